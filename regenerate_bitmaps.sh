@@ -29,3 +29,6 @@ echo "Next steps:"
 echo "  1. Build: pio run -e esp32c3"
 echo "  2. Upload: pio run -t upload -e esp32c3"
 echo "  3. Monitor: pio device monitor"
+echo ""
+echo "Or, with ASSET_PARTITION_ENABLED, update only the assets partition:"
+echo "  python3 scripts/pack_assets.py && esptool.py --chip esp32c3 write_flash 0x290000 assets.bin"
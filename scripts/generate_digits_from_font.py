@@ -19,9 +19,9 @@ USAGE:
     (Optional: modify font path and size in the script or hardcoded defaults)
 
 OUTPUT:
-    Generates: src/digit_bitmaps.h
+    Generates: src/digit_bitmaps.h (declarations) and src/digit_bitmaps.cpp (data)
     Contains: 12 bitmap glyphs (0-9, :, °) at 120pt from Courier Bold font
-    Format: 60x100 pixel monochrome bitmaps for e-ink display
+    Format: 70x110 pixel monochrome bitmaps, PackBits compressed (src/packed_bitmap.h)
     Rebuild firmware with: pio run -e esp32c3
 """
 
@@ -29,6 +29,9 @@ import os
 import sys
 from PIL import Image, ImageDraw, ImageFont
 
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from packed_assets import write_assets  # noqa: E402
+
 def find_helvetica_bold_font():
     """Find SF Mono Heavy font on the system."""
     # macOS and other systems
@@ -110,8 +113,50 @@ def generate_digit_bitmap(digit_char, font_path=None, font_size=120, width=70, h
     
     return bytes(bitmap)
 
+DIGIT_NAMES = {':': "COLON_BITMAP", '°': "DEGREE_BITMAP"}
+
+DIGIT_PREAMBLE = """// Custom bitmap digits rendered from TrueType font
+// 70x110 pixels each (monochrome, 1 bit per pixel, 1 = black), PackBits compressed
+
+#define DIGIT_WIDTH 70
+#define DIGIT_HEIGHT 110
+
+"""
+
+DIGIT_LOOKUP = """
+// Lookup function to get bitmap for a digit
+static inline const PackedBitmap &getDigitBitmap(char digit)
+{
+    unsigned char c = (unsigned char)digit;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch"
+    switch (c)
+    {
+%s    default:
+        return DIGIT_0_BITMAP;
+    }
+#pragma GCC diagnostic pop
+}
+"""
+
+
+def write_digit_assets(output_file, bitmaps):
+    """Header + data table for {char: 70x110 bitmap}"""
+    assets = []
+    cases = ""
+    for digit, bitmap in bitmaps.items():
+        name = DIGIT_NAMES.get(digit, f"DIGIT_{digit}_BITMAP")
+        assets.append((name, 70, 110, bitmap, "DIGIT_WIDTH", "DIGIT_HEIGHT"))
+        if digit == '°':
+            cases += f"    case 0xB0:\n        return {name}; // UTF-8 degree symbol byte\n"
+        else:
+            cases += f"    case '{digit}':\n        return {name};\n"
+    write_assets(output_file, "DIGIT_BITMAPS_H", DIGIT_PREAMBLE, assets, DIGIT_LOOKUP % cases,
+                 script="scripts/generate_digits_from_font.py")
+
+
 def generate_cpp_header(output_file, font_path=None, font_size=120):
-    """Generate C++ header with bitmap data."""
+    """Generate C++ header and data table."""
     digits = '0123456789:°'
     bitmaps = {}
     
@@ -121,74 +166,7 @@ def generate_cpp_header(output_file, font_path=None, font_size=120):
         bitmaps[digit] = bitmap
         print(f"  Generated '{digit}' bitmap ({len(bitmap)} bytes)")
     
-    # Write header file
-    with open(output_file, 'w') as f:
-        f.write("""#ifndef DIGIT_BITMAPS_H
-#define DIGIT_BITMAPS_H
-
-#include <Arduino.h>
-
-// Custom bitmap digits rendered from TrueType font
-// 60x100 pixels each (monochrome, 1 bit per pixel)
-// Auto-generated - do not edit manually
-// Use scripts/generate_digits_from_font.py to regenerate
-
-#define DIGIT_WIDTH 70
-#define DIGIT_HEIGHT 110
-#define DIGIT_BYTES ((DIGIT_WIDTH + 7) / 8 * DIGIT_HEIGHT)  // 1100 bytes per digit
-
-""")
-        
-        # Write bitmap arrays
-        for digit in digits:
-            bitmap = bitmaps[digit]
-            if digit == ':':
-                array_name = "COLON_BITMAP"
-            elif digit == '°':
-                array_name = "DEGREE_BITMAP"
-            else:
-                array_name = f"DIGIT_{digit}_BITMAP"
-            
-            f.write(f"static const unsigned char {array_name}[DIGIT_BYTES] PROGMEM = {{\n")
-            
-            # Write bitmap data as hex bytes
-            for i, byte in enumerate(bitmap):
-                if i % 16 == 0:
-                    f.write("    ")
-                f.write(f"0x{byte:02x}")
-                if i < len(bitmap) - 1:
-                    f.write(", ")
-                if (i + 1) % 16 == 0:
-                    f.write("\n")
-            
-            f.write("\n};\n\n")
-        
-        # Write lookup function
-        f.write("""// Lookup function to get bitmap for a digit
-static inline const unsigned char* getDigitBitmap(char digit) {
-    #pragma GCC diagnostic push
-    #pragma GCC diagnostic ignored "-Wswitch"
-    switch (digit) {
-""")
-        
-        for digit in digits:
-            if digit == ':':
-                f.write(f"        case ':': return COLON_BITMAP;\n")
-            elif digit == '°':
-                f.write(f"        case '°': return DEGREE_BITMAP;\n")
-            else:
-                f.write(f"        case '{digit}': return DIGIT_{digit}_BITMAP;\n")
-        
-        f.write("""        default: return DIGIT_0_BITMAP;
-    }
-    #pragma GCC diagnostic pop
-}
-
-#endif // DIGIT_BITMAPS_H
-""")
-    
-    print(f"\nWrote {output_file}")
-    print(f"Header contains {len(digits)} bitmaps, 1100 bytes each = {len(digits) * 1100} bytes total")
+    write_digit_assets(output_file, bitmaps)
 
 if __name__ == "__main__":
     # Determine paths
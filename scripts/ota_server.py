@@ -0,0 +1,297 @@
+#!/usr/bin/env python3
+"""
+Firmware update server for trmnl-view panels.
+
+Panels ask for /ota/manifest?version=<FIRMWARE_VERSION> on their weather wakes. A panel
+on the newest build gets 204; any other gets a manifest naming a patch from its build to the
+newest one, in the format documented in src/ota_patch.h. Patches are made on first request
+and kept in memory.
+
+Every image is signed when it is published (ECDSA P-256 over the image and its version), and
+panels boot only images whose signature checks out against OTA_PUBLIC_KEY. The private key is
+needed to publish, not to serve: keep it off the machine running the server.
+
+USAGE:
+    python3 scripts/ota_server.py [--port 8070] [--builds ota_builds]
+
+    Once, make the release key and put the printed public key in src/config.h:
+    python3 scripts/ota_server.py --keygen ota_release_key.pem
+
+    Publish a release: bump FIRMWARE_VERSION in src/config.h, build, then
+    python3 scripts/ota_server.py --add .pio/build/esp32c3/firmware.bin --key ota_release_key.pem
+    which copies the image to <builds>/<version>.bin and its signature to <version>.sig.
+    Keep the builds panels still run: a patch can only be made from a build the server has.
+
+    Panels: set OTA_MANIFEST_URL and OTA_PUBLIC_KEY in src/config.h. Serving from the same
+    host as the weather (or frames) lets the manifest check reuse that connection.
+
+    Offline:
+    python3 scripts/ota_server.py --patch old.bin new.bin --out patch.bin
+
+REQUIREMENTS:
+    Python 3.8+ standard library only; the openssl command line tool for --keygen and --add
+"""
+
+import argparse
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+PATCH_VERSION = 1
+HEADER = struct.Struct("<2sBBIIII")
+MIN_MATCH = 8
+INDEX_STEP = 4  # Source offsets indexed; every target offset is looked up
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def varint(value):
+    out = bytearray()
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+    return out
+
+
+def match_length(source, start, target, pos):
+    """Bytes source[start:] and target[pos:] have in common"""
+    n = 0
+    limit = min(len(source) - start, len(target) - pos)
+    step = 256
+    while step >= 1:
+        while n + step <= limit and source[start + n:start + n + step] == target[pos + n:pos + n + step]:
+            n += step
+        step //= 16
+    while n < limit and source[start + n] == target[pos + n]:
+        n += 1
+    return n
+
+
+def make_patch(source, target):
+    """Copy/literal patch of target against source, as OtaPatch::encode makes it"""
+    index = {}
+    for i in range(0, len(source) - MIN_MATCH + 1, INDEX_STEP):
+        index.setdefault(source[i:i + MIN_MATCH], i)
+
+    ops = bytearray()
+    copy_end = 0
+    literal_start = 0
+    pos = 0
+    while pos + MIN_MATCH <= len(target):
+        # Carry on from the last copy across the changed bytes (moved code with a patched
+        # constant), else wherever the block index points
+        best_from, best_length = 0, 0
+        carried = copy_end + (pos - literal_start)
+        if copy_end > 0 and carried < len(source):
+            best_from, best_length = carried, match_length(source, carried, target, pos)
+        if best_length < MIN_MATCH:
+            candidate = index.get(bytes(target[pos:pos + MIN_MATCH]))
+            if candidate is not None:
+                length = match_length(source, candidate, target, pos)
+                if length > best_length:
+                    best_from, best_length = candidate, length
+        if best_length < MIN_MATCH:
+            pos += 1
+            continue
+
+        if pos > literal_start:
+            ops += varint((pos - literal_start) << 1) + target[literal_start:pos]
+        offset = best_from - copy_end
+        zigzag = offset << 1 if offset >= 0 else (-offset << 1) - 1
+        ops += varint((best_length << 1) | 1) + varint(zigzag)
+        copy_end = best_from + best_length
+        pos += best_length
+        literal_start = pos
+    if len(target) > literal_start:
+        ops += varint((len(target) - literal_start) << 1) + target[literal_start:]
+
+    header = HEADER.pack(b"TP", PATCH_VERSION, 0, len(source), fnv1a(source), len(target), fnv1a(target))
+    return header + bytes(ops)
+
+
+def openssl(*args, data=None):
+    try:
+        return subprocess.run(["openssl", *args], input=data, capture_output=True, check=True).stdout
+    except FileNotFoundError:
+        sys.exit("openssl not found")
+    except subprocess.CalledProcessError as e:
+        sys.exit(f"openssl {args[0]} failed: {e.stderr.decode(errors='replace').strip()}")
+
+
+def signed_message(image, version):
+    """What the release key signs, as OtaUpdate checks it: the image, then its version"""
+    return image + struct.pack("<I", version)
+
+
+def make_key(path):
+    """New P-256 release key at path; returns the public half as OTA_PUBLIC_KEY hex"""
+    if os.path.exists(path):
+        sys.exit(f"{path} exists; a new key locks out panels built with the old one")
+    openssl("ecparam", "-name", "prime256v1", "-genkey", "-noout", "-out", path)
+    os.chmod(path, 0o600)
+    return public_key(path)
+
+
+def public_key(path):
+    return openssl("ec", "-in", path, "-pubout", "-outform", "DER").hex()
+
+
+def sign(path, message):
+    """DER ECDSA signature over SHA-256 of message"""
+    return openssl("dgst", "-sha256", "-sign", path, data=message)
+
+
+def firmware_version():
+    with open(os.path.join(REPO, "src", "config.h")) as f:
+        match = re.search(r"#define\s+FIRMWARE_VERSION\s+(\d+)", f.read())
+    if match is None:
+        sys.exit("FIRMWARE_VERSION not found in src/config.h")
+    return int(match.group(1))
+
+
+class Builds:
+    """Firmware images by version, and the patches made between them so far"""
+
+    def __init__(self, directory):
+        self.directory = directory
+        self.patches = {}
+        self.lock = threading.Lock()
+
+    def versions(self):
+        names = os.listdir(self.directory) if os.path.isdir(self.directory) else []
+        return sorted(int(n[:-4]) for n in names if re.fullmatch(r"\d+\.bin", n))
+
+    def image(self, version, extension="bin"):
+        path = os.path.join(self.directory, f"{version}.{extension}")
+        if not os.path.exists(path):
+            return None
+        with open(path, "rb") as f:
+            return f.read()
+
+    def signature(self, version):
+        return self.image(version, "sig")
+
+    def patch(self, old, new):
+        with self.lock:
+            if (old, new) not in self.patches:
+                source, target = self.image(old), self.image(new)
+                if source is None or target is None:
+                    return None
+                self.patches[(old, new)] = make_patch(source, target)
+                print(f"Patch {old} -> {new}: {len(self.patches[(old, new)])} bytes for a {len(target)} byte image")
+            return self.patches[(old, new)]
+
+
+def make_handler(builds):
+    class UpdateHandler(BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"  # Keep-alive: the patch follows on the manifest's connection
+
+        def reply(self, status, body=b"", content_type="application/octet-stream"):
+            self.send_response(status)
+            if status != 204:
+                self.send_header("Content-Type", content_type)
+                self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+
+        def do_GET(self):
+            url = urlparse(self.path)
+            query = parse_qs(url.query)
+            try:
+                if url.path == "/ota/manifest":
+                    running = int(query["version"][0])
+                    versions = builds.versions()
+                    if not versions or running >= versions[-1]:
+                        self.reply(204)
+                        return
+                    latest = versions[-1]
+                    signature = builds.signature(latest)
+                    if signature is None:
+                        print(f"Build {latest} has no {latest}.sig; publish it with --add and --key")
+                        self.reply(204)
+                        return
+                    patch = builds.patch(running, latest)
+                    if patch is None:
+                        print(f"Panel on build {running} asked for an update, but that build isn't in {builds.directory}")
+                        self.reply(204)
+                        return
+                    manifest = (f"version {latest}\npatch /ota/patch?from={running}&to={latest}\nsize {len(patch)}\n"
+                                f"signature {signature.hex()}\n")
+                    self.reply(200, manifest.encode(), "text/plain")
+                elif url.path == "/ota/patch":
+                    patch = builds.patch(int(query["from"][0]), int(query["to"][0]))
+                    if patch is None:
+                        self.reply(404, b"no such build", "text/plain")
+                    else:
+                        self.reply(200, patch)
+                else:
+                    self.reply(404, b"not found", "text/plain")
+            except (KeyError, ValueError):
+                self.reply(400, b"bad query", "text/plain")
+
+    return UpdateHandler
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Firmware update server for trmnl-view panels")
+    parser.add_argument("--port", type=int, default=8070)
+    parser.add_argument("--builds", default=os.path.join(REPO, "ota_builds"), help="Directory of <version>.bin images")
+    parser.add_argument("--add", help="Sign a built firmware.bin and publish it as the FIRMWARE_VERSION in src/config.h")
+    parser.add_argument("--key", help="Release key (PEM) to sign --add with")
+    parser.add_argument("--keygen", metavar="KEY", help="Write a new release key and print OTA_PUBLIC_KEY")
+    parser.add_argument("--patch", nargs=2, metavar=("OLD", "NEW"), help="Write a patch from OLD to NEW and exit")
+    parser.add_argument("--out", default="patch.bin", help="Output for --patch")
+    args = parser.parse_args()
+
+    if args.patch:
+        with open(args.patch[0], "rb") as f:
+            source = f.read()
+        with open(args.patch[1], "rb") as f:
+            target = f.read()
+        patch = make_patch(source, target)
+        with open(args.out, "wb") as f:
+            f.write(patch)
+        print(f"Wrote {len(patch)} bytes to {args.out} ({100.0 * len(patch) / len(target):.1f}% of the image)")
+        return
+
+    if args.keygen:
+        public = make_key(args.keygen)
+        print(f"Wrote {args.keygen}. Keep it private and backed up; panels need this in src/config.h:")
+        print(f'#define OTA_PUBLIC_KEY "{public}"')
+        return
+
+    if args.add:
+        if not args.key:
+            sys.exit("--add needs --key: panels refuse unsigned images")
+        version = firmware_version()
+        with open(args.add, "rb") as f:
+            signature = sign(args.key, signed_message(f.read(), version))
+        os.makedirs(args.builds, exist_ok=True)
+        destination = os.path.join(args.builds, f"{version}.bin")
+        shutil.copyfile(args.add, destination)
+        with open(os.path.join(args.builds, f"{version}.sig"), "wb") as f:
+            f.write(signature)
+        print(f"Published {args.add} as {destination}, signed with {args.key}")
+        return
+
+    server = ThreadingHTTPServer(("0.0.0.0", args.port), make_handler(Builds(args.builds)))
+    print(f"Update server listening on http://0.0.0.0:{args.port}/ota/manifest, builds in {args.builds}")
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""
+Pack digits, weather icons and fonts into the asset blob read by src/asset_pack.h.
+
+The blob goes into the "assets" partition (partitions.csv), which the firmware maps with
+esp_partition_mmap when ASSET_PARTITION_ENABLED is 1. Changing an icon or a font then only
+needs the partition rewritten, not a firmware build and reflash.
+
+USAGE:
+    python3 scripts/pack_assets.py [--fonts <Adafruit GFX Library>/Fonts] [--out assets.bin]
+
+    Flash it (the offset is the assets row of partitions.csv):
+    esptool.py --chip esp32c3 write_flash 0x290000 assets.bin
+
+Bitmaps come from the generated src/digit_bitmaps.cpp and src/weather_bitmaps.cpp (run
+generate_digits_from_font.py / png_to_bitmap.py first to change them), fonts from the
+Adafruit GFX headers the firmware is built with. Fonts go in whole, not cut like the built-in
+subsets (subset_fonts.py): USB and OTA updates rewrite only the app, so a pack outlives the
+firmware it was made with, and text a later build adds must still find its glyphs here.
+
+REQUIREMENTS:
+    Python 3.8+ standard library only.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from packed_assets import REPO, load_packed  # noqa: E402
+from render_server import DEFAULT_FONTS, GfxFont  # noqa: E402
+from subset_fonts import FONTS  # noqa: E402
+
+ASSET_PACK_VERSION = 1
+ASSET_KIND_BITMAP = 1
+ASSET_KIND_FONT = 2
+HEADER_SIZE = 16
+ENTRY_SIZE = 16
+PARTITION_SIZE = 0x40000  # assets row of partitions.csv
+
+# Same names the firmware looks up (DisplayManager's asset tables)
+BITMAP_SOURCES = ["digit_bitmaps.cpp", "weather_bitmaps.cpp"]
+
+
+def fnv1a(data, h=2166136261):
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def bitmap_payload(width, height, packed):
+    return struct.pack("<HH", width, height) + packed
+
+
+def font_payload(font):
+    glyphs = b"".join(struct.pack("<HBBBbbx", *g) for g in font.glyphs)
+    bitmap_offset = 12 + len(glyphs)
+    return struct.pack("<HHBxxxI", font.first, font.last, font.y_advance, bitmap_offset) + glyphs + font.bitmap
+
+
+def pack(entries):
+    """entries: [(name, kind, payload)] -> blob, same bytes as AssetPackWriter"""
+    pos = HEADER_SIZE + ENTRY_SIZE * len(entries)
+    index = b""
+    body = b""
+    for name, kind, payload in entries:
+        offset = (pos + 3) & ~3
+        body += b"\0" * (offset - pos) + payload
+        index += struct.pack("<IBxxxII", fnv1a(name.encode()), kind, offset, len(payload))
+        pos = offset + len(payload)
+    rest = index + body
+    return struct.pack("<2sBxHHII", b"TA", ASSET_PACK_VERSION, len(entries), 0, pos, fnv1a(rest)) + rest
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--fonts", default=DEFAULT_FONTS, help="Adafruit GFX Fonts directory")
+    parser.add_argument("--out", default=os.path.join(REPO, "assets.bin"))
+    args = parser.parse_args()
+
+    entries = []
+    for source in BITMAP_SOURCES:
+        for name, (width, height, packed) in load_packed(source).items():
+            entries.append((name, ASSET_KIND_BITMAP, bitmap_payload(width, height, packed)))
+    for name in FONTS.values():
+        font = GfxFont(os.path.join(args.fonts, name + ".h"))
+        entries.append((name, ASSET_KIND_FONT, font_payload(font)))
+
+    blob = pack(entries)
+    if len(blob) > PARTITION_SIZE:
+        sys.exit(f"{len(blob)} bytes don't fit the {PARTITION_SIZE} byte assets partition")
+    with open(args.out, "wb") as f:
+        f.write(blob)
+    print(f"Wrote {args.out}: {len(entries)} assets, {len(blob)} bytes")
+
+
+if __name__ == "__main__":
+    main()
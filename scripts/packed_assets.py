@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""
+PackBits-compressed bitmap tables shared by the asset generators.
+
+generate_digits_from_font.py and png_to_bitmap.py hand their 1bpp bitmaps (MSB = leftmost
+pixel, 1 = ink) to write_assets(), which emits a header declaring one PackedBitmap per asset
+and a .cpp holding the only copy of the data (src/packed_bitmap.h describes the format).
+render_server.py reads the bitmaps back with load_assets(), pack_assets.py with load_packed().
+
+Run directly to print the compressed size of every asset in the generated sources:
+    python3 scripts/packed_assets.py
+"""
+
+import os
+import re
+import struct
+import sys
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SRC = os.path.join(REPO, "src")
+
+
+def packbits(data):
+    """Same run selection as FrameCodec::encode"""
+    out = bytearray()
+    i, n = 0, len(data)
+    while i < n:
+        run = 1
+        while i + run < n and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 2:
+            out += struct.pack("bB", 1 - run, data[i])
+            i += run
+            continue
+        start, count = i, 0
+        while i < n and count < 128:
+            if i + 2 < n and data[i] == data[i + 1] == data[i + 2]:
+                break
+            i += 1
+            count += 1
+        out.append(count - 1)
+        out += data[start:start + count]
+    return bytes(out)
+
+
+def unpackbits(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        header = struct.unpack("b", data[i:i + 1])[0]
+        i += 1
+        if header >= 0:
+            out += data[i:i + header + 1]
+            i += header + 1
+        elif header != -128:
+            out += bytes([data[i]]) * (1 - header)
+            i += 1
+    return bytes(out)
+
+
+def _byte_lines(data, indent="    "):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join(f"0x{b:02x}" for b in data[i:i + 16]))
+    return ",\n".join(lines)
+
+
+def write_assets(header_path, guard, preamble, assets, header_tail="", script=None):
+    """
+    Write header_path (declarations) and the matching .cpp (data)
+
+    assets: list of (name, width, height, raw bytes, width and height expressions for the source)
+    preamble: comment and #defines placed after the include in the header
+    header_tail: code after the declarations (lookup helpers)
+    """
+    source_path = os.path.splitext(header_path)[0] + ".cpp"
+    header_name = os.path.basename(header_path)
+    script = script or "scripts/" + os.path.basename(sys.argv[0])
+
+    with open(header_path, "w") as f:
+        f.write(f"#ifndef {guard}\n#define {guard}\n\n#include \"packed_bitmap.h\"\n\n")
+        f.write(preamble)
+        f.write(f"// Auto-generated - do not edit manually. Use {script} to regenerate.\n")
+        for name, *_ in assets:
+            f.write(f"extern const PackedBitmap {name};\n")
+        f.write(header_tail)
+        f.write(f"\n#endif // {guard}\n")
+
+    raw_total = packed_total = 0
+    with open(source_path, "w") as f:
+        f.write(f"#include \"{header_name}\"\n\n")
+        f.write(f"// Auto-generated - do not edit manually. Use {script} to regenerate.\n")
+        for name, width, height, raw, width_expr, height_expr in assets:
+            assert len(raw) == (width + 7) // 8 * height
+            packed = packbits(raw)
+            assert unpackbits(packed) == raw
+            raw_total += len(raw)
+            packed_total += len(packed)
+            data_name = name[:-len("_BITMAP")] + "_DATA" if name.endswith("_BITMAP") else name + "_data"
+            f.write(f"\nstatic const uint8_t {data_name}[] PROGMEM = {{ // {len(raw)} bytes raw\n")
+            f.write(_byte_lines(packed))
+            f.write("\n};\n")
+            f.write(f"const PackedBitmap {name} = {{{data_name}, sizeof({data_name}), {width_expr}, {height_expr}}};\n")
+
+    print(f"Wrote {header_path} and {source_path}")
+    print(f"{len(assets)} bitmaps: {raw_total} bytes raw, {packed_total} bytes PackBits")
+
+
+def load_packed(source_name):
+    """Compressed bitmaps of a generated .cpp in src/: {name: (width, height, PackBits data)}"""
+    with open(os.path.join(SRC, source_name)) as f:
+        text = f.read()
+    with open(os.path.join(SRC, os.path.splitext(source_name)[0] + ".h")) as f:
+        defines = dict(re.findall(r"^#define (\w+) (\d+)", f.read(), re.M))
+    data = {}
+    for data_name, body in re.findall(r"static const uint8_t (\w+)\[\] PROGMEM = \{[^\n]*\n([^}]*)\}", text):
+        data[data_name] = bytes(int(v, 16) for v in re.findall(r"0x[0-9a-fA-F]+", body))
+    bitmaps = {}
+    for name, data_name, width, height in re.findall(
+            r"const PackedBitmap (\w+) = \{(\w+), sizeof\(\w+\), (\w+), (\w+)\};", text):
+        bitmaps[name] = (int(defines.get(width, width)), int(defines.get(height, height)), data[data_name])
+    return bitmaps
+
+
+def load_assets(source_name):
+    """Decoded bitmaps of a generated .cpp in src/, by PackedBitmap name"""
+    return {name: unpackbits(packed) for name, (_, _, packed) in load_packed(source_name).items()}
+
+
+if __name__ == "__main__":
+    for source in ("digit_bitmaps.cpp", "weather_bitmaps.cpp"):
+        with open(os.path.join(SRC, source)) as f:
+            text = f.read()
+        for data_name, raw_size, body in re.findall(
+                r"static const uint8_t (\w+)\[\] PROGMEM = \{ // (\d+) bytes raw\n([^}]*)\}", text):
+            packed = len(re.findall(r"0x[0-9a-fA-F]+", body))
+            print(f"{source:20} {data_name:24} {int(raw_size):5} -> {packed:4} bytes")
@@ -3,8 +3,12 @@
 
 from PIL import Image
 import os
+import sys
 from pathlib import Path
 
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from packed_assets import write_assets  # noqa: E402
+
 def png_to_bitmap_c(png_path, output_size=32):
     """Convert PNG to monochrome bitmap C array"""
     img = Image.open(png_path)
@@ -53,18 +57,25 @@ def png_to_bitmap_c(png_path, output_size=32):
     
     return bytes_list, output_size
 
-def generate_c_code(png_folder, target_size=40):
-    """Generate C header with all bitmap arrays, resizing to target size"""
-    
-    png_files = sorted(Path(png_folder).glob('*.png'))
-    
-    c_code = f"""#ifndef WEATHER_BITMAPS_H
-#define WEATHER_BITMAPS_H
-
-// Auto-generated from PNG files - {target_size}x{target_size} monochrome bitmaps
-// Each bitmap is {target_size*target_size//8} bytes
+def icon_preamble(target_size):
+    return f"""// Weather icons from PNG files - {target_size}x{target_size} monochrome bitmaps (1 = black)
+// {target_size*target_size//8} bytes each raw, PackBits compressed
 
 """
+
+
+def write_icon_assets(output_file, icons, target_size=40):
+    """Header + data table for [(name, bitmap bytes)]"""
+    assets = [(name, target_size, target_size, bitmap, str(target_size), str(target_size)) for name, bitmap in icons]
+    write_assets(output_file, "WEATHER_BITMAPS_H", icon_preamble(target_size), assets,
+                 script="scripts/png_to_bitmap.py")
+
+
+def generate_icons(png_folder, target_size=40):
+    """Convert all PNGs in a folder, resizing to target size"""
+    
+    png_files = sorted(Path(png_folder).glob('*.png'))
+    icons = []
     
     for png_file in png_files:
         name = png_file.stem.replace('-', '_').replace(' ', '_').replace('.', '_')
@@ -117,38 +128,15 @@ def generate_c_code(png_folder, target_size=40):
             print(f"Error processing {png_file}: {e}")
             continue
         
-        c_code += f"const unsigned char {name}_{target_size}x{target_size}[] PROGMEM = {{\n"
-        
-        # Format bytes nicely
-        for i, byte in enumerate(bytes_list):
-            if i % 16 == 0:
-                c_code += "  "
-            c_code += f"0x{byte:02x}"
-            if i < len(bytes_list) - 1:
-                c_code += ", "
-            if (i + 1) % 16 == 0:
-                c_code += "\n"
-        
-        c_code += "\n};\n\n"
-    
-    c_code += "#endif // WEATHER_BITMAPS_H\n"
+        icons.append((f"{name}_{target_size}x{target_size}", bytes(bytes_list)))
     
-    return c_code
-
-# Generate for 40x40
-output_dir = "/Users/colin/Projects/trmnl-view/src"
-output_size = 40
-
-code = generate_c_code("/Users/colin/Projects/trmnl-view/weather-bitmaps", output_size)
+    return icons
 
-output_file = os.path.join(output_dir, "weather_bitmaps.h")
-with open(output_file, 'w') as f:
-    f.write(code)
 
-print(f"✓ Generated {output_file}")
-print(f"  Size: {len(code)} bytes of C code")
+if __name__ == "__main__":
+    # Generate for 40x40
+    output_dir = "/Users/colin/Projects/trmnl-view/src"
+    output_size = 40
 
-# Also show file sizes
-import subprocess
-result = subprocess.run(['du', '-h', output_file], capture_output=True, text=True)
-print(f"  File size: {result.stdout.strip()}")
+    icons = generate_icons("/Users/colin/Projects/trmnl-view/weather-bitmaps", output_size)
+    write_icon_assets(os.path.join(output_dir, "weather_bitmaps.h"), icons, output_size)
@@ -0,0 +1,472 @@
+#!/usr/bin/env python3
+"""
+Reference renderer for server-rendered frame mode (RENDER_FRAME_ENABLED).
+
+Rasterizes the weather pane (or the whole screen) exactly the way DisplayWeather
+does on the device: layout constants come from src/weather_layout.h, icons and
+digits from src/weather_bitmaps.cpp / src/digit_bitmaps.cpp, and text uses the same
+Adafruit GFX fonts. The result is served as a PackBits-compressed 1bpp frame in
+the format documented in src/frame_codec.h.
+
+USAGE:
+    python3 scripts/render_server.py [--port 8090] [--fonts <Adafruit GFX Library>/Fonts]
+
+    Device: set RENDER_FRAME_ENABLED 1 and RENDER_FRAME_URL in src/config.h
+
+    Offline render of a saved Open-Meteo response (for checking frames by eye):
+    python3 scripts/render_server.py --fixture forecast.json --time 1767362400 --out pane.pbm
+
+    Panels built with RENDER_FRAME_DELTA send the hash of the pane they show (known=) and get
+    back only the changed tiles (src/tile_delta.h), or 304 when nothing changed. Offline:
+    python3 scripts/render_server.py --fixture forecast.json --since 1767360600 --time 1767362400 --out delta.bin
+
+REQUIREMENTS:
+    Python 3.8+ standard library only. Fonts default to the PlatformIO copy of
+    Adafruit GFX in .pio/libdeps/esp32c3.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from weather_gateway import (LocationCache, UPSTREAM_URL, WEATHER_CLEAR, WEATHER_CLOUDY, WEATHER_FOGGY,  # noqa: E402
+                             WEATHER_OVERCAST, WEATHER_RAIN, WEATHER_SNOW, WEATHER_THUNDER, extract_weather)
+from packed_assets import load_assets, packbits  # noqa: E402
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SRC = os.path.join(REPO, "src")
+DEFAULT_FONTS = os.path.join(REPO, ".pio", "libdeps", "esp32c3", "Adafruit GFX Library", "Fonts")
+
+FRAME_VERSION = 1
+FRAME_FLAG_PACKBITS = 0x01
+
+DAYS_SHORT = ["Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"]
+DAYS_LONG = ["Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"]
+MONTHS = ["Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"]
+
+
+# --- Firmware sources ------------------------------------------------------------------------
+
+def read_source(name):
+    with open(os.path.join(SRC, name)) as f:
+        return f.read()
+
+
+def load_layout():
+    """Constants from config.h and weather_layout.h, evaluated in order"""
+    values = {}
+    for name, value in re.findall(r"^#define (\w+) ([^/\n]+)", read_source("config.h"), re.M):
+        try:
+            values[name] = int(eval(value, {}, values))
+        except Exception:
+            pass
+    for name, value in re.findall(r"^const int (\w+) = ([^;]+);", read_source("weather_layout.h"), re.M):
+        values[name] = int(eval(value, {}, values))
+    return values
+
+
+class GfxFont:
+    """Adafruit GFX font header (Fonts/*.h)"""
+
+    def __init__(self, path):
+        with open(path) as f:
+            text = f.read()
+        bitmap_body = re.search(r"Bitmaps\[\] PROGMEM = \{([^}]*)\}", text).group(1)
+        self.bitmap = bytes(int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]+", bitmap_body))
+        glyph_body = re.search(r"Glyphs\[\] PROGMEM = \{(.*?)\};", text, re.S).group(1)
+        self.glyphs = [tuple(int(v) for v in g.split(","))
+                       for g in re.findall(r"\{\s*(-?\d+\s*,\s*-?\d+\s*,\s*-?\d+\s*,\s*-?\d+\s*,\s*-?\d+\s*,\s*-?\d+)\s*\}",
+                                           glyph_body)]
+        tail = re.search(r"Glyphs,\s*(0x[0-9A-Fa-f]+|\d+),\s*(0x[0-9A-Fa-f]+|\d+),\s*(\d+)\s*\}", text)
+        self.first = int(tail.group(1), 0)
+        self.last = int(tail.group(2), 0)
+        self.y_advance = int(tail.group(3))
+
+    def glyph(self, byte):
+        if self.first <= byte <= self.last:
+            return self.glyphs[byte - self.first]
+        return None  # Adafruit GFX skips bytes outside the font (e.g. UTF-8 of the degree sign)
+
+    def text_width(self, text):
+        """Width as getTextBounds reports it"""
+        x, minx, maxx = 0, 32767, -32768
+        for byte in text.encode("utf-8"):
+            g = self.glyph(byte)
+            if g is None:
+                continue
+            _, w, h, advance, xo, _ = g
+            if w > 0 and h > 0:
+                minx = min(minx, x + xo)
+                maxx = max(maxx, x + xo + w - 1)
+            x += advance
+        return maxx - minx + 1 if maxx >= minx else 0
+
+
+# --- Rendering -------------------------------------------------------------------------------
+
+class Canvas:
+    """Packed 1bpp region of the panel, 1 = white, drawn in panel coordinates"""
+
+    def __init__(self, x, y, width, height):
+        self.x, self.y, self.width, self.height = x, y, width, height
+        self.row_bytes = width // 8
+        self.bits = bytearray(b"\xff" * (self.row_bytes * height))
+
+    def black(self, x, y):
+        x -= self.x
+        y -= self.y
+        if 0 <= x < self.width and 0 <= y < self.height:
+            self.bits[y * self.row_bytes + x // 8] &= ~(0x80 >> (x % 8)) & 0xFF
+
+    def bitmap(self, x, y, data, width, height):
+        """Set bits are black (drawBitmapIcon / drawNumberBitmap convention)"""
+        row_bytes = (width + 7) // 8
+        for row in range(height):
+            for col in range(width):
+                if data[row * row_bytes + col // 8] & (0x80 >> (col % 8)):
+                    self.black(x + col, y + row)
+
+    def rect(self, x, y, w, h):
+        for i in range(w):
+            self.black(x + i, y)
+            self.black(x + i, y + h - 1)
+        for j in range(h):
+            self.black(x, y + j)
+            self.black(x + w - 1, y + j)
+
+    def print(self, font, x, y, text):
+        for byte in text.encode("utf-8"):
+            g = font.glyph(byte)
+            if g is None:
+                continue
+            offset, w, h, advance, xo, yo = g
+            bit = 0
+            for row in range(h):
+                for col in range(w):
+                    if font.bitmap[offset + bit // 8] & (0x80 >> (bit % 8)):
+                        self.black(x + xo + col, y + yo + row)
+                    bit += 1
+            x += advance
+
+    def centered(self, font, text, center_x, y):
+        """DisplayManager::drawCenteredText"""
+        self.print(font, center_x - font.text_width(text) // 2, y, text)
+
+
+class Renderer:
+    def __init__(self, fonts_dir):
+        self.layout = load_layout()
+        self.icons = load_assets("weather_bitmaps.cpp")
+        self.digits = load_assets("digit_bitmaps.cpp")
+        self.digit_width = int(re.search(r"#define DIGIT_WIDTH (\d+)", read_source("digit_bitmaps.h")).group(1))
+        self.digit_height = int(re.search(r"#define DIGIT_HEIGHT (\d+)", read_source("digit_bitmaps.h")).group(1))
+        self.font_bold = GfxFont(os.path.join(fonts_dir, "FreeSansBold12pt7b.h"))
+        self.font_small = GfxFont(os.path.join(fonts_dir, "FreeSans9pt7b.h"))
+        self.font_date = GfxFont(os.path.join(fonts_dir, "FreeMonoBold24pt7b.h"))
+
+    def digit_bitmap(self, char):
+        """getDigitBitmap, including its fallback to 0"""
+        if char.isdigit():
+            return self.digits[f"DIGIT_{char}_BITMAP"]
+        if char == ":":
+            return self.digits["COLON_BITMAP"]
+        if char == "°":
+            return self.digits["DEGREE_BITMAP"]
+        return self.digits["DIGIT_0_BITMAP"]
+
+    def number(self, canvas, x, y, text):
+        """DisplayManager::drawNumberBitmap"""
+        for char in text:
+            canvas.bitmap(x, y, self.digit_bitmap(char), self.digit_width, self.digit_height)
+            x += self.digit_width
+
+    def icon(self, canvas, x, y, condition):
+        """DisplayWeather::drawWeatherIcon"""
+        names = {WEATHER_CLEAR: "sun_max_40x40", WEATHER_CLOUDY: "cloud_40x40", WEATHER_OVERCAST: "cloud_40x40",
+                 WEATHER_FOGGY: "cloud_fog_40x40", WEATHER_RAIN: "cloud_rain_40x40",
+                 WEATHER_SNOW: "cloud_snow_40x40", WEATHER_THUNDER: "cloud_bolt_rain_40x40"}
+        name = names.get(condition)
+        if name is None:
+            canvas.rect(x - 8, y - 8, 16, 16)
+            canvas.print(self.font_small, x - 2, y + 5, "?")
+            return
+        canvas.bitmap(x - 20 + 1, y - 20, self.icons[name], 40, 40)
+
+    def weather_pane(self, canvas, weather, updated_local):
+        L = self.layout
+        start_x, box_width = L["WEATHER_PANE_X"], L["WEATHER_PANE_WIDTH"]
+
+        # Current temperature
+        temp = "%.0f°" % weather["current_temp"]
+        total_width = (len(temp.encode("utf-8")) - 1) * self.digit_width  # strlen - 1, as on the device
+        self.number(canvas, start_x + box_width // 2 - total_width // 2, L["CURRENT_TEMP_Y"], temp)
+
+        # Hourly cells
+        col_width = box_width // L["HOURLY_COLUMNS"]
+        y = L["HOURLY_START_Y"]
+        for i in range(L["HOURLY_COLUMNS"]):
+            hour, temp, condition = weather["hourly"][i]
+            center_x = start_x + i * col_width + col_width // 2
+            label = "%d%s" % (12 if hour % 12 == 0 else hour % 12, "a" if hour < 12 else "p")
+            canvas.centered(self.font_bold, label, center_x, y + L["TEXT_HEIGHT"])
+            self.icon(canvas, center_x, y + L["ICON_HEIGHT"], condition)
+            canvas.centered(self.font_bold, "%.0f°" % temp, center_x, y + L["ICON_HEIGHT"] + L["TEXT_HEIGHT"] * 2)
+
+        # Daily cells
+        col_width = box_width // L["DAILY_COLUMNS"]
+        y = L["DAILY_START_Y"]
+        for i in range(L["DAILY_COLUMNS"]):
+            day_of_week, high, low, condition = weather["daily"][i]
+            center_x = start_x + i * col_width + col_width // 2
+            canvas.centered(self.font_bold, DAYS_SHORT[day_of_week % 7], center_x, y + L["TEXT_HEIGHT"])
+            self.icon(canvas, center_x, y + L["ICON_HEIGHT"], condition)
+            canvas.centered(self.font_bold, "%.0f/%.0f°" % (high, low), center_x,
+                            y + L["ICON_HEIGHT"] + L["TEXT_HEIGHT"] * 2)
+
+        # Last updated stamp
+        stamp = time.strftime("%b %d %H:%M", updated_local)
+        canvas.print(self.font_small, start_x + box_width - L["LAST_UPDATED_WIDTH"] + 20, L["LAST_UPDATED_Y"], stamp)
+
+    def clock_pane(self, canvas, local):
+        """DisplayClock::updateFull (time and date, no battery)"""
+        self.number(canvas, 30, 80, "%02d:%02d" % (local.tm_hour, local.tm_min))
+        center_x = self.layout["DISPLAY_LEFT_HALF"] // 2
+        day_of_week = (local.tm_wday + 1) % 7
+        canvas.centered(self.font_date, DAYS_LONG[day_of_week], center_x, 250)
+        canvas.centered(self.font_date, "%s %d, %d" % (MONTHS[local.tm_mon - 1], local.tm_mday, local.tm_year),
+                        center_x, 300)
+
+    def render(self, forecast, fetched_at, display_time, pane):
+        L = self.layout
+        offset = forecast.get("utc_offset_seconds", 0)
+        local = time.gmtime(display_time + offset)
+        weather = extract_weather(forecast, local.tm_hour)
+
+        if pane == "full":
+            canvas = Canvas(0, 0, L["DISPLAY_WIDTH"], L["DISPLAY_HEIGHT"])
+            self.clock_pane(canvas, local)
+        else:
+            canvas = Canvas(L["WEATHER_PANE_X"], 0, L["WEATHER_PANE_WIDTH"], L["DISPLAY_HEIGHT"])
+        self.weather_pane(canvas, weather, time.gmtime(fetched_at + offset))
+        return canvas
+
+
+# --- Frame encoding (src/frame_codec.cpp) -----------------------------------------------------
+
+def encode_window(canvas, x, y, w, h):
+    """Frame for a window of the canvas (canvas coordinates, x and w multiples of 8)"""
+    data = packbits(b"".join(canvas.bits[row * canvas.row_bytes + x // 8:row * canvas.row_bytes + (x + w) // 8]
+                             for row in range(y, y + h)))
+    return struct.pack("<2sBBHHHHI", b"TF", FRAME_VERSION, FRAME_FLAG_PACKBITS,
+                       canvas.x + x, canvas.y + y, w, h, len(data)) + data
+
+
+def encode_frame(canvas):
+    return encode_window(canvas, 0, 0, canvas.width, canvas.height)
+
+
+# --- Tile deltas (src/tile_delta.cpp) ---------------------------------------------------------
+
+TILE_DELTA_VERSION = 1
+TILE_SIZE = 40
+REFRESH_OVERHEAD_AREA = eval(re.search(r"REFRESH_OVERHEAD_AREA = ([^;]+);", read_source("weather_diff.cpp")).group(1))
+
+
+def image_hash(bits):
+    """TileDelta::imageHash (FNV-1a, never 0)"""
+    h = 2166136261
+    for b in bits:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h or 1
+
+
+def union_rect(a, b):
+    x0, y0 = min(a[0], b[0]), min(a[1], b[1])
+    x1, y1 = max(a[0] + a[2], b[0] + b[2]), max(a[1] + a[3], b[1] + b[3])
+    return (x0, y0, x1 - x0, y1 - y0)
+
+
+def merge_rects(rects):
+    """WeatherDiff::mergeRects, same order so both sides pick the same windows"""
+    rects = list(rects)
+    while len(rects) > 1:
+        best, best_saving = None, 0
+        for a in range(len(rects)):
+            for b in range(a + 1, len(rects)):
+                merged = union_rect(rects[a], rects[b])
+                saving = (REFRESH_OVERHEAD_AREA + rects[a][2] * rects[a][3] + rects[b][2] * rects[b][3]
+                          - merged[2] * merged[3])
+                if saving > best_saving:
+                    best, best_saving = (a, b), saving
+        if best is None:
+            break
+        a, b = best
+        rects[a] = union_rect(rects[a], rects[b])
+        rects[b] = rects[-1]
+        rects.pop()
+    return rects
+
+
+def changed_rects(before, after, width, height):
+    """TileDelta::changedRects: dirty tiles, horizontal runs, then merged into refresh windows"""
+    row_bytes = width // 8
+    rects = []
+    for ty in range(0, height, TILE_SIZE):
+        th = min(TILE_SIZE, height - ty)
+        run_start = None
+        for tx in range(0, width + 1, TILE_SIZE):
+            dirty = False
+            if tx < width:
+                tw = min(TILE_SIZE, width - tx)
+                dirty = any(before[y * row_bytes + tx // 8:y * row_bytes + (tx + tw) // 8] !=
+                            after[y * row_bytes + tx // 8:y * row_bytes + (tx + tw) // 8] for y in range(ty, ty + th))
+            if dirty and run_start is None:
+                run_start = tx
+            elif not dirty and run_start is not None:
+                rects.append((run_start, ty, min(tx, width) - run_start, th))
+                run_start = None
+    return merge_rects(rects)
+
+
+def encode_delta(canvas, rects, base_hash, new_hash):
+    tiles = b"".join(encode_window(canvas, *rect) for rect in rects)
+    return struct.pack("<2sBBII", b"TD", TILE_DELTA_VERSION, len(rects), base_hash, new_hash) + tiles
+
+
+class PaneHistory:
+    """Recently served panes per location, so a panel's hash can be turned back into pixels"""
+
+    def __init__(self, depth=8):
+        self.depth = depth
+        self.panes = {}  # (location, pane) -> [(hash, bits)], newest last
+        self.lock = threading.Lock()
+
+    def get(self, key, pane_hash):
+        with self.lock:
+            for h, bits in self.panes.get(key, []):
+                if h == pane_hash:
+                    return bits
+        return None
+
+    def add(self, key, pane_hash, bits):
+        with self.lock:
+            entries = [e for e in self.panes.get(key, []) if e[0] != pane_hash]
+            self.panes[key] = (entries + [(pane_hash, bytes(bits))])[-self.depth:]
+
+
+def delta_response(canvas, known, history, key):
+    """Body for a panel showing the pane with hash known, None if nothing changed"""
+    new_hash = image_hash(canvas.bits)
+    history.add(key, new_hash, canvas.bits)
+    if known == new_hash:
+        return None
+
+    before = history.get(key, known)
+    if before is None:
+        # Panel shows something we no longer have (or nothing yet): send the whole pane
+        return encode_delta(canvas, [(0, 0, canvas.width, canvas.height)], 0, new_hash)
+    return encode_delta(canvas, changed_rects(before, canvas.bits, canvas.width, canvas.height), known, new_hash)
+
+
+def to_pbm(canvas):
+    """Portable bitmap for eyeballing a frame (PBM uses 1 = black)"""
+    return b"P4\n%d %d\n" % (canvas.width, canvas.height) + bytes(b ^ 0xFF for b in canvas.bits)
+
+
+# --- Server ----------------------------------------------------------------------------------
+
+def make_handler(renderer, cache, history):
+    class FrameHandler(BaseHTTPRequestHandler):
+        def do_GET(self):
+            url = urlparse(self.path)
+            if url.path != "/frame":
+                self.send_error(404)
+                return
+            query = parse_qs(url.query)
+            try:
+                pane = query.get("pane", ["weather"])[0]
+                display_time = int(query.get("time", [int(time.time())])[0])
+                key = (int(round(float(query["latitude"][0]) * 10000)),
+                       int(round(float(query["longitude"][0]) * 10000)))
+                known = int(query["known"][0], 16) if "known" in query else None
+            except (KeyError, ValueError):
+                self.send_error(400, "latitude, longitude and time are required")
+                return
+
+            entry = cache.get(key)
+            if entry is None:
+                self.send_error(503, "No forecast for this location yet")
+                return
+
+            started = time.time()
+            fetched_at, forecast = entry
+            canvas = renderer.render(forecast, fetched_at, display_time, pane)
+            if known is None:
+                frame = encode_frame(canvas)
+            else:
+                # Panel sent the hash of the pane it shows: reply with the tiles that changed
+                frame = delta_response(canvas, known, history, (key, pane))
+                if frame is None:
+                    print(f"{pane} pane for {key} unchanged")
+                    self.send_response(304)
+                    self.end_headers()
+                    return
+            print(f"Rendered {pane} frame for {key}: {len(frame)} bytes in {(time.time() - started) * 1000:.0f} ms")
+
+            self.send_response(200)
+            self.send_header("Content-Type", "application/octet-stream")
+            self.send_header("Content-Length", str(len(frame)))
+            self.end_headers()
+            self.wfile.write(frame)
+
+    return FrameHandler
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Reference frame renderer for trmnl-view panels")
+    parser.add_argument("--port", type=int, default=8090)
+    parser.add_argument("--fonts", default=DEFAULT_FONTS, help="Adafruit GFX Fonts directory")
+    parser.add_argument("--ttl", type=int, default=15 * 60, help="Seconds before a location is refetched")
+    parser.add_argument("--unit", default="fahrenheit", choices=["fahrenheit", "celsius"])
+    parser.add_argument("--fixture", help="Render a saved Open-Meteo response instead of serving")
+    parser.add_argument("--time", type=int, default=int(time.time()), help="Display time for --fixture")
+    parser.add_argument("--pane", default="weather", choices=["weather", "full"])
+    parser.add_argument("--out", help="Output for --fixture (.pbm for a viewable image, otherwise a frame)")
+    parser.add_argument("--since", type=int, help="With --fixture, write the tile delta from the pane at this time")
+    args = parser.parse_args()
+
+    renderer = Renderer(args.fonts)
+
+    if args.fixture:
+        with open(args.fixture) as f:
+            forecast = json.load(f)
+        canvas = renderer.render(forecast, args.time, args.time, args.pane)
+        if args.since is not None:
+            before = renderer.render(forecast, args.since, args.since, args.pane)
+            rects = changed_rects(before.bits, canvas.bits, canvas.width, canvas.height)
+            data = encode_delta(canvas, rects, image_hash(before.bits), image_hash(canvas.bits))
+        elif args.out and args.out.endswith(".pbm"):
+            data = to_pbm(canvas)
+        else:
+            data = encode_frame(canvas)
+        with open(args.out or "frame.bin", "wb") as f:
+            f.write(data)
+        print(f"Wrote {len(data)} bytes to {args.out or 'frame.bin'}")
+        return
+
+    cache = LocationCache(args.ttl, UPSTREAM_URL, args.unit)
+    server = ThreadingHTTPServer(("0.0.0.0", args.port), make_handler(renderer, cache, PaneHistory()))
+    print(f"Render server listening on http://0.0.0.0:{args.port}/frame")
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+"""
+Subset the Adafruit GFX fonts to the characters the firmware can draw.
+
+The display code draws a handful of strings per font (day and month names, digits, "Battery:",
+"a"/"p" ...), yet linking Fonts/*.h pulls in all 95 printable ASCII glyphs of each. This
+scans the drawing code for the text every font can be asked to render and writes
+src/font_subsets.h: one GFXfont per UI font holding only those glyphs' bitmaps.
+
+Which text belongs to which font comes from the sources:
+  - string literals in each display*.cpp function that calls setFont(FONT_...), plus the
+    literals of the helpers it calls that don't pick a font themselves
+  - literal arguments passed to those functions from anywhere in src/ (showError("WiFi Failed"))
+  - string #defines from config.h a drawing function uses (WEATHER_CAROUSEL_NAMES)
+  - month and day names behind strftime's %b / %a / %B / %A
+  - digits, '-' and ' ' for every font (numbers come from TextFormat at run time)
+
+The subset keeps GFX's glyph indexing (glyph[c - first]) so Adafruit_GFX, TextLayout and
+TextRaster use it unchanged: the first..last range shrinks to the characters in use, and
+glyphs inside it that are never drawn keep their advance but lose their bitmap. Before
+writing, every string found is rendered with the full and the subset font and the results
+compared, so the subset draws exactly the same pixels.
+
+USAGE:
+    python3 scripts/subset_fonts.py [--fonts <Adafruit GFX Library>/Fonts] [--list]
+
+    PlatformIO runs it before every build (extra_scripts in platformio.ini), so the subset
+    follows code and config.h changes; src/font_subsets.h is only rewritten when it changes.
+
+REQUIREMENTS:
+    Python 3.8+ standard library only.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+# PlatformIO runs extra scripts from the project directory without __file__
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)) if "__file__" in globals() else os.path.abspath("scripts"))
+from render_server import DAYS_LONG, DAYS_SHORT, DEFAULT_FONTS, MONTHS, SRC, Canvas, GfxFont  # noqa: E402
+
+OUTPUT = os.path.join(SRC, "font_subsets.h")
+DRAWING_SOURCES = ["display.cpp", "display_clock.cpp", "display_weather.cpp"]
+
+# UiFont id (display.h) -> Adafruit font
+FONTS = {
+    "FONT_SANS_9": "FreeSans9pt7b",
+    "FONT_SANS_BOLD_12": "FreeSansBold12pt7b",
+    "FONT_MONO_BOLD_24": "FreeMonoBold24pt7b",
+}
+ALWAYS = "0123456789- "
+MONTHS_LONG = ["January", "February", "March", "April", "May", "June", "July", "August", "September", "October",
+               "November", "December"]
+STRFTIME = {"a": DAYS_SHORT, "A": DAYS_LONG, "b": MONTHS, "B": MONTHS_LONG}
+
+
+def read(name):
+    # One character per byte, so text compares with glyph codes directly (UTF-8 falls outside)
+    with open(os.path.join(SRC, name), encoding="latin-1") as f:
+        return f.read()
+
+
+def strip_comments(text):
+    return re.sub(r"//[^\n]*|/\*.*?\*/", "", text, flags=re.S)
+
+
+def literals(text):
+    """String literals outside Serial logging and strftime formats, C escapes resolved"""
+    text = re.sub(r"Serial\.\w+\([^;]*;", "", text)
+    text = re.sub(r"strftime\([^;]*;", "", text)
+    return [s.encode("latin-1").decode("unicode_escape") for s in re.findall(r'"((?:[^"\\\n]|\\.)*)"', text)]
+
+
+def strftime_text(text):
+    """Everything strftime formats in text can produce, minus the digits every font has"""
+    out = []
+    for fmt in re.findall(r'strftime\([^;]*?"((?:[^"\\]|\\.)*)"', text):
+        out.append(re.sub(r"%.", "", fmt))
+        for spec in re.findall(r"%(.)", fmt):
+            out.extend(STRFTIME.get(spec, []))
+    return out
+
+
+def functions(text):
+    """{name: body} for the top-level function definitions in a source file"""
+    found = {}
+    for match in re.finditer(r"^\w[\w:<>&\* ]*?\b(\w+)\s*\([^;{]*\)\s*(?:const\s*)?(?::[^;{]*)?\{", text, re.M):
+        depth, i = 1, match.end()
+        while depth and i < len(text):
+            depth += {"{": 1, "}": -1}.get(text[i], 0)
+            i += 1
+        found.setdefault(match.group(1), "")
+        found[match.group(1)] += text[match.end():i - 1]
+    return found
+
+
+def string_defines():
+    return {name: value for name, value in re.findall(r'^#define (\w+) "([^"]*)"', read("config.h"), re.M)}
+
+
+def scan():
+    """{UiFont id: [strings the firmware can draw with it]}"""
+    bodies = {}
+    for name in DRAWING_SOURCES:
+        for function, body in functions(strip_comments(read(name))).items():
+            bodies[function] = bodies.get(function, "") + body
+    callers = "".join(strip_comments(read(name)) for name in sorted(os.listdir(SRC)) if name.endswith(".cpp"))
+    defines = string_defines()
+
+    def fonts_of(body):
+        return [f for f in re.findall(r"setFont\((FONT_\w+)\)", body) if f in FONTS]
+
+    def text_of(function, seen):
+        # Own text plus that of the helpers it calls that leave the font alone
+        body = bodies[function]
+        out = literals(body) + strftime_text(body)
+        out += [defines[d] for d in re.findall(r"\b[A-Z_]+\b", body) if d in defines]
+        for callee in set(re.findall(r"\b(\w+)\s*\(", body)):
+            if callee in bodies and callee not in seen and not fonts_of(bodies[callee]):
+                seen.add(callee)
+                out += text_of(callee, seen)
+        return out
+
+    texts = {font: [ALWAYS] for font in FONTS}
+    for function, body in bodies.items():
+        fonts = fonts_of(body)
+        if not fonts:
+            continue
+        text = text_of(function, {function})
+        text += literals("".join(re.findall(r"\b" + function + r"\s*\([^;]*;", callers)))
+        for font in fonts:
+            texts[font] += text
+    return texts
+
+
+def used_glyphs(font, text):
+    return sorted({ord(c) for s in text for c in s if font.glyph(ord(c)) is not None})
+
+
+def subset(font, used):
+    """GfxFont with only the used glyphs; unused ones inside the range keep their advance"""
+    out = GfxFont.__new__(GfxFont)
+    out.first, out.last, out.y_advance = used[0], used[-1], font.y_advance
+    out.bitmap = b""
+    out.glyphs = []
+    for c in range(out.first, out.last + 1):
+        offset, w, h, advance, xo, yo = font.glyph(c)
+        if c in used:
+            out.glyphs.append((len(out.bitmap), w, h, advance, xo, yo))
+            out.bitmap += font.bitmap[offset:offset + (w * h + 7) // 8]
+        else:
+            out.glyphs.append((0, 0, 0, advance, xo, yo))
+    return out
+
+
+def verify(full, sub, text):
+    """Each string renders to the same pixels with both fonts"""
+    for s in set(text):
+        images = []
+        for font in (full, sub):
+            canvas = Canvas(0, 0, 8 * (len(s.encode("utf-8")) * 6 + 8), 3 * font.y_advance)
+            canvas.print(font, 8, 2 * font.y_advance, s)
+            images.append(bytes(canvas.bits))
+        if images[0] != images[1] or full.text_width(s) != sub.text_width(s):
+            sys.exit(f"Subset renders {s!r} differently")
+
+
+def font_source(name, font, chars):
+    rows = []
+    for i in range(0, len(font.bitmap), 12):
+        rows.append("  " + ", ".join(f"0x{b:02X}" for b in font.bitmap[i:i + 12]))
+    glyphs = []
+    for c, g in zip(range(font.first, font.last + 1), font.glyphs):
+        glyphs.append("  {{{:6d}, {:3d}, {:3d}, {:3d}, {:4d}, {:4d}}}".format(*g) + f"  // 0x{c:02X} {chr(c)!r}")
+    return (f"// {name}: {len(chars)} of 95 glyphs {chars!r}\n"
+            f"const uint8_t {name}SubsetBitmaps[] PROGMEM = {{\n" + ",\n".join(rows or ["  0x00"]) + "};\n\n"
+            f"const GFXglyph {name}SubsetGlyphs[] PROGMEM = {{\n" + ",\n".join(glyphs) + "};\n\n"
+            f"const GFXfont {name}Subset PROGMEM = {{(uint8_t *){name}SubsetBitmaps, (GFXglyph *){name}SubsetGlyphs, "
+            f"0x{font.first:02X}, 0x{font.last:02X}, {font.y_advance}}};\n")
+
+
+def build(fonts_dir):
+    """(header text, [(font name, full bytes, subset bytes, characters)])"""
+    texts = scan()
+    parts, report = [], []
+    for ui_font, name in FONTS.items():
+        full = GfxFont(os.path.join(fonts_dir, name + ".h"))
+        used = used_glyphs(full, texts[ui_font])
+        sub = subset(full, used)
+        verify(full, sub, texts[ui_font])
+        chars = "".join(chr(c) for c in used)
+        parts.append(font_source(name, sub, chars))
+        report.append((name, len(full.bitmap) + 8 * len(full.glyphs), len(sub.bitmap) + 8 * len(sub.glyphs), chars))
+    header = ("// Generated by scripts/subset_fonts.py from the Adafruit GFX fonts - do not edit, not checked in\n"
+              "// Glyphs the firmware never draws have no bitmap; rerun after adding text (PlatformIO does it\n"
+              "// before every build)\n\n"
+              "#ifndef FONT_SUBSETS_H\n#define FONT_SUBSETS_H\n\n#include <Adafruit_GFX.h>\n\n" +
+              "\n".join(parts) + "\n#endif // FONT_SUBSETS_H\n")
+    return header, report
+
+
+def write(fonts_dir, quiet=False):
+    header, report = build(fonts_dir)
+    old = None
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT) as f:
+            old = f.read()
+    if header != old:
+        with open(OUTPUT, "w") as f:
+            f.write(header)
+    if not quiet or header != old:
+        for name, full, sub, chars in report:
+            print(f"{name}: {full} -> {sub} bytes ({len(chars)} glyphs)")
+    return report
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--fonts", default=DEFAULT_FONTS, help="Adafruit GFX Fonts directory")
+    parser.add_argument("--list", action="store_true", help="Print the strings found per font and exit")
+    args = parser.parse_args()
+
+    if args.list:
+        for ui_font, text in scan().items():
+            print(f"{FONTS[ui_font]}: {sorted(set(text))}")
+        return
+    write(args.fonts)
+
+
+try:
+    Import  # noqa: F821 - defined when PlatformIO runs this as a pre: extra script
+except NameError:
+    if __name__ == "__main__":
+        main()
+else:
+    Import("env")  # noqa: F821
+    write(os.path.join(env.subst("$PROJECT_LIBDEPS_DIR"), env.subst("$PIOENV"), "Adafruit GFX Library", "Fonts"),  # noqa: F821
+          quiet=True)
@@ -0,0 +1,355 @@
+#!/usr/bin/env python3
+"""
+Fleet telemetry collector for trmnl-view panels.
+
+Panels keep a metrics record for every wake in RTC memory and POST them to /telemetry as one
+batch, in the format documented in src/telemetry.h, on the wakes where the radio is already
+up for weather. Each batch is decoded and appended to <log>/<mac>.jsonl, one wake per line.
+GET /summary returns per-panel aggregates as JSON; --summary prints them from the logs.
+
+USAGE:
+    python3 scripts/telemetry_collector.py [--port 8060] [--log telemetry]
+    python3 scripts/telemetry_collector.py --summary [--log telemetry]
+
+    Panels: set TELEMETRY_URL in src/config.h.
+
+    Check the decoder and aggregates against a stand-in fleet posting over local HTTP:
+    python3 scripts/telemetry_collector.py --self-test
+
+REQUIREMENTS:
+    Python 3.8+ standard library only
+"""
+
+import argparse
+import json
+import os
+import random
+import statistics
+import sys
+import tempfile
+import threading
+import urllib.error
+import urllib.request
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+BATCH_VERSION = 1
+HEADER_SIZE = 12
+# WakeMetrics fields in batch column order
+FIELDS = ["started_at", "awake_ms", "radio_ms", "fetch_ms", "refresh_ms", "battery_x10",
+          "rssi", "kind", "refreshes", "retries", "fetch", "reset_cause"]
+KINDS = ["clock", "prefetch", "fresh_boot"]
+FETCH_RESULTS = [None, "failed", "updated", "not_modified"]  # WakeMetrics.fetch is FetchResult + 1
+RESET_CAUSES = ["power_on", "deep_sleep", "restart", "crash", "brownout"]
+
+
+class BatchError(ValueError):
+    pass
+
+
+def read_varint(data, pos):
+    value, shift = 0, 0
+    while pos < len(data) and shift < 64:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if byte & 0x80 == 0:
+            return value, pos
+        shift += 7
+    raise BatchError("truncated varint")
+
+
+def varint(value):
+    out = bytearray()
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+    return out
+
+
+def decode_batch(data):
+    """(mac, dropped, [record dict]) from a batch, as Telemetry::decode reads it"""
+    if len(data) < HEADER_SIZE or data[0:2] != b"TM" or data[2] != BATCH_VERSION:
+        raise BatchError("bad header")
+    count = data[3]
+    mac = ":".join(f"{b:02x}" for b in data[4:10])
+    dropped = data[10] | (data[11] << 8)
+    records = [{} for _ in range(count)]
+
+    pos = HEADER_SIZE
+    for column, name in enumerate(FIELDS):
+        previous, previous_diff, zeros = 0, 0, 0
+        for i in range(count):
+            residual = 0
+            if zeros > 0:
+                zeros -= 1
+            else:
+                word, pos = read_varint(data, pos)
+                if word == 0:
+                    zeros, pos = read_varint(data, pos)
+                    if zeros >= count - i:
+                        raise BatchError("zero run past the last record")
+                else:
+                    residual = (word >> 1) ^ -(word & 1)
+            diff = previous_diff + residual if column == 0 else residual
+            previous += diff
+            previous_diff = diff
+            records[i][name] = previous
+    if pos != len(data):
+        raise BatchError("trailing bytes")
+    return mac, dropped, records
+
+
+def encode_batch(mac, dropped, records):
+    """Batch as Telemetry::encode makes it, for the stand-in panels"""
+    out = bytearray(b"TM")
+    out += bytes([BATCH_VERSION, len(records)])
+    out += bytes(int(part, 16) for part in mac.split(":"))
+    out += bytes([dropped & 0xFF, dropped >> 8])
+    for column, name in enumerate(FIELDS):
+        previous, previous_diff, zeros = 0, 0, 0
+        for record in records:
+            diff = record[name] - previous
+            residual = diff - previous_diff if column == 0 else diff
+            previous, previous_diff = record[name], diff
+            if residual == 0:
+                zeros += 1
+                continue
+            if zeros:
+                out += varint(0) + varint(zeros - 1)
+                zeros = 0
+            out += varint(residual << 1 if residual >= 0 else (-residual << 1) - 1)
+        if zeros:
+            out += varint(0) + varint(zeros - 1)
+    return bytes(out)
+
+
+def median(values):
+    return statistics.median(values) if values else None
+
+
+def summarize(wakes, dropped):
+    """Aggregates for one panel's logged wakes"""
+    fetches = [w for w in wakes if w["fetch"]]
+    radio = [w for w in wakes if w["rssi"]]
+    dated = [w for w in wakes if w["started_at"]]
+    summary = {
+        "wakes": len(wakes),
+        "dropped": dropped,
+        "by_kind": {kind: sum(1 for w in wakes if w["kind"] == i) for i, kind in enumerate(KINDS)},
+        "fetches": len(fetches),
+        "fetch_failure_rate": round(sum(1 for w in fetches if w["fetch"] == 1) / len(fetches), 3) if fetches else None,
+        "refreshes": sum(w["refreshes"] for w in wakes),
+        "retries": sum(w["retries"] for w in wakes),
+        "resets": {},
+        "median_ms": {},
+        "rssi_min": min(w["rssi"] for w in radio) if radio else None,
+        "rssi_avg": round(sum(w["rssi"] for w in radio) / len(radio), 1) if radio else None,
+        "battery_per_hour": None,
+        "last_seen": max(w["started_at"] for w in dated) if dated else None,
+    }
+    for w in wakes:
+        if w["kind"] == KINDS.index("fresh_boot"):
+            cause = RESET_CAUSES[w["reset_cause"]] if w["reset_cause"] < len(RESET_CAUSES) else str(w["reset_cause"])
+            summary["resets"][cause] = summary["resets"].get(cause, 0) + 1
+    for i, kind in enumerate(KINDS):
+        of_kind = [w for w in wakes if w["kind"] == i]
+        if of_kind:
+            summary["median_ms"][kind] = {
+                phase: median([w[phase + "_ms"] for w in of_kind]) for phase in ("awake", "radio", "fetch", "refresh")
+            }
+
+    # Least-squares battery slope in percent per hour
+    points = [(w["started_at"] / 3600.0, w["battery_x10"] / 10.0) for w in dated if w["battery_x10"]]
+    if len(points) >= 2:
+        mean_t = sum(t for t, _ in points) / len(points)
+        mean_b = sum(b for _, b in points) / len(points)
+        spread = sum((t - mean_t) ** 2 for t, _ in points)
+        if spread > 0:
+            slope = sum((t - mean_t) * (b - mean_b) for t, b in points) / spread
+            summary["battery_per_hour"] = round(slope, 3)
+    return summary
+
+
+class Collector:
+    """Per-panel wake logs: one JSON line per wake, plus the dropped count from each batch"""
+
+    def __init__(self, directory):
+        self.directory = directory
+        self.lock = threading.Lock()
+        os.makedirs(directory, exist_ok=True)
+
+    def path(self, mac):
+        return os.path.join(self.directory, mac.replace(":", "") + ".jsonl")
+
+    def add(self, batch):
+        mac, dropped, records = decode_batch(batch)
+        with self.lock, open(self.path(mac), "a") as f:
+            if dropped:
+                f.write(json.dumps({"dropped": dropped}) + "\n")
+            for record in records:
+                f.write(json.dumps(record) + "\n")
+        return mac, len(records)
+
+    def summary(self):
+        panels = {}
+        with self.lock:
+            for name in sorted(os.listdir(self.directory)):
+                if not name.endswith(".jsonl"):
+                    continue
+                wakes, dropped = [], 0
+                with open(os.path.join(self.directory, name)) as f:
+                    for line in f:
+                        entry = json.loads(line)
+                        if "dropped" in entry:
+                            dropped += entry["dropped"]
+                        else:
+                            wakes.append(entry)
+                mac = ":".join(name[i:i + 2] for i in range(0, 12, 2))
+                panels[mac] = summarize(wakes, dropped)
+        return panels
+
+
+def make_handler(collector, quiet=False):
+    class TelemetryHandler(BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"  # Panels keep the weather connection alive for the upload
+
+        def reply(self, status, body=b"", content_type="text/plain"):
+            self.send_response(status)
+            self.send_header("Content-Type", content_type)
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+
+        def log_message(self, format, *args):
+            if not quiet:
+                super().log_message(format, *args)
+
+        def do_POST(self):
+            if self.path != "/telemetry":
+                self.reply(404, b"not found")
+                return
+            body = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+            try:
+                mac, count = collector.add(body)
+            except BatchError as e:
+                self.reply(400, str(e).encode())
+                return
+            if not quiet:
+                print(f"{mac}: {count} wake(s) in {len(body)} bytes")
+            self.reply(204)
+
+        def do_GET(self):
+            if self.path == "/summary":
+                self.reply(200, json.dumps(collector.summary(), indent=2).encode(), "application/json")
+            else:
+                self.reply(404, b"not found")
+
+    return TelemetryHandler
+
+
+def stand_in_fleet(url, panels=3, hours=6):
+    """Panels that wake every minute, prefetch weather every 15 and post their ring then.
+    Returns the wakes each one sent, keyed by MAC."""
+    sent = {}
+    rng = random.Random(7)
+    for n in range(panels):
+        mac = f"24:0a:c4:00:00:{n + 1:02x}"
+        ring, sent[mac] = [], []
+        battery = 900 - n * 50
+        start = 1760000000 + n * 7
+        for minute in range(hours * 60):
+            now = start + minute * 60
+            if minute == 0:
+                ring.append({"started_at": now, "awake_ms": 6100, "radio_ms": 3300, "fetch_ms": 1400,
+                             "refresh_ms": 2100, "battery_x10": battery, "rssi": -60 - n * 5, "kind": 2,
+                             "refreshes": 1, "retries": 2, "fetch": 2, "reset_cause": 0})
+            battery -= 1 if minute % 12 == 0 else 0
+            ring.append({"started_at": now + 1, "awake_ms": 300 + rng.randrange(40), "radio_ms": 0, "fetch_ms": 0,
+                         "refresh_ms": 280, "battery_x10": battery, "rssi": 0, "kind": 0, "refreshes": 1,
+                         "retries": 0, "fetch": 0, "reset_cause": 1})
+            if minute % 15 == 14:
+                failed = n == 2 and minute % 60 == 14  # The weak-signal panel loses one fetch an hour
+                ring.append({"started_at": now + 30, "awake_ms": 4000 + rng.randrange(500),
+                             "radio_ms": 2800 + rng.randrange(300), "fetch_ms": 1100, "refresh_ms": 0,
+                             "battery_x10": battery, "rssi": -60 - n * 5 - rng.randrange(6), "kind": 1,
+                             "refreshes": 0, "retries": rng.randrange(4), "fetch": 1 if failed else 3,
+                             "reset_cause": 1})
+                batch = encode_batch(mac, 0, ring)
+                request = urllib.request.Request(url + "/telemetry", data=batch, method="POST",
+                                                 headers={"Content-Type": "application/octet-stream"})
+                with urllib.request.urlopen(request) as response:
+                    if response.status != 204:
+                        raise AssertionError(f"upload answered {response.status}")
+                sent[mac] += ring
+                ring = []
+    return sent
+
+
+def self_test():
+    with tempfile.TemporaryDirectory() as directory:
+        collector = Collector(directory)
+        server = ThreadingHTTPServer(("127.0.0.1", 0), make_handler(collector, quiet=True))
+        threading.Thread(target=server.serve_forever, daemon=True).start()
+        url = f"http://127.0.0.1:{server.server_address[1]}"
+        try:
+            sent = stand_in_fleet(url)
+
+            request = urllib.request.Request(url + "/telemetry", data=b"TM\x01\x05garbage", method="POST")
+            try:
+                urllib.request.urlopen(request)
+                raise AssertionError("malformed batch accepted")
+            except urllib.error.HTTPError as e:
+                assert e.code == 400, e.code
+
+            with urllib.request.urlopen(url + "/summary") as response:
+                summary = json.loads(response.read())
+        finally:
+            server.shutdown()
+
+        assert sorted(summary) == sorted(sent), summary.keys()
+        for mac, wakes in sent.items():
+            logged = [json.loads(line) for line in open(collector.path(mac))]
+            assert logged == wakes, f"{mac}: logged wakes differ from the ones sent"
+            panel = summary[mac]
+            assert panel == summarize(wakes, 0)
+            assert panel["wakes"] == len(wakes)
+            assert panel["by_kind"]["fresh_boot"] == 1 and panel["resets"] == {"power_on": 1}
+            assert panel["battery_per_hour"] < 0
+            print(f"{mac}: {panel['wakes']} wakes, fetch failures {panel['fetch_failure_rate']}, "
+                  f"rssi {panel['rssi_min']}/{panel['rssi_avg']}, battery {panel['battery_per_hour']}%/h")
+        assert summary["24:0a:c4:00:00:03"]["fetch_failure_rate"] > 0
+        assert summary["24:0a:c4:00:00:01"]["fetch_failure_rate"] == 0
+
+        sizes = [len(encode_batch("24:0a:c4:00:00:01", 0, sent["24:0a:c4:00:00:01"][i:i + 16]))
+                 for i in range(1, 6 * 16, 16)]
+        print(f"A 15-minute batch (16 wakes) is {min(sizes)}-{max(sizes)} bytes, 320 unpacked")
+    print("Self-test passed")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Fleet telemetry collector for trmnl-view panels")
+    parser.add_argument("--port", type=int, default=8060)
+    parser.add_argument("--log", default=os.path.join(REPO, "telemetry"), help="Directory of per-panel wake logs")
+    parser.add_argument("--summary", action="store_true", help="Print per-panel aggregates from the logs and exit")
+    parser.add_argument("--self-test", action="store_true", help="Run a stand-in fleet against a local collector")
+    args = parser.parse_args()
+
+    if args.self_test:
+        self_test()
+        return
+    collector = Collector(args.log)
+    if args.summary:
+        json.dump(collector.summary(), sys.stdout, indent=2)
+        print()
+        return
+
+    server = ThreadingHTTPServer(("0.0.0.0", args.port), make_handler(collector))
+    print(f"Telemetry collector listening on http://0.0.0.0:{args.port}/telemetry, logs in {args.log}")
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+"""
+LAN weather gateway for trmnl-view panels.
+
+Fetches Open-Meteo once per location, caches the forecast and answers panels over
+UDP with the compact binary layout from src/gateway_protocol.h (a 69-byte reply instead of
+a multi-kilobyte HTTPS JSON response per panel).
+
+USAGE:
+    python3 scripts/weather_gateway.py [--port 4210] [--ttl 900]
+
+    Then on each panel set in src/config.h:
+        #define WEATHER_GATEWAY_ENABLED 1
+        #define WEATHER_GATEWAY_HOST "<this machine's LAN IP>"
+
+REQUIREMENTS:
+    Python 3.8+ standard library only
+"""
+
+import argparse
+import json
+import socket
+import struct
+import threading
+import time
+import urllib.request
+from datetime import date
+
+UPSTREAM_URL = "https://api.open-meteo.com/v1/forecast"
+
+MAGIC = b"TW"
+VERSION = 1
+TYPE_REQUEST = 1
+TYPE_WEATHER = 2
+TYPE_NOT_MODIFIED = 3
+TYPE_ERROR = 4
+
+REQUEST = struct.Struct("<2sBBHbBiiI")
+HEADER = struct.Struct("<2sBBHH")
+HOURLY = struct.Struct("<BhB")
+DAILY = struct.Struct("<BhhB")
+
+# WeatherCondition values from src/types.h
+WEATHER_UNKNOWN, WEATHER_CLEAR, WEATHER_CLOUDY, WEATHER_OVERCAST = 0, 1, 2, 3
+WEATHER_FOGGY, WEATHER_RAIN, WEATHER_SNOW, WEATHER_THUNDER = 4, 5, 6, 7
+
+
+def weather_condition(code):
+    """Same mapping as NetworkManager::getWeatherCondition"""
+    if code in (0, 1):
+        return WEATHER_CLEAR
+    if code == 2:
+        return WEATHER_CLOUDY
+    if code == 3:
+        return WEATHER_OVERCAST
+    if code in (45, 48):
+        return WEATHER_FOGGY
+    if 51 <= code <= 67:
+        return WEATHER_RAIN
+    if 71 <= code <= 87:
+        return WEATHER_SNOW
+    if 90 <= code <= 99:
+        return WEATHER_THUNDER
+    return WEATHER_UNKNOWN
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h ^= b
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h or 1
+
+
+def tenths(value):
+    return int(round((value or 0.0) * 10))
+
+
+def extract_weather(forecast, display_hour):
+    """Reduce an Open-Meteo response to the WeatherData fields, like parseWeatherJson"""
+    current = forecast["current"]
+    hourly = forecast["hourly"]
+    daily = forecast["daily"]
+
+    # Hourly columns start at the next hour
+    start = display_hour + 1
+    if start >= len(hourly["temperature_2m"]):
+        start = 0
+
+    weather = {
+        "current_temp": current.get("temperature_2m") or 0.0,
+        "condition": weather_condition(current.get("weather_code") or 0),
+        "humidity": int(current.get("relative_humidity_2m") or 0),
+        "wind_speed": int(current.get("wind_speed_10m") or 0),
+        "hourly": [],
+        "daily": [],
+    }
+
+    for i in range(6):
+        index = start + i
+        if index < len(hourly["temperature_2m"]):
+            weather["hourly"].append((int(hourly["time"][index][11:13]), hourly["temperature_2m"][index] or 0.0,
+                                      weather_condition(hourly["weather_code"][index] or 0)))
+        else:
+            weather["hourly"].append((0, 0.0, WEATHER_UNKNOWN))
+
+    for i in range(4):
+        if i < len(daily["temperature_2m_max"]):
+            day_of_week = (date.fromisoformat(daily["time"][i]).weekday() + 1) % 7  # 0=Sun
+            weather["daily"].append((day_of_week, daily["temperature_2m_max"][i] or 0.0,
+                                     daily["temperature_2m_min"][i] or 0.0,
+                                     weather_condition(daily["weather_code"][i] or 0)))
+        else:
+            weather["daily"].append((0, 0.0, 0.0, WEATHER_UNKNOWN))
+
+    return weather
+
+
+def encode_payload(forecast, fetched_at, display_hour):
+    """Build the 61-byte weather payload for a panel showing display_hour"""
+    weather = extract_weather(forecast, display_hour)
+
+    body = bytearray()
+    body += struct.pack("<hBBB", tenths(weather["current_temp"]), weather["condition"],
+                        weather["humidity"] & 0xFF, weather["wind_speed"] & 0xFF)
+    for hour, temp, condition in weather["hourly"]:
+        body += HOURLY.pack(hour, tenths(temp), condition)
+    for day_of_week, high, low, condition in weather["daily"]:
+        body += DAILY.pack(day_of_week, tenths(high), tenths(low), condition)
+
+    content_hash = fnv1a(body)
+    return struct.pack("<II", fetched_at, content_hash) + bytes(body), content_hash
+
+
+class LocationCache:
+    """One upstream forecast per location, refreshed in the background when stale"""
+
+    def __init__(self, ttl, upstream, unit):
+        self.ttl = ttl
+        self.upstream = upstream
+        self.unit = unit
+        self.entries = {}  # (lat_e4, lon_e4) -> (fetched_at, forecast)
+        self.refreshing = set()
+        self.lock = threading.Lock()
+        self.upstream_fetches = 0
+
+    def fetch_upstream(self, key):
+        lat, lon = key[0] / 10000.0, key[1] / 10000.0
+        url = (f"{self.upstream}?latitude={lat:.4f}&longitude={lon:.4f}"
+               "&current=temperature_2m,relative_humidity_2m,weather_code"
+               "&hourly=temperature_2m,weather_code"
+               "&daily=temperature_2m_max,temperature_2m_min,weather_code"
+               f"&temperature_unit={self.unit}&timezone=auto&forecast_days=5")
+        with urllib.request.urlopen(url, timeout=10) as response:
+            forecast = json.load(response)
+        with self.lock:
+            self.entries[key] = (int(time.time()), forecast)
+            self.upstream_fetches += 1
+        print(f"Upstream fetch for {lat:.4f},{lon:.4f} ({self.upstream_fetches} total)")
+
+    def refresh_in_background(self, key):
+        def run():
+            try:
+                self.fetch_upstream(key)
+            except Exception as e:  # Keep serving the stale forecast
+                print(f"Upstream refresh failed for {key}: {e}")
+            finally:
+                with self.lock:
+                    self.refreshing.discard(key)
+
+        with self.lock:
+            if key in self.refreshing:
+                return
+            self.refreshing.add(key)
+        threading.Thread(target=run, daemon=True).start()
+
+    def get(self, key):
+        with self.lock:
+            entry = self.entries.get(key)
+        if entry is None:
+            # First panel for this location waits for the fetch; it retries on timeout anyway
+            try:
+                self.fetch_upstream(key)
+            except Exception as e:
+                print(f"Upstream fetch failed for {key}: {e}")
+                return None
+            with self.lock:
+                return self.entries.get(key)
+        if time.time() - entry[0] > self.ttl:
+            self.refresh_in_background(key)
+        return entry
+
+
+def handle(datagram, cache):
+    """Answer one request datagram; returns the response bytes or None to drop it"""
+    if len(datagram) != REQUEST.size:
+        return None
+    magic, version, msg_type, sequence, display_hour, _, lat, lon, known_hash = REQUEST.unpack(datagram)
+    if magic != MAGIC or version != VERSION or msg_type != TYPE_REQUEST or not 0 <= display_hour < 24:
+        return None
+
+    entry = cache.get((lat, lon))
+    if entry is None:
+        return HEADER.pack(MAGIC, VERSION, TYPE_ERROR, sequence, 0)
+
+    fetched_at, forecast = entry
+    try:
+        payload, content_hash = encode_payload(forecast, fetched_at, display_hour)
+    except (KeyError, IndexError, TypeError, ValueError) as e:
+        print(f"Unexpected upstream format: {e}")
+        return HEADER.pack(MAGIC, VERSION, TYPE_ERROR, sequence, 0)
+
+    if known_hash == content_hash:
+        return HEADER.pack(MAGIC, VERSION, TYPE_NOT_MODIFIED, sequence, 0)
+    return HEADER.pack(MAGIC, VERSION, TYPE_WEATHER, sequence, len(payload)) + payload
+
+
+def main():
+    parser = argparse.ArgumentParser(description="LAN weather gateway for trmnl-view panels")
+    parser.add_argument("--port", type=int, default=4210, help="UDP port (WEATHER_GATEWAY_PORT)")
+    parser.add_argument("--ttl", type=int, default=15 * 60, help="Seconds before a location is refetched")
+    parser.add_argument("--upstream", default=UPSTREAM_URL, help="Open-Meteo forecast endpoint")
+    parser.add_argument("--unit", default="fahrenheit", choices=["fahrenheit", "celsius"])
+    args = parser.parse_args()
+
+    cache = LocationCache(args.ttl, args.upstream, args.unit)
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("0.0.0.0", args.port))
+    print(f"Weather gateway listening on UDP {args.port} (ttl {args.ttl}s)")
+
+    while True:
+        datagram, address = sock.recvfrom(512)
+        response = handle(datagram, cache)
+        if response is not None:
+            sock.sendto(response, address)
+
+
+if __name__ == "__main__":
+    main()
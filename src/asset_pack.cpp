@@ -0,0 +1,239 @@
+#include "asset_pack.h"
+#include <cstring>
+
+const size_t FONT_HEADER_SIZE = 12;
+const size_t GLYPH_SIZE = 8;
+
+static_assert(sizeof(GFXglyph) == GLYPH_SIZE, "Pack glyph tables are used in place as GFXglyph");
+
+static uint16_t le16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t le32(const uint8_t *p)
+{
+    return (uint32_t)le16(p) | ((uint32_t)le16(p + 2) << 16);
+}
+
+static void storeLe16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void storeLe32(uint8_t *p, uint32_t v)
+{
+    storeLe16(p, (uint16_t)v);
+    storeLe16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint32_t fnv1a(const uint8_t *bytes, size_t length, uint32_t hash = 2166136261u)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+uint32_t AssetPack::nameHash(const char *name)
+{
+    return fnv1a((const uint8_t *)name, strlen(name));
+}
+
+bool AssetPack::begin(const uint8_t *blob, size_t size, bool verifyChecksum)
+{
+    data = nullptr;
+    if (blob == nullptr || size < ASSET_PACK_HEADER_SIZE || blob[0] != 'T' || blob[1] != 'A' ||
+        blob[2] != ASSET_PACK_VERSION)
+    {
+        return false;
+    }
+
+    uint32_t length = le32(blob + 8);
+    int count = le16(blob + 4);
+    size_t indexEnd = ASSET_PACK_HEADER_SIZE + (size_t)count * ASSET_INDEX_ENTRY_SIZE;
+    if (length > size || length < indexEnd)
+    {
+        return false;
+    }
+
+    // Every payload inside the blob and aligned, so lookups need no further checks
+    for (int i = 0; i < count; i++)
+    {
+        const uint8_t *entry = blob + ASSET_PACK_HEADER_SIZE + i * ASSET_INDEX_ENTRY_SIZE;
+        uint32_t offset = le32(entry + 8);
+        uint32_t payload = le32(entry + 12);
+        if (offset % 4 != 0 || offset < indexEnd || offset > length || payload > length - offset)
+        {
+            return false;
+        }
+        if (entry[4] == ASSET_KIND_BITMAP && payload < 4)
+        {
+            return false;
+        }
+        if (entry[4] == ASSET_KIND_FONT)
+        {
+            const uint8_t *font = blob + offset;
+            if (payload < FONT_HEADER_SIZE || le16(font + 2) < le16(font))
+                return false;
+            size_t glyphs = (size_t)(le16(font + 2) - le16(font) + 1) * GLYPH_SIZE;
+            if (FONT_HEADER_SIZE + glyphs > payload || le32(font + 8) < FONT_HEADER_SIZE + glyphs ||
+                le32(font + 8) > payload)
+                return false;
+        }
+    }
+
+    if (verifyChecksum && fnv1a(blob + ASSET_PACK_HEADER_SIZE, length - ASSET_PACK_HEADER_SIZE) != le32(blob + 12))
+    {
+        return false;
+    }
+
+    data = blob;
+    blobLength = length;
+    entries = count;
+    return true;
+}
+
+const uint8_t *AssetPack::find(const char *name, uint8_t kind, uint32_t &length) const
+{
+    if (data == nullptr)
+    {
+        return nullptr;
+    }
+    uint32_t hash = nameHash(name);
+    for (int i = 0; i < entries; i++)
+    {
+        const uint8_t *entry = data + ASSET_PACK_HEADER_SIZE + i * ASSET_INDEX_ENTRY_SIZE;
+        if (le32(entry) == hash && entry[4] == kind)
+        {
+            length = le32(entry + 12);
+            return data + le32(entry + 8);
+        }
+    }
+    return nullptr;
+}
+
+bool AssetPack::bitmap(const char *name, PackedBitmap &out) const
+{
+    uint32_t length;
+    const uint8_t *payload = find(name, ASSET_KIND_BITMAP, length);
+    if (payload == nullptr || length - 4 > 0xFFFF)
+    {
+        return false;
+    }
+    out.width = le16(payload);
+    out.height = le16(payload + 2);
+    out.data = payload + 4;
+    out.length = (uint16_t)(length - 4);
+    return true;
+}
+
+bool AssetPack::font(const char *name, GFXfont &out) const
+{
+    uint32_t length;
+    const uint8_t *payload = find(name, ASSET_KIND_FONT, length);
+    if (payload == nullptr)
+    {
+        return false;
+    }
+    // GFX takes non-const pointers but only ever reads through them
+    out.first = le16(payload);
+    out.last = le16(payload + 2);
+    out.yAdvance = payload[4];
+    out.glyph = (GFXglyph *)(payload + FONT_HEADER_SIZE);
+    out.bitmap = (uint8_t *)(payload + le32(payload + 8));
+    return true;
+}
+
+AssetPackWriter::AssetPackWriter(uint8_t *out, size_t capacity, int count)
+    : out(out), capacity(capacity), count(count), pos(ASSET_PACK_HEADER_SIZE + (size_t)count * ASSET_INDEX_ENTRY_SIZE)
+{
+    if (pos > capacity)
+    {
+        overflow = true;
+        return;
+    }
+    memset(out, 0, pos);
+}
+
+uint8_t *AssetPackWriter::beginEntry(const char *name, uint8_t kind, size_t length)
+{
+    size_t offset = (pos + 3) & ~(size_t)3;
+    if (overflow || added >= count || offset + length > capacity)
+    {
+        overflow = true;
+        return nullptr;
+    }
+    memset(out + pos, 0, offset - pos);
+
+    uint8_t *entry = out + ASSET_PACK_HEADER_SIZE + added * ASSET_INDEX_ENTRY_SIZE;
+    storeLe32(entry, AssetPack::nameHash(name));
+    entry[4] = kind;
+    storeLe32(entry + 8, (uint32_t)offset);
+    storeLe32(entry + 12, (uint32_t)length);
+    added++;
+    pos = offset + length;
+    return out + offset;
+}
+
+bool AssetPackWriter::addBitmap(const char *name, const PackedBitmap &bitmap)
+{
+    uint8_t *payload = beginEntry(name, ASSET_KIND_BITMAP, 4 + (size_t)bitmap.length);
+    if (payload == nullptr)
+    {
+        return false;
+    }
+    storeLe16(payload, bitmap.width);
+    storeLe16(payload + 2, bitmap.height);
+    memcpy(payload + 4, bitmap.data, bitmap.length);
+    return true;
+}
+
+bool AssetPackWriter::addFont(const char *name, const GFXfont &font, size_t bitmapLength)
+{
+    size_t glyphs = (size_t)(font.last - font.first + 1);
+    size_t bitmapOffset = FONT_HEADER_SIZE + glyphs * GLYPH_SIZE;
+    uint8_t *payload = beginEntry(name, ASSET_KIND_FONT, bitmapOffset + bitmapLength);
+    if (payload == nullptr)
+    {
+        return false;
+    }
+    storeLe16(payload, font.first);
+    storeLe16(payload + 2, font.last);
+    payload[4] = font.yAdvance;
+    payload[5] = payload[6] = payload[7] = 0;
+    storeLe32(payload + 8, (uint32_t)bitmapOffset);
+    for (size_t i = 0; i < glyphs; i++)
+    {
+        const GFXglyph &g = font.glyph[i];
+        uint8_t *p = payload + FONT_HEADER_SIZE + i * GLYPH_SIZE;
+        storeLe16(p, g.bitmapOffset);
+        p[2] = g.width;
+        p[3] = g.height;
+        p[4] = g.xAdvance;
+        p[5] = (uint8_t)g.xOffset;
+        p[6] = (uint8_t)g.yOffset;
+        p[7] = 0;
+    }
+    memcpy(payload + bitmapOffset, font.bitmap, bitmapLength);
+    return true;
+}
+
+size_t AssetPackWriter::finish()
+{
+    if (overflow || added != count)
+    {
+        return 0;
+    }
+    out[0] = 'T';
+    out[1] = 'A';
+    out[2] = ASSET_PACK_VERSION;
+    out[3] = 0;
+    storeLe16(out + 4, (uint16_t)count);
+    storeLe16(out + 6, 0);
+    storeLe32(out + 8, (uint32_t)pos);
+    storeLe32(out + 12, fnv1a(out + ASSET_PACK_HEADER_SIZE, pos - ASSET_PACK_HEADER_SIZE));
+    return pos;
+}
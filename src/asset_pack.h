@@ -0,0 +1,117 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include "packed_bitmap.h"
+#include "text_layout.h"
+
+// Asset blob, as written by scripts/pack_assets.py into the "assets" flash partition
+//
+//   0  'T' 'A'   magic
+//   2  u8        version
+//   3  u8        reserved
+//   4  u16       entry count
+//   6  u16       reserved
+//   8  u32       blob length in bytes
+//   12 u32       FNV-1a of bytes 16 .. length
+//   16 index     count entries of 16 bytes:
+//                u32 FNV-1a of the asset name, u8 kind, 3 reserved, u32 offset, u32 length
+//   payloads     each at a multiple of 4 from the start of the blob
+//
+// ASSET_KIND_BITMAP payload: u16 width, u16 height, PackBits data (see packed_bitmap.h)
+// ASSET_KIND_FONT payload:   u16 first, u16 last, u8 yAdvance, 3 reserved, u32 bitmap offset
+//                            (from the payload), then last - first + 1 glyphs of 8 bytes laid
+//                            out like GFXglyph (u16 bitmapOffset, width, height, xAdvance,
+//                            xOffset, yOffset, pad), then the glyph bitmap
+//
+// Multi-byte fields are little-endian, the byte order of the C3, so glyph tables are used in
+// place. Assets are named like their built-in counterparts ("DIGIT_0_BITMAP", "cloud_40x40",
+// "FreeSans9pt7b").
+
+#define ASSET_PACK_VERSION 1
+#define ASSET_PACK_HEADER_SIZE 16
+#define ASSET_INDEX_ENTRY_SIZE 16
+#define ASSET_KIND_BITMAP 1
+#define ASSET_KIND_FONT 2
+
+// Reader over a blob that stays mapped (esp_partition_mmap on the device, mmap on host):
+// bitmaps and fonts point into the blob, nothing is copied.
+// Reads only the bytes it is handed, so tests open partitions they build in memory.
+class AssetPack
+{
+public:
+    /**
+     * Validate the header and index
+     * @param blob Start of the mapping
+     * @param size Mapped bytes (the partition may be larger than the blob)
+     * @param verifyChecksum Also hash the payloads (reads the whole blob)
+     * @return false if the blob is missing, another version, truncated or corrupt
+     */
+    bool begin(const uint8_t *blob, size_t size, bool verifyChecksum);
+
+    bool valid() const { return data != nullptr; }
+    int count() const { return entries; }
+    size_t length() const { return blobLength; }
+
+    /**
+     * Find a bitmap
+     * @param name Asset name
+     * @param out Points into the blob on success
+     * @return false if the pack has no bitmap of that name
+     */
+    bool bitmap(const char *name, PackedBitmap &out) const;
+
+    /**
+     * Find a font
+     * @param name Asset name
+     * @param out Bitmap and glyph table point into the blob on success
+     * @return false if the pack has no font of that name
+     */
+    bool font(const char *name, GFXfont &out) const;
+
+    /**
+     * FNV-1a of an asset name, as stored in the index
+     */
+    static uint32_t nameHash(const char *name);
+
+private:
+    const uint8_t *data = nullptr;
+    size_t blobLength = 0;
+    int entries = 0;
+
+    const uint8_t *find(const char *name, uint8_t kind, uint32_t &length) const;
+};
+
+// Blob writer for tests and host tools; scripts/pack_assets.py writes the same bytes
+class AssetPackWriter
+{
+public:
+    /**
+     * @param out Output buffer
+     * @param capacity Output capacity
+     * @param count Entries that will be added (the index is sized up front)
+     */
+    AssetPackWriter(uint8_t *out, size_t capacity, int count);
+
+    bool addBitmap(const char *name, const PackedBitmap &bitmap);
+    bool addFont(const char *name, const GFXfont &font, size_t bitmapLength);
+
+    /**
+     * Fill in the header
+     * @return Blob length, 0 if anything didn't fit or fewer entries were added than announced
+     */
+    size_t finish();
+
+private:
+    uint8_t *out;
+    size_t capacity;
+    int count;
+    int added = 0;
+    size_t pos;
+    bool overflow = false;
+
+    uint8_t *beginEntry(const char *name, uint8_t kind, size_t length);
+};
+
+#endif // ASSET_PACK_H
@@ -0,0 +1,67 @@
+#include "band_transfer.h"
+
+BandTransfer::BandTransfer(uint8_t *bufferA, uint8_t *bufferB, size_t capacity) : buffers{bufferA, bufferB}, size(capacity)
+{
+}
+
+void BandTransfer::partialWindow(const PanelSpi &spi, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    // Byte-aligned columns, inclusive ends
+    uint16_t xe = (uint16_t)((x + w - 1) | 0x0007);
+    uint16_t ye = (uint16_t)(y + h - 1);
+    x &= 0xFFF8;
+    const uint8_t window[9] = {(uint8_t)(x >> 8), (uint8_t)x, (uint8_t)(xe >> 8), (uint8_t)xe, (uint8_t)(y >> 8),
+                               (uint8_t)y,        (uint8_t)(ye >> 8), (uint8_t)ye, 0x01};
+
+    spi.command(spi.context, PANEL_CMD_PARTIAL_IN);
+    spi.command(spi.context, PANEL_CMD_PARTIAL_WINDOW);
+    spi.data(spi.context, window, sizeof(window));
+}
+
+void BandTransfer::begin(const PanelSpi &spi, uint8_t ram, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    link = spi;
+    next = 0;
+    inFlight = 0;
+    partialWindow(link, x, y, w, h);
+    link.command(link.context, ram);
+}
+
+uint8_t *BandTransfer::band()
+{
+    // With both buffers queued, the one handed out next is the older of the two
+    if (inFlight == 2)
+    {
+        link.waitOldest(link.context);
+        inFlight--;
+        waited++;
+    }
+    return buffers[next];
+}
+
+void BandTransfer::send(size_t length)
+{
+    if (inFlight == 2)
+    {
+        // send() without band(): the buffer may still be on the wire
+        link.waitOldest(link.context);
+        inFlight--;
+    }
+    if (length > 0)
+    {
+        link.queue(link.context, buffers[next], length);
+        inFlight++;
+        sent += (uint32_t)length;
+    }
+    next ^= 1;
+}
+
+void BandTransfer::end()
+{
+    while (inFlight > 0)
+    {
+        link.waitOldest(link.context);
+        inFlight--;
+    }
+    link.command(link.context, PANEL_CMD_PARTIAL_OUT);
+}
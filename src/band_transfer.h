@@ -0,0 +1,91 @@
+#ifndef BAND_TRANSFER_H
+#define BAND_TRANSFER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Panel controller (UC8179 on the GxEPD2_750_T7) commands for a partial window write, the
+// sequence GxEPD2_750_T7::writeImage sends
+#define PANEL_CMD_PARTIAL_WINDOW 0x90 // xs, xe, ys, ye as big-endian u16, then 0x01
+#define PANEL_CMD_PARTIAL_IN 0x91
+#define PANEL_CMD_PARTIAL_OUT 0x92
+#define PANEL_RAM_OLD 0x10 // Image the next differential refresh starts from
+#define PANEL_RAM_NEW 0x13 // Image the next refresh shows
+
+// SPI link to the controller. On the device this is the SPI master with DMA (panel_dma.h);
+// tests record the byte stream.
+struct PanelSpi
+{
+    void *context;
+    void (*command)(void *context, uint8_t command);                     // DC low, blocking
+    void (*data)(void *context, const uint8_t *bytes, size_t length);    // DC high, blocking
+    void (*queue)(void *context, const uint8_t *bytes, size_t length);   // DC high, returns once queued
+    void (*waitOldest)(void *context);                                   // Until the oldest queued transfer is out
+};
+
+// Streams a partial window to controller RAM from two band buffers: while one band is on
+// the wire the caller renders (or decodes) the next into the other. A buffer is only handed
+// out again once its transfer has finished.
+// The bus is reached only through PanelSpi, so tests run it against a simulated SPI clock.
+class BandTransfer
+{
+public:
+    /**
+     * @param bufferA First band buffer (on the device: DMA capable, 32-bit aligned)
+     * @param bufferB Second band buffer
+     * @param capacity Bytes in each
+     */
+    BandTransfer(uint8_t *bufferA, uint8_t *bufferB, size_t capacity);
+
+    /**
+     * Set the window and start writing one of the controller's image RAMs
+     * @param spi Link to the controller, nothing queued on it
+     * @param ram PANEL_RAM_NEW or PANEL_RAM_OLD
+     * @param x Left edge (rounded down to a multiple of 8, like GxEPD2)
+     * @param y Top row
+     * @param w Width (the right edge is rounded up to a multiple of 8)
+     * @param h Rows
+     */
+    void begin(const PanelSpi &spi, uint8_t ram, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+    /**
+     * Enter partial mode and set the window, as GxEPD2_750_T7::_setPartialRamArea does
+     * @param spi Link to the controller, nothing queued on it
+     * @param x Left edge (rounded down to a multiple of 8)
+     * @param y Top row
+     * @param w Width (the right edge is rounded up to a multiple of 8)
+     * @param h Rows
+     */
+    static void partialWindow(const PanelSpi &spi, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+    /**
+     * Buffer for the next band, waiting for its last transfer if it is still on the wire
+     */
+    uint8_t *band();
+
+    /**
+     * Queue the band last returned by band()
+     * @param length Bytes of it to send (whole rows of the window)
+     */
+    void send(size_t length);
+
+    /**
+     * Wait for the queued bands and leave partial mode
+     */
+    void end();
+
+    size_t capacity() const { return size; }
+    uint32_t bytesSent() const { return sent; }
+    uint32_t waits() const { return waited; } // band() calls that found their buffer on the wire
+
+private:
+    uint8_t *buffers[2];
+    size_t size;
+    PanelSpi link = {};
+    int next = 0;     // Buffer band() hands out next
+    int inFlight = 0; // Queued transfers not yet waited for (at most 2)
+    uint32_t sent = 0;
+    uint32_t waited = 0;
+};
+
+#endif // BAND_TRANSFER_H
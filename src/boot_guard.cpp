@@ -0,0 +1,90 @@
+#include "boot_guard.h"
+
+// Order subsystems come back in: the radio first, since weather needs it
+static const uint8_t PROBE_ORDER[] = {SUBSYSTEM_RADIO, SUBSYSTEM_WEATHER, SUBSYSTEM_RESTORE};
+const uint8_t MAX_PROBE_BACKOFF = 3;
+
+BootPlan BootGuard::begin(BootGuardState &state, BootCause cause, int failureLimit)
+{
+    if (state.magic != BOOT_GUARD_MAGIC || cause == BOOT_POWER_ON)
+    {
+        state = {};
+        state.magic = BOOT_GUARD_MAGIC;
+        state.enabled = SUBSYSTEM_ALL;
+    }
+    else if ((cause == BOOT_CRASH || cause == BOOT_BROWNOUT) && state.inWake)
+    {
+        // The previous wake never got to deep sleep
+        state.failures = state.failures < 255 ? state.failures + 1 : 255;
+        state.cleanWakes = 0;
+        if (state.probing != 0)
+        {
+            // Blame the subsystem on probation and wait longer before trying it again
+            state.enabled &= ~state.probing;
+            state.probing = 0;
+            state.probeBackoff = state.probeBackoff < MAX_PROBE_BACKOFF ? state.probeBackoff + 1 : MAX_PROBE_BACKOFF;
+        }
+        else if (state.failures >= failureLimit)
+        {
+            state.enabled = 0;
+        }
+    }
+
+    state.inWake = 1;
+    state.lastCause = cause;
+    BootPlan plan;
+    plan.enabled = state.enabled;
+    plan.degraded = state.enabled != SUBSYSTEM_ALL;
+    return plan;
+}
+
+void BootGuard::finished(BootGuardState &state, int probeWakes)
+{
+    state.inWake = 0;
+    if (state.enabled == SUBSYSTEM_ALL && state.probing == 0)
+    {
+        // Failures only count in a row
+        state.failures = 0;
+        state.cleanWakes = 0;
+        state.probeBackoff = 0;
+        return;
+    }
+
+    state.cleanWakes++;
+    if (state.cleanWakes < (probeWakes << state.probeBackoff))
+    {
+        return;
+    }
+    state.cleanWakes = 0;
+
+    // Probation passed: the subsystem is trusted again
+    if (state.probing != 0)
+    {
+        state.probing = 0;
+        if (state.enabled == SUBSYSTEM_ALL)
+        {
+            state.failures = 0;
+            state.probeBackoff = 0;
+            return;
+        }
+    }
+
+    for (uint8_t subsystem : PROBE_ORDER)
+    {
+        if ((state.enabled & subsystem) == 0)
+        {
+            state.enabled |= subsystem;
+            state.probing = subsystem;
+            return;
+        }
+    }
+}
+
+bool BootGuard::allowed(const BootPlan &plan, uint8_t subsystem)
+{
+    if ((plan.enabled & subsystem) == 0)
+    {
+        return false;
+    }
+    return subsystem != SUBSYSTEM_WEATHER || (plan.enabled & SUBSYSTEM_RADIO) != 0;
+}
@@ -0,0 +1,74 @@
+#ifndef BOOT_GUARD_H
+#define BOOT_GUARD_H
+
+#include <cstdint>
+
+// Why this wake started, reduced from esp_reset_reason()
+enum BootCause : uint8_t
+{
+    BOOT_POWER_ON = 0, // Power-on or reset button: start over
+    BOOT_DEEP_SLEEP,   // Timer wake - the previous wake reached deep sleep
+    BOOT_RESTART,      // esp_restart(), e.g. after an OTA update: neither a failure nor a fresh start
+    BOOT_CRASH,        // Panic or watchdog
+    BOOT_BROWNOUT
+};
+
+// Subsystems the breaker can switch off; re-enabled in this order
+const uint8_t SUBSYSTEM_RADIO = 1;   // WiFi and time sync
+const uint8_t SUBSYSTEM_WEATHER = 2; // Weather or frame fetch, parse and draw (needs the radio)
+const uint8_t SUBSYSTEM_RESTORE = 4; // Warm restore from flash on a fresh boot
+const uint8_t SUBSYSTEM_ALL = SUBSYSTEM_RADIO | SUBSYSTEM_WEATHER | SUBSYSTEM_RESTORE;
+
+#define BOOT_GUARD_MAGIC 0x42475244u // "BGRD"
+
+// Breaker state. Lives in RTC_NOINIT memory: the bootloader reloads RTC_DATA_ATTR variables
+// on every reset that isn't a deep sleep wake, which would forget a crash loop.
+struct BootGuardState
+{
+    uint32_t magic;       // BOOT_GUARD_MAGIC once initialized
+    uint8_t inWake;       // Set while a wake runs, cleared just before deep sleep
+    uint8_t failures;     // Wakes in a row that ended in a crash or brownout
+    uint8_t enabled;      // SUBSYSTEM_* bits allowed
+    uint8_t probing;      // Subsystem re-enabled on probation (0 = none)
+    uint8_t lastCause;    // BootCause of this wake
+    uint8_t probeBackoff; // Probation wait doubles per failed probe, up to 8x
+    uint16_t cleanWakes;  // Wakes that reached deep sleep since the last change
+};
+
+// What this wake may do
+struct BootPlan
+{
+    uint8_t enabled; // SUBSYSTEM_* bits
+    bool degraded;   // Clock only until the subsystems come back
+};
+
+// Boot-loop circuit breaker: counts wakes that end in a reset instead of deep sleep, and after
+// failureLimit of them in a row runs clock only, without radio, on a longer sleep. Subsystems
+// then come back one at a time, each on probation; one that fails again goes back off.
+// The caller owns the RTC state and maps the reset reason; tests replay crash sequences on it.
+class BootGuard
+{
+public:
+    /**
+     * Account for how the previous wake ended and plan this one. Call first thing in setup().
+     * @param state RTC_NOINIT state (garbage after power-on is handled)
+     * @param cause Why this wake started
+     * @param failureLimit Failed wakes in a row before degrading
+     */
+    static BootPlan begin(BootGuardState &state, BootCause cause, int failureLimit);
+
+    /**
+     * The wake reached deep sleep. Call just before sleeping.
+     * @param state Breaker state
+     * @param probeWakes Clean wakes before the next subsystem comes back (and before one on
+     *                   probation is trusted), times the backoff
+     */
+    static void finished(BootGuardState &state, int probeWakes);
+
+    /**
+     * Whether subsystem may run this wake (weather also needs the radio)
+     */
+    static bool allowed(const BootPlan &plan, uint8_t subsystem);
+};
+
+#endif // BOOT_GUARD_H
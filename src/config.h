@@ -14,6 +14,53 @@
 #define WEATHER_LATITUDE "45.5152" // Portland, OR
 #define WEATHER_LONGITUDE "-122.6784"
 #define WEATHER_UPDATE_INTERVAL 30 * 60 // 30 minutes in seconds
+#define WEATHER_PREFETCH_LEAD_SECONDS 40 // Fetch off-phase before the boundary (:29:20), show at :30:00
+#define WEATHER_STAGGER_MINUTES 5 // Minutes of prefetch slots per panel by MAC: 5 -> :25:10 to :29:20 (0 = off)
+#define WEATHER_STAGGER_JITTER 5 // Seconds a panel's slot moves from one boundary to the next
+#define WEATHER_MAX_INTERVAL (60 * 60) // Adaptive schedule stretches to this while the forecast isn't changing
+#define WEATHER_UNCHANGED_STRETCH 2 // Unchanged fetches in a row before the schedule stretches
+
+// Weather carousel - several locations fetched in one request and rotated through the pane
+#define WEATHER_CAROUSEL 0 // Set to 1 to use the lists below instead of WEATHER_LATITUDE/LONGITUDE
+#define WEATHER_CAROUSEL_NAMES "Portland,Seattle,Bend"
+#define WEATHER_CAROUSEL_LATITUDES "45.5152,47.6062,44.0582"
+#define WEATHER_CAROUSEL_LONGITUDES "-122.6784,-122.3321,-121.3153"
+#define WEATHER_CAROUSEL_SECONDS (5 * 60) // Time each location stays on the pane
+#define WEATHER_MAX_LOCATIONS 4 // Compact forecasts kept in RTC memory (58 bytes each)
+
+// Air quality (US AQI, PM2.5) from Open-Meteo, drawn under the current temp. Fetched in the same
+// wake as the forecast, on the same kept-alive connection when both URLs share a host.
+#define AIR_QUALITY_ENABLED 0
+#define AIR_QUALITY_API_URL "https://air-quality-api.open-meteo.com/v1/air-quality"
+// Compact records in RTC memory; the gateway only serves single-location forecasts
+#define WEATHER_STREAMED_FETCH ((WEATHER_CAROUSEL || AIR_QUALITY_ENABLED) && !WEATHER_GATEWAY_ENABLED)
+
+// LAN weather gateway (scripts/weather_gateway.py) - one upstream fetch shared by every panel
+#define WEATHER_GATEWAY_ENABLED 0 // Set to 1 to fetch from the gateway over UDP instead of HTTPS
+#define WEATHER_GATEWAY_HOST "192.168.5.10"
+#define WEATHER_GATEWAY_PORT 4210
+#define WEATHER_GATEWAY_TIMEOUT_MS 400 // Per attempt
+#define WEATHER_GATEWAY_ATTEMPTS 3
+
+// Server-rendered frames (scripts/render_server.py) - the weather pane is rasterized on a host
+#define RENDER_FRAME_ENABLED 0 // Set to 1 to draw the pane from a compressed 1bpp frame
+#define RENDER_FRAME_URL "http://192.168.5.10:8090/frame"
+#define RENDER_FRAME_PANE "weather" // "weather" (right half, prefetched) or "full" (whole screen, fetched on the boundary clock wake)
+#define RENDER_FRAME_MAX_BYTES 16384 // Compressed frame download limit
+#define RENDER_FRAME_DELTA 1 // Ask only for the tiles that changed since the pane on screen
+
+// Asset partition (scripts/pack_assets.py) - digits, icons and fonts replaceable without a reflash
+#define ASSET_PARTITION_ENABLED 0 // Set to 1 to map them from flash; built-in copies fill any gaps
+#define ASSET_PARTITION_LABEL "assets"
+
+// Warm restore - the last forecast or server pane, kept in flash and put back on a fresh boot
+#define WARM_RESTORE_ENABLED 1
+#define WARM_PARTITION_LABEL "warm" // 128 KB ring of 4 KB sectors, see flash_ring.h
+
+// Boot-loop circuit breaker - wakes that end in a crash or brownout instead of deep sleep
+#define BOOT_FAILURE_LIMIT 3          // Failed wakes in a row before running clock only, radio off
+#define BOOT_PROBE_WAKES 12           // Clean wakes before a subsystem comes back (and is trusted again)
+#define BOOT_DEGRADED_CLOCK_MINUTES 5 // Clock interval while degraded
 
 // Time display update
 #define CLOCK_UPDATE_INTERVAL 60 // 1 minute in seconds
@@ -23,6 +70,21 @@
 #define DISPLAY_HEIGHT 480
 #define DISPLAY_LEFT_HALF 400  // Left half for clock
 #define DISPLAY_RIGHT_HALF 400 // Right half for weather
+#define DISPLAY_PAGE_ROWS 60 // Rows per band buffer (two of DISPLAY_WIDTH / 8 bytes a row, one drawn while the other is sent)
+#define PANEL_SPI_HZ 20000000 // UC8179 write clock limit (50 ns cycle); GxEPD2 defaults to 4 MHz
+
+// Fast waveform: a short custom LUT for partial refreshes of the chosen regions, traded for
+// more ghosting, which counts against the region in the refresh ledger
+#define FAST_WAVEFORM_REGIONS 0   // FAST_* bits: 1 = clock digits, 2 = date, 4 = battery, 8 = weather
+#define FAST_WAVEFORM_FRAMES 10   // Drive phase length in controller frames
+
+// Ghosting ledger: each region counts its partial refreshes (stock = 1) and is cleaned with
+// a full-waveform refresh of its own rectangle once over budget, preferably in quiet hours
+#define GHOST_FAST_COST 4         // A fast-waveform refresh, in stock ones
+#define GHOST_BUDGET 60           // Cleaned at the next quiet-hours wake once over this
+#define GHOST_LIMIT 240           // Cleaned whatever the hour (max 255)
+#define QUIET_HOURS_START 2       // Local hour quiet hours start (may wrap past midnight)
+#define QUIET_HOURS_END 5         // Local hour they end
 
 // Pin configuration (Waveshare e-ink for ESP32-C3)
 // Match TRMNL OG hardware
@@ -35,14 +97,26 @@
 #define PIN_BUSY 4    // EPD_BUSY
 #define PIN_BATTERY 3 // Battery ADC pin
 
-// OTA Configuration
-#define OTA_ENABLED 1
-#define OTA_WAIT_SECONDS 30
+// OTA Configuration - pulled on prefetch wakes while the radio is up for weather, see ota_patch.h
+#define OTA_ENABLED 0 // Set to 1 once the update server runs and OTA_PUBLIC_KEY is set
+#define FIRMWARE_VERSION 1 // Bump for every release; the update server keys patches by it
+#define OTA_MANIFEST_URL "http://192.168.5.10:8070/ota/manifest" // scripts/ota_server.py
+// Release key's public half, hex DER, from scripts/ota_server.py --keygen. Images not signed
+// with its private half are never booted, whoever answers OTA_MANIFEST_URL.
+#define OTA_PUBLIC_KEY ""
+#define OTA_MIN_BATTERY 30 // Percent; below this the manifest isn't checked
+
+// Fleet telemetry - wake metrics kept in RTC memory and posted as one batch on prefetch wakes,
+// never with a connection of their own; see telemetry.h
+#define TELEMETRY_ENABLED 0 // Set to 1 once TELEMETRY_URL points at a running collector
+#define TELEMETRY_URL "http://192.168.5.10:8060/telemetry" // scripts/telemetry_collector.py
 
 // Battery configuration
 #define BATTERY_SAVE_MODE 1       // Enable deep sleep
 #define WAKEUP_INTERVAL_MINUTES 1 // Wake up every minute for time updates
 #define WAKEUP_INTERVAL_SECONDS (WAKEUP_INTERVAL_MINUTES * 60)
+#define POWER_TARGET_RUNTIME_HOURS 72 // Battery-life goal the power governor steers toward
+#define POWER_SAMPLE_INTERVAL (30 * 60) // Battery trend sample spacing in seconds
 
 // Debug options (set to 1 to enable)
 #define DEBUG_TIME_SYNC 0
@@ -0,0 +1,491 @@
+#include "digit_bitmaps.h"
+
+// Auto-generated - do not edit manually. Use scripts/generate_digits_from_font.py to regenerate.
+
+static const uint8_t DIGIT_0_DATA[] PROGMEM = { // 990 bytes raw
+    0xa4, 0x00, 0x02, 0x1f, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xfe, 0xfc, 0x00, 0x00,
+    0x07, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x1f, 0xfe, 0xff, 0x00, 0xe0, 0xfd, 0x00, 0x00,
+    0x7f, 0xfe, 0xff, 0x00, 0xf8, 0xfd, 0x00, 0xfd, 0xff, 0x00, 0xfc, 0xfe, 0x00, 0x00, 0x03, 0xfc,
+    0xff, 0xfe, 0x00, 0x00, 0x07, 0xfc, 0xff, 0x03, 0x80, 0x00, 0x00, 0x0f, 0xfc, 0xff, 0x03, 0xc0,
+    0x00, 0x00, 0x1f, 0xfc, 0xff, 0x03, 0xe0, 0x00, 0x00, 0x3f, 0xfc, 0xff, 0x03, 0xf0, 0x00, 0x00,
+    0x7f, 0xfc, 0xff, 0x03, 0xf8, 0x00, 0x00, 0x7f, 0xfc, 0xff, 0x02, 0xf8, 0x00, 0x00, 0xfb, 0xff,
+    0x02, 0xfc, 0x00, 0x01, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x01, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x03,
+    0xfe, 0xff, 0x00, 0x83, 0xfe, 0xff, 0x05, 0x00, 0x03, 0xff, 0xff, 0xfc, 0x00, 0xfe, 0xff, 0x7a,
+    0x00, 0x07, 0xff, 0xff, 0xf8, 0x00, 0x7f, 0xff, 0xff, 0x80, 0x07, 0xff, 0xff, 0xf0, 0x00, 0x3f,
+    0xff, 0xff, 0x80, 0x07, 0xff, 0xff, 0xe0, 0x00, 0x1f, 0xff, 0xff, 0xc0, 0x0f, 0xff, 0xff, 0xc0,
+    0x00, 0x0f, 0xff, 0xff, 0xc0, 0x0f, 0xff, 0xff, 0xc0, 0x00, 0x07, 0xff, 0xff, 0xc0, 0x1f, 0xff,
+    0xff, 0x80, 0x00, 0x07, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0x80, 0x00, 0x03, 0xff, 0xff, 0xe0,
+    0x1f, 0xff, 0xff, 0x00, 0x00, 0x03, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0x00, 0x00, 0x03, 0xff,
+    0xff, 0xe0, 0x3f, 0xff, 0xff, 0x00, 0x00, 0x01, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xfe, 0x00, 0x00,
+    0x07, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xfe, 0x00, 0x00, 0x1f, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xfe,
+    0x00, 0x00, 0x3f, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xfe, 0x00, 0x00, 0xfe, 0xff, 0x05, 0xf0, 0x3f,
+    0xff, 0xfc, 0x00, 0x03, 0xfe, 0xff, 0x05, 0xf8, 0x7f, 0xff, 0xfc, 0x00, 0x0f, 0xfe, 0xff, 0x05,
+    0xf8, 0x7f, 0xff, 0xfc, 0x00, 0x3f, 0xfe, 0xff, 0x05, 0xf8, 0x7f, 0xff, 0xfc, 0x00, 0x7f, 0xfe,
+    0xff, 0x04, 0xf8, 0x7f, 0xff, 0xfc, 0x01, 0xfd, 0xff, 0x04, 0xf8, 0x7f, 0xff, 0xfc, 0x07, 0xfd,
+    0xff, 0x04, 0xf8, 0x7f, 0xff, 0xfc, 0x1f, 0xfd, 0xff, 0x04, 0xf8, 0x7f, 0xff, 0xfc, 0x7f, 0xfd,
+    0xff, 0x03, 0xf8, 0x7f, 0xff, 0xfc, 0xfc, 0xff, 0x01, 0xf8, 0x7f, 0xfa, 0xff, 0x01, 0xf8, 0x7f,
+    0xfa, 0xff, 0x01, 0xf8, 0x7f, 0xfa, 0xff, 0x01, 0xf8, 0x7f, 0xfa, 0xff, 0x01, 0xf8, 0x7f, 0xfa,
+    0xff, 0x01, 0xf8, 0x7f, 0xfa, 0xff, 0x01, 0xf8, 0x7f, 0xfd, 0xff, 0x04, 0xfc, 0xff, 0xff, 0xf8,
+    0x7f, 0xfd, 0xff, 0x04, 0xf0, 0xff, 0xff, 0xf8, 0x7f, 0xfd, 0xff, 0x04, 0xc0, 0xff, 0xff, 0xf8,
+    0x7f, 0xfd, 0xff, 0x04, 0x00, 0xff, 0xff, 0xf8, 0x7f, 0xfe, 0xff, 0x05, 0xfe, 0x00, 0xff, 0xff,
+    0xf8, 0x7f, 0xfe, 0xff, 0x05, 0xf8, 0x00, 0xff, 0xff, 0xf8, 0x7f, 0xfe, 0xff, 0x05, 0xe0, 0x00,
+    0xff, 0xff, 0xf8, 0x7f, 0xfe, 0xff, 0x7f, 0x80, 0x00, 0xff, 0xff, 0xf8, 0x3f, 0xff, 0xff, 0xfe,
+    0x00, 0x00, 0xff, 0xff, 0xf8, 0x3f, 0xff, 0xff, 0xf8, 0x00, 0x01, 0xff, 0xff, 0xf0, 0x3f, 0xff,
+    0xff, 0xf0, 0x00, 0x01, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff, 0xc0, 0x00, 0x01, 0xff, 0xff, 0xf0,
+    0x3f, 0xff, 0xff, 0x00, 0x00, 0x01, 0xff, 0xff, 0xf0, 0x1f, 0xff, 0xff, 0x00, 0x00, 0x03, 0xff,
+    0xff, 0xf0, 0x1f, 0xff, 0xff, 0x00, 0x00, 0x03, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0x00, 0x00,
+    0x03, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0x80, 0x00, 0x07, 0xff, 0xff, 0xe0, 0x0f, 0xff, 0xff,
+    0x80, 0x00, 0x07, 0xff, 0xff, 0xc0, 0x0f, 0xff, 0xff, 0xc0, 0x00, 0x0f, 0xff, 0xff, 0xc0, 0x0f,
+    0xff, 0xff, 0xe0, 0x00, 0x0f, 0xff, 0xff, 0xc0, 0x07, 0xff, 0xff, 0xe0, 0x00, 0x1f, 0xff, 0xff,
+    0x80, 0x07, 0xff, 0xff, 0xf0, 0x00, 0x3f, 0xff, 0xff, 0x0e, 0x80, 0x03, 0xff, 0xff, 0xf8, 0x00,
+    0x7f, 0xff, 0xff, 0x00, 0x03, 0xff, 0xff, 0xfe, 0x01, 0xfe, 0xff, 0x01, 0x00, 0x01, 0xfb, 0xff,
+    0x02, 0xfe, 0x00, 0x01, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x00, 0xfb, 0xff, 0x03, 0xfc, 0x00, 0x00,
+    0x7f, 0xfc, 0xff, 0x03, 0xfc, 0x00, 0x00, 0x7f, 0xfc, 0xff, 0x03, 0xf8, 0x00, 0x00, 0x3f, 0xfc,
+    0xff, 0x03, 0xf0, 0x00, 0x00, 0x1f, 0xfc, 0xff, 0x03, 0xe0, 0x00, 0x00, 0x0f, 0xfc, 0xff, 0x03,
+    0xc0, 0x00, 0x00, 0x07, 0xfc, 0xff, 0x03, 0x80, 0x00, 0x00, 0x03, 0xfc, 0xff, 0xfe, 0x00, 0x00,
+    0x01, 0xfd, 0xff, 0x00, 0xfe, 0xfd, 0x00, 0xfd, 0xff, 0x00, 0xfc, 0xfd, 0x00, 0x00, 0x3f, 0xfe,
+    0xff, 0x00, 0xf0, 0xfd, 0x00, 0x00, 0x0f, 0xfe, 0xff, 0x00, 0xc0, 0xfd, 0x00, 0x00, 0x03, 0xfe,
+    0xff, 0xfb, 0x00, 0x02, 0x7f, 0xff, 0xf8, 0xfb, 0x00, 0x01, 0x01, 0xfe, 0x91, 0x00
+};
+const PackedBitmap DIGIT_0_BITMAP = {DIGIT_0_DATA, sizeof(DIGIT_0_DATA), DIGIT_WIDTH, DIGIT_HEIGHT};
+
+static const uint8_t DIGIT_1_DATA[] PROGMEM = { // 990 bytes raw
+    0x92, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x3f, 0xff, 0xff, 0x80, 0xfc, 0x00,
+    0x03, 0x7f, 0xff, 0xff, 0x80, 0xfd, 0x00, 0x00, 0x01, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00,
+    0x03, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x0f, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00,
+    0x1f, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x7f, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0xfd,
+    0xff, 0x00, 0x80, 0xfe, 0x00, 0x00, 0x01, 0xfd, 0xff, 0x00, 0x80, 0xfe, 0x00, 0x00, 0x07, 0xfd,
+    0xff, 0x00, 0x80, 0xfe, 0x00, 0x00, 0x0f, 0xfd, 0xff, 0x00, 0x80, 0xfe, 0x00, 0x00, 0x3f, 0xfd,
+    0xff, 0x00, 0x80, 0xfe, 0x00, 0x00, 0x7f, 0xfd, 0xff, 0x03, 0x80, 0x00, 0x00, 0x01, 0xfc, 0xff,
+    0x03, 0x80, 0x00, 0x00, 0x01, 0xfc, 0xff, 0x03, 0x80, 0x00, 0x00, 0x01, 0xfc, 0xff, 0x03, 0x80,
+    0x00, 0x00, 0x01, 0xfc, 0xff, 0x03, 0x80, 0x00, 0x00, 0x01, 0xfc, 0xff, 0x03, 0x80, 0x00, 0x00,
+    0x01, 0xfc, 0xff, 0x75, 0x80, 0x00, 0x00, 0x01, 0xff, 0xff, 0xcf, 0xff, 0xff, 0x80, 0x00, 0x00,
+    0x01, 0xff, 0xff, 0x0f, 0xff, 0xff, 0x80, 0x00, 0x00, 0x01, 0xff, 0xfe, 0x0f, 0xff, 0xff, 0x80,
+    0x00, 0x00, 0x01, 0xff, 0xf8, 0x0f, 0xff, 0xff, 0x80, 0x00, 0x00, 0x01, 0xff, 0xf0, 0x0f, 0xff,
+    0xff, 0x80, 0x00, 0x00, 0x01, 0xff, 0xc0, 0x0f, 0xff, 0xff, 0x80, 0x00, 0x00, 0x01, 0xff, 0x80,
+    0x0f, 0xff, 0xff, 0x80, 0x00, 0x00, 0x01, 0xfe, 0x00, 0x0f, 0xff, 0xff, 0x80, 0x00, 0x00, 0x01,
+    0xfc, 0x00, 0x0f, 0xff, 0xff, 0x80, 0x00, 0x00, 0x01, 0xf8, 0x00, 0x0f, 0xff, 0xff, 0x80, 0x00,
+    0x00, 0x01, 0xe0, 0x00, 0x0f, 0xff, 0xff, 0x80, 0x00, 0x00, 0x01, 0xc0, 0x00, 0x0f, 0xff, 0xff,
+    0x80, 0x00, 0x00, 0x01, 0x00, 0x00, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff,
+    0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc,
+    0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03,
+    0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff,
+    0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80,
+    0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00,
+    0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f,
+    0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff,
+    0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc,
+    0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03,
+    0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff,
+    0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80,
+    0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00,
+    0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f,
+    0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff,
+    0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x06, 0x0f, 0xff, 0xff, 0x80, 0x00,
+    0x00, 0x01, 0xfa, 0xff, 0x01, 0xf8, 0x01, 0xfa, 0xff, 0x01, 0xf8, 0x01, 0xfa, 0xff, 0x01, 0xf8,
+    0x01, 0xfa, 0xff, 0x01, 0xf8, 0x01, 0xfa, 0xff, 0x01, 0xf8, 0x01, 0xfa, 0xff, 0x01, 0xf8, 0x01,
+    0xfa, 0xff, 0x01, 0xf8, 0x01, 0xfa, 0xff, 0x01, 0xf8, 0x01, 0xfa, 0xff, 0x01, 0xf8, 0x01, 0xfa,
+    0xff, 0x01, 0xf8, 0x01, 0xfa, 0xff, 0x01, 0xf8, 0x01, 0xfa, 0xff, 0x01, 0xf8, 0x01, 0xfa, 0xff,
+    0x01, 0xf8, 0x01, 0xfa, 0xff, 0x01, 0xf8, 0x01, 0xfa, 0xff, 0x01, 0xf8, 0x01, 0xfa, 0xff, 0x01,
+    0xf8, 0x01, 0xfa, 0xff, 0x00, 0xf8, 0x8c, 0x00
+};
+const PackedBitmap DIGIT_1_BITMAP = {DIGIT_1_DATA, sizeof(DIGIT_1_DATA), DIGIT_WIDTH, DIGIT_HEIGHT};
+
+static const uint8_t DIGIT_2_DATA[] PROGMEM = { // 990 bytes raw
+    0x9b, 0x00, 0x02, 0x3f, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xfe, 0xfc, 0x00, 0x00,
+    0x1f, 0xfe, 0xff, 0x00, 0xc0, 0xfd, 0x00, 0x00, 0x7f, 0xfe, 0xff, 0x00, 0xf8, 0xfe, 0x00, 0x00,
+    0x01, 0xfd, 0xff, 0x00, 0xfe, 0xfe, 0x00, 0x00, 0x03, 0xfc, 0xff, 0xfe, 0x00, 0x00, 0x0f, 0xfc,
+    0xff, 0x03, 0xc0, 0x00, 0x00, 0x1f, 0xfc, 0xff, 0x03, 0xe0, 0x00, 0x00, 0x3f, 0xfc, 0xff, 0x03,
+    0xf0, 0x00, 0x00, 0x7f, 0xfc, 0xff, 0x02, 0xf8, 0x00, 0x00, 0xfb, 0xff, 0x02, 0xfc, 0x00, 0x01,
+    0xfb, 0xff, 0x02, 0xfc, 0x00, 0x01, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x03, 0xfa, 0xff, 0x01, 0x00,
+    0x07, 0xfa, 0xff, 0x01, 0x00, 0x07, 0xfa, 0xff, 0x05, 0x80, 0x0f, 0xff, 0xff, 0xfc, 0x03, 0xfe,
+    0xff, 0x63, 0x80, 0x0f, 0xff, 0xff, 0xf0, 0x00, 0x7f, 0xff, 0xff, 0x80, 0x0f, 0xff, 0xff, 0xc0,
+    0x00, 0x3f, 0xff, 0xff, 0xc0, 0x1f, 0xff, 0xff, 0x80, 0x00, 0x1f, 0xff, 0xff, 0xc0, 0x1f, 0xff,
+    0xff, 0x00, 0x00, 0x0f, 0xff, 0xff, 0xc0, 0x1f, 0xff, 0xff, 0x00, 0x00, 0x07, 0xff, 0xff, 0xc0,
+    0x1f, 0xff, 0xfe, 0x00, 0x00, 0x07, 0xff, 0xff, 0xc0, 0x3f, 0xff, 0xfe, 0x00, 0x00, 0x07, 0xff,
+    0xff, 0xc0, 0x3f, 0xff, 0xfc, 0x00, 0x00, 0x03, 0xff, 0xff, 0xc0, 0x3f, 0xff, 0xfc, 0x00, 0x00,
+    0x03, 0xff, 0xff, 0xc0, 0x3f, 0xff, 0xfc, 0x00, 0x00, 0x03, 0xff, 0xff, 0xc0, 0x3f, 0xff, 0xfc,
+    0x00, 0x00, 0x03, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03,
+    0x07, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x0f, 0xff,
+    0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0x80,
+    0xfc, 0x00, 0x02, 0x3f, 0xff, 0xff, 0xfb, 0x00, 0x02, 0x3f, 0xff, 0xff, 0xfb, 0x00, 0x02, 0x7f,
+    0xff, 0xfe, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xfe, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xfc, 0xfc,
+    0x00, 0x03, 0x03, 0xff, 0xff, 0xfc, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03,
+    0x0f, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x3f, 0xff,
+    0xff, 0xc0, 0xfc, 0x00, 0x03, 0x7f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0xfe, 0xff, 0x00, 0x80, 0xfd,
+    0x00, 0x00, 0x01, 0xfe, 0xff, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xfe, 0xfc, 0x00, 0x03, 0x07,
+    0xff, 0xff, 0xfc, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x3f, 0xff, 0xff,
+    0xf0, 0xfc, 0x00, 0x03, 0x7f, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0xfe, 0xff, 0x00, 0xc0, 0xfd, 0x00,
+    0x00, 0x01, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x03, 0xfe, 0xff, 0xfc, 0x00, 0x03, 0x07,
+    0xff, 0xff, 0xfc, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff,
+    0xf0, 0xfc, 0x00, 0x03, 0x3f, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x7f, 0xff, 0xff, 0xc0, 0xfc,
+    0x00, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x03, 0xfe, 0xff, 0xfc, 0x00, 0x03, 0x07, 0xff,
+    0xff, 0xfc, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0xf0,
+    0xfc, 0x00, 0x03, 0x3f, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x7f, 0xff, 0xff, 0xc0, 0xfc, 0x00,
+    0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x01, 0xfe, 0xff, 0xfc, 0x00, 0x00, 0x03, 0xfa, 0xff,
+    0x01, 0xf0, 0x07, 0xfa, 0xff, 0x01, 0xf0, 0x0f, 0xfa, 0xff, 0x01, 0xf0, 0x1f, 0xfa, 0xff, 0x01,
+    0xf0, 0x1f, 0xfa, 0xff, 0x01, 0xf0, 0x1f, 0xfa, 0xff, 0x01, 0xf0, 0x1f, 0xfa, 0xff, 0x01, 0xf0,
+    0x1f, 0xfa, 0xff, 0x01, 0xf0, 0x1f, 0xfa, 0xff, 0x01, 0xf0, 0x1f, 0xfa, 0xff, 0x01, 0xf0, 0x1f,
+    0xfa, 0xff, 0x01, 0xf0, 0x1f, 0xfa, 0xff, 0x01, 0xf0, 0x1f, 0xfa, 0xff, 0x01, 0xf0, 0x1f, 0xfa,
+    0xff, 0x01, 0xf0, 0x1f, 0xfa, 0xff, 0x01, 0xf0, 0x1f, 0xfa, 0xff, 0x01, 0xf0, 0x1f, 0xfa, 0xff,
+    0x00, 0xf0, 0x8c, 0x00
+};
+const PackedBitmap DIGIT_2_BITMAP = {DIGIT_2_DATA, sizeof(DIGIT_2_DATA), DIGIT_WIDTH, DIGIT_HEIGHT};
+
+static const uint8_t DIGIT_3_DATA[] PROGMEM = { // 990 bytes raw
+    0xa4, 0x00, 0x02, 0x1f, 0xff, 0xf8, 0xfc, 0x00, 0x00, 0x01, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00,
+    0x00, 0x0f, 0xfe, 0xff, 0x00, 0xf0, 0xfd, 0x00, 0x00, 0x3f, 0xfe, 0xff, 0x00, 0xfc, 0xfd, 0x00,
+    0xfc, 0xff, 0xfe, 0x00, 0x00, 0x03, 0xfc, 0xff, 0x03, 0xc0, 0x00, 0x00, 0x07, 0xfc, 0xff, 0x03,
+    0xe0, 0x00, 0x00, 0x0f, 0xfc, 0xff, 0x03, 0xf0, 0x00, 0x00, 0x1f, 0xfc, 0xff, 0x03, 0xf8, 0x00,
+    0x00, 0x3f, 0xfc, 0xff, 0x03, 0xfc, 0x00, 0x00, 0x7f, 0xfc, 0xff, 0x02, 0xfe, 0x00, 0x00, 0xfa,
+    0xff, 0xff, 0x00, 0xfa, 0xff, 0x01, 0x00, 0x01, 0xfa, 0xff, 0x01, 0x80, 0x03, 0xfa, 0xff, 0x01,
+    0x80, 0x03, 0xfa, 0xff, 0x05, 0xc0, 0x03, 0xff, 0xff, 0xfc, 0x00, 0xfe, 0xff, 0x5a, 0xc0, 0x07,
+    0xff, 0xff, 0xf0, 0x00, 0x1f, 0xff, 0xff, 0xc0, 0x07, 0xff, 0xff, 0xc0, 0x00, 0x0f, 0xff, 0xff,
+    0xc0, 0x07, 0xff, 0xff, 0x80, 0x00, 0x07, 0xff, 0xff, 0xe0, 0x0f, 0xff, 0xff, 0x00, 0x00, 0x03,
+    0xff, 0xff, 0xe0, 0x0f, 0xff, 0xff, 0x00, 0x00, 0x01, 0xff, 0xff, 0xe0, 0x0f, 0xff, 0xfe, 0x00,
+    0x00, 0x01, 0xff, 0xff, 0xe0, 0x0f, 0xff, 0xfe, 0x00, 0x00, 0x01, 0xff, 0xff, 0xe0, 0x0f, 0xff,
+    0xfe, 0x00, 0x00, 0x01, 0xff, 0xff, 0xe0, 0x0f, 0xff, 0xfe, 0x00, 0x00, 0x01, 0xff, 0xff, 0xe0,
+    0x0f, 0xff, 0xfc, 0x00, 0x00, 0x01, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xc0,
+    0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xc0, 0xfc, 0x00,
+    0x03, 0x03, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x02, 0x0f,
+    0xff, 0xff, 0xfb, 0x00, 0x02, 0x1f, 0xff, 0xff, 0xfb, 0x00, 0x02, 0x7f, 0xff, 0xfe, 0xfd, 0x00,
+    0x00, 0x7f, 0xfe, 0xff, 0x00, 0xfc, 0xfd, 0x00, 0x00, 0x7f, 0xfe, 0xff, 0x00, 0xf8, 0xfd, 0x00,
+    0x00, 0x7f, 0xfe, 0xff, 0x00, 0xf0, 0xfd, 0x00, 0x00, 0x7f, 0xfe, 0xff, 0x00, 0xe0, 0xfd, 0x00,
+    0x00, 0x7f, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x03, 0x7f, 0xff, 0xff, 0xfe, 0xfc, 0x00, 0x03,
+    0x7f, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x7f, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x00, 0x7f, 0xfe,
+    0xff, 0xfc, 0x00, 0x00, 0x7f, 0xfe, 0xff, 0x00, 0xe0, 0xfd, 0x00, 0x00, 0x7f, 0xfe, 0xff, 0x00,
+    0xf8, 0xfd, 0x00, 0x00, 0x7f, 0xfe, 0xff, 0x00, 0xfe, 0xfd, 0x00, 0x00, 0x7f, 0xfd, 0xff, 0xfd,
+    0x00, 0x00, 0x7f, 0xfd, 0xff, 0x00, 0x80, 0xfe, 0x00, 0x00, 0x7f, 0xfd, 0xff, 0x00, 0xc0, 0xfd,
+    0x00, 0x00, 0x01, 0xfe, 0xff, 0x00, 0xe0, 0xfc, 0x00, 0x03, 0x3f, 0xff, 0xff, 0xe0, 0xfc, 0x00,
+    0x03, 0x0f, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x01,
+    0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf8, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xf8,
+    0xfb, 0x00, 0xff, 0xff, 0x00, 0xf8, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xfc, 0xfb, 0x00, 0x02, 0x7f,
+    0xff, 0xfc, 0xfb, 0x00, 0x05, 0x7f, 0xff, 0xfc, 0x3f, 0xff, 0xfc, 0xfe, 0x00, 0x05, 0x7f, 0xff,
+    0xfc, 0x3f, 0xff, 0xfc, 0xfe, 0x00, 0xff, 0xff, 0x03, 0xfc, 0x3f, 0xff, 0xfc, 0xfe, 0x00, 0xff,
+    0xff, 0x03, 0xfc, 0x1f, 0xff, 0xfe, 0xfe, 0x00, 0xff, 0xff, 0x2e, 0xfc, 0x1f, 0xff, 0xfe, 0x00,
+    0x00, 0x01, 0xff, 0xff, 0xfc, 0x1f, 0xff, 0xff, 0x00, 0x00, 0x03, 0xff, 0xff, 0xfc, 0x1f, 0xff,
+    0xff, 0x80, 0x00, 0x07, 0xff, 0xff, 0xf8, 0x0f, 0xff, 0xff, 0xc0, 0x00, 0x0f, 0xff, 0xff, 0xf8,
+    0x0f, 0xff, 0xff, 0xf0, 0x00, 0x3f, 0xff, 0xff, 0xf8, 0x0f, 0xfe, 0xff, 0x00, 0x87, 0xfe, 0xff,
+    0x01, 0xf0, 0x07, 0xfa, 0xff, 0x01, 0xf0, 0x07, 0xfa, 0xff, 0x01, 0xf0, 0x03, 0xfa, 0xff, 0x01,
+    0xe0, 0x03, 0xfa, 0xff, 0x01, 0xc0, 0x01, 0xfa, 0xff, 0x01, 0xc0, 0x00, 0xfa, 0xff, 0x02, 0x80,
+    0x00, 0x7f, 0xfb, 0xff, 0xff, 0x00, 0x00, 0x3f, 0xfc, 0xff, 0x03, 0xfe, 0x00, 0x00, 0x1f, 0xfc,
+    0xff, 0x03, 0xfc, 0x00, 0x00, 0x0f, 0xfc, 0xff, 0x03, 0xf8, 0x00, 0x00, 0x07, 0xfc, 0xff, 0x03,
+    0xe0, 0x00, 0x00, 0x01, 0xfc, 0xff, 0x00, 0xc0, 0xfe, 0x00, 0x00, 0x7f, 0xfd, 0xff, 0xfd, 0x00,
+    0x00, 0x1f, 0xfe, 0xff, 0x00, 0xfc, 0xfd, 0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0xe0, 0xfc, 0x00,
+    0x02, 0x7f, 0xff, 0xfe, 0xfb, 0x00, 0x02, 0x01, 0xff, 0x80, 0x92, 0x00
+};
+const PackedBitmap DIGIT_3_BITMAP = {DIGIT_3_DATA, sizeof(DIGIT_3_DATA), DIGIT_WIDTH, DIGIT_HEIGHT};
+
+static const uint8_t DIGIT_4_DATA[] PROGMEM = { // 990 bytes raw
+    0x92, 0x00, 0x02, 0x3f, 0xff, 0xfe, 0xfb, 0x00, 0x02, 0x7f, 0xff, 0xfe, 0xfb, 0x00, 0x02, 0x7f,
+    0xff, 0xfc, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xfc, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xf8, 0xfc, 0x00,
+    0x03, 0x01, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x03,
+    0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff,
+    0xe0, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xc0, 0xfc,
+    0x00, 0x03, 0x0f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03,
+    0x1f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x02, 0x3f, 0xff,
+    0xff, 0xfb, 0x00, 0x02, 0x3f, 0xff, 0xff, 0xfb, 0x00, 0x02, 0x3f, 0xff, 0xfe, 0xfb, 0x00, 0x02,
+    0x7f, 0xff, 0xfe, 0xfb, 0x00, 0x02, 0x7f, 0xff, 0xfe, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xfc, 0xfb,
+    0x00, 0xff, 0xff, 0x00, 0xfc, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x01,
+    0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff,
+    0xf0, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xe0, 0xfc,
+    0x00, 0x03, 0x07, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03,
+    0x0f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x1f, 0xff,
+    0xff, 0x80, 0xfc, 0x00, 0x7f, 0x1f, 0xff, 0xff, 0x80, 0xff, 0xff, 0xe0, 0x00, 0x00, 0x3f, 0xff,
+    0xff, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x00, 0x3f, 0xff, 0xff, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x00,
+    0x7f, 0xff, 0xfe, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x00, 0x7f, 0xff, 0xfe, 0x00, 0xff, 0xff, 0xe0,
+    0x00, 0x00, 0xff, 0xff, 0xfc, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x00, 0xff, 0xff, 0xfc, 0x00, 0xff,
+    0xff, 0xe0, 0x00, 0x00, 0xff, 0xff, 0xfc, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x01, 0xff, 0xff, 0xf8,
+    0x00, 0xff, 0xff, 0xe0, 0x00, 0x01, 0xff, 0xff, 0xf8, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x03, 0xff,
+    0xff, 0xf0, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x03, 0xff, 0xff, 0xf0, 0x00, 0xff, 0xff, 0xe0, 0x00,
+    0x07, 0xff, 0xff, 0xe0, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x07, 0xff, 0xff, 0xe0, 0x00, 0xff, 0xff,
+    0xe0, 0x00, 0x0f, 0xff, 0xff, 0x33, 0xe0, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x0f, 0xff, 0xff, 0xc0,
+    0x00, 0xff, 0xff, 0xe0, 0x00, 0x0f, 0xff, 0xff, 0xc0, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x1f, 0xff,
+    0xff, 0x80, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x1f, 0xff, 0xff, 0x80, 0x00, 0xff, 0xff, 0xe0, 0x00,
+    0x3f, 0xff, 0xff, 0x80, 0x00, 0xff, 0xff, 0xe0, 0x00, 0x3f, 0xfa, 0xff, 0x01, 0xfc, 0x3f, 0xfa,
+    0xff, 0x01, 0xfc, 0x3f, 0xfa, 0xff, 0x01, 0xfc, 0x3f, 0xfa, 0xff, 0x01, 0xfc, 0x3f, 0xfa, 0xff,
+    0x01, 0xfc, 0x3f, 0xfa, 0xff, 0x01, 0xfc, 0x3f, 0xfa, 0xff, 0x01, 0xfc, 0x3f, 0xfa, 0xff, 0x01,
+    0xfc, 0x3f, 0xfa, 0xff, 0x01, 0xfc, 0x3f, 0xfa, 0xff, 0x01, 0xfc, 0x3f, 0xfa, 0xff, 0x01, 0xfc,
+    0x3f, 0xfa, 0xff, 0x01, 0xfc, 0x3f, 0xfa, 0xff, 0x01, 0xfc, 0x3f, 0xfa, 0xff, 0x01, 0xfc, 0x3f,
+    0xfa, 0xff, 0x01, 0xfc, 0x3f, 0xfa, 0xff, 0x00, 0xfc, 0xfd, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf0,
+    0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf0, 0xfc, 0x00,
+    0x03, 0x01, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x01,
+    0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff,
+    0xf0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf0, 0xfc,
+    0x00, 0x03, 0x01, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03,
+    0x01, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x01, 0xff,
+    0xff, 0xf0, 0x8b, 0x00
+};
+const PackedBitmap DIGIT_4_BITMAP = {DIGIT_4_DATA, sizeof(DIGIT_4_DATA), DIGIT_WIDTH, DIGIT_HEIGHT};
+
+static const uint8_t DIGIT_5_DATA[] PROGMEM = { // 990 bytes raw
+    0x9e, 0x00, 0x00, 0x01, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x01, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x01,
+    0xfb, 0xff, 0x02, 0xfe, 0x00, 0x03, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x03, 0xfb, 0xff, 0x02, 0xfe,
+    0x00, 0x03, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x03, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x03, 0xfb, 0xff,
+    0x02, 0xfe, 0x00, 0x03, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x03, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x03,
+    0xfb, 0xff, 0x02, 0xfe, 0x00, 0x03, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x03, 0xfb, 0xff, 0x02, 0xfe,
+    0x00, 0x03, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x03, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x03, 0xfb, 0xff,
+    0x02, 0xfe, 0x00, 0x03, 0xfb, 0xff, 0x04, 0xfe, 0x00, 0x07, 0xff, 0xff, 0xfb, 0x00, 0x02, 0x07,
+    0xff, 0xff, 0xfb, 0x00, 0x02, 0x07, 0xff, 0xff, 0xfb, 0x00, 0x02, 0x07, 0xff, 0xff, 0xfb, 0x00,
+    0x02, 0x07, 0xff, 0xfe, 0xfb, 0x00, 0x02, 0x07, 0xff, 0xfe, 0xfb, 0x00, 0x02, 0x07, 0xff, 0xfe,
+    0xfb, 0x00, 0x02, 0x07, 0xff, 0xfe, 0xfb, 0x00, 0x02, 0x07, 0xff, 0xfe, 0xfb, 0x00, 0x02, 0x07,
+    0xff, 0xfe, 0xfb, 0x00, 0x02, 0x07, 0xff, 0xfe, 0xfb, 0x00, 0x05, 0x07, 0xff, 0xfe, 0x00, 0x07,
+    0xfc, 0xfe, 0x00, 0x1e, 0x07, 0xff, 0xfe, 0x00, 0x7f, 0xff, 0xc0, 0x00, 0x00, 0x0f, 0xff, 0xfe,
+    0x03, 0xff, 0xff, 0xf8, 0x00, 0x00, 0x0f, 0xff, 0xfe, 0x07, 0xff, 0xff, 0xfe, 0x00, 0x00, 0x0f,
+    0xff, 0xfe, 0x1f, 0xfe, 0xff, 0x05, 0x80, 0x00, 0x0f, 0xff, 0xfe, 0x3f, 0xfe, 0xff, 0x05, 0xc0,
+    0x00, 0x0f, 0xff, 0xfc, 0x7f, 0xfe, 0xff, 0x04, 0xe0, 0x00, 0x0f, 0xff, 0xfc, 0xfd, 0xff, 0x04,
+    0xf0, 0x00, 0x0f, 0xff, 0xfc, 0xfd, 0xff, 0x02, 0xf8, 0x00, 0x0f, 0xfb, 0xff, 0x02, 0xfc, 0x00,
+    0x0f, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x0f, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x0f, 0xfa, 0xff, 0x01,
+    0x00, 0x0f, 0xfa, 0xff, 0x01, 0x80, 0x0f, 0xfa, 0xff, 0x01, 0x80, 0x1f, 0xfe, 0xff, 0x00, 0x87,
+    0xfe, 0xff, 0x36, 0xc0, 0x1f, 0xff, 0xff, 0xf8, 0x00, 0x7f, 0xff, 0xff, 0xc0, 0x1f, 0xff, 0xff,
+    0xf0, 0x00, 0x1f, 0xff, 0xff, 0xc0, 0x1f, 0xff, 0xff, 0xe0, 0x00, 0x0f, 0xff, 0xff, 0xe0, 0x1f,
+    0xff, 0xff, 0xc0, 0x00, 0x07, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0x80, 0x00, 0x03, 0xff, 0xff,
+    0xe0, 0x1f, 0xff, 0xff, 0x00, 0x00, 0x03, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff,
+    0xf0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf0, 0xfb,
+    0x00, 0xff, 0xff, 0x00, 0xf0, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xf0, 0xfb, 0x00, 0xff, 0xff, 0x00,
+    0xf0, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xf0, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xf0, 0xfb, 0x00, 0xff,
+    0xff, 0x00, 0xf0, 0xfb, 0x00, 0xff, 0xff, 0x4d, 0xf0, 0x3f, 0xff, 0xfe, 0x00, 0x00, 0x01, 0xff,
+    0xff, 0xf0, 0x3f, 0xff, 0xfe, 0x00, 0x00, 0x01, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff, 0x00, 0x00,
+    0x01, 0xff, 0xff, 0xe0, 0x3f, 0xff, 0xff, 0x00, 0x00, 0x03, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff,
+    0x80, 0x00, 0x07, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0xc0, 0x00, 0x07, 0xff, 0xff, 0xe0, 0x1f,
+    0xff, 0xff, 0xe0, 0x00, 0x1f, 0xff, 0xff, 0xc0, 0x1f, 0xff, 0xff, 0xf0, 0x00, 0x3f, 0xff, 0xff,
+    0xc0, 0x0f, 0xff, 0xff, 0xfc, 0x00, 0xfe, 0xff, 0x01, 0xc0, 0x0f, 0xfa, 0xff, 0x01, 0x80, 0x0f,
+    0xfa, 0xff, 0x01, 0x80, 0x07, 0xfa, 0xff, 0x01, 0x00, 0x03, 0xfa, 0xff, 0x01, 0x00, 0x03, 0xfb,
+    0xff, 0x02, 0xfe, 0x00, 0x01, 0xfb, 0xff, 0x02, 0xfc, 0x00, 0x00, 0xfb, 0xff, 0x02, 0xf8, 0x00,
+    0x00, 0xfb, 0xff, 0x03, 0xf8, 0x00, 0x00, 0x7f, 0xfc, 0xff, 0x03, 0xf0, 0x00, 0x00, 0x3f, 0xfc,
+    0xff, 0x03, 0xe0, 0x00, 0x00, 0x0f, 0xfc, 0xff, 0x03, 0x80, 0x00, 0x00, 0x07, 0xfc, 0xff, 0xfe,
+    0x00, 0x00, 0x03, 0xfd, 0xff, 0x00, 0xfe, 0xfd, 0x00, 0xfd, 0xff, 0x00, 0xf8, 0xfd, 0x00, 0x00,
+    0x3f, 0xfe, 0xff, 0x00, 0xe0, 0xfd, 0x00, 0x00, 0x07, 0xfe, 0xff, 0xfb, 0x00, 0xff, 0xff, 0x00,
+    0xf8, 0xfb, 0x00, 0x01, 0x01, 0xfe, 0x91, 0x00
+};
+const PackedBitmap DIGIT_5_BITMAP = {DIGIT_5_DATA, sizeof(DIGIT_5_DATA), DIGIT_WIDTH, DIGIT_HEIGHT};
+
+static const uint8_t DIGIT_6_DATA[] PROGMEM = { // 990 bytes raw
+    0x9b, 0x00, 0x03, 0x01, 0xff, 0xff, 0xfe, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xfc, 0xfc, 0x00,
+    0x03, 0x07, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x1f,
+    0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x3f, 0xff, 0xff,
+    0xc0, 0xfc, 0x00, 0x03, 0x7f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00,
+    0x00, 0x01, 0xfe, 0xff, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xfe, 0xfc, 0x00, 0x03, 0x03, 0xff,
+    0xff, 0xfe, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xfc, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xf8,
+    0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0xe0, 0xfc, 0x00,
+    0x03, 0x3f, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x7f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0xfe, 0xff,
+    0x00, 0x80, 0xfc, 0x00, 0xfe, 0xff, 0xfc, 0x00, 0x00, 0x01, 0xfe, 0xff, 0xfc, 0x00, 0x03, 0x03,
+    0xff, 0xff, 0xfe, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xfc, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff,
+    0xf8, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0xf0, 0xfc,
+    0x00, 0x03, 0x1f, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x3f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03,
+    0x3f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x05, 0x7f, 0xff, 0xff, 0x81, 0xff, 0xf0, 0xfe, 0x00, 0xfe,
+    0xff, 0x02, 0x0f, 0xff, 0xfe, 0xfe, 0x00, 0xfe, 0xff, 0x0e, 0x3f, 0xff, 0xff, 0x80, 0x00, 0x01,
+    0xff, 0xff, 0xfe, 0x7f, 0xff, 0xff, 0xe0, 0x00, 0x01, 0xfb, 0xff, 0x02, 0xf0, 0x00, 0x03, 0xfb,
+    0xff, 0x02, 0xf8, 0x00, 0x03, 0xfb, 0xff, 0x02, 0xfc, 0x00, 0x07, 0xfb, 0xff, 0x02, 0xfe, 0x00,
+    0x07, 0xfa, 0xff, 0x01, 0x00, 0x0f, 0xfa, 0xff, 0x01, 0x80, 0x0f, 0xfa, 0xff, 0x01, 0xc0, 0x0f,
+    0xfa, 0xff, 0x01, 0xc0, 0x1f, 0xfa, 0xff, 0x01, 0xe0, 0x1f, 0xfa, 0xff, 0x01, 0xf0, 0x1f, 0xfa,
+    0xff, 0x39, 0xf0, 0x1f, 0xff, 0xff, 0xfe, 0x00, 0x7f, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff, 0xf8,
+    0x00, 0x1f, 0xff, 0xff, 0xf8, 0x3f, 0xff, 0xff, 0xe0, 0x00, 0x07, 0xff, 0xff, 0xf8, 0x3f, 0xff,
+    0xff, 0xc0, 0x00, 0x03, 0xff, 0xff, 0xfc, 0x3f, 0xff, 0xff, 0x80, 0x00, 0x01, 0xff, 0xff, 0xfc,
+    0x3f, 0xff, 0xff, 0x80, 0x00, 0x01, 0xff, 0xff, 0xfc, 0x3f, 0xff, 0xff, 0xfe, 0x00, 0xff, 0xff,
+    0x03, 0xfc, 0x3f, 0xff, 0xff, 0xfe, 0x00, 0xff, 0xff, 0x03, 0xfc, 0x7f, 0xff, 0xfe, 0xfe, 0x00,
+    0x05, 0x7f, 0xff, 0xfc, 0x7f, 0xff, 0xfe, 0xfe, 0x00, 0x05, 0x7f, 0xff, 0xfc, 0x7f, 0xff, 0xfe,
+    0xfe, 0x00, 0x05, 0x7f, 0xff, 0xfc, 0x7f, 0xff, 0xfe, 0xfe, 0x00, 0x05, 0x7f, 0xff, 0xfc, 0x3f,
+    0xff, 0xfe, 0xfe, 0x00, 0x05, 0x7f, 0xff, 0xfc, 0x3f, 0xff, 0xfe, 0xfe, 0x00, 0x05, 0x7f, 0xff,
+    0xfc, 0x3f, 0xff, 0xfe, 0xfe, 0x00, 0x05, 0x7f, 0xff, 0xfc, 0x3f, 0xff, 0xfe, 0xfe, 0x00, 0x05,
+    0x7f, 0xff, 0xfc, 0x3f, 0xff, 0xfe, 0xfe, 0x00, 0x05, 0x7f, 0xff, 0xfc, 0x3f, 0xff, 0xfe, 0xfe,
+    0x00, 0xff, 0xff, 0x03, 0xfc, 0x3f, 0xff, 0xff, 0xfe, 0x00, 0xff, 0xff, 0x37, 0xfc, 0x1f, 0xff,
+    0xff, 0x00, 0x00, 0x01, 0xff, 0xff, 0xfc, 0x1f, 0xff, 0xff, 0x80, 0x00, 0x01, 0xff, 0xff, 0xf8,
+    0x1f, 0xff, 0xff, 0xc0, 0x00, 0x03, 0xff, 0xff, 0xf8, 0x0f, 0xff, 0xff, 0xe0, 0x00, 0x07, 0xff,
+    0xff, 0xf8, 0x0f, 0xff, 0xff, 0xf0, 0x00, 0x0f, 0xff, 0xff, 0xf0, 0x0f, 0xff, 0xff, 0xfc, 0x00,
+    0x3f, 0xff, 0xff, 0xf0, 0x07, 0xfe, 0xff, 0x00, 0xc3, 0xfe, 0xff, 0x01, 0xe0, 0x07, 0xfa, 0xff,
+    0x01, 0xe0, 0x03, 0xfa, 0xff, 0x01, 0xc0, 0x01, 0xfa, 0xff, 0x01, 0xc0, 0x01, 0xfa, 0xff, 0x01,
+    0x80, 0x00, 0xfa, 0xff, 0xff, 0x00, 0x00, 0x7f, 0xfc, 0xff, 0x03, 0xfe, 0x00, 0x00, 0x3f, 0xfc,
+    0xff, 0x03, 0xfc, 0x00, 0x00, 0x1f, 0xfc, 0xff, 0x03, 0xf8, 0x00, 0x00, 0x0f, 0xfc, 0xff, 0x03,
+    0xf0, 0x00, 0x00, 0x07, 0xfc, 0xff, 0x03, 0xe0, 0x00, 0x00, 0x01, 0xfc, 0xff, 0x00, 0x80, 0xfe,
+    0x00, 0xfc, 0xff, 0xfd, 0x00, 0x00, 0x3f, 0xfe, 0xff, 0x00, 0xfc, 0xfd, 0x00, 0x00, 0x0f, 0xfe,
+    0xff, 0x00, 0xf0, 0xfd, 0x00, 0x00, 0x01, 0xfe, 0xff, 0x00, 0xc0, 0xfc, 0x00, 0x02, 0x3f, 0xff,
+    0xfc, 0xfa, 0x00, 0x01, 0xff, 0x80, 0x92, 0x00
+};
+const PackedBitmap DIGIT_6_BITMAP = {DIGIT_6_DATA, sizeof(DIGIT_6_DATA), DIGIT_WIDTH, DIGIT_HEIGHT};
+
+static const uint8_t DIGIT_7_DATA[] PROGMEM = { // 990 bytes raw
+    0x95, 0x00, 0x00, 0x0f, 0xfa, 0xff, 0x01, 0xe0, 0x0f, 0xfa, 0xff, 0x01, 0xe0, 0x0f, 0xfa, 0xff,
+    0x01, 0xe0, 0x0f, 0xfa, 0xff, 0x01, 0xe0, 0x0f, 0xfa, 0xff, 0x01, 0xe0, 0x0f, 0xfa, 0xff, 0x01,
+    0xe0, 0x0f, 0xfa, 0xff, 0x01, 0xe0, 0x0f, 0xfa, 0xff, 0x01, 0xe0, 0x0f, 0xfa, 0xff, 0x01, 0xe0,
+    0x0f, 0xfa, 0xff, 0x01, 0xe0, 0x0f, 0xfa, 0xff, 0x01, 0xe0, 0x0f, 0xfa, 0xff, 0x01, 0xe0, 0x0f,
+    0xfa, 0xff, 0x01, 0xe0, 0x0f, 0xfa, 0xff, 0x01, 0xe0, 0x0f, 0xfa, 0xff, 0x01, 0xe0, 0x0f, 0xfa,
+    0xff, 0x01, 0xe0, 0x0f, 0xfa, 0xff, 0x00, 0xe0, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xe0, 0xfc,
+    0x00, 0x03, 0x07, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03,
+    0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x02, 0x1f, 0xff,
+    0xff, 0xfb, 0x00, 0x02, 0x1f, 0xff, 0xff, 0xfb, 0x00, 0x02, 0x3f, 0xff, 0xfe, 0xfb, 0x00, 0x02,
+    0x3f, 0xff, 0xfe, 0xfb, 0x00, 0x02, 0x7f, 0xff, 0xfc, 0xfb, 0x00, 0x02, 0x7f, 0xff, 0xfc, 0xfb,
+    0x00, 0xff, 0xff, 0x00, 0xf8, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xf8, 0xfc, 0x00, 0x03, 0x01, 0xff,
+    0xff, 0xf0, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xe0,
+    0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xc0, 0xfc, 0x00,
+    0x03, 0x0f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x1f,
+    0xff, 0xff, 0x80, 0xfc, 0x00, 0x02, 0x1f, 0xff, 0xff, 0xfb, 0x00, 0x02, 0x3f, 0xff, 0xff, 0xfb,
+    0x00, 0x02, 0x3f, 0xff, 0xfe, 0xfb, 0x00, 0x02, 0x7f, 0xff, 0xfe, 0xfb, 0x00, 0x02, 0x7f, 0xff,
+    0xfc, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xfc, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xf8, 0xfc, 0x00, 0x03,
+    0x01, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x03, 0xff,
+    0xff, 0xf0, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xe0,
+    0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xc0, 0xfc, 0x00,
+    0x03, 0x1f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x02, 0x3f,
+    0xff, 0xff, 0xfb, 0x00, 0x02, 0x3f, 0xff, 0xff, 0xfb, 0x00, 0x02, 0x7f, 0xff, 0xfe, 0xfb, 0x00,
+    0x02, 0x7f, 0xff, 0xfe, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xfc, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xfc,
+    0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xf8, 0xfc, 0x00,
+    0x03, 0x03, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x07,
+    0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff,
+    0xc0, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0x80, 0xfc,
+    0x00, 0x03, 0x1f, 0xff, 0xff, 0x80, 0xfc, 0x00, 0x02, 0x3f, 0xff, 0xff, 0xfb, 0x00, 0x02, 0x7f,
+    0xff, 0xff, 0xfb, 0x00, 0x02, 0x7f, 0xff, 0xfe, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xfe, 0xfb, 0x00,
+    0xff, 0xff, 0x00, 0xfc, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xfc, 0xfc, 0x00, 0x03, 0x01, 0xff,
+    0xff, 0xf8, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xf0,
+    0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xe0, 0xfc, 0x00,
+    0x03, 0x0f, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x1f,
+    0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0x80, 0x88, 0x00
+};
+const PackedBitmap DIGIT_7_BITMAP = {DIGIT_7_DATA, sizeof(DIGIT_7_DATA), DIGIT_WIDTH, DIGIT_HEIGHT};
+
+static const uint8_t DIGIT_8_DATA[] PROGMEM = { // 990 bytes raw
+    0xa4, 0x00, 0x02, 0x3f, 0xff, 0xf0, 0xfc, 0x00, 0x00, 0x03, 0xfe, 0xff, 0xfc, 0x00, 0x00, 0x1f,
+    0xfe, 0xff, 0x00, 0xe0, 0xfd, 0x00, 0xfd, 0xff, 0x00, 0xfc, 0xfe, 0x00, 0x00, 0x03, 0xfc, 0xff,
+    0xfe, 0x00, 0x00, 0x07, 0xfc, 0xff, 0x03, 0x80, 0x00, 0x00, 0x1f, 0xfc, 0xff, 0x03, 0xe0, 0x00,
+    0x00, 0x3f, 0xfc, 0xff, 0x03, 0xf0, 0x00, 0x00, 0x7f, 0xfc, 0xff, 0x02, 0xf8, 0x00, 0x00, 0xfb,
+    0xff, 0x02, 0xfc, 0x00, 0x01, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x03, 0xfa, 0xff, 0x01, 0x00, 0x07,
+    0xfa, 0xff, 0x01, 0x80, 0x07, 0xfa, 0xff, 0x01, 0x80, 0x0f, 0xfe, 0xff, 0x00, 0x8f, 0xfe, 0xff,
+    0x7f, 0xc0, 0x0f, 0xff, 0xff, 0xfc, 0x00, 0x7f, 0xff, 0xff, 0xc0, 0x1f, 0xff, 0xff, 0xf0, 0x00,
+    0x3f, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0xe0, 0x00, 0x1f, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff,
+    0xc0, 0x00, 0x0f, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0x80, 0x00, 0x07, 0xff, 0xff, 0xe0, 0x3f,
+    0xff, 0xff, 0x00, 0x00, 0x03, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff, 0x00, 0x00, 0x03, 0xff, 0xff,
+    0xf0, 0x3f, 0xff, 0xff, 0x00, 0x00, 0x03, 0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff, 0x00, 0x00, 0x03,
+    0xff, 0xff, 0xf0, 0x3f, 0xff, 0xff, 0x00, 0x00, 0x03, 0xff, 0xff, 0xf0, 0x1f, 0xff, 0xff, 0x00,
+    0x00, 0x03, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0x00, 0x00, 0x03, 0xff, 0xff, 0xe0, 0x1f, 0xff,
+    0xff, 0x00, 0x00, 0x03, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0x00, 0x00, 0x03, 0xff, 0xff, 0xe0,
+    0x0f, 0xff, 0xff, 0x33, 0x80, 0x00, 0x07, 0xff, 0xff, 0xc0, 0x0f, 0xff, 0xff, 0x80, 0x00, 0x07,
+    0xff, 0xff, 0xc0, 0x07, 0xff, 0xff, 0xc0, 0x00, 0x0f, 0xff, 0xff, 0x80, 0x07, 0xff, 0xff, 0xe0,
+    0x00, 0x1f, 0xff, 0xff, 0x80, 0x03, 0xff, 0xff, 0xf8, 0x00, 0x7f, 0xff, 0xff, 0x00, 0x01, 0xff,
+    0xff, 0xfe, 0x01, 0xff, 0xff, 0xfe, 0x00, 0x00, 0xfb, 0xff, 0x03, 0xfc, 0x00, 0x00, 0x7f, 0xfc,
+    0xff, 0x03, 0xf8, 0x00, 0x00, 0x3f, 0xfc, 0xff, 0x03, 0xf0, 0x00, 0x00, 0x0f, 0xfc, 0xff, 0x03,
+    0xc0, 0x00, 0x00, 0x03, 0xfc, 0xff, 0xfd, 0x00, 0x00, 0x7f, 0xfe, 0xff, 0x00, 0xf8, 0xfd, 0x00,
+    0x00, 0x3f, 0xfe, 0xff, 0x00, 0xf0, 0xfd, 0x00, 0xfd, 0xff, 0x00, 0xfc, 0xfe, 0x00, 0x00, 0x07,
+    0xfc, 0xff, 0x03, 0x80, 0x00, 0x00, 0x1f, 0xfc, 0xff, 0x03, 0xe0, 0x00, 0x00, 0x7f, 0xfc, 0xff,
+    0x02, 0xf8, 0x00, 0x00, 0xfb, 0xff, 0x02, 0xfc, 0x00, 0x03, 0xfa, 0xff, 0x01, 0x00, 0x07, 0xfa,
+    0xff, 0x01, 0x80, 0x0f, 0xfa, 0xff, 0x39, 0xc0, 0x1f, 0xff, 0xff, 0xf8, 0x00, 0x7f, 0xff, 0xff,
+    0xe0, 0x1f, 0xff, 0xff, 0xe0, 0x00, 0x1f, 0xff, 0xff, 0xe0, 0x3f, 0xff, 0xff, 0xc0, 0x00, 0x0f,
+    0xff, 0xff, 0xf0, 0x7f, 0xff, 0xff, 0x00, 0x00, 0x03, 0xff, 0xff, 0xf8, 0x7f, 0xff, 0xff, 0x00,
+    0x00, 0x03, 0xff, 0xff, 0xf8, 0xff, 0xff, 0xfe, 0x00, 0x00, 0x01, 0xff, 0xff, 0xfc, 0xff, 0xff,
+    0xfc, 0xfe, 0x00, 0xff, 0xff, 0x03, 0xfc, 0xff, 0xff, 0xfc, 0xfe, 0x00, 0xff, 0xff, 0x03, 0xfc,
+    0xff, 0xff, 0xfc, 0xfe, 0x00, 0xff, 0xff, 0x03, 0xfc, 0xff, 0xff, 0xfc, 0xfe, 0x00, 0xff, 0xff,
+    0x03, 0xfc, 0xff, 0xff, 0xf8, 0xfe, 0x00, 0x05, 0x7f, 0xff, 0xfc, 0xff, 0xff, 0xf8, 0xfe, 0x00,
+    0x05, 0x7f, 0xff, 0xfc, 0xff, 0xff, 0xfc, 0xfe, 0x00, 0xff, 0xff, 0x03, 0xfc, 0xff, 0xff, 0xfc,
+    0xfe, 0x00, 0xff, 0xff, 0x03, 0xfc, 0xff, 0xff, 0xfc, 0xfe, 0x00, 0xff, 0xff, 0x03, 0xfc, 0xff,
+    0xff, 0xfc, 0xfe, 0x00, 0xff, 0xff, 0x12, 0xfc, 0xff, 0xff, 0xfe, 0x00, 0x00, 0x01, 0xff, 0xff,
+    0xfc, 0xff, 0xff, 0xfe, 0x00, 0x00, 0x01, 0xff, 0xff, 0xfc, 0xfe, 0xff, 0xff, 0x00, 0x03, 0x03,
+    0xff, 0xff, 0xfc, 0xfe, 0xff, 0x05, 0x80, 0x00, 0x07, 0xff, 0xff, 0xfc, 0xfe, 0xff, 0x0f, 0xe0,
+    0x00, 0x1f, 0xff, 0xff, 0xfc, 0x7f, 0xff, 0xff, 0xf8, 0x00, 0x7f, 0xff, 0xff, 0xf8, 0x7f, 0xfe,
+    0xff, 0x00, 0x87, 0xfe, 0xff, 0x01, 0xf8, 0x3f, 0xfa, 0xff, 0x01, 0xf0, 0x3f, 0xfa, 0xff, 0x01,
+    0xf0, 0x1f, 0xfa, 0xff, 0x01, 0xe0, 0x0f, 0xfa, 0xff, 0x01, 0xc0, 0x07, 0xfa, 0xff, 0x01, 0x80,
+    0x03, 0xfa, 0xff, 0x01, 0x00, 0x01, 0xfb, 0xff, 0x02, 0xfe, 0x00, 0x00, 0xfb, 0xff, 0x03, 0xfc,
+    0x00, 0x00, 0x3f, 0xfc, 0xff, 0x03, 0xf0, 0x00, 0x00, 0x1f, 0xfc, 0xff, 0x03, 0xe0, 0x00, 0x00,
+    0x07, 0xfc, 0xff, 0x00, 0x80, 0xfe, 0x00, 0xfd, 0xff, 0x00, 0xfc, 0xfd, 0x00, 0x00, 0x3f, 0xfe,
+    0xff, 0x00, 0xe0, 0xfd, 0x00, 0x00, 0x01, 0xfe, 0xff, 0xfb, 0x00, 0x02, 0x03, 0xff, 0x80, 0x92,
+    0x00
+};
+const PackedBitmap DIGIT_8_BITMAP = {DIGIT_8_DATA, sizeof(DIGIT_8_DATA), DIGIT_WIDTH, DIGIT_HEIGHT};
+
+static const uint8_t DIGIT_9_DATA[] PROGMEM = { // 990 bytes raw
+    0x9b, 0x00, 0x02, 0x1f, 0xff, 0xf0, 0xfc, 0x00, 0x00, 0x01, 0xfe, 0xff, 0xfc, 0x00, 0x00, 0x0f,
+    0xfe, 0xff, 0x00, 0xe0, 0xfd, 0x00, 0x00, 0x3f, 0xfe, 0xff, 0x00, 0xf8, 0xfd, 0x00, 0xfd, 0xff,
+    0x00, 0xfe, 0xfe, 0x00, 0x00, 0x01, 0xfc, 0xff, 0xfe, 0x00, 0x00, 0x07, 0xfc, 0xff, 0x03, 0xc0,
+    0x00, 0x00, 0x0f, 0xfc, 0xff, 0x03, 0xe0, 0x00, 0x00, 0x1f, 0xfc, 0xff, 0x03, 0xf0, 0x00, 0x00,
+    0x3f, 0xfc, 0xff, 0x03, 0xf8, 0x00, 0x00, 0x7f, 0xfc, 0xff, 0x02, 0xfc, 0x00, 0x00, 0xfb, 0xff,
+    0x02, 0xfe, 0x00, 0x01, 0xfa, 0xff, 0x01, 0x00, 0x03, 0xfa, 0xff, 0x01, 0x80, 0x03, 0xfa, 0xff,
+    0x01, 0x80, 0x07, 0xfa, 0xff, 0x01, 0xc0, 0x0f, 0xfa, 0xff, 0x05, 0xc0, 0x0f, 0xff, 0xff, 0xfe,
+    0x00, 0xfe, 0xff, 0x39, 0xe0, 0x1f, 0xff, 0xff, 0xf8, 0x00, 0x1f, 0xff, 0xff, 0xe0, 0x1f, 0xff,
+    0xff, 0xe0, 0x00, 0x0f, 0xff, 0xff, 0xf0, 0x1f, 0xff, 0xff, 0xc0, 0x00, 0x07, 0xff, 0xff, 0xf0,
+    0x3f, 0xff, 0xff, 0x80, 0x00, 0x03, 0xff, 0xff, 0xf8, 0x3f, 0xff, 0xff, 0x00, 0x00, 0x01, 0xff,
+    0xff, 0xf8, 0x3f, 0xff, 0xff, 0x00, 0x00, 0x01, 0xff, 0xff, 0xf8, 0x7f, 0xff, 0xfe, 0xfe, 0x00,
+    0xff, 0xff, 0x03, 0xf8, 0x7f, 0xff, 0xfe, 0xfe, 0x00, 0xff, 0xff, 0x03, 0xfc, 0x7f, 0xff, 0xfe,
+    0xfe, 0x00, 0x05, 0x7f, 0xff, 0xfc, 0x7f, 0xff, 0xfc, 0xfe, 0x00, 0x05, 0x7f, 0xff, 0xfc, 0x7f,
+    0xff, 0xfc, 0xfe, 0x00, 0x05, 0x7f, 0xff, 0xfc, 0x7f, 0xff, 0xfc, 0xfe, 0x00, 0x05, 0x7f, 0xff,
+    0xfc, 0x7f, 0xff, 0xfc, 0xfe, 0x00, 0x05, 0x7f, 0xff, 0xfc, 0x7f, 0xff, 0xfc, 0xfe, 0x00, 0x05,
+    0x7f, 0xff, 0xfc, 0x7f, 0xff, 0xfe, 0xfe, 0x00, 0x05, 0x7f, 0xff, 0xfc, 0x7f, 0xff, 0xfe, 0xfe,
+    0x00, 0xff, 0xff, 0x03, 0xfc, 0x7f, 0xff, 0xfe, 0xfe, 0x00, 0xff, 0xff, 0x03, 0xfc, 0x7f, 0xff,
+    0xff, 0xfe, 0x00, 0xff, 0xff, 0x37, 0xfc, 0x7f, 0xff, 0xff, 0x00, 0x00, 0x01, 0xff, 0xff, 0xfc,
+    0x3f, 0xff, 0xff, 0x80, 0x00, 0x03, 0xff, 0xff, 0xfc, 0x3f, 0xff, 0xff, 0x80, 0x00, 0x03, 0xff,
+    0xff, 0xfc, 0x3f, 0xff, 0xff, 0xc0, 0x00, 0x07, 0xff, 0xff, 0xf8, 0x3f, 0xff, 0xff, 0xf0, 0x00,
+    0x1f, 0xff, 0xff, 0xf8, 0x1f, 0xff, 0xff, 0xfc, 0x00, 0x3f, 0xff, 0xff, 0xf8, 0x1f, 0xfe, 0xff,
+    0x00, 0x83, 0xfe, 0xff, 0x01, 0xf8, 0x0f, 0xfa, 0xff, 0x01, 0xf8, 0x0f, 0xfa, 0xff, 0x01, 0xf0,
+    0x07, 0xfa, 0xff, 0x01, 0xf0, 0x07, 0xfa, 0xff, 0x01, 0xf0, 0x03, 0xfa, 0xff, 0x01, 0xe0, 0x01,
+    0xfa, 0xff, 0x01, 0xe0, 0x00, 0xfa, 0xff, 0x02, 0xc0, 0x00, 0x7f, 0xfb, 0xff, 0x02, 0xc0, 0x00,
+    0x7f, 0xfb, 0xff, 0x02, 0xc0, 0x00, 0x1f, 0xfb, 0xff, 0x0e, 0x80, 0x00, 0x0f, 0xff, 0xff, 0xfe,
+    0x7f, 0xff, 0xff, 0x80, 0x00, 0x03, 0xff, 0xff, 0xfc, 0xfe, 0xff, 0xfe, 0x00, 0xff, 0xff, 0x03,
+    0xf0, 0xff, 0xff, 0xfe, 0xfe, 0x00, 0x05, 0x3f, 0xff, 0xc1, 0xff, 0xff, 0xfe, 0xfe, 0x00, 0x05,
+    0x03, 0xfc, 0x03, 0xff, 0xff, 0xfc, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xfc, 0xfc, 0x00, 0x03,
+    0x07, 0xff, 0xff, 0xf8, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x1f, 0xff,
+    0xff, 0xf0, 0xfc, 0x00, 0x03, 0x3f, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x3f, 0xff, 0xff, 0xc0,
+    0xfc, 0x00, 0x03, 0x7f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00,
+    0x01, 0xfe, 0xff, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xfe, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff,
+    0xfe, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff, 0xfc, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xf8, 0xfc,
+    0x00, 0x03, 0x0f, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03,
+    0x3f, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x7f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03, 0x7f, 0xff,
+    0xff, 0x80, 0xfc, 0x00, 0xfe, 0xff, 0xfc, 0x00, 0x00, 0x01, 0xfe, 0xff, 0xfc, 0x00, 0x03, 0x03,
+    0xff, 0xff, 0xfe, 0xfc, 0x00, 0x03, 0x03, 0xff, 0xff, 0xfc, 0xfc, 0x00, 0x03, 0x07, 0xff, 0xff,
+    0xf8, 0xfc, 0x00, 0x03, 0x0f, 0xff, 0xff, 0xf0, 0xfc, 0x00, 0x03, 0x1f, 0xff, 0xff, 0xf0, 0xfc,
+    0x00, 0x03, 0x3f, 0xff, 0xff, 0xe0, 0xfc, 0x00, 0x03, 0x3f, 0xff, 0xff, 0xc0, 0xfc, 0x00, 0x03,
+    0x7f, 0xff, 0xff, 0x80, 0x89, 0x00
+};
+const PackedBitmap DIGIT_9_BITMAP = {DIGIT_9_DATA, sizeof(DIGIT_9_DATA), DIGIT_WIDTH, DIGIT_HEIGHT};
+
+static const uint8_t COLON_DATA[] PROGMEM = { // 990 bytes raw
+    0x81, 0x00, 0xdb, 0x00, 0x00, 0xf8, 0xfa, 0x00, 0x02, 0x07, 0xff, 0x80, 0xfb, 0x00, 0x02, 0x1f,
+    0xff, 0xe0, 0xfb, 0x00, 0x02, 0x3f, 0xff, 0xf0, 0xfb, 0x00, 0x02, 0x7f, 0xff, 0xf8, 0xfb, 0x00,
+    0xff, 0xff, 0x00, 0xfc, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xfe, 0xfc, 0x00, 0x00, 0x03, 0xfe,
+    0xff, 0xfc, 0x00, 0x00, 0x03, 0xfe, 0xff, 0xfc, 0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0x80, 0xfd,
+    0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0x80, 0xfd,
+    0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0xc0, 0xfd, 0x00, 0x00, 0x0f, 0xfe, 0xff, 0x00, 0xc0, 0xfd,
+    0x00, 0x00, 0x0f, 0xfe, 0xff, 0x00, 0xc0, 0xfd, 0x00, 0x00, 0x0f, 0xfe, 0xff, 0x00, 0xc0, 0xfd,
+    0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0xc0, 0xfd, 0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0xc0, 0xfd,
+    0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0x80, 0xfd,
+    0x00, 0x00, 0x03, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x03, 0xfe, 0xff, 0xfc, 0x00, 0x00,
+    0x01, 0xfe, 0xff, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xfe, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xfc,
+    0xfb, 0x00, 0x02, 0x7f, 0xff, 0xf8, 0xfb, 0x00, 0x02, 0x3f, 0xff, 0xf0, 0xfb, 0x00, 0x02, 0x0f,
+    0xff, 0xe0, 0xfb, 0x00, 0x02, 0x03, 0xff, 0x80, 0xfa, 0x00, 0x00, 0x38, 0x81, 0x00, 0xfb, 0x00,
+    0x00, 0xfc, 0xfa, 0x00, 0x02, 0x07, 0xff, 0x80, 0xfb, 0x00, 0x02, 0x1f, 0xff, 0xe0, 0xfb, 0x00,
+    0x02, 0x3f, 0xff, 0xf0, 0xfb, 0x00, 0x02, 0x7f, 0xff, 0xf8, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xfc,
+    0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xfe, 0xfc, 0x00, 0x00, 0x03, 0xfe, 0xff, 0xfc, 0x00, 0x00,
+    0x03, 0xfe, 0xff, 0xfc, 0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x07, 0xfe,
+    0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x07, 0xfe,
+    0xff, 0x00, 0xc0, 0xfd, 0x00, 0x00, 0x0f, 0xfe, 0xff, 0x00, 0xc0, 0xfd, 0x00, 0x00, 0x0f, 0xfe,
+    0xff, 0x00, 0xc0, 0xfd, 0x00, 0x00, 0x0f, 0xfe, 0xff, 0x00, 0xc0, 0xfd, 0x00, 0x00, 0x07, 0xfe,
+    0xff, 0x00, 0xc0, 0xfd, 0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0xc0, 0xfd, 0x00, 0x00, 0x07, 0xfe,
+    0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x03, 0xfe,
+    0xff, 0x00, 0x80, 0xfd, 0x00, 0x00, 0x03, 0xfe, 0xff, 0xfc, 0x00, 0x00, 0x01, 0xfe, 0xff, 0xfc,
+    0x00, 0x03, 0x01, 0xff, 0xff, 0xfe, 0xfb, 0x00, 0xff, 0xff, 0x00, 0xfc, 0xfb, 0x00, 0x02, 0x7f,
+    0xff, 0xf8, 0xfb, 0x00, 0x02, 0x3f, 0xff, 0xf0, 0xfb, 0x00, 0x02, 0x0f, 0xff, 0xe0, 0xfb, 0x00,
+    0x02, 0x03, 0xff, 0x80, 0xfa, 0x00, 0x00, 0x38, 0x81, 0x00, 0xdb, 0x00
+};
+const PackedBitmap COLON_BITMAP = {COLON_DATA, sizeof(COLON_DATA), DIGIT_WIDTH, DIGIT_HEIGHT};
+
+static const uint8_t DEGREE_DATA[] PROGMEM = { // 990 bytes raw
+    0xa4, 0x00, 0x01, 0x03, 0xff, 0xfa, 0x00, 0x02, 0x1f, 0xff, 0xe0, 0xfb, 0x00, 0xff, 0xff, 0x00,
+    0xfc, 0xfc, 0x00, 0x03, 0x01, 0xff, 0xff, 0xfe, 0xfc, 0x00, 0x00, 0x07, 0xfe, 0xff, 0x00, 0x80,
+    0xfd, 0x00, 0x00, 0x0f, 0xfe, 0xff, 0x00, 0xc0, 0xfd, 0x00, 0x00, 0x1f, 0xfe, 0xff, 0x00, 0xe0,
+    0xfd, 0x00, 0x00, 0x3f, 0xfe, 0xff, 0x00, 0xf0, 0xfd, 0x00, 0x00, 0x7f, 0xfe, 0xff, 0x00, 0xf8,
+    0xfd, 0x00, 0x00, 0x7f, 0xfe, 0xff, 0x00, 0xf8, 0xfd, 0x00, 0xfd, 0xff, 0x00, 0xfc, 0xfe, 0x00,
+    0x00, 0x01, 0xfd, 0xff, 0x00, 0xfe, 0xfe, 0x00, 0x05, 0x01, 0xff, 0xff, 0x03, 0xff, 0xfe, 0xfe,
+    0x00, 0x05, 0x03, 0xff, 0xfc, 0x00, 0xff, 0xff, 0xfe, 0x00, 0x05, 0x03, 0xff, 0xf8, 0x00, 0x3f,
+    0xff, 0xfe, 0x00, 0x05, 0x03, 0xff, 0xf0, 0x00, 0x3f, 0xff, 0xfe, 0x00, 0x71, 0x03, 0xff, 0xe0,
+    0x00, 0x1f, 0xff, 0x80, 0x00, 0x00, 0x07, 0xff, 0xc0, 0x00, 0x0f, 0xff, 0x80, 0x00, 0x00, 0x07,
+    0xff, 0xc0, 0x00, 0x0f, 0xff, 0x80, 0x00, 0x00, 0x07, 0xff, 0xc0, 0x00, 0x0f, 0xff, 0x80, 0x00,
+    0x00, 0x07, 0xff, 0xc0, 0x00, 0x07, 0xff, 0x80, 0x00, 0x00, 0x07, 0xff, 0x80, 0x00, 0x07, 0xff,
+    0x80, 0x00, 0x00, 0x07, 0xff, 0x80, 0x00, 0x07, 0xff, 0x80, 0x00, 0x00, 0x07, 0xff, 0x80, 0x00,
+    0x07, 0xff, 0x80, 0x00, 0x00, 0x07, 0xff, 0xc0, 0x00, 0x07, 0xff, 0x80, 0x00, 0x00, 0x07, 0xff,
+    0xc0, 0x00, 0x0f, 0xff, 0x80, 0x00, 0x00, 0x07, 0xff, 0xc0, 0x00, 0x0f, 0xff, 0x80, 0x00, 0x00,
+    0x07, 0xff, 0xe0, 0x00, 0x1f, 0xff, 0x80, 0x00, 0x00, 0x03, 0xff, 0xe0, 0x00, 0x1f, 0xff, 0xfe,
+    0x00, 0x05, 0x03, 0xff, 0xf0, 0x00, 0x3f, 0xff, 0xfe, 0x00, 0x05, 0x03, 0xff, 0xf8, 0x00, 0x7f,
+    0xff, 0xfe, 0x00, 0x05, 0x01, 0xff, 0xfe, 0x01, 0xff, 0xfe, 0xfe, 0x00, 0x00, 0x01, 0xfd, 0xff,
+    0x00, 0xfe, 0xfd, 0x00, 0xfd, 0xff, 0x00, 0xfc, 0xfd, 0x00, 0xfd, 0xff, 0x00, 0xfc, 0xfd, 0x00,
+    0x00, 0x7f, 0xfe, 0xff, 0x00, 0xf8, 0xfd, 0x00, 0x00, 0x3f, 0xfe, 0xff, 0x00, 0xf0, 0xfd, 0x00,
+    0x00, 0x1f, 0xfe, 0xff, 0x00, 0xf0, 0xfd, 0x00, 0x00, 0x0f, 0xfe, 0xff, 0x00, 0xe0, 0xfd, 0x00,
+    0x00, 0x07, 0xfe, 0xff, 0x00, 0xc0, 0xfd, 0x00, 0x00, 0x03, 0xfe, 0xff, 0xfb, 0x00, 0xff, 0xff,
+    0x00, 0xfe, 0xfb, 0x00, 0x02, 0x7f, 0xff, 0xf8, 0xfb, 0x00, 0x02, 0x0f, 0xff, 0xc0, 0xfa, 0x00,
+    0x00, 0x38, 0x81, 0x00, 0x81, 0x00, 0x81, 0x00, 0x8e, 0x00
+};
+const PackedBitmap DEGREE_BITMAP = {DEGREE_DATA, sizeof(DEGREE_DATA), DIGIT_WIDTH, DIGIT_HEIGHT};
@@ -1,10 +1,74 @@
 #include "display.h"
 #include "config.h"
 #include "digit_bitmaps.h"
+#include "text_format.h"
+#include "font_subsets.h" // Generated before each build by scripts/subset_fonts.py
 #include <SPI.h>
+#include <cstring>
+#include <esp_partition.h>
 #include <time.h>
 
-DisplayManager::DisplayManager() : display(GxEPD2_750_T7(PIN_CS, PIN_DC, PIN_RST, PIN_BUSY)), clockDisplay(this), weatherDisplay(this)
+// Frame decode passes
+const int FRAME_PASS_VALIDATE = 0; // Decode only, nothing sent to the panel
+const int FRAME_PASS_WRITE = 1;    // New image into controller RAM
+const int FRAME_PASS_AGAIN = 2;    // Same image into the previous-image RAM after the refresh
+
+// Ping-pong band buffers: word aligned in internal RAM so the SPI master DMAs straight from them
+static WORD_ALIGNED_ATTR uint8_t bandBuffers[2][DISPLAY_WIDTH / 8 * DISPLAY_PAGE_ROWS];
+
+// Built-in assets under the names scripts/pack_assets.py gives them
+struct BuiltInBitmap
+{
+    const char *name;
+    const PackedBitmap *bitmap;
+};
+static const BuiltInBitmap BUILT_IN_BITMAPS[] = {
+    {"DIGIT_0_BITMAP", &DIGIT_0_BITMAP}, {"DIGIT_1_BITMAP", &DIGIT_1_BITMAP}, {"DIGIT_2_BITMAP", &DIGIT_2_BITMAP},
+    {"DIGIT_3_BITMAP", &DIGIT_3_BITMAP}, {"DIGIT_4_BITMAP", &DIGIT_4_BITMAP}, {"DIGIT_5_BITMAP", &DIGIT_5_BITMAP},
+    {"DIGIT_6_BITMAP", &DIGIT_6_BITMAP}, {"DIGIT_7_BITMAP", &DIGIT_7_BITMAP}, {"DIGIT_8_BITMAP", &DIGIT_8_BITMAP},
+    {"DIGIT_9_BITMAP", &DIGIT_9_BITMAP}, {"COLON_BITMAP", &COLON_BITMAP},     {"DEGREE_BITMAP", &DEGREE_BITMAP},
+    {"cloud_bolt_rain_40x40", &cloud_bolt_rain_40x40}, {"cloud_fog_40x40", &cloud_fog_40x40},
+    {"cloud_40x40", &cloud_40x40},       {"cloud_rain_40x40", &cloud_rain_40x40},
+    {"cloud_snow_40x40", &cloud_snow_40x40}, {"sun_max_40x40", &sun_max_40x40},
+};
+static_assert(sizeof(BUILT_IN_BITMAPS) / sizeof(BUILT_IN_BITMAPS[0]) == ASSET_BITMAP_COUNT, "One slot per asset");
+
+// In UiFont order; only the glyphs the display code can draw are linked
+static const char *const FONT_NAMES[UI_FONT_COUNT] = {"FreeSans9pt7b", "FreeSansBold12pt7b", "FreeMonoBold24pt7b"};
+static const GFXfont *const BUILT_IN_FONTS[UI_FONT_COUNT] = {&FreeSans9pt7bSubset, &FreeSansBold12pt7bSubset,
+                                                             &FreeMonoBold24pt7bSubset};
+
+// GxEPD2 keeps its partial-mode flag and the controller's partial init private. Naming a private member in an
+// explicit template instantiation is allowed, which is the standard-conforming way to reach
+// it without patching the library; bands streamed past GxEPD2 need the controller set up the
+// way its writeImage would. Fails to compile, rather than misbehave, if a GxEPD2 update
+// changes them.
+template <typename Tag, typename Tag::type Member>
+struct PrivateMember
+{
+    friend typename Tag::type memberOf(Tag) { return Member; }
+};
+struct PanelPartialModeTag
+{
+    typedef bool GxEPD2_EPD::*type;
+    friend type memberOf(PanelPartialModeTag);
+};
+template struct PrivateMember<PanelPartialModeTag, &GxEPD2_EPD::_using_partial_mode>;
+struct PanelInitPartTag
+{
+    typedef void (GxEPD2_750_T7::*type)();
+    friend type memberOf(PanelInitPartTag);
+};
+template struct PrivateMember<PanelInitPartTag, &GxEPD2_750_T7::_Init_Part>;
+
+static bool frameOnPanel(const FrameInfo &info)
+{
+    return info.x % 8 == 0 && info.x + info.width <= DISPLAY_WIDTH && info.y + info.height <= DISPLAY_HEIGHT;
+}
+
+DisplayManager::DisplayManager()
+    : display(GxEPD2_750_T7(PIN_CS, PIN_DC, PIN_RST, PIN_BUSY)),
+      transfer(bandBuffers[0], bandBuffers[1], sizeof(bandBuffers[0])), clockDisplay(this), weatherDisplay(this)
 {
 }
 
@@ -13,39 +77,208 @@ void DisplayManager::init()
     // Initialize SPI with custom pins
     SPI.begin(PIN_CLK, PIN_MISO, PIN_MOSI, PIN_CS);
 
+    // GxEPD2's own commands at the controller's clock too
+    display.epd2.selectSPI(SPI, SPISettings(PANEL_SPI_HZ, MSBFIRST, SPI_MODE0));
     display.init(115200);
+    setFullWindow();
+    loadAssets(true);
     display.setRotation(0);
-    display.fillScreen(GxEPD_WHITE);
-    display.display(true);
+
+    // Every band starts out white, so an empty page loop clears the panel
+    setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    firstPage();
+    while (nextPage())
+    {
+    }
+
+    // GxEPD2 ran the first refresh with the full waveform: every region starts clean
+    if (ledger != nullptr)
+    {
+        *ledger = {};
+    }
 }
 
 void DisplayManager::showError(const String &errorMessage)
 {
-    display.fillScreen(GxEPD_WHITE);
-    display.setFont(&FreeSansBold12pt7b);
-    display.setTextColor(GxEPD_BLACK);
+    // GFX print, so this goes through GxEPD2's own (small) buffer and page loop
+    setPartialWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    display.firstPage();
+    do
+    {
+        display.fillScreen(GxEPD_WHITE);
+        setFont(FONT_SANS_BOLD_12);
+        display.setTextColor(GxEPD_BLACK);
 
-    display.setCursor(50, 200);
-    display.print("ERROR: ");
-    display.println(errorMessage);
+        display.setCursor(50, 200);
+        display.print("ERROR: ");
+        display.println(errorMessage);
+    } while (display.nextPage());
+}
 
-    display.display(true);
+void DisplayManager::setFont(UiFont font)
+{
+    currentFont = &fonts[font];
+    TextLayout::fontRows(currentFont, currentFontTop, currentFontBottom);
+    display.setFont(currentFont);
 }
 
 TextBounds DisplayManager::drawCenteredText(const char *text, int16_t centerX, int16_t y)
 {
-    int16_t x1, y1;
-    uint16_t w, h;
-    display.getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
+    TextExtent extent;
+    if (currentFont)
+    {
+        extent = TextLayout::measure(currentFont, text);
+    }
+    else
+    {
+        display.getTextBounds(text, 0, 0, &extent.x1, &extent.y1, &extent.w, &extent.h);
+    }
+    return drawCenteredAt(text, centerX, y, extent);
+}
+
+TextBounds DisplayManager::drawCenteredLabel(const char *label, int16_t centerX, int16_t y)
+{
+    if (!currentFont)
+    {
+        return drawCenteredText(label, centerX, y);
+    }
+    return drawCenteredAt(label, centerX, y, TextLayout::measureLabel(labelWidths, currentFont, label));
+}
 
+TextBounds DisplayManager::drawCenteredAt(const char *text, int16_t centerX, int16_t y, const TextExtent &extent)
+{
     // Calculate x position to center the text
-    int16_t x = centerX - (w / 2);
+    int16_t x = centerX - (extent.w / 2);
 
-    display.setCursor(x, y);
-    display.print(text);
+    drawText(x, y, text);
 
     // Return the bounding box of the drawn text
-    return {x, (int16_t)(y - h), (int16_t)w, (int16_t)h};
+    return {x, (int16_t)(y - extent.h), (int16_t)extent.w, (int16_t)extent.h};
+}
+
+void DisplayManager::drawText(int16_t x, int16_t y, const char *text)
+{
+    if (!currentFont || display.getRotation() != 0)
+    {
+        display.setCursor(x, y);
+        display.print(text);
+        return;
+    }
+
+    // Single lines in another band of a paged buffer are skipped whole
+    RasterTarget target = rasterTarget();
+    if (strchr(text, '\n') == nullptr &&
+        !TextRaster::rowsInPage(target, y + currentFontTop, currentFontBottom - currentFontTop))
+    {
+        return;
+    }
+    int16_t end = TextRaster::drawText(target, currentFont, x, y, text, true);
+    display.setCursor(end, y);
+}
+
+void DisplayManager::setPartialWindow(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    display.setPartialWindow(x, y, w, h);
+
+    // Same clamping and 8-px rounding GxEPD2 applies (rotation 0)
+    uint16_t px = x < DISPLAY_WIDTH ? x : DISPLAY_WIDTH;
+    uint16_t py = y < DISPLAY_HEIGHT ? y : DISPLAY_HEIGHT;
+    uint16_t pw = w < DISPLAY_WIDTH - px ? w : DISPLAY_WIDTH - px;
+    uint16_t ph = h < DISPLAY_HEIGHT - py ? h : DISPLAY_HEIGHT - py;
+    pw += px % 8;
+    if (pw % 8 > 0)
+        pw += 8 - pw % 8;
+    px -= px % 8;
+
+    windowX = px;
+    windowY = py;
+    windowWidth = pw;
+    windowHeight = ph;
+}
+
+RasterTarget DisplayManager::rasterTarget()
+{
+    RasterTarget target = {band, windowX, windowY, windowWidth, windowHeight,
+                           bandTop, DISPLAY_PAGE_ROWS, DISPLAY_WIDTH, DISPLAY_HEIGHT};
+    return target;
+}
+
+bool DisplayManager::inBand(const ScreenRect &rect)
+{
+    return TextRaster::rowsInPage(rasterTarget(), rect.y, rect.h);
+}
+
+void DisplayManager::drawRect(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    RasterTarget target = rasterTarget();
+    TextRaster::fillRect(target, x, y, w, 1, true);
+    TextRaster::fillRect(target, x, y + h - 1, w, 1, true);
+    TextRaster::fillRect(target, x, y, 1, h, true);
+    TextRaster::fillRect(target, x + w - 1, y, 1, h, true);
+}
+
+void DisplayManager::enterPartialMode()
+{
+    // What GxEPD2's writeImage does first; refresh() would otherwise re-init the controller
+    // after the bands are already in its RAM
+    if (!(display.epd2.*memberOf(PanelPartialModeTag())))
+    {
+        (display.epd2.*memberOf(PanelInitPartTag()))();
+    }
+}
+
+void DisplayManager::firstPage()
+{
+    enterPartialMode();
+    panelDma.begin();
+    secondPass = false;
+    startPass(PANEL_RAM_NEW);
+}
+
+void DisplayManager::startPass(uint8_t ram)
+{
+    transfer.begin(panelDma.port(), ram, windowX, windowY, windowWidth, windowHeight);
+    bandTop = 0;
+    band = transfer.band();
+    memset(band, 0xFF, transfer.capacity());
+}
+
+bool DisplayManager::nextPage()
+{
+    // Queue the band just drawn; the draw code gets the other buffer while it is on the wire
+    uint16_t rows = windowHeight - bandTop < DISPLAY_PAGE_ROWS ? windowHeight - bandTop : DISPLAY_PAGE_ROWS;
+    transfer.send((size_t)rows * (windowWidth / 8));
+    bandTop += DISPLAY_PAGE_ROWS;
+    if (bandTop < windowHeight)
+    {
+        band = transfer.band();
+        memset(band, 0xFF, transfer.capacity());
+        return true;
+    }
+
+    transfer.end();
+    panelDma.end();
+    if (secondPass)
+    {
+        band = nullptr;
+        return false;
+    }
+
+    // Same sequence as GxEPD2's paged partial update: new image, refresh, then the image again
+    // as the base of the next differential refresh
+    refreshWindow(windowX, windowY, windowWidth, windowHeight);
+    panelDma.begin();
+    secondPass = true;
+    startPass(PANEL_RAM_OLD);
+    return true;
+}
+
+void DisplayManager::setFullWindow()
+{
+    windowX = 0;
+    windowY = 0;
+    windowWidth = DISPLAY_WIDTH;
+    windowHeight = DISPLAY_HEIGHT;
 }
 
 void DisplayManager::updateClock(int hour, int minute, int second, int dayOfWeek, int month, int day, int year)
@@ -53,6 +286,84 @@ void DisplayManager::updateClock(int hour, int minute, int second, int dayOfWeek
     clockDisplay.updateFull(hour, minute, second, dayOfWeek, month, day, year);
 }
 
+void DisplayManager::setRefreshLedger(RefreshLedgerState &state)
+{
+    ledger = &state;
+}
+
+void DisplayManager::refreshWindow(int16_t x, int16_t y, uint16_t w, uint16_t h)
+{
+    ScreenRect window = {x, y, (int16_t)w, (int16_t)h};
+    driveWindow(window, RefreshLedger::waveformFor(window, FAST_WAVEFORM_REGIONS));
+}
+
+void DisplayManager::driveWindow(const ScreenRect &window, RefreshWaveform waveform)
+{
+    if (ledger != nullptr)
+    {
+        RefreshLedger::record(*ledger, window, waveform, GHOST_FAST_COST);
+    }
+    uint32_t started = millis();
+    refreshes++;
+    if (waveform == WAVEFORM_STOCK)
+    {
+        display.epd2.refresh(window.x, window.y, window.w, window.h);
+        refreshTime += millis() - started;
+        return;
+    }
+
+    // Our LUT (or the OTP one) in place of GxEPD2's, so the refresh is sent past GxEPD2 too
+    Serial.printf("%s refresh of %dx%d at (%d,%d)\n", waveform == WAVEFORM_FAST ? "Fast" : "Cleanup", window.w,
+                  window.h, window.x, window.y);
+    panelDma.begin();
+    PanelSpi port = panelDma.port();
+    if (waveform == WAVEFORM_FAST)
+    {
+        PanelWaveform::loadFast(port, FAST_WAVEFORM_FRAMES);
+    }
+    else
+    {
+        PanelWaveform::selectFull(port);
+    }
+    PanelWaveform::startRefresh(port, window.x, window.y, window.w, window.h);
+    panelDma.waitIdle(10000);
+    PanelWaveform::endRefresh(port);
+    panelDma.end();
+
+    // GxEPD2 puts its own panel setting and LUT back before its next write or refresh
+    display.epd2.*memberOf(PanelPartialModeTag()) = false;
+    refreshTime += millis() - started;
+}
+
+void DisplayManager::cleanupGhosting(int hour)
+{
+    if (ledger == nullptr)
+    {
+        return;
+    }
+    uint32_t due = RefreshLedger::dueForCleanup(*ledger, hour, GHOST_BUDGET, GHOST_LIMIT, QUIET_HOURS_START,
+                                                QUIET_HOURS_END);
+    if (due == 0)
+    {
+        return;
+    }
+
+    // Both controller RAMs still hold the image on the panel, so nothing is redrawn: the full
+    // waveform drives the same pixels again and settles what the partial refreshes left behind
+    ScreenRect rects[PANEL_REGION_COUNT];
+    int count = RefreshLedger::cleanupRects(due, rects);
+    for (int i = 0; i < count; i++)
+    {
+        enterPartialMode();
+        driveWindow(rects[i], WAVEFORM_CLEANUP);
+    }
+}
+
+void DisplayManager::setSunTimes(const SunDay &sun)
+{
+    clockDisplay.setSunTimes(sun);
+}
+
 void DisplayManager::partialUpdateClock(int hour, int minute, int second)
 {
     clockDisplay.updatePartial(hour, minute, second);
@@ -60,19 +371,54 @@ void DisplayManager::partialUpdateClock(int hour, int minute, int second)
 
 void DisplayManager::partialUpdateDate(int dayOfWeek, int month, int day, int year)
 {
-    // Update only the date area (top of left half)
-    display.setPartialWindow(0, 0, DISPLAY_LEFT_HALF, 80);
-    display.firstPage();
+    setPartialWindow(CLOCK_DATE_RECT.x, CLOCK_DATE_RECT.y, CLOCK_DATE_RECT.w, CLOCK_DATE_RECT.h);
+    firstPage();
     do
     {
-        display.fillRect(0, 0, DISPLAY_LEFT_HALF, 80, GxEPD_WHITE);
         clockDisplay.drawDate(dayOfWeek, month, day, year);
-    } while (display.nextPage());
+    } while (nextPage());
+}
+
+void DisplayManager::updateWeather(const WeatherData &weather, RenderedWeather &shown)
+{
+    weatherDisplay.update(weather, shown);
 }
 
-void DisplayManager::updateWeather(const WeatherData &weather)
+void DisplayManager::updateClockAndWeather(int hour, int minute, int dayOfWeek, int month, int day, int year,
+                                           int batteryPercentX10, const WeatherData &weather, RenderedWeather &shown)
 {
-    weatherDisplay.update(weather);
+    // New minute and prefetched weather share one refresh so the panel only cycles once.
+    // The window is the union of the clock digits and the weather regions that changed;
+    // anything else it happens to cover (date, battery) is redrawn as well.
+    ScreenRect rects[WEATHER_REGION_COUNT];
+    int count = weatherDisplay.planRefresh(weather, shown, rects);
+    ScreenRect window = CLOCK_TIME_RECT;
+    for (int i = 0; i < count; i++)
+    {
+        window = WeatherDiff::unionRect(window, rects[i]);
+    }
+
+    currentBatteryX10 = batteryPercentX10;
+    setPartialWindow(window.x, window.y, window.w, window.h);
+    firstPage();
+    do
+    {
+        if (inBand(CLOCK_TIME_RECT))
+        {
+            clockDisplay.drawTime(hour, minute);
+        }
+        if (WeatherDiff::intersects(window, CLOCK_DATE_RECT) && inBand(CLOCK_DATE_RECT))
+        {
+            clockDisplay.drawDate(dayOfWeek, month, day, year);
+        }
+        if (WeatherDiff::intersects(window, BATTERY_RECT) && inBand(BATTERY_RECT))
+        {
+            drawBattery();
+        }
+        weatherDisplay.drawWindow(weather, window);
+    } while (nextPage());
+
+    WeatherDiff::capture(weather, shown);
 }
 
 void DisplayManager::deepSleep(uint32_t sleepSeconds)
@@ -88,58 +434,203 @@ void DisplayManager::wakeup()
     // Light initialization after deep sleep - just reinit SPI and display controller
     // Does NOT clear the screen (preserves existing content)
     SPI.begin(PIN_CLK, PIN_MISO, PIN_MOSI, PIN_CS);
+    display.epd2.selectSPI(SPI, SPISettings(PANEL_SPI_HZ, MSBFIRST, SPI_MODE0));
     display.init(115200, false); // false = don't reset, preserves display content
+    setFullWindow();
+    loadAssets(false); // Checksum was verified on the cold boot
+}
+
+void DisplayManager::loadAssets(bool verifyChecksum)
+{
+    for (int i = 0; i < ASSET_BITMAP_COUNT; i++)
+        bitmaps[i] = *BUILT_IN_BITMAPS[i].bitmap;
+    for (int i = 0; i < UI_FONT_COUNT; i++)
+        fonts[i] = *BUILT_IN_FONTS[i];
+
+#if ASSET_PARTITION_ENABLED
+    // Mapped through the flash cache, like the firmware's own PROGMEM data; the mapping lives
+    // until deep sleep, so bitmaps and fonts point straight into it
+    const esp_partition_t *partition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, ASSET_PARTITION_LABEL);
+    const void *mapped = nullptr;
+    spi_flash_mmap_handle_t handle;
+    if (partition == nullptr ||
+        esp_partition_mmap(partition, 0, partition->size, SPI_FLASH_MMAP_DATA, &mapped, &handle) != ESP_OK)
+    {
+        Serial.println("No asset partition, using built-in assets");
+        return;
+    }
+    if (!assetPack.begin((const uint8_t *)mapped, partition->size, verifyChecksum))
+    {
+        Serial.println("Asset partition empty or invalid, using built-in assets");
+        spi_flash_munmap(handle);
+        return;
+    }
+
+    int found = 0;
+    for (int i = 0; i < ASSET_BITMAP_COUNT; i++)
+        found += assetPack.bitmap(BUILT_IN_BITMAPS[i].name, bitmaps[i]) ? 1 : 0;
+    // Packed fonts are whole, so they cover text added since the pack was flashed
+    for (int i = 0; i < UI_FONT_COUNT; i++)
+        found += assetPack.font(FONT_NAMES[i], fonts[i]) ? 1 : 0;
+    Serial.printf("Assets: %d of %d from partition (%u byte pack)\n", found, ASSET_BITMAP_COUNT + UI_FONT_COUNT,
+                  (unsigned)assetPack.length());
+#else
+    (void)verifyChecksum;
+#endif
+}
+
+const PackedBitmap &DisplayManager::bitmapAsset(const PackedBitmap &builtIn)
+{
+    // Built-ins have one definition each (generated .cpp), so the address identifies them
+    for (int i = 0; i < ASSET_BITMAP_COUNT; i++)
+    {
+        if (BUILT_IN_BITMAPS[i].bitmap == &builtIn)
+            return bitmaps[i];
+    }
+    return builtIn;
 }
 
-void DisplayManager::updateBattery(float batteryPercent)
+void DisplayManager::updateBattery(int batteryPercentX10)
 {
-    currentBattery = batteryPercent;
+    currentBatteryX10 = batteryPercentX10;
 
     // Update only battery area on left panel (lower left corner)
-    display.setPartialWindow(0, 400, 200, 80);
-    display.firstPage();
+    setPartialWindow(BATTERY_RECT.x, BATTERY_RECT.y, BATTERY_RECT.w, BATTERY_RECT.h);
+    firstPage();
     do
     {
-        display.fillRect(0, 400, 200, 80, GxEPD_WHITE);
+        drawBattery();
+    } while (nextPage());
+}
 
-        display.setFont(&FreeSans9pt7b);
-        display.setTextColor(GxEPD_BLACK);
-        display.setTextSize(1);
+bool DisplayManager::drawFrame(const uint8_t *frame, size_t length)
+{
+    FrameDecoder decoder;
+    if (!decoder.begin(frame, length))
+    {
+        Serial.println("Invalid frame header");
+        return false;
+    }
 
-        char battStr[20];
-        sprintf(battStr, "Battery: %.0f%%", batteryPercent);
-        display.setCursor(10, DISPLAY_HEIGHT - 20);
-        display.println(battStr);
-    } while (display.nextPage());
+    const FrameInfo &info = decoder.info();
+    if (!frameOnPanel(info))
+    {
+        Serial.printf("Frame %dx%d at (%d,%d) is off the panel\n", info.width, info.height, info.x, info.y);
+        return false;
+    }
+
+    // Decode once without touching the panel so a corrupt frame can't leave half an image behind
+    if (!writeFrameBands(decoder, FRAME_PASS_VALIDATE))
+    {
+        Serial.println("Corrupt frame data");
+        return false;
+    }
+
+    writeFrame(decoder);
+
+    Serial.printf("Frame drawn: %dx%d at (%d,%d) from %u bytes\n", info.width, info.height, info.x, info.y, (unsigned)length);
+    return true;
 }
 
-void DisplayManager::drawBitmapIcon(int x, int y, const unsigned char *bitmap, int size)
+bool DisplayManager::drawFrameDelta(const uint8_t *delta, size_t length, uint32_t shownHash)
 {
-    // Draw a monochrome bitmap icon centered at (x, y)
-    // bitmap: pointer to PROGMEM bitmap array
-    // size: 32 for 32x32 bitmap
+    TileDeltaReader reader;
+    if (!reader.begin(delta, length))
+    {
+        Serial.println("Invalid tile delta");
+        return false;
+    }
+    if (reader.baseHash() != 0 && reader.baseHash() != shownHash)
+    {
+        Serial.printf("Tile delta is for pane %08x, panel shows %08x\n", reader.baseHash(), shownHash);
+        return false;
+    }
 
-    int bytes_per_row = size / 8;
-    int offset_x = size / 2; // Center horizontally
-    int offset_y = size / 2; // Center vertically
+    // Check every tile before the first refresh so a bad delta can't leave the pane half updated
+    FrameDecoder decoder;
+    while (reader.nextTile(decoder))
+    {
+        if (!frameOnPanel(decoder.info()) || !writeFrameBands(decoder, FRAME_PASS_VALIDATE))
+        {
+            Serial.println("Corrupt tile in delta");
+            return false;
+        }
+    }
 
-    for (int row = 0; row < size; row++)
+    // One partial window per tile - the server already merged neighbouring changes
+    reader.rewind();
+    while (reader.nextTile(decoder))
     {
-        for (int col = 0; col < bytes_per_row; col++)
+        const FrameInfo &info = decoder.info();
+        Serial.printf("Tile window %dx%d at (%d,%d)\n", info.width, info.height, info.x, info.y);
+
+        writeFrame(decoder);
+    }
+
+    Serial.printf("Tile delta applied: %d window(s) from %u bytes\n", reader.tileCount(), (unsigned)length);
+    return true;
+}
+
+void DisplayManager::writeFrame(FrameDecoder &decoder)
+{
+    // Band by band straight into controller RAM - the frame never exists uncompressed in full.
+    // Same sequence as GxEPD2's drawImage: write, partial refresh, write again.
+    const FrameInfo &info = decoder.info();
+    enterPartialMode();
+    panelDma.begin();
+    writeFrameBands(decoder, FRAME_PASS_WRITE);
+    panelDma.end();
+    refreshWindow(info.x, info.y, info.width, info.height);
+    panelDma.begin();
+    writeFrameBands(decoder, FRAME_PASS_AGAIN);
+    panelDma.end();
+}
+
+bool DisplayManager::writeFrameBands(FrameDecoder &decoder, int pass)
+{
+    const FrameInfo &info = decoder.info();
+    size_t stride = decoder.rowBytes();
+    int bandRows = (int)(transfer.capacity() / stride);
+    if (pass != FRAME_PASS_VALIDATE)
+    {
+        transfer.begin(panelDma.port(), pass == FRAME_PASS_WRITE ? PANEL_RAM_NEW : PANEL_RAM_OLD, info.x, info.y,
+                       info.width, info.height);
+    }
+
+    // Each band decodes while the one before it is on the wire
+    decoder.rewind();
+    int rows;
+    while ((rows = decoder.decodeRows(transfer.band(), bandRows)) > 0)
+    {
+        if (pass != FRAME_PASS_VALIDATE)
         {
-            byte b = pgm_read_byte(bitmap + row * bytes_per_row + col);
-
-            for (int bit = 0; bit < 8; bit++)
-            {
-                if ((b & (0x80 >> bit)) != 0) // Black pixel
-                {
-                    int pixel_x = x - offset_x + 1 + col * 8 + bit;
-                    int pixel_y = y - offset_y + row;
-                    display.drawPixel(pixel_x, pixel_y, GxEPD_BLACK);
-                }
-            }
+            transfer.send((size_t)rows * stride);
         }
     }
+    if (pass != FRAME_PASS_VALIDATE)
+    {
+        transfer.end();
+    }
+    return rows == 0;
+}
+
+void DisplayManager::drawBattery()
+{
+    setFont(FONT_SANS_9);
+    display.setTextColor(GxEPD_BLACK);
+    display.setTextSize(1);
+
+    char battStr[20];
+    TextFormat(battStr, sizeof(battStr)).text("Battery: ").whole(currentBatteryX10).text("%");
+    drawText(10, DISPLAY_HEIGHT - 20, battStr);
+}
+
+void DisplayManager::drawBitmapIcon(int x, int y, const PackedBitmap &bitmap)
+{
+    // Draw a monochrome bitmap icon centered at (x, y)
+    const PackedBitmap &asset = bitmapAsset(bitmap);
+    PackedBlit::draw(rasterTarget(), asset, x - asset.width / 2 + 1, y - asset.height / 2);
 }
 
 void DisplayManager::drawNumberBitmap(int x, int y, const char *numberString)
@@ -148,6 +639,11 @@ void DisplayManager::drawNumberBitmap(int x, int y, const char *numberString)
     // x, y: top-left position for first digit
     // numberString: string containing digits, colon, and degree symbol (e.g., "72°")
 
+    RasterTarget target = rasterTarget();
+    if (!TextRaster::rowsInPage(target, y, DIGIT_HEIGHT))
+    {
+        return;
+    }
     int currentX = x;
 
     // Draw each character
@@ -162,34 +658,7 @@ void DisplayManager::drawNumberBitmap(int x, int y, const char *numberString)
             c = 0xB0; // Use the second byte for lookup
         }
 
-        const unsigned char *bitmap = getDigitBitmap((char)c);
-
-        // Draw bitmap row by row
-        int bytes_per_row = (DIGIT_WIDTH + 7) / 8;
-        for (int row = 0; row < DIGIT_HEIGHT; row++)
-        {
-            for (int col = 0; col < bytes_per_row; col++)
-            {
-                byte b = pgm_read_byte(bitmap + row * bytes_per_row + col);
-
-                // Process each bit in the byte
-                for (int bit = 0; bit < 8; bit++)
-                {
-                    if ((b & (0x80 >> bit)) != 0) // Black pixel
-                    {
-                        int pixel_x = currentX + col * 8 + bit;
-                        int pixel_y = y + row;
-
-                        // Bounds check
-                        if (pixel_x >= 0 && pixel_x < 800 &&
-                            pixel_y >= 0 && pixel_y < 480)
-                        {
-                            display.drawPixel(pixel_x, pixel_y, GxEPD_BLACK);
-                        }
-                    }
-                }
-            }
-        }
+        PackedBlit::draw(target, bitmapAsset(getDigitBitmap((char)c)), currentX, y);
 
         // Move to next digit position
         currentX += DIGIT_WIDTH;
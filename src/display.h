@@ -2,12 +2,21 @@
 #define DISPLAY_H
 
 #include <GxEPD2_BW.h>
-#include <Fonts/FreeSansBold12pt7b.h>
-#include <Fonts/FreeSans9pt7b.h>
+#include "config.h"
 #include "types.h"
 #include "weather_bitmaps.h"
 #include "display_clock.h"
 #include "display_weather.h"
+#include "frame_codec.h"
+#include "tile_delta.h"
+#include "text_layout.h"
+#include "text_raster.h"
+#include "packed_bitmap.h"
+#include "asset_pack.h"
+#include "band_transfer.h"
+#include "panel_dma.h"
+#include "panel_waveform.h"
+#include "refresh_ledger.h"
 
 // Bounding box info for rendered text
 struct TextBounds
@@ -15,6 +24,22 @@ struct TextBounds
     int16_t x, y, w, h;
 };
 
+// Fonts the panel uses, taken from the asset partition when it has them
+enum UiFont : uint8_t
+{
+    FONT_SANS_9 = 0,
+    FONT_SANS_BOLD_12,
+    FONT_MONO_BOLD_24,
+    UI_FONT_COUNT
+};
+
+const int ASSET_BITMAP_COUNT = 18; // Digits and weather icons
+
+// GxEPD2's own frame buffer only backs GFX drawing in showError; everything else is drawn
+// into DisplayManager's two band buffers
+const int GFX_PAGE_ROWS = 16;
+typedef GxEPD2_BW<GxEPD2_750_T7, GFX_PAGE_ROWS> PanelDisplay;
+
 class DisplayManager
 {
 public:
@@ -22,22 +47,71 @@ public:
     void init();
     void showError(const String &errorMessage);
     void updateClock(int hour, int minute, int second, int dayOfWeek, int month, int day, int year);
-    void updateWeather(const WeatherData &weather);
-    void updateBattery(float batteryPercent);
+    void updateWeather(const WeatherData &weather, RenderedWeather &shown);
+    void updateClockAndWeather(int hour, int minute, int dayOfWeek, int month, int day, int year,
+                               int batteryPercentX10, const WeatherData &weather, RenderedWeather &shown);
+    void updateBattery(int batteryPercentX10); // Tenths of a percent
+    void setSunTimes(const SunDay &sun); // Daylight line under the date, drawn with it
+    void setRefreshLedger(RefreshLedgerState &ledger); // RTC ghosting per region, see refresh_ledger.h
+    void cleanupGhosting(int hour); // Full-waveform refresh of the regions the ledger says are due
+    bool drawFrame(const uint8_t *frame, size_t length); // Server-rendered frame, see frame_codec.h
+    bool drawFrameDelta(const uint8_t *delta, size_t length, uint32_t shownHash); // Changed tiles, see tile_delta.h
     void partialUpdateClock(int hour, int minute, int second);
     void partialUpdateDate(int dayOfWeek, int month, int day, int year);
     void deepSleep(uint32_t sleepSeconds);
     void wakeup();
+    int refreshCount() const { return refreshes; } // Partial refreshes this wake
+    uint32_t refreshMillis() const { return refreshTime; } // Time spent in them
 
     // Exposed for helper classes
-    GxEPD2_BW<GxEPD2_750_T7, GxEPD2_750_T7::HEIGHT> &getDisplay() { return display; }
+    PanelDisplay &getDisplay() { return display; }
+    void setFont(UiFont font); // Use this, not getDisplay().setFont, so text can be measured
     TextBounds drawCenteredText(const char *text, int16_t centerX, int16_t y);
-    void drawBitmapIcon(int x, int y, const unsigned char *bitmap, int size);
+    TextBounds drawCenteredLabel(const char *label, int16_t centerX, int16_t y); // Static strings, width cached
+    void drawText(int16_t x, int16_t y, const char *text); // Black, current font, cursor at the baseline
+    void setPartialWindow(int16_t x, int16_t y, int16_t w, int16_t h); // Use this so text knows the window
+    // Page loop over the window in DISPLAY_PAGE_ROWS bands, like GxEPD2's: each pass draws one
+    // band into a cleared buffer while the previous one goes out over DMA. Refreshes once all
+    // bands are in, then runs the bands again for the controller's previous-image RAM.
+    // The window's regions pick the waveform (FAST_WAVEFORM_REGIONS) and are charged for it.
+    void firstPage();
+    bool nextPage();
+    bool inBand(const ScreenRect &rect); // Rect reaches the current band; draw code skips it otherwise
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h); // Black outline, GFX drawRect into the band
+    void drawBitmapIcon(int x, int y, const PackedBitmap &bitmap); // Centered at (x, y), partition copy if any
     void drawNumberBitmap(int x, int y, const char *numberString); // Draw number using bitmap digits
 
 private:
-    GxEPD2_BW<GxEPD2_750_T7, GxEPD2_750_T7::HEIGHT> display;
-    float currentBattery = 0;
+    PanelDisplay display;
+    int currentBatteryX10 = 0;
+    const GFXfont *currentFont = nullptr;
+    int16_t currentFontTop = 0, currentFontBottom = 0; // Rows the current font inks around the baseline
+    TextWidthCache labelWidths = {};
+    int16_t windowX = 0, windowY = 0; // Partial window as GxEPD2 rounded it
+    uint16_t windowWidth = DISPLAY_WIDTH, windowHeight = DISPLAY_HEIGHT;
+    AssetPack assetPack;
+    PackedBitmap bitmaps[ASSET_BITMAP_COUNT]; // Mapped or built-in, in BUILT_IN_BITMAPS order
+    GFXfont fonts[UI_FONT_COUNT];
+    void setFullWindow();
+    RasterTarget rasterTarget();
+    void loadAssets(bool verifyChecksum);
+    const PackedBitmap &bitmapAsset(const PackedBitmap &builtIn);
+    TextBounds drawCenteredAt(const char *text, int16_t centerX, int16_t y, const TextExtent &extent);
+    void drawBattery();
+    bool writeFrameBands(FrameDecoder &decoder, int pass);
+    void writeFrame(FrameDecoder &decoder);
+    void enterPartialMode();
+    void startPass(uint8_t ram);
+    void refreshWindow(int16_t x, int16_t y, uint16_t w, uint16_t h);
+    void driveWindow(const ScreenRect &window, RefreshWaveform waveform);
+    PanelDma panelDma;
+    BandTransfer transfer;
+    uint8_t *band = nullptr;  // Buffer the draw code writes, from transfer
+    uint16_t bandTop = 0;     // Window row it starts at
+    bool secondPass = false;  // Bands going to the previous-image RAM after the refresh
+    RefreshLedgerState *ledger = nullptr;
+    int refreshes = 0;
+    uint32_t refreshTime = 0;
     DisplayClock clockDisplay;
     DisplayWeather weatherDisplay;
 };
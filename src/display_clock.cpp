@@ -1,8 +1,9 @@
 #include "display_clock.h"
 #include "display.h"
-#include <Fonts/FreeMonoBold24pt7b.h>
 #include "config.h"
 #include "digit_bitmaps.h"
+#include "text_format.h"
+#include <time.h>
 
 DisplayClock::DisplayClock(DisplayManager *displayManager) : displayManager(displayManager)
 {
@@ -10,15 +11,19 @@ DisplayClock::DisplayClock(DisplayManager *displayManager) : displayManager(disp
 
 void DisplayClock::updateFull(int hour, int minute, int second, int dayOfWeek, int month, int day, int year)
 {
-    auto &display = displayManager->getDisplay();
-    display.setPartialWindow(0, 0, DISPLAY_LEFT_HALF, DISPLAY_HEIGHT);
-    display.firstPage();
+    displayManager->setPartialWindow(0, 0, DISPLAY_LEFT_HALF, DISPLAY_HEIGHT);
+    displayManager->firstPage();
     do
     {
-        display.fillRect(0, 0, DISPLAY_LEFT_HALF, DISPLAY_HEIGHT, GxEPD_WHITE);
-        drawTime(hour, minute);
-        drawDate(dayOfWeek, month, day, year);
-    } while (display.nextPage());
+        if (displayManager->inBand(CLOCK_TIME_RECT))
+        {
+            drawTime(hour, minute);
+        }
+        if (displayManager->inBand(CLOCK_DATE_RECT))
+        {
+            drawDate(dayOfWeek, month, day, year);
+        }
+    } while (displayManager->nextPage());
 
     lastDisplayedHour = hour;
     lastDisplayedMinute = minute;
@@ -32,16 +37,14 @@ void DisplayClock::updatePartial(int hour, int minute, int second)
         return;
     }
 
-    auto &display = displayManager->getDisplay();
     // Update only the time area (partial refresh for efficiency)
     // Window from y=80 to y=230 covers just the time, not day/date below
-    display.setPartialWindow(0, 80, DISPLAY_LEFT_HALF, 140);
-    display.firstPage();
+    displayManager->setPartialWindow(0, 80, DISPLAY_LEFT_HALF, 140);
+    displayManager->firstPage();
     do
     {
-        display.fillRect(0, 80, DISPLAY_LEFT_HALF, 140, GxEPD_WHITE);
         drawTime(hour, minute);
-    } while (display.nextPage());
+    } while (displayManager->nextPage());
 
     lastDisplayedHour = hour;
     lastDisplayedMinute = minute;
@@ -55,23 +58,57 @@ void DisplayClock::drawTime(int hour, int minute)
 
 void DisplayClock::drawDate(int dayOfWeek, int month, int day, int year)
 {
-    String dayOfWeekStr = getDayOfWeekName(dayOfWeek);
+    const char *dayOfWeekStr = getDayOfWeekName(dayOfWeek);
     String dateStr = getFormattedDate(month, day, year);
 
-    displayManager->getDisplay().setFont(&FreeMonoBold24pt7b);
+    displayManager->setFont(FONT_MONO_BOLD_24);
     displayManager->getDisplay().setTextColor(GxEPD_BLACK);
     displayManager->getDisplay().setTextSize(1);
 
     // Center day of week and date below time
     int centerX = DISPLAY_LEFT_HALF / 2;
-    displayManager->drawCenteredText(dayOfWeekStr.c_str(), centerX, 250);
+    displayManager->drawCenteredLabel(dayOfWeekStr, centerX, 250);
     displayManager->drawCenteredText(dateStr.c_str(), centerX, 300);
+
+    drawDaylight();
+}
+
+void DisplayClock::drawDaylight()
+{
+    if (sun.dayKey == 0)
+    {
+        return;
+    }
+
+    char line[40];
+    TextFormat text(line, sizeof(line));
+    if (sun.polar == SUN_POLAR_NIGHT)
+    {
+        text.text("No sunrise today");
+    }
+    else if (sun.polar == SUN_MIDNIGHT_SUN)
+    {
+        text.text("No sunset today");
+    }
+    else
+    {
+        struct tm rise, set;
+        localtime_r(&sun.sunrise, &rise);
+        localtime_r(&sun.sunset, &set);
+        int minutes = SunTimes::dayLengthMinutes(sun);
+        text.text("Sun ").integer(rise.tm_hour).text(":").integer(rise.tm_min, 2);
+        text.text("-").integer(set.tm_hour).text(":").integer(set.tm_min, 2);
+        text.text(" (").integer(minutes / 60).text("h ").integer(minutes % 60, 2).text("m)");
+    }
+
+    displayManager->setFont(FONT_SANS_BOLD_12);
+    displayManager->drawCenteredText(line, DISPLAY_LEFT_HALF / 2, 345);
 }
 
-String DisplayClock::getDayOfWeekName(int dayOfWeekIndex)
+const char *DisplayClock::getDayOfWeekName(int dayOfWeekIndex)
 {
     static const char *daysOfWeek[] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
-    return String(daysOfWeek[dayOfWeekIndex % 7]);
+    return daysOfWeek[dayOfWeekIndex % 7];
 }
 
 String DisplayClock::getFormattedDate(int month, int day, int year)
@@ -79,7 +116,7 @@ String DisplayClock::getFormattedDate(int month, int day, int year)
     static const char *months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
 
     char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%s %d, %d", months[month % 12], day, year);
+    TextFormat(buffer, sizeof(buffer)).text(months[month % 12]).text(" ").integer(day).text(", ").integer(year);
     return String(buffer);
 }
 
@@ -87,7 +124,7 @@ void DisplayClock::drawTimeBitmap(int hour, int minute)
 {
     // Draw time using custom digit bitmaps for crisp rendering
     char timeStr[6];
-    snprintf(timeStr, sizeof(timeStr), "%02d:%02d", hour, minute);
+    TextFormat(timeStr, sizeof(timeStr)).integer(hour, 2).text(":").integer(minute, 2);
 
     // Render centered in left half: x=50, y=80
     displayManager->drawNumberBitmap(30, 80, timeStr);
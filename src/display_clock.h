@@ -2,6 +2,7 @@
 #define DISPLAY_CLOCK_H
 
 #include <Arduino.h>
+#include "sun_times.h"
 
 class DisplayManager;
 
@@ -12,17 +13,20 @@ public:
     void updateFull(int hour, int minute, int second, int dayOfWeek, int month, int day, int year);
     void updatePartial(int hour, int minute, int second);
     void drawDate(int dayOfWeek, int month, int day, int year);
+    void drawTime(int hour, int minute); // Caller owns the refresh
+    void setSunTimes(const SunDay &day) { sun = day; }
 
 private:
     DisplayManager *displayManager;
     int lastDisplayedHour = -1;
     int lastDisplayedMinute = -1;
+    SunDay sun = {}; // Drawn under the date when dayKey is set
 
-    void drawTime(int hour, int minute);
     void drawTimeBitmap(int hour, int minute);  // New method for crisp bitmap rendering
+    void drawDaylight();
 
     // Helper methods to get formatted day and date strings
-    String getDayOfWeekName(int dayOfWeekIndex);
+    const char *getDayOfWeekName(int dayOfWeekIndex);
     String getFormattedDate(int month, int day, int year);
 };
 
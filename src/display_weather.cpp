@@ -3,42 +3,146 @@
 #include "config.h"
 #include "digit_bitmaps.h"
 #include "weather_bitmaps.h"
+#include "weather_layout.h"
+#include "forecast_stream.h"
+#include "text_format.h"
 #include <time.h>
 
-const int HOURLY_START_Y = 170;
-const int DAILY_START_Y = 290;
-const int ICON_HEIGHT = 50;
-const int TEXT_HEIGHT = 20;
-
 DisplayWeather::DisplayWeather(DisplayManager *displayManager) : displayManager(displayManager)
 {
 }
 
-void DisplayWeather::update(const WeatherData &weather)
+void DisplayWeather::update(const WeatherData &weather, RenderedWeather &shown)
+{
+    // Compare against what is on the panel and only refresh the regions that changed
+    ScreenRect rects[WEATHER_REGION_COUNT];
+    int count = planRefresh(weather, shown, rects);
+    if (count == 0)
+    {
+        Serial.println("Weather unchanged on screen - skipping refresh");
+        return;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        const ScreenRect &rect = rects[i];
+        Serial.printf("Weather refresh window %d: %dx%d at (%d,%d)\n", i, rect.w, rect.h, rect.x, rect.y);
+
+        displayManager->setPartialWindow(rect.x, rect.y, rect.w, rect.h);
+        displayManager->firstPage();
+        do
+        {
+            drawWindow(weather, rect);
+        } while (displayManager->nextPage());
+    }
+
+    WeatherDiff::capture(weather, shown);
+}
+
+int DisplayWeather::planRefresh(const WeatherData &weather, const RenderedWeather &shown, ScreenRect *rects)
+{
+    RenderedWeather next;
+    WeatherDiff::capture(weather, next);
+    return WeatherDiff::refreshRects(WeatherDiff::changedRegions(shown, next), rects);
+}
+
+void DisplayWeather::drawWindow(const WeatherData &weather, const ScreenRect &window)
+{
+    // Redraw every region touching the window - merged and aligned windows overlap neighbours.
+    // Regions outside the current band of a paged buffer are skipped.
+    for (int region = 0; region < WEATHER_REGION_COUNT; region++)
+    {
+        ScreenRect rect = WeatherDiff::regionRect(region);
+        if (WeatherDiff::intersects(rect, window) && displayManager->inBand(rect))
+        {
+            drawRegion(region, weather);
+        }
+    }
+}
+
+void DisplayWeather::drawRegion(int region, const WeatherData &weather)
 {
-    auto &display = displayManager->getDisplay();
-    display.setPartialWindow(DISPLAY_LEFT_HALF, 0, DISPLAY_RIGHT_HALF, DISPLAY_HEIGHT);
-    display.firstPage();
-    do
+    int startX = WEATHER_PANE_X;
+    int boxWidth = WEATHER_PANE_WIDTH;
+
+    if (region == REGION_CURRENT_TEMP)
+    {
+        drawCurrentTemperature(startX, boxWidth, CURRENT_TEMP_Y, weather.currentTemp);
+    }
+    else if (region < REGION_DAILY_FIRST)
+    {
+        drawHourlyCell(startX, boxWidth, HOURLY_START_Y, weather, region - REGION_HOURLY_FIRST);
+    }
+    else if (region < REGION_LAST_UPDATED)
+    {
+        drawDailyCell(startX, boxWidth, DAILY_START_Y, weather, region - REGION_DAILY_FIRST);
+    }
+    else if (region == REGION_LAST_UPDATED)
+    {
+        // Last updated timestamp at bottom right
+        if (weather.lastUpdated > 0)
+        {
+            drawLastUpdated(weather, startX, boxWidth);
+        }
+    }
+    else if (region == REGION_LOCATION_NAME)
+    {
+        drawLocationName(weather);
+    }
+    else
     {
-        display.fillRect(DISPLAY_LEFT_HALF, 0, DISPLAY_RIGHT_HALF, DISPLAY_HEIGHT, GxEPD_WHITE);
-        draw(DISPLAY_LEFT_HALF, 400, weather);
-    } while (display.nextPage());
+        drawAirQuality(startX, boxWidth, weather);
+    }
 }
 
-void DisplayWeather::draw(int startX, int boxWidth, const WeatherData &weather)
+void DisplayWeather::drawAirQuality(int startX, int boxWidth, const WeatherData &weather)
 {
-    int startY = 30;
+    if (!weather.hasAirQuality)
+    {
+        return;
+    }
 
-    drawCurrentTemperature(startX, boxWidth, startY, weather.currentTemp);
-    drawHourly(startX, boxWidth, HOURLY_START_Y, weather);
-    drawDaily(startX, boxWidth, DAILY_START_Y, weather);
+    // US EPA category names
+    const char *category = "Hazardous";
+    if (weather.usAqi <= 50)
+        category = "Good";
+    else if (weather.usAqi <= 100)
+        category = "Moderate";
+    else if (weather.usAqi <= 150)
+        category = "Unhealthy for some";
+    else if (weather.usAqi <= 200)
+        category = "Unhealthy";
+    else if (weather.usAqi <= 300)
+        category = "Very unhealthy";
+
+    displayManager->setFont(FONT_SANS_9);
+    displayManager->getDisplay().setTextSize(1);
+
+    char aqiStr[48];
+    TextFormat(aqiStr, sizeof(aqiStr))
+        .text("AQI ")
+        .integer(weather.usAqi)
+        .text(" ")
+        .text(category)
+        .text("   PM2.5 ")
+        .whole(weather.pm25Tenths);
+    displayManager->drawCenteredText(aqiStr, startX + boxWidth / 2, AIR_QUALITY_Y);
+}
 
-    // Last updated timestamp at bottom right
-    if (weather.lastUpdated > 0)
+void DisplayWeather::drawLocationName(const WeatherData &weather)
+{
+#if WEATHER_CAROUSEL
+    // Only the carousel needs to say which place the pane is showing
+    char name[24];
+    if (!WeatherCarousel::listEntry(WEATHER_CAROUSEL_NAMES, weather.location, name, sizeof(name)))
     {
-        drawLastUpdated(weather, startX, boxWidth);
+        return;
     }
+
+    displayManager->setFont(FONT_SANS_9);
+    displayManager->getDisplay().setTextSize(1);
+    displayManager->drawText(LOCATION_NAME_X, LAST_UPDATED_Y, name);
+#endif
 }
 
 void DisplayWeather::drawLastUpdated(const WeatherData &weather, int startX, int boxWidth)
@@ -48,22 +152,20 @@ void DisplayWeather::drawLastUpdated(const WeatherData &weather, int startX, int
     struct tm timeinfo;
     localtime_r(&updateTime, &timeinfo);
 
-    displayManager->getDisplay().setFont(&FreeSans9pt7b);
+    displayManager->setFont(FONT_SANS_9);
     displayManager->getDisplay().setTextSize(1);
 
     char timeStr[20];
     strftime(timeStr, sizeof(timeStr), "%b %d %H:%M", &timeinfo);
 
-    int textWidth = 150;
-    displayManager->getDisplay().setCursor(startX + boxWidth - textWidth + 20, 460);
-    displayManager->getDisplay().print(timeStr);
+    displayManager->drawText(startX + boxWidth - LAST_UPDATED_WIDTH + 20, LAST_UPDATED_Y, timeStr);
 }
 
-void DisplayWeather::drawCurrentTemperature(int startX, int boxWidth, int startY, float temp)
+void DisplayWeather::drawCurrentTemperature(int startX, int boxWidth, int startY, int16_t temp)
 {
     // Large current temperature using bitmap digits with degree symbol
     char tempStr[20];
-    sprintf(tempStr, "%.0f°", temp);
+    TextFormat(tempStr, sizeof(tempStr)).whole(temp).text("°");
 
     // Calculate centered position for temperature (variable width depending on digits)
     // Each digit is 60px wide, estimate total width
@@ -75,100 +177,94 @@ void DisplayWeather::drawCurrentTemperature(int startX, int boxWidth, int startY
     displayManager->drawNumberBitmap(centerX, startY, tempStr);
 }
 
-void DisplayWeather::drawHourly(int startX, int boxWidth, int startY, const WeatherData &weather)
+void DisplayWeather::drawHourlyCell(int startX, int boxWidth, int startY, const WeatherData &weather, int i)
 {
-    // Hourly forecast (next 5 hours)
-    displayManager->getDisplay().setFont(&FreeSansBold12pt7b);
+    // Hourly forecast (next 5 hours) - one of 5 columns across the box width
+    displayManager->setFont(FONT_SANS_BOLD_12);
     displayManager->getDisplay().setTextSize(1);
 
-    int colWidth = boxWidth / 5; // 5 columns across the box width
-    for (int i = 0; i < 5; i++)
-    {
-        char timeStr[8];
-        int hour = weather.hourly[i].hour;
-        int displayHour = (hour % 12 == 0) ? 12 : (hour % 12);
-        const char *ampm = (hour < 12) ? "a" : "p";
-        int colX = startX + (i * colWidth);
-        int centerX = colX + (colWidth / 2);
-
-        sprintf(timeStr, "%d%s", displayHour, ampm);
-        displayManager->drawCenteredText(timeStr, centerX, startY + TEXT_HEIGHT);
-
-        // Draw weather icon
-        drawWeatherIcon(centerX, startY + ICON_HEIGHT, weather.hourly[i].condition);
-
-        char tempStr[8];
-        sprintf(tempStr, "%.0f°", weather.hourly[i].temp);
-        displayManager->drawCenteredText(tempStr, centerX, startY + ICON_HEIGHT + (TEXT_HEIGHT * 2));
-    }
+    int colWidth = boxWidth / HOURLY_COLUMNS;
+    char timeStr[8];
+    int hour = weather.hourly[i].hour;
+    int displayHour = (hour % 12 == 0) ? 12 : (hour % 12);
+    const char *ampm = (hour < 12) ? "a" : "p";
+    int colX = startX + (i * colWidth);
+    int centerX = colX + (colWidth / 2);
+
+    TextFormat(timeStr, sizeof(timeStr)).integer(displayHour).text(ampm);
+    displayManager->drawCenteredText(timeStr, centerX, startY + TEXT_HEIGHT);
+
+    // Draw weather icon
+    drawWeatherIcon(centerX, startY + ICON_HEIGHT, weather.hourly[i].condition);
+
+    char tempStr[8];
+    TextFormat(tempStr, sizeof(tempStr)).whole(weather.hourly[i].temp).text("°");
+    displayManager->drawCenteredText(tempStr, centerX, startY + ICON_HEIGHT + (TEXT_HEIGHT * 2));
 }
 
-void DisplayWeather::drawDaily(int startX, int boxWidth, int startY, const WeatherData &weather)
+void DisplayWeather::drawDailyCell(int startX, int boxWidth, int startY, const WeatherData &weather, int i)
 {
-    // Daily forecast (next 4 days) - 4 evenly spaced columns
-    displayManager->getDisplay().setFont(&FreeSansBold12pt7b);
+    // Daily forecast (next 4 days) - one of 4 evenly spaced columns
+    displayManager->setFont(FONT_SANS_BOLD_12);
     displayManager->getDisplay().setTextSize(1);
 
-    int dayColWidth = boxWidth / 4; // 4 columns across the box width
-    for (int i = 0; i < 4; i++)
-    {
-        int boxX = startX + (i * dayColWidth);
-        int centerX = boxX + (dayColWidth / 2);
+    static const char *daysOfWeek[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
 
-        // Day of week
-        displayManager->drawCenteredText(weather.daily[i].day.c_str(), centerX, startY + TEXT_HEIGHT);
+    int dayColWidth = boxWidth / DAILY_COLUMNS;
+    int boxX = startX + (i * dayColWidth);
+    int centerX = boxX + (dayColWidth / 2);
 
-        // Draw weather icon
-        drawWeatherIcon(centerX, startY + ICON_HEIGHT, weather.daily[i].condition);
+    // Day of week
+    displayManager->drawCenteredLabel(daysOfWeek[weather.daily[i].dayOfWeek % 7], centerX, startY + TEXT_HEIGHT);
 
-        // High / Low temps
-        char tempStr[20];
-        sprintf(tempStr, "%.0f/%.0f°", weather.daily[i].tempHigh, weather.daily[i].tempLow);
-        displayManager->drawCenteredText(tempStr, centerX, startY + ICON_HEIGHT + (TEXT_HEIGHT * 2));
-    }
+    // Draw weather icon
+    drawWeatherIcon(centerX, startY + ICON_HEIGHT, weather.daily[i].condition);
+
+    // High / Low temps
+    char tempStr[20];
+    TextFormat(tempStr, sizeof(tempStr)).whole(weather.daily[i].tempHigh).text("/").whole(weather.daily[i].tempLow).text("°");
+    displayManager->drawCenteredText(tempStr, centerX, startY + ICON_HEIGHT + (TEXT_HEIGHT * 2));
 }
 
-void DisplayWeather::drawWeatherIcon(int x, int y, const String &condition)
+void DisplayWeather::drawWeatherIcon(int x, int y, WeatherCondition condition)
 {
     // Determine which bitmap to use based on condition
-    const unsigned char *bitmap = nullptr;
+    const PackedBitmap *bitmap = nullptr;
 
-    if (condition.indexOf("Clear") >= 0)
-    {
-        bitmap = sun_max_40x40;
-    }
-    else if (condition.indexOf("Cloudy") >= 0 || condition.indexOf("Overcast") >= 0)
-    {
-        bitmap = cloud_40x40;
-    }
-    else if (condition.indexOf("Foggy") >= 0)
-    {
-        bitmap = cloud_fog_40x40;
-    }
-    else if (condition.indexOf("Rain") >= 0)
-    {
-        bitmap = cloud_rain_40x40;
-    }
-    else if (condition.indexOf("Snow") >= 0)
-    {
-        bitmap = cloud_snow_40x40;
-    }
-    else if (condition.indexOf("Thunder") >= 0)
+    switch (condition)
     {
-        bitmap = cloud_bolt_rain_40x40;
+    case WEATHER_CLEAR:
+        bitmap = &sun_max_40x40;
+        break;
+    case WEATHER_CLOUDY:
+    case WEATHER_OVERCAST:
+        bitmap = &cloud_40x40;
+        break;
+    case WEATHER_FOGGY:
+        bitmap = &cloud_fog_40x40;
+        break;
+    case WEATHER_RAIN:
+        bitmap = &cloud_rain_40x40;
+        break;
+    case WEATHER_SNOW:
+        bitmap = &cloud_snow_40x40;
+        break;
+    case WEATHER_THUNDER:
+        bitmap = &cloud_bolt_rain_40x40;
+        break;
+    default:
+        break;
     }
 
     if (bitmap != nullptr)
     {
-        displayManager->drawBitmapIcon(x, y, bitmap, 40);
+        displayManager->drawBitmapIcon(x, y, *bitmap);
     }
     else
     {
         // Unknown: question mark in a box
-        auto &display = displayManager->getDisplay();
-        display.drawRect(x - 8, y - 8, 16, 16, GxEPD_BLACK);
-        display.setFont(&FreeSans9pt7b);
-        display.setCursor(x - 2, y + 5);
-        display.print("?");
+        displayManager->drawRect(x - 8, y - 8, 16, 16);
+        displayManager->setFont(FONT_SANS_9);
+        displayManager->drawText(x - 2, y + 5, "?");
     }
 }
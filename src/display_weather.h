@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "types.h"
+#include "weather_diff.h"
 
 class DisplayManager;
 
@@ -10,18 +11,25 @@ class DisplayWeather
 {
 public:
     DisplayWeather(DisplayManager *displayManager);
-    void update(const WeatherData &weather);
+    void update(const WeatherData &weather, RenderedWeather &shown); // Refreshes only regions that differ from shown
+
+    // Refresh windows needed to go from shown to weather (0 = nothing visible changed)
+    int planRefresh(const WeatherData &weather, const RenderedWeather &shown, ScreenRect *rects);
+    // Draw the regions touching window into the current page (caller owns the refresh)
+    void drawWindow(const WeatherData &weather, const ScreenRect &window);
 
 private:
     DisplayManager *displayManager;
 
-    void draw(int startX, int boxWidth, const WeatherData &weather);
+    void drawRegion(int region, const WeatherData &weather);
     void drawLastUpdated(const WeatherData &weather, int startX, int boxWidth);
+    void drawLocationName(const WeatherData &weather);
+    void drawAirQuality(int startX, int boxWidth, const WeatherData &weather);
 
-    void drawCurrentTemperature(int startX, int boxWidth, int startY, float temp);
-    void drawHourly(int startX, int boxWidth, int startY, const WeatherData &weather);
-    void drawDaily(int startX, int boxWidth, int startY, const WeatherData &weather);
-    void drawWeatherIcon(int x, int y, const String &condition);
+    void drawCurrentTemperature(int startX, int boxWidth, int startY, int16_t temp); // Tenths of a degree
+    void drawHourlyCell(int startX, int boxWidth, int startY, const WeatherData &weather, int i);
+    void drawDailyCell(int startX, int boxWidth, int startY, const WeatherData &weather, int i);
+    void drawWeatherIcon(int x, int y, WeatherCondition condition);
 };
 
 #endif // DISPLAY_WEATHER_H
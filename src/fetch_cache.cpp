@@ -0,0 +1,159 @@
+#include "fetch_cache.h"
+#include "config.h"
+#include <cstring>
+
+// Keys whose scalar values change between responses even when the forecast doesn't.
+// Arrays under the same names (hourly.time, daily.time) are still hashed.
+static const char *const VOLATILE_KEYS[] = {"generationtime_ms", "time"};
+const int VOLATILE_KEY_COUNT = sizeof(VOLATILE_KEYS) / sizeof(VOLATILE_KEYS[0]);
+
+const uint32_t FNV_OFFSET = 2166136261u;
+const uint32_t FNV_PRIME = 16777619u;
+
+static uint32_t hashBytes(uint32_t hash, const char *data, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (uint8_t)data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Index just past the closing quote of the string starting at start
+static size_t skipString(const char *body, size_t length, size_t start)
+{
+    size_t i = start + 1;
+    while (i < length && body[i] != '"')
+    {
+        i += (body[i] == '\\') ? 2 : 1;
+    }
+    return (i < length) ? i + 1 : length;
+}
+
+static bool isVolatileKey(const char *key, size_t keyLength)
+{
+    for (int k = 0; k < VOLATILE_KEY_COUNT; k++)
+    {
+        if (strlen(VOLATILE_KEYS[k]) == keyLength && memcmp(VOLATILE_KEYS[k], key, keyLength) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void copyValidator(char *dest, size_t size, const char *value)
+{
+    if (value == nullptr)
+    {
+        dest[0] = '\0';
+        return;
+    }
+    // A truncated validator would never match - store nothing instead
+    size_t length = strlen(value);
+    if (length >= size)
+    {
+        dest[0] = '\0';
+        return;
+    }
+    memcpy(dest, value, length + 1);
+}
+
+void FetchCache::reset(FetchCacheState &state)
+{
+    memset(&state, 0, sizeof(state));
+    state.parsedHour = -1;
+}
+
+bool FetchCache::canRevalidate(const FetchCacheState &state, int displayHour)
+{
+    if (state.contentHash == 0 || state.parsedHour != displayHour)
+    {
+        return false;
+    }
+    return state.etag[0] != '\0' || state.lastModified[0] != '\0';
+}
+
+uint32_t FetchCache::contentHash(const char *body, size_t length)
+{
+    uint32_t hash = FNV_OFFSET;
+    size_t i = 0;
+    while (i < length)
+    {
+        if (body[i] != '"')
+        {
+            hash = hashBytes(hash, &body[i], 1);
+            i++;
+            continue;
+        }
+
+        size_t end = skipString(body, length, i);
+        hash = hashBytes(hash, &body[i], end - i);
+
+        // Is this string a volatile key with a scalar value?
+        size_t colon = end;
+        while (colon < length && (body[colon] == ' ' || body[colon] == '\n' || body[colon] == '\r' || body[colon] == '\t'))
+            colon++;
+        if (colon >= length || body[colon] != ':' || !isVolatileKey(&body[i + 1], end - i - 2))
+        {
+            i = end;
+            continue;
+        }
+
+        size_t value = colon + 1;
+        while (value < length && (body[value] == ' ' || body[value] == '\n' || body[value] == '\r' || body[value] == '\t'))
+            value++;
+        if (value >= length || body[value] == '[' || body[value] == '{')
+        {
+            i = end;
+            continue;
+        }
+
+        // Hash the colon, drop the value
+        hash = hashBytes(hash, ":", 1);
+        i = (body[value] == '"') ? skipString(body, length, value) : value;
+        while (i < length && body[i] != ',' && body[i] != '}' && body[i] != ']')
+            i++;
+    }
+    return (hash == 0) ? 1 : hash;
+}
+
+bool FetchCache::needsParse(const FetchCacheState &state, uint32_t hash, int displayHour)
+{
+    return hash != state.contentHash || displayHour != state.parsedHour;
+}
+
+void FetchCache::recordNotModified(FetchCacheState &state)
+{
+    if (state.unchangedStreak < 255)
+        state.unchangedStreak++;
+}
+
+void FetchCache::recordBody(FetchCacheState &state, uint32_t hash, int displayHour,
+                            const char *etag, const char *lastModified)
+{
+    if (state.contentHash != 0 && hash == state.contentHash)
+    {
+        if (state.unchangedStreak < 255)
+            state.unchangedStreak++;
+    }
+    else
+    {
+        state.unchangedStreak = 0;
+    }
+
+    state.contentHash = hash;
+    state.parsedHour = (int8_t)displayHour;
+    copyValidator(state.etag, sizeof(state.etag), etag);
+    copyValidator(state.lastModified, sizeof(state.lastModified), lastModified);
+}
+
+int FetchCache::adaptiveInterval(const FetchCacheState &state, int baseInterval, int maxInterval)
+{
+    if (state.unchangedStreak < WEATHER_UNCHANGED_STRETCH || baseInterval >= maxInterval)
+    {
+        return baseInterval;
+    }
+    return (baseInterval * 2 < maxInterval) ? baseInterval * 2 : maxInterval;
+}
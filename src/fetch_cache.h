@@ -0,0 +1,90 @@
+#ifndef FETCH_CACHE_H
+#define FETCH_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Outcome of a weather fetch
+enum FetchResult : uint8_t
+{
+    FETCH_FAILED = 0,
+    FETCH_UPDATED,      // New forecast parsed into WeatherData
+    FETCH_NOT_MODIFIED  // 304 or identical content - nothing parsed, nothing to render
+};
+
+// What we know about the last response - plain data so it can live in RTC memory
+struct FetchCacheState
+{
+    char etag[64];          // ETag validator ("" = server sent none)
+    char lastModified[32];  // Last-Modified validator ("" = server sent none)
+    uint32_t contentHash;   // Hash of the last body, volatile fields excluded (0 = nothing cached)
+    int8_t parsedHour;      // Hour the hourly forecast was last parsed for (-1 = never)
+    uint8_t unchangedStreak; // Fetches in a row that found the same forecast
+};
+
+// Conditional-fetch bookkeeping and adaptive weather schedule.
+// Decisions only: the request and the parse stay in NetworkManager.
+
+class FetchCache
+{
+public:
+    /**
+     * Forget everything (fresh boot - the panel no longer shows the cached forecast)
+     */
+    static void reset(FetchCacheState &state);
+
+    /**
+     * Whether validators may be sent. A 304 carries no body, so it's only usable
+     * when the forecast on screen was parsed for the same hour.
+     * @param state Cache state
+     * @param displayHour Hour the hourly forecast will start from
+     * @return true to send If-None-Match / If-Modified-Since
+     */
+    static bool canRevalidate(const FetchCacheState &state, int displayHour);
+
+    /**
+     * FNV-1a hash of a JSON body, skipping scalar values that change on every response
+     * (generationtime_ms, current.time) so an unchanged forecast hashes the same
+     * @param body Response body
+     * @param length Body length in bytes
+     * @return Content hash (never 0)
+     */
+    static uint32_t contentHash(const char *body, size_t length);
+
+    /**
+     * Whether a downloaded body has to be parsed
+     * @param state Cache state
+     * @param hash contentHash of the body
+     * @param displayHour Hour the hourly forecast will start from
+     * @return false if the forecast and hour both match what is on screen
+     */
+    static bool needsParse(const FetchCacheState &state, uint32_t hash, int displayHour);
+
+    /**
+     * Record a 304 response
+     */
+    static void recordNotModified(FetchCacheState &state);
+
+    /**
+     * Record a 200 response (after a successful parse, if one was needed)
+     * @param state Cache state
+     * @param hash contentHash of the body
+     * @param displayHour Hour the hourly forecast was parsed for
+     * @param etag ETag header ("" or nullptr if absent)
+     * @param lastModified Last-Modified header ("" or nullptr if absent)
+     */
+    static void recordBody(FetchCacheState &state, uint32_t hash, int displayHour,
+                           const char *etag, const char *lastModified);
+
+    /**
+     * Weather interval adapted to how often the forecast actually changes: doubles after
+     * WEATHER_UNCHANGED_STRETCH unchanged fetches in a row, back to base on the first change
+     * @param state Cache state
+     * @param baseInterval Interval from the power policy in seconds
+     * @param maxInterval Longest interval to stretch to in seconds
+     * @return Interval to schedule the next fetch with
+     */
+    static int adaptiveInterval(const FetchCacheState &state, int baseInterval, int maxInterval);
+};
+
+#endif // FETCH_CACHE_H
@@ -0,0 +1,219 @@
+#include "flash_ring.h"
+
+const uint8_t RING_MAGIC_0 = 'T';
+const uint8_t RING_MAGIC_1 = 'R';
+const size_t RING_CHUNK = 256; // Payload read while hashing
+
+static uint32_t ringHash(const uint8_t *bytes, size_t length, uint32_t hash = 2166136261u)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t ringLe32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void ringStore32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+static int sectorsFor(size_t length)
+{
+    return (int)((FLASH_RING_HEADER_SIZE + length + FLASH_RING_SECTOR_SIZE - 1) / FLASH_RING_SECTOR_SIZE);
+}
+
+bool FlashRing::mount(const FlashPort &flashPort)
+{
+    port = flashPort;
+    sectors = (int)(port.size / FLASH_RING_SECTOR_SIZE);
+    head = 0;
+    nextSequence = 1;
+    erased = 0;
+    written = 0;
+    for (int i = 0; i < FLASH_RING_MAX_TYPES; i++)
+    {
+        live[i] = {};
+    }
+
+    uint8_t probe[FLASH_RING_HEADER_SIZE];
+    if (sectors == 0 || !port.read(port.context, 0, probe, sizeof(probe)))
+    {
+        return false;
+    }
+
+    // Records start on sector boundaries, so walk them; anything that doesn't hash is stale
+    // or erased and is stepped over one sector at a time
+    uint32_t newest = 0;
+    int sector = 0;
+    while (sector < sectors)
+    {
+        Live record;
+        uint8_t type;
+        if (!readRecord(sector, record, type))
+        {
+            sector++;
+            continue;
+        }
+        if (!live[type].valid || record.sequence > live[type].sequence)
+        {
+            live[type] = record;
+        }
+        if (record.sequence >= newest)
+        {
+            newest = record.sequence;
+            head = (sector + record.sectors) % sectors;
+        }
+        sector += record.sectors;
+    }
+    nextSequence = newest + 1;
+    return true;
+}
+
+bool FlashRing::readRecord(int sector, Live &record, uint8_t &type)
+{
+    uint32_t offset = (uint32_t)sector * FLASH_RING_SECTOR_SIZE;
+    uint8_t header[FLASH_RING_HEADER_SIZE];
+    if (!port.read(port.context, offset, header, sizeof(header)) || header[0] != RING_MAGIC_0 ||
+        header[1] != RING_MAGIC_1 || header[2] >= FLASH_RING_MAX_TYPES)
+    {
+        return false;
+    }
+    uint32_t length = ringLe32(header + 8);
+    if (length > port.size - offset - FLASH_RING_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    uint32_t recordHash = ringHash(header, 12);
+    uint32_t payloadHash = ringHash(nullptr, 0);
+    uint8_t chunk[RING_CHUNK];
+    for (uint32_t pos = 0; pos < length; pos += RING_CHUNK)
+    {
+        size_t n = length - pos < RING_CHUNK ? length - pos : RING_CHUNK;
+        if (!port.read(port.context, offset + FLASH_RING_HEADER_SIZE + pos, chunk, n))
+        {
+            return false;
+        }
+        recordHash = ringHash(chunk, n, recordHash);
+        payloadHash = ringHash(chunk, n, payloadHash);
+    }
+    if (recordHash != ringLe32(header + 12))
+    {
+        return false;
+    }
+
+    type = header[2];
+    record.valid = true;
+    record.sector = (uint16_t)sector;
+    record.sectors = (uint16_t)sectorsFor(length);
+    record.length = length;
+    record.hash = payloadHash;
+    record.sequence = ringLe32(header + 4);
+    return true;
+}
+
+bool FlashRing::find(uint8_t type, size_t &length) const
+{
+    if (type >= FLASH_RING_MAX_TYPES || !live[type].valid)
+    {
+        return false;
+    }
+    length = live[type].length;
+    return true;
+}
+
+bool FlashRing::read(uint8_t type, uint8_t *out, size_t capacity, size_t &length)
+{
+    if (!find(type, length) || length > capacity)
+    {
+        return false;
+    }
+    uint32_t offset = (uint32_t)live[type].sector * FLASH_RING_SECTOR_SIZE + FLASH_RING_HEADER_SIZE;
+    return port.read(port.context, offset, out, length);
+}
+
+bool FlashRing::overlapsLive(int start, int count, int &liveEnd) const
+{
+    for (int i = 0; i < FLASH_RING_MAX_TYPES; i++)
+    {
+        const Live &l = live[i];
+        if (l.valid && start < l.sector + l.sectors && l.sector < start + count)
+        {
+            liveEnd = l.sector + l.sectors;
+            return true;
+        }
+    }
+    return false;
+}
+
+FlashRingResult FlashRing::write(uint8_t type, const uint8_t *data, size_t length)
+{
+    if (type >= FLASH_RING_MAX_TYPES || sectors == 0)
+    {
+        return RING_FAILED;
+    }
+    if (live[type].valid && live[type].length == length && live[type].hash == ringHash(data, length))
+    {
+        return RING_UNCHANGED;
+    }
+
+    // First run of free sectors from the head. The record being replaced counts as live too,
+    // so it survives until the new one is complete.
+    int count = sectorsFor(length);
+    int start = head;
+    int tail = -1; // Free sectors at the end that were too few for this record
+    bool found = false;
+    for (int attempt = 0; attempt <= 2 * FLASH_RING_MAX_TYPES + 1 && count <= sectors; attempt++)
+    {
+        if (start + count > sectors)
+        {
+            tail = tail < 0 ? start : tail;
+            start = 0;
+        }
+        int liveEnd;
+        if (!overlapsLive(start, count, liveEnd))
+        {
+            found = true;
+            break;
+        }
+        start = liveEnd;
+    }
+    if (!found)
+    {
+        return RING_FULL;
+    }
+
+    uint32_t offset = (uint32_t)start * FLASH_RING_SECTOR_SIZE;
+    uint8_t header[FLASH_RING_HEADER_SIZE] = {RING_MAGIC_0, RING_MAGIC_1, type, 0};
+    ringStore32(header + 4, nextSequence);
+    ringStore32(header + 8, (uint32_t)length);
+    ringStore32(header + 12, ringHash(data, length, ringHash(header, 12)));
+
+    if (!port.erase(port.context, offset, (size_t)count * FLASH_RING_SECTOR_SIZE))
+    {
+        return RING_FAILED;
+    }
+    erased += count;
+    if (!port.write(port.context, offset + FLASH_RING_HEADER_SIZE, data, length) ||
+        !port.write(port.context, offset, header, sizeof(header)))
+    {
+        return RING_FAILED;
+    }
+    written += FLASH_RING_HEADER_SIZE + length;
+
+    live[type] = {true, (uint16_t)start, (uint16_t)count, (uint32_t)length, ringHash(data, length), nextSequence};
+    nextSequence++;
+    // A skipped tail goes to the next, smaller record; otherwise a steady mix of sizes can
+    // keep wrapping at the same place and never wear the last sectors
+    head = tail >= 0 ? tail : (start + count) % sectors;
+    return RING_WRITTEN;
+}
@@ -0,0 +1,103 @@
+#ifndef FLASH_RING_H
+#define FLASH_RING_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Log of typed records in a flash partition, the newest of each type kept
+//
+// Every record starts on a sector boundary:
+//   0  'T' 'R'   magic
+//   2  u8        type
+//   3  u8        reserved
+//   4  u32       sequence number (higher = newer)
+//   8  u32       payload length
+//   12 u32       FNV-1a of bytes 0..11 and the payload
+//   16 payload   spanning as many sectors as it needs
+//
+// Multi-byte fields are little-endian. New records go at the head, which moves round the
+// partition and steps over the sectors of the live records (the newest of each type), so
+// erases spread over every other sector. The payload is written before the header, so a
+// record cut short by a reset has no valid header and the previous one stays live.
+
+#define FLASH_RING_SECTOR_SIZE 4096
+#define FLASH_RING_HEADER_SIZE 16
+#define FLASH_RING_MAX_TYPES 4
+
+// Partition access - esp_partition_* on the device, a RAM image in tests
+struct FlashPort
+{
+    void *context;
+    uint32_t size; // Bytes, a multiple of FLASH_RING_SECTOR_SIZE
+    bool (*read)(void *context, uint32_t offset, void *out, size_t length);
+    bool (*write)(void *context, uint32_t offset, const void *data, size_t length);
+    bool (*erase)(void *context, uint32_t offset, size_t length); // Whole sectors
+};
+
+enum FlashRingResult : uint8_t
+{
+    RING_WRITTEN = 0,
+    RING_UNCHANGED, // Same payload as the live record - nothing written
+    RING_FULL,      // No free run of sectors outside the live records
+    RING_FAILED     // Flash read, write or erase error
+};
+
+// Every flash access goes through FlashPort; tests use a RAM image that can fail on request.
+class FlashRing
+{
+public:
+    /**
+     * Scan the partition for the live records and the head
+     * @return false if the partition can't be read
+     */
+    bool mount(const FlashPort &flashPort);
+
+    /**
+     * Payload length of the newest record of type
+     * @return false if there is none
+     */
+    bool find(uint8_t type, size_t &length) const;
+
+    /**
+     * Read the newest record of type
+     * @param out Output buffer
+     * @param capacity Output capacity
+     * @param length Payload length on success
+     * @return false if there is none, it doesn't fit or can't be read
+     */
+    bool read(uint8_t type, uint8_t *out, size_t capacity, size_t &length);
+
+    /**
+     * Make data the newest record of type, unless it already is
+     */
+    FlashRingResult write(uint8_t type, const uint8_t *data, size_t length);
+
+    uint32_t sectorsErased() const { return erased; } // Since mount
+    uint32_t bytesWritten() const { return written; }
+    uint32_t recordsWritten() const { return nextSequence - 1; } // Over the partition's life
+    int sectorCount() const { return sectors; }
+
+private:
+    struct Live
+    {
+        bool valid;
+        uint16_t sector;
+        uint16_t sectors;
+        uint32_t length;
+        uint32_t hash;
+        uint32_t sequence;
+    };
+
+    bool readRecord(int sector, Live &record, uint8_t &type);
+    bool overlapsLive(int start, int count, int &liveEnd) const;
+
+    FlashPort port = {};
+    int sectors = 0;
+    int head = 0;
+    uint32_t nextSequence = 1;
+    Live live[FLASH_RING_MAX_TYPES] = {};
+    uint32_t erased = 0;
+    uint32_t written = 0;
+};
+
+#endif // FLASH_RING_H
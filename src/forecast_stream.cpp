@@ -0,0 +1,474 @@
+#include "forecast_stream.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+// Sections a location needs before it counts as parsed
+const uint8_t SECTION_CURRENT = 0x01;
+const uint8_t SECTION_HOURLY = 0x02;
+const uint8_t SECTION_DAILY = 0x04;
+const uint8_t SECTION_ALL = SECTION_CURRENT | SECTION_HOURLY | SECTION_DAILY;
+
+static int16_t parseTenths(const char *text)
+{
+    // "null" and other non-numbers read as 0, like the "| 0.0f" defaults in parseWeatherJson
+    return (int16_t)lroundf(strtof(text, nullptr) * 10.0f);
+}
+
+static uint8_t parseByte(const char *text)
+{
+    long v = lroundf(strtof(text, nullptr));
+    return (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+void ForecastStreamParser::begin(LocationForecast *out, int maxOut, time_t shownAt, int hourIfNoOffset)
+{
+    reset(out, maxOut);
+    displayTime = shownAt;
+    fallbackHour = hourIfNoOffset;
+    required = SECTION_ALL;
+    memset(records, 0, sizeof(LocationForecast) * maxLocations);
+}
+
+void ForecastStreamParser::beginAirQuality(LocationForecast *out, int maxOut)
+{
+    reset(out, maxOut);
+    required = SECTION_CURRENT;
+    for (int i = 0; i < maxLocations; i++)
+    {
+        records[i].hasAirQuality = 0;
+        records[i].usAqi = 0;
+        records[i].pm25Tenths = 0;
+    }
+}
+
+void ForecastStreamParser::reset(LocationForecast *out, int maxOut)
+{
+    records = out;
+    maxLocations = maxOut;
+    depth = 0;
+    locationDepth = -1;
+    state = STATE_STRUCTURE;
+    tokenLength = 0;
+    failed = false;
+    started = false;
+    locations = 0;
+    sections = 0;
+    hasOffset = false;
+    utcOffset = 0;
+}
+
+bool ForecastStreamParser::feed(const char *data, size_t length)
+{
+    for (size_t i = 0; i < length && !failed; i++)
+    {
+        char c = data[i];
+        switch (state)
+        {
+        case STATE_STRING:
+            if (c == '\\')
+            {
+                state = STATE_ESCAPE;
+            }
+            else if (c == '"')
+            {
+                state = STATE_STRUCTURE;
+                value(true);
+            }
+            else if (tokenLength < TOKEN_SIZE - 1)
+            {
+                token[tokenLength++] = c;
+            }
+            break;
+
+        case STATE_ESCAPE:
+            // Escapes never occur in the fields we keep; the character is kept as is
+            if (tokenLength < TOKEN_SIZE - 1)
+                token[tokenLength++] = c;
+            state = STATE_STRING;
+            break;
+
+        case STATE_LITERAL:
+            if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' || c == '+' || c == '.' || c == 'E')
+            {
+                if (tokenLength < TOKEN_SIZE - 1)
+                    token[tokenLength++] = c;
+                break;
+            }
+            state = STATE_STRUCTURE;
+            value(false);
+            structural(c);
+            break;
+
+        case STATE_STRUCTURE:
+            structural(c);
+            break;
+        }
+    }
+    return !failed;
+}
+
+int ForecastStreamParser::finish()
+{
+    if (failed || !started || depth != 0 || state == STATE_STRING || state == STATE_ESCAPE)
+    {
+        return -1;
+    }
+    return locations;
+}
+
+void ForecastStreamParser::structural(char c)
+{
+    switch (c)
+    {
+    case ' ':
+    case '\t':
+    case '\r':
+    case '\n':
+        return;
+    case '{':
+        push(false);
+        return;
+    case '[':
+        push(true);
+        return;
+    case '}':
+        pop(false);
+        return;
+    case ']':
+        pop(true);
+        return;
+    case ',':
+        if (depth == 0)
+        {
+            failed = true;
+        }
+        else if (stack[depth - 1].isArray)
+        {
+            stack[depth - 1].index++;
+        }
+        else
+        {
+            stack[depth - 1].expectKey = true;
+        }
+        return;
+    case ':':
+        if (depth == 0 || stack[depth - 1].isArray || !stack[depth - 1].expectKey)
+        {
+            failed = true;
+            return;
+        }
+        stack[depth - 1].expectKey = false;
+        return;
+    case '"':
+        tokenIsKey = depth > 0 && !stack[depth - 1].isArray && stack[depth - 1].expectKey;
+        tokenLength = 0;
+        state = STATE_STRING;
+        return;
+    default:
+        tokenIsKey = false;
+        tokenLength = 0;
+        token[tokenLength++] = c;
+        state = STATE_LITERAL;
+        return;
+    }
+}
+
+void ForecastStreamParser::push(bool isArray)
+{
+    if (depth == MAX_DEPTH || (depth == 0 && started))
+    {
+        failed = true;
+        return;
+    }
+
+    if (depth == 0)
+    {
+        // An array at the top means one object per requested location
+        started = true;
+        locationDepth = isArray ? 1 : 0;
+    }
+
+    if (depth == locationDepth)
+    {
+        sections = 0;
+        hasOffset = false;
+    }
+    else if (depth == locationDepth + 1 && !isArray)
+    {
+        // "hourly_units" and friends don't match
+        const char *section = stack[locationDepth].key;
+        if (strcmp(section, "current") == 0)
+            sections |= SECTION_CURRENT;
+        else if (strcmp(section, "hourly") == 0)
+            sections |= SECTION_HOURLY;
+        else if (strcmp(section, "daily") == 0)
+            sections |= SECTION_DAILY;
+    }
+
+    Frame &frame = stack[depth++];
+    frame.isArray = isArray;
+    frame.expectKey = !isArray;
+    frame.index = 0;
+    frame.key[0] = '\0';
+}
+
+void ForecastStreamParser::pop(bool isArray)
+{
+    if (depth == 0 || stack[depth - 1].isArray != isArray)
+    {
+        failed = true;
+        return;
+    }
+    depth--;
+
+    if (depth == locationDepth)
+    {
+        // A location without all its sections fails the whole response, like parseWeatherJson
+        if ((sections & required) != required)
+        {
+            failed = true;
+            return;
+        }
+        int location = (locationDepth == 1) ? stack[0].index : 0;
+        if (location < maxLocations)
+        {
+            locations = location + 1;
+        }
+    }
+}
+
+int ForecastStreamParser::hourlyStart() const
+{
+    // Arrays start at local midnight of the location (timezone=auto); columns start at the next hour
+    if (!hasOffset)
+    {
+        return fallbackHour + 1;
+    }
+    int64_t local = (int64_t)displayTime + utcOffset;
+    int secondsOfDay = (int)(((local % 86400) + 86400) % 86400);
+    return secondsOfDay / 3600 + 1;
+}
+
+void ForecastStreamParser::value(bool isString)
+{
+    token[tokenLength] = '\0';
+    if (tokenIsKey)
+    {
+        memcpy(stack[depth - 1].key, token, tokenLength + 1);
+        return;
+    }
+    if (depth == 0 || locationDepth < 0 || depth - 1 < locationDepth)
+    {
+        return;
+    }
+
+    int location = (locationDepth == 1) ? stack[0].index : 0;
+    if (location >= maxLocations)
+    {
+        return;
+    }
+    LocationForecast &record = records[location];
+    int level = depth - 1 - locationDepth; // 0 = in the location object, 1 = in a section, 2 = in a section's array
+    const Frame &top = stack[depth - 1];
+
+    if (level == 0)
+    {
+        if (!isString && strcmp(top.key, "utc_offset_seconds") == 0)
+        {
+            hasOffset = true;
+            utcOffset = strtol(token, nullptr, 10);
+        }
+        return;
+    }
+
+    const char *section = stack[locationDepth].key;
+    if (level == 1 && !top.isArray && strcmp(section, "current") == 0)
+    {
+        if (strcmp(top.key, "temperature_2m") == 0)
+            record.currentTemp = parseTenths(token);
+        else if (strcmp(top.key, "relative_humidity_2m") == 0)
+            record.humidity = parseByte(token);
+        else if (strcmp(top.key, "wind_speed_10m") == 0)
+            record.windSpeed = parseByte(token);
+        else if (strcmp(top.key, "weather_code") == 0)
+            record.currentCondition = conditionForCode(atoi(token));
+        else if (strcmp(top.key, "us_aqi") == 0 && strcmp(token, "null") != 0)
+        {
+            long aqi = lroundf(strtof(token, nullptr));
+            record.usAqi = (uint16_t)(aqi < 0 ? 0 : (aqi > 999 ? 999 : aqi));
+            record.hasAirQuality = 1;
+        }
+        else if (strcmp(top.key, "pm2_5") == 0)
+        {
+            int16_t pm25 = parseTenths(token);
+            record.pm25Tenths = (uint16_t)(pm25 < 0 ? 0 : pm25);
+        }
+        return;
+    }
+
+    if (level != 2 || !top.isArray)
+    {
+        return;
+    }
+    const char *field = stack[depth - 2].key;
+
+    if (strcmp(section, "hourly") == 0)
+    {
+        int slot = top.index - hourlyStart();
+        if (slot < 0 || slot >= 6)
+            return;
+        if (strcmp(field, "time") == 0)
+        {
+            // "2026-01-02T14:00" -> 14
+            const char *t = strchr(token, 'T');
+            record.hourly[slot].hour = t ? (uint8_t)atoi(t + 1) : 0;
+        }
+        else if (strcmp(field, "temperature_2m") == 0)
+            record.hourly[slot].temp = parseTenths(token);
+        else if (strcmp(field, "weather_code") == 0)
+            record.hourly[slot].condition = conditionForCode(atoi(token));
+    }
+    else if (strcmp(section, "daily") == 0)
+    {
+        int slot = top.index;
+        if (slot >= 4)
+            return;
+        if (strcmp(field, "time") == 0)
+            record.daily[slot].dayOfWeek = dayOfWeekFor(token);
+        else if (strcmp(field, "temperature_2m_max") == 0)
+            record.daily[slot].tempHigh = parseTenths(token);
+        else if (strcmp(field, "temperature_2m_min") == 0)
+            record.daily[slot].tempLow = parseTenths(token);
+        else if (strcmp(field, "weather_code") == 0)
+            record.daily[slot].condition = conditionForCode(atoi(token));
+    }
+}
+
+WeatherCondition ForecastStreamParser::conditionForCode(int wmoCode)
+{
+    if (wmoCode == 0 || wmoCode == 1)
+        return WEATHER_CLEAR;
+    if (wmoCode == 2)
+        return WEATHER_CLOUDY;
+    if (wmoCode == 3)
+        return WEATHER_OVERCAST;
+    if (wmoCode == 45 || wmoCode == 48)
+        return WEATHER_FOGGY;
+    if (wmoCode >= 51 && wmoCode <= 67)
+        return WEATHER_RAIN;
+    if (wmoCode >= 71 && wmoCode <= 87)
+        return WEATHER_SNOW;
+    if (wmoCode >= 90 && wmoCode <= 99)
+        return WEATHER_THUNDER;
+    return WEATHER_UNKNOWN;
+}
+
+uint8_t ForecastStreamParser::dayOfWeekFor(const char *isoDate)
+{
+    // Parse year, month, day from YYYY-MM-DD format
+    int year = atoi(isoDate);
+    int month = (strlen(isoDate) >= 7) ? atoi(isoDate + 5) : 1;
+    int day = (strlen(isoDate) >= 10) ? atoi(isoDate + 8) : 1;
+
+    // Zeller's congruence to get day of week (January and February count as months 13 and 14
+    // of the previous year)
+    int m = month;
+    if (m < 3)
+    {
+        m += 12;
+        year--;
+    }
+    int q = day;
+    int k = year % 100;
+    int j = year / 100;
+
+    int h = (q + (13 * (m + 1)) / 5 + k + k / 4 + j / 4 + 5 * j) % 7; // 0=Sat, 1=Sun, etc.
+    return (uint8_t)((h + 6) % 7);                                   // Convert to 0=Sun, 1=Mon, etc.
+}
+
+int WeatherCarousel::slotAt(time_t now, int count, int periodSeconds)
+{
+    if (count <= 1 || periodSeconds <= 0 || now < 0)
+    {
+        return 0;
+    }
+    return (int)((now / periodSeconds) % count);
+}
+
+int WeatherCarousel::listCount(const char *list)
+{
+    if (list == nullptr || list[0] == '\0')
+    {
+        return 0;
+    }
+    int count = 1;
+    for (const char *p = list; *p; p++)
+    {
+        if (*p == ',')
+            count++;
+    }
+    return count;
+}
+
+bool WeatherCarousel::listEntry(const char *list, int index, char *out, size_t size)
+{
+    if (index < 0 || index >= listCount(list) || size == 0)
+    {
+        return false;
+    }
+
+    const char *start = list;
+    for (int i = 0; i < index; i++)
+    {
+        start = strchr(start, ',') + 1;
+    }
+    const char *end = strchr(start, ',');
+    size_t length = end ? (size_t)(end - start) : strlen(start);
+    if (length >= size)
+        length = size - 1;
+    memcpy(out, start, length);
+    out[length] = '\0';
+    return true;
+}
+
+void WeatherCarousel::expand(const LocationForecast &record, uint8_t location, time_t fetchedAt, WeatherData &weather)
+{
+    weather = {};
+    weather.currentTemp = record.currentTemp;
+    weather.currentCondition = (WeatherCondition)record.currentCondition;
+    weather.humidity = record.humidity;
+    weather.windSpeed = record.windSpeed;
+    weather.lastUpdated = fetchedAt;
+    weather.location = location;
+    weather.hasAirQuality = record.hasAirQuality != 0;
+    weather.usAqi = record.usAqi;
+    weather.pm25Tenths = record.pm25Tenths;
+
+    for (int i = 0; i < 6; i++)
+    {
+        weather.hourly[i].hour = record.hourly[i].hour;
+        weather.hourly[i].temp = record.hourly[i].temp;
+        weather.hourly[i].condition = (WeatherCondition)record.hourly[i].condition;
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        weather.daily[i].dayOfWeek = record.daily[i].dayOfWeek;
+        weather.daily[i].tempHigh = record.daily[i].tempHigh;
+        weather.daily[i].tempLow = record.daily[i].tempLow;
+        weather.daily[i].condition = (WeatherCondition)record.daily[i].condition;
+    }
+}
+
+uint32_t WeatherCarousel::recordsHash(const LocationForecast *records, int count)
+{
+    // FNV-1a over the records; the parser zeroes them first, so padding is stable
+    const uint8_t *bytes = (const uint8_t *)records;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(LocationForecast) * count; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash ? hash : 1;
+}
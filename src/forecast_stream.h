@@ -0,0 +1,176 @@
+#ifndef FORECAST_STREAM_H
+#define FORECAST_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include "types.h"
+
+// One location's forecast reduced to what the weather pane shows.
+// Fixed point (tenths of a degree) so a record per carousel location fits in RTC memory.
+struct LocationForecast
+{
+    int16_t currentTemp;
+    uint8_t currentCondition;
+    uint8_t humidity;
+    uint8_t windSpeed;
+    uint8_t hasAirQuality; // Set by a successful air-quality pass
+    struct
+    {
+        uint8_t hour;
+        uint8_t condition;
+        int16_t temp;
+    } hourly[6];
+    struct
+    {
+        uint8_t dayOfWeek;
+        uint8_t condition;
+        int16_t tempHigh;
+        int16_t tempLow;
+    } daily[4];
+    uint16_t usAqi;
+    uint16_t pm25Tenths; // PM2.5 in tenths of ug/m3
+};
+
+// Streaming parser for Open-Meteo forecast and air-quality responses, single location (an
+// object) or several (an array of objects, one per comma-separated coordinate in the request).
+// Bytes are fed as they arrive; only the values the pane shows are kept, so memory use
+// doesn't grow with the number of locations or forecast days.
+// Knows nothing of sockets: the caller feeds whatever the connection returned.
+
+class ForecastStreamParser
+{
+public:
+    /**
+     * Start a new response
+     * @param records Output, one per location
+     * @param maxLocations Records available; later locations are skipped
+     * @param displayTime Time the forecast will be shown (hourly columns start at the next hour)
+     * @param fallbackHour Local hour to use when a location has no utc_offset_seconds
+     */
+    void begin(LocationForecast *records, int maxLocations, time_t displayTime, int fallbackHour);
+
+    /**
+     * Start an air-quality response for records already filled by a forecast response.
+     * Only us_aqi and pm2_5 from the current section are written; locations match by index.
+     * @param records Records from the forecast pass
+     * @param maxLocations Records available
+     */
+    void beginAirQuality(LocationForecast *records, int maxLocations);
+
+    /**
+     * Parse the next chunk of the body
+     * @return false once the JSON is malformed (further chunks are ignored)
+     */
+    bool feed(const char *data, size_t length);
+
+    /**
+     * End of body
+     * @return Number of complete locations parsed, -1 if the response was truncated, malformed
+     *         or a location is missing a section (current/hourly/daily, or current for air quality)
+     */
+    int finish();
+
+    /**
+     * Simplified WMO weather code to condition mapping
+     */
+    static WeatherCondition conditionForCode(int wmoCode);
+
+    /**
+     * Day of week for an ISO date ("2026-01-03")
+     * @return 0=Sun, 1=Mon, etc.
+     */
+    static uint8_t dayOfWeekFor(const char *isoDate);
+
+private:
+    static const int MAX_DEPTH = 6;
+    static const int TOKEN_SIZE = 32;
+
+    struct Frame
+    {
+        bool isArray;
+        bool expectKey;
+        int index;
+        char key[TOKEN_SIZE];
+    };
+
+    enum State : uint8_t
+    {
+        STATE_STRUCTURE,
+        STATE_STRING,
+        STATE_ESCAPE,
+        STATE_LITERAL
+    };
+
+    void reset(LocationForecast *out, int maxOut);
+    void structural(char c);
+    void push(bool isArray);
+    void pop(bool isArray);
+    void value(bool isString);
+    int hourlyStart() const;
+
+    LocationForecast *records = nullptr;
+    int maxLocations = 0;
+    time_t displayTime = 0;
+    int fallbackHour = 0;
+
+    Frame stack[MAX_DEPTH];
+    int depth = 0;
+    int locationDepth = -1; // Stack depth of a location object (0 = single, 1 = array of locations)
+    State state = STATE_STRUCTURE;
+    bool tokenIsKey = false;
+    char token[TOKEN_SIZE];
+    int tokenLength = 0;
+    bool failed = false;
+    bool started = false;
+
+    int locations = 0;
+    uint8_t sections = 0; // Sections seen in the current location
+    uint8_t required = 0; // Sections every location must have
+    bool hasOffset = false;
+    int32_t utcOffset = 0;
+};
+
+// Rotation of the weather pane through the carousel locations.
+// Only arithmetic on the fetch time, so every wake picks the same slot for the same minute.
+
+class WeatherCarousel
+{
+public:
+    /**
+     * Location due on the pane at a given time. Tied to the wall clock, so the rotation
+     * needs no state and every wake agrees on it.
+     * @param now Current time
+     * @param count Locations in the carousel
+     * @param periodSeconds Time each location stays on the pane
+     * @return Location index
+     */
+    static int slotAt(time_t now, int count, int periodSeconds);
+
+    /**
+     * Entries in a comma-separated config list
+     */
+    static int listCount(const char *list);
+
+    /**
+     * Copy one entry of a comma-separated config list
+     * @return false if the list has no such entry
+     */
+    static bool listEntry(const char *list, int index, char *out, size_t size);
+
+    /**
+     * Expand a compact record for the renderer
+     * @param record Compact forecast
+     * @param location Carousel index, drawn as the location name
+     * @param fetchedAt Time of the fetch, for the "last updated" stamp
+     * @param weather Output
+     */
+    static void expand(const LocationForecast &record, uint8_t location, time_t fetchedAt, WeatherData &weather);
+
+    /**
+     * Content hash of parsed records, for FetchCache (never 0)
+     */
+    static uint32_t recordsHash(const LocationForecast *records, int count);
+};
+
+#endif // FORECAST_STREAM_H
@@ -0,0 +1,214 @@
+#include "frame_codec.h"
+#include <cstring>
+
+static uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return (uint32_t)get16(p) | ((uint32_t)get16(p + 2) << 16);
+}
+
+static void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    put16(p, (uint16_t)v);
+    put16(p + 2, (uint16_t)(v >> 16));
+}
+
+bool FrameDecoder::begin(const uint8_t *frame, size_t length)
+{
+    data = nullptr;
+    if (length < FRAME_HEADER_SIZE || frame[0] != 'T' || frame[1] != 'F' || frame[2] != FRAME_VERSION)
+    {
+        return false;
+    }
+
+    frameInfo.flags = frame[3];
+    frameInfo.x = get16(frame + 4);
+    frameInfo.y = get16(frame + 6);
+    frameInfo.width = get16(frame + 8);
+    frameInfo.height = get16(frame + 10);
+    frameInfo.dataLength = get32(frame + 12);
+
+    if (frameInfo.width == 0 || frameInfo.width % 8 != 0 || frameInfo.height == 0 ||
+        frameInfo.dataLength != length - FRAME_HEADER_SIZE)
+    {
+        return false;
+    }
+    if (!(frameInfo.flags & FRAME_FLAG_PACKBITS) &&
+        frameInfo.dataLength != (uint32_t)rowBytes() * frameInfo.height)
+    {
+        return false;
+    }
+
+    data = frame + FRAME_HEADER_SIZE;
+    rewind();
+    return true;
+}
+
+void FrameDecoder::rewind()
+{
+    pos = 0;
+    row = 0;
+    runRemaining = 0;
+}
+
+int FrameDecoder::decodeRows(uint8_t *band, int maxRows)
+{
+    if (data == nullptr)
+    {
+        return -1;
+    }
+
+    int rows = frameInfo.height - row;
+    if (rows > maxRows)
+        rows = maxRows;
+    if (rows <= 0)
+        return 0;
+
+    size_t needed = (size_t)rows * rowBytes();
+
+    if (!(frameInfo.flags & FRAME_FLAG_PACKBITS))
+    {
+        memcpy(band, data + pos, needed);
+        pos += needed;
+        row += rows;
+        return rows;
+    }
+
+    size_t out = 0;
+    while (out < needed)
+    {
+        if (runRemaining == 0)
+        {
+            if (pos >= frameInfo.dataLength)
+                return -1; // Stream ended before the image did
+            int8_t header = (int8_t)data[pos++];
+            if (header == -128)
+                continue; // No-op
+            if (header >= 0)
+            {
+                runRepeats = false;
+                runRemaining = header + 1;
+            }
+            else
+            {
+                if (pos >= frameInfo.dataLength)
+                    return -1;
+                runRepeats = true;
+                runRemaining = 1 - header;
+                runByte = data[pos++];
+            }
+        }
+
+        // Copy as much of the run as fits in this band
+        size_t chunk = (size_t)runRemaining;
+        if (chunk > needed - out)
+            chunk = needed - out;
+        if (runRepeats)
+        {
+            memset(band + out, runByte, chunk);
+        }
+        else
+        {
+            if (pos + chunk > frameInfo.dataLength)
+                return -1;
+            memcpy(band + out, data + pos, chunk);
+            pos += chunk;
+        }
+        out += chunk;
+        runRemaining -= (int)chunk;
+    }
+
+    row += rows;
+    return rows;
+}
+
+size_t FrameCodec::maxEncodedSize(int width, int height)
+{
+    size_t raw = (size_t)width / 8 * height;
+    return FRAME_HEADER_SIZE + raw + (raw + 127) / 128;
+}
+
+size_t FrameCodec::encode(const uint8_t *image, FrameInfo info, uint8_t *out, size_t capacity)
+{
+    return encode(image, info.width / 8, info, out, capacity);
+}
+
+size_t FrameCodec::encode(const uint8_t *image, size_t stride, FrameInfo info, uint8_t *out, size_t capacity)
+{
+    size_t rowBytes = info.width / 8;
+    size_t raw = rowBytes * info.height;
+    if (capacity < FRAME_HEADER_SIZE)
+        return 0;
+
+    // Byte i of the frame image, which may be a window of a wider one
+    auto at = [&](size_t i) { return image[(i / rowBytes) * stride + i % rowBytes]; };
+
+    size_t o = FRAME_HEADER_SIZE;
+    if (!(info.flags & FRAME_FLAG_PACKBITS))
+    {
+        if (o + raw > capacity)
+            return 0;
+        for (size_t r = 0; r < info.height; r++)
+        {
+            memcpy(out + o, image + r * stride, rowBytes);
+            o += rowBytes;
+        }
+    }
+    else
+    {
+        size_t i = 0;
+        while (i < raw)
+        {
+            // Length of the repeat starting here
+            size_t run = 1;
+            while (i + run < raw && run < 128 && at(i + run) == at(i))
+                run++;
+
+            if (run >= 2)
+            {
+                if (o + 2 > capacity)
+                    return 0;
+                out[o++] = (uint8_t)(int8_t)(1 - (int)run);
+                out[o++] = at(i);
+                i += run;
+                continue;
+            }
+
+            // Literal until the next repeat of 3+ (a 2-byte repeat costs the same as literals)
+            size_t count = 0;
+            while (i < raw && count < 128)
+            {
+                if (i + 2 < raw && at(i) == at(i + 1) && at(i) == at(i + 2))
+                    break;
+                i++;
+                count++;
+            }
+            if (o + 1 + count > capacity)
+                return 0;
+            out[o++] = (uint8_t)(count - 1);
+            for (size_t k = i - count; k < i; k++)
+                out[o++] = at(k);
+        }
+    }
+
+    out[0] = 'T';
+    out[1] = 'F';
+    out[2] = FRAME_VERSION;
+    out[3] = info.flags;
+    put16(out + 4, info.x);
+    put16(out + 6, info.y);
+    put16(out + 8, info.width);
+    put16(out + 10, info.height);
+    put32(out + 12, (uint32_t)(o - FRAME_HEADER_SIZE));
+    return o;
+}
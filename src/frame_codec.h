@@ -0,0 +1,100 @@
+#ifndef FRAME_CODEC_H
+#define FRAME_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Server-rendered 1bpp frame, as served by scripts/render_server.py
+//
+//   0  'T' 'F'   magic
+//   2  u8        version
+//   3  u8        flags (FRAME_FLAG_PACKBITS = data is PackBits compressed, else raw)
+//   4  u16       x      position on the panel
+//   6  u16       y
+//   8  u16       width  (multiple of 8)
+//   10 u16       height
+//   12 u32       data length in bytes
+//   16 data      rows top to bottom, MSB = leftmost pixel, 1 = white (GxEPD2 image convention)
+//
+// Multi-byte fields are little-endian. PackBits runs may cross row boundaries.
+
+#define FRAME_VERSION 1
+#define FRAME_HEADER_SIZE 16
+#define FRAME_FLAG_PACKBITS 0x01
+
+struct FrameInfo
+{
+    uint16_t x, y, width, height;
+    uint8_t flags;
+    uint32_t dataLength;
+};
+
+// Streaming decoder: hands out the image a band of rows at a time so the full
+// frame never exists uncompressed in RAM. Decodes from a caller buffer; writing the rows
+// to the panel is DisplayManager's job.
+class FrameDecoder
+{
+public:
+    /**
+     * Validate the header and position at the first row
+     * @param frame Complete frame (header + data)
+     * @param length Frame length in bytes
+     * @return false if the header is invalid or the data is truncated
+     */
+    bool begin(const uint8_t *frame, size_t length);
+
+    const FrameInfo &info() const { return frameInfo; }
+    int rowBytes() const { return frameInfo.width / 8; }
+    int rowsDecoded() const { return row; }
+
+    /**
+     * Decode the next rows
+     * @param band Output, at least maxRows * rowBytes() bytes
+     * @param maxRows Band height
+     * @return Rows written (0 once the frame is done), -1 if the data is corrupt
+     */
+    int decodeRows(uint8_t *band, int maxRows);
+
+    /**
+     * Start again from the first row (GxEPD2 writes the image twice for partial refresh)
+     */
+    void rewind();
+
+private:
+    const uint8_t *data = nullptr;
+    FrameInfo frameInfo = {};
+    size_t pos = 0;
+    int row = 0;
+    int runRemaining = 0; // Bytes left in the current PackBits run
+    bool runRepeats = false;
+    uint8_t runByte = 0;
+};
+
+// Frame encoder for the host renderer and tests
+class FrameCodec
+{
+public:
+    /**
+     * Worst-case encoded size for a frame (PackBits adds one byte per 128 literals)
+     */
+    static size_t maxEncodedSize(int width, int height);
+
+    /**
+     * Encode a packed 1bpp image
+     * @param image Rows of width / 8 bytes, 1 = white
+     * @param info Position and size; flags select compression, dataLength is filled in
+     * @param out Output buffer
+     * @param capacity Output capacity
+     * @return Bytes written, 0 if it doesn't fit
+     */
+    static size_t encode(const uint8_t *image, FrameInfo info, uint8_t *out, size_t capacity);
+
+    /**
+     * Encode a window of a larger packed 1bpp image
+     * @param image First byte of the window's top row
+     * @param stride Bytes per row of the larger image
+     */
+    static size_t encode(const uint8_t *image, size_t stride, FrameInfo info, uint8_t *out, size_t capacity);
+};
+
+#endif // FRAME_CODEC_H
@@ -0,0 +1,203 @@
+#include "gateway_protocol.h"
+#include "sun_times.h"
+#include <cstring>
+
+const uint8_t MAGIC_0 = 'T';
+const uint8_t MAGIC_1 = 'W';
+
+// Payload offsets (see gateway_protocol.h)
+const size_t HASHED_FROM = 8;
+const size_t HOURLY_OFFSET = 13;
+const size_t HOURLY_STRIDE = 4;
+const size_t DAILY_OFFSET = 37;
+const size_t DAILY_STRIDE = 6;
+
+static void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    put16(p, (uint16_t)v);
+    put16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return (uint32_t)get16(p) | ((uint32_t)get16(p + 2) << 16);
+}
+
+// FNV-1a, same as the gateway script
+static uint32_t payloadHash(const uint8_t *payload)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = HASHED_FROM; i < GATEWAY_PAYLOAD_SIZE; i++)
+    {
+        hash ^= payload[i];
+        hash *= 16777619u;
+    }
+    return (hash == 0) ? 1 : hash;
+}
+
+static void putHeader(uint8_t *buffer, GatewayMessageType type, uint16_t sequence, uint16_t payloadLength)
+{
+    buffer[0] = MAGIC_0;
+    buffer[1] = MAGIC_1;
+    buffer[2] = GATEWAY_VERSION;
+    buffer[3] = type;
+    put16(buffer + 4, sequence);
+    put16(buffer + 6, payloadLength);
+}
+
+static bool validHeader(const uint8_t *buffer, size_t length)
+{
+    return length >= GATEWAY_HEADER_SIZE && buffer[0] == MAGIC_0 && buffer[1] == MAGIC_1 &&
+           buffer[2] == GATEWAY_VERSION;
+}
+
+size_t GatewayProtocol::encodeRequest(const GatewayRequest &request, uint8_t *buffer)
+{
+    buffer[0] = MAGIC_0;
+    buffer[1] = MAGIC_1;
+    buffer[2] = GATEWAY_VERSION;
+    buffer[3] = GATEWAY_REQUEST;
+    put16(buffer + 4, request.sequence);
+    buffer[6] = (uint8_t)request.displayHour;
+    buffer[7] = 0;
+    put32(buffer + 8, (uint32_t)request.latitudeE4);
+    put32(buffer + 12, (uint32_t)request.longitudeE4);
+    put32(buffer + 16, request.knownHash);
+    return GATEWAY_REQUEST_SIZE;
+}
+
+bool GatewayProtocol::decodeRequest(const uint8_t *buffer, size_t length, GatewayRequest &request)
+{
+    if (length != GATEWAY_REQUEST_SIZE || !validHeader(buffer, length) || buffer[3] != GATEWAY_REQUEST)
+    {
+        return false;
+    }
+
+    request.sequence = get16(buffer + 4);
+    request.displayHour = (int8_t)buffer[6];
+    request.latitudeE4 = (int32_t)get32(buffer + 8);
+    request.longitudeE4 = (int32_t)get32(buffer + 12);
+    request.knownHash = get32(buffer + 16);
+    return true;
+}
+
+size_t GatewayProtocol::encodeResponse(GatewayMessageType type, uint16_t sequence, const WeatherData &weather, uint8_t *buffer)
+{
+    if (type != GATEWAY_WEATHER)
+    {
+        putHeader(buffer, type, sequence, 0);
+        return GATEWAY_HEADER_SIZE;
+    }
+
+    putHeader(buffer, type, sequence, GATEWAY_PAYLOAD_SIZE);
+    uint8_t *payload = buffer + GATEWAY_HEADER_SIZE;
+    put32(payload, (uint32_t)weather.lastUpdated);
+    put16(payload + 8, (uint16_t)weather.currentTemp);
+    payload[10] = weather.currentCondition;
+    payload[11] = (uint8_t)weather.humidity;
+    payload[12] = (uint8_t)weather.windSpeed;
+
+    for (int i = 0; i < 6; i++)
+    {
+        uint8_t *slot = payload + HOURLY_OFFSET + i * HOURLY_STRIDE;
+        slot[0] = (uint8_t)weather.hourly[i].hour;
+        put16(slot + 1, (uint16_t)weather.hourly[i].temp);
+        slot[3] = weather.hourly[i].condition;
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        uint8_t *slot = payload + DAILY_OFFSET + i * DAILY_STRIDE;
+        slot[0] = weather.daily[i].dayOfWeek;
+        put16(slot + 1, (uint16_t)weather.daily[i].tempHigh);
+        put16(slot + 3, (uint16_t)weather.daily[i].tempLow);
+        slot[5] = weather.daily[i].condition;
+    }
+
+    put32(payload + 4, payloadHash(payload));
+    return GATEWAY_MAX_RESPONSE_SIZE;
+}
+
+GatewayDecodeResult GatewayProtocol::decodeResponse(const uint8_t *buffer, size_t length, uint16_t expectedSequence,
+                                                    WeatherData &weather, uint32_t &contentHash)
+{
+    if (!validHeader(buffer, length))
+    {
+        return GATEWAY_DECODE_BAD_PACKET;
+    }
+
+    uint8_t type = buffer[3];
+    uint16_t payloadLength = get16(buffer + 6);
+    if (length != GATEWAY_HEADER_SIZE + (size_t)payloadLength)
+    {
+        return GATEWAY_DECODE_BAD_PACKET;
+    }
+    if (get16(buffer + 4) != expectedSequence)
+    {
+        return GATEWAY_DECODE_WRONG_SEQUENCE;
+    }
+
+    if (type == GATEWAY_NOT_MODIFIED && payloadLength == 0)
+    {
+        return GATEWAY_DECODE_NOT_MODIFIED;
+    }
+    if (type == GATEWAY_ERROR && payloadLength == 0)
+    {
+        return GATEWAY_DECODE_ERROR;
+    }
+    if (type != GATEWAY_WEATHER || payloadLength != GATEWAY_PAYLOAD_SIZE)
+    {
+        return GATEWAY_DECODE_BAD_PACKET;
+    }
+
+    const uint8_t *payload = buffer + GATEWAY_HEADER_SIZE;
+    uint32_t hash = get32(payload + 4);
+    if (hash != payloadHash(payload))
+    {
+        return GATEWAY_DECODE_BAD_PACKET;
+    }
+
+    weather.lastUpdated = (time_t)get32(payload);
+    weather.currentTemp = (int16_t)get16(payload + 8);
+    weather.currentCondition = (WeatherCondition)payload[10];
+    weather.humidity = payload[11];
+    weather.windSpeed = payload[12];
+
+    for (int i = 0; i < 6; i++)
+    {
+        const uint8_t *slot = payload + HOURLY_OFFSET + i * HOURLY_STRIDE;
+        weather.hourly[i].hour = slot[0];
+        weather.hourly[i].temp = (int16_t)get16(slot + 1);
+        weather.hourly[i].condition = (WeatherCondition)slot[3];
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        const uint8_t *slot = payload + DAILY_OFFSET + i * DAILY_STRIDE;
+        weather.daily[i].dayOfWeek = slot[0];
+        weather.daily[i].tempHigh = (int16_t)get16(slot + 1);
+        weather.daily[i].tempLow = (int16_t)get16(slot + 3);
+        weather.daily[i].condition = (WeatherCondition)slot[5];
+    }
+
+    contentHash = hash;
+    return GATEWAY_DECODE_WEATHER;
+}
+
+int32_t GatewayProtocol::parseCoordinateE4(const char *text)
+{
+    // Same digits the sun routine uses, rounded to four places without going through strtod
+    int32_t micro = SunTimes::parseMicroDegrees(text);
+    return (micro + (micro < 0 ? -50 : 50)) / 100;
+}
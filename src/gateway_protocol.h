@@ -0,0 +1,121 @@
+#ifndef GATEWAY_PROTOCOL_H
+#define GATEWAY_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include "types.h"
+
+// Compact UDP protocol between a panel and the LAN weather gateway (scripts/weather_gateway.py).
+// Every field is little-endian at a fixed offset; temperatures travel as tenths of a degree.
+//
+// Request (20 bytes)
+//   0  'T' 'W'   magic
+//   2  u8        version
+//   3  u8        type (GATEWAY_REQUEST)
+//   4  u16       sequence number, echoed in the response
+//   6  i8        display hour (hourly forecast starts at the next hour)
+//   7  u8        reserved (0)
+//   8  i32       latitude * 10000
+//   12 i32       longitude * 10000
+//   16 u32       content hash already on screen (0 = none)
+//
+// Response header (8 bytes), followed by the weather payload for GATEWAY_WEATHER
+//   0  'T' 'W'   magic
+//   2  u8        version
+//   3  u8        type (GATEWAY_WEATHER / GATEWAY_NOT_MODIFIED / GATEWAY_ERROR)
+//   4  u16       sequence number
+//   6  u16       payload length
+//
+// Weather payload (61 bytes)
+//   0  u32       fetched at (epoch seconds, gateway's upstream fetch)
+//   4  u32       content hash (FNV-1a of payload bytes 8..end)
+//   8  i16       current temp x10
+//   10 u8        current condition
+//   11 u8        humidity
+//   12 u8        wind speed
+//   13 6 x {u8 hour, i16 temp x10, u8 condition}
+//   37 4 x {u8 day of week, i16 high x10, i16 low x10, u8 condition}
+
+#define GATEWAY_VERSION 1
+#define GATEWAY_REQUEST_SIZE 20
+#define GATEWAY_HEADER_SIZE 8
+#define GATEWAY_PAYLOAD_SIZE 61
+#define GATEWAY_MAX_RESPONSE_SIZE (GATEWAY_HEADER_SIZE + GATEWAY_PAYLOAD_SIZE)
+
+enum GatewayMessageType : uint8_t
+{
+    GATEWAY_REQUEST = 1,
+    GATEWAY_WEATHER = 2,
+    GATEWAY_NOT_MODIFIED = 3, // Content hash in the request still matches
+    GATEWAY_ERROR = 4         // Gateway has no forecast for this location yet
+};
+
+// Result of decoding a response datagram
+enum GatewayDecodeResult : uint8_t
+{
+    GATEWAY_DECODE_WEATHER = 0,
+    GATEWAY_DECODE_NOT_MODIFIED,
+    GATEWAY_DECODE_ERROR,       // Well-formed error response from the gateway
+    GATEWAY_DECODE_BAD_PACKET,  // Wrong magic, version, size or unknown type
+    GATEWAY_DECODE_WRONG_SEQUENCE // Late reply to an earlier attempt
+};
+
+// Request fields before encoding
+struct GatewayRequest
+{
+    uint16_t sequence;
+    int8_t displayHour;
+    int32_t latitudeE4;
+    int32_t longitudeE4;
+    uint32_t knownHash;
+};
+
+// Encoding and decoding of gateway datagrams.
+// Byte layout only; the panel's UDP socket and scripts/weather_gateway.py share it.
+
+class GatewayProtocol
+{
+public:
+    /**
+     * Encode a request datagram
+     * @param request Request fields
+     * @param buffer Output, at least GATEWAY_REQUEST_SIZE bytes
+     * @return Bytes written
+     */
+    static size_t encodeRequest(const GatewayRequest &request, uint8_t *buffer);
+
+    /**
+     * Decode a request datagram (gateway side, used by the stand-in in tests)
+     * @return false if the datagram isn't a valid request
+     */
+    static bool decodeRequest(const uint8_t *buffer, size_t length, GatewayRequest &request);
+
+    /**
+     * Encode a response datagram
+     * @param type GATEWAY_WEATHER, GATEWAY_NOT_MODIFIED or GATEWAY_ERROR
+     * @param sequence Sequence number from the request
+     * @param weather Forecast (only read for GATEWAY_WEATHER)
+     * @param buffer Output, at least GATEWAY_MAX_RESPONSE_SIZE bytes
+     * @return Bytes written
+     */
+    static size_t encodeResponse(GatewayMessageType type, uint16_t sequence, const WeatherData &weather, uint8_t *buffer);
+
+    /**
+     * Decode a response datagram
+     * @param buffer Datagram
+     * @param length Datagram length
+     * @param expectedSequence Sequence number of the request being answered
+     * @param weather Output, only written for GATEWAY_DECODE_WEATHER
+     * @param contentHash Output, hash of the decoded forecast
+     * @return What the datagram contained
+     */
+    static GatewayDecodeResult decodeResponse(const uint8_t *buffer, size_t length, uint16_t expectedSequence,
+                                              WeatherData &weather, uint32_t &contentHash);
+
+    /**
+     * Coordinate string ("45.5152") to fixed point degrees x 10000
+     */
+    static int32_t parseCoordinateE4(const char *text);
+};
+
+#endif // GATEWAY_PROTOCOL_H
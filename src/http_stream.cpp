@@ -0,0 +1,323 @@
+#include "http_stream.h"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static bool headerIs(const char *line, const char *name, const char **value)
+{
+    size_t length = strlen(name);
+    for (size_t i = 0; i < length; i++)
+    {
+        if (tolower((unsigned char)line[i]) != tolower((unsigned char)name[i]))
+            return false;
+    }
+    if (line[length] != ':')
+        return false;
+
+    const char *v = line + length + 1;
+    while (*v == ' ' || *v == '\t')
+        v++;
+    *value = v;
+    return true;
+}
+
+static bool containsToken(const char *value, const char *token)
+{
+    // Case-insensitive substring match, enough for "chunked", "close" and "keep-alive"
+    size_t length = strlen(token);
+    for (const char *p = value; *p; p++)
+    {
+        size_t i = 0;
+        while (i < length && p[i] && tolower((unsigned char)p[i]) == token[i])
+            i++;
+        if (i == length)
+            return true;
+    }
+    return false;
+}
+
+static void copyValue(char *out, size_t size, const char *value)
+{
+    size_t length = strlen(value);
+    while (length > 0 && (value[length - 1] == ' ' || value[length - 1] == '\t'))
+        length--;
+    if (length >= size)
+        length = size - 1;
+    memcpy(out, value, length);
+    out[length] = '\0';
+}
+
+void HttpResponseReader::begin(bool headRequest)
+{
+    state = STATE_STATUS;
+    head = headRequest;
+    lineLength = 0;
+    lineTruncated = false;
+    statusCode = 0;
+    persistent = true;
+    chunked = false;
+    hasLength = false;
+    remaining = 0;
+    etagValue[0] = '\0';
+    lastModifiedValue[0] = '\0';
+}
+
+bool HttpResponseReader::lineComplete(char c)
+{
+    if (c == '\n')
+    {
+        if (lineLength > 0 && line[lineLength - 1] == '\r')
+            lineLength--;
+        line[lineLength] = '\0';
+        lineLength = 0;
+        return true;
+    }
+    if (lineLength < LINE_SIZE - 1)
+        line[lineLength++] = c;
+    else
+        lineTruncated = true;
+    return false;
+}
+
+void HttpResponseReader::statusLine()
+{
+    // "HTTP/1.1 200 OK"
+    if (strncmp(line, "HTTP/1.", 7) != 0 || line[8] != ' ')
+    {
+        state = STATE_FAILED;
+        return;
+    }
+    persistent = line[7] != '0'; // HTTP/1.0 closes unless it says keep-alive
+    statusCode = atoi(line + 9);
+    state = (statusCode >= 100 && statusCode <= 599) ? STATE_HEADERS : STATE_FAILED;
+}
+
+void HttpResponseReader::headerLine()
+{
+    const char *value = nullptr;
+    if (lineTruncated)
+    {
+        // Only long headers we don't use (cookies, CSP) get here
+        lineTruncated = false;
+        return;
+    }
+    if (headerIs(line, "Content-Length", &value))
+    {
+        hasLength = true;
+        remaining = strtoul(value, nullptr, 10);
+    }
+    else if (headerIs(line, "Transfer-Encoding", &value))
+    {
+        chunked = containsToken(value, "chunked");
+    }
+    else if (headerIs(line, "Connection", &value))
+    {
+        if (containsToken(value, "close"))
+            persistent = false;
+        else if (containsToken(value, "keep-alive"))
+            persistent = true;
+    }
+    else if (headerIs(line, "ETag", &value))
+    {
+        copyValue(etagValue, sizeof(etagValue), value);
+    }
+    else if (headerIs(line, "Last-Modified", &value))
+    {
+        copyValue(lastModifiedValue, sizeof(lastModifiedValue), value);
+    }
+}
+
+void HttpResponseReader::headersDone()
+{
+    if (statusCode < 200)
+    {
+        // Interim response (100 Continue); the real one follows on the same connection
+        state = STATE_STATUS;
+        return;
+    }
+    if (head || statusCode == 204 || statusCode == 304)
+    {
+        state = STATE_DONE;
+    }
+    else if (chunked)
+    {
+        state = STATE_CHUNK_SIZE;
+    }
+    else if (hasLength)
+    {
+        state = (remaining == 0) ? STATE_DONE : STATE_BODY_LENGTH;
+    }
+    else
+    {
+        // No framing: the body runs until the server closes, so nothing can follow it
+        persistent = false;
+        state = STATE_BODY_CLOSE;
+    }
+}
+
+size_t HttpResponseReader::feed(const char *data, size_t length, HttpBodySink sink, void *context)
+{
+    size_t i = 0;
+    while (i < length && state != STATE_DONE && state != STATE_FAILED)
+    {
+        switch (state)
+        {
+        case STATE_STATUS:
+            if (lineComplete(data[i++]))
+            {
+                if (line[0] != '\0') // Stray CRLF between pipelined responses
+                    statusLine();
+            }
+            break;
+
+        case STATE_HEADERS:
+            if (lineComplete(data[i++]))
+            {
+                if (line[0] == '\0')
+                    headersDone();
+                else
+                    headerLine();
+            }
+            break;
+
+        case STATE_BODY_LENGTH:
+        case STATE_CHUNK_DATA:
+        {
+            size_t n = length - i < remaining ? length - i : remaining;
+            sink(context, data + i, n);
+            i += n;
+            remaining -= n;
+            if (remaining == 0)
+                state = (state == STATE_CHUNK_DATA) ? STATE_CHUNK_END : STATE_DONE;
+            break;
+        }
+
+        case STATE_BODY_CLOSE:
+            sink(context, data + i, length - i);
+            i = length;
+            break;
+
+        case STATE_CHUNK_SIZE:
+            if (lineComplete(data[i++]))
+            {
+                // "1a2b" or "1a2b;extension"
+                char *end = nullptr;
+                remaining = strtoul(line, &end, 16);
+                if (end == line)
+                    state = STATE_FAILED;
+                else
+                    state = (remaining == 0) ? STATE_TRAILERS : STATE_CHUNK_DATA;
+            }
+            break;
+
+        case STATE_CHUNK_END:
+            if (lineComplete(data[i++]))
+                state = (line[0] == '\0') ? STATE_CHUNK_SIZE : STATE_FAILED;
+            break;
+
+        case STATE_TRAILERS:
+            if (lineComplete(data[i++]) && line[0] == '\0')
+                state = STATE_DONE;
+            break;
+
+        default:
+            break;
+        }
+    }
+    return i;
+}
+
+bool HttpResponseReader::closed()
+{
+    if (state == STATE_BODY_CLOSE)
+    {
+        state = STATE_DONE;
+    }
+    else if (state != STATE_DONE)
+    {
+        state = STATE_FAILED;
+    }
+    persistent = false;
+    return state == STATE_DONE;
+}
+
+const char *HttpRequest::splitUrl(const char *url, char *host, size_t hostSize, uint16_t &port, bool &secure)
+{
+    const char *rest;
+    if (strncmp(url, "https://", 8) == 0)
+    {
+        secure = true;
+        port = 443;
+        rest = url + 8;
+    }
+    else if (strncmp(url, "http://", 7) == 0)
+    {
+        secure = false;
+        port = 80;
+        rest = url + 7;
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    const char *path = strchr(rest, '/');
+    const char *hostEnd = path ? path : rest + strlen(rest);
+    const char *colon = (const char *)memchr(rest, ':', hostEnd - rest);
+    if (colon)
+    {
+        port = (uint16_t)atoi(colon + 1);
+        hostEnd = colon;
+    }
+
+    size_t length = hostEnd - rest;
+    if (length == 0 || length >= hostSize || port == 0)
+    {
+        return nullptr;
+    }
+    memcpy(host, rest, length);
+    host[length] = '\0';
+    return path ? path : "/";
+}
+
+size_t HttpRequest::formatGet(char *out, size_t size, const char *host, const char *path, const char *query,
+                              const char *ifNoneMatch, const char *ifModifiedSince)
+{
+    int n = snprintf(out, size,
+                     "GET %s%s HTTP/1.1\r\n"
+                     "Host: %s\r\n"
+                     "Connection: keep-alive\r\n"
+                     "Accept-Encoding: identity\r\n",
+                     path, query ? query : "", host);
+    if (ifNoneMatch && ifNoneMatch[0] != '\0' && n >= 0 && (size_t)n < size)
+        n += snprintf(out + n, size - n, "If-None-Match: %s\r\n", ifNoneMatch);
+    if (ifModifiedSince && ifModifiedSince[0] != '\0' && n >= 0 && (size_t)n < size)
+        n += snprintf(out + n, size - n, "If-Modified-Since: %s\r\n", ifModifiedSince);
+    if (n >= 0 && (size_t)n < size)
+        n += snprintf(out + n, size - n, "\r\n");
+
+    if (n < 0 || (size_t)n >= size)
+    {
+        return 0;
+    }
+    return (size_t)n;
+}
+
+size_t HttpRequest::formatPost(char *out, size_t size, const char *host, const char *path, const char *contentType,
+                               size_t contentLength)
+{
+    int n = snprintf(out, size,
+                     "POST %s HTTP/1.1\r\n"
+                     "Host: %s\r\n"
+                     "Connection: keep-alive\r\n"
+                     "Content-Type: %s\r\n"
+                     "Content-Length: %u\r\n"
+                     "\r\n",
+                     path, host, contentType, (unsigned)contentLength);
+    if (n < 0 || (size_t)n >= size)
+    {
+        return 0;
+    }
+    return (size_t)n;
+}
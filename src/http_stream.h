@@ -0,0 +1,135 @@
+#ifndef HTTP_STREAM_H
+#define HTTP_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Called with each piece of response body as it is framed
+typedef void (*HttpBodySink)(void *context, const char *data, size_t length);
+
+// Incremental HTTP/1.1 response framing for a kept-alive connection. Stops exactly at the
+// end of one response, so several requests can be pipelined on one socket and their
+// responses read back to back. Handles Content-Length, chunked and read-until-close bodies.
+// Reads bytes the caller hands it, never the socket, so tests split responses anywhere.
+
+class HttpResponseReader
+{
+public:
+    /**
+     * Start reading the next response on the connection
+     * @param headRequest true if the request was HEAD (no body follows)
+     */
+    void begin(bool headRequest = false);
+
+    /**
+     * Frame the next bytes from the connection
+     * @param data Bytes received
+     * @param length Byte count
+     * @param sink Receives body bytes (after chunk framing is removed)
+     * @param context Passed to sink
+     * @return Bytes consumed; less than length once the response is complete - the rest
+     *         belongs to the next pipelined response
+     */
+    size_t feed(const char *data, size_t length, HttpBodySink sink, void *context);
+
+    /**
+     * The server closed the connection
+     * @return true if that completes the response (body delimited by close)
+     */
+    bool closed();
+
+    bool done() const { return state == STATE_DONE; }
+    bool failed() const { return state == STATE_FAILED; }
+    int status() const { return statusCode; }
+
+    /**
+     * Whether the connection can carry another request after this response
+     */
+    bool keepAlive() const { return persistent && state == STATE_DONE; }
+
+    const char *etag() const { return etagValue; }
+    const char *lastModified() const { return lastModifiedValue; }
+
+private:
+    static const int LINE_SIZE = 96;
+
+    enum State : uint8_t
+    {
+        STATE_STATUS,
+        STATE_HEADERS,
+        STATE_BODY_LENGTH,
+        STATE_BODY_CLOSE,
+        STATE_CHUNK_SIZE,
+        STATE_CHUNK_DATA,
+        STATE_CHUNK_END,
+        STATE_TRAILERS,
+        STATE_DONE,
+        STATE_FAILED
+    };
+
+    bool lineComplete(char c);
+    void statusLine();
+    void headerLine();
+    void headersDone();
+
+    State state = STATE_STATUS;
+    bool head = false;
+    char line[LINE_SIZE];
+    int lineLength = 0;
+    bool lineTruncated = false;
+
+    int statusCode = 0;
+    bool persistent = true;
+    bool chunked = false;
+    bool hasLength = false;
+    size_t remaining = 0;
+    char etagValue[64];
+    char lastModifiedValue[32];
+};
+
+// Request side of the same connection.
+// Formats into a caller buffer; sending is the caller's job.
+
+class HttpRequest
+{
+public:
+    /**
+     * Split an http:// or https:// URL
+     * @param url Absolute URL
+     * @param host Output host name
+     * @param hostSize Room in host
+     * @param port Output port (default for the scheme if none given)
+     * @param secure Output true for https
+     * @return Path and query ("/" if none), or nullptr if the URL can't be used
+     */
+    static const char *splitUrl(const char *url, char *host, size_t hostSize, uint16_t &port, bool &secure);
+
+    /**
+     * Format a keep-alive GET
+     * @param out Output buffer
+     * @param size Room in out
+     * @param host Host header
+     * @param path Path and query
+     * @param query Appended to path as is (may be nullptr)
+     * @param ifNoneMatch ETag to revalidate (nullptr or "" = none)
+     * @param ifModifiedSince Last-Modified to revalidate (nullptr or "" = none)
+     * @return Request length, 0 if it doesn't fit
+     */
+    static size_t formatGet(char *out, size_t size, const char *host, const char *path, const char *query,
+                            const char *ifNoneMatch, const char *ifModifiedSince);
+
+    /**
+     * Format the head of a keep-alive POST; the body is sent after it
+     * @param out Output buffer
+     * @param size Room in out
+     * @param host Host header
+     * @param path Path and query
+     * @param contentType Content-Type header
+     * @param contentLength Body length in bytes
+     * @return Head length, 0 if it doesn't fit
+     */
+    static size_t formatPost(char *out, size_t size, const char *host, const char *path, const char *contentType,
+                             size_t contentLength);
+};
+
+#endif // HTTP_STREAM_H
@@ -1,9 +1,20 @@
 #include <Arduino.h>
 #include <cstdlib>
+#include <cstring>
+#include <esp_system.h>
 #include "config.h"
 #include "display.h"
 #include "network.h"
 #include "wake_logic.h"
+#include "power_governor.h"
+#include "fetch_cache.h"
+#include "forecast_stream.h"
+#include "sun_times.h"
+#include "text_format.h"
+#include "warm_store.h"
+#include "boot_guard.h"
+#include "ota_update.h"
+#include "telemetry.h"
 
 // Disable watchdog timers to prevent early resets during init
 extern "C"
@@ -15,9 +26,353 @@ extern "C"
 RTC_DATA_ATTR time_t lastWeatherUpdate = 0;
 RTC_DATA_ATTR bool isFirstBoot = true;
 RTC_DATA_ATTR int lastDisplayedDay = -1; // Track last displayed day to detect midnight transitions
+RTC_DATA_ATTR int lastDisplayedBattery = -1; // Battery percent currently on screen
+RTC_DATA_ATTR PowerGovernorState powerState = {};
+RTC_DATA_ATTR WeatherData parkedWeather = {}; // Prefetched forecast waiting for the next clock update
+RTC_DATA_ATTR bool hasParkedWeather = false;
+RTC_DATA_ATTR time_t parkedBoundary = 0; // Boundary the parked forecast is shown at
+RTC_DATA_ATTR bool prefetchWakePending = false; // Next wake is an off-phase weather prefetch
+RTC_DATA_ATTR RenderedWeather renderedWeather = {}; // Weather values currently on the panel
+RTC_DATA_ATTR FetchCacheState fetchCache = {}; // Validators and content hash of the forecast on screen
+RTC_DATA_ATTR uint32_t shownFrameHash = 0; // Hash of the server-rendered pane on screen (0 = none)
+RTC_DATA_ATTR SunDay sunToday = {}; // Sunrise/sunset for the local day, computed once a day
+RTC_DATA_ATTR RefreshLedgerState refreshLedger = {}; // Ghosting per panel region since its last full-waveform refresh
+RTC_NOINIT_ATTR BootGuardState bootGuard; // Survives crash and brownout resets, see boot_guard.h
+RTC_DATA_ATTR TelemetryRing telemetry = {}; // Wake metrics waiting for the next upload
+RTC_DATA_ATTR uint32_t otaFailedVersion = 0; // Announced firmware whose patch didn't apply; not retried
+#if WEATHER_STREAMED_FETCH
+RTC_DATA_ATTR LocationForecast carousel[WEATHER_MAX_LOCATIONS] = {}; // Compact forecast per location
+RTC_DATA_ATTR int carouselCount = 0;
+RTC_DATA_ATTR time_t carouselFetchedAt = 0;
+#endif
+
+// Subsystems the boot guard allows this wake
+BootPlan bootPlan = {SUBSYSTEM_ALL, false};
+
+// This wake's metrics, added to the telemetry ring just before sleep
+WakeMetrics wakeMetrics = {};
+uint32_t wakeStartedMs = 0;
+
+// Active power policy for this wake (refreshed every wake, used for sleep calculation)
+PowerPolicy activePolicy = PowerGovernor::policyFor(POWER_NORMAL);
 
 DisplayManager display;
 NetworkManager network;
+WarmStore warmStore;
+
+#if RENDER_FRAME_ENABLED
+static uint8_t frameBuffer[RENDER_FRAME_MAX_BYTES]; // Downloaded or restored pane
+#endif
+
+// "full" frames carry the clock, so they go out on the boundary's clock wake instead of a prefetch wake
+#define FRAME_HAS_CLOCK (RENDER_FRAME_ENABLED && strcmp(RENDER_FRAME_PANE, "full") == 0)
+
+// Recompute sunrise/sunset when the local day changes - no fetch, a few thousand integer ops
+void updateSunTimes(const struct tm &timeinfo)
+{
+    int32_t dayKey = (timeinfo.tm_year + 1900) * 1000 + timeinfo.tm_yday;
+    if (sunToday.dayKey != dayKey)
+    {
+        struct tm noonInfo = timeinfo;
+        noonInfo.tm_hour = 12;
+        noonInfo.tm_min = 0;
+        noonInfo.tm_sec = 0;
+        SunTimes::compute(SunTimes::parseMicroDegrees(WEATHER_LATITUDE), SunTimes::parseMicroDegrees(WEATHER_LONGITUDE),
+                          mktime(&noonInfo), sunToday);
+        sunToday.dayKey = dayKey;
+        Serial.printf("Daylight today: %d minutes\n", SunTimes::dayLengthMinutes(sunToday));
+    }
+    display.setSunTimes(sunToday);
+}
+
+// Reset reason as the boot guard sees it
+BootCause bootCause()
+{
+    switch (esp_reset_reason())
+    {
+    case ESP_RST_DEEPSLEEP:
+        return BOOT_DEEP_SLEEP;
+    case ESP_RST_SW:
+        return BOOT_RESTART;
+    case ESP_RST_PANIC:
+    case ESP_RST_INT_WDT:
+    case ESP_RST_TASK_WDT:
+    case ESP_RST_WDT:
+        return BOOT_CRASH;
+    case ESP_RST_BROWNOUT:
+        return BOOT_BROWNOUT;
+    default:
+        return BOOT_POWER_ON;
+    }
+}
+
+// Connect WiFi and sync time ahead of a weather or frame fetch
+void connectForFetch()
+{
+    if (!BootGuard::allowed(bootPlan, SUBSYSTEM_RADIO))
+    {
+        return;
+    }
+
+    // Connect WiFi and sync time for accurate weather fetch and future cycles
+    uint32_t started = millis();
+    if (!network.isConnected())
+    {
+        network.connectWiFi(WIFI_SSID, WIFI_PASSWORD);
+    }
+
+    if (network.isConnected())
+    {
+        Serial.println("Syncing time for accurate weather fetch...");
+        if (!network.syncTime())
+        {
+            Serial.println("Time sync failed, continuing with current time");
+        }
+        wakeMetrics.rssi = (int8_t)network.rssi();
+    }
+    Telemetry::addMs(wakeMetrics.radioMs, millis() - started);
+}
+
+// Connect WiFi, sync time and fetch weather for display at displayTime (0 = now)
+FetchResult fetchWeatherNow(WeatherData &weather, time_t displayTime)
+{
+    connectForFetch();
+
+    Serial.println("Fetching weather...");
+    uint32_t started = millis();
+    weather = {};
+#if WEATHER_STREAMED_FETCH
+    // Every location comes back in one response; the pane shows the one due at displayTime
+    int count = carouselCount;
+    FetchResult result = network.fetchLocations(carousel, WEATHER_MAX_LOCATIONS, count, fetchCache, displayTime);
+    if (result == FETCH_UPDATED)
+    {
+        carouselCount = count;
+        carouselFetchedAt = time(nullptr);
+        time_t shownAt = displayTime ? displayTime : carouselFetchedAt;
+        int slot = WeatherCarousel::slotAt(shownAt, carouselCount, WEATHER_CAROUSEL_SECONDS);
+        WeatherCarousel::expand(carousel[slot], slot, carouselFetchedAt, weather);
+    }
+#else
+    FetchResult result = network.fetchWeather(weather, fetchCache, displayTime);
+#endif
+    Telemetry::addMs(wakeMetrics.fetchMs, millis() - started);
+    wakeMetrics.fetch = result + 1;
+    return result;
+}
+
+#if RENDER_FRAME_ENABLED
+// Server renders the pane: fetch the frame for displayTime and stream it to the panel.
+// FETCH_UPDATED only if something was drawn.
+FetchResult showServerFrame(time_t displayTime)
+{
+    uint8_t *frame = frameBuffer;
+
+    connectForFetch();
+    if (displayTime == 0)
+    {
+        displayTime = time(nullptr);
+    }
+
+    size_t length = 0;
+    uint32_t started = millis();
+    FetchResult result =
+        network.fetchFrame(RENDER_FRAME_PANE, displayTime, shownFrameHash, frame, sizeof(frameBuffer), length);
+    Telemetry::addMs(wakeMetrics.fetchMs, millis() - started);
+    wakeMetrics.fetch = result + 1;
+    if (result != FETCH_UPDATED)
+    {
+        return result; // Not modified: the pane would come out identical
+    }
+
+#if RENDER_FRAME_DELTA
+    if (!display.drawFrameDelta(frame, length, shownFrameHash))
+    {
+        shownFrameHash = 0; // Next request gets the whole pane
+        return FETCH_FAILED;
+    }
+    TileDeltaReader reader;
+    reader.begin(frame, length);
+    shownFrameHash = reader.newHash();
+#if WARM_RESTORE_ENABLED
+    if (reader.baseHash() == 0)
+    {
+        warmStore.savePane(frame, length); // Whole pane, restorable without a base image
+    }
+#endif
+#else
+    if (!display.drawFrame(frame, length))
+    {
+        return FETCH_FAILED;
+    }
+#if WARM_RESTORE_ENABLED
+    warmStore.savePane(frame, length);
+#endif
+#endif
+
+    // Pane no longer matches anything the local renderer drew
+    renderedWeather.valid = false;
+    return FETCH_UPDATED;
+}
+
+// A "full" frame covers the whole screen but has no battery or daylight line: put them back
+void redrawAroundFullFrame(const struct tm &timeinfo, int batteryX10)
+{
+    display.partialUpdateDate(timeinfo.tm_wday, timeinfo.tm_mon, timeinfo.tm_mday, timeinfo.tm_year + 1900);
+    lastDisplayedDay = timeinfo.tm_mday;
+    display.updateBattery(batteryX10);
+    lastDisplayedBattery = TextFormat::roundTenths(batteryX10);
+}
+#endif
+
+// Per-device prefetch slot seed from the factory MAC; readable without the radio
+uint32_t staggerSeed()
+{
+    uint64_t efuse = ESP.getEfuseMac();
+    uint8_t mac[6];
+    for (int i = 0; i < 6; i++)
+    {
+        mac[i] = (uint8_t)(efuse >> (8 * i));
+    }
+    return WakeLogic::staggerSeed(mac);
+}
+
+// Off-phase wake: radio work only, the panel is left alone.
+// The result is parked in RTC memory and drawn with the first clock update at its boundary.
+void prefetchWeather()
+{
+    time_t currentTime;
+    time(&currentTime);
+    // The staggered slot can be up to WEATHER_STAGGER_MINUTES ahead of the usual lead
+    time_t boundary =
+        WakeLogic::weatherBoundary(currentTime + WEATHER_PREFETCH_LEAD_SECONDS + WEATHER_STAGGER_MINUTES * 60);
+
+#if RENDER_FRAME_ENABLED
+    // A frame is too big to park in RTC memory, so it goes straight to the panel.
+    // It is rendered for the boundary time; only the weather pane refreshes ("full" frames
+    // never get here, see FRAME_HAS_CLOCK).
+    Serial.println("Prefetch wake - fetching server frame for the boundary...");
+    if (showServerFrame(boundary) != FETCH_FAILED)
+    {
+        lastWeatherUpdate = boundary;
+    }
+    else
+    {
+        Serial.println("Frame fetch failed - will retry off-phase next minute");
+    }
+    return;
+#endif
+
+    Serial.println("Prefetch wake - fetching weather ahead of the boundary...");
+    FetchResult result = fetchWeatherNow(parkedWeather, boundary);
+    if (result == FETCH_UPDATED)
+    {
+        Serial.println("Weather parked for the boundary's clock update");
+        hasParkedWeather = true;
+        parkedBoundary = boundary;
+    }
+    else if (result == FETCH_NOT_MODIFIED)
+    {
+        // Screen already shows this forecast - just move the schedule on
+        Serial.println("Weather unchanged - nothing to park");
+        lastWeatherUpdate = boundary;
+    }
+    else
+    {
+        Serial.println("Weather prefetch failed - will retry off-phase next minute");
+    }
+}
+
+#if TELEMETRY_ENABLED
+// Post the wakes recorded since the last upload. Only called with the radio already up for
+// weather, so telemetry never costs a connection of its own.
+void uploadTelemetry()
+{
+    if (!network.isConnected() || telemetry.count == 0)
+    {
+        return;
+    }
+    static uint8_t batch[TELEMETRY_BATCH_MAX];
+    uint8_t mac[6];
+    network.macAddress(mac);
+    int records;
+    size_t length = Telemetry::encode(telemetry, mac, batch, sizeof(batch), records);
+    if (length > 0 && network.postTelemetry(batch, length))
+    {
+        Serial.printf("Telemetry: %d wake(s) uploaded in %u bytes (%u unpacked)\n", records, (unsigned)length,
+                      (unsigned)(records * sizeof(WakeMetrics)));
+        Telemetry::acknowledge(telemetry, records);
+    }
+}
+
+// Close this wake's metrics into the RTC ring
+void recordWake()
+{
+    uint32_t awake = millis() - wakeStartedMs;
+    time_t now = time(nullptr);
+    wakeMetrics.startedAt = now > 1577836800 ? (uint32_t)(now - awake / 1000) : 0; // Unset before 2020
+    Telemetry::addMs(wakeMetrics.awakeMs, awake);
+    Telemetry::addMs(wakeMetrics.refreshMs, display.refreshMillis());
+    wakeMetrics.refreshes = (uint8_t)min(display.refreshCount(), 255);
+    wakeMetrics.retries = (uint8_t)min(network.retries(), 255);
+    if (wakeMetrics.batteryX10 == 0)
+    {
+        wakeMetrics.batteryX10 = network.readDeviceBattery(); // Prefetch wakes don't read it otherwise
+    }
+    Telemetry::record(telemetry, wakeMetrics);
+
+    // DEBUG_NO_SLEEP runs the next wake in this loop
+    wakeMetrics = {};
+    wakeStartedMs = millis();
+}
+#endif
+
+#if OTA_ENABLED
+// Ask the update server for newer firmware while the radio is up for weather, and patch the
+// running image into the other app partition as the delta downloads. Restarts on success.
+void checkFirmwareUpdate()
+{
+    if (!network.isConnected())
+    {
+        return;
+    }
+    int battery = network.readDeviceBattery() / 10;
+    if (battery < OTA_MIN_BATTERY)
+    {
+        Serial.printf("Battery at %d%% - not checking for updates\n", battery);
+        return;
+    }
+
+    OtaManifest manifest;
+    if (!network.fetchOtaManifest(manifest) || manifest.version <= FIRMWARE_VERSION ||
+        manifest.version == otaFailedVersion)
+    {
+        return;
+    }
+    Serial.printf("Firmware %u available (running %u), patch %u bytes\n", (unsigned)manifest.version,
+                  (unsigned)FIRMWARE_VERSION, (unsigned)manifest.patchSize);
+
+    uint32_t started = millis();
+    static OtaUpdate update;
+    if (!update.begin())
+    {
+        return;
+    }
+    bool received = network.fetchOtaPatch(manifest, OtaUpdate::sink, &update);
+    if (!update.finish(received, manifest))
+    {
+        // A download cut short is retried next time; a patch that doesn't fit this image isn't
+        otaFailedVersion = received ? manifest.version : 0;
+        return;
+    }
+
+    Serial.printf("Firmware %u installed in %lu ms - restarting\n", (unsigned)manifest.version,
+                  (unsigned long)(millis() - started));
+    Serial.flush();
+    network.disconnectWiFi();
+    esp_restart(); // A restart, not a crash, to the boot guard
+}
+#endif
 
 // Common update logic used by both first boot and regular wakes
 void performUpdates()
@@ -27,6 +382,73 @@ void performUpdates()
     struct tm timeinfo;
     time(&currentTime);
     localtime_r(&currentTime, &timeinfo);
+    updateSunTimes(timeinfo);
+
+    // Battery is read first so a combined refresh can redraw it
+    int batteryX10 = network.readDeviceBattery();
+    wakeMetrics.batteryX10 = batteryX10;
+
+    // Feed the battery trend to the power governor and pick this wake's policy
+    if (powerState.startTime == 0 || currentTime < powerState.startTime)
+    {
+        PowerGovernor::reset(powerState, currentTime);
+    }
+    PowerGovernor::recordSample(powerState, currentTime, batteryX10, POWER_SAMPLE_INTERVAL);
+    PowerLevel previousLevel = (PowerLevel)powerState.level;
+    PowerLevel level = PowerGovernor::update(powerState, currentTime, POWER_TARGET_RUNTIME_HOURS);
+    activePolicy = PowerGovernor::policyFor(level);
+    if (level != previousLevel)
+    {
+        int rateX10 = PowerGovernor::dischargeRateX10(powerState);
+        Serial.printf("Power level changed %d -> %d (drain %d.%d%%/h)\n", previousLevel, level, rateX10 / 10, abs(rateX10 % 10));
+    }
+
+    int shownBattery = TextFormat::roundTenths(batteryX10);
+
+    // A staggered prefetch parks its forecast minutes early; it still goes out at the boundary
+    bool parkedDue = hasParkedWeather && currentTime >= parkedBoundary;
+
+    // Carousel turn: the next location's forecast is already in RTC memory, no fetch needed
+    bool carouselTurn = false;
+    WeatherData turnWeather = {};
+#if WEATHER_CAROUSEL && WEATHER_STREAMED_FETCH
+    if (!isFirstBoot && !parkedDue && carouselCount > 1 && renderedWeather.valid)
+    {
+        int slot = WeatherCarousel::slotAt(currentTime, carouselCount, WEATHER_CAROUSEL_SECONDS);
+        if (slot != renderedWeather.location)
+        {
+            WeatherCarousel::expand(carousel[slot], slot, carouselFetchedAt, turnWeather);
+            carouselTurn = true;
+        }
+    }
+#endif
+
+    // A "full" frame is rendered for the boundary minute, so it is fetched on that clock wake
+    bool frameShown = false;
+#if RENDER_FRAME_ENABLED
+    if (FRAME_HAS_CLOCK && !isFirstBoot && !WakeLogic::isFirstBoot(lastWeatherUpdate) &&
+        BootGuard::allowed(bootPlan, SUBSYSTEM_WEATHER) &&
+        WakeLogic::shouldUpdateWeather(currentTime, lastWeatherUpdate,
+                                       FetchCache::adaptiveInterval(fetchCache, activePolicy.weatherIntervalSeconds,
+                                                                    WEATHER_MAX_INTERVAL)))
+    {
+        Serial.println("Boundary clock wake - fetching full server frame...");
+        FetchResult result = showServerFrame(currentTime);
+        if (result != FETCH_FAILED)
+        {
+            lastWeatherUpdate = WakeLogic::weatherBoundary(currentTime);
+        }
+        else
+        {
+            Serial.println("Frame fetch failed - will retry on the next clock wake");
+        }
+        if (result == FETCH_UPDATED)
+        {
+            redrawAroundFullFrame(timeinfo, batteryX10);
+            frameShown = true;
+        }
+    }
+#endif
 
     // On fresh boot, do full display update; otherwise partial updates
     if (isFirstBoot)
@@ -37,6 +459,31 @@ void performUpdates()
         lastDisplayedDay = timeinfo.tm_mday;
         isFirstBoot = false;
     }
+    else if (frameShown)
+    {
+        // Clock and date came with the frame
+        Serial.printf("Clock and frame updated: %02d:%02d:%02d\n", timeinfo.tm_hour, timeinfo.tm_min,
+                      timeinfo.tm_sec);
+    }
+    else if (parkedDue || carouselTurn)
+    {
+        // Prefetched weather (or the next carousel location) goes out in the same refresh as the new minute
+        display.updateClockAndWeather(timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_wday, timeinfo.tm_mon,
+                                      timeinfo.tm_mday, timeinfo.tm_year + 1900, batteryX10,
+                                      parkedDue ? parkedWeather : turnWeather, renderedWeather);
+        Serial.printf("Clock and %s weather updated: %02d:%02d:%02d\n", parkedDue ? "parked" : "carousel",
+                      timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
+
+        if (parkedDue)
+        {
+#if WARM_RESTORE_ENABLED
+            warmStore.saveForecast(parkedWeather);
+#endif
+            lastWeatherUpdate = parkedBoundary;
+            hasParkedWeather = false;
+        }
+        lastDisplayedDay = timeinfo.tm_mday;
+    }
     else
     {
         // Regular partial updates on wake from sleep
@@ -54,58 +501,53 @@ void performUpdates()
         }
     }
 
-    // Battery and weather updates happen every cycle regardless of boot state
-    float batteryPercent = network.readDeviceBattery();
-    display.updateBattery(batteryPercent);
-
-    // Update weather if needed (every 30 minutes)
-    if (WakeLogic::shouldUpdateWeather(currentTime, lastWeatherUpdate, WEATHER_UPDATE_INTERVAL))
+    // Only redraw the battery when the shown value moves by the policy's step
+    if (lastDisplayedBattery < 0 || abs(shownBattery - lastDisplayedBattery) >= activePolicy.batteryRedrawStep)
     {
-        Serial.println("Weather update needed - connecting WiFi...");
+        display.updateBattery(batteryX10);
+        lastDisplayedBattery = shownBattery;
+    }
 
-        // Connect WiFi and sync time for accurate weather fetch and future cycles
-        if (!network.isConnected())
-        {
-            network.connectWiFi(WIFI_SSID, WIFI_PASSWORD);
-        }
+    // Regions over their ghosting budget get a full-waveform refresh of their own rectangle
+    display.cleanupGhosting(timeinfo.tm_hour);
 
-        if (network.isConnected())
+    // The first fetch after boot happens inline; later ones come from off-phase prefetch wakes
+    if (WakeLogic::isFirstBoot(lastWeatherUpdate) && BootGuard::allowed(bootPlan, SUBSYSTEM_WEATHER))
+    {
+        Serial.println("Initial weather needed - connecting WiFi...");
+
+#if RENDER_FRAME_ENABLED
+        FetchResult result = showServerFrame(0);
+        if (result != FETCH_FAILED)
         {
-            Serial.println("Syncing time for accurate weather fetch...");
-            if (network.syncTime())
-            {
-                // Re-read current time after successful sync
-                time(&currentTime);
-                localtime_r(&currentTime, &timeinfo);
-            }
-            else
+            if (FRAME_HAS_CLOCK && result == FETCH_UPDATED)
             {
-                Serial.println("Time sync failed, continuing with current time");
+                redrawAroundFullFrame(timeinfo, batteryX10);
             }
+            time(&currentTime);
+            lastWeatherUpdate = WakeLogic::weatherBoundary(currentTime);
         }
+        else
+        {
+            Serial.println("Frame fetch failed - will retry on next cycle");
+        }
+        return;
+#endif
 
-        Serial.println("Fetching weather...");
         WeatherData weather = {};
-        if (network.fetchWeather(weather))
+        if (fetchWeatherNow(weather, 0) == FETCH_UPDATED)
         {
             Serial.println("Weather updated!");
-            display.updateWeather(weather);
+            display.updateWeather(weather, renderedWeather);
+            Serial.printf("Fresh forecast on screen %lu ms after wake\n", millis());
+#if WARM_RESTORE_ENABLED
+            warmStore.saveForecast(weather);
+#endif
 
             // Only update the timestamp if fetch succeeded
             // Set lastWeatherUpdate to nearest :00 or :30 boundary
-            // This aligns all future updates to :00 and :30 marks, naturally re-rendering hourly forecast
-            struct tm updateTime;
-            localtime_r(&currentTime, &updateTime);
-            if (updateTime.tm_min < 30)
-            {
-                updateTime.tm_min = 0;
-            }
-            else
-            {
-                updateTime.tm_min = 30;
-            }
-            updateTime.tm_sec = 0;
-            lastWeatherUpdate = mktime(&updateTime);
+            time(&currentTime);
+            lastWeatherUpdate = WakeLogic::weatherBoundary(currentTime);
         }
         else
         {
@@ -114,6 +556,38 @@ void performUpdates()
     }
 }
 
+#if WARM_RESTORE_ENABLED
+// Fresh boot: put the last pane back from flash before WiFi and time sync. Its fetch time is
+// in the pane's "last updated" stamp, so it reads as old until the first fetch replaces it.
+bool restoreWarmState()
+{
+#if RENDER_FRAME_ENABLED
+    size_t length = 0;
+    if (!warmStore.loadPane(frameBuffer, sizeof(frameBuffer), length))
+    {
+        return false;
+    }
+    // shownFrameHash stays 0, so the first fetch asks for the whole pane and refreshes the copy
+    TileDeltaReader reader;
+    bool drawn = reader.begin(frameBuffer, length) ? display.drawFrameDelta(frameBuffer, length, 0)
+                                                   : display.drawFrame(frameBuffer, length);
+#else
+    WeatherData weather;
+    if (!warmStore.loadForecast(weather))
+    {
+        return false;
+    }
+    display.updateWeather(weather, renderedWeather);
+    bool drawn = true;
+#endif
+    if (drawn)
+    {
+        Serial.printf("Warm restore: last pane on screen %lu ms after reset\n", millis());
+    }
+    return drawn;
+}
+#endif
+
 void setup()
 {
     // Disable watchdog immediately
@@ -122,6 +596,16 @@ void setup()
     Serial.begin(115200);
     delay(100);
 
+    // Before anything that could crash: a wake that never reached deep sleep counts against it
+    BootCause cause = bootCause();
+    bootPlan = BootGuard::begin(bootGuard, cause, BOOT_FAILURE_LIMIT);
+    wakeMetrics.resetCause = cause;
+    if (bootPlan.degraded)
+    {
+        Serial.printf("Boot guard: %d failed wake(s) in a row, last reset %d - subsystems %02x (probing %02x)\n",
+                      bootGuard.failures, bootGuard.lastCause, bootPlan.enabled, bootGuard.probing);
+    }
+
     // Set timezone early so time conversions are correct
     setenv("TZ", TZ_INFO, 1);
     tzset();
@@ -129,6 +613,7 @@ void setup()
     // Check wake reason
     esp_sleep_wakeup_cause_t wakeupReason = esp_sleep_get_wakeup_cause();
     bool wokeFromSleep = (wakeupReason == ESP_SLEEP_WAKEUP_TIMER);
+    display.setRefreshLedger(refreshLedger);
 
     if (wokeFromSleep)
     {
@@ -139,17 +624,56 @@ void setup()
     {
         // Fresh boot - hardware initialization only
         Serial.println("=== FRESH BOOT ===");
+        wakeMetrics.kind = WAKE_FRESH_BOOT;
 
         Serial.println("Initializing display...");
         display.init();
         Serial.println("Display initialized!");
 
+        // Initialize RTC tracking for next cycles
+        lastWeatherUpdate = 0; // Force weather update in loop on first boot
+        lastDisplayedDay = -1; // Force date update in loop
+        lastDisplayedBattery = -1; // Screen was cleared, battery must be redrawn
+        hasParkedWeather = false;
+        prefetchWakePending = false;
+        renderedWeather.valid = false; // Screen was cleared, whole weather pane is dirty
+        FetchCache::reset(fetchCache);  // Nothing cached is on screen any more
+        shownFrameHash = 0;             // Server-rendered pane is gone too
+        sunToday.dayKey = 0;            // Location or clock may have changed with the firmware
+#if WEATHER_STREAMED_FETCH
+        carouselCount = 0;
+        carouselFetchedAt = 0;
+#endif
+
+        bool restored = false;
+#if WARM_RESTORE_ENABLED
+        if (BootGuard::allowed(bootPlan, SUBSYSTEM_RESTORE))
+        {
+            restored = restoreWarmState();
+        }
+#endif
+
+        // Degraded: clock only, from the RTC's time (kept across crash and brownout resets)
+        if (!BootGuard::allowed(bootPlan, SUBSYSTEM_RADIO))
+        {
+            Serial.println("Boot guard: radio off, skipping WiFi and time sync");
+            PowerGovernor::reset(powerState, time(nullptr));
+            Serial.flush();
+            return;
+        }
+
         // WiFi and time sync on fresh boot
+        uint32_t radioStarted = millis();
         Serial.println("Connecting to WiFi...");
-        if (!network.connectWiFi(WIFI_SSID, WIFI_PASSWORD))
+        bool connected = network.connectWiFi(WIFI_SSID, WIFI_PASSWORD);
+        Telemetry::addMs(wakeMetrics.radioMs, millis() - radioStarted);
+        if (!connected)
         {
             Serial.println("WiFi connection failed!");
-            display.showError("WiFi Failed");
+            if (!restored)
+            {
+                display.showError("WiFi Failed"); // Keeps a restored pane on screen otherwise
+            }
             return;
         }
 
@@ -157,14 +681,16 @@ void setup()
         Serial.println(network.getIPAddress());
 
         Serial.println("Syncing time...");
+        radioStarted = millis();
         if (!network.syncTime())
         {
             Serial.println("Time sync failed!");
         }
+        Telemetry::addMs(wakeMetrics.radioMs, millis() - radioStarted);
+        wakeMetrics.rssi = (int8_t)network.rssi();
 
-        // Initialize RTC tracking for next cycles
-        lastWeatherUpdate = 0; // Force weather update in loop on first boot
-        lastDisplayedDay = -1; // Force date update in loop
+        // Fresh boot starts a new battery-life target
+        PowerGovernor::reset(powerState, time(nullptr));
         // Keep isFirstBoot = true so performUpdates knows to do full initial display
     }
 
@@ -174,31 +700,89 @@ void setup()
 
 void loop()
 {
-    performUpdates();
+    // Level persists in RTC memory; prefetch wakes don't re-run the governor
+    activePolicy = PowerGovernor::policyFor((PowerLevel)powerState.level);
 
-    // Get current time for sleep calculation
     time_t currentTime;
     struct tm timeinfo;
+
+    if (prefetchWakePending)
+    {
+        prefetchWakePending = false;
+        time(&currentTime);
+        localtime_r(&currentTime, &timeinfo);
+        int wakeMinute = timeinfo.tm_min;
+
+        wakeMetrics.kind = WAKE_PREFETCH;
+        prefetchWeather();
+#if TELEMETRY_ENABLED
+        uploadTelemetry();
+#endif
+#if OTA_ENABLED
+        // Same wake and connection as the weather; never on a clock wake
+        checkFirmwareUpdate();
+#endif
+
+        // A slow fetch that ran past the minute boundary must not leave the old minute on screen
+        time(&currentTime);
+        localtime_r(&currentTime, &timeinfo);
+        if (timeinfo.tm_min != wakeMinute)
+        {
+            Serial.println("Prefetch overran the minute boundary - updating clock now");
+            performUpdates();
+        }
+    }
+    else
+    {
+        performUpdates();
+#if TELEMETRY_ENABLED
+        uploadTelemetry(); // Only if a "full" frame or the first fetch already brought the radio up
+#endif
+    }
+
+    // Get current time for sleep calculation
     time(&currentTime);
     localtime_r(&currentTime, &timeinfo);
 
-    // Calculate sleep duration to wake at the top of the next minute
-    int secondsInMinute = timeinfo.tm_sec;
-    uint32_t sleepSeconds = 60 - secondsInMinute;
-
-    // Add a small buffer to ensure we're past the minute boundary
-    if (sleepSeconds < 3)
+    // Wake at the top of the next clock update (every minute at normal power),
+    // or earlier off-phase if weather needs prefetching for the next boundary
+    // Weather interval stretches while fetches keep finding the same forecast
+    time_t prefetchAt = 0;
+    if (bootPlan.degraded && activePolicy.clockIntervalMinutes < BOOT_DEGRADED_CLOCK_MINUTES)
+    {
+        activePolicy.clockIntervalMinutes = BOOT_DEGRADED_CLOCK_MINUTES;
+    }
+    if (!hasParkedWeather && !FRAME_HAS_CLOCK && BootGuard::allowed(bootPlan, SUBSYSTEM_WEATHER))
     {
-        sleepSeconds += 60; // Sleep to the next minute instead
+        int weatherInterval = FetchCache::adaptiveInterval(fetchCache, activePolicy.weatherIntervalSeconds,
+                                                           WEATHER_MAX_INTERVAL);
+        // Each panel takes its own slot before the boundary so a fleet doesn't fetch in the same second
+        int stagger = WakeLogic::staggerSeconds(staggerSeed(), lastWeatherUpdate + weatherInterval,
+                                                WEATHER_STAGGER_MINUTES, WEATHER_STAGGER_JITTER,
+                                                WEATHER_PREFETCH_LEAD_SECONDS);
+        prefetchAt =
+            WakeLogic::prefetchTime(lastWeatherUpdate, weatherInterval, WEATHER_PREFETCH_LEAD_SECONDS, stagger);
     }
+    WakePlan plan = WakeLogic::planNextWake(currentTime, timeinfo.tm_min, timeinfo.tm_sec,
+                                            activePolicy.clockIntervalMinutes, prefetchAt);
+    uint32_t sleepSeconds = plan.sleepSeconds;
+    prefetchWakePending = plan.prefetch;
 
-    Serial.printf("Sleeping for %u seconds (current: %02d:%02d:%02d)\n",
-                  sleepSeconds, timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
+    Serial.printf("Sleeping for %u seconds until %s wake (current: %02d:%02d:%02d)\n",
+                  sleepSeconds, plan.prefetch ? "prefetch" : "clock",
+                  timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
     Serial.flush();
 
     // Disconnect WiFi to save power
     network.disconnectWiFi();
 
+#if TELEMETRY_ENABLED
+    recordWake();
+#endif
+
+    // Made it to sleep: the boot guard counts this wake as clean
+    BootGuard::finished(bootGuard, BOOT_PROBE_WAKES);
+
 #if DEBUG_NO_SLEEP
     // Debug mode: use delay instead of deep sleep to keep serial monitor active
     Serial.println("DEBUG_NO_SLEEP enabled - using delay instead of deep sleep");
@@ -1,6 +1,9 @@
 #include "network.h"
 #include "config.h"
+#include "forecast_stream.h"
+#include "text_format.h"
 #include <WiFi.h>
+#include <WiFiUdp.h>
 #include <HTTPClient.h>
 #include <time.h>
 #include <ArduinoJson.h>
@@ -24,6 +27,7 @@ bool NetworkManager::connectWiFi(const char *ssid, const char *password)
         Serial.print(".");
         attempts++;
     }
+    retryCount += attempts;
 
     if (WiFi.status() == WL_CONNECTED)
     {
@@ -40,6 +44,7 @@ bool NetworkManager::connectWiFi(const char *ssid, const char *password)
 
 void NetworkManager::disconnectWiFi()
 {
+    closeSession();
     WiFi.disconnect();
     WiFi.mode(WIFI_OFF);
 }
@@ -49,6 +54,16 @@ bool NetworkManager::isConnected()
     return WiFi.status() == WL_CONNECTED;
 }
 
+int NetworkManager::rssi()
+{
+    return isConnected() ? WiFi.RSSI() : 0;
+}
+
+void NetworkManager::macAddress(uint8_t mac[6])
+{
+    WiFi.macAddress(mac);
+}
+
 String NetworkManager::getIPAddress()
 {
     if (isConnected())
@@ -85,20 +100,46 @@ bool NetworkManager::syncTime()
         }
         delay(500);
         attempts++;
+        retryCount++;
     }
 
     Serial.println("Time sync failed!");
     return false;
 }
 
-bool NetworkManager::fetchWeather(WeatherData &weatherData)
+// Ask for validators back and send the stored ones when the forecast on screen can be reused
+static void addValidators(HTTPClient &http, const FetchCacheState &cache, int displayHour)
+{
+    const char *headerKeys[] = {"ETag", "Last-Modified"};
+    http.collectHeaders(headerKeys, 2);
+    if (FetchCache::canRevalidate(cache, displayHour))
+    {
+        if (cache.etag[0] != '\0')
+            http.addHeader("If-None-Match", cache.etag);
+        if (cache.lastModified[0] != '\0')
+            http.addHeader("If-Modified-Since", cache.lastModified);
+        Serial.println("Sending conditional request");
+    }
+}
+
+FetchResult NetworkManager::fetchWeather(WeatherData &weatherData, FetchCacheState &cache, time_t displayTime)
 {
     if (!isConnected())
     {
         Serial.println("WiFi not connected, cannot fetch weather");
-        return false;
+        return FETCH_FAILED;
     }
 
+    // Hour the hourly forecast will start from - a cached forecast is only reusable for the same hour
+    time_t hourBase = (displayTime > 0) ? displayTime : time(nullptr);
+    struct tm timeinfo;
+    localtime_r(&hourBase, &timeinfo);
+    int displayHour = timeinfo.tm_hour;
+
+#if WEATHER_GATEWAY_ENABLED
+    return fetchWeatherFromGateway(weatherData, cache, displayHour);
+#else
+
     HTTPClient http;
     String url = String(WEATHER_API_URL) +
                  "?latitude=" + WEATHER_LATITUDE +
@@ -111,17 +152,28 @@ bool NetworkManager::fetchWeather(WeatherData &weatherData)
     Serial.println(url);
 
     http.begin(url);
+    addValidators(http, cache, displayHour);
     int httpCode = http.GET();
 
     Serial.printf("HTTP response code: %d\n", httpCode);
 
+    if (httpCode == 304)
+    {
+        Serial.println("Weather not modified - skipping parse");
+        http.end();
+        FetchCache::recordNotModified(cache);
+        return FETCH_NOT_MODIFIED;
+    }
+
     if (httpCode != 200)
     {
         Serial.printf("HTTP error: %d\n", httpCode);
         http.end();
-        return false;
+        return FETCH_FAILED;
     }
 
+    String etag = http.header("ETag");
+    String lastModified = http.header("Last-Modified");
     String payload = http.getString();
     http.end();
 
@@ -135,16 +187,622 @@ bool NetworkManager::fetchWeather(WeatherData &weatherData)
         Serial.println(payload);
     }
 
-    bool parseResult = parseWeatherJson(payload, weatherData);
+    // Servers without validators still send identical forecasts - catch those by content
+    uint32_t hash = FetchCache::contentHash(payload.c_str(), payload.length());
+    if (!FetchCache::needsParse(cache, hash, displayHour))
+    {
+        Serial.printf("Weather content unchanged (hash %08x) - skipping parse\n", hash);
+        FetchCache::recordBody(cache, hash, displayHour, etag.c_str(), lastModified.c_str());
+        return FETCH_NOT_MODIFIED;
+    }
+
+    bool parseResult = parseWeatherJson(payload, weatherData, displayTime);
     Serial.printf("Parse result: %d\n", parseResult);
-    return parseResult;
+    if (!parseResult)
+    {
+        return FETCH_FAILED;
+    }
+
+    FetchCache::recordBody(cache, hash, displayHour, etag.c_str(), lastModified.c_str());
+    return FETCH_UPDATED;
+#endif
 }
 
-bool NetworkManager::parseWeatherJson(const String &jsonResponse, WeatherData &weatherData)
+// Coordinates for the streamed fetch: the carousel list, or the single configured location
+#if WEATHER_CAROUSEL
+#define STREAMED_LATITUDES WEATHER_CAROUSEL_LATITUDES
+#define STREAMED_LONGITUDES WEATHER_CAROUSEL_LONGITUDES
+#else
+#define STREAMED_LATITUDES WEATHER_LATITUDE
+#define STREAMED_LONGITUDES WEATHER_LONGITUDE
+#endif
+
+static void feedParser(void *context, const char *data, size_t length)
+{
+    ((ForecastStreamParser *)context)->feed(data, length);
+}
+
+bool NetworkManager::openSession(const char *host, uint16_t port, bool secure)
+{
+    WiFiClient *client = secure ? (WiFiClient *)&tlsClient : &plainClient;
+    if (sessionClient == client && client->connected() && port == sessionPort && strcmp(host, sessionHost) == 0)
+    {
+        Serial.printf("Reusing connection to %s\n", host);
+        return true;
+    }
+
+    closeSession();
+    uint32_t started = millis();
+    if (secure)
+    {
+        tlsClient.setInsecure(); // Same as HTTPClient without a CA certificate
+    }
+    if (!client->connect(host, port))
+    {
+        Serial.printf("Connect to %s:%u failed\n", host, port);
+        return false;
+    }
+    Serial.printf("Connected to %s:%u in %lu ms\n", host, port, (unsigned long)(millis() - started));
+
+    sessionClient = client;
+    snprintf(sessionHost, sizeof(sessionHost), "%s", host);
+    sessionPort = port;
+    bufferedStart = bufferedEnd = 0;
+    return true;
+}
+
+void NetworkManager::closeSession()
+{
+    if (sessionClient != nullptr)
+    {
+        sessionClient->stop();
+        sessionClient = nullptr;
+    }
+    sessionHost[0] = '\0';
+    bufferedStart = bufferedEnd = 0;
+}
+
+bool NetworkManager::sendRequest(const char *request, size_t length)
+{
+    if (sessionClient == nullptr || length == 0 || sessionClient->write((const uint8_t *)request, length) != length)
+    {
+        Serial.println("Request send failed");
+        closeSession();
+        return false;
+    }
+    return true;
+}
+
+bool NetworkManager::readResponse(HttpResponseReader &reader, HttpBodySink sink, void *context)
+{
+    if (sessionClient == nullptr)
+    {
+        return false;
+    }
+
+    uint32_t lastData = millis();
+    while (!reader.done() && !reader.failed())
+    {
+        // Bytes left over from the previous response belong to this one (pipelining)
+        if (bufferedStart == bufferedEnd)
+        {
+            int available = sessionClient->available();
+            if (available <= 0)
+            {
+                if (!sessionClient->connected())
+                {
+                    reader.closed();
+                    break;
+                }
+                if (millis() - lastData > 5000)
+                {
+                    Serial.println("Response timed out");
+                    break;
+                }
+                delay(1);
+                continue;
+            }
+            int n = sessionClient->read((uint8_t *)sessionBuffer,
+                                        available < (int)sizeof(sessionBuffer) ? available : sizeof(sessionBuffer));
+            if (n <= 0)
+            {
+                continue;
+            }
+            bufferedStart = 0;
+            bufferedEnd = n;
+            lastData = millis();
+        }
+        bufferedStart += reader.feed(sessionBuffer + bufferedStart, bufferedEnd - bufferedStart, sink, context);
+    }
+
+    if (!reader.done() || !reader.keepAlive())
+    {
+        closeSession();
+    }
+    return reader.done();
+}
+
+FetchResult NetworkManager::fetchLocations(LocationForecast *records, int maxLocations, int &count,
+                                           FetchCacheState &cache, time_t displayTime)
+{
+    if (!isConnected())
+    {
+        Serial.println("WiFi not connected, cannot fetch weather");
+        return FETCH_FAILED;
+    }
+
+    time_t hourBase = (displayTime > 0) ? displayTime : time(nullptr);
+    struct tm timeinfo;
+    localtime_r(&hourBase, &timeinfo);
+    int displayHour = timeinfo.tm_hour;
+    uint32_t started = millis();
+
+    // Open-Meteo takes comma-separated coordinates and answers with one object per location
+    static char request[768];
+    char query[320];
+    char host[64];
+    uint16_t port;
+    bool secure;
+    const char *path = HttpRequest::splitUrl(WEATHER_API_URL, host, sizeof(host), port, secure);
+    if (path == nullptr)
+    {
+        Serial.println("Bad WEATHER_API_URL");
+        return FETCH_FAILED;
+    }
+    snprintf(query, sizeof(query),
+             "?latitude=%s&longitude=%s&current=temperature_2m,relative_humidity_2m,weather_code"
+             "&hourly=temperature_2m,weather_code&daily=temperature_2m_max,temperature_2m_min,weather_code"
+             "&temperature_unit=fahrenheit&timezone=auto&forecast_days=5",
+             STREAMED_LATITUDES, STREAMED_LONGITUDES);
+    bool revalidate = FetchCache::canRevalidate(cache, displayHour) && count > 0;
+    size_t length = HttpRequest::formatGet(request, sizeof(request), host, path, query,
+                                           revalidate ? cache.etag : nullptr, revalidate ? cache.lastModified : nullptr);
+
+    Serial.printf("Fetching weather for all locations from %s%s%s\n", host, path, query);
+    if (revalidate)
+    {
+        Serial.println("Sending conditional request");
+    }
+    if (!openSession(host, port, secure) || !sendRequest(request, length))
+    {
+        return FETCH_FAILED;
+    }
+
+#if AIR_QUALITY_ENABLED
+    static char airRequest[384];
+    char airHost[64];
+    uint16_t airPort;
+    bool airSecure;
+    const char *airPath = HttpRequest::splitUrl(AIR_QUALITY_API_URL, airHost, sizeof(airHost), airPort, airSecure);
+    size_t airLength = 0;
+    if (airPath != nullptr)
+    {
+        snprintf(query, sizeof(query), "?latitude=%s&longitude=%s&current=us_aqi,pm2_5", STREAMED_LATITUDES,
+                 STREAMED_LONGITUDES);
+        airLength = HttpRequest::formatGet(airRequest, sizeof(airRequest), airHost, airPath, query, nullptr, nullptr);
+    }
+
+    // Same host: the second request goes out before the first response is read
+    bool pipelined = airLength > 0 && port == airPort && secure == airSecure && strcmp(host, airHost) == 0;
+    if (pipelined && !sendRequest(airRequest, airLength))
+    {
+        return FETCH_FAILED;
+    }
+#endif
+
+    // Parse while the body streams in - the whole response is never held in RAM
+    static LocationForecast parsed[WEATHER_MAX_LOCATIONS];
+    static ForecastStreamParser parser;
+    int capacity = maxLocations < WEATHER_MAX_LOCATIONS ? maxLocations : WEATHER_MAX_LOCATIONS;
+    parser.begin(parsed, capacity, displayTime, displayHour);
+
+    HttpResponseReader reader;
+    reader.begin();
+    if (!readResponse(reader, feedParser, &parser))
+    {
+        Serial.println("Weather response incomplete");
+        return FETCH_FAILED;
+    }
+    Serial.printf("HTTP response code: %d\n", reader.status());
+
+    int locations;
+    bool notModified = reader.status() == 304;
+    char etag[sizeof(cache.etag)];
+    char lastModified[sizeof(cache.lastModified)];
+    if (notModified)
+    {
+        // Forecast on screen still holds; start from it so air quality can still change
+        Serial.println("Weather not modified - skipping parse");
+        memcpy(parsed, records, sizeof(LocationForecast) * count);
+        locations = count;
+        strcpy(etag, cache.etag);
+        strcpy(lastModified, cache.lastModified);
+    }
+    else if (reader.status() == 200)
+    {
+        locations = parser.finish();
+        Serial.printf("%d location(s) parsed\n", locations);
+        if (locations <= 0)
+        {
+            return FETCH_FAILED;
+        }
+        strcpy(etag, reader.etag());
+        strcpy(lastModified, reader.lastModified());
+    }
+    else
+    {
+        Serial.printf("HTTP error: %d\n", reader.status());
+        closeSession(); // A pipelined request may still be queued behind the error
+        return FETCH_FAILED;
+    }
+
+#if AIR_QUALITY_ENABLED
+    if (airLength > 0)
+    {
+        // A server that closed after the forecast dropped the pipelined request too
+        if (pipelined && !reader.keepAlive())
+        {
+            pipelined = false;
+        }
+        bool sent = pipelined || (openSession(airHost, airPort, airSecure) && sendRequest(airRequest, airLength));
+
+        parser.beginAirQuality(parsed, locations);
+        HttpResponseReader airReader;
+        airReader.begin();
+        bool airOk = sent && readResponse(airReader, feedParser, &parser) && airReader.status() == 200 &&
+                     parser.finish() > 0;
+        Serial.printf("Air quality %s\n", airOk ? "updated" : "failed - keeping the values on screen");
+        if (!airOk)
+        {
+            for (int i = 0; i < locations; i++)
+            {
+                bool known = i < count;
+                parsed[i].hasAirQuality = known ? records[i].hasAirQuality : 0;
+                parsed[i].usAqi = known ? records[i].usAqi : 0;
+                parsed[i].pm25Tenths = known ? records[i].pm25Tenths : 0;
+            }
+        }
+    }
+#endif
+    Serial.printf("Weather fetch took %lu ms\n", (unsigned long)(millis() - started));
+
+    // Compare what the pane would show, not the bytes (those carry generation times)
+    uint32_t hash = WeatherCarousel::recordsHash(parsed, locations);
+    if (!FetchCache::needsParse(cache, hash, displayHour) && locations == count)
+    {
+        Serial.printf("Weather content unchanged (hash %08x)\n", hash);
+        if (notModified)
+            FetchCache::recordNotModified(cache);
+        else
+            FetchCache::recordBody(cache, hash, displayHour, etag, lastModified);
+        return FETCH_NOT_MODIFIED;
+    }
+
+    memcpy(records, parsed, sizeof(LocationForecast) * locations);
+    count = locations;
+    FetchCache::recordBody(cache, hash, displayHour, etag, lastModified);
+    return FETCH_UPDATED;
+}
+
+FetchResult NetworkManager::fetchFrame(const char *pane, time_t displayTime, uint32_t shownHash, uint8_t *buffer,
+                                       size_t capacity, size_t &length)
+{
+    if (!isConnected())
+    {
+        Serial.println("WiFi not connected, cannot fetch frame");
+        return FETCH_FAILED;
+    }
+
+    HTTPClient http;
+    String url = String(RENDER_FRAME_URL) +
+                 "?pane=" + pane +
+                 "&time=" + String((uint32_t)displayTime) +
+                 "&latitude=" + WEATHER_LATITUDE +
+                 "&longitude=" + WEATHER_LONGITUDE;
+#if RENDER_FRAME_DELTA
+    char known[16];
+    snprintf(known, sizeof(known), "%08x", (unsigned)shownHash);
+    url += String("&known=") + known;
+#endif
+
+    Serial.print("Fetching frame from: ");
+    Serial.println(url);
+
+    http.begin(url);
+    int httpCode = http.GET();
+    if (httpCode == 304)
+    {
+        Serial.println("Frame not modified (304)");
+        http.end();
+        return FETCH_NOT_MODIFIED;
+    }
+    if (httpCode != 200)
+    {
+        Serial.printf("Frame HTTP error: %d\n", httpCode);
+        http.end();
+        return FETCH_FAILED;
+    }
+
+    int size = http.getSize();
+    if (size <= 0 || (size_t)size > capacity)
+    {
+        Serial.printf("Frame size %d doesn't fit in %u bytes\n", size, (unsigned)capacity);
+        http.end();
+        return FETCH_FAILED;
+    }
+
+    // Read straight into the caller's buffer - no String copy of the body
+    WiFiClient *stream = http.getStreamPtr();
+    size_t received = 0;
+    uint32_t lastData = millis();
+    while (received < (size_t)size && millis() - lastData < 2000)
+    {
+        size_t available = stream->available();
+        if (available == 0)
+        {
+            delay(1);
+            continue;
+        }
+        if (available > (size_t)size - received)
+            available = (size_t)size - received;
+        received += stream->readBytes(buffer + received, available);
+        lastData = millis();
+    }
+    http.end();
+
+    if (received != (size_t)size)
+    {
+        Serial.printf("Frame truncated: %u of %d bytes\n", (unsigned)received, size);
+        return FETCH_FAILED;
+    }
+
+    Serial.printf("Frame received: %u bytes\n", (unsigned)received);
+    length = received;
+    return FETCH_UPDATED;
+}
+
+// Body of a small text response
+struct TextBody
+{
+    char text[384];
+    size_t length;
+};
+
+static void collectText(void *context, const char *data, size_t length)
+{
+    TextBody *body = (TextBody *)context;
+    size_t room = sizeof(body->text) - body->length;
+    size_t n = length < room ? length : room;
+    memcpy(body->text + body->length, data, n);
+    body->length += n;
+}
+
+// Passes the body on only once the status says it is the patch, not an error page
+struct PatchBody
+{
+    const HttpResponseReader *reader;
+    HttpBodySink sink;
+    void *context;
+    size_t received;
+};
+
+static void forwardPatch(void *context, const char *data, size_t length)
+{
+    PatchBody *body = (PatchBody *)context;
+    if (body->reader->status() == 200)
+    {
+        body->sink(body->context, data, length);
+        body->received += length;
+    }
+}
+
+bool NetworkManager::fetchOtaManifest(OtaManifest &manifest)
+{
+    if (!isConnected())
+    {
+        return false;
+    }
+
+    static char request[384];
+    char query[32];
+    char host[64];
+    uint16_t port;
+    bool secure;
+    const char *path = HttpRequest::splitUrl(OTA_MANIFEST_URL, host, sizeof(host), port, secure);
+    if (path == nullptr)
+    {
+        Serial.println("Bad OTA_MANIFEST_URL");
+        return false;
+    }
+    snprintf(query, sizeof(query), "%cversion=%u", strchr(path, '?') ? '&' : '?', (unsigned)FIRMWARE_VERSION);
+    size_t length = HttpRequest::formatGet(request, sizeof(request), host, path, query, nullptr, nullptr);
+    if (!openSession(host, port, secure) || !sendRequest(request, length))
+    {
+        return false;
+    }
+
+    static TextBody body;
+    body.length = 0;
+    HttpResponseReader reader;
+    reader.begin();
+    if (!readResponse(reader, collectText, &body))
+    {
+        Serial.println("Update manifest incomplete");
+        return false;
+    }
+    if (reader.status() == 204)
+    {
+        Serial.printf("Firmware %u is current\n", (unsigned)FIRMWARE_VERSION);
+        return false;
+    }
+    if (reader.status() != 200 || !OtaPatch::parseManifest(body.text, body.length, manifest))
+    {
+        Serial.printf("Update manifest unusable (HTTP %d)\n", reader.status());
+        return false;
+    }
+    return true;
+}
+
+bool NetworkManager::fetchOtaPatch(const OtaManifest &manifest, HttpBodySink sink, void *context)
+{
+    // A bare path lives on the manifest's host
+    static char request[384];
+    char host[64];
+    uint16_t port;
+    bool secure;
+    const char *path = HttpRequest::splitUrl(manifest.patch[0] == '/' ? OTA_MANIFEST_URL : manifest.patch, host,
+                                             sizeof(host), port, secure);
+    if (path == nullptr)
+    {
+        Serial.println("Bad patch URL in update manifest");
+        return false;
+    }
+    if (manifest.patch[0] == '/')
+    {
+        path = manifest.patch;
+    }
+    size_t length = HttpRequest::formatGet(request, sizeof(request), host, path, nullptr, nullptr, nullptr);
+    if (!openSession(host, port, secure) || !sendRequest(request, length))
+    {
+        return false;
+    }
+
+    uint32_t started = millis();
+    HttpResponseReader reader;
+    reader.begin();
+    PatchBody body = {&reader, sink, context, 0};
+    bool complete = readResponse(reader, forwardPatch, &body);
+    Serial.printf("Patch download: HTTP %d, %u bytes in %lu ms\n", reader.status(), (unsigned)body.received,
+                  (unsigned long)(millis() - started));
+    return complete && reader.status() == 200;
+}
+
+static void discardBody(void *context, const char *data, size_t length)
+{
+}
+
+bool NetworkManager::postTelemetry(const uint8_t *batch, size_t length)
+{
+    if (!isConnected())
+    {
+        return false;
+    }
+
+    char head[256];
+    char host[64];
+    uint16_t port;
+    bool secure;
+    const char *path = HttpRequest::splitUrl(TELEMETRY_URL, host, sizeof(host), port, secure);
+    if (path == nullptr)
+    {
+        Serial.println("Bad TELEMETRY_URL");
+        return false;
+    }
+    size_t headLength = HttpRequest::formatPost(head, sizeof(head), host, path, "application/octet-stream", length);
+    if (!openSession(host, port, secure) || !sendRequest(head, headLength) ||
+        !sendRequest((const char *)batch, length))
+    {
+        return false;
+    }
+
+    HttpResponseReader reader;
+    reader.begin();
+    if (!readResponse(reader, discardBody, nullptr) || reader.status() < 200 || reader.status() > 299)
+    {
+        Serial.printf("Telemetry upload failed (HTTP %d)\n", reader.status());
+        return false;
+    }
+    return true;
+}
+
+FetchResult NetworkManager::fetchWeatherFromGateway(WeatherData &weatherData, FetchCacheState &cache, int displayHour)
+{
+    // One small datagram each way - no DNS, TCP or TLS handshake
+    static uint16_t sequence = (uint16_t)esp_random();
+
+    IPAddress gateway;
+    if (!gateway.fromString(WEATHER_GATEWAY_HOST))
+    {
+        Serial.println("Invalid gateway address");
+        return FETCH_FAILED;
+    }
+
+    GatewayRequest request = {};
+    request.displayHour = (int8_t)displayHour;
+    request.latitudeE4 = GatewayProtocol::parseCoordinateE4(WEATHER_LATITUDE);
+    request.longitudeE4 = GatewayProtocol::parseCoordinateE4(WEATHER_LONGITUDE);
+    request.knownHash = (cache.contentHash != 0 && cache.parsedHour == displayHour) ? cache.contentHash : 0;
+
+    WiFiUDP udp;
+    udp.begin(0);
+
+    uint8_t buffer[GATEWAY_MAX_RESPONSE_SIZE];
+    for (int attempt = 1; attempt <= WEATHER_GATEWAY_ATTEMPTS; attempt++)
+    {
+        request.sequence = ++sequence;
+        retryCount += attempt > 1 ? 1 : 0;
+        size_t length = GatewayProtocol::encodeRequest(request, buffer);
+        uint32_t sentAt = millis();
+
+        udp.beginPacket(gateway, WEATHER_GATEWAY_PORT);
+        udp.write(buffer, length);
+        udp.endPacket();
+
+        while (millis() - sentAt < WEATHER_GATEWAY_TIMEOUT_MS)
+        {
+            int packetSize = udp.parsePacket();
+            if (packetSize <= 0)
+            {
+                delay(2);
+                continue;
+            }
+
+            int received = udp.read(buffer, sizeof(buffer));
+            uint32_t hash = 0;
+            GatewayDecodeResult result = GatewayProtocol::decodeResponse(buffer, received > 0 ? received : 0,
+                                                                         request.sequence, weatherData, hash);
+            if (result == GATEWAY_DECODE_WRONG_SEQUENCE || result == GATEWAY_DECODE_BAD_PACKET)
+            {
+                continue; // Stale reply from an earlier attempt or noise - keep waiting
+            }
+
+            udp.stop();
+            Serial.printf("Gateway reply in %u ms (attempt %d)\n", (unsigned)(millis() - sentAt), attempt);
+
+            if (result == GATEWAY_DECODE_NOT_MODIFIED)
+            {
+                Serial.println("Gateway: weather not modified - skipping update");
+                FetchCache::recordNotModified(cache);
+                return FETCH_NOT_MODIFIED;
+            }
+            if (result == GATEWAY_DECODE_ERROR)
+            {
+                Serial.println("Gateway has no forecast for this location yet");
+                return FETCH_FAILED;
+            }
+
+            FetchCache::recordBody(cache, hash, displayHour, "", "");
+            return FETCH_UPDATED;
+        }
+        Serial.printf("Gateway attempt %d timed out\n", attempt);
+    }
+
+    udp.stop();
+    return FETCH_FAILED;
+}
+
+// ArduinoJson has already parsed the number to floating point; convert once here so nothing
+// past the parse touches float (the streamed fetch reads tenths straight from the text)
+static int16_t tenthsOf(JsonVariantConst value)
+{
+    return (int16_t)lroundf((value | 0.0f) * 10.0f);
+}
+
+bool NetworkManager::parseWeatherJson(const String &jsonResponse, WeatherData &weatherData, time_t displayTime)
 {
     // Initialize with defaults
     weatherData.currentTemp = 0;
-    weatherData.currentCondition = "Unknown";
+    weatherData.currentCondition = WEATHER_UNKNOWN;
     weatherData.humidity = 0;
     weatherData.windSpeed = 0;
 
@@ -168,14 +826,16 @@ bool NetworkManager::parseWeatherJson(const String &jsonResponse, WeatherData &w
         if (!doc["current"].isNull())
         {
             JsonObject current = doc["current"];
-            weatherData.currentTemp = current["temperature_2m"] | 0.0f;
+            weatherData.currentTemp = tenthsOf(current["temperature_2m"]);
             weatherData.humidity = current["relative_humidity_2m"] | 0;
 
             // Simple WMO weather code to condition mapping
             int weatherCode = current["weather_code"] | 0;
             weatherData.currentCondition = getWeatherCondition(weatherCode);
 
-            Serial.printf("Current: %.1f°F, %d%%, %s\n", weatherData.currentTemp, weatherData.humidity, weatherData.currentCondition.c_str());
+            char tempStr[12];
+            TextFormat(tempStr, sizeof(tempStr)).tenths(weatherData.currentTemp);
+            Serial.printf("Current: %s°F, %d%%, condition %d\n", tempStr, weatherData.humidity, weatherData.currentCondition);
         }
         else
         {
@@ -194,11 +854,13 @@ bool NetworkManager::parseWeatherJson(const String &jsonResponse, WeatherData &w
         JsonArray hourlyTemps = doc["hourly"]["temperature_2m"];
         JsonArray hourlyWeatherCodes = doc["hourly"]["weather_code"];
 
-        // Find the current hour to determine starting index
+        // Find the display hour to determine starting index
+        // (a prefetch fetches slightly ahead of the boundary it will be shown at)
         time_t now;
         struct tm timeinfo;
         time(&now);
-        localtime_r(&now, &timeinfo);
+        time_t hourBase = (displayTime > 0) ? displayTime : now;
+        localtime_r(&hourBase, &timeinfo);
         int currentHour = timeinfo.tm_hour;
 
         // Find the first hourly entry that matches or exceeds current hour
@@ -213,7 +875,7 @@ bool NetworkManager::parseWeatherJson(const String &jsonResponse, WeatherData &w
             int hourStart = timeStr.indexOf('T') + 1;
             weatherData.hourly[i].hour = timeStr.substring(hourStart, hourStart + 2).toInt();
 
-            weatherData.hourly[i].temp = hourlyTemps[startIndex + i] | 0.0f;
+            weatherData.hourly[i].temp = tenthsOf(hourlyTemps[startIndex + i]);
             weatherData.hourly[i].condition = getWeatherCondition((int)(hourlyWeatherCodes[startIndex + i] | 0));
         }
 
@@ -229,35 +891,13 @@ bool NetworkManager::parseWeatherJson(const String &jsonResponse, WeatherData &w
         JsonArray dailyTempMin = doc["daily"]["temperature_2m_min"];
         JsonArray dailyWeatherCodes = doc["daily"]["weather_code"];
 
-        const char *daysOfWeek[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
-
         for (int i = 0; i < 4 && i < dailyTempMax.size(); i++)
         {
             // Extract date from ISO timestamp (e.g., "2026-01-03" → day of week)
             String dateStr = dailyTimes[i].as<String>();
-            // Parse year, month, day from YYYY-MM-DD format
-            int year = dateStr.substring(0, 4).toInt();
-            int month = dateStr.substring(5, 7).toInt();
-            int day = dateStr.substring(8, 10).toInt();
-
-            // Zeller's congruence to get day of week
-            int q = day;
-            int m = month;
-            int k = year % 100;
-            int j = year / 100;
-
-            if (m < 3)
-            {
-                m += 12;
-                k--;
-            }
-
-            int h = (q + (13 * (m + 1)) / 5 + k + k / 4 + j / 4 - 2 * j) % 7;
-            int dayOfWeek = (h + 5) % 7; // Convert to 0=Sun, 1=Mon, etc.
-
-            weatherData.daily[i].day = daysOfWeek[dayOfWeek];
-            weatherData.daily[i].tempHigh = dailyTempMax[i] | 0.0f;
-            weatherData.daily[i].tempLow = dailyTempMin[i] | 0.0f;
+            weatherData.daily[i].dayOfWeek = ForecastStreamParser::dayOfWeekFor(dateStr.c_str());
+            weatherData.daily[i].tempHigh = tenthsOf(dailyTempMax[i]);
+            weatherData.daily[i].tempLow = tenthsOf(dailyTempMin[i]);
             weatherData.daily[i].condition = getWeatherCondition((int)(dailyWeatherCodes[i] | 0));
         }
 
@@ -282,31 +922,12 @@ bool NetworkManager::parseWeatherJson(const String &jsonResponse, WeatherData &w
     }
 }
 
-String NetworkManager::getWeatherCondition(int wmoCode)
+WeatherCondition NetworkManager::getWeatherCondition(int wmoCode)
 {
-    // Simplified WMO weather code to text mapping
-    if (wmoCode == 0 || wmoCode == 1)
-        return "Clear";
-    if (wmoCode == 2)
-        return "Cloudy";
-    if (wmoCode == 3)
-        return "Overcast";
-    if (wmoCode == 45 || wmoCode == 48)
-        return "Foggy";
-    if (wmoCode >= 51 && wmoCode <= 67)
-        return "Rain";
-    if (wmoCode >= 71 && wmoCode <= 87)
-        return "Snow";
-    if (wmoCode >= 80 && wmoCode <= 82)
-        return "Rain";
-    if (wmoCode == 85 || wmoCode == 86)
-        return "Snow";
-    if (wmoCode >= 90 && wmoCode <= 99)
-        return "Thunder";
-    return "Unknown";
+    return ForecastStreamParser::conditionForCode(wmoCode);
 }
 
-float NetworkManager::readDeviceBattery()
+int NetworkManager::readDeviceBattery()
 {
     // Take 8 samples and average
     int32_t adc = 0;
@@ -315,13 +936,13 @@ float NetworkManager::readDeviceBattery()
     {
         adc += analogReadMilliVolts(PIN_BATTERY);
     }
-    // Voltage divider: multiply by 2, convert mV to V
-    float voltage = (adc / 8.0f) * 2.0f / 1000.0f;
+    // Voltage divider: multiply by 2 (average of 8 samples, so divide by 4)
+    int32_t millivolts = adc / 4;
 
-    // Convert to percentage (3.0V = 0%, 4.2V = 100%)
-    float percent = (voltage - 3.0) / (4.2 - 3.0) * 100.0;
-    percent = constrain(percent, 0, 100);
+    // Convert to tenths of a percent (3.0V = 0%, 4.2V = 100%)
+    int32_t percentX10 = (millivolts - 3000) * 1000 / 1200;
+    percentX10 = constrain(percentX10, 0, 1000);
 
-    Serial.printf("Device battery: %.2fV (%.0f%%)\n", voltage, percent);
-    return percent;
+    Serial.printf("Device battery: %d mV (%d.%d%%)\n", (int)millivolts, (int)(percentX10 / 10), (int)(percentX10 % 10));
+    return (int)percentX10;
 }
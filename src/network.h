@@ -1,8 +1,16 @@
 #ifndef NETWORK_H
 #define NETWORK_H
 
+#include <Arduino.h>
 #include <ArduinoJson.h>
+#include <WiFiClient.h>
+#include <WiFiClientSecure.h>
 #include "types.h"
+#include "fetch_cache.h"
+#include "gateway_protocol.h"
+#include "forecast_stream.h"
+#include "http_stream.h"
+#include "ota_patch.h"
 
 class NetworkManager
 {
@@ -12,19 +20,66 @@ public:
     void disconnectWiFi();
     bool isConnected();
     String getIPAddress();
+    int rssi(); // dBm, 0 when not connected
+    void macAddress(uint8_t mac[6]);
+    int retries() const { return retryCount; } // WiFi and time sync 500 ms polls, gateway re-sends
 
     // Time synchronization
     bool syncTime();
 
     // Weather API
-    bool fetchWeather(WeatherData &weatherData);
+    // displayTime selects which hour the hourly forecast starts from (0 = now)
+    // cache holds validators/content hash from the last response; weatherData is only
+    // written when the result is FETCH_UPDATED
+    FetchResult fetchWeather(WeatherData &weatherData, FetchCacheState &cache, time_t displayTime = 0);
+
+    // Every WEATHER_CAROUSEL location (or the single configured one) in one request,
+    // stream-parsed into compact records. With AIR_QUALITY_ENABLED the air-quality request
+    // follows on the same kept-alive connection, pipelined when both URLs share a host.
+    // records and count are only written when the result is FETCH_UPDATED
+    FetchResult fetchLocations(LocationForecast *records, int maxLocations, int &count, FetchCacheState &cache,
+                               time_t displayTime = 0);
+
+    // Server-rendered frame (RENDER_FRAME_URL) for display at displayTime
+    // With RENDER_FRAME_DELTA the server answers with a tile delta against shownHash, or
+    // FETCH_NOT_MODIFIED when the pane would come out the same. length is set on FETCH_UPDATED.
+    FetchResult fetchFrame(const char *pane, time_t displayTime, uint32_t shownHash, uint8_t *buffer, size_t capacity,
+                           size_t &length);
+
+    // Update manifest (OTA_MANIFEST_URL) for the running FIRMWARE_VERSION, on the kept-alive
+    // session, so it shares the weather connection when the update server is the same host.
+    // false = up to date (204) or no usable answer
+    bool fetchOtaManifest(OtaManifest &manifest);
+
+    // Stream the manifest's patch into sink. Only a 200 body reaches sink.
+    bool fetchOtaPatch(const OtaManifest &manifest, HttpBodySink sink, void *context);
+
+    // POST a telemetry batch (telemetry.h) to TELEMETRY_URL on the kept-alive session
+    bool postTelemetry(const uint8_t *batch, size_t length);
 
     // Battery reading
-    float readDeviceBattery();
+    int readDeviceBattery(); // Tenths of a percent
 
 private:
-    bool parseWeatherJson(const String &jsonResponse, WeatherData &weatherData);
-    String getWeatherCondition(int wmoCode);
+    FetchResult fetchWeatherFromGateway(WeatherData &weatherData, FetchCacheState &cache, int displayHour);
+    bool parseWeatherJson(const String &jsonResponse, WeatherData &weatherData, time_t displayTime);
+    WeatherCondition getWeatherCondition(int wmoCode);
+
+    // Kept-alive HTTP/1.1 connection shared by consecutive requests in one wake
+    bool openSession(const char *host, uint16_t port, bool secure);
+    void closeSession();
+    bool sendRequest(const char *request, size_t length);
+    bool readResponse(HttpResponseReader &reader, HttpBodySink sink, void *context);
+
+    WiFiClient plainClient;
+    WiFiClientSecure tlsClient;
+    WiFiClient *sessionClient = nullptr;
+    char sessionHost[64] = "";
+    uint16_t sessionPort = 0;
+    char sessionBuffer[512];
+    size_t bufferedStart = 0; // Unread bytes in sessionBuffer, possibly the next pipelined response
+    size_t bufferedEnd = 0;
+    int retryCount = 0;
 };
 
 #endif // NETWORK_H
@@ -0,0 +1,426 @@
+#include "ota_patch.h"
+#include <cstring>
+
+const uint8_t PATCH_MAGIC_0 = 'T';
+const uint8_t PATCH_MAGIC_1 = 'P';
+const size_t PATCH_MIN_MATCH = 8; // Shorter copies cost about as much as the literal
+
+static uint32_t patchLe32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void patchStore32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+uint32_t OtaPatch::imageHash(const uint8_t *image, size_t length, uint32_t hash)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ image[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void OtaPatchApplier::begin(const OtaPatchPort &patchPort)
+{
+    port = patchPort;
+    state = STATE_HEADER;
+    failure = PATCH_OK;
+    headLength = 0;
+    sourceLength = targetLength = targetHash = 0;
+    hash = OtaPatch::imageHash(nullptr, 0);
+    produced = copied = copyEnd = 0;
+    varint = 0;
+    varintShift = 0;
+    opLength = 0;
+}
+
+bool OtaPatchApplier::fail(OtaPatchError error)
+{
+    state = STATE_FAILED;
+    failure = error;
+    return false;
+}
+
+bool OtaPatchApplier::header()
+{
+    if (head[0] != PATCH_MAGIC_0 || head[1] != PATCH_MAGIC_1 || head[2] != OTA_PATCH_VERSION)
+    {
+        return fail(PATCH_BAD_HEADER);
+    }
+    sourceLength = patchLe32(head + 4);
+    targetLength = patchLe32(head + 12);
+    targetHash = patchLe32(head + 16);
+    if (targetLength == 0)
+    {
+        return fail(PATCH_BAD_HEADER);
+    }
+
+    // Check the running image before the first write: a patch for another build would
+    // otherwise only show up as a bad hash after the whole download
+    uint32_t sourceHash = OtaPatch::imageHash(nullptr, 0);
+    for (uint32_t pos = 0; pos < sourceLength; pos += COPY_CHUNK)
+    {
+        size_t n = sourceLength - pos < COPY_CHUNK ? sourceLength - pos : COPY_CHUNK;
+        if (!port.readSource(port.context, pos, buffer, n))
+        {
+            return fail(PATCH_WRONG_SOURCE); // Larger than the running partition
+        }
+        sourceHash = OtaPatch::imageHash(buffer, n, sourceHash);
+    }
+    if (sourceHash != patchLe32(head + 8))
+    {
+        return fail(PATCH_WRONG_SOURCE);
+    }
+    state = STATE_OP;
+    return true;
+}
+
+bool OtaPatchApplier::readVarint(uint8_t byte)
+{
+    if (varintShift > 28 || (varintShift == 28 && (byte & 0x70) != 0))
+    {
+        fail(PATCH_CORRUPT);
+        return false;
+    }
+    varint |= (uint32_t)(byte & 0x7F) << varintShift;
+    varintShift += 7;
+    return (byte & 0x80) == 0;
+}
+
+bool OtaPatchApplier::emit(const uint8_t *data, size_t length)
+{
+    hash = OtaPatch::imageHash(data, length, hash);
+    if (!port.writeTarget(port.context, data, length))
+    {
+        return fail(PATCH_IO_ERROR);
+    }
+    produced += (uint32_t)length;
+    return true;
+}
+
+void OtaPatchApplier::opDone()
+{
+    state = produced == targetLength ? STATE_DONE : STATE_OP;
+}
+
+bool OtaPatchApplier::copy(int64_t offset)
+{
+    int64_t start = (int64_t)copyEnd + offset;
+    if (start < 0 || start + opLength > sourceLength)
+    {
+        return fail(PATCH_CORRUPT);
+    }
+    for (uint32_t done = 0; done < opLength;)
+    {
+        size_t n = opLength - done < COPY_CHUNK ? opLength - done : COPY_CHUNK;
+        if (!port.readSource(port.context, (uint32_t)start + done, buffer, n))
+        {
+            return fail(PATCH_IO_ERROR);
+        }
+        if (!emit(buffer, n))
+        {
+            return false;
+        }
+        done += (uint32_t)n;
+    }
+    copyEnd = (uint32_t)start + opLength;
+    copied += opLength;
+    opDone();
+    return true;
+}
+
+bool OtaPatchApplier::feed(const uint8_t *data, size_t length)
+{
+    size_t i = 0;
+    while (i < length && state != STATE_FAILED)
+    {
+        switch (state)
+        {
+        case STATE_HEADER:
+            head[headLength++] = data[i++];
+            if (headLength == OTA_PATCH_HEADER_SIZE)
+            {
+                header();
+            }
+            break;
+
+        case STATE_OP:
+            if (readVarint(data[i++]))
+            {
+                opLength = varint >> 1;
+                if (opLength == 0 || opLength > targetLength - produced)
+                {
+                    fail(PATCH_CORRUPT);
+                    break;
+                }
+                state = (varint & 1) ? STATE_COPY_OFFSET : STATE_LITERAL;
+                varint = 0;
+                varintShift = 0;
+            }
+            break;
+
+        case STATE_COPY_OFFSET:
+            if (readVarint(data[i++]))
+            {
+                int64_t offset = (int64_t)(varint >> 1) ^ -(int64_t)(varint & 1); // Zigzag
+                varint = 0;
+                varintShift = 0;
+                copy(offset);
+            }
+            break;
+
+        case STATE_LITERAL:
+        {
+            size_t n = length - i < opLength ? length - i : opLength;
+            if (emit(data + i, n))
+            {
+                i += n;
+                opLength -= (uint32_t)n;
+                if (opLength == 0)
+                {
+                    opDone();
+                }
+            }
+            break;
+        }
+
+        default:
+            fail(PATCH_CORRUPT); // Bytes after the last op
+            break;
+        }
+    }
+    return state != STATE_FAILED;
+}
+
+bool OtaPatchApplier::finish()
+{
+    if (state == STATE_FAILED)
+    {
+        return false;
+    }
+    if (state != STATE_DONE)
+    {
+        return fail(PATCH_INCOMPLETE);
+    }
+    if (hash != targetHash)
+    {
+        return fail(PATCH_BAD_TARGET);
+    }
+    return true;
+}
+
+// Decimal value up to end of line; false if there are no digits
+static bool manifestNumber(const char *p, const char *end, uint32_t &value)
+{
+    value = 0;
+    const char *start = p;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+        value = value * 10 + (uint32_t)(*p++ - '0');
+    }
+    return p > start;
+}
+
+bool OtaPatch::parseManifest(const char *text, size_t length, OtaManifest &manifest)
+{
+    manifest = {};
+    const char *end = text + length;
+    const char *line = text;
+    while (line < end)
+    {
+        const char *lineEnd = (const char *)memchr(line, '\n', end - line);
+        const char *next = lineEnd ? lineEnd + 1 : end;
+        lineEnd = lineEnd ? lineEnd : end;
+        while (lineEnd > line && (lineEnd[-1] == '\r' || lineEnd[-1] == ' '))
+        {
+            lineEnd--;
+        }
+
+        const char *key = line;
+        const char *value = (const char *)memchr(line, ' ', lineEnd - line);
+        if (value != nullptr)
+        {
+            size_t keyLength = value - key;
+            while (value < lineEnd && *value == ' ')
+            {
+                value++;
+            }
+            size_t valueLength = lineEnd - value;
+            if (keyLength == 7 && memcmp(key, "version", 7) == 0)
+            {
+                manifestNumber(value, lineEnd, manifest.version);
+            }
+            else if (keyLength == 4 && memcmp(key, "size", 4) == 0)
+            {
+                manifestNumber(value, lineEnd, manifest.patchSize);
+            }
+            else if (keyLength == 5 && memcmp(key, "patch", 5) == 0 && valueLength < sizeof(manifest.patch))
+            {
+                memcpy(manifest.patch, value, valueLength);
+                manifest.patch[valueLength] = '\0';
+            }
+            else if (keyLength == 9 && memcmp(key, "signature", 9) == 0)
+            {
+                manifest.signatureLength =
+                    (uint8_t)parseHex(value, valueLength, manifest.signature, sizeof(manifest.signature));
+            }
+        }
+        line = next;
+    }
+    return manifest.version != 0 && manifest.patch[0] != '\0' && manifest.signatureLength != 0;
+}
+
+static int hexDigit(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+size_t OtaPatch::parseHex(const char *hex, size_t length, uint8_t *out, size_t capacity)
+{
+    if (length % 2 != 0 || length / 2 > capacity)
+    {
+        return 0;
+    }
+    for (size_t i = 0; i < length; i += 2)
+    {
+        int high = hexDigit(hex[i]), low = hexDigit(hex[i + 1]);
+        if (high < 0 || low < 0)
+        {
+            return 0;
+        }
+        out[i / 2] = (uint8_t)(high << 4 | low);
+    }
+    return length / 2;
+}
+
+// Patch being encoded; writes stop (and ok clears) once capacity runs out
+struct PatchWriter
+{
+    uint8_t *out;
+    size_t capacity;
+    size_t length;
+    bool ok;
+
+    void byte(uint8_t value)
+    {
+        if (length < capacity)
+            out[length++] = value;
+        else
+            ok = false;
+    }
+
+    void varint(uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            byte((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        byte((uint8_t)value);
+    }
+
+    void literal(const uint8_t *data, size_t count)
+    {
+        if (count == 0)
+            return;
+        varint((uint32_t)count << 1);
+        for (size_t i = 0; i < count; i++)
+            byte(data[i]);
+    }
+};
+
+static uint32_t patchBucket(const uint8_t *p)
+{
+    uint64_t word = 0;
+    memcpy(&word, p, 8);
+    return (uint32_t)((word * 0x9E3779B97F4A7C15ull) >> 48) % OTA_PATCH_INDEX_SIZE;
+}
+
+static size_t patchMatch(const uint8_t *source, size_t sourceSize, size_t from, const uint8_t *target, size_t left)
+{
+    size_t n = 0;
+    while (from + n < sourceSize && n < left && source[from + n] == target[n])
+    {
+        n++;
+    }
+    return n;
+}
+
+size_t OtaPatch::encode(const uint8_t *source, size_t sourceSize, const uint8_t *target, size_t targetSize,
+                        uint32_t *index, uint8_t *out, size_t capacity)
+{
+    if (capacity < OTA_PATCH_HEADER_SIZE || targetSize == 0)
+    {
+        return 0;
+    }
+    out[0] = PATCH_MAGIC_0;
+    out[1] = PATCH_MAGIC_1;
+    out[2] = OTA_PATCH_VERSION;
+    out[3] = 0;
+    patchStore32(out + 4, (uint32_t)sourceSize);
+    patchStore32(out + 8, imageHash(source, sourceSize));
+    patchStore32(out + 12, (uint32_t)targetSize);
+    patchStore32(out + 16, imageHash(target, targetSize));
+    PatchWriter writer = {out, capacity, OTA_PATCH_HEADER_SIZE, true};
+
+    // Last source offset of each 8-byte block hash
+    memset(index, 0xFF, OTA_PATCH_INDEX_SIZE * sizeof(uint32_t));
+    for (size_t i = 0; i + PATCH_MIN_MATCH <= sourceSize; i++)
+    {
+        index[patchBucket(source + i)] = (uint32_t)i;
+    }
+
+    size_t copyEnd = 0;
+    size_t literalStart = 0;
+    size_t pos = 0;
+    while (pos + PATCH_MIN_MATCH <= targetSize)
+    {
+        // Where the last copy would have carried on had the literal been unchanged bytes
+        // (a patched constant inside moved code), then wherever the block hash points
+        size_t bestFrom = 0, bestLength = 0;
+        size_t carried = copyEnd + (pos - literalStart);
+        if (copyEnd > 0 && carried < sourceSize)
+        {
+            bestFrom = carried;
+            bestLength = patchMatch(source, sourceSize, carried, target + pos, targetSize - pos);
+        }
+        uint32_t candidate = index[patchBucket(target + pos)];
+        if (candidate != 0xFFFFFFFFu && bestLength < PATCH_MIN_MATCH)
+        {
+            size_t length = patchMatch(source, sourceSize, candidate, target + pos, targetSize - pos);
+            if (length > bestLength)
+            {
+                bestFrom = candidate;
+                bestLength = length;
+            }
+        }
+        if (bestLength < PATCH_MIN_MATCH)
+        {
+            pos++;
+            continue;
+        }
+
+        writer.literal(target + literalStart, pos - literalStart);
+        int64_t offset = (int64_t)bestFrom - (int64_t)copyEnd;
+        writer.varint((uint32_t)(bestLength << 1) | 1);
+        writer.varint((uint32_t)((offset << 1) ^ (offset >> 63))); // Zigzag
+        copyEnd = bestFrom + bestLength;
+        pos += bestLength;
+        literalStart = pos;
+    }
+    writer.literal(target + literalStart, targetSize - literalStart);
+    return writer.ok ? writer.length : 0;
+}
@@ -0,0 +1,169 @@
+#ifndef OTA_PATCH_H
+#define OTA_PATCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Firmware delta against the running image, applied while it downloads
+//
+//   0  'T' 'P'   magic
+//   2  u8        version
+//   3  u8        reserved (0)
+//   4  u32       source size   running image the patch applies to
+//   8  u32       source hash   FNV-1a of those bytes
+//   12 u32       target size
+//   16 u32       target hash   FNV-1a of the image the patch produces
+//   20 ops       until target size bytes are out
+//
+// Each op starts with a LEB128 word w, and produces w >> 1 bytes (at least 1):
+//   w & 1 == 0   literal: the bytes follow
+//   w & 1 == 1   copy: a zigzag LEB128 offset follows; the bytes come from the source, starting
+//                that far from where the previous copy ended (code that only moved stays one
+//                run of copies with offset 0)
+//
+// No compressor is needed on the device: the win comes from copies, and the patch is streamed
+// straight into the OTA partition without being held anywhere.
+
+#define OTA_PATCH_VERSION 1
+#define OTA_PATCH_HEADER_SIZE 20
+#define OTA_PATCH_INDEX_SIZE 65536 // Scratch entries for OtaPatch::encode
+#define OTA_SIGNATURE_MAX 72       // DER ECDSA P-256 signature
+
+enum OtaPatchError : uint8_t
+{
+    PATCH_OK = 0,
+    PATCH_BAD_HEADER,   // Not a patch, or a newer format
+    PATCH_WRONG_SOURCE, // Made against another image than the one running
+    PATCH_CORRUPT,      // Op runs outside the source or past the target size
+    PATCH_IO_ERROR,     // Flash read or write failed
+    PATCH_INCOMPLETE,   // Download ended early
+    PATCH_BAD_TARGET    // Result doesn't hash to what the patch promised
+};
+
+// Source reads and target writes. The target is written strictly in order.
+struct OtaPatchPort
+{
+    void *context;
+    bool (*readSource)(void *context, uint32_t offset, void *out, size_t length);
+    bool (*writeTarget)(void *context, const void *data, size_t length);
+};
+
+// Newest firmware as announced by the update server, one "key value" per line:
+//   version 43
+//   patch /ota/patch?from=42&to=43   (path on the manifest's host, or an absolute URL)
+//   size 23456                       (patch bytes, optional)
+//   signature 3045022100...          (hex DER ECDSA P-256 / SHA-256 signature)
+//
+// The signature covers the target image followed by the version as a u32 little-endian, so an
+// older signed image can't be announced as a newer version. The patch hashes above only catch
+// damage; the signature is what says the image came from the release key.
+struct OtaManifest
+{
+    uint32_t version;
+    char patch[128];
+    uint32_t patchSize; // 0 = not given
+    uint8_t signature[OTA_SIGNATURE_MAX];
+    uint8_t signatureLength;
+};
+
+// Applies a patch as it streams in. Flash is reached only through OtaPatchPort, so tests apply
+// patches to RAM images and can cut a download off anywhere.
+class OtaPatchApplier
+{
+public:
+    /**
+     * Start a patch
+     * @param port Running image and OTA partition access
+     */
+    void begin(const OtaPatchPort &port);
+
+    /**
+     * Apply the next bytes of the patch. The source is hashed as soon as the header is in,
+     * before anything is written.
+     * @return false once the patch has failed (see error())
+     */
+    bool feed(const uint8_t *data, size_t length);
+
+    /**
+     * The download is complete
+     * @return true if the whole target was written and hashes as promised
+     */
+    bool finish();
+
+    OtaPatchError error() const { return failure; }
+    uint32_t targetSize() const { return targetLength; }
+    uint32_t targetWritten() const { return produced; }
+    uint32_t copiedBytes() const { return copied; }
+
+private:
+    static const size_t COPY_CHUNK = 256;
+
+    enum State : uint8_t
+    {
+        STATE_HEADER,
+        STATE_OP,
+        STATE_COPY_OFFSET,
+        STATE_LITERAL,
+        STATE_DONE,
+        STATE_FAILED
+    };
+
+    bool header();
+    bool readVarint(uint8_t byte);
+    bool copy(int64_t offset);
+    bool emit(const uint8_t *data, size_t length);
+    void opDone();
+    bool fail(OtaPatchError error);
+
+    OtaPatchPort port = {};
+    State state = STATE_FAILED;
+    OtaPatchError failure = PATCH_INCOMPLETE;
+    uint8_t head[OTA_PATCH_HEADER_SIZE];
+    size_t headLength = 0;
+
+    uint32_t sourceLength = 0;
+    uint32_t targetLength = 0;
+    uint32_t targetHash = 0;
+    uint32_t hash = 0;
+    uint32_t produced = 0;
+    uint32_t copied = 0;
+    uint32_t copyEnd = 0;
+
+    uint32_t varint = 0;
+    int varintShift = 0;
+    uint32_t opLength = 0;
+    uint8_t buffer[COPY_CHUNK];
+};
+
+// Hashing, manifest parsing and the patch encoder for the host tools and tests
+class OtaPatch
+{
+public:
+    /**
+     * FNV-1a over an image, as in the patch header
+     */
+    static uint32_t imageHash(const uint8_t *image, size_t length, uint32_t hash = 2166136261u);
+
+    /**
+     * Parse a manifest body. Unknown keys are skipped.
+     * @return false if version, patch or signature is missing
+     */
+    static bool parseManifest(const char *text, size_t length, OtaManifest &manifest);
+
+    /**
+     * Decode hex digits (either case)
+     * @return Bytes written, 0 if the text isn't whole bytes of hex or doesn't fit capacity
+     */
+    static size_t parseHex(const char *hex, size_t length, uint8_t *out, size_t capacity);
+
+    /**
+     * Encode target as a patch against source: copies where 8 or more bytes match, literals
+     * in between
+     * @param index Scratch of OTA_PATCH_INDEX_SIZE entries
+     * @return Patch length, 0 if it doesn't fit in capacity
+     */
+    static size_t encode(const uint8_t *source, size_t sourceSize, const uint8_t *target, size_t targetSize,
+                         uint32_t *index, uint8_t *out, size_t capacity);
+};
+
+#endif // OTA_PATCH_H
@@ -0,0 +1,117 @@
+#include "ota_update.h"
+#include <Arduino.h>
+#include <mbedtls/pk.h>
+#include "config.h"
+
+#if OTA_ENABLED
+static_assert(sizeof(OTA_PUBLIC_KEY) > 1, "OTA_ENABLED needs OTA_PUBLIC_KEY (scripts/ota_server.py --keygen)");
+#endif
+
+bool OtaUpdate::begin()
+{
+    running = esp_ota_get_running_partition();
+    target = esp_ota_get_next_update_partition(nullptr);
+    if (running == nullptr || target == nullptr)
+    {
+        Serial.println("No OTA partition to update into");
+        return false;
+    }
+    mbedtls_md_init(&digest);
+    if (mbedtls_md_setup(&digest, mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), 0) != 0 ||
+        mbedtls_md_starts(&digest) != 0)
+    {
+        Serial.println("No SHA-256 for the image signature");
+        mbedtls_md_free(&digest);
+        return false;
+    }
+    esp_err_t err = esp_ota_begin(target, OTA_WITH_SEQUENTIAL_WRITES, &handle);
+    if (err != ESP_OK)
+    {
+        Serial.printf("OTA begin failed: %s\n", esp_err_to_name(err));
+        mbedtls_md_free(&digest);
+        return false;
+    }
+    Serial.printf("Patching %s into %s\n", running->label, target->label);
+    applier.begin({this, readSource, writeTarget});
+    return true;
+}
+
+void OtaUpdate::sink(void *context, const char *data, size_t length)
+{
+    // Once the patch has failed the rest of the download is ignored
+    ((OtaUpdate *)context)->applier.feed((const uint8_t *)data, length);
+}
+
+bool OtaUpdate::finish(bool received, const OtaManifest &manifest)
+{
+    bool applied = received && applier.finish();
+    bool signedByRelease = applied && signatureValid(manifest);
+    mbedtls_md_free(&digest);
+    if (!applied)
+    {
+        Serial.printf("Update not applied: %s, patch error %d, %u of %u bytes written\n",
+                      received ? "download complete" : "download incomplete", applier.error(),
+                      (unsigned)applier.targetWritten(), (unsigned)applier.targetSize());
+        esp_ota_abort(handle);
+        return false;
+    }
+    if (!signedByRelease)
+    {
+        // Whoever answered the manifest made this image, not the holder of the release key
+        Serial.printf("New image rejected: signature doesn't match OTA_PUBLIC_KEY for version %u\n",
+                      (unsigned)manifest.version);
+        esp_ota_abort(handle);
+        return false;
+    }
+
+    // Checks the image header, checksum and appended SHA-256 as well
+    esp_err_t err = esp_ota_end(handle);
+    if (err == ESP_OK)
+    {
+        err = esp_ota_set_boot_partition(target);
+    }
+    if (err != ESP_OK)
+    {
+        Serial.printf("New image rejected: %s\n", esp_err_to_name(err));
+        return false;
+    }
+    Serial.printf("New image: %u bytes, %u copied from the running one\n", (unsigned)applier.targetWritten(),
+                  (unsigned)applier.copiedBytes());
+    return true;
+}
+
+bool OtaUpdate::readSource(void *context, uint32_t offset, void *out, size_t length)
+{
+    const esp_partition_t *running = ((OtaUpdate *)context)->running;
+    return offset + length <= running->size && esp_partition_read(running, offset, out, length) == ESP_OK;
+}
+
+bool OtaUpdate::writeTarget(void *context, const void *data, size_t length)
+{
+    OtaUpdate *update = (OtaUpdate *)context;
+    return esp_ota_write(update->handle, data, length) == ESP_OK &&
+           mbedtls_md_update(&update->digest, (const uint8_t *)data, length) == 0;
+}
+
+bool OtaUpdate::signatureValid(const OtaManifest &manifest)
+{
+    // Signed message: the image, then the version it is announced as (ota_patch.h)
+    const uint8_t version[4] = {(uint8_t)manifest.version, (uint8_t)(manifest.version >> 8),
+                                (uint8_t)(manifest.version >> 16), (uint8_t)(manifest.version >> 24)};
+    uint8_t hash[32];
+    if (mbedtls_md_update(&digest, version, sizeof(version)) != 0 || mbedtls_md_finish(&digest, hash) != 0)
+    {
+        return false;
+    }
+
+    uint8_t key[128]; // DER SubjectPublicKeyInfo, 91 bytes for P-256
+    size_t keyLength = OtaPatch::parseHex(OTA_PUBLIC_KEY, sizeof(OTA_PUBLIC_KEY) - 1, key, sizeof(key));
+    mbedtls_pk_context pk;
+    mbedtls_pk_init(&pk);
+    bool valid = keyLength != 0 && mbedtls_pk_parse_public_key(&pk, key, keyLength) == 0 &&
+                 mbedtls_pk_can_do(&pk, MBEDTLS_PK_ECDSA) &&
+                 mbedtls_pk_verify(&pk, MBEDTLS_MD_SHA256, hash, sizeof(hash), manifest.signature,
+                                   manifest.signatureLength) == 0;
+    mbedtls_pk_free(&pk);
+    return valid;
+}
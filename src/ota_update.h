@@ -0,0 +1,46 @@
+#ifndef OTA_UPDATE_H
+#define OTA_UPDATE_H
+
+#include <esp_ota_ops.h>
+#include <mbedtls/md.h>
+#include "ota_patch.h"
+
+// Writes a downloading patch (ota_patch.h) into the next OTA partition, reading the running
+// image for the copies, and switches the boot partition once the result checks out and carries
+// the release key's signature (OTA_PUBLIC_KEY)
+class OtaUpdate
+{
+public:
+    /**
+     * Open the next OTA partition. Flash is erased as the writes reach it, not up front.
+     * @return false if there is no other app partition
+     */
+    bool begin();
+
+    /**
+     * HttpBodySink for the patch download; context is the OtaUpdate
+     */
+    static void sink(void *context, const char *data, size_t length);
+
+    /**
+     * Verify and make the new image the boot partition
+     * @param received Whether the download completed
+     * @param manifest The manifest the patch was announced by; its signature must match the
+     *                 image written and its version
+     * @return true if the next restart runs the new firmware
+     */
+    bool finish(bool received, const OtaManifest &manifest);
+
+private:
+    static bool readSource(void *context, uint32_t offset, void *out, size_t length);
+    static bool writeTarget(void *context, const void *data, size_t length);
+    bool signatureValid(const OtaManifest &manifest);
+
+    const esp_partition_t *running = nullptr;
+    const esp_partition_t *target = nullptr;
+    esp_ota_handle_t handle = 0;
+    OtaPatchApplier applier;
+    mbedtls_md_context_t digest; // SHA-256 of the image as it is written
+};
+
+#endif // OTA_UPDATE_H
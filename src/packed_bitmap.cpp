@@ -0,0 +1,104 @@
+#include "packed_bitmap.h"
+
+// Clear (paint black) the ink bits of one asset byte whose leftmost pixel lands on panel
+// column px, keeping only columns clipLeft..clipRight-1
+static void inkByte(uint8_t *row, const RasterTarget &target, int px, int clipLeft, int clipRight, uint8_t bits)
+{
+    if (px < clipLeft)
+        bits = clipLeft - px >= 8 ? 0 : (uint8_t)(bits & (0xFF >> (clipLeft - px)));
+    if (px + 8 > clipRight)
+        bits = px + 8 - clipRight >= 8 ? 0 : (uint8_t)(bits & (0xFF << (px + 8 - clipRight)));
+    if (bits == 0)
+        return;
+
+    // Left of the window only when those bits were clipped away above
+    int bx = px - target.windowX;
+    int shift = bx & 7;
+    int index = bx >> 3;
+    if (index >= 0)
+        row[index] &= (uint8_t) ~(bits >> shift);
+    if (shift != 0 && index + 1 < target.windowWidth / 8)
+        row[index + 1] &= (uint8_t) ~(bits << (8 - shift));
+}
+
+bool PackedBlit::draw(const RasterTarget &target, const PackedBitmap &bitmap, int16_t x, int16_t y)
+{
+    // Clip once: panel, then window, then the page of the window in the buffer
+    int clipLeft = target.windowX > 0 ? target.windowX : 0;
+    int clipRight = target.windowX + target.windowWidth;
+    if (clipRight > target.panelWidth)
+        clipRight = target.panelWidth;
+    int clipTop = target.windowY + target.pageTop;
+    if (clipTop < 0)
+        clipTop = 0;
+    int clipBottom = target.windowY + target.pageTop + target.pageHeight;
+    if (clipBottom > target.windowY + target.windowHeight)
+        clipBottom = target.windowY + target.windowHeight;
+    if (clipBottom > target.panelHeight)
+        clipBottom = target.panelHeight;
+    if (y >= clipBottom || y + bitmap.height <= clipTop)
+        return true; // Another band of a paged buffer
+
+    const int rowBytes = (bitmap.width + 7) / 8;
+    const int stride = target.windowWidth / 8;
+    const uint8_t *data = bitmap.data;
+    size_t pos = 0;
+    int row = 0;
+    int col = 0;
+
+    // Rows below the page are never decoded
+    while (row < bitmap.height && y + row < clipBottom)
+    {
+        if (pos >= bitmap.length)
+            return false;
+        int8_t header = (int8_t)data[pos++];
+        if (header == -128)
+            continue; // No-op
+
+        int count;
+        uint8_t repeated = 0;
+        bool repeats = header < 0;
+        if (repeats)
+        {
+            if (pos >= bitmap.length)
+                return false;
+            count = 1 - header;
+            repeated = data[pos++];
+        }
+        else
+        {
+            count = header + 1;
+            if (pos + count > bitmap.length)
+                return false;
+        }
+
+        if (repeats && repeated == 0)
+        {
+            // White: nothing to draw, just move on
+            col += count;
+            row += col / rowBytes;
+            col %= rowBytes;
+            continue;
+        }
+
+        const uint8_t *literal = data + pos;
+        if (!repeats)
+            pos += count;
+        for (int i = 0; i < count && row < bitmap.height; i++)
+        {
+            uint8_t bits = repeats ? repeated : literal[i];
+            int py = y + row;
+            if (bits != 0 && py >= clipTop && py < clipBottom)
+            {
+                uint8_t *line = target.buffer + (size_t)(py - target.windowY - target.pageTop) * stride;
+                inkByte(line, target, x + col * 8, clipLeft, clipRight, bits);
+            }
+            if (++col == rowBytes)
+            {
+                col = 0;
+                row++;
+            }
+        }
+    }
+    return true;
+}
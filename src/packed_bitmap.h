@@ -0,0 +1,44 @@
+#ifndef PACKED_BITMAP_H
+#define PACKED_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include "text_raster.h"
+
+#ifdef ARDUINO
+#include <pgmspace.h>
+#else
+#define PROGMEM
+#endif
+
+// 1bpp asset (digit or icon) as emitted by scripts/packed_assets.py: rows of (width + 7) / 8
+// bytes, MSB = leftmost pixel, 1 = black, PackBits compressed as one stream (runs may cross
+// rows, same coding as FRAME_FLAG_PACKBITS). Defined once in the generated .cpp.
+struct PackedBitmap
+{
+    const uint8_t *data;
+    uint16_t length; // Compressed bytes
+    uint16_t width, height;
+};
+
+// Draws a PackedBitmap straight from flash into the frame buffer: each run is decoded into
+// place, runs of white are skipped without touching the buffer, so nothing is unpacked to a
+// scratch copy and no pixel goes through drawPixel. Black pixels only, like drawBitmap with a
+// transparent background. Draws into any RasterTarget, so tests check it against drawBitmap.
+
+class PackedBlit
+{
+public:
+    /**
+     * Draw a bitmap
+     * @param target Buffer to draw into (clipped to panel, window and page)
+     * @param bitmap Asset
+     * @param x Left edge on the panel
+     * @param y Top edge on the panel
+     * @return false if the data ends before the image does (what was decoded is drawn); only
+     *         checked as far as the page reaches
+     */
+    static bool draw(const RasterTarget &target, const PackedBitmap &bitmap, int16_t x, int16_t y);
+};
+
+#endif // PACKED_BITMAP_H
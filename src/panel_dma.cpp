@@ -0,0 +1,174 @@
+#include "panel_dma.h"
+#include "config.h"
+#include <Arduino.h>
+#include <SPI.h>
+
+// Largest single transfer: one band of the widest window
+const int PANEL_DMA_MAX_TRANSFER = DISPLAY_WIDTH / 8 * DISPLAY_PAGE_ROWS;
+
+bool PanelDma::begin()
+{
+    SPI.end();
+
+    spi_bus_config_t bus = {};
+    bus.mosi_io_num = PIN_MOSI;
+    bus.miso_io_num = -1; // The panel is write-only
+    bus.sclk_io_num = PIN_CLK;
+    bus.quadwp_io_num = -1;
+    bus.quadhd_io_num = -1;
+    bus.max_transfer_sz = PANEL_DMA_MAX_TRANSFER;
+    if (spi_bus_initialize(SPI2_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK)
+    {
+        Serial.println("Panel DMA bus unavailable, streaming through Arduino SPI");
+        SPI.begin(PIN_CLK, PIN_MISO, PIN_MOSI, PIN_CS);
+        return false;
+    }
+
+    spi_device_interface_config_t config = {};
+    config.mode = 0;
+    config.clock_speed_hz = PANEL_SPI_HZ;
+    config.spics_io_num = -1; // CS stays a GPIO, held low across a band stream
+    config.queue_size = 2;    // Both band buffers in flight
+    if (spi_bus_add_device(SPI2_HOST, &config, &device) != ESP_OK)
+    {
+        Serial.println("Panel DMA device unavailable, streaming through Arduino SPI");
+        spi_bus_free(SPI2_HOST);
+        SPI.begin(PIN_CLK, PIN_MISO, PIN_MOSI, PIN_CS);
+        device = nullptr;
+        return false;
+    }
+    spi_device_acquire_bus(device, portMAX_DELAY); // No other device: skip per-transaction arbitration
+    nextTransaction = 0;
+    return true;
+}
+
+void PanelDma::end()
+{
+    if (selected)
+    {
+        digitalWrite(PIN_CS, HIGH);
+        selected = false;
+    }
+    if (device == nullptr)
+    {
+        return;
+    }
+    spi_device_release_bus(device);
+    spi_bus_remove_device(device);
+    spi_bus_free(SPI2_HOST);
+    device = nullptr;
+    SPI.begin(PIN_CLK, PIN_MISO, PIN_MOSI, PIN_CS);
+}
+
+PanelSpi PanelDma::port()
+{
+    return {this, command, data, queue, waitOldest};
+}
+
+bool PanelDma::waitIdle(uint32_t timeoutMs)
+{
+    // BUSY is low while the controller drives the panel
+    delay(1);
+    uint32_t start = millis();
+    while (digitalRead(PIN_BUSY) == LOW)
+    {
+        if (millis() - start > timeoutMs)
+        {
+            Serial.println("Panel busy timeout");
+            return false;
+        }
+        delay(1);
+    }
+    return true;
+}
+
+void PanelDma::select(bool dataMode)
+{
+    digitalWrite(PIN_DC, dataMode ? HIGH : LOW);
+    digitalWrite(PIN_CS, LOW);
+}
+
+void PanelDma::command(void *context, uint8_t command)
+{
+    PanelDma *self = (PanelDma *)context;
+    if (self->selected)
+    {
+        // End of a data stream; BandTransfer only sends commands once it has drained
+        digitalWrite(PIN_CS, HIGH);
+        self->selected = false;
+    }
+    self->select(false);
+    if (self->device != nullptr)
+    {
+        spi_transaction_t t = {};
+        t.flags = SPI_TRANS_USE_TXDATA;
+        t.length = 8;
+        t.tx_data[0] = command;
+        spi_device_polling_transmit(self->device, &t);
+    }
+    else
+    {
+        SPI.beginTransaction(SPISettings(PANEL_SPI_HZ, MSBFIRST, SPI_MODE0));
+        SPI.transfer(command);
+        SPI.endTransaction();
+    }
+    digitalWrite(PIN_CS, HIGH);
+    digitalWrite(PIN_DC, HIGH);
+}
+
+void PanelDma::data(void *context, const uint8_t *bytes, size_t length)
+{
+    PanelDma *self = (PanelDma *)context;
+    self->select(true);
+    if (self->device != nullptr)
+    {
+        spi_transaction_t t = {};
+        t.length = length * 8;
+        t.tx_buffer = bytes;
+        spi_device_polling_transmit(self->device, &t);
+    }
+    else
+    {
+        SPI.beginTransaction(SPISettings(PANEL_SPI_HZ, MSBFIRST, SPI_MODE0));
+        SPI.writeBytes(bytes, length);
+        SPI.endTransaction();
+    }
+    digitalWrite(PIN_CS, HIGH);
+}
+
+void PanelDma::queue(void *context, const uint8_t *bytes, size_t length)
+{
+    PanelDma *self = (PanelDma *)context;
+    if (!self->selected)
+    {
+        self->select(true);
+        self->selected = true;
+    }
+    if (self->device == nullptr)
+    {
+        // No DMA: blocking write, so the band is out before BandTransfer reuses it
+        SPI.beginTransaction(SPISettings(PANEL_SPI_HZ, MSBFIRST, SPI_MODE0));
+        SPI.writeBytes(bytes, length);
+        SPI.endTransaction();
+        return;
+    }
+
+    // Returns once the transfer is queued; the DMA reads the buffer while the CPU moves on
+    spi_transaction_t &t = self->transactions[self->nextTransaction];
+    self->nextTransaction ^= 1;
+    t = {};
+    t.length = length * 8;
+    t.tx_buffer = bytes;
+    spi_device_queue_trans(self->device, &t, portMAX_DELAY);
+}
+
+void PanelDma::waitOldest(void *context)
+{
+    PanelDma *self = (PanelDma *)context;
+    if (self->device == nullptr)
+    {
+        return;
+    }
+    spi_transaction_t *done;
+    spi_device_get_trans_result(self->device, &done, portMAX_DELAY);
+}
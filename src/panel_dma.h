@@ -0,0 +1,31 @@
+#ifndef PANEL_DMA_H
+#define PANEL_DMA_H
+
+#include <driver/spi_master.h>
+#include "band_transfer.h"
+
+// The panel's SPI bus driven by the ESP-IDF SPI master with DMA while a window is streamed.
+// GxEPD2 talks through the Arduino SPI driver, which has no DMA, so begin() takes the bus
+// from it and end() hands it back; CS and DC stay plain GPIOs as GxEPD2 drives them.
+class PanelDma
+{
+public:
+    bool begin(); // false = bus unavailable, Arduino SPI left untouched
+    void end();
+    PanelSpi port();
+    bool waitIdle(uint32_t timeoutMs); // Until the controller releases BUSY after a refresh
+
+private:
+    static void command(void *context, uint8_t command);
+    static void data(void *context, const uint8_t *bytes, size_t length);
+    static void queue(void *context, const uint8_t *bytes, size_t length);
+    static void waitOldest(void *context);
+    void select(bool dataMode);
+
+    spi_device_handle_t device = nullptr;
+    spi_transaction_t transactions[2] = {};
+    int nextTransaction = 0;
+    bool selected = false; // CS low with DC high: a data stream is open
+};
+
+#endif // PANEL_DMA_H
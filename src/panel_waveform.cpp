@@ -0,0 +1,59 @@
+#include "panel_waveform.h"
+#include <cstring>
+
+// Phase level selects, 2 bits per phase (A in the top bits): 00 GND, 01 VDH, 10 VDL, 11 VDHR.
+// VDH pulls a pixel to black and VDL to white.
+const uint8_t LEVEL_PHASE_A_BLACK = 0x40;
+const uint8_t LEVEL_PHASE_A_WHITE = 0x80;
+const uint8_t LEVEL_NONE = 0x00;
+
+void PanelWaveform::fastLuts(uint8_t frames, uint8_t luts[PANEL_LUT_COUNT][PANEL_LUT_MAX_BYTES])
+{
+    // One group, one phase: changing pixels driven straight to their new colour, unchanged
+    // ones and VCOM held at ground for the same time. Groups after the first are unused.
+    const uint8_t levels[PANEL_LUT_COUNT] = {LEVEL_NONE, LEVEL_NONE, LEVEL_PHASE_A_WHITE, LEVEL_PHASE_A_BLACK,
+                                             LEVEL_NONE};
+    for (int i = 0; i < PANEL_LUT_COUNT; i++)
+    {
+        memset(luts[i], 0, PANEL_LUT_MAX_BYTES);
+        luts[i][0] = levels[i];
+        luts[i][1] = frames;
+        luts[i][5] = 1; // Repeat once
+    }
+}
+
+void PanelWaveform::loadFast(const PanelSpi &spi, uint8_t frames)
+{
+    uint8_t luts[PANEL_LUT_COUNT][PANEL_LUT_MAX_BYTES];
+    fastLuts(frames, luts);
+
+    const uint8_t setting = PANEL_SETTING_LUT_REGISTER;
+    spi.command(spi.context, PANEL_CMD_PANEL_SETTING);
+    spi.data(spi.context, &setting, 1);
+    for (int i = 0; i < PANEL_LUT_COUNT; i++)
+    {
+        spi.command(spi.context, (uint8_t)(PANEL_CMD_LUT_VCOM + i));
+        spi.data(spi.context, luts[i], PANEL_LUT_BYTES[i]);
+    }
+}
+
+void PanelWaveform::selectFull(const PanelSpi &spi)
+{
+    const uint8_t setting = PANEL_SETTING_LUT_OTP;
+    const uint8_t sensed = 0x00;
+    spi.command(spi.context, PANEL_CMD_PANEL_SETTING);
+    spi.data(spi.context, &setting, 1);
+    spi.command(spi.context, PANEL_CMD_CASCADE);
+    spi.data(spi.context, &sensed, 1);
+}
+
+void PanelWaveform::startRefresh(const PanelSpi &spi, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    BandTransfer::partialWindow(spi, x, y, w, h);
+    spi.command(spi.context, PANEL_CMD_REFRESH);
+}
+
+void PanelWaveform::endRefresh(const PanelSpi &spi)
+{
+    spi.command(spi.context, PANEL_CMD_PARTIAL_OUT);
+}
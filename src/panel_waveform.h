@@ -0,0 +1,63 @@
+#ifndef PANEL_WAVEFORM_H
+#define PANEL_WAVEFORM_H
+
+#include <cstdint>
+#include "band_transfer.h"
+
+// UC8179 commands for choosing the refresh waveform
+#define PANEL_CMD_PANEL_SETTING 0x00
+#define PANEL_CMD_REFRESH 0x12
+#define PANEL_CMD_LUT_VCOM 0x20
+#define PANEL_CMD_LUT_WW 0x21 // White to white
+#define PANEL_CMD_LUT_KW 0x22 // Black to white
+#define PANEL_CMD_LUT_WK 0x23 // White to black
+#define PANEL_CMD_LUT_KK 0x24 // Black to black
+#define PANEL_CMD_CASCADE 0xE0 // Bit 1 (TSFIX): use the forced temperature instead of the sensor
+#define PANEL_SETTING_LUT_OTP 0x1F      // KW mode, waveform from OTP: the full, flashing update
+#define PANEL_SETTING_LUT_REGISTER 0x3F // KW mode, waveform from the LUT registers
+
+// LUT register sizes: groups of 6 bytes (phase levels, 4 phase lengths in frames, repeat)
+const int PANEL_LUT_COUNT = 5; // VCOM, WW, KW, WK, KK
+const int PANEL_LUT_BYTES[PANEL_LUT_COUNT] = {60, 42, 60, 60, 60};
+const int PANEL_LUT_MAX_BYTES = 60;
+
+enum RefreshWaveform : uint8_t
+{
+    WAVEFORM_STOCK = 0, // GxEPD2's partial update LUT
+    WAVEFORM_FAST,      // Short custom LUT: one drive phase, more ghosting
+    WAVEFORM_CLEANUP    // Full OTP waveform over the region only
+};
+
+// Fast partial refresh for regions that only flip a few black-on-white shapes (the clock
+// digits): a custom LUT with a single drive phase instead of GxEPD2's general-purpose one.
+// RefreshLedger decides when a region has collected enough ghosting for the full waveform.
+// Builds LUT bytes and command sequences; they reach the controller through PanelSpi.
+class PanelWaveform
+{
+public:
+    /**
+     * The fast LUTs, in PANEL_CMD_LUT_VCOM..KK order
+     * @param frames Length of the drive phase in controller frames
+     * @param luts Filled, PANEL_LUT_BYTES[i] bytes each
+     */
+    static void fastLuts(uint8_t frames, uint8_t luts[PANEL_LUT_COUNT][PANEL_LUT_MAX_BYTES]);
+
+    /**
+     * Switch the controller to register LUTs and load the fast ones
+     */
+    static void loadFast(const PanelSpi &spi, uint8_t frames);
+
+    /**
+     * Switch the controller to its OTP (full) waveform at the sensed temperature; GxEPD2's
+     * partial init forces a hot one so the OTP waveform runs short
+     */
+    static void selectFull(const PanelSpi &spi);
+
+    /**
+     * Start refreshing a window with the selected waveform; wait for BUSY, then endRefresh()
+     */
+    static void startRefresh(const PanelSpi &spi, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    static void endRefresh(const PanelSpi &spi);
+};
+
+#endif // PANEL_WAVEFORM_H
@@ -0,0 +1,176 @@
+#include "power_governor.h"
+#include "config.h"
+#include <cstring>
+
+// Trend must cover at least this long before the governor acts on it
+const int MIN_TREND_SECONDS = 60 * 60;
+// Samples needed at the current level before stepping again (lets the new trend settle)
+const int MIN_SAMPLES_AT_LEVEL = 3;
+// Battery floors that force a minimum level regardless of trend (tenths of a percent)
+const int SAVER_FLOOR_X10 = 100;
+const int CRITICAL_FLOOR_X10 = 50;
+
+void PowerGovernor::reset(PowerGovernorState &state, time_t now)
+{
+    memset(&state, 0, sizeof(state));
+    state.startTime = now;
+    state.level = POWER_NORMAL;
+}
+
+bool PowerGovernor::recordSample(PowerGovernorState &state, time_t now, int batteryPercentX10, int sampleInterval)
+{
+    if (state.sampleCount > 0)
+    {
+        int last = (state.sampleHead + POWER_SAMPLE_COUNT - 1) % POWER_SAMPLE_COUNT;
+        if (now - state.sampleTimes[last] < sampleInterval)
+        {
+            return false;
+        }
+    }
+
+    state.sampleTimes[state.sampleHead] = now;
+    state.samplePercentX10[state.sampleHead] = (int16_t)batteryPercentX10;
+    state.sampleHead = (state.sampleHead + 1) % POWER_SAMPLE_COUNT;
+    if (state.sampleCount < POWER_SAMPLE_COUNT)
+    {
+        state.sampleCount++;
+    }
+    if (state.samplesSinceChange < 255)
+    {
+        state.samplesSinceChange++;
+    }
+    return true;
+}
+
+int PowerGovernor::dischargeRateX10(const PowerGovernorState &state, int window)
+{
+    int n = (window < state.sampleCount) ? window : state.sampleCount;
+    if (n < 2)
+    {
+        return 0;
+    }
+
+    // Oldest sample in the window is the time origin, keeps the sums small
+    int first = (state.sampleHead + POWER_SAMPLE_COUNT - n) % POWER_SAMPLE_COUNT;
+    time_t origin = state.sampleTimes[first];
+
+    int64_t sumT = 0, sumP = 0, sumTT = 0, sumTP = 0;
+    for (int i = 0; i < n; i++)
+    {
+        int idx = (first + i) % POWER_SAMPLE_COUNT;
+        int64_t t = (int64_t)(state.sampleTimes[idx] - origin);
+        int64_t p = state.samplePercentX10[idx];
+        sumT += t;
+        sumP += p;
+        sumTT += t * t;
+        sumTP += t * p;
+    }
+
+    int64_t denom = n * sumTT - sumT * sumT;
+    if (denom == 0)
+    {
+        return 0;
+    }
+
+    // Slope is in tenths of a percent per second; negate so draining is positive
+    int64_t numer = n * sumTP - sumT * sumP;
+    return (int)(-numer * 3600 / denom);
+}
+
+PowerLevel PowerGovernor::update(PowerGovernorState &state, time_t now, int targetRuntimeHours)
+{
+    if (state.sampleCount == 0)
+    {
+        return (PowerLevel)state.level;
+    }
+
+    int newest = (state.sampleHead + POWER_SAMPLE_COUNT - 1) % POWER_SAMPLE_COUNT;
+    int percentX10 = state.samplePercentX10[newest];
+
+    // Hard floors: a nearly empty battery never runs at full rate
+    int floorLevel = POWER_NORMAL;
+    if (percentX10 <= CRITICAL_FLOOR_X10)
+    {
+        floorLevel = POWER_CRITICAL;
+    }
+    else if (percentX10 <= SAVER_FLOOR_X10)
+    {
+        floorLevel = POWER_SAVER;
+    }
+
+    int level = state.level;
+    time_t targetEnd = state.startTime + (time_t)targetRuntimeHours * 3600;
+    time_t remaining = targetEnd - now;
+
+    // Only judge the trend measured at the current level
+    int window = state.samplesSinceChange + 1;
+    if (window > state.sampleCount)
+    {
+        window = state.sampleCount;
+    }
+    int oldest = (state.sampleHead + POWER_SAMPLE_COUNT - window) % POWER_SAMPLE_COUNT;
+    bool trendReady = state.samplesSinceChange >= MIN_SAMPLES_AT_LEVEL &&
+                      (state.sampleTimes[newest] - state.sampleTimes[oldest]) >= MIN_TREND_SECONDS;
+
+    if (remaining <= 0)
+    {
+        // Target already met - nothing left to protect
+        level = POWER_NORMAL;
+    }
+    else if (trendReady)
+    {
+        int rateX10 = dischargeRateX10(state, window);
+        if (rateX10 <= 0)
+        {
+            // Flat or charging: relax one step
+            if (level > POWER_NORMAL)
+            {
+                level--;
+            }
+        }
+        else
+        {
+            int64_t projected = (int64_t)percentX10 * 3600 / rateX10;
+            if (projected < remaining)
+            {
+                if (level < POWER_CRITICAL)
+                {
+                    level++;
+                }
+            }
+            else if (projected > (int64_t)remaining * 5 / 4 && level > POWER_NORMAL)
+            {
+                // 25% headroom before relaxing avoids flapping between levels
+                level--;
+            }
+        }
+    }
+
+    if (level < floorLevel)
+    {
+        level = floorLevel;
+    }
+
+    if (level != state.level)
+    {
+        state.level = (uint8_t)level;
+        state.samplesSinceChange = 0;
+    }
+    return (PowerLevel)state.level;
+}
+
+PowerPolicy PowerGovernor::policyFor(PowerLevel level)
+{
+    switch (level)
+    {
+    case POWER_ECO:
+        return {1, 60 * 60, 5};
+    case POWER_SAVER:
+        return {2, 2 * 60 * 60, 5};
+    case POWER_CRITICAL:
+        return {5, 4 * 60 * 60, 10};
+    case POWER_NORMAL:
+    default:
+        return {WAKEUP_INTERVAL_MINUTES, WEATHER_UPDATE_INTERVAL, 1};
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef POWER_GOVERNOR_H
+#define POWER_GOVERNOR_H
+
+#include <ctime>
+#include <cstdint>
+
+// Number of battery samples kept in RTC memory for the discharge trend
+#define POWER_SAMPLE_COUNT 8
+
+// Power levels, from full features down to bare minimum
+enum PowerLevel : uint8_t
+{
+    POWER_NORMAL = 0,
+    POWER_ECO,
+    POWER_SAVER,
+    POWER_CRITICAL
+};
+
+// What the firmware is allowed to do at a given power level
+struct PowerPolicy
+{
+    int clockIntervalMinutes;   // Clock redraw granularity (1 = every minute)
+    int weatherIntervalSeconds; // Minimum time between weather fetches
+    int batteryRedrawStep;      // Redraw battery only when the shown percent moves by this much
+};
+
+// Governor state - must be plain data so it can live in RTC memory
+struct PowerGovernorState
+{
+    time_t startTime;                             // When the runtime target started counting (fresh boot)
+    time_t sampleTimes[POWER_SAMPLE_COUNT];       // Ring of sample timestamps
+    int16_t samplePercentX10[POWER_SAMPLE_COUNT]; // Ring of battery readings in tenths of a percent
+    uint8_t sampleCount;                          // Valid samples in the ring
+    uint8_t sampleHead;                           // Next slot to write
+    uint8_t samplesSinceChange;                   // Samples recorded since the level last changed
+    uint8_t level;                                // Current PowerLevel
+};
+
+// Closed-loop governor that trades update frequency for battery life.
+// Takes the battery readings and the clock as arguments; the state lives in RTC memory in main.cpp.
+
+class PowerGovernor
+{
+public:
+    /**
+     * Start a new runtime target (fresh boot or battery swap)
+     * @param state Governor state to reset
+     * @param now Current epoch time
+     */
+    static void reset(PowerGovernorState &state, time_t now);
+
+    /**
+     * Record a battery reading if at least sampleInterval has passed since the last one
+     * @param state Governor state
+     * @param now Current epoch time
+     * @param batteryPercentX10 Battery in tenths of a percent, from readDeviceBattery
+     * @param sampleInterval Minimum seconds between samples (e.g., 30 * 60)
+     * @return true if the sample was stored
+     */
+    static bool recordSample(PowerGovernorState &state, time_t now, int batteryPercentX10, int sampleInterval);
+
+    /**
+     * Least-squares discharge rate over the most recent samples
+     * @param state Governor state
+     * @param window Number of most recent samples to fit (capped at sampleCount)
+     * @return Discharge in tenths of a percent per hour (positive = draining)
+     */
+    static int dischargeRateX10(const PowerGovernorState &state, int window = POWER_SAMPLE_COUNT);
+
+    /**
+     * Re-evaluate the power level against the runtime target
+     * @param state Governor state (level is updated in place)
+     * @param now Current epoch time
+     * @param targetRuntimeHours Desired runtime from startTime
+     * @return The new power level
+     */
+    static PowerLevel update(PowerGovernorState &state, time_t now, int targetRuntimeHours);
+
+    /**
+     * Map a power level to update intervals and refresh policy
+     * @param level Power level
+     * @return Policy for that level
+     */
+    static PowerPolicy policyFor(PowerLevel level);
+};
+
+#endif // POWER_GOVERNOR_H
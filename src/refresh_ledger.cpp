@@ -0,0 +1,125 @@
+#include "refresh_ledger.h"
+
+static uint8_t fastBit(int region)
+{
+    const uint8_t leftPane[] = {FAST_CLOCK_TIME, FAST_CLOCK_DATE, FAST_BATTERY};
+    return region < PANEL_REGION_WEATHER_FIRST ? leftPane[region] : FAST_WEATHER;
+}
+
+static bool contains(const ScreenRect &outer, const ScreenRect &inner)
+{
+    return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.w <= outer.x + outer.w &&
+           inner.y + inner.h <= outer.y + outer.h;
+}
+
+ScreenRect RefreshLedger::regionRect(int region)
+{
+    switch (region)
+    {
+    case PANEL_REGION_CLOCK_TIME:
+        return CLOCK_TIME_RECT;
+    case PANEL_REGION_CLOCK_DATE:
+        return CLOCK_DATE_RECT;
+    case PANEL_REGION_BATTERY:
+        return BATTERY_RECT;
+    default:
+        return WeatherDiff::regionRect(region - PANEL_REGION_WEATHER_FIRST);
+    }
+}
+
+uint32_t RefreshLedger::regionsIn(const ScreenRect &window)
+{
+    uint32_t regions = 0;
+    for (int region = 0; region < PANEL_REGION_COUNT; region++)
+    {
+        ScreenRect rect = regionRect(region);
+        int cx = rect.x + rect.w / 2;
+        int cy = rect.y + rect.h / 2;
+        if (cx >= window.x && cx < window.x + window.w && cy >= window.y && cy < window.y + window.h)
+        {
+            regions |= 1u << region;
+        }
+    }
+    return regions;
+}
+
+RefreshWaveform RefreshLedger::waveformFor(const ScreenRect &window, uint8_t fastRegions)
+{
+    uint32_t regions = regionsIn(window);
+    if (regions == 0)
+    {
+        return WAVEFORM_STOCK;
+    }
+    for (int region = 0; region < PANEL_REGION_COUNT; region++)
+    {
+        if ((regions & (1u << region)) && (fastRegions & fastBit(region)) == 0)
+        {
+            return WAVEFORM_STOCK;
+        }
+    }
+    return WAVEFORM_FAST;
+}
+
+void RefreshLedger::record(RefreshLedgerState &state, const ScreenRect &window, RefreshWaveform waveform, int fastCost)
+{
+    if (waveform == WAVEFORM_CLEANUP)
+    {
+        // Only what the full waveform drove end to end is clean; a region it clipped keeps its count
+        for (int region = 0; region < PANEL_REGION_COUNT; region++)
+        {
+            if (contains(window, regionRect(region)))
+            {
+                state.ghosting[region] = 0;
+            }
+        }
+        return;
+    }
+
+    int cost = waveform == WAVEFORM_FAST ? fastCost : 1;
+    uint32_t regions = regionsIn(window);
+    for (int region = 0; region < PANEL_REGION_COUNT; region++)
+    {
+        if (regions & (1u << region))
+        {
+            int ghosting = state.ghosting[region] + cost;
+            state.ghosting[region] = ghosting > 255 ? 255 : ghosting;
+        }
+    }
+}
+
+bool RefreshLedger::quietHour(int hour, int start, int end)
+{
+    if (start <= end)
+    {
+        return hour >= start && hour < end;
+    }
+    return hour >= start || hour < end;
+}
+
+uint32_t RefreshLedger::dueForCleanup(const RefreshLedgerState &state, int hour, int budget, int limit,
+                                      int quietStart, int quietEnd)
+{
+    int threshold = quietHour(hour, quietStart, quietEnd) ? budget : limit;
+    uint32_t due = 0;
+    for (int region = 0; region < PANEL_REGION_COUNT; region++)
+    {
+        if (state.ghosting[region] >= threshold)
+        {
+            due |= 1u << region;
+        }
+    }
+    return due;
+}
+
+int RefreshLedger::cleanupRects(uint32_t due, ScreenRect *rects)
+{
+    int count = 0;
+    for (int region = 0; region < PANEL_REGION_COUNT; region++)
+    {
+        if (due & (1u << region))
+        {
+            rects[count++] = regionRect(region);
+        }
+    }
+    return WeatherDiff::mergeRects(rects, count);
+}
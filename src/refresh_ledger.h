@@ -0,0 +1,99 @@
+#ifndef REFRESH_LEDGER_H
+#define REFRESH_LEDGER_H
+
+#include <cstdint>
+#include "config.h"
+#include "panel_waveform.h"
+#include "weather_diff.h"
+
+// Left pane areas, 8-px aligned
+const ScreenRect CLOCK_TIME_RECT = {0, 80, DISPLAY_LEFT_HALF, 144};
+const ScreenRect CLOCK_DATE_RECT = {0, 216, DISPLAY_LEFT_HALF, 144}; // Day, date and daylight line
+const ScreenRect BATTERY_RECT = {0, 400, 200, 80};
+
+// Panel areas that wear (and get cleaned up) on their own
+enum PanelRegion : uint8_t
+{
+    PANEL_REGION_CLOCK_TIME = 0,
+    PANEL_REGION_CLOCK_DATE,
+    PANEL_REGION_BATTERY,
+    PANEL_REGION_WEATHER_FIRST, // WEATHER_REGION_COUNT regions, in WeatherRegion order
+    PANEL_REGION_COUNT = PANEL_REGION_WEATHER_FIRST + WEATHER_REGION_COUNT
+};
+
+// Bits of FAST_WAVEFORM_REGIONS; the weather bit covers every weather region
+const uint8_t FAST_CLOCK_TIME = 1;
+const uint8_t FAST_CLOCK_DATE = 2;
+const uint8_t FAST_BATTERY = 4;
+const uint8_t FAST_WEATHER = 8;
+
+// Ghosting each region has collected since it was last driven with the full waveform -
+// must be plain data so it can live in RTC memory
+struct RefreshLedgerState
+{
+    uint8_t ghosting[PANEL_REGION_COUNT]; // Refresh cost, saturating
+};
+
+// Per-region refresh accounting. Every partial refresh adds to the regions its window covers
+// (a fast-waveform one more than a stock one); a region over its budget gets a full-waveform
+// refresh of just its own rectangle, in quiet hours unless it is over the hard limit.
+// Bookkeeping over rectangles only; DisplayManager drives the actual refreshes.
+class RefreshLedger
+{
+public:
+    /**
+     * Screen rectangle of one region, 8-px aligned
+     * @param region PanelRegion index
+     */
+    static ScreenRect regionRect(int region);
+
+    /**
+     * Regions a refresh window counts against: those whose centre it covers, so a neighbour
+     * the window only clips by a few alignment rows is left alone
+     * @return Bitmask of PanelRegion bits
+     */
+    static uint32_t regionsIn(const ScreenRect &window);
+
+    /**
+     * Waveform for a partial refresh of window: fast only when every region it covers may use it
+     * @param fastRegions FAST_* bits
+     */
+    static RefreshWaveform waveformFor(const ScreenRect &window, uint8_t fastRegions);
+
+    /**
+     * Account for a refresh that has just run
+     * @param state Ledger, updated
+     * @param window Refreshed window
+     * @param waveform How it was driven; a cleanup clears the regions it fully covers
+     * @param fastCost Ghosting of a fast refresh, in stock partial refreshes
+     */
+    static void record(RefreshLedgerState &state, const ScreenRect &window, RefreshWaveform waveform, int fastCost);
+
+    /**
+     * Whether hour falls in [start, end), wrapping past midnight (start > end)
+     */
+    static bool quietHour(int hour, int start, int end);
+
+    /**
+     * Regions that need a cleanup now
+     * @param state Ledger
+     * @param hour Local hour
+     * @param budget Ghosting a region may collect before it is cleaned in quiet hours
+     * @param limit Ghosting at which it is cleaned whatever the hour
+     * @param quietStart First quiet hour
+     * @param quietEnd Hour quiet hours end
+     * @return Bitmask of PanelRegion bits (0 = nothing due)
+     */
+    static uint32_t dueForCleanup(const RefreshLedgerState &state, int hour, int budget, int limit, int quietStart,
+                                  int quietEnd);
+
+    /**
+     * Turn a due mask into cleanup windows, merged like weather refresh windows
+     * @param due Bitmask from dueForCleanup
+     * @param rects Output array with room for PANEL_REGION_COUNT rectangles
+     * @return Number of windows written
+     */
+    static int cleanupRects(uint32_t due, ScreenRect *rects);
+};
+
+#endif // REFRESH_LEDGER_H
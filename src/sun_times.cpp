@@ -0,0 +1,257 @@
+#include "sun_times.h"
+
+const int32_t DEGREE = 1 << 20; // Q20
+const int32_t ONE = 1 << 30;    // Q30
+
+const int64_t DAY_MS = 86400000;
+const int64_t J2000_MS = 946728000000LL; // 2000-01-01 12:00 UTC
+const int64_t FULL_TURN_NANO = 360000000000LL;
+
+const int32_t CORDIC_GAIN = 652032874;            // prod 1/sqrt(1 + 2^-2i), Q30
+const int32_t SIN_AXIAL_TILT = 427116999;         // sin(23.4397 deg), Q30
+const int32_t SIN_HORIZON = -15610145;            // sin(-0.833 deg): refraction + solar radius, Q30
+
+// atan(2^-i) in degrees, Q20
+static const int32_t CORDIC_ANGLES[] = {47185920, 27855475, 14718068, 7471121, 3750058, 1876857,
+                                        938658,   469357,   234682,   117342,  58671,   29335,
+                                        14668,    7334,     3667,     1833,    917,     458,
+                                        229,      115,      57,       29,      14,      7};
+const int CORDIC_STEPS = sizeof(CORDIC_ANGLES) / sizeof(CORDIC_ANGLES[0]);
+
+static int64_t floorDiv(int64_t a, int64_t b)
+{
+    int64_t q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+static int64_t floorMod(int64_t a, int64_t b)
+{
+    return a - floorDiv(a, b) * b;
+}
+
+static int32_t nanoToQ20(int64_t nanoDegrees)
+{
+    return (int32_t)(nanoDegrees * DEGREE / 1000000000LL);
+}
+
+static uint32_t isqrt64(uint64_t value)
+{
+    // Bit-by-bit square root, floor
+    uint64_t result = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > value)
+        bit >>= 2;
+    while (bit != 0)
+    {
+        if (value >= result + bit)
+        {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)result;
+}
+
+// sqrt(1 - v^2) for |v| <= 1, all Q30
+static int32_t complement(int32_t v)
+{
+    int64_t square = (int64_t)v * v;
+    uint64_t rest = (1ULL << 60) > (uint64_t)square ? (1ULL << 60) - (uint64_t)square : 0;
+    return (int32_t)isqrt64(rest);
+}
+
+static void rotate(int32_t angle, int32_t &sine, int32_t &cosine)
+{
+    // Fold into -180..180, then into -90..90 where CORDIC converges
+    int32_t a = (int32_t)floorMod((int64_t)angle + 180 * DEGREE, 360 * DEGREE) - 180 * DEGREE;
+    bool flip = false;
+    if (a > 90 * DEGREE)
+    {
+        a -= 180 * DEGREE;
+        flip = true;
+    }
+    else if (a < -90 * DEGREE)
+    {
+        a += 180 * DEGREE;
+        flip = true;
+    }
+
+    int32_t x = CORDIC_GAIN;
+    int32_t y = 0;
+    for (int i = 0; i < CORDIC_STEPS; i++)
+    {
+        int32_t dx = y >> i;
+        int32_t dy = x >> i;
+        if (a >= 0)
+        {
+            x -= dx;
+            y += dy;
+            a -= CORDIC_ANGLES[i];
+        }
+        else
+        {
+            x += dx;
+            y -= dy;
+            a += CORDIC_ANGLES[i];
+        }
+    }
+    sine = flip ? -y : y;
+    cosine = flip ? -x : x;
+}
+
+int32_t SunTimes::sinQ30(int32_t angle)
+{
+    int32_t s, c;
+    rotate(angle, s, c);
+    return s;
+}
+
+int32_t SunTimes::cosQ30(int32_t angle)
+{
+    int32_t s, c;
+    rotate(angle, s, c);
+    return c;
+}
+
+int32_t SunTimes::atan2Q20(int32_t y, int32_t x)
+{
+    if (x == 0 && y == 0)
+    {
+        return 0;
+    }
+    if (x < 0)
+    {
+        // Mirror into the right half-plane
+        int32_t mirrored = atan2Q20(y, x == INT32_MIN ? INT32_MAX : -x);
+        return (y >= 0 ? 180 * DEGREE : -180 * DEGREE) - mirrored;
+    }
+
+    // Vectoring grows the vector by 1/CORDIC_GAIN (1.65), so start from half scale
+    int32_t vx = x >> 1;
+    int32_t vy = y >> 1;
+    int32_t angle = 0;
+    for (int i = 0; i < CORDIC_STEPS; i++)
+    {
+        int32_t dx = vy >> i;
+        int32_t dy = vx >> i;
+        if (vy > 0)
+        {
+            vx += dx;
+            vy -= dy;
+            angle += CORDIC_ANGLES[i];
+        }
+        else
+        {
+            vx -= dx;
+            vy += dy;
+            angle -= CORDIC_ANGLES[i];
+        }
+    }
+    return angle;
+}
+
+void SunTimes::compute(int32_t latitudeMicro, int32_t longitudeMicro, time_t noon, SunDay &day)
+{
+    // Mean solar noon nearest to the given time: J* = n - longitude / 360
+    int64_t longitudeMs = (int64_t)longitudeMicro * 24 / 100; // 240 s per degree
+    int64_t sinceJ2000 = (int64_t)noon * 1000 - J2000_MS;
+    int64_t n = floorDiv(sinceJ2000 + longitudeMs + DAY_MS / 2, DAY_MS);
+    int64_t meanNoon = n * DAY_MS - longitudeMs;
+
+    // Mean anomaly M = 357.5291 + 0.98560028 * J* (nano-degrees, whole days and remainder kept
+    // apart so the product stays within 64 bits)
+    int64_t days = floorDiv(meanNoon, DAY_MS);
+    int64_t rest = meanNoon - days * DAY_MS;
+    int64_t anomalyNano = floorMod(357529100000LL + 985600280LL * days + 985600280LL * rest / DAY_MS, FULL_TURN_NANO);
+    int32_t anomaly = nanoToQ20(anomalyNano);
+    int32_t sinAnomaly = sinQ30(anomaly);
+
+    // Equation of the center, ecliptic longitude
+    int64_t centerNano = (1914800000LL * sinAnomaly + 20000000LL * sinQ30(2 * anomaly) +
+                          300000LL * sinQ30(3 * anomaly)) >> 30;
+    int32_t eclipticLongitude = nanoToQ20(floorMod(anomalyNano + centerNano + 282937200000LL, FULL_TURN_NANO));
+
+    // Solar transit: 0.0053 and 0.0069 of a day are 457.92 s and 596.16 s
+    int64_t transit = meanNoon + ((457920LL * sinAnomaly) >> 30) -
+                      ((596160LL * sinQ30(2 * eclipticLongitude)) >> 30);
+
+    // Declination, then the hour angle where the sun's centre is 0.833 deg below the horizon
+    int32_t sinDeclination = (int32_t)(((int64_t)sinQ30(eclipticLongitude) * SIN_AXIAL_TILT) >> 30);
+    int32_t cosDeclination = complement(sinDeclination);
+    int32_t latitude = (int32_t)((int64_t)latitudeMicro * DEGREE / 1000000);
+    int32_t sinLatitude, cosLatitude;
+    rotate(latitude, sinLatitude, cosLatitude);
+
+    int64_t numerator = SIN_HORIZON - (((int64_t)sinLatitude * sinDeclination) >> 30);
+    int64_t denominator = ((int64_t)cosLatitude * cosDeclination) >> 30;
+    day.sunrise = 0;
+    day.sunset = 0;
+    if (numerator >= denominator)
+    {
+        day.polar = SUN_POLAR_NIGHT;
+        return;
+    }
+    if (numerator <= -denominator)
+    {
+        day.polar = SUN_MIDNIGHT_SUN;
+        return;
+    }
+
+    int32_t cosHourAngle = (int32_t)(numerator * ONE / denominator);
+    int32_t hourAngle = atan2Q20(complement(cosHourAngle), cosHourAngle); // 0..180 deg
+    int64_t halfDay = ((int64_t)hourAngle * 240000) >> 20;                 // 240 s per degree
+
+    day.polar = SUN_RISES_AND_SETS;
+    day.sunrise = (time_t)floorDiv(J2000_MS + transit - halfDay + 500, 1000);
+    day.sunset = (time_t)floorDiv(J2000_MS + transit + halfDay + 500, 1000);
+}
+
+int32_t SunTimes::parseMicroDegrees(const char *text)
+{
+    bool negative = false;
+    if (*text == '-' || *text == '+')
+    {
+        negative = *text == '-';
+        text++;
+    }
+
+    int64_t value = 0;
+    while (*text >= '0' && *text <= '9')
+    {
+        value = value * 10 + (*text++ - '0');
+    }
+    value *= 1000000;
+
+    if (*text == '.')
+    {
+        text++;
+        int64_t scale = 100000;
+        for (int digits = 0; *text >= '0' && *text <= '9'; digits++, text++)
+        {
+            if (digits < 6)
+            {
+                value += (*text - '0') * scale;
+                scale /= 10;
+            }
+            else if (digits == 6 && *text >= '5')
+            {
+                value++; // Round on the seventh digit
+            }
+        }
+    }
+    return (int32_t)(negative ? -value : value);
+}
+
+int SunTimes::dayLengthMinutes(const SunDay &day)
+{
+    if (day.polar == SUN_POLAR_NIGHT)
+        return 0;
+    if (day.polar == SUN_MIDNIGHT_SUN)
+        return 24 * 60;
+    return (int)((day.sunset - day.sunrise + 30) / 60);
+}
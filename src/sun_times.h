@@ -0,0 +1,70 @@
+#ifndef SUN_TIMES_H
+#define SUN_TIMES_H
+
+#include <cstdint>
+#include <ctime>
+
+// Sun above the horizon or not for the whole day
+enum SunPolar : uint8_t
+{
+    SUN_RISES_AND_SETS = 0,
+    SUN_POLAR_NIGHT,  // Never rises
+    SUN_MIDNIGHT_SUN  // Never sets
+};
+
+// Sunrise and sunset for one local day - plain data so it can be cached in RTC memory
+struct SunDay
+{
+    int32_t dayKey; // Local date as year * 1000 + day of year (0 = not computed)
+    time_t sunrise; // UTC
+    time_t sunset;  // UTC
+    uint8_t polar;  // SunPolar; sunrise/sunset are only set for SUN_RISES_AND_SETS
+};
+
+// Sunrise equation (NOAA's simplified form) in integer fixed point - the C3 has no FPU.
+// Angles are degrees in Q20, sines and cosines Q30, times milliseconds. Accurate to about
+// a minute between the polar circles; refraction and the solar disc are the usual -0.833 deg.
+// Integer inputs and outputs only, checked on host against a double-precision reference.
+
+class SunTimes
+{
+public:
+    /**
+     * Compute one day's sunrise and sunset
+     * @param latitudeMicro Latitude in millionths of a degree (north positive)
+     * @param longitudeMicro Longitude in millionths of a degree (east positive)
+     * @param noon Any time near local noon of the day wanted (UTC epoch)
+     * @param day Output; dayKey is left to the caller
+     */
+    static void compute(int32_t latitudeMicro, int32_t longitudeMicro, time_t noon, SunDay &day);
+
+    /**
+     * Parse a decimal degree string ("45.5152", "-122.6784") without float
+     * @return Millionths of a degree
+     */
+    static int32_t parseMicroDegrees(const char *text);
+
+    /**
+     * Daylight between sunrise and sunset
+     * @return Minutes (0 for polar night, 1440 for midnight sun)
+     */
+    static int dayLengthMinutes(const SunDay &day);
+
+    /**
+     * CORDIC sine and cosine
+     * @param angle Degrees in Q20, any range
+     * @return Q30 (1.0 = 1 << 30)
+     */
+    static int32_t sinQ30(int32_t angle);
+    static int32_t cosQ30(int32_t angle);
+
+    /**
+     * CORDIC atan2
+     * @param y Q30 (or any scale shared with x)
+     * @param x Q30
+     * @return Degrees in Q20, -180..180
+     */
+    static int32_t atan2Q20(int32_t y, int32_t x);
+};
+
+#endif // SUN_TIMES_H
@@ -0,0 +1,277 @@
+#include "telemetry.h"
+
+const uint8_t TELEMETRY_MAGIC_0 = 'T';
+const uint8_t TELEMETRY_MAGIC_1 = 'M';
+
+static int64_t metricsField(const WakeMetrics &m, int field)
+{
+    switch (field)
+    {
+    case 0:
+        return m.startedAt;
+    case 1:
+        return m.awakeMs;
+    case 2:
+        return m.radioMs;
+    case 3:
+        return m.fetchMs;
+    case 4:
+        return m.refreshMs;
+    case 5:
+        return m.batteryX10;
+    case 6:
+        return m.rssi;
+    case 7:
+        return m.kind;
+    case 8:
+        return m.refreshes;
+    case 9:
+        return m.retries;
+    case 10:
+        return m.fetch;
+    default:
+        return m.resetCause;
+    }
+}
+
+static void setMetricsField(WakeMetrics &m, int field, int64_t value)
+{
+    switch (field)
+    {
+    case 0:
+        m.startedAt = (uint32_t)value;
+        break;
+    case 1:
+        m.awakeMs = (uint16_t)value;
+        break;
+    case 2:
+        m.radioMs = (uint16_t)value;
+        break;
+    case 3:
+        m.fetchMs = (uint16_t)value;
+        break;
+    case 4:
+        m.refreshMs = (uint16_t)value;
+        break;
+    case 5:
+        m.batteryX10 = (uint16_t)value;
+        break;
+    case 6:
+        m.rssi = (int8_t)value;
+        break;
+    case 7:
+        m.kind = (uint8_t)value;
+        break;
+    case 8:
+        m.refreshes = (uint8_t)value;
+        break;
+    case 9:
+        m.retries = (uint8_t)value;
+        break;
+    case 10:
+        m.fetch = (uint8_t)value;
+        break;
+    default:
+        m.resetCause = (uint8_t)value;
+        break;
+    }
+}
+
+// Batch being encoded; writes stop (and ok clears) once capacity runs out
+struct TelemetryWriter
+{
+    uint8_t *out;
+    size_t capacity;
+    size_t length;
+    bool ok;
+
+    void byte(uint8_t value)
+    {
+        if (length < capacity)
+            out[length++] = value;
+        else
+            ok = false;
+    }
+
+    void varint(uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            byte((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        byte((uint8_t)value);
+    }
+};
+
+static bool telemetryVarint(const uint8_t *batch, size_t length, size_t &pos, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < length; shift += 7)
+    {
+        uint8_t byte = batch[pos++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Telemetry::reset(TelemetryRing &ring)
+{
+    ring.head = 0;
+    ring.count = 0;
+    ring.dropped = 0;
+}
+
+void Telemetry::record(TelemetryRing &ring, const WakeMetrics &metrics)
+{
+    if (ring.count == TELEMETRY_CAPACITY)
+    {
+        ring.head = (ring.head + 1) % TELEMETRY_CAPACITY;
+        ring.count--;
+        ring.dropped = ring.dropped < 0xFFFF ? ring.dropped + 1 : 0xFFFF;
+    }
+    ring.records[(ring.head + ring.count) % TELEMETRY_CAPACITY] = metrics;
+    ring.count++;
+}
+
+void Telemetry::addMs(uint16_t &field, uint32_t ms)
+{
+    field = ms >= 0xFFFFu - field ? 0xFFFF : (uint16_t)(field + ms);
+}
+
+size_t Telemetry::encode(const TelemetryRing &ring, const uint8_t mac[6], uint8_t *out, size_t capacity,
+                         int &records)
+{
+    records = 0;
+    if (ring.count == 0 || capacity < TELEMETRY_HEADER_SIZE)
+    {
+        return 0;
+    }
+    int count = ring.count < 255 ? ring.count : 255;
+    out[0] = TELEMETRY_MAGIC_0;
+    out[1] = TELEMETRY_MAGIC_1;
+    out[2] = TELEMETRY_VERSION;
+    out[3] = (uint8_t)count;
+    for (int i = 0; i < 6; i++)
+    {
+        out[4 + i] = mac[i];
+    }
+    out[10] = (uint8_t)ring.dropped;
+    out[11] = (uint8_t)(ring.dropped >> 8);
+    TelemetryWriter writer = {out, capacity, TELEMETRY_HEADER_SIZE, true};
+
+    for (int field = 0; field < TELEMETRY_FIELD_COUNT; field++)
+    {
+        int64_t previous = 0, previousDiff = 0;
+        uint32_t zeros = 0;
+        for (int i = 0; i < count; i++)
+        {
+            int64_t value = metricsField(ring.records[(ring.head + i) % TELEMETRY_CAPACITY], field);
+            int64_t diff = value - previous;
+            int64_t residual = field == 0 ? diff - previousDiff : diff;
+            previous = value;
+            previousDiff = diff;
+            if (residual == 0)
+            {
+                zeros++;
+                continue;
+            }
+            if (zeros > 0)
+            {
+                writer.varint(0);
+                writer.varint(zeros - 1);
+                zeros = 0;
+            }
+            writer.varint(((uint64_t)residual << 1) ^ (uint64_t)(residual >> 63)); // Zigzag
+        }
+        if (zeros > 0)
+        {
+            writer.varint(0);
+            writer.varint(zeros - 1);
+        }
+    }
+    if (!writer.ok)
+    {
+        return 0;
+    }
+    records = count;
+    return writer.length;
+}
+
+void Telemetry::acknowledge(TelemetryRing &ring, int records)
+{
+    if (records > ring.count)
+    {
+        records = ring.count;
+    }
+    ring.head = (ring.head + records) % TELEMETRY_CAPACITY;
+    ring.count -= records;
+    ring.dropped = 0;
+}
+
+int Telemetry::decode(const uint8_t *batch, size_t length, uint8_t mac[6], int &dropped, WakeMetrics *records,
+                      int maxRecords)
+{
+    if (length < TELEMETRY_HEADER_SIZE || batch[0] != TELEMETRY_MAGIC_0 || batch[1] != TELEMETRY_MAGIC_1 ||
+        batch[2] != TELEMETRY_VERSION || batch[3] > maxRecords)
+    {
+        return -1;
+    }
+    int count = batch[3];
+    for (int i = 0; i < 6; i++)
+    {
+        mac[i] = batch[4 + i];
+    }
+    dropped = batch[10] | (batch[11] << 8);
+    for (int i = 0; i < count; i++)
+    {
+        records[i] = {};
+    }
+
+    size_t pos = TELEMETRY_HEADER_SIZE;
+    for (int field = 0; field < TELEMETRY_FIELD_COUNT; field++)
+    {
+        int64_t previous = 0, previousDiff = 0;
+        uint64_t zeros = 0;
+        for (int i = 0; i < count; i++)
+        {
+            int64_t residual = 0;
+            if (zeros > 0)
+            {
+                zeros--;
+            }
+            else
+            {
+                uint64_t word;
+                if (!telemetryVarint(batch, length, pos, word))
+                {
+                    return -1;
+                }
+                if (word == 0)
+                {
+                    if (!telemetryVarint(batch, length, pos, zeros) || zeros >= (uint64_t)(count - i))
+                    {
+                        return -1;
+                    }
+                }
+                else
+                {
+                    residual = (int64_t)(word >> 1) ^ -(int64_t)(word & 1);
+                }
+            }
+            int64_t diff = field == 0 ? previousDiff + residual : residual;
+            previous += diff;
+            previousDiff = diff;
+            setMetricsField(records[i], field, previous);
+        }
+        if (zeros > 0)
+        {
+            return -1;
+        }
+    }
+    return pos == length ? count : -1;
+}
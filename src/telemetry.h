@@ -0,0 +1,104 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <cstddef>
+#include <cstdint>
+
+// What started a wake
+enum WakeKind : uint8_t
+{
+    WAKE_CLOCK = 0,  // Minute-boundary wake
+    WAKE_PREFETCH,   // Off-phase weather wake
+    WAKE_FRESH_BOOT  // Any reset that wasn't a deep sleep wake
+};
+
+// One wake's metrics - plain data so it can live in RTC memory
+struct WakeMetrics
+{
+    uint32_t startedAt;  // Unix seconds (0 = clock not set)
+    uint16_t awakeMs;    // Wake to deep sleep
+    uint16_t radioMs;    // WiFi connect and time sync
+    uint16_t fetchMs;    // Weather or frame requests
+    uint16_t refreshMs;  // Panel refreshes
+    uint16_t batteryX10; // Tenths of a percent
+    int8_t rssi;         // dBm (0 = radio not used)
+    uint8_t kind;        // WakeKind
+    uint8_t refreshes;   // Panel refreshes
+    uint8_t retries;     // Extra WiFi, time sync and gateway polls
+    uint8_t fetch;       // FetchResult + 1 of the last fetch (0 = none)
+    uint8_t resetCause;  // BootCause
+};
+
+#define TELEMETRY_CAPACITY 64 // Wakes kept between uploads; the oldest go first when full
+
+// Wakes since the last upload
+struct TelemetryRing
+{
+    uint16_t head;    // Oldest record
+    uint16_t count;
+    uint16_t dropped; // Overwritten before they could be uploaded
+    WakeMetrics records[TELEMETRY_CAPACITY];
+};
+
+// Upload batch, oldest wake first
+//
+//   0  'T' 'M'   magic
+//   2  u8        version
+//   3  u8        record count
+//   4  u8[6]     device MAC
+//   10 u16       wakes dropped since the last upload
+//   12 columns   each WakeMetrics field in turn, for every record: the zigzag LEB128
+//                difference from the previous record's value (startedAt: from the previous
+//                difference, so a steady wake interval costs nothing). A 0 is followed by a
+//                LEB128 count of further zeros.
+//
+// Fields that rarely change (kind, fetch, retries, reset cause) shrink to a few bytes per
+// batch, which is most of the compression.
+
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_HEADER_SIZE 12
+#define TELEMETRY_FIELD_COUNT 12
+#define TELEMETRY_BATCH_MAX (TELEMETRY_HEADER_SIZE + TELEMETRY_CAPACITY * 40) // Worst case
+
+// Wake metrics ring and batch encoding.
+// Works on a caller-owned ring and buffers; NetworkManager posts the batch.
+class Telemetry
+{
+public:
+    static void reset(TelemetryRing &ring);
+
+    /**
+     * Append a finished wake, dropping the oldest if the ring is full
+     */
+    static void record(TelemetryRing &ring, const WakeMetrics &metrics);
+
+    /**
+     * Add elapsed milliseconds to a duration field, saturating
+     */
+    static void addMs(uint16_t &field, uint32_t ms);
+
+    /**
+     * Encode every record in the ring as one batch
+     * @param mac Device MAC
+     * @param records Output number of records in the batch, for acknowledge()
+     * @return Batch length, 0 if the ring is empty or the batch doesn't fit
+     */
+    static size_t encode(const TelemetryRing &ring, const uint8_t mac[6], uint8_t *out, size_t capacity,
+                         int &records);
+
+    /**
+     * The batch was accepted: drop its records
+     */
+    static void acknowledge(TelemetryRing &ring, int records);
+
+    /**
+     * Decode a batch (host collector and tests)
+     * @param mac Output device MAC
+     * @param dropped Output wakes dropped before the batch
+     * @return Records decoded, -1 if the batch is malformed or has more than maxRecords
+     */
+    static int decode(const uint8_t *batch, size_t length, uint8_t mac[6], int &dropped, WakeMetrics *records,
+                      int maxRecords);
+};
+
+#endif // TELEMETRY_H
@@ -0,0 +1,89 @@
+#include "text_format.h"
+
+TextFormat::TextFormat(char *out, size_t size) : out(out), size(size), used(0), overflow(size == 0)
+{
+    if (size > 0)
+    {
+        out[0] = '\0';
+    }
+}
+
+void TextFormat::put(char c)
+{
+    if (used + 1 >= size)
+    {
+        overflow = true;
+        return;
+    }
+    out[used++] = c;
+    out[used] = '\0';
+}
+
+TextFormat &TextFormat::text(const char *value)
+{
+    while (*value != '\0')
+    {
+        put(*value++);
+    }
+    return *this;
+}
+
+TextFormat &TextFormat::integer(int32_t value, int minDigits)
+{
+    // Magnitude as unsigned so INT32_MIN doesn't overflow
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+    char digits[10];
+    int count = 0;
+    do
+    {
+        digits[count++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (value < 0)
+    {
+        put('-');
+    }
+    for (int i = count; i < minDigits; i++)
+    {
+        put('0');
+    }
+    while (count > 0)
+    {
+        put(digits[--count]);
+    }
+    return *this;
+}
+
+TextFormat &TextFormat::whole(int32_t tenths)
+{
+    return integer(roundTenths(tenths));
+}
+
+TextFormat &TextFormat::tenths(int32_t tenths)
+{
+    if (tenths < 0)
+    {
+        put('-');
+    }
+    uint32_t magnitude = tenths < 0 ? 0u - (uint32_t)tenths : (uint32_t)tenths;
+    integer((int32_t)(magnitude / 10));
+    put('.');
+    put((char)('0' + magnitude % 10));
+    return *this;
+}
+
+int32_t TextFormat::roundTenths(int32_t tenths)
+{
+    int32_t whole = tenths / 10;
+    int32_t rest = tenths % 10; // Same sign as tenths
+    if (rest > 5 || (rest == 5 && (whole & 1)))
+    {
+        whole++;
+    }
+    else if (rest < -5 || (rest == -5 && (whole & 1)))
+    {
+        whole--;
+    }
+    return whole;
+}
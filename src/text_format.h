@@ -0,0 +1,57 @@
+#ifndef TEXT_FORMAT_H
+#define TEXT_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Integer-only text building for the panel and the serial log. The C3 has no FPU, so
+// temperatures, PM2.5 and battery stay in tenths from parse to render and never go through
+// "%.0f" (soft-float division and newlib's float printf on every call).
+// Writes into a caller buffer; nothing here allocates or touches the display.
+
+class TextFormat
+{
+public:
+    /**
+     * Start writing at out; the buffer is always NUL-terminated
+     * @param out Output buffer
+     * @param size Room in out, including the terminator
+     */
+    TextFormat(char *out, size_t size);
+
+    TextFormat &text(const char *value);
+
+    /**
+     * Decimal integer
+     * @param minDigits Zero-padded to at least this many digits ("%02d" is 2)
+     */
+    TextFormat &integer(int32_t value, int minDigits = 1);
+
+    // Tenths rounded to a whole number the way "%.0f" prints them (ties to even), minus sign
+    // dropped for zero
+    TextFormat &whole(int32_t tenths);
+
+    // Tenths with one decimal, as "%.1f" prints them
+    TextFormat &tenths(int32_t tenths);
+
+    /**
+     * @return Characters written, 0 if anything was cut off
+     */
+    size_t length() const { return overflow ? 0 : used; }
+
+    /**
+     * Round tenths to the nearest whole number, ties to even (what "%.0f" prints)
+     * @return Whole units
+     */
+    static int32_t roundTenths(int32_t tenths);
+
+private:
+    char *out;
+    size_t size;
+    size_t used;
+    bool overflow;
+
+    void put(char c);
+};
+
+#endif // TEXT_FORMAT_H
@@ -0,0 +1,79 @@
+#include "text_layout.h"
+
+TextExtent TextLayout::measure(const GFXfont *font, const char *text)
+{
+    // Same bookkeeping as Adafruit_GFX::charBounds, including the empty glyph of a space
+    // still moving the box, so centred text lands on the same pixels
+    int16_t minX = 0x7FFF, minY = 0x7FFF, maxX = -1, maxY = -1;
+    int16_t cursor = 0;
+    uint16_t first = font->first;
+    uint16_t last = font->last;
+    const GFXglyph *glyphs = font->glyph;
+
+    for (const uint8_t *c = (const uint8_t *)text; *c != '\0'; c++)
+    {
+        if (*c < first || *c > last)
+        {
+            continue;
+        }
+        const GFXglyph &glyph = glyphs[*c - first];
+        int16_t x1 = cursor + glyph.xOffset;
+        int16_t y1 = glyph.yOffset;
+        int16_t x2 = x1 + glyph.width - 1;
+        int16_t y2 = y1 + glyph.height - 1;
+        if (x1 < minX)
+            minX = x1;
+        if (y1 < minY)
+            minY = y1;
+        if (x2 > maxX)
+            maxX = x2;
+        if (y2 > maxY)
+            maxY = y2;
+        cursor += glyph.xAdvance;
+    }
+
+    TextExtent extent = {0, 0, 0, 0};
+    if (maxX >= minX)
+    {
+        extent.x1 = minX;
+        extent.w = (uint16_t)(maxX - minX + 1);
+    }
+    if (maxY >= minY)
+    {
+        extent.y1 = minY;
+        extent.h = (uint16_t)(maxY - minY + 1);
+    }
+    return extent;
+}
+
+TextExtent TextLayout::measureLabel(TextWidthCache &cache, const GFXfont *font, const char *text)
+{
+    // Direct-mapped on the string address; a collision just measures again
+    uintptr_t key = (uintptr_t)text ^ ((uintptr_t)font >> 4);
+    int slot = (int)((key ^ (key >> 5)) % TEXT_WIDTH_CACHE_SLOTS);
+    if (cache.text[slot] != text || cache.font[slot] != font)
+    {
+        cache.font[slot] = font;
+        cache.text[slot] = text;
+        cache.extent[slot] = measure(font, text);
+    }
+    return cache.extent[slot];
+}
+
+void TextLayout::fontRows(const GFXfont *font, int16_t &top, int16_t &bottom)
+{
+    top = 0;
+    bottom = 0;
+    for (int i = 0; i <= font->last - font->first; i++)
+    {
+        const GFXglyph &glyph = font->glyph[i];
+        if (glyph.width == 0 || glyph.height == 0)
+        {
+            continue;
+        }
+        if (glyph.yOffset < top)
+            top = glyph.yOffset;
+        if (glyph.yOffset + glyph.height > bottom)
+            bottom = glyph.yOffset + glyph.height;
+    }
+}
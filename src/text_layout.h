@@ -0,0 +1,82 @@
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef ARDUINO
+#include <gfxfont.h>
+#else
+// Same layout as Adafruit GFX's gfxfont.h so fonts can be measured on host
+typedef struct
+{
+    uint16_t bitmapOffset;
+    uint8_t width;
+    uint8_t height;
+    uint8_t xAdvance;
+    int8_t xOffset;
+    int8_t yOffset;
+} GFXglyph;
+
+typedef struct
+{
+    uint8_t *bitmap;
+    GFXglyph *glyph;
+    uint16_t first;
+    uint16_t last;
+    uint8_t yAdvance;
+} GFXfont;
+#endif
+
+// Ink box of a string drawn with the cursor at (0, 0), as getTextBounds reports it
+struct TextExtent
+{
+    int16_t x1, y1;
+    uint16_t w, h;
+};
+
+// Label widths cached by string address - only for strings with static storage (day and
+// month names, fixed captions). Lives in RAM, so it starts cold after every deep sleep.
+#define TEXT_WIDTH_CACHE_SLOTS 16
+
+struct TextWidthCache
+{
+    const GFXfont *font[TEXT_WIDTH_CACHE_SLOTS];
+    const char *text[TEXT_WIDTH_CACHE_SLOTS];
+    TextExtent extent[TEXT_WIDTH_CACHE_SLOTS];
+};
+
+// String measurement straight from a GFX font's glyph table: one lookup and a few integer
+// adds per character, where Adafruit_GFX::getTextBounds goes through charBounds with wrap
+// and text-size handling for every glyph. Single line, text size 1, no wrap - all the
+// panel's labels.
+// Reads font tables only, so tests check it against a copy of getTextBounds' arithmetic.
+
+class TextLayout
+{
+public:
+    /**
+     * Measure a string
+     * @param font GFX font the string will be drawn with
+     * @param text Single line
+     * @return Same box getTextBounds(text, 0, 0, ...) gives for that font
+     */
+    static TextExtent measure(const GFXfont *font, const char *text);
+
+    /**
+     * Measure a string with static storage, reusing the result for the same address
+     * @param cache Cache to look in and fill (zero it to start)
+     * @return Same as measure()
+     */
+    static TextExtent measureLabel(TextWidthCache &cache, const GFXfont *font, const char *text);
+
+    /**
+     * Rows any glyph of a font can ink, so a line can be skipped without measuring it
+     * @param font GFX font
+     * @param top Highest inked row relative to the baseline (negative above it)
+     * @param bottom One past the lowest inked row relative to the baseline
+     */
+    static void fontRows(const GFXfont *font, int16_t &top, int16_t &bottom);
+};
+
+#endif // TEXT_LAYOUT_H
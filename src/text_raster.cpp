@@ -0,0 +1,189 @@
+#include "text_raster.h"
+
+// Set (white) or clear (black) pixels x0..x1-1 of one buffer row
+static void fillRun(uint8_t *row, int x0, int x1, bool black)
+{
+    int firstByte = x0 >> 3;
+    int lastByte = (x1 - 1) >> 3;
+    uint8_t head = (uint8_t)(0xFF >> (x0 & 7));
+    uint8_t tail = (uint8_t)(0xFF << (7 - ((x1 - 1) & 7)));
+
+    if (firstByte == lastByte)
+    {
+        uint8_t mask = head & tail;
+        row[firstByte] = black ? (uint8_t)(row[firstByte] & ~mask) : (uint8_t)(row[firstByte] | mask);
+        return;
+    }
+
+    row[firstByte] = black ? (uint8_t)(row[firstByte] & ~head) : (uint8_t)(row[firstByte] | head);
+    for (int i = firstByte + 1; i < lastByte; i++)
+    {
+        row[i] = black ? 0x00 : 0xFF;
+    }
+    row[lastByte] = black ? (uint8_t)(row[lastByte] & ~tail) : (uint8_t)(row[lastByte] | tail);
+}
+
+// count (1..32) glyph bits from bit onwards, MSB first, zero below them. Reads only the bytes
+// those bits live in - the last glyph's bits end the font bitmap.
+static uint32_t readBits(const uint8_t *bits, int bit, int count)
+{
+    const uint8_t *p = bits + (bit >> 3);
+    int shift = bit & 7;
+    int bytes = (shift + count + 7) >> 3;
+    uint64_t window = 0;
+    for (int i = 0; i < bytes; i++)
+    {
+        window |= (uint64_t)p[i] << (56 - 8 * i);
+    }
+    uint32_t word = (uint32_t)((window << shift) >> 32);
+    return count == 32 ? word : word & ~(0xFFFFFFFFu >> count);
+}
+
+// Panel area a draw may touch: the panel, then the window, then the page of the window in the buffer
+static void clipArea(const RasterTarget &target, int &left, int &top, int &right, int &bottom)
+{
+    left = target.windowX > 0 ? target.windowX : 0;
+    right = target.windowX + target.windowWidth;
+    if (right > target.panelWidth)
+        right = target.panelWidth;
+    top = target.windowY + target.pageTop;
+    if (top < 0)
+        top = 0;
+    bottom = target.windowY + target.pageTop + target.pageHeight;
+    if (bottom > target.windowY + target.windowHeight)
+        bottom = target.windowY + target.windowHeight;
+    if (bottom > target.panelHeight)
+        bottom = target.panelHeight;
+}
+
+static void drawGlyph(const RasterTarget &target, const GFXfont *font, const GFXglyph &glyph, int16_t x, int16_t y,
+                      bool black)
+{
+    // Glyph box on the panel
+    int left = x + glyph.xOffset;
+    int top = y + glyph.yOffset;
+    int width = glyph.width;
+    int height = glyph.height;
+
+    // Clip once: panel, then window, then the page of the window in the buffer
+    int clipLeft, clipTop, clipRight, clipBottom;
+    clipArea(target, clipLeft, clipTop, clipRight, clipBottom);
+
+    int colStart = clipLeft > left ? clipLeft - left : 0;
+    int colEnd = clipRight < left + width ? clipRight - left : width;
+    int rowStart = clipTop > top ? clipTop - top : 0;
+    int rowEnd = clipBottom < top + height ? clipBottom - top : height;
+    if (colStart >= colEnd || rowStart >= rowEnd)
+    {
+        return;
+    }
+
+    // Glyph bits run on from one row to the next, no padding
+    const uint8_t *bits = font->bitmap + glyph.bitmapOffset;
+    int stride = target.windowWidth / 8;
+    int bufferX = left - target.windowX;
+
+    for (int row = rowStart; row < rowEnd; row++)
+    {
+        uint8_t *line = target.buffer + (top + row - target.windowY - target.pageTop) * stride;
+        int bit = row * width + colStart;
+        int runStart = -1;
+        for (int col = colStart; col < colEnd;)
+        {
+            int count = colEnd - col < 32 ? colEnd - col : 32;
+            uint32_t word = readBits(bits, bit, count);
+            int pos = 0;
+            while (pos < count)
+            {
+                if (runStart < 0)
+                {
+                    // Skip blank bits up to the next ink
+                    if (word == 0)
+                        break;
+                    int blank = __builtin_clz(word);
+                    pos += blank;
+                    word <<= blank;
+                    runStart = col + pos;
+                }
+                // Ink up to the next blank bit or the end of this word
+                int ink = ~word == 0 ? 32 : __builtin_clz(~word);
+                if (pos + ink >= count)
+                {
+                    break; // Run may carry on into the next word
+                }
+                pos += ink;
+                word <<= ink;
+                fillRun(line, bufferX + runStart, bufferX + col + pos, black);
+                runStart = -1;
+            }
+            col += count;
+            bit += count;
+        }
+        if (runStart >= 0)
+        {
+            fillRun(line, bufferX + runStart, bufferX + colEnd, black);
+        }
+    }
+}
+
+int16_t TextRaster::drawText(const RasterTarget &target, const GFXfont *font, int16_t x, int16_t y, const char *text,
+                             bool black)
+{
+    for (const uint8_t *c = (const uint8_t *)text; *c != '\0'; c++)
+    {
+        if (*c == '\n')
+        {
+            x = 0;
+            y += font->yAdvance;
+            continue;
+        }
+        if (*c == '\r' || *c < font->first || *c > font->last)
+        {
+            continue;
+        }
+
+        const GFXglyph &glyph = font->glyph[*c - font->first];
+        if (glyph.width > 0 && glyph.height > 0)
+        {
+            // GFX wraps at the panel edge before drawing a glyph that would cross it
+            if (x + glyph.xOffset + glyph.width > target.panelWidth)
+            {
+                x = 0;
+                y += font->yAdvance;
+            }
+            drawGlyph(target, font, glyph, x, y, black);
+        }
+        x += glyph.xAdvance;
+    }
+    return x;
+}
+
+void TextRaster::fillRect(const RasterTarget &target, int16_t x, int16_t y, int16_t w, int16_t h, bool black)
+{
+    int clipLeft, clipTop, clipRight, clipBottom;
+    clipArea(target, clipLeft, clipTop, clipRight, clipBottom);
+    int left = x > clipLeft ? x : clipLeft;
+    int right = x + w < clipRight ? x + w : clipRight;
+    int top = y > clipTop ? y : clipTop;
+    int bottom = y + h < clipBottom ? y + h : clipBottom;
+    if (left >= right || top >= bottom)
+    {
+        return;
+    }
+
+    int stride = target.windowWidth / 8;
+    for (int row = top; row < bottom; row++)
+    {
+        uint8_t *line = target.buffer + (row - target.windowY - target.pageTop) * stride;
+        fillRun(line, left - target.windowX, right - target.windowX, black);
+    }
+}
+
+bool TextRaster::rowsInPage(const RasterTarget &target, int16_t top, int16_t height)
+{
+    int pageStart = target.windowY + target.pageTop;
+    int pageEnd = pageStart + target.pageHeight;
+    if (pageEnd > target.windowY + target.windowHeight)
+        pageEnd = target.windowY + target.windowHeight;
+    return height > 0 && top < pageEnd && top + height > pageStart;
+}
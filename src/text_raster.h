@@ -0,0 +1,64 @@
+#ifndef TEXT_RASTER_H
+#define TEXT_RASTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "text_layout.h"
+
+// GxEPD2_BW frame buffer for the current page: rows of windowWidth / 8 bytes, MSB = leftmost
+// pixel, 1 = white. Only pixels inside the panel, the window and the page are written -
+// the same clipping GxEPD2's drawPixel applies one pixel at a time.
+struct RasterTarget
+{
+    uint8_t *buffer;
+    int16_t windowX, windowY;        // Partial window on the panel (x and width multiples of 8)
+    uint16_t windowWidth, windowHeight;
+    uint16_t pageTop, pageHeight;    // Window rows held in the buffer (GxEPD2 pages)
+    uint16_t panelWidth, panelHeight;
+};
+
+
+// GFXfont text drawn as horizontal runs of bytes into the frame buffer: each glyph is clipped
+// once, its bitmap decoded row by row and every run of ink written with masks and whole-byte
+// stores. Same pixels as Adafruit_GFX print at text size 1 with wrap, transparent background.
+// Writes only into the RasterTarget it is given, so tests compare buffers byte for byte.
+
+class TextRaster
+{
+public:
+    /**
+     * Draw a string
+     * @param target Buffer to draw into
+     * @param font GFX font
+     * @param x Cursor x (left of the first glyph's origin)
+     * @param y Cursor y (baseline)
+     * @param text Bytes outside the font are skipped, '\n' starts a new line like GFX
+     * @param black Ink colour (false = white)
+     * @return Cursor x after the last glyph
+     */
+    static int16_t drawText(const RasterTarget &target, const GFXfont *font, int16_t x, int16_t y, const char *text,
+                            bool black);
+
+    /**
+     * Fill a rectangle, clipped like text (GFX fillRect at rotation 0)
+     * @param target Buffer to draw into
+     * @param x Left edge on the panel
+     * @param y Top row on the panel
+     * @param w Width
+     * @param h Height
+     * @param black Colour (false = white)
+     */
+    static void fillRect(const RasterTarget &target, int16_t x, int16_t y, int16_t w, int16_t h, bool black);
+
+    /**
+     * Whether panel rows reach the page in the buffer. With a paged buffer every draw call
+     * runs once per page, so callers skip regions and strings that lie in another band.
+     * @param target Buffer being drawn
+     * @param top First panel row
+     * @param height Rows
+     * @return true if any of the rows is in the window and the page
+     */
+    static bool rowsInPage(const RasterTarget &target, int16_t top, int16_t height);
+};
+
+#endif // TEXT_RASTER_H
@@ -0,0 +1,168 @@
+#include "tile_delta.h"
+#include <cstring>
+
+static uint32_t readU32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void writeU32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+// Length of the tile frame starting at p, 0 if it runs past end
+static size_t tileLength(const uint8_t *p, size_t available)
+{
+    if (available < FRAME_HEADER_SIZE)
+        return 0;
+    uint32_t dataLength = readU32(p + 12);
+    if (dataLength > available - FRAME_HEADER_SIZE)
+        return 0;
+    return FRAME_HEADER_SIZE + dataLength;
+}
+
+bool TileDeltaReader::begin(const uint8_t *delta, size_t deltaLength)
+{
+    data = nullptr;
+    if (deltaLength < TILE_DELTA_HEADER_SIZE || delta[0] != 'T' || delta[1] != 'D' || delta[2] != TILE_DELTA_VERSION)
+    {
+        return false;
+    }
+
+    // Walk the tiles once so nextTile can't run off the end of a truncated download
+    size_t p = TILE_DELTA_HEADER_SIZE;
+    for (int i = 0; i < delta[3]; i++)
+    {
+        size_t tile = tileLength(delta + p, deltaLength - p);
+        FrameDecoder decoder;
+        if (tile == 0 || !decoder.begin(delta + p, tile))
+        {
+            return false;
+        }
+        p += tile;
+    }
+    if (p != deltaLength)
+    {
+        return false;
+    }
+
+    data = delta;
+    length = deltaLength;
+    count = delta[3];
+    base = readU32(delta + 4);
+    next = readU32(delta + 8);
+    rewind();
+    return true;
+}
+
+void TileDeltaReader::rewind()
+{
+    pos = TILE_DELTA_HEADER_SIZE;
+}
+
+bool TileDeltaReader::nextTile(FrameDecoder &decoder)
+{
+    if (data == nullptr || pos >= length)
+    {
+        return false;
+    }
+    size_t tile = tileLength(data + pos, length - pos);
+    decoder.begin(data + pos, tile);
+    pos += tile;
+    return true;
+}
+
+uint32_t TileDelta::imageHash(const uint8_t *image, size_t length)
+{
+    // FNV-1a, same as scripts/render_server.py
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= image[i];
+        hash *= 16777619u;
+    }
+    return hash ? hash : 1;
+}
+
+int TileDelta::maxRects(int width, int height)
+{
+    return ((width + TILE_SIZE - 1) / TILE_SIZE) * ((height + TILE_SIZE - 1) / TILE_SIZE);
+}
+
+int TileDelta::changedRects(const uint8_t *before, const uint8_t *after, int width, int height, ScreenRect *rects)
+{
+    int rowBytes = width / 8;
+    int count = 0;
+
+    for (int ty = 0; ty < height; ty += TILE_SIZE)
+    {
+        int th = (height - ty < TILE_SIZE) ? height - ty : TILE_SIZE;
+        int runStart = -1;
+
+        for (int tx = 0; tx <= width; tx += TILE_SIZE)
+        {
+            bool dirty = false;
+            if (tx < width)
+            {
+                int tw = (width - tx < TILE_SIZE) ? width - tx : TILE_SIZE;
+                for (int y = ty; y < ty + th && !dirty; y++)
+                {
+                    size_t offset = (size_t)y * rowBytes + tx / 8;
+                    dirty = memcmp(before + offset, after + offset, tw / 8) != 0;
+                }
+            }
+
+            // Horizontal runs of dirty tiles become one rectangle
+            if (dirty && runStart < 0)
+            {
+                runStart = tx;
+            }
+            else if (!dirty && runStart >= 0)
+            {
+                int runEnd = (tx < width) ? tx : width;
+                rects[count++] = {(int16_t)runStart, (int16_t)ty, (int16_t)(runEnd - runStart), (int16_t)th};
+                runStart = -1;
+            }
+        }
+    }
+
+    // Same trade-off as the weather regions: each window costs a refresh
+    return WeatherDiff::mergeRects(rects, count);
+}
+
+size_t TileDelta::encode(const uint8_t *image, int width, int originX, int originY, const ScreenRect *rects, int count,
+                         uint32_t baseHash, uint32_t newHash, uint8_t *out, size_t capacity)
+{
+    if (count > 255 || capacity < TILE_DELTA_HEADER_SIZE)
+    {
+        return 0;
+    }
+
+    int rowBytes = width / 8;
+    size_t o = TILE_DELTA_HEADER_SIZE;
+    for (int i = 0; i < count; i++)
+    {
+        const ScreenRect &r = rects[i];
+        FrameInfo info = {(uint16_t)(originX + r.x), (uint16_t)(originY + r.y), (uint16_t)r.w, (uint16_t)r.h,
+                          FRAME_FLAG_PACKBITS, 0};
+        size_t written = FrameCodec::encode(image + (size_t)r.y * rowBytes + r.x / 8, rowBytes, info, out + o,
+                                            capacity - o);
+        if (written == 0)
+        {
+            return 0;
+        }
+        o += written;
+    }
+
+    out[0] = 'T';
+    out[1] = 'D';
+    out[2] = TILE_DELTA_VERSION;
+    out[3] = (uint8_t)count;
+    writeU32(out + 4, baseHash);
+    writeU32(out + 8, newHash);
+    return o;
+}
@@ -0,0 +1,105 @@
+#ifndef TILE_DELTA_H
+#define TILE_DELTA_H
+
+#include <cstddef>
+#include <cstdint>
+#include "frame_codec.h"
+#include "weather_diff.h"
+
+// Changed tiles of a server-rendered pane, relative to the image the panel already shows
+//
+//   0  'T' 'D'   magic
+//   2  u8        version
+//   3  u8        tile count
+//   4  u32       base hash  image the tiles apply to (0 = none, tiles cover the whole pane)
+//   8  u32       new hash   image once the tiles are applied
+//   12 tiles     each a complete frame (frame_codec.h) at its panel position
+//
+// Every tile is also a refresh window: the panel RAM doesn't survive deep sleep, so a
+// window is only refreshed with pixels that were sent for all of it.
+
+#define TILE_DELTA_VERSION 1
+#define TILE_DELTA_HEADER_SIZE 12
+#define TILE_SIZE 40 // Diff granularity in pixels (one weather icon), a multiple of 8
+
+// Walks the tiles of a received delta in place; each tile's pixels stay a frame for FrameDecoder.
+class TileDeltaReader
+{
+public:
+    /**
+     * Validate the header and every tile's frame header
+     * @param delta Complete delta
+     * @param length Delta length in bytes
+     * @return false if the header is invalid or the tiles don't add up to length
+     */
+    bool begin(const uint8_t *delta, size_t length);
+
+    uint32_t baseHash() const { return base; }
+    uint32_t newHash() const { return next; }
+    int tileCount() const { return count; }
+
+    /**
+     * Point a decoder at the next tile
+     * @param decoder Decoder to begin on the tile
+     * @return false once all tiles have been handed out
+     */
+    bool nextTile(FrameDecoder &decoder);
+
+    /**
+     * Start again from the first tile
+     */
+    void rewind();
+
+private:
+    const uint8_t *data = nullptr;
+    size_t length = 0;
+    size_t pos = 0;
+    uint32_t base = 0;
+    uint32_t next = 0;
+    int count = 0;
+};
+
+// Tile diff and delta encoder for the host renderer and tests
+class TileDelta
+{
+public:
+    /**
+     * Identity of a rendered pane, as exchanged with the server (never 0)
+     */
+    static uint32_t imageHash(const uint8_t *image, size_t length);
+
+    /**
+     * Room needed in the rects array of changedRects
+     */
+    static int maxRects(int width, int height);
+
+    /**
+     * Find the tiles that differ and merge them into refresh windows
+     * @param before Packed 1bpp image on the panel (rows of width / 8 bytes)
+     * @param after Packed 1bpp image to show
+     * @param width Image width, a multiple of 8
+     * @param height Image height
+     * @param rects Output windows in image coordinates, room for maxRects(width, height)
+     * @return Number of windows (0 = images are identical)
+     */
+    static int changedRects(const uint8_t *before, const uint8_t *after, int width, int height, ScreenRect *rects);
+
+    /**
+     * Encode windows of an image as a delta
+     * @param image Packed 1bpp image to show
+     * @param width Image width, a multiple of 8
+     * @param originX Panel position of the image, a multiple of 8
+     * @param originY Panel position of the image
+     * @param rects Windows from changedRects (image coordinates)
+     * @param count Number of windows
+     * @param baseHash Hash of the image the panel shows (0 = rects cover the whole image)
+     * @param newHash Hash of image
+     * @param out Output buffer
+     * @param capacity Output capacity
+     * @return Bytes written, 0 if it doesn't fit
+     */
+    static size_t encode(const uint8_t *image, int width, int originX, int originY, const ScreenRect *rects, int count,
+                         uint32_t baseHash, uint32_t newHash, uint8_t *out, size_t capacity);
+};
+
+#endif // TILE_DELTA_H
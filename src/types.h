@@ -1,31 +1,51 @@
 #ifndef TYPES_H
 #define TYPES_H
 
-#include <Arduino.h>
+#include <ctime>
+#include <cstdint>
 
+// Simplified weather conditions (mapped from WMO codes)
+enum WeatherCondition : uint8_t
+{
+    WEATHER_UNKNOWN = 0,
+    WEATHER_CLEAR,
+    WEATHER_CLOUDY,
+    WEATHER_OVERCAST,
+    WEATHER_FOGGY,
+    WEATHER_RAIN,
+    WEATHER_SNOW,
+    WEATHER_THUNDER
+};
+
+// Plain data only (no String) so a forecast can be parked in RTC memory across deep sleep.
+// Temperatures are tenths of a degree (the C3 has no FPU); see text_format.h for printing.
 struct WeatherData
 {
-    float currentTemp;
-    String currentCondition;
+    int16_t currentTemp;
+    WeatherCondition currentCondition;
     int humidity;
     int windSpeed;
     time_t lastUpdated; // Timestamp of last weather fetch
+    uint8_t location;   // Carousel index (0 = the only or first configured location)
+    bool hasAirQuality;  // usAqi and pm25Tenths are set (AIR_QUALITY_ENABLED and the fetch succeeded)
+    int usAqi;           // US AQI
+    uint16_t pm25Tenths; // PM2.5 in tenths of ug/m3
 
     // Hourly forecast (next 6 hours)
     struct HourlyForecast
     {
         int hour;
-        float temp;
-        String condition;
+        int16_t temp;
+        WeatherCondition condition;
     } hourly[6];
 
     // Daily forecast (next 4 days)
     struct DailyForecast
     {
-        String day;
-        float tempHigh;
-        float tempLow;
-        String condition;
+        uint8_t dayOfWeek; // 0=Sun, 1=Mon, etc.
+        int16_t tempHigh;
+        int16_t tempLow;
+        WeatherCondition condition;
     } daily[4];
 };
 
@@ -1,5 +1,7 @@
 #include "wake_logic.h"
+#ifdef ARDUINO
 #include <Arduino.h>
+#endif
 
 bool WakeLogic::shouldUpdateWeather(time_t currentTime, time_t lastWeatherUpdate, int weatherUpdateInterval)
 {
@@ -10,10 +12,12 @@ bool WakeLogic::shouldUpdateWeather(time_t currentTime, time_t lastWeatherUpdate
     }
 
     bool should_update = (currentTime - lastWeatherUpdate >= weatherUpdateInterval);
+#ifdef ARDUINO
     Serial.printf("Weather check: current=%ld, lastUpdate=%ld, diff=%ld, interval=%d, result=%s\n",
                   currentTime, lastWeatherUpdate, currentTime - lastWeatherUpdate, weatherUpdateInterval,
                   should_update ? "YES" : "NO");
     Serial.flush();
+#endif
     return should_update;
 }
 
@@ -31,3 +35,110 @@ bool WakeLogic::isFirstBoot(time_t lastWeatherUpdate)
 {
     return (lastWeatherUpdate == 0);
 }
+
+int WakeLogic::secondsUntilNextClockUpdate(int currentMinute, int currentSecond, int clockIntervalMinutes)
+{
+    if (clockIntervalMinutes < 1)
+    {
+        clockIntervalMinutes = 1;
+    }
+
+    int minutesToBoundary = clockIntervalMinutes - (currentMinute % clockIntervalMinutes);
+    int sleepSeconds = minutesToBoundary * 60 - currentSecond;
+
+    // Add a small buffer to ensure we're past the boundary
+    if (sleepSeconds < 3)
+    {
+        sleepSeconds += clockIntervalMinutes * 60; // Sleep to the next boundary instead
+    }
+    return sleepSeconds;
+}
+
+time_t WakeLogic::weatherBoundary(time_t when)
+{
+    // This aligns all updates to :00 and :30 marks, naturally re-rendering hourly forecast
+    struct tm boundary;
+    localtime_r(&when, &boundary);
+    boundary.tm_min = (boundary.tm_min < 30) ? 0 : 30;
+    boundary.tm_sec = 0;
+    return mktime(&boundary);
+}
+
+time_t WakeLogic::prefetchTime(time_t lastWeatherUpdate, int weatherUpdateInterval, int leadSeconds,
+                               int staggerSeconds)
+{
+    if (lastWeatherUpdate == 0)
+    {
+        return 0; // First fetch happens inline on fresh boot
+    }
+    return lastWeatherUpdate + weatherUpdateInterval - leadSeconds - staggerSeconds;
+}
+
+// Earliest second of a minute a staggered prefetch starts, clear of the clock wake
+const int STAGGER_CLOCK_GUARD = 10;
+
+static uint32_t staggerMix(uint32_t h)
+{
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+uint32_t WakeLogic::staggerSeed(const uint8_t mac[6])
+{
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < 6; i++)
+    {
+        hash = (hash ^ mac[i]) * 16777619u;
+    }
+    return staggerMix(hash); // Consecutive MACs differ only in the last byte
+}
+
+int WakeLogic::staggerSeconds(uint32_t seed, time_t boundary, int spreadMinutes, int jitterSeconds, int leadSeconds)
+{
+    // Slots are the seconds of each minute from the guard up to the usual :20 phase
+    int perMinute = 60 - leadSeconds - STAGGER_CLOCK_GUARD + 1;
+    if (spreadMinutes < 1 || perMinute < 1)
+    {
+        return 0;
+    }
+    int slots = spreadMinutes * perMinute;
+    int slot = (int)(seed % (uint32_t)slots);
+    if (jitterSeconds > 0)
+    {
+        uint32_t window = staggerMix(seed ^ (uint32_t)(boundary / 60));
+        slot += (int)(window % (uint32_t)(2 * jitterSeconds + 1)) - jitterSeconds;
+        slot = (slot % slots + slots) % slots; // Wraps within the spread
+    }
+
+    // Slot 0 is the unstaggered prefetch; later slots step back a second at a time, then a minute
+    return (slot / perMinute) * 60 + slot % perMinute;
+}
+
+WakePlan WakeLogic::planNextWake(time_t currentTime, int currentMinute, int currentSecond,
+                                 int clockIntervalMinutes, time_t prefetchAt)
+{
+    int clockSleep = secondsUntilNextClockUpdate(currentMinute, currentSecond, clockIntervalMinutes);
+    if (prefetchAt == 0)
+    {
+        return {clockSleep, false};
+    }
+
+    time_t target = prefetchAt;
+    if (target < currentTime + 3)
+    {
+        // Overdue: keep the same second-of-minute phase, one or more minutes later
+        time_t minutesLate = (currentTime + 3 - target + 59) / 60;
+        target += minutesLate * 60;
+    }
+
+    int prefetchSleep = (int)(target - currentTime);
+    if (prefetchSleep < clockSleep)
+    {
+        return {prefetchSleep, true};
+    }
+    return {clockSleep, false};
+}
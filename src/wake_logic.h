@@ -1,8 +1,16 @@
 #ifndef WAKE_LOGIC_H
 #define WAKE_LOGIC_H
 
+#include <cstdint>
 #include <ctime>
 
+// Where the next wake lands and what it is for
+struct WakePlan
+{
+    int sleepSeconds; // Seconds to sleep from now
+    bool prefetch;    // true = off-phase weather prefetch wake, false = clock update wake
+};
+
 // Pure decision logic functions for wake scenarios
 // These have no side effects and can be easily tested
 
@@ -42,6 +50,69 @@ public:
      * @return true if lastWeatherUpdate is 0 (never updated)
      */
     static bool isFirstBoot(time_t lastWeatherUpdate);
+
+    /**
+     * Seconds to sleep until the next clock update boundary
+     * @param currentMinute Current minute (tm_min)
+     * @param currentSecond Current second (tm_sec)
+     * @param clockIntervalMinutes Clock granularity in minutes (1 = every minute)
+     * @return Seconds until the next minute divisible by clockIntervalMinutes (never less than 3)
+     */
+    static int secondsUntilNextClockUpdate(int currentMinute, int currentSecond, int clockIntervalMinutes);
+
+    /**
+     * Snap a time down to the weather boundary it belongs to (:00 or :30, local time)
+     * @param when Epoch time
+     * @return Epoch time of the :00 or :30 mark at or before when
+     */
+    static time_t weatherBoundary(time_t when);
+
+    /**
+     * When the off-phase prefetch for the next weather boundary should run
+     * @param lastWeatherUpdate Boundary the current weather was shown at (0 = never)
+     * @param weatherUpdateInterval Interval in seconds (e.g., 30 * 60)
+     * @param leadSeconds How far ahead of the boundary to fetch (e.g., 40 -> :29:20)
+     * @param staggerSeconds This device's extra lead, from staggerSeconds
+     * @return Epoch time of the prefetch, or 0 if weather has never been fetched
+     */
+    static time_t prefetchTime(time_t lastWeatherUpdate, int weatherUpdateInterval, int leadSeconds,
+                               int staggerSeconds = 0);
+
+    /**
+     * Per-device stagger seed, so every panel in a fleet gets its own prefetch slot
+     * @param mac Factory MAC
+     */
+    static uint32_t staggerSeed(const uint8_t mac[6]);
+
+    /**
+     * How much earlier than leadSeconds this device prefetches for a boundary. Devices are
+     * spread over the spreadMinutes before the boundary by their seed, then moved a few slots
+     * per boundary so two panels that share a slot don't collide every time. Every prefetch
+     * still starts at a second of the minute clear of the clock wake and leaves leadSeconds
+     * before the next minute, and the forecast is still shown at the boundary.
+     * @param seed From staggerSeed
+     * @param boundary Weather boundary being prefetched for
+     * @param spreadMinutes Minutes the fleet is spread over (0 = no stagger)
+     * @param jitterSeconds Most a single boundary moves the device from its slot
+     * @param leadSeconds As for prefetchTime
+     * @return Seconds to add to leadSeconds, 0 .. spreadMinutes * 60 - leadSeconds - 10 (the first
+     *         minute of the spread only has the seconds from :10 on, the others end at 60 - leadSeconds)
+     */
+    static int staggerSeconds(uint32_t seed, time_t boundary, int spreadMinutes, int jitterSeconds, int leadSeconds);
+
+    /**
+     * Pick the next wake: the next clock boundary, or an earlier prefetch wake if one is due.
+     * A prefetch that is already overdue (failed attempt) retries at the same phase of the next
+     * minute, so retries never land on a clock boundary.
+     * @param currentTime Current epoch time
+     * @param currentMinute Current minute (tm_min)
+     * @param currentSecond Current second (tm_sec)
+     * @param clockIntervalMinutes Clock granularity in minutes
+     * @param prefetchAt Prefetch time from prefetchTime, or 0 if nothing to fetch
+     * @return Sleep duration and wake type
+     */
+    static WakePlan planNextWake(time_t currentTime, int currentMinute, int currentSecond,
+                                 int clockIntervalMinutes, time_t prefetchAt);
 };
 
 #endif // WAKE_LOGIC_H
@@ -0,0 +1,84 @@
+#include "warm_store.h"
+#include "config.h"
+#include <Arduino.h>
+
+bool WarmStore::ready()
+{
+    if (mountTried)
+    {
+        return partition != nullptr;
+    }
+    mountTried = true;
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, WARM_PARTITION_LABEL);
+    if (partition == nullptr)
+    {
+        Serial.println("No warm partition, nothing to restore from");
+        return false;
+    }
+    FlashPort port = {this, partition->size, read, write, erase};
+    if (!ring.mount(port))
+    {
+        Serial.println("Warm partition unreadable");
+        partition = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool WarmStore::loadForecast(WeatherData &weather)
+{
+    // Plain struct bytes: a record from a firmware with another layout has another length
+    size_t length = 0;
+    return ready() && ring.read(WARM_FORECAST, (uint8_t *)&weather, sizeof(weather), length) &&
+           length == sizeof(weather);
+}
+
+void WarmStore::saveForecast(const WeatherData &weather)
+{
+    if (ready())
+    {
+        report("Forecast", ring.write(WARM_FORECAST, (const uint8_t *)&weather, sizeof(weather)), sizeof(weather));
+    }
+}
+
+bool WarmStore::loadPane(uint8_t *buffer, size_t capacity, size_t &length)
+{
+    return ready() && ring.read(WARM_PANE, buffer, capacity, length);
+}
+
+void WarmStore::savePane(const uint8_t *pane, size_t length)
+{
+    if (ready())
+    {
+        report("Pane", ring.write(WARM_PANE, pane, length), length);
+    }
+}
+
+void WarmStore::report(const char *what, FlashRingResult result, size_t length)
+{
+    if (result == RING_WRITTEN)
+    {
+        // The sequence number survives power loss, so it counts writes over the partition's life
+        Serial.printf("%s saved to flash: %u bytes, %u sector(s) erased, record #%u\n", what, (unsigned)length,
+                      (unsigned)ring.sectorsErased(), (unsigned)ring.recordsWritten());
+    }
+    else if (result != RING_UNCHANGED)
+    {
+        Serial.printf("%s not saved to flash (%s)\n", what, result == RING_FULL ? "no room" : "flash error");
+    }
+}
+
+bool WarmStore::read(void *context, uint32_t offset, void *out, size_t length)
+{
+    return esp_partition_read(((WarmStore *)context)->partition, offset, out, length) == ESP_OK;
+}
+
+bool WarmStore::write(void *context, uint32_t offset, const void *data, size_t length)
+{
+    return esp_partition_write(((WarmStore *)context)->partition, offset, data, length) == ESP_OK;
+}
+
+bool WarmStore::erase(void *context, uint32_t offset, size_t length)
+{
+    return esp_partition_erase_range(((WarmStore *)context)->partition, offset, length) == ESP_OK;
+}
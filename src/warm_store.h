@@ -0,0 +1,37 @@
+#ifndef WARM_STORE_H
+#define WARM_STORE_H
+
+#include <esp_partition.h>
+#include "flash_ring.h"
+#include "types.h"
+
+// Record types in the warm partition
+enum WarmRecord : uint8_t
+{
+    WARM_FORECAST = 0, // WeatherData as last drawn by the local renderer
+    WARM_PANE          // Server-rendered pane as received: a frame, or a tile delta with no base
+};
+
+// What was last on the weather pane, kept in a FlashRing on the "warm" partition so a fresh
+// boot can put it back before WiFi and time sync. Records are only written when they change.
+class WarmStore
+{
+public:
+    bool loadForecast(WeatherData &weather);
+    void saveForecast(const WeatherData &weather);
+    bool loadPane(uint8_t *buffer, size_t capacity, size_t &length);
+    void savePane(const uint8_t *pane, size_t length);
+
+private:
+    bool ready(); // Mounts on first use; false = no partition, nothing is read or written
+    static bool read(void *context, uint32_t offset, void *out, size_t length);
+    static bool write(void *context, uint32_t offset, const void *data, size_t length);
+    static bool erase(void *context, uint32_t offset, size_t length);
+    void report(const char *what, FlashRingResult result, size_t length);
+
+    const esp_partition_t *partition = nullptr;
+    bool mountTried = false;
+    FlashRing ring;
+};
+
+#endif // WARM_STORE_H
@@ -0,0 +1,92 @@
+#include "weather_bitmaps.h"
+
+// Auto-generated - do not edit manually. Use scripts/png_to_bitmap.py to regenerate.
+
+static const uint8_t cloud_bolt_rain_40x40_data[] PROGMEM = { // 200 bytes raw
+    0xf6, 0x00, 0x01, 0x01, 0x74, 0xfe, 0x00, 0x01, 0x06, 0xad, 0xfe, 0x00, 0x01, 0x15, 0x05, 0xfe,
+    0x00, 0x2c, 0x18, 0x01, 0xc0, 0x00, 0x00, 0x30, 0x00, 0x60, 0x00, 0x00, 0x60, 0x00, 0x50, 0x00,
+    0x00, 0xa0, 0x00, 0x28, 0x00, 0x00, 0xc0, 0x00, 0x3f, 0x00, 0x00, 0x80, 0x00, 0x02, 0xc0, 0x00,
+    0x80, 0x00, 0x00, 0xe0, 0x01, 0x80, 0x00, 0x00, 0x30, 0x06, 0x80, 0x00, 0x00, 0x28, 0x0b, 0xfe,
+    0x00, 0x01, 0x10, 0x1c, 0xfe, 0x00, 0x01, 0x18, 0x10, 0xfe, 0x00, 0xff, 0x18, 0xfe, 0x00, 0xff,
+    0x10, 0xfe, 0x00, 0xff, 0x18, 0xfe, 0x00, 0x01, 0x30, 0x10, 0xfe, 0x00, 0x01, 0x28, 0x1c, 0xfe,
+    0x00, 0x06, 0xe0, 0x0a, 0x00, 0x00, 0x02, 0xa0, 0x07, 0xfe, 0xff, 0x01, 0x40, 0x01, 0xfe, 0x55,
+    0xff, 0x00, 0x02, 0x08, 0x88, 0x80, 0xf9, 0x00, 0x00, 0x10, 0xfe, 0x00, 0x2a, 0xc0, 0x6c, 0x06,
+    0x00, 0x01, 0x80, 0x58, 0x04, 0x00, 0x01, 0x00, 0x70, 0x0c, 0x00, 0x03, 0x00, 0xda, 0x08, 0x00,
+    0x00, 0x10, 0xee, 0x18, 0x40, 0x00, 0x10, 0x38, 0x00, 0xc0, 0x00, 0x30, 0x18, 0x01, 0x80, 0x00,
+    0x60, 0x60, 0x01, 0x00, 0x00, 0x40, 0x20, 0x03, 0xfe, 0x00, 0x00, 0x40, 0xfd, 0x00, 0x00, 0x80,
+    0xfa, 0x00
+};
+const PackedBitmap cloud_bolt_rain_40x40 = {cloud_bolt_rain_40x40_data, sizeof(cloud_bolt_rain_40x40_data), 40, 40};
+
+static const uint8_t cloud_fog_40x40_data[] PROGMEM = { // 200 bytes raw
+    0xfa, 0x00, 0x00, 0x50, 0xfe, 0x00, 0x01, 0x03, 0xee, 0xfe, 0x00, 0x36, 0x0d, 0x15, 0x80, 0x00,
+    0x00, 0x14, 0x01, 0xc0, 0x00, 0x00, 0x38, 0x00, 0x70, 0x00, 0x00, 0x60, 0x00, 0x20, 0x00, 0x00,
+    0xa0, 0x00, 0x38, 0x00, 0x00, 0xc0, 0x00, 0x17, 0x00, 0x00, 0x80, 0x00, 0x0d, 0xe0, 0x01, 0x80,
+    0x00, 0x00, 0xb0, 0x01, 0x40, 0x00, 0x00, 0x28, 0x02, 0x80, 0x00, 0x00, 0x1c, 0x0d, 0x80, 0x00,
+    0x00, 0x08, 0x16, 0xfe, 0x00, 0x01, 0x06, 0x18, 0xfe, 0x00, 0x01, 0x0c, 0x28, 0xfe, 0x00, 0x01,
+    0x06, 0x30, 0xfe, 0x00, 0x01, 0x04, 0x30, 0xfe, 0x00, 0x01, 0x06, 0x20, 0xfe, 0x00, 0x01, 0x0c,
+    0x30, 0xfe, 0x00, 0x01, 0x14, 0x30, 0xfe, 0x00, 0x01, 0x18, 0x1c, 0xfe, 0x00, 0x0e, 0x68, 0x0b,
+    0x54, 0xaa, 0xab, 0xb0, 0x07, 0xef, 0xdd, 0xf6, 0xc0, 0x00, 0x29, 0x55, 0x15, 0xf0, 0x00, 0x0c,
+    0x10, 0x00, 0x40, 0x00, 0x00, 0x7f, 0xff, 0xff, 0x00, 0x00, 0x4a, 0xaa, 0x95, 0xf0, 0x00, 0x07,
+    0x29, 0x24, 0x92, 0x00, 0x00, 0x7f, 0xff, 0xff, 0xf1, 0x00
+};
+const PackedBitmap cloud_fog_40x40 = {cloud_fog_40x40_data, sizeof(cloud_fog_40x40_data), 40, 40};
+
+static const uint8_t cloud_40x40_data[] PROGMEM = { // 200 bytes raw
+    0xdc, 0x00, 0x00, 0xa0, 0xfe, 0x00, 0x01, 0x07, 0x7e, 0xfe, 0x00, 0x22, 0x1a, 0x85, 0x80, 0x00,
+    0x00, 0x28, 0x02, 0xc0, 0x00, 0x00, 0x50, 0x00, 0xa0, 0x00, 0x00, 0xa0, 0x00, 0x70, 0x00, 0x00,
+    0xc0, 0x00, 0x10, 0x00, 0x01, 0x40, 0x00, 0x1e, 0x80, 0x01, 0x80, 0x00, 0x17, 0xa0, 0x01, 0xfe,
+    0x00, 0x01, 0xe8, 0x03, 0xfe, 0x00, 0x01, 0x30, 0x03, 0xfe, 0x00, 0x01, 0x1c, 0x0d, 0xfe, 0x00,
+    0x01, 0x04, 0x1c, 0xfe, 0x00, 0x01, 0x0e, 0x30, 0xfe, 0x00, 0x01, 0x04, 0x60, 0xfe, 0x00, 0x01,
+    0x06, 0x60, 0xfe, 0x00, 0x01, 0x06, 0x50, 0xfe, 0x00, 0x01, 0x04, 0x60, 0xfe, 0x00, 0x01, 0x0e,
+    0x60, 0xfe, 0x00, 0x01, 0x08, 0x20, 0xfe, 0x00, 0x01, 0x1c, 0x38, 0xfe, 0x00, 0x0e, 0x30, 0x35,
+    0x54, 0x92, 0x45, 0xf0, 0x0f, 0xff, 0xff, 0xfe, 0xc0, 0x02, 0xaa, 0xaa, 0xb5, 0xd8, 0x00
+};
+const PackedBitmap cloud_40x40 = {cloud_40x40_data, sizeof(cloud_40x40_data), 40, 40};
+
+static const uint8_t cloud_rain_40x40_data[] PROGMEM = { // 200 bytes raw
+    0xff, 0x00, 0x00, 0x50, 0xfe, 0x00, 0x01, 0x03, 0xae, 0xfe, 0x00, 0x36, 0x0d, 0x55, 0x80, 0x00,
+    0x00, 0x14, 0x02, 0xc0, 0x00, 0x00, 0x30, 0x00, 0xa0, 0x00, 0x00, 0x50, 0x00, 0x70, 0x00, 0x00,
+    0x60, 0x00, 0x18, 0x00, 0x00, 0xc0, 0x00, 0x16, 0x80, 0x00, 0x80, 0x00, 0x1b, 0x40, 0x01, 0x80,
+    0x00, 0x01, 0xb0, 0x01, 0x40, 0x00, 0x00, 0x58, 0x01, 0x80, 0x00, 0x00, 0x14, 0x06, 0x80, 0x00,
+    0x00, 0x0c, 0x1e, 0xfe, 0x00, 0x01, 0x0a, 0x10, 0xfe, 0x00, 0x01, 0x06, 0x38, 0xfe, 0x00, 0x01,
+    0x04, 0x20, 0xfe, 0x00, 0x01, 0x06, 0x30, 0xfe, 0x00, 0x01, 0x0c, 0x20, 0xfe, 0x00, 0x01, 0x06,
+    0x30, 0xfe, 0x00, 0x01, 0x0c, 0x30, 0xfe, 0x00, 0xff, 0x18, 0xfe, 0x00, 0x0f, 0x34, 0x1e, 0xa4,
+    0x92, 0x49, 0xe8, 0x07, 0xdf, 0xff, 0xbe, 0xa0, 0x00, 0xb5, 0x55, 0x6a, 0x80, 0xf1, 0x00, 0x2f,
+    0x30, 0xc1, 0x83, 0x00, 0x00, 0x60, 0xa1, 0x06, 0x00, 0x00, 0x40, 0x83, 0x04, 0x00, 0x00, 0xc1,
+    0x86, 0x0c, 0x00, 0x00, 0x83, 0x02, 0x18, 0x00, 0x00, 0x02, 0x00, 0x10, 0x00, 0x00, 0x06, 0x00,
+    0x30, 0x00, 0x00, 0x0c, 0x00, 0x20, 0x00, 0x00, 0x08, 0x00, 0x60, 0x00, 0x00, 0x08, 0x00, 0x40,
+    0xf6, 0x00
+};
+const PackedBitmap cloud_rain_40x40 = {cloud_rain_40x40_data, sizeof(cloud_rain_40x40_data), 40, 40};
+
+static const uint8_t cloud_snow_40x40_data[] PROGMEM = { // 200 bytes raw
+    0xf6, 0x00, 0x01, 0x01, 0x7a, 0xfe, 0x00, 0x36, 0x06, 0xd6, 0x80, 0x00, 0x00, 0x0a, 0x02, 0x80,
+    0x00, 0x00, 0x18, 0x01, 0x60, 0x00, 0x00, 0x30, 0x00, 0x50, 0x00, 0x00, 0x50, 0x00, 0x30, 0x00,
+    0x00, 0x60, 0x00, 0x2a, 0x00, 0x00, 0xa0, 0x00, 0x1d, 0x80, 0x00, 0xc0, 0x00, 0x02, 0xe0, 0x00,
+    0x80, 0x00, 0x00, 0x50, 0x01, 0x80, 0x00, 0x00, 0x38, 0x06, 0xc0, 0x00, 0x00, 0x10, 0x0b, 0xfe,
+    0x00, 0xff, 0x0c, 0xfe, 0x00, 0x01, 0x0c, 0x18, 0xfe, 0x00, 0x01, 0x08, 0x10, 0xfe, 0x00, 0x01,
+    0x0c, 0x18, 0xfe, 0x00, 0x01, 0x14, 0x10, 0xfe, 0x00, 0x01, 0x0c, 0x18, 0xfe, 0x00, 0xff, 0x18,
+    0xfe, 0x00, 0x01, 0x30, 0x0c, 0xfe, 0x00, 0x0e, 0xe8, 0x07, 0xaa, 0xab, 0x5b, 0x40, 0x03, 0xff,
+    0xfe, 0xff, 0x80, 0x00, 0x00, 0x02, 0x80, 0xf5, 0x00, 0xff, 0x20, 0x14, 0x08, 0x00, 0x00, 0x10,
+    0x54, 0x22, 0x00, 0x00, 0x68, 0x28, 0x18, 0x00, 0x00, 0x50, 0x30, 0x28, 0x00, 0x00, 0x20, 0x44,
+    0x08, 0xfb, 0x00, 0x19, 0x01, 0x00, 0x80, 0x00, 0x00, 0x02, 0x02, 0x01, 0x40, 0x00, 0x03, 0x83,
+    0xc1, 0xa0, 0x00, 0x05, 0x01, 0x00, 0x80, 0x00, 0x00, 0x41, 0x22, 0x40, 0x00, 0x01, 0xfd, 0x00
+};
+const PackedBitmap cloud_snow_40x40 = {cloud_snow_40x40_data, sizeof(cloud_snow_40x40_data), 40, 40};
+
+static const uint8_t sun_max_40x40_data[] PROGMEM = { // 200 bytes raw
+    0xff, 0x00, 0x00, 0x10, 0xfd, 0x00, 0x00, 0x10, 0xfd, 0x00, 0x00, 0x28, 0xfd, 0x00, 0x00, 0x18,
+    0xfd, 0x00, 0x00, 0x28, 0xfd, 0x00, 0x1a, 0x18, 0x00, 0x00, 0x03, 0x00, 0x10, 0x01, 0xc0, 0x03,
+    0x80, 0x00, 0x02, 0x80, 0x01, 0x40, 0x00, 0x07, 0x00, 0x00, 0xe0, 0x00, 0x0a, 0x00, 0x00, 0x40,
+    0x10, 0x04, 0xfe, 0x00, 0x00, 0xdd, 0xfe, 0x00, 0x01, 0x03, 0x6b, 0xfe, 0x00, 0x43, 0x05, 0x85,
+    0xc0, 0x00, 0x00, 0x0e, 0x00, 0xa0, 0x00, 0x00, 0x08, 0x00, 0x60, 0x00, 0x00, 0x1c, 0x00, 0x30,
+    0x00, 0x00, 0x10, 0x00, 0x30, 0x00, 0x54, 0x18, 0x00, 0x28, 0x5a, 0xbc, 0x18, 0x00, 0x30, 0x6e,
+    0x6a, 0x28, 0x00, 0x18, 0x74, 0x00, 0x18, 0x00, 0x30, 0x00, 0x00, 0x14, 0x00, 0x50, 0x00, 0x00,
+    0x0c, 0x00, 0x60, 0x00, 0x00, 0x0a, 0x00, 0xa0, 0x00, 0x00, 0x07, 0x02, 0xc0, 0x00, 0x00, 0x03,
+    0xfb, 0x80, 0xfe, 0x00, 0x00, 0xae, 0xfe, 0x00, 0x1f, 0x40, 0x50, 0x04, 0x00, 0x00, 0xe0, 0x00,
+    0x0e, 0x00, 0x01, 0xa0, 0x00, 0x07, 0x00, 0x03, 0x80, 0x00, 0x03, 0x80, 0x06, 0x80, 0x10, 0x01,
+    0xc0, 0x01, 0x00, 0x18, 0x00, 0x80, 0x00, 0x00, 0x30, 0xfd, 0x00, 0x00, 0x18, 0xfd, 0x00, 0x00,
+    0x38, 0xfd, 0x00, 0x00, 0x28, 0xfd, 0x00, 0x00, 0x10, 0xfa, 0x00
+};
+const PackedBitmap sun_max_40x40 = {sun_max_40x40_data, sizeof(sun_max_40x40_data), 40, 40};
@@ -1,103 +1,17 @@
 #ifndef WEATHER_BITMAPS_H
 #define WEATHER_BITMAPS_H
 
-// Auto-generated from PNG files - 40x40 monochrome bitmaps
-// Each bitmap is 200 bytes
-
-const unsigned char cloud_bolt_rain_40x40[] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x74, 0x00, 0x00, 0x00, 
-  0x06, 0xad, 0x00, 0x00, 0x00, 0x15, 0x05, 0x00, 0x00, 0x00, 0x18, 0x01, 0xc0, 0x00, 0x00, 0x30, 
-  0x00, 0x60, 0x00, 0x00, 0x60, 0x00, 0x50, 0x00, 0x00, 0xa0, 0x00, 0x28, 0x00, 0x00, 0xc0, 0x00, 
-  0x3f, 0x00, 0x00, 0x80, 0x00, 0x02, 0xc0, 0x00, 0x80, 0x00, 0x00, 0xe0, 0x01, 0x80, 0x00, 0x00, 
-  0x30, 0x06, 0x80, 0x00, 0x00, 0x28, 0x0b, 0x00, 0x00, 0x00, 0x10, 0x1c, 0x00, 0x00, 0x00, 0x18, 
-  0x10, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x10, 0x10, 0x00, 0x00, 0x00, 0x18, 0x18, 
-  0x00, 0x00, 0x00, 0x30, 0x10, 0x00, 0x00, 0x00, 0x28, 0x1c, 0x00, 0x00, 0x00, 0xe0, 0x0a, 0x00, 
-  0x00, 0x02, 0xa0, 0x07, 0xff, 0xff, 0xff, 0x40, 0x01, 0x55, 0x55, 0x55, 0x00, 0x00, 0x08, 0x88, 
-  0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0xc0, 0x6c, 0x06, 
-  0x00, 0x01, 0x80, 0x58, 0x04, 0x00, 0x01, 0x00, 0x70, 0x0c, 0x00, 0x03, 0x00, 0xda, 0x08, 0x00, 
-  0x00, 0x10, 0xee, 0x18, 0x40, 0x00, 0x10, 0x38, 0x00, 0xc0, 0x00, 0x30, 0x18, 0x01, 0x80, 0x00, 
-  0x60, 0x60, 0x01, 0x00, 0x00, 0x40, 0x20, 0x03, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 
-  0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-const unsigned char cloud_fog_40x40[] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x03, 0xee, 0x00, 0x00, 0x00, 
-  0x0d, 0x15, 0x80, 0x00, 0x00, 0x14, 0x01, 0xc0, 0x00, 0x00, 0x38, 0x00, 0x70, 0x00, 0x00, 0x60, 
-  0x00, 0x20, 0x00, 0x00, 0xa0, 0x00, 0x38, 0x00, 0x00, 0xc0, 0x00, 0x17, 0x00, 0x00, 0x80, 0x00, 
-  0x0d, 0xe0, 0x01, 0x80, 0x00, 0x00, 0xb0, 0x01, 0x40, 0x00, 0x00, 0x28, 0x02, 0x80, 0x00, 0x00, 
-  0x1c, 0x0d, 0x80, 0x00, 0x00, 0x08, 0x16, 0x00, 0x00, 0x00, 0x06, 0x18, 0x00, 0x00, 0x00, 0x0c, 
-  0x28, 0x00, 0x00, 0x00, 0x06, 0x30, 0x00, 0x00, 0x00, 0x04, 0x30, 0x00, 0x00, 0x00, 0x06, 0x20, 
-  0x00, 0x00, 0x00, 0x0c, 0x30, 0x00, 0x00, 0x00, 0x14, 0x30, 0x00, 0x00, 0x00, 0x18, 0x1c, 0x00, 
-  0x00, 0x00, 0x68, 0x0b, 0x54, 0xaa, 0xab, 0xb0, 0x07, 0xef, 0xdd, 0xf6, 0xc0, 0x00, 0x29, 0x55, 
-  0x15, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x10, 0x00, 0x40, 0x00, 0x00, 0x7f, 0xff, 0xff, 0x00, 0x00, 0x4a, 0xaa, 0x95, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x29, 0x24, 0x92, 0x00, 0x00, 0x7f, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-const unsigned char cloud_40x40[] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0xa0, 0x00, 0x00, 0x00, 0x07, 0x7e, 0x00, 0x00, 0x00, 0x1a, 0x85, 
-  0x80, 0x00, 0x00, 0x28, 0x02, 0xc0, 0x00, 0x00, 0x50, 0x00, 0xa0, 0x00, 0x00, 0xa0, 0x00, 0x70, 
-  0x00, 0x00, 0xc0, 0x00, 0x10, 0x00, 0x01, 0x40, 0x00, 0x1e, 0x80, 0x01, 0x80, 0x00, 0x17, 0xa0, 
-  0x01, 0x00, 0x00, 0x00, 0xe8, 0x03, 0x00, 0x00, 0x00, 0x30, 0x03, 0x00, 0x00, 0x00, 0x1c, 0x0d, 
-  0x00, 0x00, 0x00, 0x04, 0x1c, 0x00, 0x00, 0x00, 0x0e, 0x30, 0x00, 0x00, 0x00, 0x04, 0x60, 0x00, 
-  0x00, 0x00, 0x06, 0x60, 0x00, 0x00, 0x00, 0x06, 0x50, 0x00, 0x00, 0x00, 0x04, 0x60, 0x00, 0x00, 
-  0x00, 0x0e, 0x60, 0x00, 0x00, 0x00, 0x08, 0x20, 0x00, 0x00, 0x00, 0x1c, 0x38, 0x00, 0x00, 0x00, 
-  0x30, 0x35, 0x54, 0x92, 0x45, 0xf0, 0x0f, 0xff, 0xff, 0xfe, 0xc0, 0x02, 0xaa, 0xaa, 0xb5, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-const unsigned char cloud_rain_40x40[] PROGMEM = {
-  0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x03, 0xae, 0x00, 0x00, 0x00, 0x0d, 0x55, 0x80, 0x00, 0x00, 
-  0x14, 0x02, 0xc0, 0x00, 0x00, 0x30, 0x00, 0xa0, 0x00, 0x00, 0x50, 0x00, 0x70, 0x00, 0x00, 0x60, 
-  0x00, 0x18, 0x00, 0x00, 0xc0, 0x00, 0x16, 0x80, 0x00, 0x80, 0x00, 0x1b, 0x40, 0x01, 0x80, 0x00, 
-  0x01, 0xb0, 0x01, 0x40, 0x00, 0x00, 0x58, 0x01, 0x80, 0x00, 0x00, 0x14, 0x06, 0x80, 0x00, 0x00, 
-  0x0c, 0x1e, 0x00, 0x00, 0x00, 0x0a, 0x10, 0x00, 0x00, 0x00, 0x06, 0x38, 0x00, 0x00, 0x00, 0x04, 
-  0x20, 0x00, 0x00, 0x00, 0x06, 0x30, 0x00, 0x00, 0x00, 0x0c, 0x20, 0x00, 0x00, 0x00, 0x06, 0x30, 
-  0x00, 0x00, 0x00, 0x0c, 0x30, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x34, 0x1e, 0xa4, 
-  0x92, 0x49, 0xe8, 0x07, 0xdf, 0xff, 0xbe, 0xa0, 0x00, 0xb5, 0x55, 0x6a, 0x80, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0xc1, 0x83, 
-  0x00, 0x00, 0x60, 0xa1, 0x06, 0x00, 0x00, 0x40, 0x83, 0x04, 0x00, 0x00, 0xc1, 0x86, 0x0c, 0x00, 
-  0x00, 0x83, 0x02, 0x18, 0x00, 0x00, 0x02, 0x00, 0x10, 0x00, 0x00, 0x06, 0x00, 0x30, 0x00, 0x00, 
-  0x0c, 0x00, 0x20, 0x00, 0x00, 0x08, 0x00, 0x60, 0x00, 0x00, 0x08, 0x00, 0x40, 0x00, 0x00, 0x00, 
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-const unsigned char cloud_snow_40x40[] PROGMEM = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x7a, 0x00, 0x00, 0x00, 
-  0x06, 0xd6, 0x80, 0x00, 0x00, 0x0a, 0x02, 0x80, 0x00, 0x00, 0x18, 0x01, 0x60, 0x00, 0x00, 0x30, 
-  0x00, 0x50, 0x00, 0x00, 0x50, 0x00, 0x30, 0x00, 0x00, 0x60, 0x00, 0x2a, 0x00, 0x00, 0xa0, 0x00, 
-  0x1d, 0x80, 0x00, 0xc0, 0x00, 0x02, 0xe0, 0x00, 0x80, 0x00, 0x00, 0x50, 0x01, 0x80, 0x00, 0x00, 
-  0x38, 0x06, 0xc0, 0x00, 0x00, 0x10, 0x0b, 0x00, 0x00, 0x00, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x0c, 
-  0x18, 0x00, 0x00, 0x00, 0x08, 0x10, 0x00, 0x00, 0x00, 0x0c, 0x18, 0x00, 0x00, 0x00, 0x14, 0x10, 
-  0x00, 0x00, 0x00, 0x0c, 0x18, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x30, 0x0c, 0x00, 
-  0x00, 0x00, 0xe8, 0x07, 0xaa, 0xab, 0x5b, 0x40, 0x03, 0xff, 0xfe, 0xff, 0x80, 0x00, 0x00, 0x02, 
-  0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x20, 0x08, 
-  0x00, 0x00, 0x10, 0x54, 0x22, 0x00, 0x00, 0x68, 0x28, 0x18, 0x00, 0x00, 0x50, 0x30, 0x28, 0x00, 
-  0x00, 0x20, 0x44, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x80, 0x00, 0x00, 0x02, 
-  0x02, 0x01, 0x40, 0x00, 0x03, 0x83, 0xc1, 0xa0, 0x00, 0x05, 0x01, 0x00, 0x80, 0x00, 0x00, 0x41, 
-  0x22, 0x40, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00
-};
-
-const unsigned char sun_max_40x40[] PROGMEM = {
-  0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00, 
-  0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x03, 0x00, 
-  0x10, 0x01, 0xc0, 0x03, 0x80, 0x00, 0x02, 0x80, 0x01, 0x40, 0x00, 0x07, 0x00, 0x00, 0xe0, 0x00, 
-  0x0a, 0x00, 0x00, 0x40, 0x10, 0x04, 0x00, 0x00, 0x00, 0xdd, 0x00, 0x00, 0x00, 0x03, 0x6b, 0x00, 
-  0x00, 0x00, 0x05, 0x85, 0xc0, 0x00, 0x00, 0x0e, 0x00, 0xa0, 0x00, 0x00, 0x08, 0x00, 0x60, 0x00, 
-  0x00, 0x1c, 0x00, 0x30, 0x00, 0x00, 0x10, 0x00, 0x30, 0x00, 0x54, 0x18, 0x00, 0x28, 0x5a, 0xbc, 
-  0x18, 0x00, 0x30, 0x6e, 0x6a, 0x28, 0x00, 0x18, 0x74, 0x00, 0x18, 0x00, 0x30, 0x00, 0x00, 0x14, 
-  0x00, 0x50, 0x00, 0x00, 0x0c, 0x00, 0x60, 0x00, 0x00, 0x0a, 0x00, 0xa0, 0x00, 0x00, 0x07, 0x02, 
-  0xc0, 0x00, 0x00, 0x03, 0xfb, 0x80, 0x00, 0x00, 0x00, 0xae, 0x00, 0x00, 0x00, 0x40, 0x50, 0x04, 
-  0x00, 0x00, 0xe0, 0x00, 0x0e, 0x00, 0x01, 0xa0, 0x00, 0x07, 0x00, 0x03, 0x80, 0x00, 0x03, 0x80, 
-  0x06, 0x80, 0x10, 0x01, 0xc0, 0x01, 0x00, 0x18, 0x00, 0x80, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 
-  0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00, 0x00, 
-  0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
+#include "packed_bitmap.h"
+
+// Weather icons from PNG files - 40x40 monochrome bitmaps (1 = black)
+// 200 bytes each raw, PackBits compressed
+
+// Auto-generated - do not edit manually. Use scripts/png_to_bitmap.py to regenerate.
+extern const PackedBitmap cloud_bolt_rain_40x40;
+extern const PackedBitmap cloud_fog_40x40;
+extern const PackedBitmap cloud_40x40;
+extern const PackedBitmap cloud_rain_40x40;
+extern const PackedBitmap cloud_snow_40x40;
+extern const PackedBitmap sun_max_40x40;
 
 #endif // WEATHER_BITMAPS_H
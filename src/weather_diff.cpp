@@ -0,0 +1,213 @@
+#include "weather_diff.h"
+#include "text_format.h"
+#include <cstring>
+
+// A panel refresh has a fixed cost regardless of window size. Expressed as pixel area, this
+// decides when two dirty rectangles are cheaper to refresh as one window.
+const int32_t REFRESH_OVERHEAD_AREA = 400 * 120;
+
+// Region rows, in panel coordinates before alignment
+const int CURRENT_TEMP_TOP = CURRENT_TEMP_Y - 6;
+const int CURRENT_TEMP_BOTTOM = CURRENT_TEMP_Y + 114;
+const int CELL_TOP_MARGIN = 2;                                         // Label ascent sits above the start row
+const int CELL_HEIGHT = ICON_HEIGHT + TEXT_HEIGHT * 2 + 14;            // Label, icon, temp + descent
+const int LAST_UPDATED_TOP = LAST_UPDATED_Y - 20;                      // Ascent of FreeSans9pt7b
+const int LAST_UPDATED_BOTTOM = LAST_UPDATED_Y + 12;                   // Descent
+const int AIR_QUALITY_TOP = AIR_QUALITY_Y - 14;                        // Stays below the current temp
+const int AIR_QUALITY_BOTTOM = AIR_QUALITY_Y + 5;                      // and above the hourly labels
+
+static int16_t roundTemp(int16_t tenths)
+{
+    // Rounded the way the pane prints it so the diff matches the pixels
+    return (int16_t)TextFormat::roundTenths(tenths);
+}
+
+static ScreenRect alignRect(int x0, int y0, int x1, int y1)
+{
+    // Partial windows work in whole bytes of 8 pixels
+    x0 &= ~7;
+    y0 &= ~7;
+    x1 = (x1 + 7) & ~7;
+    y1 = (y1 + 7) & ~7;
+    return {(int16_t)x0, (int16_t)y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+}
+
+static int32_t area(const ScreenRect &r)
+{
+    return (int32_t)r.w * r.h;
+}
+
+void WeatherDiff::capture(const WeatherData &weather, RenderedWeather &rendered)
+{
+    memset(&rendered, 0, sizeof(rendered));
+    rendered.valid = true;
+    rendered.currentTemp = roundTemp(weather.currentTemp);
+
+    for (int i = 0; i < HOURLY_COLUMNS; i++)
+    {
+        rendered.hourly[i].hour = (uint8_t)weather.hourly[i].hour;
+        rendered.hourly[i].temp = roundTemp(weather.hourly[i].temp);
+        rendered.hourly[i].condition = weather.hourly[i].condition;
+    }
+
+    for (int i = 0; i < DAILY_COLUMNS; i++)
+    {
+        rendered.daily[i].dayOfWeek = weather.daily[i].dayOfWeek;
+        rendered.daily[i].tempHigh = roundTemp(weather.daily[i].tempHigh);
+        rendered.daily[i].tempLow = roundTemp(weather.daily[i].tempLow);
+        rendered.daily[i].condition = weather.daily[i].condition;
+    }
+
+    // Stamp is only drawn when lastUpdated is set
+    rendered.stampMinutes = (weather.lastUpdated > 0) ? (uint32_t)(weather.lastUpdated / 60) : 0;
+    rendered.location = weather.location;
+    rendered.usAqi = weather.hasAirQuality ? (int16_t)weather.usAqi : -1;
+    rendered.pm25 = weather.hasAirQuality ? roundTemp((int16_t)weather.pm25Tenths) : 0;
+}
+
+uint32_t WeatherDiff::changedRegions(const RenderedWeather &shown, const RenderedWeather &next)
+{
+    if (!shown.valid)
+    {
+        return (1u << WEATHER_REGION_COUNT) - 1;
+    }
+
+    uint32_t changed = 0;
+    if (shown.currentTemp != next.currentTemp)
+    {
+        changed |= 1u << REGION_CURRENT_TEMP;
+    }
+
+    for (int i = 0; i < HOURLY_COLUMNS; i++)
+    {
+        if (shown.hourly[i].hour != next.hourly[i].hour ||
+            shown.hourly[i].temp != next.hourly[i].temp ||
+            shown.hourly[i].condition != next.hourly[i].condition)
+        {
+            changed |= 1u << (REGION_HOURLY_FIRST + i);
+        }
+    }
+
+    for (int i = 0; i < DAILY_COLUMNS; i++)
+    {
+        if (shown.daily[i].dayOfWeek != next.daily[i].dayOfWeek ||
+            shown.daily[i].tempHigh != next.daily[i].tempHigh ||
+            shown.daily[i].tempLow != next.daily[i].tempLow ||
+            shown.daily[i].condition != next.daily[i].condition)
+        {
+            changed |= 1u << (REGION_DAILY_FIRST + i);
+        }
+    }
+
+    if (shown.stampMinutes != next.stampMinutes)
+    {
+        changed |= 1u << REGION_LAST_UPDATED;
+    }
+
+    if (shown.location != next.location)
+    {
+        changed |= 1u << REGION_LOCATION_NAME;
+    }
+
+    if (shown.usAqi != next.usAqi || shown.pm25 != next.pm25)
+    {
+        changed |= 1u << REGION_AIR_QUALITY;
+    }
+    return changed;
+}
+
+ScreenRect WeatherDiff::regionRect(int region)
+{
+    if (region == REGION_CURRENT_TEMP)
+    {
+        return alignRect(WEATHER_PANE_X, CURRENT_TEMP_TOP, WEATHER_PANE_X + WEATHER_PANE_WIDTH, CURRENT_TEMP_BOTTOM);
+    }
+
+    if (region >= REGION_HOURLY_FIRST && region < REGION_DAILY_FIRST)
+    {
+        int colWidth = WEATHER_PANE_WIDTH / HOURLY_COLUMNS;
+        int x = WEATHER_PANE_X + (region - REGION_HOURLY_FIRST) * colWidth;
+        int y = HOURLY_START_Y - CELL_TOP_MARGIN;
+        return alignRect(x, y, x + colWidth, y + CELL_HEIGHT);
+    }
+
+    if (region >= REGION_DAILY_FIRST && region < REGION_LAST_UPDATED)
+    {
+        int colWidth = WEATHER_PANE_WIDTH / DAILY_COLUMNS;
+        int x = WEATHER_PANE_X + (region - REGION_DAILY_FIRST) * colWidth;
+        int y = DAILY_START_Y - CELL_TOP_MARGIN;
+        return alignRect(x, y, x + colWidth, y + CELL_HEIGHT);
+    }
+
+    if (region == REGION_AIR_QUALITY)
+    {
+        return alignRect(WEATHER_PANE_X, AIR_QUALITY_TOP, WEATHER_PANE_X + WEATHER_PANE_WIDTH, AIR_QUALITY_BOTTOM);
+    }
+
+    if (region == REGION_LOCATION_NAME)
+    {
+        return alignRect(LOCATION_NAME_X, LAST_UPDATED_TOP, LAST_UPDATED_X, LAST_UPDATED_BOTTOM);
+    }
+
+    return alignRect(LAST_UPDATED_X, LAST_UPDATED_TOP, WEATHER_PANE_X + WEATHER_PANE_WIDTH, LAST_UPDATED_BOTTOM);
+}
+
+int WeatherDiff::refreshRects(uint32_t changed, ScreenRect *rects)
+{
+    int count = 0;
+    for (int region = 0; region < WEATHER_REGION_COUNT; region++)
+    {
+        if (changed & (1u << region))
+        {
+            rects[count++] = regionRect(region);
+        }
+    }
+    return mergeRects(rects, count);
+}
+
+int WeatherDiff::mergeRects(ScreenRect *rects, int count)
+{
+    // Greedily merge the pair with the biggest saving until no merge pays off
+    while (count > 1)
+    {
+        int bestA = -1, bestB = -1;
+        int32_t bestSaving = 0;
+        for (int a = 0; a < count; a++)
+        {
+            for (int b = a + 1; b < count; b++)
+            {
+                ScreenRect merged = unionRect(rects[a], rects[b]);
+                int32_t saving = REFRESH_OVERHEAD_AREA + area(rects[a]) + area(rects[b]) - area(merged);
+                if (saving > bestSaving)
+                {
+                    bestSaving = saving;
+                    bestA = a;
+                    bestB = b;
+                }
+            }
+        }
+
+        if (bestA < 0)
+        {
+            break;
+        }
+
+        rects[bestA] = unionRect(rects[bestA], rects[bestB]);
+        rects[bestB] = rects[--count];
+    }
+    return count;
+}
+
+bool WeatherDiff::intersects(const ScreenRect &a, const ScreenRect &b)
+{
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+ScreenRect WeatherDiff::unionRect(const ScreenRect &a, const ScreenRect &b)
+{
+    int x0 = (a.x < b.x) ? a.x : b.x;
+    int y0 = (a.y < b.y) ? a.y : b.y;
+    int x1 = (a.x + a.w > b.x + b.w) ? a.x + a.w : b.x + b.w;
+    int y1 = (a.y + a.h > b.y + b.h) ? a.y + a.h : b.y + b.h;
+    return {(int16_t)x0, (int16_t)y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+}
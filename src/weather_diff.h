@@ -0,0 +1,107 @@
+#ifndef WEATHER_DIFF_H
+#define WEATHER_DIFF_H
+
+#include <cstdint>
+#include "types.h"
+#include "weather_layout.h"
+
+// Weather pane regions that can be refreshed independently
+enum WeatherRegion
+{
+    REGION_CURRENT_TEMP = 0,
+    REGION_HOURLY_FIRST = 1, // HOURLY_COLUMNS cells
+    REGION_DAILY_FIRST = REGION_HOURLY_FIRST + HOURLY_COLUMNS, // DAILY_COLUMNS cells
+    REGION_LAST_UPDATED = REGION_DAILY_FIRST + DAILY_COLUMNS,
+    REGION_LOCATION_NAME, // Carousel location, bottom left
+    REGION_AIR_QUALITY,   // AQI line under the current temp
+    WEATHER_REGION_COUNT
+};
+
+// Screen rectangle in absolute panel coordinates
+struct ScreenRect
+{
+    int16_t x, y, w, h;
+};
+
+// What is currently on the panel, reduced to the values that affect pixels.
+// Compact plain data so it can live in RTC memory.
+struct RenderedWeather
+{
+    bool valid; // false = pane contents unknown (fresh boot), everything is dirty
+    int16_t currentTemp;
+    struct
+    {
+        uint8_t hour;
+        int16_t temp;
+        uint8_t condition;
+    } hourly[HOURLY_COLUMNS];
+    struct
+    {
+        uint8_t dayOfWeek;
+        int16_t tempHigh;
+        int16_t tempLow;
+        uint8_t condition;
+    } daily[DAILY_COLUMNS];
+    uint32_t stampMinutes; // lastUpdated in minutes (the stamp shows HH:MM)
+    uint8_t location;      // Carousel index whose name is shown
+    int16_t usAqi;         // AQI shown (-1 = none)
+    int16_t pm25;          // PM2.5 as printed
+};
+
+// Field-level diff between what is on the panel and a new forecast.
+// Compares plain structs and returns rectangles; drawing stays in DisplayWeather.
+
+class WeatherDiff
+{
+public:
+    /**
+     * Reduce a forecast to the values the renderer actually shows
+     * @param weather Forecast to render
+     * @param rendered Output compact state
+     */
+    static void capture(const WeatherData &weather, RenderedWeather &rendered);
+
+    /**
+     * Compare shown and next state region by region
+     * @param shown State currently on the panel
+     * @param next State about to be rendered
+     * @return Bitmask of WeatherRegion bits that changed (0 = nothing visible changed)
+     */
+    static uint32_t changedRegions(const RenderedWeather &shown, const RenderedWeather &next);
+
+    /**
+     * Screen rectangle covering one region, 8-px aligned
+     * @param region WeatherRegion index
+     * @return Rectangle in absolute panel coordinates
+     */
+    static ScreenRect regionRect(int region);
+
+    /**
+     * Turn a changed-region mask into refresh windows. Each window costs a panel refresh,
+     * so neighbouring rectangles are merged whenever that is cheaper than refreshing twice.
+     * @param changed Bitmask from changedRegions
+     * @param rects Output array with room for WEATHER_REGION_COUNT rectangles
+     * @return Number of refresh windows written
+     */
+    static int refreshRects(uint32_t changed, ScreenRect *rects);
+
+    /**
+     * Merge refresh windows in place while one refresh is cheaper than two
+     * @param rects Rectangles to merge
+     * @param count Number of rectangles
+     * @return Number of rectangles left at the front of rects
+     */
+    static int mergeRects(ScreenRect *rects, int count);
+
+    /**
+     * Check whether two rectangles overlap
+     */
+    static bool intersects(const ScreenRect &a, const ScreenRect &b);
+
+    /**
+     * Smallest rectangle containing both
+     */
+    static ScreenRect unionRect(const ScreenRect &a, const ScreenRect &b);
+};
+
+#endif // WEATHER_DIFF_H
@@ -0,0 +1,30 @@
+#ifndef WEATHER_LAYOUT_H
+#define WEATHER_LAYOUT_H
+
+#include "config.h"
+
+// Weather pane layout (right half of the screen)
+// Shared by DisplayWeather and the refresh-region math in WeatherDiff
+
+const int WEATHER_PANE_X = DISPLAY_LEFT_HALF;
+const int WEATHER_PANE_WIDTH = DISPLAY_RIGHT_HALF;
+
+const int CURRENT_TEMP_Y = 30;
+const int AIR_QUALITY_Y = 160; // Baseline of the AQI line between the current temp and the hourly row
+const int HOURLY_START_Y = 170;
+const int DAILY_START_Y = 290;
+const int ICON_HEIGHT = 50;
+const int TEXT_HEIGHT = 20;
+
+const int HOURLY_COLUMNS = 5;
+const int DAILY_COLUMNS = 4;
+
+// "Last updated" stamp, bottom right
+const int LAST_UPDATED_WIDTH = 150;
+const int LAST_UPDATED_X = WEATHER_PANE_X + WEATHER_PANE_WIDTH - LAST_UPDATED_WIDTH + 20;
+const int LAST_UPDATED_Y = 460;
+
+// Carousel location name, bottom left (same baseline as the stamp)
+const int LOCATION_NAME_X = WEATHER_PANE_X + 20;
+
+#endif // WEATHER_LAYOUT_H
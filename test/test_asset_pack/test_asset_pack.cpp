@@ -0,0 +1,279 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "../../src/asset_pack.h"
+#include "../../src/asset_pack.cpp" // Include implementation directly for testing
+#include "../../src/packed_bitmap.cpp"
+#include "../../src/text_layout.cpp"
+#include "../../src/digit_bitmaps.cpp"
+#include "../../src/weather_bitmaps.cpp"
+
+const size_t PARTITION_SIZE = 0x40000; // assets row of partitions.csv
+
+struct NamedBitmap
+{
+    const char *name;
+    const PackedBitmap *bitmap;
+};
+
+static const NamedBitmap BITMAPS[] = {
+    {"DIGIT_0_BITMAP", &DIGIT_0_BITMAP}, {"DIGIT_1_BITMAP", &DIGIT_1_BITMAP}, {"DIGIT_2_BITMAP", &DIGIT_2_BITMAP},
+    {"DIGIT_3_BITMAP", &DIGIT_3_BITMAP}, {"DIGIT_4_BITMAP", &DIGIT_4_BITMAP}, {"DIGIT_5_BITMAP", &DIGIT_5_BITMAP},
+    {"DIGIT_6_BITMAP", &DIGIT_6_BITMAP}, {"DIGIT_7_BITMAP", &DIGIT_7_BITMAP}, {"DIGIT_8_BITMAP", &DIGIT_8_BITMAP},
+    {"DIGIT_9_BITMAP", &DIGIT_9_BITMAP}, {"COLON_BITMAP", &COLON_BITMAP},     {"DEGREE_BITMAP", &DEGREE_BITMAP},
+    {"cloud_bolt_rain_40x40", &cloud_bolt_rain_40x40}, {"cloud_fog_40x40", &cloud_fog_40x40},
+    {"cloud_40x40", &cloud_40x40},       {"cloud_rain_40x40", &cloud_rain_40x40},
+    {"cloud_snow_40x40", &cloud_snow_40x40}, {"sun_max_40x40", &sun_max_40x40},
+};
+const int BITMAP_COUNT = sizeof(BITMAPS) / sizeof(BITMAPS[0]);
+
+// Small GFX font: printable ASCII, glyph sizes and offsets varied, bits packed like fontconvert
+static GFXglyph glyphs[0x7E - 0x20 + 1];
+static std::vector<uint8_t> fontBits;
+static GFXfont font;
+
+static void buildFont()
+{
+    uint32_t seed = 4242;
+    for (int c = 0x20; c <= 0x7E; c++)
+    {
+        GFXglyph &g = glyphs[c - 0x20];
+        g.width = c == ' ' ? 0 : (uint8_t)(2 + (c * 3) % 11);
+        g.height = c == ' ' ? 0 : (uint8_t)(4 + (c * 7) % 13);
+        g.xAdvance = (uint8_t)(g.width + 2);
+        g.xOffset = (int8_t)(c % 3 - 1);
+        g.yOffset = (int8_t)(-(int)g.height + c % 4);
+        g.bitmapOffset = (uint16_t)fontBits.size();
+        for (int i = 0; i < (g.width * g.height + 7) / 8; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            fontBits.push_back((uint8_t)(seed >> 16));
+        }
+    }
+    font = {fontBits.data(), glyphs, 0x20, 0x7E, 24};
+}
+
+// Blob as flashed into the partition: the rest of the partition stays erased (0xFF)
+static void buildPartition(std::vector<uint8_t> &partition, size_t &blobLength)
+{
+    partition.assign(PARTITION_SIZE, 0xFF);
+    AssetPackWriter writer(partition.data(), partition.size(), BITMAP_COUNT + 1);
+    for (int i = 0; i < BITMAP_COUNT; i++)
+    {
+        TEST_ASSERT_TRUE(writer.addBitmap(BITMAPS[i].name, *BITMAPS[i].bitmap));
+    }
+    TEST_ASSERT_TRUE(writer.addFont("FreeSans9pt7b", font, fontBits.size()));
+    blobLength = writer.finish();
+    TEST_ASSERT_TRUE(blobLength > 0);
+}
+
+// Host stand-in for esp_partition_mmap: the partition image in a file, mapped read-only
+struct MappedFile
+{
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+
+    bool map(const std::vector<uint8_t> &contents)
+    {
+        char path[] = "/tmp/asset_pack_XXXXXX";
+        int fd = mkstemp(path);
+        if (fd < 0)
+            return false;
+        bool written = write(fd, contents.data(), contents.size()) == (ssize_t)contents.size();
+        void *mapping = written ? mmap(nullptr, contents.size(), PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        close(fd);
+        unlink(path);
+        if (mapping == MAP_FAILED)
+            return false;
+        data = (const uint8_t *)mapping;
+        size = contents.size();
+        return true;
+    }
+
+    ~MappedFile()
+    {
+        if (data)
+            munmap((void *)data, size);
+    }
+};
+
+static bool inside(const void *p, const MappedFile &file)
+{
+    return (const uint8_t *)p >= file.data && (const uint8_t *)p < file.data + file.size;
+}
+
+void test_mapped_blob_resolves_every_asset_in_place()
+{
+    size_t blobLength;
+    std::vector<uint8_t> partition;
+    buildPartition(partition, blobLength);
+    MappedFile file;
+    TEST_ASSERT_TRUE(file.map(partition));
+
+    AssetPack pack;
+    TEST_ASSERT_TRUE(pack.begin(file.data, file.size, true));
+    TEST_ASSERT_EQUAL(BITMAP_COUNT + 1, pack.count());
+    TEST_ASSERT_EQUAL(blobLength, pack.length());
+
+    for (int i = 0; i < BITMAP_COUNT; i++)
+    {
+        PackedBitmap mapped;
+        TEST_ASSERT_TRUE(pack.bitmap(BITMAPS[i].name, mapped));
+        TEST_ASSERT_TRUE(inside(mapped.data, file));
+        TEST_ASSERT_EQUAL(BITMAPS[i].bitmap->width, mapped.width);
+        TEST_ASSERT_EQUAL(BITMAPS[i].bitmap->height, mapped.height);
+        TEST_ASSERT_EQUAL(BITMAPS[i].bitmap->length, mapped.length);
+        TEST_ASSERT_EQUAL_MEMORY(BITMAPS[i].bitmap->data, mapped.data, mapped.length);
+    }
+
+    // Names are per kind; unknown names fall back to the built-ins
+    PackedBitmap bitmap;
+    GFXfont mappedFont;
+    TEST_ASSERT_FALSE(pack.bitmap("FreeSans9pt7b", bitmap));
+    TEST_ASSERT_FALSE(pack.font("DIGIT_0_BITMAP", mappedFont));
+    TEST_ASSERT_FALSE(pack.bitmap("moon_40x40", bitmap));
+
+    TEST_ASSERT_TRUE(pack.font("FreeSans9pt7b", mappedFont));
+    TEST_ASSERT_TRUE(inside(mappedFont.glyph, file));
+    TEST_ASSERT_TRUE(inside(mappedFont.bitmap, file));
+    TEST_ASSERT_EQUAL(0, (uintptr_t)mappedFont.glyph % alignof(GFXglyph));
+    TEST_ASSERT_EQUAL(font.first, mappedFont.first);
+    TEST_ASSERT_EQUAL(font.last, mappedFont.last);
+    TEST_ASSERT_EQUAL(font.yAdvance, mappedFont.yAdvance);
+    TEST_ASSERT_EQUAL_MEMORY(fontBits.data(), mappedFont.bitmap, fontBits.size());
+}
+
+void test_mapped_assets_draw_and_measure_like_built_ins()
+{
+    size_t blobLength;
+    std::vector<uint8_t> partition;
+    buildPartition(partition, blobLength);
+    MappedFile file;
+    TEST_ASSERT_TRUE(file.map(partition));
+    AssetPack pack;
+    TEST_ASSERT_TRUE(pack.begin(file.data, file.size, false));
+
+    std::vector<uint8_t> builtIn(400 / 8 * 480, 0xFF), mapped(400 / 8 * 480, 0xFF);
+    RasterTarget builtInTarget = {builtIn.data(), 400, 0, 400, 480, 0, 480, 800, 480};
+    RasterTarget mappedTarget = builtInTarget;
+    mappedTarget.buffer = mapped.data();
+    for (int i = 0; i < BITMAP_COUNT; i++)
+    {
+        PackedBitmap bitmap;
+        TEST_ASSERT_TRUE(pack.bitmap(BITMAPS[i].name, bitmap));
+        int16_t x = (int16_t)(380 + (i % 6) * 71);
+        int16_t y = (int16_t)((i / 6) * 130 - 20);
+        TEST_ASSERT_TRUE(PackedBlit::draw(builtInTarget, *BITMAPS[i].bitmap, x, y));
+        TEST_ASSERT_TRUE(PackedBlit::draw(mappedTarget, bitmap, x, y));
+    }
+    TEST_ASSERT_EQUAL_MEMORY(builtIn.data(), mapped.data(), builtIn.size());
+
+    GFXfont mappedFont;
+    TEST_ASSERT_TRUE(pack.font("FreeSans9pt7b", mappedFont));
+    const char *labels[] = {"Battery: 87%", "Jan 01 14:30", "~{|}", " ", "Wednesday"};
+    for (const char *label : labels)
+    {
+        TextExtent a = TextLayout::measure(&font, label);
+        TextExtent b = TextLayout::measure(&mappedFont, label);
+        TEST_ASSERT_EQUAL(a.x1, b.x1);
+        TEST_ASSERT_EQUAL(a.y1, b.y1);
+        TEST_ASSERT_EQUAL(a.w, b.w);
+        TEST_ASSERT_EQUAL(a.h, b.h);
+    }
+}
+
+void test_rejects_blobs_it_cannot_trust()
+{
+    size_t blobLength;
+    std::vector<uint8_t> good;
+    buildPartition(good, blobLength);
+    AssetPack pack;
+
+    // Never flashed
+    std::vector<uint8_t> erased(PARTITION_SIZE, 0xFF);
+    TEST_ASSERT_FALSE(pack.begin(erased.data(), erased.size(), false));
+    TEST_ASSERT_FALSE(pack.valid());
+    TEST_ASSERT_FALSE(pack.begin(nullptr, 0, false));
+
+    // Newer format
+    std::vector<uint8_t> blob = good;
+    blob[2] = ASSET_PACK_VERSION + 1;
+    TEST_ASSERT_FALSE(pack.begin(blob.data(), blob.size(), false));
+
+    // Partition smaller than the blob claims
+    TEST_ASSERT_FALSE(pack.begin(good.data(), blobLength - 1, false));
+    TEST_ASSERT_TRUE(pack.begin(good.data(), blobLength, true));
+
+    // A flipped payload bit passes the structural checks, not the checksum
+    blob = good;
+    blob[blobLength - 1] ^= 0x10;
+    TEST_ASSERT_TRUE(pack.begin(blob.data(), blob.size(), false));
+    TEST_ASSERT_FALSE(pack.begin(blob.data(), blob.size(), true));
+
+    // Index entries pointing outside the blob or off alignment
+    blob = good;
+    blob[ASSET_PACK_HEADER_SIZE + 12] = 0xFF; // Length of the first entry
+    blob[ASSET_PACK_HEADER_SIZE + 13] = 0xFF;
+    TEST_ASSERT_FALSE(pack.begin(blob.data(), blob.size(), false));
+    blob = good;
+    blob[ASSET_PACK_HEADER_SIZE + 8] += 2; // Offset of the first entry
+    TEST_ASSERT_FALSE(pack.begin(blob.data(), blob.size(), false));
+
+    // Font whose glyph table would run past its payload
+    blob = good;
+    size_t fontEntry = ASSET_PACK_HEADER_SIZE + BITMAP_COUNT * ASSET_INDEX_ENTRY_SIZE;
+    uint32_t fontOffset = blob[fontEntry + 8] | (blob[fontEntry + 9] << 8) | (blob[fontEntry + 10] << 16);
+    blob[fontOffset + 2] = 0xFF; // last = 0xFF7E
+    TEST_ASSERT_FALSE(pack.begin(blob.data(), blob.size(), false));
+    TEST_ASSERT_FALSE(pack.valid());
+
+    // Doesn't fit
+    std::vector<uint8_t> small(2048);
+    AssetPackWriter writer(small.data(), small.size(), 2);
+    TEST_ASSERT_TRUE(writer.addBitmap("DIGIT_8_BITMAP", DIGIT_8_BITMAP));
+    TEST_ASSERT_FALSE(writer.addBitmap("DIGIT_9_BITMAP", DIGIT_9_BITMAP) && writer.addBitmap("COLON_BITMAP", COLON_BITMAP));
+    TEST_ASSERT_EQUAL(0, writer.finish());
+}
+
+void test_open_cost()
+{
+    size_t blobLength;
+    std::vector<uint8_t> partition;
+    buildPartition(partition, blobLength);
+    MappedFile file;
+    TEST_ASSERT_TRUE(file.map(partition));
+    AssetPack pack;
+    const int runs = 2000;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++)
+        pack.begin(file.data, file.size, false);
+    double indexUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++)
+        pack.begin(file.data, file.size, true);
+    double checksumUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "%d assets, %zu byte blob: open %.2f us, with checksum %.2f us on host", pack.count(),
+             blobLength, indexUs, checksumUs);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(pack.valid());
+}
+
+int main()
+{
+    buildFont();
+    UNITY_BEGIN();
+    RUN_TEST(test_mapped_blob_resolves_every_asset_in_place);
+    RUN_TEST(test_mapped_assets_draw_and_measure_like_built_ins);
+    RUN_TEST(test_rejects_blobs_it_cannot_trust);
+    RUN_TEST(test_open_cost);
+    return UNITY_END();
+}
@@ -0,0 +1,279 @@
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <vector>
+#include "../../src/band_transfer.h"
+#include "../../src/band_transfer.cpp" // Include implementation directly for testing
+#include "../../src/frame_codec.cpp"
+
+const int PANEL_WIDTH = 800;
+const int PANEL_HEIGHT = 480;
+const int BAND_ROWS = 60; // DISPLAY_PAGE_ROWS
+const size_t BAND_BYTES = PANEL_WIDTH / 8 * BAND_ROWS;
+const uint16_t COMMAND = 0x100; // Wire entries: command bytes carry this bit, data bytes don't
+
+// Records what goes out on the wire, in order, the way the controller sees it. Queued
+// transfers reach the wire when waited for, from the buffer as it is then - so a band
+// rewritten while still in flight shows up in the stream as well as in the overwrite count.
+// A simulated clock charges every byte at hz; queued bytes go out while the caller works.
+struct MockSpi
+{
+    struct Pending
+    {
+        const uint8_t *bytes;
+        std::vector<uint8_t> queuedAs;
+        double doneUs;
+    };
+    std::vector<uint16_t> wire;
+    std::deque<Pending> queued;
+    int maxInFlight = 0;
+    int overwrites = 0;      // Buffers changed between queue and completion
+    int outOfOrder = 0;      // Commands or blocking data while transfers were queued
+    bool blocking = false;   // Queue waits for the transfer, like the Arduino SPI fallback
+    double hz = 20e6;
+    double nowUs = 0;
+    double wireFreeUs = 0;
+
+    double byteUs() const { return 8e6 / hz; }
+
+    static void command(void *context, uint8_t command)
+    {
+        MockSpi *spi = (MockSpi *)context;
+        spi->outOfOrder += spi->queued.empty() ? 0 : 1;
+        spi->wire.push_back(COMMAND | command);
+        spi->nowUs += spi->byteUs();
+        spi->wireFreeUs = spi->nowUs;
+    }
+
+    static void data(void *context, const uint8_t *bytes, size_t length)
+    {
+        MockSpi *spi = (MockSpi *)context;
+        spi->outOfOrder += spi->queued.empty() ? 0 : 1;
+        spi->wire.insert(spi->wire.end(), bytes, bytes + length);
+        spi->nowUs += length * spi->byteUs();
+        spi->wireFreeUs = spi->nowUs;
+    }
+
+    static void queue(void *context, const uint8_t *bytes, size_t length)
+    {
+        MockSpi *spi = (MockSpi *)context;
+        double start = spi->nowUs > spi->wireFreeUs ? spi->nowUs : spi->wireFreeUs;
+        spi->wireFreeUs = start + length * spi->byteUs();
+        spi->queued.push_back({bytes, std::vector<uint8_t>(bytes, bytes + length), spi->wireFreeUs});
+        spi->maxInFlight = (int)spi->queued.size() > spi->maxInFlight ? (int)spi->queued.size() : spi->maxInFlight;
+        if (spi->blocking)
+            waitOldest(context);
+    }
+
+    static void waitOldest(void *context)
+    {
+        MockSpi *spi = (MockSpi *)context;
+        if (spi->queued.empty())
+            return;
+        Pending &p = spi->queued.front();
+        if (memcmp(p.bytes, p.queuedAs.data(), p.queuedAs.size()) != 0)
+            spi->overwrites++;
+        spi->wire.insert(spi->wire.end(), p.bytes, p.bytes + p.queuedAs.size());
+        spi->nowUs = p.doneUs > spi->nowUs ? p.doneUs : spi->nowUs;
+        spi->queued.pop_front();
+    }
+
+    PanelSpi port() { return {this, command, data, queue, waitOldest}; }
+};
+
+// GxEPD2_750_T7::writeImage / _writeImage(command, ...) for a byte-aligned window: partial
+// in, _setPartialRamArea, the RAM command, the rows, partial out. Copied from the GxEPD2
+// release pinned in platformio.ini
+static std::vector<uint16_t> gxepd2WriteImage(uint8_t ram, const uint8_t *image, uint16_t x, uint16_t y, uint16_t w,
+                                              uint16_t h)
+{
+    std::vector<uint16_t> out;
+    uint16_t xe = (x + w - 1) | 0x0007;
+    uint16_t ye = y + h - 1;
+    x &= 0xFFF8;
+    out.push_back(COMMAND | 0x91);
+    out.push_back(COMMAND | 0x90);
+    const uint16_t window[] = {(uint16_t)(x / 256), (uint16_t)(x % 256), (uint16_t)(xe / 256), (uint16_t)(xe % 256),
+                               (uint16_t)(y / 256), (uint16_t)(y % 256), (uint16_t)(ye / 256), (uint16_t)(ye % 256),
+                               0x01};
+    out.insert(out.end(), window, window + 9);
+    out.push_back(COMMAND | ram);
+    out.insert(out.end(), image, image + (size_t)(xe + 1 - x) / 8 * h);
+    out.push_back(COMMAND | 0x92);
+    return out;
+}
+
+static std::vector<uint8_t> randomImage(size_t bytes, uint32_t seed)
+{
+    std::vector<uint8_t> image(bytes);
+    for (uint8_t &b : image)
+    {
+        seed = seed * 1103515245 + 12345;
+        b = (uint8_t)(seed >> 16);
+    }
+    return image;
+}
+
+static uint8_t bufferA[BAND_BYTES], bufferB[BAND_BYTES];
+
+// The page loop DisplayManager runs: each band is drawn (copied) into the buffer band()
+// hands out, stamped over first so reuse of an in-flight buffer can't go unnoticed
+static void streamWindow(BandTransfer &transfer, MockSpi &spi, uint8_t ram, const uint8_t *image, uint16_t x,
+                         uint16_t y, uint16_t w, uint16_t h, double renderUs = 0)
+{
+    size_t stride = (size_t)((x + w - 1) / 8 - x / 8 + 1);
+    transfer.begin(spi.port(), ram, x, y, w, h);
+    for (int top = 0; top < h; top += BAND_ROWS)
+    {
+        int rows = h - top < BAND_ROWS ? h - top : BAND_ROWS;
+        uint8_t *band = transfer.band();
+        memset(band, 0xA5, transfer.capacity());
+        memcpy(band, image + top * stride, rows * stride);
+        spi.nowUs += renderUs;
+        transfer.send(rows * stride);
+    }
+    transfer.end();
+}
+
+void test_window_stream_matches_gxepd2()
+{
+    // Windows the firmware uses, a full panel, and one whose right edge is rounded up
+    struct Window
+    {
+        uint16_t x, y, w, h;
+    } windows[] = {{0, 80, 400, 144}, {0, 216, 400, 144}, {0, 400, 200, 80}, {400, 0, 400, 480},
+                   {512, 296, 96, 88}, {0, 0, 800, 480},  {16, 7, 45, 61},   {0, 0, 8, 1}};
+    for (const Window &win : windows)
+    {
+        const uint8_t rams[] = {PANEL_RAM_NEW, PANEL_RAM_OLD};
+        for (uint8_t ram : rams)
+        {
+            size_t stride = (size_t)((win.x + win.w - 1) / 8 - win.x / 8 + 1);
+            std::vector<uint8_t> image = randomImage(stride * win.h, win.x * 31 + win.y + ram);
+            BandTransfer transfer(bufferA, bufferB, BAND_BYTES);
+            MockSpi spi;
+            streamWindow(transfer, spi, ram, image.data(), win.x, win.y, win.w, win.h);
+
+            std::vector<uint16_t> expected = gxepd2WriteImage(ram, image.data(), win.x, win.y, win.w, win.h);
+            TEST_ASSERT_EQUAL(expected.size(), spi.wire.size());
+            TEST_ASSERT_EQUAL_MEMORY(expected.data(), spi.wire.data(), expected.size() * sizeof(uint16_t));
+            TEST_ASSERT_EQUAL(0, spi.overwrites);
+            TEST_ASSERT_EQUAL(0, spi.outOfOrder);
+            TEST_ASSERT_EQUAL(stride * win.h, transfer.bytesSent());
+        }
+    }
+}
+
+void test_ping_pong_never_touches_a_band_on_the_wire()
+{
+    std::vector<uint8_t> image = randomImage(PANEL_WIDTH / 8 * PANEL_HEIGHT, 5);
+    BandTransfer transfer(bufferA, bufferB, BAND_BYTES);
+    MockSpi spi;
+    streamWindow(transfer, spi, PANEL_RAM_NEW, image.data(), 0, 0, PANEL_WIDTH, PANEL_HEIGHT, 1000);
+
+    // Both buffers in flight at once, the first two bands handed out without waiting, and
+    // every later one only after its previous transfer finished
+    int bands = PANEL_HEIGHT / BAND_ROWS;
+    TEST_ASSERT_EQUAL(2, spi.maxInFlight);
+    TEST_ASSERT_EQUAL(bands - 2, (int)transfer.waits());
+    TEST_ASSERT_EQUAL(0, spi.overwrites);
+    TEST_ASSERT_EQUAL(0, spi.outOfOrder);
+
+    // The mock does catch a band rewritten in flight: one buffer handed out twice
+    BandTransfer single(bufferA, bufferA, BAND_BYTES);
+    MockSpi caught;
+    streamWindow(single, caught, PANEL_RAM_NEW, image.data(), 0, 0, PANEL_WIDTH, PANEL_HEIGHT);
+    TEST_ASSERT_TRUE(caught.overwrites > 0);
+
+    // Buffers alternate
+    MockSpi second;
+    transfer.begin(second.port(), PANEL_RAM_NEW, 0, 0, PANEL_WIDTH, PANEL_HEIGHT);
+    uint8_t *first = transfer.band();
+    transfer.send(BAND_BYTES);
+    TEST_ASSERT_TRUE(transfer.band() != first);
+    transfer.send(BAND_BYTES);
+    TEST_ASSERT_TRUE(transfer.band() == first);
+    transfer.send(0); // Empty band: nothing queued
+    transfer.end();
+    TEST_ASSERT_EQUAL(0, second.overwrites);
+    TEST_ASSERT_EQUAL(COMMAND | PANEL_CMD_PARTIAL_OUT, second.wire.back());
+}
+
+void test_frame_decoded_into_bands()
+{
+    // drawFrame's pass: each band decoded straight into the buffer band() hands out
+    FrameInfo info = {400, 0, 400, 480, FRAME_FLAG_PACKBITS, 0};
+    std::vector<uint8_t> image(info.width / 8 * info.height, 0xFF);
+    for (size_t i = 0; i < image.size(); i += 7)
+        image[i] = (uint8_t)(i * 13);
+    std::vector<uint8_t> frame(FrameCodec::maxEncodedSize(info.width, info.height));
+    frame.resize(FrameCodec::encode(image.data(), info, frame.data(), frame.size()));
+
+    FrameDecoder decoder;
+    TEST_ASSERT_TRUE(decoder.begin(frame.data(), frame.size()));
+    BandTransfer transfer(bufferA, bufferB, BAND_BYTES);
+    MockSpi spi;
+    size_t stride = decoder.rowBytes();
+    transfer.begin(spi.port(), PANEL_RAM_NEW, info.x, info.y, info.width, info.height);
+    int rows;
+    while ((rows = decoder.decodeRows(transfer.band(), (int)(transfer.capacity() / stride))) > 0)
+        transfer.send(rows * stride);
+    transfer.end();
+
+    TEST_ASSERT_EQUAL(0, rows);
+    std::vector<uint16_t> expected = gxepd2WriteImage(PANEL_RAM_NEW, image.data(), info.x, info.y, info.width, info.height);
+    TEST_ASSERT_EQUAL(expected.size(), spi.wire.size());
+    TEST_ASSERT_EQUAL_MEMORY(expected.data(), spi.wire.data(), expected.size() * sizeof(uint16_t));
+    TEST_ASSERT_EQUAL(0, spi.overwrites);
+}
+
+void test_overlap_and_clock_timing()
+{
+    // Simulated time to write the left half (the clock's full update): bands drawn for
+    // renderUs each, sent blocking (GxEPD2's path) or queued while the next band is drawn
+    std::vector<uint8_t> image = randomImage(400 / 8 * PANEL_HEIGHT, 9);
+    const double clocks[] = {4e6, 20e6};
+    const double renderUs[] = {0, 1000, 3000};
+    for (double hz : clocks)
+    {
+        for (double render : renderUs)
+        {
+            double us[2];
+            for (int queued = 0; queued < 2; queued++)
+            {
+                BandTransfer transfer(bufferA, bufferB, BAND_BYTES);
+                MockSpi spi;
+                spi.hz = hz;
+                spi.blocking = queued == 0;
+                streamWindow(transfer, spi, PANEL_RAM_NEW, image.data(), 0, 0, 400, PANEL_HEIGHT, render);
+                us[queued] = spi.nowUs;
+                TEST_ASSERT_EQUAL(0, spi.overwrites);
+            }
+
+            // Overlapped: the slower of drawing and sending per band, plus one of the other
+            int bands = PANEL_HEIGHT / BAND_ROWS;
+            double wireUs = 400 / 8 * BAND_ROWS * 8e6 / hz;
+            double slower = render > wireUs ? render : wireUs;
+            double fixedUs = 13 * 8e6 / hz; // Four commands and the window bytes
+            TEST_ASSERT_FLOAT_WITHIN(1.0, bands * (render + wireUs) + fixedUs, us[0]);
+            TEST_ASSERT_FLOAT_WITHIN(1.0, bands * slower + (render + wireUs - slower) + fixedUs, us[1]);
+            TEST_ASSERT_TRUE(render == 0 || us[1] < us[0]);
+
+            char msg[120];
+            snprintf(msg, sizeof(msg), "%2.0f MHz, %4.0f us per band drawn: blocking %6.0f us, ping-pong %6.0f us",
+                     hz / 1e6, render, us[0], us[1]);
+            TEST_MESSAGE(msg);
+        }
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_window_stream_matches_gxepd2);
+    RUN_TEST(test_ping_pong_never_touches_a_band_on_the_wire);
+    RUN_TEST(test_frame_decoded_into_bands);
+    RUN_TEST(test_overlap_and_clock_timing);
+    return UNITY_END();
+}
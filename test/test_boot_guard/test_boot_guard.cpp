@@ -0,0 +1,218 @@
+#include <unity.h>
+#include <cstring>
+#include "../../src/boot_guard.h"
+#include "../../src/boot_guard.cpp" // Include implementation directly for testing
+
+const int LIMIT = 3;
+const int PROBE = 4;
+
+static BootGuardState freshState()
+{
+    BootGuardState state;
+    memset(&state, 0xA5, sizeof(state)); // RTC_NOINIT memory after power-on
+    BootGuard::begin(state, BOOT_POWER_ON, LIMIT);
+    BootGuard::finished(state, PROBE);
+    return state;
+}
+
+// One wake that resets before reaching deep sleep
+static BootPlan crashWake(BootGuardState &state, BootCause cause = BOOT_CRASH)
+{
+    return BootGuard::begin(state, cause, LIMIT);
+}
+
+// The wake after a crash starts with that crash's cause; it then sleeps cleanly
+static BootPlan cleanWake(BootGuardState &state, BootCause cause = BOOT_DEEP_SLEEP)
+{
+    BootPlan plan = BootGuard::begin(state, cause, LIMIT);
+    BootGuard::finished(state, PROBE);
+    return plan;
+}
+
+static void enterDegraded(BootGuardState &state)
+{
+    crashWake(state, BOOT_DEEP_SLEEP); // Normal wake that crashes
+    for (int i = 0; i < LIMIT; i++)
+    {
+        crashWake(state); // Each crash reset starts a wake that crashes again
+    }
+}
+
+void test_garbage_state_starts_clean()
+{
+    BootGuardState state;
+    memset(&state, 0xA5, sizeof(state));
+    BootPlan plan = BootGuard::begin(state, BOOT_DEEP_SLEEP, LIMIT);
+    TEST_ASSERT_EQUAL(SUBSYSTEM_ALL, plan.enabled);
+    TEST_ASSERT_FALSE(plan.degraded);
+    TEST_ASSERT_EQUAL(0, state.failures);
+    TEST_ASSERT_EQUAL(BOOT_GUARD_MAGIC, state.magic);
+}
+
+void test_degrades_after_failure_limit()
+{
+    BootGuardState state = freshState();
+    crashWake(state, BOOT_DEEP_SLEEP);
+    TEST_ASSERT_FALSE(crashWake(state).degraded); // One failure
+    TEST_ASSERT_FALSE(crashWake(state, BOOT_BROWNOUT).degraded); // Two
+    BootPlan plan = crashWake(state); // Three
+    TEST_ASSERT_TRUE(plan.degraded);
+    TEST_ASSERT_EQUAL(0, plan.enabled);
+    TEST_ASSERT_FALSE(BootGuard::allowed(plan, SUBSYSTEM_RADIO));
+    TEST_ASSERT_FALSE(BootGuard::allowed(plan, SUBSYSTEM_WEATHER));
+    TEST_ASSERT_FALSE(BootGuard::allowed(plan, SUBSYSTEM_RESTORE));
+    TEST_ASSERT_EQUAL(3, state.failures);
+    TEST_ASSERT_EQUAL(BOOT_CRASH, state.lastCause);
+}
+
+void test_failures_must_be_in_a_row()
+{
+    BootGuardState state = freshState();
+    for (int i = 0; i < 10; i++)
+    {
+        crashWake(state, BOOT_DEEP_SLEEP);
+        crashWake(state); // Crashes twice in a row...
+        TEST_ASSERT_FALSE(cleanWake(state).degraded); // ...then recovers
+        TEST_ASSERT_EQUAL(0, state.failures);
+    }
+}
+
+void test_resets_that_are_not_failures()
+{
+    BootGuardState state = freshState();
+
+    // A crash outside a wake (inWake clear) is not counted: nothing of ours was running
+    BootGuard::begin(state, BOOT_CRASH, LIMIT);
+    TEST_ASSERT_EQUAL(0, state.failures);
+
+    // A restart (e.g. after an update) in the middle of a wake is neutral
+    crashWake(state, BOOT_RESTART);
+    crashWake(state, BOOT_RESTART);
+    TEST_ASSERT_EQUAL(0, state.failures);
+
+    // And the power button always starts over
+    enterDegraded(state);
+    BootPlan plan = cleanWake(state, BOOT_POWER_ON);
+    TEST_ASSERT_FALSE(plan.degraded);
+    TEST_ASSERT_EQUAL(0, state.failures);
+}
+
+void test_subsystems_come_back_one_at_a_time()
+{
+    BootGuardState state = freshState();
+    enterDegraded(state);
+    BootGuard::finished(state, PROBE); // The degraded wake itself is clean
+
+    const uint8_t order[] = {SUBSYSTEM_RADIO, SUBSYSTEM_WEATHER, SUBSYSTEM_RESTORE};
+    uint8_t expected = 0;
+    int wakes = 1;
+    for (uint8_t subsystem : order)
+    {
+        // Each one waits for PROBE clean wakes: clock only, then the previous one's probation
+        while (!(state.enabled & subsystem))
+        {
+            TEST_ASSERT_EQUAL(expected, state.enabled);
+            cleanWake(state);
+            wakes++;
+            TEST_ASSERT_TRUE(wakes < 100);
+        }
+        expected |= subsystem;
+        TEST_ASSERT_EQUAL(expected, state.enabled);
+        TEST_ASSERT_EQUAL(subsystem, state.probing);
+        TEST_ASSERT_EQUAL(0, wakes % PROBE);
+    }
+    TEST_ASSERT_EQUAL(3 * PROBE, wakes);
+
+    // Restore's probation passes and the guard is back to normal
+    while (state.probing != 0)
+    {
+        cleanWake(state);
+        wakes++;
+    }
+    TEST_ASSERT_EQUAL(4 * PROBE, wakes);
+    BootPlan plan = cleanWake(state);
+    TEST_ASSERT_FALSE(plan.degraded);
+    TEST_ASSERT_EQUAL(0, state.failures);
+}
+
+void test_failed_probe_turns_subsystem_off_again_with_backoff()
+{
+    BootGuardState state = freshState();
+    enterDegraded(state);
+    BootGuard::finished(state, PROBE);
+    for (int i = 1; i < PROBE; i++)
+    {
+        cleanWake(state);
+    }
+    TEST_ASSERT_EQUAL(SUBSYSTEM_RADIO, state.probing);
+
+    // Radio back; weather comes on probation and crashes
+    for (int i = 0; i < PROBE; i++)
+    {
+        cleanWake(state);
+    }
+    TEST_ASSERT_EQUAL(SUBSYSTEM_WEATHER, state.probing);
+    crashWake(state, BOOT_DEEP_SLEEP);
+    BootPlan plan = crashWake(state);
+    TEST_ASSERT_TRUE(BootGuard::allowed(plan, SUBSYSTEM_RADIO));
+    TEST_ASSERT_FALSE(BootGuard::allowed(plan, SUBSYSTEM_WEATHER));
+    TEST_ASSERT_EQUAL(0, state.probing);
+    TEST_ASSERT_EQUAL(1, state.probeBackoff);
+    BootGuard::finished(state, PROBE);
+
+    // It is retried after twice the wait
+    int wakes = 1;
+    while (!(state.enabled & SUBSYSTEM_WEATHER))
+    {
+        cleanWake(state);
+        wakes++;
+        TEST_ASSERT_TRUE(wakes < 100);
+    }
+    TEST_ASSERT_EQUAL(2 * PROBE, wakes);
+    TEST_ASSERT_EQUAL(SUBSYSTEM_WEATHER, state.probing);
+}
+
+void test_backoff_is_capped()
+{
+    BootGuardState state = freshState();
+    enterDegraded(state);
+    BootGuard::finished(state, PROBE);
+    for (int round = 0; round < 10; round++)
+    {
+        // Wait for the radio to come back on probation, then crash it
+        int wakes = 0;
+        while (state.probing != SUBSYSTEM_RADIO)
+        {
+            cleanWake(state);
+            TEST_ASSERT_TRUE(++wakes <= (PROBE << 3));
+        }
+        crashWake(state, BOOT_DEEP_SLEEP);
+        TEST_ASSERT_EQUAL(0, crashWake(state).enabled);
+        BootGuard::finished(state, PROBE);
+    }
+    TEST_ASSERT_EQUAL(3, state.probeBackoff);
+    TEST_ASSERT_TRUE(state.failures > LIMIT);
+}
+
+void test_weather_needs_the_radio()
+{
+    BootPlan plan = {SUBSYSTEM_WEATHER | SUBSYSTEM_RESTORE, true};
+    TEST_ASSERT_FALSE(BootGuard::allowed(plan, SUBSYSTEM_WEATHER));
+    TEST_ASSERT_TRUE(BootGuard::allowed(plan, SUBSYSTEM_RESTORE));
+    plan.enabled = SUBSYSTEM_ALL;
+    TEST_ASSERT_TRUE(BootGuard::allowed(plan, SUBSYSTEM_WEATHER));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_garbage_state_starts_clean);
+    RUN_TEST(test_degrades_after_failure_limit);
+    RUN_TEST(test_failures_must_be_in_a_row);
+    RUN_TEST(test_resets_that_are_not_failures);
+    RUN_TEST(test_subsystems_come_back_one_at_a_time);
+    RUN_TEST(test_failed_probe_turns_subsystem_off_again_with_backoff);
+    RUN_TEST(test_backoff_is_capped);
+    RUN_TEST(test_weather_needs_the_radio);
+    return UNITY_END();
+}
@@ -0,0 +1,307 @@
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "../../src/fetch_cache.h"
+#include "../../src/fetch_cache.cpp" // Include implementation directly for testing
+
+// Trimmed Open-Meteo style fixture. %s = generationtime_ms, current.time; %d = model run
+const char *FIXTURE_FORMAT =
+    "{\"latitude\":45.52,\"longitude\":-122.68,\"generationtime_ms\":%s,\"utc_offset_seconds\":0,"
+    "\"current\":{\"time\":\"%s\",\"interval\":900,\"temperature_2m\":%d.4,\"relative_humidity_2m\":81,\"weather_code\":3},"
+    "\"hourly\":{\"time\":[\"2026-01-02T00:00\",\"2026-01-02T01:00\",\"2026-01-02T02:00\"],"
+    "\"temperature_2m\":[41.2,40.8,%d.1],\"weather_code\":[3,3,61]},"
+    "\"daily\":{\"time\":[\"2026-01-02\",\"2026-01-03\"],\"temperature_2m_max\":[47.3,49.0],"
+    "\"temperature_2m_min\":[38.1,39.9],\"weather_code\":[61,3]}}";
+
+// Local HTTP stand-in for the weather API. Speaks raw HTTP/1.1 text so the conditional
+// request headers go through a real parse, and serves the fixture for the current model run.
+struct StandInServer
+{
+    int modelRun;        // Bump to publish a new forecast
+    bool sendValidators; // false = behave like a server without ETag/Last-Modified
+    int requests;
+    int bodiesSent;
+    int generation;      // Varies generationtime_ms per response like the real API
+
+    std::string handle(const std::string &request, int minute)
+    {
+        requests++;
+        generation++;
+
+        char etag[32];
+        snprintf(etag, sizeof(etag), "\"run-%d\"", modelRun);
+        char lastModified[40];
+        snprintf(lastModified, sizeof(lastModified), "Fri, 02 Jan 2026 %02d:00:00 GMT", modelRun % 24);
+
+        if (sendValidators)
+        {
+            if (header(request, "If-None-Match") == etag || header(request, "If-Modified-Since") == lastModified)
+            {
+                return "HTTP/1.1 304 Not Modified\r\n\r\n";
+            }
+        }
+
+        char generationStr[16];
+        snprintf(generationStr, sizeof(generationStr), "0.%04d", (generation * 37) % 10000);
+        char currentTime[24];
+        snprintf(currentTime, sizeof(currentTime), "2026-01-02T%02d:%02d", (minute / 60) % 24, (minute % 60) / 15 * 15);
+        char body[1024];
+        snprintf(body, sizeof(body), FIXTURE_FORMAT, generationStr, currentTime, 40 + modelRun, 39 + modelRun);
+
+        bodiesSent++;
+        std::string response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n";
+        if (sendValidators)
+        {
+            response += std::string("ETag: ") + etag + "\r\nLast-Modified: " + lastModified + "\r\n";
+        }
+        return response + "\r\n" + body;
+    }
+
+    static std::string header(const std::string &message, const char *name)
+    {
+        std::string key = std::string("\r\n") + name + ": ";
+        size_t start = message.find(key);
+        if (start == std::string::npos)
+            return "";
+        start += key.size();
+        return message.substr(start, message.find("\r\n", start) - start);
+    }
+};
+
+// Client side of one fetch, following NetworkManager::fetchWeather
+struct ClientStats
+{
+    int notModified;
+    int parsed;
+};
+
+static FetchResult fetch(StandInServer &server, FetchCacheState &cache, int displayHour, int minute, ClientStats &stats)
+{
+    std::string request = "GET /v1/forecast HTTP/1.1\r\nHost: stand-in\r\n";
+    if (FetchCache::canRevalidate(cache, displayHour))
+    {
+        if (cache.etag[0] != '\0')
+            request += std::string("If-None-Match: ") + cache.etag + "\r\n";
+        if (cache.lastModified[0] != '\0')
+            request += std::string("If-Modified-Since: ") + cache.lastModified + "\r\n";
+    }
+    request += "\r\n";
+
+    std::string response = server.handle(request, minute);
+    int status = atoi(response.c_str() + 9);
+    if (status == 304)
+    {
+        FetchCache::recordNotModified(cache);
+        stats.notModified++;
+        return FETCH_NOT_MODIFIED;
+    }
+
+    std::string etag = StandInServer::header(response, "ETag");
+    std::string lastModified = StandInServer::header(response, "Last-Modified");
+    std::string body = response.substr(response.find("\r\n\r\n") + 4);
+
+    uint32_t hash = FetchCache::contentHash(body.c_str(), body.size());
+    if (!FetchCache::needsParse(cache, hash, displayHour))
+    {
+        FetchCache::recordBody(cache, hash, displayHour, etag.c_str(), lastModified.c_str());
+        stats.notModified++;
+        return FETCH_NOT_MODIFIED;
+    }
+
+    stats.parsed++;
+    FetchCache::recordBody(cache, hash, displayHour, etag.c_str(), lastModified.c_str());
+    return FETCH_UPDATED;
+}
+
+static FetchCacheState freshCache()
+{
+    FetchCacheState cache;
+    FetchCache::reset(cache);
+    return cache;
+}
+
+void test_hash_ignores_volatile_fields()
+{
+    const char *a = "{\"generationtime_ms\":0.0123,\"current\":{\"time\":\"2026-01-02T14:00\",\"temperature_2m\":41.4}}";
+    const char *b = "{\"generationtime_ms\":0.9876,\"current\":{\"time\":\"2026-01-02T14:15\",\"temperature_2m\":41.4}}";
+    TEST_ASSERT_EQUAL(FetchCache::contentHash(a, strlen(a)), FetchCache::contentHash(b, strlen(b)));
+}
+
+void test_hash_sees_forecast_changes()
+{
+    const char *a = "{\"generationtime_ms\":0.0123,\"current\":{\"time\":\"2026-01-02T14:00\",\"temperature_2m\":41.4}}";
+    const char *b = "{\"generationtime_ms\":0.0123,\"current\":{\"time\":\"2026-01-02T14:00\",\"temperature_2m\":42.4}}";
+    TEST_ASSERT_NOT_EQUAL(FetchCache::contentHash(a, strlen(a)), FetchCache::contentHash(b, strlen(b)));
+}
+
+void test_hash_keeps_time_arrays()
+{
+    // hourly.time moves at midnight - that is a real change
+    const char *a = "{\"hourly\":{\"time\":[\"2026-01-02T00:00\"],\"temperature_2m\":[41.2]}}";
+    const char *b = "{\"hourly\":{\"time\":[\"2026-01-03T00:00\"],\"temperature_2m\":[41.2]}}";
+    TEST_ASSERT_NOT_EQUAL(FetchCache::contentHash(a, strlen(a)), FetchCache::contentHash(b, strlen(b)));
+}
+
+void test_no_validators_before_first_fetch()
+{
+    FetchCacheState cache = freshCache();
+    TEST_ASSERT_FALSE(FetchCache::canRevalidate(cache, 14));
+}
+
+void test_unchanged_fixture_gets_304()
+{
+    StandInServer server = {1, true, 0, 0, 0};
+    FetchCacheState cache = freshCache();
+    ClientStats stats = {};
+
+    TEST_ASSERT_EQUAL(FETCH_UPDATED, fetch(server, cache, 14, 14 * 60, stats));
+    TEST_ASSERT_EQUAL(FETCH_NOT_MODIFIED, fetch(server, cache, 14, 14 * 60 + 30, stats));
+    TEST_ASSERT_EQUAL(1, server.bodiesSent);
+    TEST_ASSERT_EQUAL(1, cache.unchangedStreak);
+}
+
+void test_changed_fixture_is_parsed()
+{
+    StandInServer server = {1, true, 0, 0, 0};
+    FetchCacheState cache = freshCache();
+    ClientStats stats = {};
+
+    fetch(server, cache, 14, 14 * 60, stats);
+    server.modelRun = 2;
+    TEST_ASSERT_EQUAL(FETCH_UPDATED, fetch(server, cache, 14, 14 * 60 + 30, stats));
+    TEST_ASSERT_EQUAL(2, stats.parsed);
+    TEST_ASSERT_EQUAL(0, cache.unchangedStreak);
+}
+
+void test_server_without_validators_uses_hash()
+{
+    StandInServer server = {1, false, 0, 0, 0};
+    FetchCacheState cache = freshCache();
+    ClientStats stats = {};
+
+    fetch(server, cache, 14, 14 * 60, stats);
+    // Body differs in generationtime_ms and current.time, forecast doesn't
+    TEST_ASSERT_EQUAL(FETCH_NOT_MODIFIED, fetch(server, cache, 14, 14 * 60 + 30, stats));
+    TEST_ASSERT_EQUAL(2, server.bodiesSent);
+    TEST_ASSERT_EQUAL(1, stats.parsed);
+}
+
+void test_new_hour_always_parses()
+{
+    // Same forecast, but the hourly columns shift - a 304 would leave nothing to render from
+    StandInServer server = {1, true, 0, 0, 0};
+    FetchCacheState cache = freshCache();
+    ClientStats stats = {};
+
+    fetch(server, cache, 14, 14 * 60 + 30, stats);
+    TEST_ASSERT_FALSE(FetchCache::canRevalidate(cache, 15));
+    TEST_ASSERT_EQUAL(FETCH_UPDATED, fetch(server, cache, 15, 15 * 60, stats));
+    // Forecast itself didn't change, so it still counts toward the streak
+    TEST_ASSERT_EQUAL(1, cache.unchangedStreak);
+}
+
+void test_oversized_validator_not_stored()
+{
+    FetchCacheState cache = freshCache();
+    char longEtag[100];
+    memset(longEtag, 'x', sizeof(longEtag) - 1);
+    longEtag[sizeof(longEtag) - 1] = '\0';
+    FetchCache::recordBody(cache, 1234, 14, longEtag, "");
+    TEST_ASSERT_EQUAL('\0', cache.etag[0]);
+    TEST_ASSERT_FALSE(FetchCache::canRevalidate(cache, 14));
+}
+
+void test_adaptive_interval()
+{
+    FetchCacheState cache = freshCache();
+    TEST_ASSERT_EQUAL(1800, FetchCache::adaptiveInterval(cache, 1800, 3600));
+    cache.unchangedStreak = WEATHER_UNCHANGED_STRETCH;
+    TEST_ASSERT_EQUAL(3600, FetchCache::adaptiveInterval(cache, 1800, 3600));
+    // Power policy already slower than the cap - leave it alone
+    TEST_ASSERT_EQUAL(7200, FetchCache::adaptiveInterval(cache, 7200, 3600));
+}
+
+// Simulated day against the stand-in: the model publishes a new run every 3 hours, at :20.
+// Fetches follow the adaptive schedule the way loop() does.
+static void simulateDay(bool sendValidators, int &fetches, int &parsed, int &bodies, int &maxStaleMinutes)
+{
+    const int MODEL_RUN_MINUTES = 3 * 60;
+    const int PUBLISH_OFFSET = 20;
+    StandInServer server = {0, sendValidators, 0, 0, 0};
+    FetchCacheState cache = freshCache();
+    ClientStats stats = {};
+
+    int minute = 0;
+    int shownRun = -1;
+    maxStaleMinutes = 0;
+    while (minute < 24 * 60)
+    {
+        server.modelRun = (minute + MODEL_RUN_MINUTES - PUBLISH_OFFSET) / MODEL_RUN_MINUTES;
+        fetch(server, cache, minute / 60, minute, stats);
+
+        int stale = minute - ((server.modelRun - 1) * MODEL_RUN_MINUTES + PUBLISH_OFFSET);
+        if (shownRun >= 0 && server.modelRun != shownRun && stale > maxStaleMinutes)
+            maxStaleMinutes = stale;
+        shownRun = server.modelRun;
+
+        minute += FetchCache::adaptiveInterval(cache, 1800, 3600) / 60;
+    }
+
+    fetches = server.requests;
+    parsed = stats.parsed;
+    bodies = server.bodiesSent;
+}
+
+void test_simulated_day_adapts_schedule()
+{
+    int fetches, parsed, bodies, maxStale;
+    simulateDay(true, fetches, parsed, bodies, maxStale);
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "Day with validators: %d fetches (vs 48), %d bodies, %d parsed, new run shown within %d min",
+             fetches, bodies, parsed, maxStale);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_TRUE(fetches < 48);
+    TEST_ASSERT_TRUE(parsed < fetches);
+    TEST_ASSERT_TRUE(bodies <= fetches);
+    TEST_ASSERT_TRUE(maxStale <= 60);
+}
+
+void test_simulated_day_without_validators()
+{
+    int fetches, parsed, bodies, maxStale;
+    simulateDay(false, fetches, parsed, bodies, maxStale);
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "Day without validators: %d fetches (vs 48), %d parsed, new run shown within %d min",
+             fetches, parsed, maxStale);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_TRUE(fetches < 48);
+    TEST_ASSERT_EQUAL(fetches, bodies);
+    TEST_ASSERT_TRUE(maxStale <= 60);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_hash_ignores_volatile_fields);
+    RUN_TEST(test_hash_sees_forecast_changes);
+    RUN_TEST(test_hash_keeps_time_arrays);
+    RUN_TEST(test_no_validators_before_first_fetch);
+    RUN_TEST(test_unchanged_fixture_gets_304);
+    RUN_TEST(test_changed_fixture_is_parsed);
+    RUN_TEST(test_server_without_validators_uses_hash);
+    RUN_TEST(test_new_hour_always_parses);
+    RUN_TEST(test_oversized_validator_not_stored);
+    RUN_TEST(test_adaptive_interval);
+
+    // Stand-in server scenarios
+    RUN_TEST(test_simulated_day_adapts_schedule);
+    RUN_TEST(test_simulated_day_without_validators);
+
+    return UNITY_END();
+}
@@ -0,0 +1,186 @@
+#include <unity.h>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include "../../src/wake_logic.h"
+#include "../../src/wake_logic.cpp" // Include implementation directly for testing
+
+const time_t DAY_START = 1767254400; // Jan 1, 2026 08:00:00 UTC
+const int INTERVAL = 30 * 60;
+const int LEAD = 40;
+const int SPREAD = 5;
+const int JITTER = 5;
+
+// Radio model for one prefetch, milliseconds. Association slows down with every other panel
+// already on the air, and past AP_CAPACITY the first attempt fails and is retried.
+const int ASSOCIATE_MS = 2000;
+const int ASSOCIATE_PER_PEER_MS = 350;
+const int AP_CAPACITY = 8;
+const int RETRY_MS = 3000;
+const int FETCH_MS = 1200;
+const int FETCH_PER_PEER_MS = 60; // Upstream API answering a burst
+
+static uint32_t rng = 12345;
+
+static uint32_t nextRandom()
+{
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+static uint32_t seedFor(int device)
+{
+    uint8_t mac[6] = {0x24, 0x0A, 0xC4, 0x00, (uint8_t)(device >> 8), (uint8_t)device};
+    return WakeLogic::staggerSeed(mac);
+}
+
+struct FleetResult
+{
+    int peakConcurrent; // Panels with the radio on at once, worst moment of the day
+    int meanRadioMs;
+    int lateFetches;    // Finished after the boundary
+    int onClockWake;    // Started in the first STAGGER_CLOCK_GUARD seconds of a minute
+};
+
+// A day of weather boundaries for a fleet of panels on the same schedule
+static FleetResult simulateFleet(int devices, int spreadMinutes)
+{
+    FleetResult result = {};
+    std::vector<int> skewMs(devices);
+    for (int d = 0; d < devices; d++)
+    {
+        skewMs[d] = (int)(nextRandom() % 4001) - 2000; // RTC drift since the last time sync
+    }
+
+    long long radioTotal = 0;
+    int fetches = 0;
+    for (int window = 1; window <= 48; window++)
+    {
+        time_t last = DAY_START + (window - 1) * INTERVAL;
+        time_t boundary = last + INTERVAL;
+
+        std::vector<long long> starts(devices);
+        for (int d = 0; d < devices; d++)
+        {
+            int stagger = WakeLogic::staggerSeconds(seedFor(d), boundary, spreadMinutes, JITTER, LEAD);
+            time_t at = WakeLogic::prefetchTime(last, INTERVAL, LEAD, stagger);
+            if (at % 60 < STAGGER_CLOCK_GUARD)
+                result.onClockWake++;
+            starts[d] = (long long)at * 1000 + skewMs[d];
+        }
+        std::sort(starts.begin(), starts.end());
+
+        std::vector<long long> ends;
+        for (long long start : starts)
+        {
+            int peers = 0;
+            for (long long end : ends)
+            {
+                if (end > start)
+                    peers++;
+            }
+            int radioMs = ASSOCIATE_MS + peers * ASSOCIATE_PER_PEER_MS + (peers >= AP_CAPACITY ? RETRY_MS : 0) +
+                          FETCH_MS + peers * FETCH_PER_PEER_MS;
+            ends.push_back(start + radioMs);
+            result.peakConcurrent = std::max(result.peakConcurrent, peers + 1);
+            if (start + radioMs > (long long)boundary * 1000)
+                result.lateFetches++;
+            radioTotal += radioMs;
+            fetches++;
+        }
+    }
+    result.meanRadioMs = (int)(radioTotal / fetches);
+    return result;
+}
+
+void test_no_spread_keeps_the_usual_lead()
+{
+    TEST_ASSERT_EQUAL(0, WakeLogic::staggerSeconds(seedFor(7), DAY_START + INTERVAL, 0, JITTER, LEAD));
+    TEST_ASSERT_EQUAL(DAY_START + INTERVAL - LEAD,
+                      WakeLogic::prefetchTime(DAY_START, INTERVAL, LEAD,
+                                              WakeLogic::staggerSeconds(seedFor(7), DAY_START, 0, JITTER, LEAD)));
+}
+
+void test_slots_stay_clear_of_clock_wake_and_boundary()
+{
+    for (int d = 0; d < 500; d++)
+    {
+        for (int window = 1; window <= 48; window++)
+        {
+            time_t boundary = DAY_START + window * INTERVAL;
+            int stagger = WakeLogic::staggerSeconds(seedFor(d), boundary, SPREAD, JITTER, LEAD);
+            TEST_ASSERT_TRUE(stagger >= 0 && stagger <= SPREAD * 60 - LEAD - STAGGER_CLOCK_GUARD);
+
+            // Shown at the same boundary, fetched between :25:10 and :29:20
+            time_t at = WakeLogic::prefetchTime(boundary - INTERVAL, INTERVAL, LEAD, stagger);
+            TEST_ASSERT_EQUAL(boundary, WakeLogic::weatherBoundary(at + LEAD + SPREAD * 60));
+            TEST_ASSERT_TRUE(at % 60 >= STAGGER_CLOCK_GUARD && at % 60 <= 60 - LEAD);
+        }
+    }
+}
+
+void test_slot_is_deterministic_with_bounded_jitter()
+{
+    uint32_t seed = seedFor(42);
+    int base = WakeLogic::staggerSeconds(seed, DAY_START, SPREAD, 0, LEAD);
+    TEST_ASSERT_EQUAL(base, WakeLogic::staggerSeconds(seed, DAY_START + 7 * INTERVAL, SPREAD, 0, LEAD));
+
+    int seen[SPREAD * 60] = {};
+    int distinct = 0;
+    for (int window = 0; window < 48; window++)
+    {
+        time_t boundary = DAY_START + window * INTERVAL;
+        int stagger = WakeLogic::staggerSeconds(seed, boundary, SPREAD, JITTER, LEAD);
+        TEST_ASSERT_EQUAL(stagger, WakeLogic::staggerSeconds(seed, boundary, SPREAD, JITTER, LEAD));
+        if (seen[stagger]++ == 0)
+            distinct++;
+    }
+    TEST_ASSERT_TRUE(distinct > 1);
+    TEST_ASSERT_TRUE(distinct <= 2 * JITTER + 1);
+}
+
+void test_consecutive_macs_spread_out()
+{
+    int used[SPREAD * 60] = {};
+    int distinct = 0;
+    for (int d = 0; d < 32; d++)
+    {
+        if (used[WakeLogic::staggerSeconds(seedFor(d), DAY_START, SPREAD, 0, LEAD)]++ == 0)
+            distinct++;
+    }
+    // 32 panels over 55 slots: a good hash leaves roughly 24 distinct
+    TEST_ASSERT_TRUE(distinct >= 20);
+}
+
+void test_fleet_simulation()
+{
+    const int fleets[] = {10, 50, 200};
+    for (int devices : fleets)
+    {
+        FleetResult together = simulateFleet(devices, 0);
+        FleetResult staggered = simulateFleet(devices, SPREAD);
+
+        char msg[160];
+        snprintf(msg, sizeof(msg),
+                 "%3d panels: peak %3d -> %2d on the air at once, mean radio-on %5d -> %4d ms, late %d -> %d",
+                 devices, together.peakConcurrent, staggered.peakConcurrent, together.meanRadioMs,
+                 staggered.meanRadioMs, together.lateFetches, staggered.lateFetches);
+        TEST_MESSAGE(msg);
+
+        TEST_ASSERT_EQUAL(0, staggered.onClockWake);
+        TEST_ASSERT_EQUAL(0, staggered.lateFetches);
+        TEST_ASSERT_TRUE(staggered.peakConcurrent < together.peakConcurrent);
+        TEST_ASSERT_TRUE(staggered.meanRadioMs < together.meanRadioMs);
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_no_spread_keeps_the_usual_lead);
+    RUN_TEST(test_slots_stay_clear_of_clock_wake_and_boundary);
+    RUN_TEST(test_slot_is_deterministic_with_bounded_jitter);
+    RUN_TEST(test_consecutive_macs_spread_out);
+    RUN_TEST(test_fleet_simulation);
+    return UNITY_END();
+}
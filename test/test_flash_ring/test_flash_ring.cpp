@@ -0,0 +1,299 @@
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "../../src/flash_ring.h"
+#include "../../src/flash_ring.cpp" // Include implementation directly for testing
+
+const uint8_t FORECAST = 0;
+const uint8_t PANE = 1;
+const uint32_t PARTITION_SIZE = 0x20000; // As in partitions.csv
+
+// NOR flash in RAM: erase sets whole sectors to 0xFF, writes can only clear bits
+struct MockFlash
+{
+    std::vector<uint8_t> bytes = std::vector<uint8_t>(PARTITION_SIZE, 0xFF);
+    std::vector<int> erases = std::vector<int>(PARTITION_SIZE / FLASH_RING_SECTOR_SIZE, 0);
+    int writesLeft = -1; // Writes before a simulated reset (-1 = no limit)
+    bool wroteUnerased = false;
+    bool erasedPartSector = false;
+
+    static bool read(void *context, uint32_t offset, void *out, size_t length)
+    {
+        MockFlash *flash = (MockFlash *)context;
+        memcpy(out, flash->bytes.data() + offset, length);
+        return true;
+    }
+
+    static bool write(void *context, uint32_t offset, const void *data, size_t length)
+    {
+        MockFlash *flash = (MockFlash *)context;
+        if (flash->writesLeft == 0)
+        {
+            return false;
+        }
+        if (flash->writesLeft > 0)
+        {
+            flash->writesLeft--;
+        }
+        const uint8_t *in = (const uint8_t *)data;
+        for (size_t i = 0; i < length; i++)
+        {
+            flash->wroteUnerased |= flash->bytes[offset + i] != 0xFF;
+            flash->bytes[offset + i] &= in[i];
+        }
+        return true;
+    }
+
+    static bool erase(void *context, uint32_t offset, size_t length)
+    {
+        MockFlash *flash = (MockFlash *)context;
+        if (offset % FLASH_RING_SECTOR_SIZE != 0 || length % FLASH_RING_SECTOR_SIZE != 0)
+        {
+            flash->erasedPartSector = true;
+            return false;
+        }
+        memset(flash->bytes.data() + offset, 0xFF, length);
+        for (size_t s = 0; s < length / FLASH_RING_SECTOR_SIZE; s++)
+        {
+            flash->erases[offset / FLASH_RING_SECTOR_SIZE + s]++;
+        }
+        return true;
+    }
+
+    FlashPort port() { return {this, PARTITION_SIZE, read, write, erase}; }
+};
+
+static std::vector<uint8_t> payload(size_t length, uint32_t seed)
+{
+    std::vector<uint8_t> bytes(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        bytes[i] = (uint8_t)(seed >> 16);
+    }
+    return bytes;
+}
+
+static void assertRecord(FlashRing &ring, uint8_t type, const std::vector<uint8_t> &expected)
+{
+    static uint8_t out[PARTITION_SIZE];
+    size_t length = 0;
+    TEST_ASSERT_TRUE(ring.read(type, out, sizeof(out), length));
+    TEST_ASSERT_EQUAL(expected.size(), length);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data(), out, length);
+}
+
+void test_empty_partition()
+{
+    MockFlash flash;
+    FlashRing ring;
+    TEST_ASSERT_TRUE(ring.mount(flash.port()));
+    TEST_ASSERT_EQUAL(32, ring.sectorCount());
+
+    size_t length;
+    uint8_t out[16];
+    TEST_ASSERT_FALSE(ring.find(FORECAST, length));
+    TEST_ASSERT_FALSE(ring.read(PANE, out, sizeof(out), length));
+    TEST_ASSERT_EQUAL(0, ring.recordsWritten());
+}
+
+void test_write_read_and_remount()
+{
+    MockFlash flash;
+    FlashRing ring;
+    ring.mount(flash.port());
+
+    std::vector<uint8_t> forecast = payload(120, 1);
+    std::vector<uint8_t> pane = payload(9000, 2); // Three sectors with its header
+    TEST_ASSERT_EQUAL(RING_WRITTEN, ring.write(FORECAST, forecast.data(), forecast.size()));
+    TEST_ASSERT_EQUAL(RING_WRITTEN, ring.write(PANE, pane.data(), pane.size()));
+    TEST_ASSERT_EQUAL(4, ring.sectorsErased());
+    assertRecord(ring, FORECAST, forecast);
+    assertRecord(ring, PANE, pane);
+
+    // A fresh boot finds both
+    FlashRing after;
+    TEST_ASSERT_TRUE(after.mount(flash.port()));
+    assertRecord(after, FORECAST, forecast);
+    assertRecord(after, PANE, pane);
+    TEST_ASSERT_EQUAL(2, after.recordsWritten());
+    TEST_ASSERT_FALSE(flash.wroteUnerased);
+    TEST_ASSERT_FALSE(flash.erasedPartSector);
+
+    // Too big for the output buffer
+    uint8_t small[100];
+    size_t length;
+    TEST_ASSERT_FALSE(after.read(FORECAST, small, sizeof(small), length));
+}
+
+void test_unchanged_records_are_not_written()
+{
+    MockFlash flash;
+    FlashRing ring;
+    ring.mount(flash.port());
+    std::vector<uint8_t> forecast = payload(120, 1);
+    ring.write(FORECAST, forecast.data(), forecast.size());
+
+    FlashRing after;
+    after.mount(flash.port());
+    TEST_ASSERT_EQUAL(RING_UNCHANGED, after.write(FORECAST, forecast.data(), forecast.size()));
+    TEST_ASSERT_EQUAL(0, after.sectorsErased());
+    TEST_ASSERT_EQUAL(0, after.bytesWritten());
+
+    forecast[60] ^= 1;
+    TEST_ASSERT_EQUAL(RING_WRITTEN, after.write(FORECAST, forecast.data(), forecast.size()));
+    TEST_ASSERT_EQUAL(1, after.sectorsErased());
+}
+
+void test_newest_record_wins_after_remount()
+{
+    MockFlash flash;
+    FlashRing ring;
+    ring.mount(flash.port());
+    std::vector<uint8_t> last;
+    for (uint32_t i = 0; i < 100; i++) // Wraps the partition three times
+    {
+        last = payload(120 + i, i);
+        ring.write(FORECAST, last.data(), last.size());
+    }
+
+    FlashRing after;
+    after.mount(flash.port());
+    assertRecord(after, FORECAST, last);
+    TEST_ASSERT_EQUAL(100, after.recordsWritten());
+
+    // The head carries on where it was, not from sector 0
+    std::vector<uint8_t> next = payload(50, 999);
+    after.write(FORECAST, next.data(), next.size());
+    TEST_ASSERT_EQUAL(4, flash.erases[0]); // Sectors 0..3 were used four times, the rest three
+    TEST_ASSERT_EQUAL(4, flash.erases[4]);
+    TEST_ASSERT_EQUAL(3, flash.erases[5]);
+}
+
+void test_interrupted_write_keeps_previous_record()
+{
+    MockFlash flash;
+    FlashRing ring;
+    ring.mount(flash.port());
+    std::vector<uint8_t> good = payload(120, 1);
+    ring.write(FORECAST, good.data(), good.size());
+
+    // Reset after the payload, before the header
+    std::vector<uint8_t> torn = payload(120, 2);
+    flash.writesLeft = 1;
+    TEST_ASSERT_EQUAL(RING_FAILED, ring.write(FORECAST, torn.data(), torn.size()));
+    flash.writesLeft = -1;
+
+    FlashRing after;
+    after.mount(flash.port());
+    assertRecord(after, FORECAST, good);
+
+    // And the torn sector is simply reused
+    TEST_ASSERT_EQUAL(RING_WRITTEN, after.write(FORECAST, torn.data(), torn.size()));
+    FlashRing again;
+    again.mount(flash.port());
+    assertRecord(again, FORECAST, torn);
+}
+
+void test_live_records_are_never_erased()
+{
+    MockFlash flash;
+    FlashRing ring;
+    ring.mount(flash.port());
+
+    // A big pane that never changes, forecasts streaming past it
+    std::vector<uint8_t> pane = payload(16384, 7);
+    ring.write(PANE, pane.data(), pane.size());
+    std::vector<uint8_t> forecast;
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        forecast = payload(120, 100 + i);
+        TEST_ASSERT_EQUAL(RING_WRITTEN, ring.write(FORECAST, forecast.data(), forecast.size()));
+        assertRecord(ring, PANE, pane);
+    }
+    for (int s = 0; s < 5; s++) // The pane's five sectors
+    {
+        TEST_ASSERT_EQUAL(1, flash.erases[s]);
+    }
+
+    FlashRing after;
+    after.mount(flash.port());
+    assertRecord(after, PANE, pane);
+    assertRecord(after, FORECAST, forecast);
+    TEST_ASSERT_FALSE(flash.wroteUnerased);
+}
+
+void test_full_ring()
+{
+    MockFlash flash;
+    FlashRing ring;
+    ring.mount(flash.port());
+    std::vector<uint8_t> pane = payload(70000, 3); // 18 sectors: a second copy can't fit beside it
+    TEST_ASSERT_EQUAL(RING_WRITTEN, ring.write(PANE, pane.data(), pane.size()));
+    std::vector<uint8_t> next = payload(70000, 4);
+    TEST_ASSERT_EQUAL(RING_FULL, ring.write(PANE, next.data(), next.size()));
+    assertRecord(ring, PANE, pane);
+
+    std::vector<uint8_t> huge = payload(PARTITION_SIZE, 5);
+    TEST_ASSERT_EQUAL(RING_FULL, ring.write(FORECAST, huge.data(), huge.size()));
+    TEST_ASSERT_EQUAL(RING_FAILED, ring.write(FLASH_RING_MAX_TYPES, pane.data(), 10));
+}
+
+void test_simulated_year_of_writes()
+{
+    // A changed forecast every 30 minutes and a new 12 KB pane every 6 hours, with a reset
+    // (remount) every week
+    MockFlash flash;
+    FlashRing ring;
+    ring.mount(flash.port());
+    uint32_t sectorsErased = 0, bytesWritten = 0;
+    for (int halfHour = 0; halfHour < 365 * 48; halfHour++)
+    {
+        if (halfHour % (7 * 48) == 0)
+        {
+            sectorsErased += ring.sectorsErased();
+            bytesWritten += ring.bytesWritten();
+            ring.mount(flash.port());
+        }
+        std::vector<uint8_t> forecast = payload(120, halfHour);
+        TEST_ASSERT_EQUAL(RING_WRITTEN, ring.write(FORECAST, forecast.data(), forecast.size()));
+        if (halfHour % 12 == 0)
+        {
+            std::vector<uint8_t> pane = payload(12000, halfHour);
+            TEST_ASSERT_EQUAL(RING_WRITTEN, ring.write(PANE, pane.data(), pane.size()));
+        }
+    }
+    sectorsErased += ring.sectorsErased();
+    bytesWritten += ring.bytesWritten();
+
+    int most = 0, least = 1 << 30;
+    for (int e : flash.erases)
+    {
+        most = e > most ? e : most;
+        least = e < least ? e : least;
+    }
+    // Wear is spread: no sector gets more than twice its share
+    TEST_ASSERT_TRUE(least > 0);
+    TEST_ASSERT_TRUE(most * (int)flash.erases.size() <= 2 * (int)sectorsErased);
+    TEST_ASSERT_TRUE(most < 100000 / 10); // Ten years of this within the flash's rated cycles
+
+    char message[160];
+    snprintf(message, sizeof(message), "Year: %u records, %u KB written, %u sector erases, %d..%d per sector",
+             (unsigned)ring.recordsWritten(), (unsigned)(bytesWritten / 1024), (unsigned)sectorsErased, least, most);
+    TEST_MESSAGE(message);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_partition);
+    RUN_TEST(test_write_read_and_remount);
+    RUN_TEST(test_unchanged_records_are_not_written);
+    RUN_TEST(test_newest_record_wins_after_remount);
+    RUN_TEST(test_interrupted_write_keeps_previous_record);
+    RUN_TEST(test_live_records_are_never_erased);
+    RUN_TEST(test_full_ring);
+    RUN_TEST(test_simulated_year_of_writes);
+    return UNITY_END();
+}
@@ -0,0 +1,305 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "../../src/forecast_stream.h"
+#include "../../src/forecast_stream.cpp" // Include implementation directly for testing
+#include "../../src/weather_diff.h"
+#include "../../src/weather_diff.cpp"
+#include "../../src/text_format.h"
+#include "../../src/text_format.cpp"
+
+const time_t DAY_START = 1767225600;                 // Jan 1, 2026 00:00:00 UTC (Thursday)
+const time_t SHOWN_AT = DAY_START + 14 * 3600 + 120; // 14:02 UTC
+
+static const int OFFSETS[] = {-28800, -18000, 3600, 32400}; // Portland, New York, Paris, Tokyo
+
+// One location the way Open-Meteo sends it for timezone=auto: units objects, 5 days of hourly
+// data starting at local midnight, 7 daily entries
+static std::string locationJson(int location, bool withOffset = true)
+{
+    char buf[256];
+    std::string json = "{\"latitude\":";
+    snprintf(buf, sizeof(buf), "%.4f,\"longitude\":%.4f,\"generationtime_ms\":0.%d,", 45.5 + location, -122.6 + location,
+             123 + location);
+    json += buf;
+    if (withOffset)
+    {
+        snprintf(buf, sizeof(buf), "\"utc_offset_seconds\":%d,", OFFSETS[location]);
+        json += buf;
+    }
+    json += "\"timezone\":\"GMT\",\"timezone_abbreviation\":\"GMT\",\"elevation\":50.0,";
+    json += "\"current_units\":{\"time\":\"iso8601\",\"interval\":\"seconds\",\"temperature_2m\":\"\\u00b0F\","
+            "\"relative_humidity_2m\":\"%\",\"wind_speed_10m\":\"mp/h\",\"weather_code\":\"wmo code\"},";
+    snprintf(buf, sizeof(buf),
+             "\"current\":{\"time\":\"2026-01-01T14:00\",\"interval\":900,\"temperature_2m\":%d.4,"
+             "\"relative_humidity_2m\":%d,\"wind_speed_10m\":%d.6,\"weather_code\":%d},",
+             40 + location, 70 + location, 5 + location, location == 1 ? 61 : 3);
+    json += buf;
+    json += "\"hourly_units\":{\"time\":\"iso8601\",\"temperature_2m\":\"\\u00b0F\",\"weather_code\":\"wmo code\"},";
+
+    std::string times, temps, codes;
+    for (int h = 0; h < 120; h++)
+    {
+        const char *sep = h ? "," : "";
+        snprintf(buf, sizeof(buf), "%s\"2026-01-%02dT%02d:00\"", sep, 1 + h / 24, h % 24);
+        times += buf;
+        snprintf(buf, sizeof(buf), "%s%d.%d", sep, 30 + location * 10 + h % 24, h % 10);
+        temps += buf;
+        snprintf(buf, sizeof(buf), "%s%d", sep, (h % 24) < 12 ? 0 : 71);
+        codes += buf;
+    }
+    json += "\"hourly\":{\"time\":[" + times + "],\"temperature_2m\":[" + temps + "],\"weather_code\":[" + codes + "]},";
+
+    json += "\"daily_units\":{\"time\":\"iso8601\",\"weather_code\":\"wmo code\",\"temperature_2m_max\":\"\\u00b0F\","
+            "\"temperature_2m_min\":\"\\u00b0F\"},";
+    std::string days, highs, lows, dailyCodes;
+    for (int d = 0; d < 7; d++)
+    {
+        const char *sep = d ? "," : "";
+        snprintf(buf, sizeof(buf), "%s\"2026-01-%02d\"", sep, 1 + d);
+        days += buf;
+        snprintf(buf, sizeof(buf), "%s%d.%d", sep, 50 + location + d, d);
+        highs += buf;
+        snprintf(buf, sizeof(buf), "%s%d.%d", sep, 35 + location + d, d);
+        lows += buf;
+        snprintf(buf, sizeof(buf), "%s%d", sep, d % 2 ? 95 : 2);
+        dailyCodes += buf;
+    }
+    json += "\"daily\":{\"time\":[" + days + "],\"weather_code\":[" + dailyCodes + "],\"temperature_2m_max\":[" + highs +
+            "],\"temperature_2m_min\":[" + lows + "]}}";
+    return json;
+}
+
+static std::string locationsJson(int count)
+{
+    std::string json = "[";
+    for (int i = 0; i < count; i++)
+    {
+        json += (i ? "," : "") + locationJson(i);
+    }
+    return json + "]";
+}
+
+static int parse(const std::string &json, LocationForecast *records, int maxLocations, size_t chunk)
+{
+    ForecastStreamParser parser;
+    parser.begin(records, maxLocations, SHOWN_AT, 13);
+    for (size_t at = 0; at < json.size(); at += chunk)
+    {
+        size_t length = json.size() - at < chunk ? json.size() - at : chunk;
+        parser.feed(json.data() + at, length);
+    }
+    return parser.finish();
+}
+
+void test_single_location_object()
+{
+    LocationForecast record;
+    TEST_ASSERT_EQUAL(1, parse(locationJson(0), &record, 1, 512));
+
+    TEST_ASSERT_EQUAL(404, record.currentTemp);
+    TEST_ASSERT_EQUAL(WEATHER_OVERCAST, record.currentCondition);
+    TEST_ASSERT_EQUAL(70, record.humidity);
+    TEST_ASSERT_EQUAL(6, record.windSpeed);
+
+    // 14:02 UTC is 06:02 in Portland: columns start at 07:00 local
+    for (int i = 0; i < 6; i++)
+    {
+        TEST_ASSERT_EQUAL(7 + i, record.hourly[i].hour);
+        TEST_ASSERT_EQUAL((30 + 7 + i) * 10 + (7 + i) % 10, record.hourly[i].temp);
+        TEST_ASSERT_EQUAL(7 + i < 12 ? WEATHER_CLEAR : WEATHER_SNOW, record.hourly[i].condition);
+    }
+
+    TEST_ASSERT_EQUAL(4, record.daily[0].dayOfWeek); // Jan 1, 2026 is a Thursday
+    TEST_ASSERT_EQUAL(5, record.daily[1].dayOfWeek);
+    TEST_ASSERT_EQUAL(500, record.daily[0].tempHigh);
+    TEST_ASSERT_EQUAL(350, record.daily[0].tempLow);
+    TEST_ASSERT_EQUAL(WEATHER_CLOUDY, record.daily[0].condition);
+    TEST_ASSERT_EQUAL(WEATHER_THUNDER, record.daily[1].condition);
+    TEST_ASSERT_EQUAL(533, record.daily[3].tempHigh);
+}
+
+void test_locations_start_at_their_own_hour()
+{
+    LocationForecast records[4];
+    TEST_ASSERT_EQUAL(4, parse(locationsJson(4), records, 4, 512));
+
+    // 14:02 UTC: 06:02 Portland, 09:02 New York, 15:02 Paris, 23:02 Tokyo
+    const int firstHour[] = {7, 10, 16, 0};
+    for (int location = 0; location < 4; location++)
+    {
+        TEST_ASSERT_EQUAL(400 + location * 10 + 4, records[location].currentTemp);
+        TEST_ASSERT_EQUAL(firstHour[location], records[location].hourly[0].hour);
+        TEST_ASSERT_EQUAL(500 + location * 10, records[location].daily[0].tempHigh);
+    }
+    TEST_ASSERT_EQUAL(WEATHER_RAIN, records[1].currentCondition);
+    TEST_ASSERT_EQUAL(WEATHER_SNOW, records[2].hourly[0].condition); // 16:00 local
+    TEST_ASSERT_EQUAL(5, records[3].hourly[5].hour);                 // Tokyo wraps past midnight
+}
+
+void test_without_offset_uses_fallback_hour()
+{
+    LocationForecast record;
+    TEST_ASSERT_EQUAL(1, parse(locationJson(0, false), &record, 1, 512));
+    TEST_ASSERT_EQUAL(14, record.hourly[0].hour); // fallbackHour 13 + 1
+}
+
+void test_chunking_does_not_change_the_result()
+{
+    std::string json = locationsJson(3);
+    LocationForecast whole[3];
+    TEST_ASSERT_EQUAL(3, parse(json, whole, 3, json.size()));
+
+    const size_t chunks[] = {1, 7, 64, 512};
+    for (size_t chunk : chunks)
+    {
+        LocationForecast records[3];
+        TEST_ASSERT_EQUAL(3, parse(json, records, 3, chunk));
+        TEST_ASSERT_EQUAL_MEMORY(whole, records, sizeof(whole));
+    }
+}
+
+void test_extra_locations_are_skipped()
+{
+    LocationForecast records[2];
+    TEST_ASSERT_EQUAL(2, parse(locationsJson(4), records, 2, 512));
+    TEST_ASSERT_EQUAL(404, records[0].currentTemp);
+    TEST_ASSERT_EQUAL(414, records[1].currentTemp);
+}
+
+void test_bad_responses_are_rejected()
+{
+    LocationForecast records[3];
+    std::string json = locationsJson(3);
+
+    // Truncated at any point before the closing bracket
+    const size_t cuts[] = {0, 1, 100, json.size() / 2, json.size() - 1};
+    for (size_t cut : cuts)
+    {
+        TEST_ASSERT_EQUAL(-1, parse(json.substr(0, cut), records, 3, 512));
+    }
+
+    // Mismatched brackets, stray separators, two top-level values
+    TEST_ASSERT_EQUAL(-1, parse("{\"current\":[}", records, 3, 512));
+    TEST_ASSERT_EQUAL(-1, parse("{\"a\" 1}", records, 3, 512));
+    TEST_ASSERT_EQUAL(-1, parse(locationJson(0) + locationJson(1), records, 3, 512));
+
+    // A location without its daily section, like an error object
+    std::string noDaily = locationJson(0);
+    noDaily = noDaily.substr(0, noDaily.find(",\"daily_units\"")) + "}";
+    TEST_ASSERT_EQUAL(-1, parse(noDaily, records, 3, 512));
+    TEST_ASSERT_EQUAL(-1, parse("{\"error\":true,\"reason\":\"Latitude must be in range\"}", records, 3, 512));
+}
+
+void test_records_hash_follows_content()
+{
+    LocationForecast a[3], b[3];
+    std::string json = locationsJson(3);
+    TEST_ASSERT_EQUAL(3, parse(json, a, 3, 512));
+    TEST_ASSERT_EQUAL(3, parse(json, b, 3, 61));
+    TEST_ASSERT_EQUAL_HEX32(WeatherCarousel::recordsHash(a, 3), WeatherCarousel::recordsHash(b, 3));
+
+    // generationtime_ms changes on every call and is not kept
+    std::string regenerated = json;
+    regenerated.replace(regenerated.find("0.123"), 5, "0.987");
+    TEST_ASSERT_EQUAL(3, parse(regenerated, b, 3, 512));
+    TEST_ASSERT_EQUAL_HEX32(WeatherCarousel::recordsHash(a, 3), WeatherCarousel::recordsHash(b, 3));
+
+    b[2].daily[3].tempLow++;
+    TEST_ASSERT_NOT_EQUAL(WeatherCarousel::recordsHash(a, 3), WeatherCarousel::recordsHash(b, 3));
+    TEST_ASSERT_NOT_EQUAL(WeatherCarousel::recordsHash(a, 3), WeatherCarousel::recordsHash(a, 2));
+}
+
+void test_carousel_rotation()
+{
+    const int period = 5 * 60;
+    TEST_ASSERT_EQUAL(0, WeatherCarousel::slotAt(DAY_START, 3, period));
+    TEST_ASSERT_EQUAL(0, WeatherCarousel::slotAt(DAY_START + period - 1, 3, period));
+    TEST_ASSERT_EQUAL(1, WeatherCarousel::slotAt(DAY_START + period, 3, period));
+    TEST_ASSERT_EQUAL(2, WeatherCarousel::slotAt(DAY_START + 2 * period, 3, period));
+    TEST_ASSERT_EQUAL(0, WeatherCarousel::slotAt(DAY_START + 3 * period, 3, period));
+    TEST_ASSERT_EQUAL(0, WeatherCarousel::slotAt(DAY_START + period, 1, period));
+    TEST_ASSERT_EQUAL(0, WeatherCarousel::slotAt(DAY_START + period, 0, period));
+
+    char name[16];
+    TEST_ASSERT_EQUAL(3, WeatherCarousel::listCount("Portland,Seattle,Bend"));
+    TEST_ASSERT_EQUAL(0, WeatherCarousel::listCount(""));
+    TEST_ASSERT_TRUE(WeatherCarousel::listEntry("Portland,Seattle,Bend", 1, name, sizeof(name)));
+    TEST_ASSERT_EQUAL_STRING("Seattle", name);
+    TEST_ASSERT_TRUE(WeatherCarousel::listEntry("Portland,Seattle,Bend", 2, name, sizeof(name)));
+    TEST_ASSERT_EQUAL_STRING("Bend", name);
+    TEST_ASSERT_TRUE(WeatherCarousel::listEntry("Portland,Seattle,Bend", 0, name, 5));
+    TEST_ASSERT_EQUAL_STRING("Port", name);
+    TEST_ASSERT_FALSE(WeatherCarousel::listEntry("Portland,Seattle,Bend", 3, name, sizeof(name)));
+}
+
+void test_expanded_record_drives_region_diff()
+{
+    LocationForecast records[2];
+    TEST_ASSERT_EQUAL(2, parse(locationsJson(2), records, 2, 512));
+
+    WeatherData first, second;
+    WeatherCarousel::expand(records[0], 0, SHOWN_AT, first);
+    WeatherCarousel::expand(records[1], 1, SHOWN_AT, second);
+    TEST_ASSERT_EQUAL(404, first.currentTemp);
+    TEST_ASSERT_EQUAL(7, first.hourly[0].hour);
+    TEST_ASSERT_EQUAL(SHOWN_AT, first.lastUpdated);
+    TEST_ASSERT_EQUAL(1, second.location);
+
+    RenderedWeather shown, next;
+    WeatherDiff::capture(first, shown);
+    WeatherDiff::capture(second, next);
+    uint32_t regions = WeatherDiff::changedRegions(shown, next);
+    TEST_ASSERT_TRUE(regions & (1u << REGION_LOCATION_NAME));
+    TEST_ASSERT_TRUE(regions & (1u << REGION_CURRENT_TEMP));
+
+    // Same location again: nothing to redraw
+    WeatherData again;
+    WeatherCarousel::expand(records[0], 0, SHOWN_AT, again);
+    WeatherDiff::capture(again, next);
+    TEST_ASSERT_EQUAL(0, WeatherDiff::changedRegions(shown, next));
+}
+
+void test_parse_speed_and_memory()
+{
+    std::string json = locationsJson(4);
+    LocationForecast records[4];
+    const int runs = 200;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++)
+    {
+        TEST_ASSERT_EQUAL(4, parse(json, records, 4, 512));
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    char msg[200];
+    snprintf(msg, sizeof(msg), "4 locations, %u byte body: %.1f MB/s on host, %.1f us per location",
+             (unsigned)json.size(), json.size() * runs / seconds / 1e6, seconds * 1e6 / runs / 4);
+    TEST_MESSAGE(msg);
+    snprintf(msg, sizeof(msg), "Parser state %u bytes + %u bytes per location record (was a 20480 byte JSON document)",
+             (unsigned)sizeof(ForecastStreamParser), (unsigned)sizeof(LocationForecast));
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_THAN(1024, sizeof(ForecastStreamParser));
+    TEST_ASSERT_LESS_THAN(64, sizeof(LocationForecast));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_single_location_object);
+    RUN_TEST(test_locations_start_at_their_own_hour);
+    RUN_TEST(test_without_offset_uses_fallback_hour);
+    RUN_TEST(test_chunking_does_not_change_the_result);
+    RUN_TEST(test_extra_locations_are_skipped);
+    RUN_TEST(test_bad_responses_are_rejected);
+    RUN_TEST(test_records_hash_follows_content);
+    RUN_TEST(test_carousel_rotation);
+    RUN_TEST(test_expanded_record_drives_region_diff);
+    RUN_TEST(test_parse_speed_and_memory);
+
+    return UNITY_END();
+}
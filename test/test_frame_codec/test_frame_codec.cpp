@@ -0,0 +1,260 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#define PROGMEM
+#include "../../src/weather_bitmaps.h"
+#include "../../src/weather_bitmaps.cpp"
+#include "../../src/packed_bitmap.cpp"
+#include "../../src/weather_layout.h"
+#include "../../src/frame_codec.h"
+#include "../../src/frame_codec.cpp" // Include implementation directly for testing
+
+const int PANE_WIDTH = WEATHER_PANE_WIDTH;
+const int PANE_HEIGHT = DISPLAY_HEIGHT;
+const int PANE_ROW_BYTES = PANE_WIDTH / 8;
+const int BAND_ROWS = 16; // Same band height as DisplayManager::drawFrame
+
+// Packed 1bpp canvas, 1 = white
+struct Canvas
+{
+    std::vector<uint8_t> bits;
+    Canvas() : bits(PANE_ROW_BYTES * PANE_HEIGHT, 0xFF) {}
+
+    void black(int x, int y)
+    {
+        if (x < 0 || y < 0 || x >= PANE_WIDTH || y >= PANE_HEIGHT)
+            return;
+        bits[y * PANE_ROW_BYTES + x / 8] &= ~(0x80 >> (x % 8));
+    }
+
+    void icon(int centerX, int centerY, const PackedBitmap *bitmap)
+    {
+        RasterTarget target = {bits.data(), 0, 0, PANE_WIDTH, PANE_HEIGHT, 0, PANE_HEIGHT, PANE_WIDTH, PANE_HEIGHT};
+        PackedBlit::draw(target, *bitmap, centerX - 20, centerY - 20);
+    }
+
+    // Stand-in for a line of 12pt text: pseudo-random glyph strokes
+    void text(int centerX, int baseline, int chars, unsigned seed)
+    {
+        int x0 = centerX - chars * 7;
+        for (int c = 0; c < chars; c++)
+        {
+            seed = seed * 1103515245 + 12345;
+            for (int stroke = 0; stroke < 5; stroke++)
+            {
+                int sx = x0 + c * 14 + (seed >> (stroke * 3)) % 10;
+                for (int y = baseline - 17; y < baseline; y++)
+                    for (int w = 0; w < 3; w++)
+                        black(sx + w, y);
+            }
+        }
+    }
+};
+
+// Sample frame: the weather pane laid out like DisplayWeather (pane-local coordinates)
+static Canvas weatherPane()
+{
+    Canvas canvas;
+    const PackedBitmap *icons[] = {&sun_max_40x40, &cloud_40x40, &cloud_rain_40x40, &cloud_snow_40x40,
+                                   &cloud_bolt_rain_40x40};
+
+    // Large current temperature: three 70x110 digit blocks with a hollow middle
+    for (int d = 0; d < 3; d++)
+        for (int y = CURRENT_TEMP_Y; y < CURRENT_TEMP_Y + 110; y++)
+            for (int x = 0; x < 70; x++)
+                if (x < 14 || x > 56 || y < CURRENT_TEMP_Y + 14 || y > CURRENT_TEMP_Y + 96)
+                    canvas.black(95 + d * 70 + x, y);
+
+    int hourlyWidth = PANE_WIDTH / HOURLY_COLUMNS;
+    for (int i = 0; i < HOURLY_COLUMNS; i++)
+    {
+        int centerX = i * hourlyWidth + hourlyWidth / 2;
+        canvas.text(centerX, HOURLY_START_Y + TEXT_HEIGHT, 3, i);
+        canvas.icon(centerX, HOURLY_START_Y + ICON_HEIGHT, icons[i]);
+        canvas.text(centerX, HOURLY_START_Y + ICON_HEIGHT + TEXT_HEIGHT * 2, 3, 10 + i);
+    }
+
+    int dailyWidth = PANE_WIDTH / DAILY_COLUMNS;
+    for (int i = 0; i < DAILY_COLUMNS; i++)
+    {
+        int centerX = i * dailyWidth + dailyWidth / 2;
+        canvas.text(centerX, DAILY_START_Y + TEXT_HEIGHT, 3, 20 + i);
+        canvas.icon(centerX, DAILY_START_Y + ICON_HEIGHT, icons[(i + 2) % 5]);
+        canvas.text(centerX, DAILY_START_Y + ICON_HEIGHT + TEXT_HEIGHT * 2, 6, 30 + i);
+    }
+
+    canvas.text(LAST_UPDATED_X - WEATHER_PANE_X + 60, LAST_UPDATED_Y, 12, 99);
+    return canvas;
+}
+
+static Canvas noisePane()
+{
+    Canvas canvas;
+    unsigned seed = 7;
+    for (auto &b : canvas.bits)
+    {
+        seed = seed * 1103515245 + 12345;
+        b = (uint8_t)(seed >> 16);
+    }
+    return canvas;
+}
+
+static std::vector<uint8_t> encodeFrame(const Canvas &canvas, uint8_t flags)
+{
+    FrameInfo info = {WEATHER_PANE_X, 0, PANE_WIDTH, PANE_HEIGHT, flags, 0};
+    std::vector<uint8_t> frame(FrameCodec::maxEncodedSize(PANE_WIDTH, PANE_HEIGHT));
+    size_t length = FrameCodec::encode(canvas.bits.data(), info, frame.data(), frame.size());
+    frame.resize(length);
+    return frame;
+}
+
+// Decode band by band and compare against the source image
+static bool decodesTo(const std::vector<uint8_t> &frame, const Canvas &canvas, int bandRows)
+{
+    FrameDecoder decoder;
+    if (!decoder.begin(frame.data(), frame.size()))
+        return false;
+
+    std::vector<uint8_t> band(bandRows * PANE_ROW_BYTES);
+    int row = 0;
+    int rows;
+    while ((rows = decoder.decodeRows(band.data(), bandRows)) > 0)
+    {
+        if (memcmp(band.data(), &canvas.bits[row * PANE_ROW_BYTES], rows * PANE_ROW_BYTES) != 0)
+            return false;
+        row += rows;
+    }
+    return rows == 0 && row == PANE_HEIGHT;
+}
+
+void test_header_fields()
+{
+    std::vector<uint8_t> frame = encodeFrame(weatherPane(), FRAME_FLAG_PACKBITS);
+    FrameDecoder decoder;
+    TEST_ASSERT_TRUE(decoder.begin(frame.data(), frame.size()));
+    TEST_ASSERT_EQUAL(WEATHER_PANE_X, decoder.info().x);
+    TEST_ASSERT_EQUAL(0, decoder.info().y);
+    TEST_ASSERT_EQUAL(PANE_WIDTH, decoder.info().width);
+    TEST_ASSERT_EQUAL(PANE_HEIGHT, decoder.info().height);
+    TEST_ASSERT_EQUAL(frame.size() - FRAME_HEADER_SIZE, decoder.info().dataLength);
+}
+
+void test_round_trip_sample_frames()
+{
+    Canvas blank;
+    Canvas pane = weatherPane();
+    Canvas noise = noisePane();
+
+    TEST_ASSERT_TRUE(decodesTo(encodeFrame(blank, FRAME_FLAG_PACKBITS), blank, BAND_ROWS));
+    TEST_ASSERT_TRUE(decodesTo(encodeFrame(pane, FRAME_FLAG_PACKBITS), pane, BAND_ROWS));
+    TEST_ASSERT_TRUE(decodesTo(encodeFrame(noise, FRAME_FLAG_PACKBITS), noise, BAND_ROWS));
+    TEST_ASSERT_TRUE(decodesTo(encodeFrame(pane, 0), pane, BAND_ROWS));
+}
+
+void test_band_height_does_not_matter()
+{
+    // Runs cross band and row boundaries; any band height must give the same image
+    Canvas pane = weatherPane();
+    std::vector<uint8_t> frame = encodeFrame(pane, FRAME_FLAG_PACKBITS);
+    TEST_ASSERT_TRUE(decodesTo(frame, pane, 1));
+    TEST_ASSERT_TRUE(decodesTo(frame, pane, 7));
+    TEST_ASSERT_TRUE(decodesTo(frame, pane, PANE_HEIGHT));
+}
+
+void test_rewind_decodes_again()
+{
+    Canvas pane = weatherPane();
+    std::vector<uint8_t> frame = encodeFrame(pane, FRAME_FLAG_PACKBITS);
+    FrameDecoder decoder;
+    decoder.begin(frame.data(), frame.size());
+
+    std::vector<uint8_t> band(BAND_ROWS * PANE_ROW_BYTES);
+    while (decoder.decodeRows(band.data(), BAND_ROWS) > 0)
+    {
+    }
+    decoder.rewind();
+    TEST_ASSERT_EQUAL(BAND_ROWS, decoder.decodeRows(band.data(), BAND_ROWS));
+    TEST_ASSERT_EQUAL_MEMORY(pane.bits.data(), band.data(), BAND_ROWS * PANE_ROW_BYTES);
+}
+
+void test_rejects_bad_frames()
+{
+    std::vector<uint8_t> frame = encodeFrame(weatherPane(), FRAME_FLAG_PACKBITS);
+    FrameDecoder decoder;
+
+    // Truncated download
+    TEST_ASSERT_FALSE(decoder.begin(frame.data(), frame.size() - 10));
+
+    // Width not a multiple of 8
+    std::vector<uint8_t> bad = frame;
+    bad[8] = 13;
+    TEST_ASSERT_FALSE(decoder.begin(bad.data(), bad.size()));
+
+    // Stream that ends before the image does
+    bad = frame;
+    bad[10] = (uint8_t)(PANE_HEIGHT + 40);
+    bad[11] = (uint8_t)((PANE_HEIGHT + 40) >> 8);
+    TEST_ASSERT_TRUE(decoder.begin(bad.data(), bad.size()));
+    std::vector<uint8_t> band(BAND_ROWS * PANE_ROW_BYTES);
+    int rows;
+    while ((rows = decoder.decodeRows(band.data(), BAND_ROWS)) > 0)
+    {
+    }
+    TEST_ASSERT_EQUAL(-1, rows);
+}
+
+void test_decode_throughput_and_memory()
+{
+    Canvas pane = weatherPane();
+    Canvas noise = noisePane();
+    std::vector<uint8_t> paneFrame = encodeFrame(pane, FRAME_FLAG_PACKBITS);
+    std::vector<uint8_t> noiseFrame = encodeFrame(noise, FRAME_FLAG_PACKBITS);
+    size_t raw = (size_t)PANE_ROW_BYTES * PANE_HEIGHT;
+
+    const int ROUNDS = 500;
+    std::vector<uint8_t> band(BAND_ROWS * PANE_ROW_BYTES);
+    FrameDecoder decoder;
+    uint32_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++)
+    {
+        decoder.begin(paneFrame.data(), paneFrame.size());
+        while (decoder.decodeRows(band.data(), BAND_ROWS) > 0)
+            checksum += band[0];
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    TEST_ASSERT_TRUE(checksum > 0);
+
+    // Peak working memory while drawing: decoder state plus one band (the compressed frame is the download itself)
+    size_t peak = sizeof(FrameDecoder) + band.size();
+
+    char msg[220];
+    snprintf(msg, sizeof(msg), "Weather pane: %zu -> %zu bytes (%.1f%%), noise: %zu bytes; decode %.0f MB/s, %.0f us/frame",
+             raw, paneFrame.size(), 100.0 * paneFrame.size() / raw, noiseFrame.size(),
+             raw * ROUNDS / seconds / 1e6, seconds * 1e6 / ROUNDS);
+    TEST_MESSAGE(msg);
+    snprintf(msg, sizeof(msg), "Peak decode memory: %zu bytes (decoder %zu + %d-row band %zu) vs %zu for a full pane copy",
+             peak, sizeof(FrameDecoder), BAND_ROWS, band.size(), raw);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_TRUE(paneFrame.size() * 2 < raw);
+    TEST_ASSERT_TRUE(noiseFrame.size() <= FrameCodec::maxEncodedSize(PANE_WIDTH, PANE_HEIGHT));
+    TEST_ASSERT_TRUE(peak * 10 < raw);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_header_fields);
+    RUN_TEST(test_round_trip_sample_frames);
+    RUN_TEST(test_band_height_does_not_matter);
+    RUN_TEST(test_rewind_decodes_again);
+    RUN_TEST(test_rejects_bad_frames);
+    RUN_TEST(test_decode_throughput_and_memory);
+
+    return UNITY_END();
+}
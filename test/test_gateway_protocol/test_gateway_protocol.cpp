@@ -0,0 +1,289 @@
+#include <unity.h>
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../../src/gateway_protocol.h"
+#include "../../src/gateway_protocol.cpp" // Include implementation directly for testing
+#include "../../src/sun_times.h"
+#include "../../src/sun_times.cpp"
+
+static WeatherData makeWeather()
+{
+    WeatherData weather = {};
+    weather.currentTemp = 414;
+    weather.currentCondition = WEATHER_OVERCAST;
+    weather.humidity = 81;
+    weather.windSpeed = 7;
+    weather.lastUpdated = 1767362400;
+    for (int i = 0; i < 6; i++)
+    {
+        weather.hourly[i].hour = 15 + i;
+        weather.hourly[i].temp = 408 - i * 10;
+        weather.hourly[i].condition = (i < 3) ? WEATHER_RAIN : WEATHER_CLOUDY;
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        weather.daily[i].dayOfWeek = (5 + i) % 7;
+        weather.daily[i].tempHigh = 473 + i * 10;
+        weather.daily[i].tempLow = -25 + i * 10;
+        weather.daily[i].condition = WEATHER_SNOW;
+    }
+    return weather;
+}
+
+void test_request_round_trip()
+{
+    GatewayRequest request = {0xBEEF, 14, GatewayProtocol::parseCoordinateE4("45.5152"),
+                              GatewayProtocol::parseCoordinateE4("-122.6784"), 0x12345678};
+    uint8_t buffer[GATEWAY_REQUEST_SIZE];
+    TEST_ASSERT_EQUAL(GATEWAY_REQUEST_SIZE, GatewayProtocol::encodeRequest(request, buffer));
+
+    GatewayRequest decoded = {};
+    TEST_ASSERT_TRUE(GatewayProtocol::decodeRequest(buffer, sizeof(buffer), decoded));
+    TEST_ASSERT_EQUAL(0xBEEF, decoded.sequence);
+    TEST_ASSERT_EQUAL(14, decoded.displayHour);
+    TEST_ASSERT_EQUAL(455152, decoded.latitudeE4);
+    TEST_ASSERT_EQUAL(-1226784, decoded.longitudeE4);
+    TEST_ASSERT_EQUAL(0x12345678, decoded.knownHash);
+}
+
+void test_weather_round_trip()
+{
+    WeatherData weather = makeWeather();
+    uint8_t buffer[GATEWAY_MAX_RESPONSE_SIZE];
+    size_t length = GatewayProtocol::encodeResponse(GATEWAY_WEATHER, 7, weather, buffer);
+    TEST_ASSERT_EQUAL(GATEWAY_MAX_RESPONSE_SIZE, length);
+
+    WeatherData decoded = {};
+    uint32_t hash = 0;
+    TEST_ASSERT_EQUAL(GATEWAY_DECODE_WEATHER, GatewayProtocol::decodeResponse(buffer, length, 7, decoded, hash));
+    TEST_ASSERT_TRUE(hash != 0);
+
+    TEST_ASSERT_EQUAL(weather.lastUpdated, decoded.lastUpdated);
+    TEST_ASSERT_EQUAL(414, decoded.currentTemp);
+    TEST_ASSERT_EQUAL(WEATHER_OVERCAST, decoded.currentCondition);
+    TEST_ASSERT_EQUAL(81, decoded.humidity);
+    TEST_ASSERT_EQUAL(7, decoded.windSpeed);
+    for (int i = 0; i < 6; i++)
+    {
+        TEST_ASSERT_EQUAL(weather.hourly[i].hour, decoded.hourly[i].hour);
+        TEST_ASSERT_EQUAL(weather.hourly[i].temp, decoded.hourly[i].temp);
+        TEST_ASSERT_EQUAL(weather.hourly[i].condition, decoded.hourly[i].condition);
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        TEST_ASSERT_EQUAL(weather.daily[i].dayOfWeek, decoded.daily[i].dayOfWeek);
+        TEST_ASSERT_EQUAL(weather.daily[i].tempHigh, decoded.daily[i].tempHigh);
+        TEST_ASSERT_EQUAL(weather.daily[i].tempLow, decoded.daily[i].tempLow);
+        TEST_ASSERT_EQUAL(weather.daily[i].condition, decoded.daily[i].condition);
+    }
+}
+
+void test_not_modified_and_error()
+{
+    WeatherData weather = {};
+    uint32_t hash = 0;
+    uint8_t buffer[GATEWAY_MAX_RESPONSE_SIZE];
+
+    size_t length = GatewayProtocol::encodeResponse(GATEWAY_NOT_MODIFIED, 3, weather, buffer);
+    TEST_ASSERT_EQUAL(GATEWAY_HEADER_SIZE, length);
+    TEST_ASSERT_EQUAL(GATEWAY_DECODE_NOT_MODIFIED, GatewayProtocol::decodeResponse(buffer, length, 3, weather, hash));
+
+    length = GatewayProtocol::encodeResponse(GATEWAY_ERROR, 3, weather, buffer);
+    TEST_ASSERT_EQUAL(GATEWAY_DECODE_ERROR, GatewayProtocol::decodeResponse(buffer, length, 3, weather, hash));
+}
+
+void test_rejects_bad_packets()
+{
+    WeatherData weather = makeWeather();
+    WeatherData decoded = {};
+    uint32_t hash = 0;
+    uint8_t buffer[GATEWAY_MAX_RESPONSE_SIZE];
+    size_t length = GatewayProtocol::encodeResponse(GATEWAY_WEATHER, 9, weather, buffer);
+
+    // Truncated
+    TEST_ASSERT_EQUAL(GATEWAY_DECODE_BAD_PACKET, GatewayProtocol::decodeResponse(buffer, length - 1, 9, decoded, hash));
+
+    // Late reply to an earlier attempt
+    TEST_ASSERT_EQUAL(GATEWAY_DECODE_WRONG_SEQUENCE, GatewayProtocol::decodeResponse(buffer, length, 10, decoded, hash));
+
+    // Corrupted payload byte fails the content hash
+    buffer[GATEWAY_HEADER_SIZE + 20] ^= 0x40;
+    TEST_ASSERT_EQUAL(GATEWAY_DECODE_BAD_PACKET, GatewayProtocol::decodeResponse(buffer, length, 9, decoded, hash));
+    buffer[GATEWAY_HEADER_SIZE + 20] ^= 0x40;
+
+    // Other protocol version
+    buffer[2] = GATEWAY_VERSION + 1;
+    TEST_ASSERT_EQUAL(GATEWAY_DECODE_BAD_PACKET, GatewayProtocol::decodeResponse(buffer, length, 9, decoded, hash));
+
+    // Nothing was written on failure
+    TEST_ASSERT_EQUAL(0, decoded.lastUpdated);
+}
+
+void test_hash_tracks_content_not_fetch_time()
+{
+    WeatherData weather = makeWeather();
+    WeatherData decoded = {};
+    uint32_t hashA = 0, hashB = 0;
+    uint8_t buffer[GATEWAY_MAX_RESPONSE_SIZE];
+
+    size_t length = GatewayProtocol::encodeResponse(GATEWAY_WEATHER, 1, weather, buffer);
+    GatewayProtocol::decodeResponse(buffer, length, 1, decoded, hashA);
+    weather.lastUpdated += 600; // Gateway refetched, forecast identical
+    length = GatewayProtocol::encodeResponse(GATEWAY_WEATHER, 1, weather, buffer);
+    GatewayProtocol::decodeResponse(buffer, length, 1, decoded, hashB);
+    TEST_ASSERT_EQUAL(hashA, hashB);
+
+    weather.hourly[2].temp += 10;
+    length = GatewayProtocol::encodeResponse(GATEWAY_WEATHER, 1, weather, buffer);
+    GatewayProtocol::decodeResponse(buffer, length, 1, decoded, hashB);
+    TEST_ASSERT_NOT_EQUAL(hashA, hashB);
+}
+
+// Local stand-in for scripts/weather_gateway.py on the loopback interface.
+// Serves the cached forecast and answers NOT_MODIFIED when the panel already has it.
+struct GatewayStandIn
+{
+    int sock;
+    uint16_t port;
+    WeatherData forecast;
+    int served;
+
+    bool open()
+    {
+        sock = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        if (sock < 0 || bind(sock, (sockaddr *)&addr, sizeof(addr)) != 0)
+            return false;
+        socklen_t len = sizeof(addr);
+        getsockname(sock, (sockaddr *)&addr, &len);
+        port = ntohs(addr.sin_port);
+        return true;
+    }
+
+    void serveOne()
+    {
+        uint8_t in[64];
+        sockaddr_in from = {};
+        socklen_t fromLen = sizeof(from);
+        ssize_t n = recvfrom(sock, in, sizeof(in), 0, (sockaddr *)&from, &fromLen);
+        GatewayRequest request;
+        if (n <= 0 || !GatewayProtocol::decodeRequest(in, n, request))
+            return;
+
+        uint8_t out[GATEWAY_MAX_RESPONSE_SIZE];
+        size_t length = GatewayProtocol::encodeResponse(GATEWAY_WEATHER, request.sequence, forecast, out);
+        uint32_t hash = 0;
+        WeatherData scratch;
+        GatewayProtocol::decodeResponse(out, length, request.sequence, scratch, hash);
+        if (request.knownHash == hash)
+            length = GatewayProtocol::encodeResponse(GATEWAY_NOT_MODIFIED, request.sequence, forecast, out);
+
+        sendto(sock, out, length, 0, (sockaddr *)&from, fromLen);
+        served++;
+    }
+};
+
+// Device side of one exchange, following NetworkManager::fetchWeatherFromGateway
+static GatewayDecodeResult exchange(int client, GatewayStandIn &gateway, uint16_t sequence, uint32_t knownHash,
+                                    WeatherData &weather, uint32_t &hash, size_t &bytesOnWire)
+{
+    GatewayRequest request = {sequence, 14, 455152, -1226784, knownHash};
+    uint8_t buffer[GATEWAY_MAX_RESPONSE_SIZE];
+    size_t length = GatewayProtocol::encodeRequest(request, buffer);
+
+    sockaddr_in to = {};
+    to.sin_family = AF_INET;
+    to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    to.sin_port = htons(gateway.port);
+    sendto(client, buffer, length, 0, (sockaddr *)&to, sizeof(to));
+
+    gateway.serveOne();
+
+    ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+    bytesOnWire = length + (received > 0 ? received : 0);
+    return GatewayProtocol::decodeResponse(buffer, received > 0 ? received : 0, sequence, weather, hash);
+}
+
+void test_round_trip_against_local_gateway()
+{
+    GatewayStandIn gateway = {};
+    gateway.forecast = makeWeather();
+    TEST_ASSERT_TRUE(gateway.open());
+
+    int client = socket(AF_INET, SOCK_DGRAM, 0);
+    timeval timeout = {1, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    const int ROUNDS = 200;
+    uint32_t knownHash = 0;
+    int updates = 0, notModified = 0;
+    size_t wireBytes = 0, firstExchangeBytes = 0;
+    double totalMicros = 0, worstMicros = 0;
+
+    for (int i = 0; i < ROUNDS; i++)
+    {
+        // Forecast changes every 50 requests, panels otherwise already have it
+        if (i > 0 && i % 50 == 0)
+            gateway.forecast.currentTemp += 10;
+
+        WeatherData weather = {};
+        uint32_t hash = 0;
+        size_t bytes = 0;
+        auto start = std::chrono::steady_clock::now();
+        GatewayDecodeResult result = exchange(client, gateway, (uint16_t)(i + 1), knownHash, weather, hash, bytes);
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        totalMicros += micros;
+        if (micros > worstMicros)
+            worstMicros = micros;
+        wireBytes += bytes;
+        if (i == 0)
+            firstExchangeBytes = bytes;
+
+        if (result == GATEWAY_DECODE_WEATHER)
+        {
+            updates++;
+            knownHash = hash;
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL(GATEWAY_DECODE_NOT_MODIFIED, result);
+            notModified++;
+        }
+    }
+    close(client);
+    close(gateway.sock);
+
+    char msg[200];
+    snprintf(msg, sizeof(msg), "%d exchanges: %d updates, %d not modified, avg RTT %.0f us, worst %.0f us, %zu bytes first exchange, %zu bytes total",
+             ROUNDS, updates, notModified, totalMicros / ROUNDS, worstMicros, firstExchangeBytes, wireBytes);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_EQUAL(ROUNDS, gateway.served);
+    TEST_ASSERT_EQUAL(4, updates);
+    TEST_ASSERT_EQUAL(GATEWAY_REQUEST_SIZE + GATEWAY_MAX_RESPONSE_SIZE, firstExchangeBytes);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_request_round_trip);
+    RUN_TEST(test_weather_round_trip);
+    RUN_TEST(test_not_modified_and_error);
+    RUN_TEST(test_rejects_bad_packets);
+    RUN_TEST(test_hash_tracks_content_not_fetch_time);
+
+    // Loopback stand-in of the gateway
+    RUN_TEST(test_round_trip_against_local_gateway);
+
+    return UNITY_END();
+}
@@ -0,0 +1,346 @@
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "../../src/http_stream.h"
+#include "../../src/http_stream.cpp" // Include implementation directly for testing
+#include "../../src/forecast_stream.h"
+#include "../../src/forecast_stream.cpp"
+
+const time_t SHOWN_AT = 1767225600 + 14 * 3600; // Jan 1, 2026 14:00 UTC
+
+static void collect(void *context, const char *data, size_t length)
+{
+    ((std::string *)context)->append(data, length);
+}
+
+static void feedParser(void *context, const char *data, size_t length)
+{
+    ((ForecastStreamParser *)context)->feed(data, length);
+}
+
+static std::string chunked(const std::string &body, size_t chunkSize)
+{
+    std::string out;
+    char size[16];
+    for (size_t at = 0; at < body.size(); at += chunkSize)
+    {
+        std::string piece = body.substr(at, chunkSize);
+        snprintf(size, sizeof(size), "%zx\r\n", piece.size());
+        out += size + piece + "\r\n";
+    }
+    return out + "0\r\n\r\n";
+}
+
+static std::string withLength(const std::string &head, const std::string &body)
+{
+    return head + "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+}
+
+// Read one response from a byte stream delivered in pieces of `piece` bytes; returns bytes consumed
+static size_t readOne(HttpResponseReader &reader, const std::string &stream, size_t from, size_t piece,
+                      std::string &body)
+{
+    size_t at = from;
+    while (at < stream.size() && !reader.done() && !reader.failed())
+    {
+        size_t length = stream.size() - at < piece ? stream.size() - at : piece;
+        at += reader.feed(stream.data() + at, length, collect, &body);
+    }
+    return at - from;
+}
+
+// Open-Meteo bodies for two locations (5 days of hourly data, as the panel requests)
+static std::string forecastBody()
+{
+    std::string one = "{\"utc_offset_seconds\":0,\"current_units\":{\"temperature_2m\":\"F\"},"
+                      "\"current\":{\"temperature_2m\":41.2,\"relative_humidity_2m\":80,\"weather_code\":3},"
+                      "\"hourly\":{\"time\":[";
+    char time[24];
+    for (int h = 0; h < 120; h++)
+    {
+        snprintf(time, sizeof(time), "%s\"2026-01-%02dT%02d:00\"", h ? "," : "", 1 + h / 24, h % 24);
+        one += time;
+    }
+    one += "],\"temperature_2m\":[";
+    for (int h = 0; h < 120; h++)
+        one += std::string(h ? "," : "") + std::to_string(30 + h % 24) + ".5";
+    one += "],\"weather_code\":[";
+    for (int h = 0; h < 120; h++)
+        one += std::string(h ? "," : "") + "61";
+    one += "]},\"daily\":{\"time\":[\"2026-01-01\",\"2026-01-02\",\"2026-01-03\",\"2026-01-04\"],"
+           "\"temperature_2m_max\":[50,51,52,53],\"temperature_2m_min\":[40,41,42,43],\"weather_code\":[3,3,61,0]}}";
+    return "[" + one + "," + one + "]";
+}
+
+static std::string airQualityBody()
+{
+    return "[{\"latitude\":45.5,\"longitude\":-122.6,\"generationtime_ms\":0.1,\"utc_offset_seconds\":0,"
+           "\"current_units\":{\"time\":\"iso8601\",\"interval\":\"seconds\",\"us_aqi\":\"USAQI\",\"pm2_5\":\"\\u03bcg/m\\u00b3\"},"
+           "\"current\":{\"time\":\"2026-01-01T14:00\",\"interval\":3600,\"us_aqi\":42,\"pm2_5\":8.3}},"
+           "{\"latitude\":47.6,\"longitude\":-122.3,\"generationtime_ms\":0.1,\"utc_offset_seconds\":0,"
+           "\"current_units\":{\"time\":\"iso8601\",\"interval\":\"seconds\",\"us_aqi\":\"USAQI\",\"pm2_5\":\"\\u03bcg/m\\u00b3\"},"
+           "\"current\":{\"time\":\"2026-01-01T14:00\",\"interval\":3600,\"us_aqi\":null,\"pm2_5\":61.0}}]";
+}
+
+void test_content_length_response()
+{
+    std::string stream = withLength("HTTP/1.1 200 OK\r\nETag: \"abc\"\r\nLast-Modified: Thu, 01 Jan 2026 14:00:00 GMT\r\n",
+                                    "{\"a\":1}");
+    const size_t pieces[] = {1, 3, stream.size()};
+    for (size_t piece : pieces)
+    {
+        HttpResponseReader reader;
+        reader.begin();
+        std::string body;
+        TEST_ASSERT_EQUAL(stream.size(), readOne(reader, stream, 0, piece, body));
+        TEST_ASSERT_TRUE(reader.done());
+        TEST_ASSERT_TRUE(reader.keepAlive());
+        TEST_ASSERT_EQUAL(200, reader.status());
+        TEST_ASSERT_EQUAL_STRING("{\"a\":1}", body.c_str());
+        TEST_ASSERT_EQUAL_STRING("\"abc\"", reader.etag());
+        TEST_ASSERT_EQUAL_STRING("Thu, 01 Jan 2026 14:00:00 GMT", reader.lastModified());
+    }
+}
+
+void test_chunked_response()
+{
+    std::string body = forecastBody();
+    std::string stream = "HTTP/1.1 200 OK\r\ntransfer-encoding: Chunked\r\nX-Long: " + std::string(200, 'x') +
+                         "\r\n\r\n" + chunked(body, 100);
+    // Extensions and trailers are allowed by the spec
+    stream.replace(stream.find("64\r\n"), 4, "64;name=v\r\n");
+    stream.replace(stream.size() - 2, 2, "X-Trailer: 1\r\n\r\n");
+
+    const size_t pieces[] = {1, 7, 512};
+    for (size_t piece : pieces)
+    {
+        HttpResponseReader reader;
+        reader.begin();
+        std::string received;
+        TEST_ASSERT_EQUAL(stream.size(), readOne(reader, stream, 0, piece, received));
+        TEST_ASSERT_TRUE(reader.done());
+        TEST_ASSERT_TRUE(reader.keepAlive());
+        TEST_ASSERT_TRUE(received == body);
+    }
+}
+
+void test_responses_without_body()
+{
+    HttpResponseReader reader;
+    std::string body;
+
+    std::string notModified = "HTTP/1.1 304 Not Modified\r\nETag: \"abc\"\r\n\r\n";
+    reader.begin();
+    TEST_ASSERT_EQUAL(notModified.size(), readOne(reader, notModified, 0, 512, body));
+    TEST_ASSERT_TRUE(reader.done());
+    TEST_ASSERT_EQUAL(304, reader.status());
+    TEST_ASSERT_TRUE(reader.keepAlive());
+
+    // Interim 100 Continue is skipped
+    std::string interim = "HTTP/1.1 100 Continue\r\n\r\n" + withLength("HTTP/1.1 200 OK\r\n", "ok");
+    reader.begin();
+    TEST_ASSERT_EQUAL(interim.size(), readOne(reader, interim, 0, 5, body));
+    TEST_ASSERT_EQUAL(200, reader.status());
+    TEST_ASSERT_EQUAL_STRING("ok", body.c_str());
+
+    // HEAD carries a length but no body
+    std::string head = "HTTP/1.1 200 OK\r\nContent-Length: 1234\r\n\r\n";
+    reader.begin(true);
+    TEST_ASSERT_EQUAL(head.size(), readOne(reader, head, 0, 512, body));
+    TEST_ASSERT_TRUE(reader.done());
+}
+
+void test_connection_close_and_http10()
+{
+    HttpResponseReader reader;
+    std::string body;
+
+    // No framing: body ends when the server closes
+    std::string unframed = "HTTP/1.0 200 OK\r\n\r\n{\"a\":1}";
+    reader.begin();
+    readOne(reader, unframed, 0, 512, body);
+    TEST_ASSERT_FALSE(reader.done());
+    TEST_ASSERT_TRUE(reader.closed());
+    TEST_ASSERT_TRUE(reader.done());
+    TEST_ASSERT_FALSE(reader.keepAlive());
+    TEST_ASSERT_EQUAL_STRING("{\"a\":1}", body.c_str());
+
+    std::string close = withLength("HTTP/1.1 200 OK\r\nConnection: close\r\n", "x");
+    reader.begin();
+    readOne(reader, close, 0, 512, body);
+    TEST_ASSERT_TRUE(reader.done());
+    TEST_ASSERT_FALSE(reader.keepAlive());
+
+    std::string keep = withLength("HTTP/1.0 200 OK\r\nConnection: Keep-Alive\r\n", "x");
+    reader.begin();
+    readOne(reader, keep, 0, 512, body);
+    TEST_ASSERT_TRUE(reader.keepAlive());
+}
+
+void test_broken_responses_fail()
+{
+    HttpResponseReader reader;
+    std::string body;
+
+    std::string garbage = "SSH-2.0-OpenSSH\r\n\r\n";
+    reader.begin();
+    readOne(reader, garbage, 0, 512, body);
+    TEST_ASSERT_TRUE(reader.failed());
+
+    std::string badChunk = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n";
+    reader.begin();
+    readOne(reader, badChunk, 0, 512, body);
+    TEST_ASSERT_TRUE(reader.failed());
+
+    // Connection dropped in the middle of a framed body
+    std::string cut = withLength("HTTP/1.1 200 OK\r\n", "{\"a\":1}");
+    cut.resize(cut.size() - 2);
+    reader.begin();
+    readOne(reader, cut, 0, 512, body);
+    TEST_ASSERT_FALSE(reader.closed());
+    TEST_ASSERT_TRUE(reader.failed());
+    TEST_ASSERT_FALSE(reader.keepAlive());
+}
+
+void test_pipelined_forecast_and_air_quality()
+{
+    // Two responses back to back on one connection, as the panel reads them
+    std::string forecast = "HTTP/1.1 200 OK\r\nETag: \"f1\"\r\nTransfer-Encoding: chunked\r\n\r\n" +
+                           chunked(forecastBody(), 1000);
+    std::string air = withLength("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n", airQualityBody());
+    std::string stream = forecast + air;
+
+    const size_t pieces[] = {1, 13, 512};
+    for (size_t piece : pieces)
+    {
+        LocationForecast records[2];
+        ForecastStreamParser parser;
+        HttpResponseReader reader;
+
+        parser.begin(records, 2, SHOWN_AT, 13);
+        reader.begin();
+        size_t at = 0;
+        while (!reader.done() && at < stream.size())
+        {
+            size_t length = stream.size() - at < piece ? stream.size() - at : piece;
+            at += reader.feed(stream.data() + at, length, feedParser, &parser);
+        }
+        TEST_ASSERT_EQUAL(forecast.size(), at);
+        TEST_ASSERT_TRUE(reader.keepAlive());
+        TEST_ASSERT_EQUAL(2, parser.finish());
+
+        parser.beginAirQuality(records, 2);
+        reader.begin();
+        while (!reader.done() && at < stream.size())
+        {
+            size_t length = stream.size() - at < piece ? stream.size() - at : piece;
+            at += reader.feed(stream.data() + at, length, feedParser, &parser);
+        }
+        TEST_ASSERT_EQUAL(stream.size(), at);
+        TEST_ASSERT_EQUAL(2, parser.finish());
+
+        // Forecast values survive the air-quality pass
+        TEST_ASSERT_EQUAL(412, records[0].currentTemp);
+        TEST_ASSERT_EQUAL(15, records[1].hourly[0].hour);
+        TEST_ASSERT_EQUAL(530, records[1].daily[3].tempHigh);
+
+        TEST_ASSERT_EQUAL(1, records[0].hasAirQuality);
+        TEST_ASSERT_EQUAL(42, records[0].usAqi);
+        TEST_ASSERT_EQUAL(83, records[0].pm25Tenths);
+        TEST_ASSERT_EQUAL(0, records[1].hasAirQuality); // us_aqi null: no AQI line
+        TEST_ASSERT_EQUAL(610, records[1].pm25Tenths);
+    }
+}
+
+void test_request_formatting()
+{
+    char host[64];
+    uint16_t port;
+    bool secure;
+    const char *path = HttpRequest::splitUrl("https://api.open-meteo.com/v1/forecast", host, sizeof(host), port, secure);
+    TEST_ASSERT_EQUAL_STRING("/v1/forecast", path);
+    TEST_ASSERT_EQUAL_STRING("api.open-meteo.com", host);
+    TEST_ASSERT_EQUAL(443, port);
+    TEST_ASSERT_TRUE(secure);
+
+    path = HttpRequest::splitUrl("http://192.168.5.10:8090", host, sizeof(host), port, secure);
+    TEST_ASSERT_EQUAL_STRING("/", path);
+    TEST_ASSERT_EQUAL_STRING("192.168.5.10", host);
+    TEST_ASSERT_EQUAL(8090, port);
+    TEST_ASSERT_FALSE(secure);
+
+    TEST_ASSERT_NULL(HttpRequest::splitUrl("ftp://example.com/", host, sizeof(host), port, secure));
+    TEST_ASSERT_NULL(HttpRequest::splitUrl("https:///path", host, sizeof(host), port, secure));
+    TEST_ASSERT_NULL(HttpRequest::splitUrl("https://example.com/", host, 5, port, secure));
+
+    char request[256];
+    size_t length = HttpRequest::formatGet(request, sizeof(request), "api.open-meteo.com", "/v1/forecast",
+                                           "?latitude=1", "\"f1\"", "");
+    TEST_ASSERT_EQUAL(strlen(request), length);
+    TEST_ASSERT_EQUAL_STRING("GET /v1/forecast?latitude=1 HTTP/1.1\r\n"
+                             "Host: api.open-meteo.com\r\n"
+                             "Connection: keep-alive\r\n"
+                             "Accept-Encoding: identity\r\n"
+                             "If-None-Match: \"f1\"\r\n"
+                             "\r\n",
+                             request);
+    TEST_ASSERT_EQUAL(0, HttpRequest::formatGet(request, 40, "api.open-meteo.com", "/v1/forecast", nullptr, nullptr,
+                                                nullptr));
+
+    length = HttpRequest::formatPost(request, sizeof(request), "192.168.5.10", "/telemetry",
+                                     "application/octet-stream", 123);
+    TEST_ASSERT_EQUAL(strlen(request), length);
+    TEST_ASSERT_EQUAL_STRING("POST /telemetry HTTP/1.1\r\n"
+                             "Host: 192.168.5.10\r\n"
+                             "Connection: keep-alive\r\n"
+                             "Content-Type: application/octet-stream\r\n"
+                             "Content-Length: 123\r\n"
+                             "\r\n",
+                             request);
+    TEST_ASSERT_EQUAL(0, HttpRequest::formatPost(request, 60, "192.168.5.10", "/telemetry", "text/plain", 1));
+}
+
+void test_air_quality_cost()
+{
+    // What the extra pane adds to a weather wake: bytes on the wire and round trips
+    char request[512];
+    std::string forecastResponse = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nTransfer-Encoding: chunked\r\n\r\n" +
+                                   chunked(forecastBody(), 1400);
+    std::string airResponse = withLength("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n", airQualityBody());
+    size_t forecastBytes =
+        HttpRequest::formatGet(request, sizeof(request), "api.open-meteo.com", "/v1/forecast",
+                               "?latitude=45.5152,47.6062&longitude=-122.6784,-122.3321&current=temperature_2m,"
+                               "relative_humidity_2m,weather_code&hourly=temperature_2m,weather_code&daily="
+                               "temperature_2m_max,temperature_2m_min,weather_code&temperature_unit=fahrenheit"
+                               "&timezone=auto&forecast_days=5",
+                               nullptr, nullptr) +
+        forecastResponse.size();
+    size_t airBytes = HttpRequest::formatGet(request, sizeof(request), "air-quality-api.open-meteo.com",
+                                             "/v1/air-quality",
+                                             "?latitude=45.5152,47.6062&longitude=-122.6784,-122.3321&current=us_aqi,pm2_5",
+                                             nullptr, nullptr) +
+                      airResponse.size();
+
+    char msg[200];
+    snprintf(msg, sizeof(msg), "Forecast %u bytes, air quality +%u bytes (%u%%); pipelined on one host: 0 extra handshakes, 0 extra round trips",
+             (unsigned)forecastBytes, (unsigned)airBytes, (unsigned)(airBytes * 100 / forecastBytes));
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_THAN(forecastBytes / 2, airBytes);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_content_length_response);
+    RUN_TEST(test_chunked_response);
+    RUN_TEST(test_responses_without_body);
+    RUN_TEST(test_connection_close_and_http10);
+    RUN_TEST(test_broken_responses_fail);
+    RUN_TEST(test_pipelined_forecast_and_air_quality);
+    RUN_TEST(test_request_formatting);
+    RUN_TEST(test_air_quality_cost);
+
+    return UNITY_END();
+}
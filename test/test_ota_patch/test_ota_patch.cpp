@@ -0,0 +1,442 @@
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include "../../src/ota_patch.h"
+#include "../../src/ota_patch.cpp" // Include implementation directly for testing
+#include "../../src/http_stream.h"
+#include "../../src/http_stream.cpp"
+
+typedef std::vector<uint8_t> Image;
+
+const char *MANIFEST_URL = "http://updates.local:8070/ota/manifest";
+const size_t PARTITION_SIZE = 0x140000; // As in partitions.csv
+
+static uint32_t scratch[OTA_PATCH_INDEX_SIZE];
+
+// Stand-in firmware image: random bytes, so nothing in a patch can come from compression
+static Image firmware(size_t size, uint32_t seed)
+{
+    Image image(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        image[i] = (uint8_t)(seed >> 16);
+    }
+    return image;
+}
+
+// The next release: a function grows, another shrinks, constants and pointers change
+static Image nextRelease(const Image &previous)
+{
+    Image next(previous.begin(), previous.begin() + 20000);
+    Image added = firmware(700, 77);
+    next.insert(next.end(), added.begin(), added.end());
+    next.insert(next.end(), previous.begin() + 20000, previous.begin() + 50000);
+    next.insert(next.end(), previous.begin() + 50300, previous.end()); // 300 bytes removed
+    for (size_t at = 4096; at < next.size(); at += 4096)
+    {
+        next[at] ^= 0x5A; // Relocated address
+        next[at + 1] += 4;
+    }
+    return next;
+}
+
+static Image encode(const Image &source, const Image &target)
+{
+    Image patch(target.size() * 2 + 64);
+    size_t length = OtaPatch::encode(source.data(), source.size(), target.data(), target.size(), scratch, patch.data(),
+                                     patch.size());
+    patch.resize(length);
+    return patch;
+}
+
+// Local HTTP stand-in for scripts/ota_server.py: one build per version, patches made on request
+struct UpdateServer
+{
+    std::map<uint32_t, Image> builds;
+    uint32_t latest = 0;
+    bool chunked = false;
+    size_t cutAfter = 0; // Close the connection after this many body bytes (0 = never)
+    int requests = 0;
+
+    void add(uint32_t version, const Image &image)
+    {
+        builds[version] = image;
+        latest = version > latest ? version : latest;
+    }
+
+    std::string respond(int status, const std::string &body)
+    {
+        std::string head = "HTTP/1.1 " + std::to_string(status) + (status == 200 ? " OK" : " Error") + "\r\n";
+        bool cut = cutAfter > 0 && cutAfter < body.size();
+        std::string payload = cut ? body.substr(0, cutAfter) : body;
+        if (chunked)
+        {
+            std::string out = head + "Transfer-Encoding: chunked\r\n\r\n";
+            char size[16];
+            for (size_t at = 0; at < payload.size(); at += 1000)
+            {
+                std::string piece = payload.substr(at, 1000);
+                snprintf(size, sizeof(size), "%zx\r\n", piece.size());
+                out += size + piece + "\r\n";
+            }
+            return cut ? out : out + "0\r\n\r\n";
+        }
+        return head + "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + payload;
+    }
+
+    static uint32_t param(const std::string &path, const char *name)
+    {
+        size_t at = path.find(std::string(name) + "=");
+        return at == std::string::npos ? 0 : (uint32_t)strtoul(path.c_str() + at + strlen(name) + 1, nullptr, 10);
+    }
+
+    // Raw response bytes for a raw request
+    std::string handle(const std::string &request)
+    {
+        requests++;
+        if (request.find("Host: updates.local\r\n") == std::string::npos)
+        {
+            return respond(400, "no host");
+        }
+        std::string path = request.substr(4, request.find(' ', 4) - 4);
+        if (path.compare(0, 13, "/ota/manifest") == 0)
+        {
+            uint32_t running = param(path, "version");
+            if (running >= latest)
+            {
+                return "HTTP/1.1 204 No Content\r\n\r\n";
+            }
+            // The signature is checked by OtaUpdate against the release key, not here
+            char manifest[192];
+            snprintf(manifest, sizeof(manifest),
+                     "version %u\r\npatch /ota/patch?from=%u&to=%u\r\nnotes ignored\r\nsignature 3006020101020101\r\n",
+                     (unsigned)latest, (unsigned)running, (unsigned)latest);
+            return respond(200, manifest);
+        }
+        if (path.compare(0, 10, "/ota/patch") == 0)
+        {
+            uint32_t from = param(path, "from"), to = param(path, "to");
+            if (builds.count(from) == 0 || builds.count(to) == 0)
+            {
+                return respond(404, "no such build");
+            }
+            Image patch = encode(builds[from], builds[to]);
+            return respond(200, std::string(patch.begin(), patch.end()));
+        }
+        return respond(404, "not found");
+    }
+};
+
+// App partitions in RAM: the running one is read for copies, the next one written in order
+struct Partitions
+{
+    Image running;
+    Image next;
+    bool writeFails = false;
+
+    static bool readSource(void *context, uint32_t offset, void *out, size_t length)
+    {
+        Partitions *p = (Partitions *)context;
+        if (offset + length > PARTITION_SIZE)
+        {
+            return false;
+        }
+        // Erased flash after the end of the image
+        for (size_t i = 0; i < length; i++)
+        {
+            ((uint8_t *)out)[i] = offset + i < p->running.size() ? p->running[offset + i] : 0xFF;
+        }
+        return true;
+    }
+
+    static bool writeTarget(void *context, const void *data, size_t length)
+    {
+        Partitions *p = (Partitions *)context;
+        if (p->writeFails || p->next.size() + length > PARTITION_SIZE)
+        {
+            return false;
+        }
+        p->next.insert(p->next.end(), (const uint8_t *)data, (const uint8_t *)data + length);
+        return true;
+    }
+
+    OtaPatchPort port() { return {this, readSource, writeTarget}; }
+};
+
+static void collect(void *context, const char *data, size_t length)
+{
+    ((std::string *)context)->append(data, length);
+}
+
+static void feedApplier(void *context, const char *data, size_t length)
+{
+    ((OtaPatchApplier *)context)->feed((const uint8_t *)data, length);
+}
+
+// One GET through the stand-in, read back in pieces of varying size as off a socket
+static bool get(UpdateServer &server, const char *url, HttpBodySink sink, void *context, int &status)
+{
+    char host[64], request[384];
+    uint16_t port;
+    bool secure;
+    const char *path = HttpRequest::splitUrl(url, host, sizeof(host), port, secure);
+    size_t length = HttpRequest::formatGet(request, sizeof(request), host, path, nullptr, nullptr, nullptr);
+    std::string response = server.handle(std::string(request, length));
+
+    HttpResponseReader reader;
+    reader.begin();
+    size_t at = 0, piece = 1;
+    while (at < response.size() && !reader.done() && !reader.failed())
+    {
+        size_t n = response.size() - at < piece ? response.size() - at : piece;
+        at += reader.feed(response.data() + at, n, sink, context);
+        piece = piece * 3 % 1460 + 1;
+    }
+    if (!reader.done())
+    {
+        reader.closed();
+    }
+    status = reader.status();
+    return reader.done();
+}
+
+// The device's weather-wake check: manifest, then the patch streamed into the next partition
+static OtaPatchError checkForUpdate(UpdateServer &server, uint32_t runningVersion, Partitions &partitions,
+                                    OtaPatchApplier &applier, bool &updated)
+{
+    updated = false;
+    char url[192];
+    snprintf(url, sizeof(url), "%s?version=%u", MANIFEST_URL, (unsigned)runningVersion);
+    std::string body;
+    int status;
+    OtaManifest manifest;
+    if (!get(server, url, collect, &body, status) || status != 200 ||
+        !OtaPatch::parseManifest(body.data(), body.size(), manifest) || manifest.version <= runningVersion)
+    {
+        return PATCH_OK; // Nothing to do
+    }
+
+    snprintf(url, sizeof(url), "http://updates.local:8070%s", manifest.patch);
+    applier.begin(partitions.port());
+    bool received = get(server, url, feedApplier, &applier, status) && status == 200;
+    updated = received && applier.finish();
+    return received ? applier.error() : PATCH_INCOMPLETE;
+}
+
+void test_parse_manifest()
+{
+    OtaManifest manifest;
+    const char *text =
+        "version 43\r\npatch /ota/patch?from=42&to=43\r\nsize 2345\r\nchannel beta\r\nsignature 30060201AB0201cd\r\n";
+    TEST_ASSERT_TRUE(OtaPatch::parseManifest(text, strlen(text), manifest));
+    TEST_ASSERT_EQUAL(43, manifest.version);
+    TEST_ASSERT_EQUAL_STRING("/ota/patch?from=42&to=43", manifest.patch);
+    TEST_ASSERT_EQUAL(2345, manifest.patchSize);
+    const uint8_t signature[] = {0x30, 0x06, 0x02, 0x01, 0xAB, 0x02, 0x01, 0xCD};
+    TEST_ASSERT_EQUAL(sizeof(signature), manifest.signatureLength);
+    TEST_ASSERT_EQUAL_MEMORY(signature, manifest.signature, sizeof(signature));
+
+    text = "signature 00\nversion 7\npatch https://cdn.example.com/p/6-7.bin";
+    TEST_ASSERT_TRUE(OtaPatch::parseManifest(text, strlen(text), manifest));
+    TEST_ASSERT_EQUAL_STRING("https://cdn.example.com/p/6-7.bin", manifest.patch);
+    TEST_ASSERT_EQUAL(0, manifest.patchSize);
+
+    text = "version 7\nsignature 00\n";
+    TEST_ASSERT_FALSE(OtaPatch::parseManifest(text, strlen(text), manifest));
+    text = "patch /p\nversion x\nsignature 00\n";
+    TEST_ASSERT_FALSE(OtaPatch::parseManifest(text, strlen(text), manifest));
+    std::string longPath = "version 2\npatch /" + std::string(200, 'a') + "\nsignature 00\n";
+    TEST_ASSERT_FALSE(OtaPatch::parseManifest(longPath.data(), longPath.size(), manifest));
+
+    // Unsigned, or a signature that isn't whole hex bytes or is too long: not an update
+    text = "version 7\npatch /p\n";
+    TEST_ASSERT_FALSE(OtaPatch::parseManifest(text, strlen(text), manifest));
+    text = "version 7\npatch /p\nsignature 3006020\n";
+    TEST_ASSERT_FALSE(OtaPatch::parseManifest(text, strlen(text), manifest));
+    text = "version 7\npatch /p\nsignature 30g6\n";
+    TEST_ASSERT_FALSE(OtaPatch::parseManifest(text, strlen(text), manifest));
+    std::string longSignature = "version 7\npatch /p\nsignature " + std::string(2 * OTA_SIGNATURE_MAX + 2, 'a');
+    TEST_ASSERT_FALSE(OtaPatch::parseManifest(longSignature.data(), longSignature.size(), manifest));
+}
+
+void test_up_to_date_device_asks_once()
+{
+    UpdateServer server;
+    server.add(42, firmware(60000, 1));
+    Partitions partitions = {server.builds[42], Image(), false};
+    OtaPatchApplier applier;
+    bool updated;
+    TEST_ASSERT_EQUAL(PATCH_OK, checkForUpdate(server, 42, partitions, applier, updated));
+    TEST_ASSERT_FALSE(updated);
+    TEST_ASSERT_EQUAL(1, server.requests); // Just the manifest
+    TEST_ASSERT_EQUAL(0, partitions.next.size());
+}
+
+void test_delta_update_over_http()
+{
+    UpdateServer server;
+    server.add(42, firmware(200000, 1));
+    server.add(43, nextRelease(server.builds[42]));
+    Image patch = encode(server.builds[42], server.builds[43]);
+
+    for (int framing = 0; framing < 2; framing++)
+    {
+        server.chunked = framing == 1;
+        Partitions partitions = {server.builds[42], Image(), false};
+        OtaPatchApplier applier;
+        bool updated;
+        TEST_ASSERT_EQUAL(PATCH_OK, checkForUpdate(server, 42, partitions, applier, updated));
+        TEST_ASSERT_TRUE(updated);
+        TEST_ASSERT_TRUE(partitions.next == server.builds[43]);
+        TEST_ASSERT_EQUAL(server.builds[43].size(), applier.targetWritten());
+    }
+
+    // The delta is a small fraction of the image
+    TEST_ASSERT_TRUE(patch.size() * 20 < server.builds[43].size());
+    char message[120];
+    snprintf(message, sizeof(message), "Image %u bytes, patch %u bytes (%.1f%%)", (unsigned)server.builds[43].size(),
+             (unsigned)patch.size(), 100.0 * patch.size() / server.builds[43].size());
+    TEST_MESSAGE(message);
+}
+
+void test_patch_for_another_build_writes_nothing()
+{
+    UpdateServer server;
+    server.add(41, firmware(60000, 9));
+    server.add(42, firmware(60000, 1));
+    server.add(43, nextRelease(server.builds[42]));
+
+    // Says it runs 42, actually runs 41
+    Partitions partitions = {server.builds[41], Image(), false};
+    OtaPatchApplier applier;
+    bool updated;
+    TEST_ASSERT_EQUAL(PATCH_WRONG_SOURCE, checkForUpdate(server, 42, partitions, applier, updated));
+    TEST_ASSERT_FALSE(updated);
+    TEST_ASSERT_EQUAL(0, partitions.next.size());
+
+    // And a server without the running build answers 404, which never reaches the applier
+    partitions.next.clear();
+    TEST_ASSERT_EQUAL(PATCH_INCOMPLETE, checkForUpdate(server, 40, partitions, applier, updated));
+    TEST_ASSERT_EQUAL(0, partitions.next.size());
+}
+
+void test_interrupted_download_is_not_applied()
+{
+    UpdateServer server;
+    server.add(42, firmware(60000, 1));
+    server.add(43, nextRelease(server.builds[42]));
+    Image patch = encode(server.builds[42], server.builds[43]);
+
+    for (int framing = 0; framing < 2; framing++)
+    {
+        server.chunked = framing == 1;
+        server.cutAfter = patch.size() / 2;
+        Partitions partitions = {server.builds[42], Image(), false};
+        OtaPatchApplier applier;
+        bool updated;
+        TEST_ASSERT_EQUAL(PATCH_INCOMPLETE, checkForUpdate(server, 42, partitions, applier, updated));
+        TEST_ASSERT_FALSE(updated);
+        TEST_ASSERT_FALSE(applier.finish());
+        TEST_ASSERT_EQUAL(PATCH_INCOMPLETE, applier.error());
+    }
+}
+
+void test_damaged_patch_is_caught()
+{
+    Image source = firmware(60000, 1);
+    Image target = nextRelease(source);
+    Image patch = encode(source, target);
+
+    // Flip each byte after the header in turn (sampled): never a silently wrong image
+    int caught = 0, tried = 0;
+    for (size_t at = OTA_PATCH_HEADER_SIZE; at < patch.size(); at += 7)
+    {
+        Image damaged = patch;
+        damaged[at] ^= 0x10;
+        Partitions partitions = {source, Image(), false};
+        OtaPatchApplier applier;
+        applier.begin(partitions.port());
+        applier.feed(damaged.data(), damaged.size());
+        bool ok = applier.finish();
+        tried++;
+        caught += !ok;
+        TEST_ASSERT_TRUE(!ok || partitions.next == target);
+    }
+    TEST_ASSERT_EQUAL(tried, caught);
+
+    // A damaged header field
+    Image damaged = patch;
+    damaged[2] = OTA_PATCH_VERSION + 1;
+    Partitions partitions = {source, Image(), false};
+    OtaPatchApplier applier;
+    applier.begin(partitions.port());
+    TEST_ASSERT_FALSE(applier.feed(damaged.data(), damaged.size()));
+    TEST_ASSERT_EQUAL(PATCH_BAD_HEADER, applier.error());
+
+    // Bytes after the last op
+    damaged = patch;
+    damaged.push_back(0);
+    applier.begin(partitions.port());
+    TEST_ASSERT_FALSE(applier.feed(damaged.data(), damaged.size()));
+    TEST_ASSERT_EQUAL(PATCH_CORRUPT, applier.error());
+}
+
+void test_flash_write_failure()
+{
+    Image source = firmware(60000, 1);
+    Image patch = encode(source, nextRelease(source));
+    Partitions partitions = {source, Image(), false};
+    partitions.writeFails = true;
+    OtaPatchApplier applier;
+    applier.begin(partitions.port());
+    TEST_ASSERT_FALSE(applier.feed(patch.data(), patch.size()));
+    TEST_ASSERT_EQUAL(PATCH_IO_ERROR, applier.error());
+    TEST_ASSERT_FALSE(applier.finish());
+}
+
+void test_encoder_edge_cases()
+{
+    // Same image: one copy
+    Image source = firmware(50000, 3);
+    Image patch = encode(source, source);
+    TEST_ASSERT_TRUE(patch.size() < OTA_PATCH_HEADER_SIZE + 8);
+
+    // Nothing in common, or no source at all: all literal, still applies
+    Image unrelated = firmware(5000, 4);
+    for (int empty = 0; empty < 2; empty++)
+    {
+        Image base = empty ? Image() : source;
+        patch = encode(base, unrelated);
+        TEST_ASSERT_TRUE(patch.size() > unrelated.size());
+        Partitions partitions = {base, Image(), false};
+        OtaPatchApplier applier;
+        applier.begin(partitions.port());
+        applier.feed(patch.data(), patch.size());
+        TEST_ASSERT_TRUE(applier.finish());
+        TEST_ASSERT_TRUE(partitions.next == unrelated);
+        TEST_ASSERT_EQUAL(0, applier.copiedBytes());
+    }
+
+    // Too small an output buffer
+    uint8_t small[100];
+    TEST_ASSERT_EQUAL(0, OtaPatch::encode(source.data(), source.size(), unrelated.data(), unrelated.size(), scratch,
+                                          small, sizeof(small)));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_parse_manifest);
+    RUN_TEST(test_up_to_date_device_asks_once);
+    RUN_TEST(test_delta_update_over_http);
+    RUN_TEST(test_patch_for_another_build_writes_nothing);
+    RUN_TEST(test_interrupted_download_is_not_applied);
+    RUN_TEST(test_damaged_patch_is_caught);
+    RUN_TEST(test_flash_write_failure);
+    RUN_TEST(test_encoder_edge_cases);
+    return UNITY_END();
+}
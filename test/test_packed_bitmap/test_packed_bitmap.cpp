@@ -0,0 +1,296 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "../../src/packed_bitmap.h"
+#include "../../src/packed_bitmap.cpp" // Include implementation directly for testing
+#include "../../src/digit_bitmaps.cpp"
+#include "../../src/weather_bitmaps.cpp"
+
+const int PANEL_WIDTH = 800;
+const int PANEL_HEIGHT = 480;
+
+// FNV-1a of the raw arrays the generators emitted before compression, in table order
+const uint32_t GOLDEN_DIGITS = 0x2ce125f4;
+const uint32_t GOLDEN_ICONS = 0xb64a0a62;
+
+static const PackedBitmap *const DIGITS[] = {&DIGIT_0_BITMAP, &DIGIT_1_BITMAP, &DIGIT_2_BITMAP, &DIGIT_3_BITMAP,
+                                             &DIGIT_4_BITMAP, &DIGIT_5_BITMAP, &DIGIT_6_BITMAP, &DIGIT_7_BITMAP,
+                                             &DIGIT_8_BITMAP, &DIGIT_9_BITMAP, &COLON_BITMAP,   &DEGREE_BITMAP};
+static const PackedBitmap *const ICONS[] = {&cloud_bolt_rain_40x40, &cloud_fog_40x40,  &cloud_40x40,
+                                            &cloud_rain_40x40,      &cloud_snow_40x40, &sun_max_40x40};
+const int DIGIT_COUNT = sizeof(DIGITS) / sizeof(DIGITS[0]);
+const int ICON_COUNT = sizeof(ICONS) / sizeof(ICONS[0]);
+
+static uint32_t fnv(const uint8_t *data, size_t length, uint32_t hash = 2166136261u)
+{
+    for (size_t i = 0; i < length; i++)
+        hash = (hash ^ data[i]) * 16777619u;
+    return hash;
+}
+
+// Plain PackBits decoder, independent of the blitter
+static std::vector<uint8_t> unpack(const PackedBitmap &bitmap)
+{
+    std::vector<uint8_t> out;
+    for (size_t i = 0; i < bitmap.length;)
+    {
+        int8_t header = (int8_t)bitmap.data[i++];
+        if (header >= 0)
+        {
+            out.insert(out.end(), bitmap.data + i, bitmap.data + i + header + 1);
+            i += header + 1;
+        }
+        else if (header != -128)
+        {
+            out.insert(out.end(), 1 - header, bitmap.data[i++]);
+        }
+    }
+    return out;
+}
+
+// Reference: the raw-bitmap loops DisplayManager used before, feeding GxEPD2_BW::drawPixel
+struct ReferencePanel
+{
+    RasterTarget target;
+
+    __attribute__((noinline)) void drawPixel(int16_t x, int16_t y)
+    {
+        if (x < 0 || x >= PANEL_WIDTH || y < 0 || y >= PANEL_HEIGHT)
+            return;
+        x -= target.windowX;
+        y -= target.windowY;
+        if (x < 0 || x >= (int16_t)target.windowWidth || y < 0 || y >= (int16_t)target.windowHeight)
+            return;
+        y -= target.pageTop;
+        if (y < 0 || y >= (int16_t)target.pageHeight)
+            return;
+        uint16_t i = x / 8 + y * (target.windowWidth / 8);
+        target.buffer[i] = (target.buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
+    }
+
+    void drawBitmap(int x, int y, const uint8_t *bits, int width, int height)
+    {
+        int bytesPerRow = (width + 7) / 8;
+        for (int row = 0; row < height; row++)
+        {
+            for (int col = 0; col < bytesPerRow; col++)
+            {
+                uint8_t b = bits[row * bytesPerRow + col];
+                for (int bit = 0; bit < 8; bit++)
+                {
+                    if ((b & (0x80 >> bit)) != 0)
+                        drawPixel(x + col * 8 + bit, y + row);
+                }
+            }
+        }
+    }
+};
+
+struct Scene
+{
+    int16_t windowX, windowY;
+    uint16_t windowWidth, windowHeight;
+    uint16_t pageTop, pageHeight;
+};
+
+struct Placement
+{
+    const PackedBitmap *bitmap;
+    int16_t x, y;
+};
+
+static void assertSameRender(const Scene &scene, const Placement *placements, int count)
+{
+    size_t size = (size_t)(scene.windowWidth / 8) * scene.pageHeight;
+    std::vector<uint8_t> blit(size, 0xFF), pixels(size, 0xFF);
+    RasterTarget target = {blit.data(), scene.windowX, scene.windowY, scene.windowWidth, scene.windowHeight,
+                           scene.pageTop, scene.pageHeight, PANEL_WIDTH, PANEL_HEIGHT};
+    ReferencePanel reference = {target};
+    reference.target.buffer = pixels.data();
+
+    for (int i = 0; i < count; i++)
+    {
+        const Placement &p = placements[i];
+        TEST_ASSERT_TRUE(PackedBlit::draw(target, *p.bitmap, p.x, p.y));
+        std::vector<uint8_t> raw = unpack(*p.bitmap);
+        reference.drawBitmap(p.x, p.y, raw.data(), p.bitmap->width, p.bitmap->height);
+    }
+    for (size_t i = 0; i < size; i++)
+    {
+        if (blit[i] != pixels[i])
+        {
+            printf("  first difference at byte %zu: %02x vs %02x\n", i, blit[i], pixels[i]);
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL_MEMORY(pixels.data(), blit.data(), size);
+}
+
+void test_assets_decode_to_generated_bitmaps()
+{
+    uint32_t digits = 2166136261u;
+    for (int i = 0; i < DIGIT_COUNT; i++)
+    {
+        std::vector<uint8_t> raw = unpack(*DIGITS[i]);
+        TEST_ASSERT_EQUAL(DIGIT_WIDTH, DIGITS[i]->width);
+        TEST_ASSERT_EQUAL(DIGIT_HEIGHT, DIGITS[i]->height);
+        TEST_ASSERT_EQUAL((DIGIT_WIDTH + 7) / 8 * DIGIT_HEIGHT, raw.size());
+        digits = fnv(raw.data(), raw.size(), digits);
+    }
+    TEST_ASSERT_EQUAL_HEX32(GOLDEN_DIGITS, digits);
+
+    uint32_t icons = 2166136261u;
+    for (int i = 0; i < ICON_COUNT; i++)
+    {
+        std::vector<uint8_t> raw = unpack(*ICONS[i]);
+        TEST_ASSERT_EQUAL(40 * 40 / 8, raw.size());
+        icons = fnv(raw.data(), raw.size(), icons);
+    }
+    TEST_ASSERT_EQUAL_HEX32(GOLDEN_ICONS, icons);
+
+    // Lookup keeps the UTF-8 degree byte and the fallback to 0
+    TEST_ASSERT_EQUAL_PTR(&DEGREE_BITMAP, &getDigitBitmap((char)0xB0));
+    TEST_ASSERT_EQUAL_PTR(&COLON_BITMAP, &getDigitBitmap(':'));
+    TEST_ASSERT_EQUAL_PTR(&DIGIT_0_BITMAP, &getDigitBitmap('x'));
+}
+
+void test_screen_positions_match_draw_pixel()
+{
+    // Clock digits, current temp, hourly and daily icons as the panel draws them, in the
+    // windows the panel refreshes them with
+    const Placement clock[] = {{&DIGIT_1_BITMAP, 30, 80}, {&DIGIT_2_BITMAP, 100, 80}, {&COLON_BITMAP, 170, 80},
+                               {&DIGIT_5_BITMAP, 240, 80}, {&DIGIT_9_BITMAP, 310, 80}};
+    const Placement pane[] = {{&DIGIT_4_BITMAP, 530, 60},        {&DIGIT_7_BITMAP, 600, 60},
+                              {&DEGREE_BITMAP, 670, 60},         {&sun_max_40x40, 417, 250},
+                              {&cloud_40x40, 497, 250},          {&cloud_rain_40x40, 577, 250},
+                              {&cloud_snow_40x40, 657, 250},     {&cloud_fog_40x40, 737, 250},
+                              {&cloud_bolt_rain_40x40, 421, 400}, {&sun_max_40x40, 521, 400}};
+    const Scene full = {0, 0, PANEL_WIDTH, PANEL_HEIGHT, 0, PANEL_HEIGHT};
+    const Scene time = {0, 80, 400, 144, 0, 144};
+    const Scene weather = {400, 0, 400, 480, 0, 480};
+    const Scene cell = {488, 240, 80, 80, 0, 80};
+    assertSameRender(full, clock, 5);
+    assertSameRender(time, clock, 5);
+    assertSameRender(weather, pane, 10);
+    assertSameRender(cell, pane, 10);
+}
+
+void test_clipping_matches_draw_pixel()
+{
+    // Every byte alignment against windows, pages and the panel edges on all sides
+    const Scene scenes[] = {
+        {0, 0, 800, 480, 0, 480},    {400, 24, 160, 400, 64, 48}, {792, 0, 8, 480, 0, 480},
+        {0, 0, 800, 480, 120, 120},  {96, 100, 200, 60, 0, 60},   {0, 400, 200, 80, 0, 80},
+    };
+    uint32_t seed = 7;
+    std::vector<Placement> placements;
+    for (int n = 0; n < 600; n++)
+    {
+        seed = seed * 1103515245 + 12345;
+        const PackedBitmap *bitmap = n % 2 ? DIGITS[(seed >> 16) % DIGIT_COUNT] : ICONS[(seed >> 16) % ICON_COUNT];
+        int16_t x = (int16_t)((int)((seed >> 4) % 900) - 80);
+        seed = seed * 1103515245 + 12345;
+        int16_t y = (int16_t)((int)((seed >> 4) % 620) - 120);
+        placements.push_back({bitmap, x, y});
+    }
+    for (const Scene &scene : scenes)
+    {
+        for (int start = 0; start < 600; start += 20)
+        {
+            assertSameRender(scene, placements.data() + start, 20);
+        }
+    }
+}
+
+void test_truncated_data_is_reported()
+{
+    uint8_t buffer[400 / 8 * 144];
+    memset(buffer, 0xFF, sizeof(buffer));
+    RasterTarget target = {buffer, 0, 80, 400, 144, 0, 144, PANEL_WIDTH, PANEL_HEIGHT};
+
+    PackedBitmap cut = DIGIT_8_BITMAP;
+    cut.length = DIGIT_8_BITMAP.length / 2;
+    TEST_ASSERT_FALSE(PackedBlit::draw(target, cut, 30, 80));
+    cut.length = 0;
+    TEST_ASSERT_FALSE(PackedBlit::draw(target, cut, 30, 80));
+
+    // A repeat header as the last byte
+    const uint8_t dangling[] = {0x01, 0xFF, 0x00, 0xFE};
+    PackedBitmap broken = {dangling, sizeof(dangling), 16, 2};
+    TEST_ASSERT_FALSE(PackedBlit::draw(target, broken, 0, 80));
+    TEST_ASSERT_TRUE(PackedBlit::draw(target, DIGIT_8_BITMAP, 30, 80));
+}
+
+void test_flash_and_time_against_raw()
+{
+    size_t raw = 0, packed = 0;
+    for (int i = 0; i < DIGIT_COUNT; i++)
+    {
+        raw += (DIGITS[i]->width + 7) / 8 * DIGITS[i]->height;
+        packed += DIGITS[i]->length;
+    }
+    size_t iconRaw = 0, iconPacked = 0;
+    for (int i = 0; i < ICON_COUNT; i++)
+    {
+        iconRaw += (ICONS[i]->width + 7) / 8 * ICONS[i]->height;
+        iconPacked += ICONS[i]->length;
+    }
+
+    // A clock update ("12:59") and a full weather pane (3 digits, 9 icons), raw vs packed
+    const Placement frame[] = {{&DIGIT_1_BITMAP, 30, 80},    {&DIGIT_2_BITMAP, 100, 80},  {&COLON_BITMAP, 170, 80},
+                               {&DIGIT_5_BITMAP, 240, 80},   {&DIGIT_9_BITMAP, 310, 80},  {&DIGIT_4_BITMAP, 530, 60},
+                               {&DIGIT_7_BITMAP, 600, 60},   {&DEGREE_BITMAP, 670, 60},   {&sun_max_40x40, 417, 250},
+                               {&cloud_40x40, 497, 250},     {&cloud_rain_40x40, 577, 250}, {&cloud_snow_40x40, 657, 250},
+                               {&cloud_fog_40x40, 737, 250}, {&cloud_bolt_rain_40x40, 421, 400},
+                               {&sun_max_40x40, 521, 400},   {&cloud_40x40, 621, 400},    {&cloud_rain_40x40, 721, 400}};
+    const int count = sizeof(frame) / sizeof(frame[0]);
+    std::vector<std::vector<uint8_t>> rawBits;
+    for (int i = 0; i < count; i++)
+        rawBits.push_back(unpack(*frame[i].bitmap));
+
+    std::vector<uint8_t> buffer(PANEL_WIDTH / 8 * PANEL_HEIGHT, 0xFF);
+    RasterTarget target = {buffer.data(), 0, 0, PANEL_WIDTH, PANEL_HEIGHT, 0, PANEL_HEIGHT, PANEL_WIDTH, PANEL_HEIGHT};
+    ReferencePanel reference = {target};
+    const int runs = 2000;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++)
+    {
+        for (int i = 0; i < count; i++)
+            reference.drawBitmap(frame[i].x, frame[i].y, rawBits[i].data(), frame[i].bitmap->width,
+                                 frame[i].bitmap->height);
+    }
+    double pixelUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++)
+    {
+        for (int i = 0; i < count; i++)
+            PackedBlit::draw(target, *frame[i].bitmap, frame[i].x, frame[i].y);
+    }
+    double blitUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    char msg[200];
+    snprintf(msg, sizeof(msg), "Digits %zu -> %zu bytes, icons %zu -> %zu bytes of flash", raw, packed, iconRaw,
+             iconPacked);
+    TEST_MESSAGE(msg);
+    snprintf(msg, sizeof(msg), "%d bitmaps: raw per-pixel %.2f us, packed blit %.2f us on host (%.1fx)", count, pixelUs,
+             blitUs, pixelUs / blitUs);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(packed < raw);
+    TEST_ASSERT_TRUE(iconPacked < iconRaw);
+    TEST_ASSERT_TRUE(blitUs < pixelUs);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_assets_decode_to_generated_bitmaps);
+    RUN_TEST(test_screen_positions_match_draw_pixel);
+    RUN_TEST(test_clipping_matches_draw_pixel);
+    RUN_TEST(test_truncated_data_is_reported);
+    RUN_TEST(test_flash_and_time_against_raw);
+    return UNITY_END();
+}
@@ -0,0 +1,258 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "../../src/text_raster.h"
+#include "../../src/text_raster.cpp" // Include implementation directly for testing
+#include "../../src/text_layout.cpp"
+#include "../../src/packed_bitmap.cpp"
+#include "../../src/digit_bitmaps.h"
+#include "../../src/digit_bitmaps.cpp"
+#include "../../src/weather_bitmaps.h"
+#include "../../src/weather_bitmaps.cpp"
+
+const int PANEL_WIDTH = 800;
+const int PANEL_HEIGHT = 480;
+const int ROW_BYTES = PANEL_WIDTH / 8;
+const int PAGE_ROWS[] = {480, 240, 160, 120, 80, 48, 16};
+const int PAGE_OPTIONS = sizeof(PAGE_ROWS) / sizeof(PAGE_ROWS[0]);
+
+// Printable ASCII with metrics like FreeSansBold12pt7b (yAdvance 29, ascent about 17)
+static GFXglyph glyphs[0x7E - 0x20 + 1];
+static std::vector<uint8_t> bitmap;
+static GFXfont font;
+
+static void buildFont()
+{
+    for (int c = 0x20; c <= 0x7E; c++)
+    {
+        GFXglyph &g = glyphs[c - 0x20];
+        g.width = c == ' ' ? 0 : (uint8_t)(6 + c % 9);
+        g.height = c == ' ' ? 0 : (uint8_t)(12 + c % 6);
+        g.xAdvance = (uint8_t)(g.width + 2);
+        g.xOffset = 1;
+        g.yOffset = (int8_t)(-(int)g.height + (c % 7 == 0 ? 5 : 0)); // Some descenders
+        g.bitmapOffset = (uint16_t)bitmap.size();
+        int bits = g.width * g.height;
+        for (int i = 0; i < (bits + 7) / 8; i++)
+        {
+            bitmap.push_back((uint8_t)(0xE7 ^ (c * 13 + i * 7)));
+        }
+    }
+    font = {bitmap.data(), glyphs, 0x20, 0x7E, 29};
+}
+
+// What the panel draws on a combined clock and weather refresh, in DisplayClock /
+// DisplayWeather positions: bitmap digits, centred labels, icons and the small stamps
+struct Item
+{
+    enum Kind
+    {
+        TEXT,
+        DIGITS,
+        ICON
+    } kind;
+    int16_t x, y;
+    const char *text;
+    const PackedBitmap *icon;
+};
+
+static std::vector<Item> scene()
+{
+    std::vector<Item> items;
+    items.push_back({Item::DIGITS, 30, 80, "12:34", nullptr});
+    items.push_back({Item::TEXT, 130, 250, "Thursday", nullptr});
+    items.push_back({Item::TEXT, 110, 300, "Jan 1, 2026", nullptr});
+    items.push_back({Item::TEXT, 60, 345, "Sun 7:51-16:37 (8h 46m)", nullptr});
+    items.push_back({Item::TEXT, 10, 460, "Battery: 88%", nullptr});
+    items.push_back({Item::DIGITS, 530, 30, "41\xC2\xB0", nullptr});
+    items.push_back({Item::TEXT, 460, 160, "AQI 42 Good   PM2.5 8", nullptr});
+    static const char *hours[] = {"3p", "4p", "5p", "6p", "7p"};
+    static const char *temps[] = {"41\xC2\xB0", "40\xC2\xB0", "38\xC2\xB0", "37\xC2\xB0", "36\xC2\xB0"};
+    static const PackedBitmap *icons[] = {&sun_max_40x40, &cloud_40x40, &cloud_rain_40x40, &cloud_snow_40x40,
+                                          &cloud_fog_40x40};
+    for (int i = 0; i < 5; i++)
+    {
+        int16_t x = (int16_t)(400 + 40 + i * 80);
+        items.push_back({Item::TEXT, (int16_t)(x - 10), 190, hours[i], nullptr});
+        items.push_back({Item::ICON, (int16_t)(x - 20), 200, nullptr, icons[i]});
+        items.push_back({Item::TEXT, (int16_t)(x - 14), 260, temps[i], nullptr});
+    }
+    static const char *days[] = {"Fri", "Sat", "Sun", "Mon"};
+    static const char *highLow[] = {"47/32\xC2\xB0", "48/33\xC2\xB0", "45/30\xC2\xB0", "44/29\xC2\xB0"};
+    for (int i = 0; i < 4; i++)
+    {
+        int16_t x = (int16_t)(400 + 50 + i * 100);
+        items.push_back({Item::TEXT, (int16_t)(x - 16), 310, days[i], nullptr});
+        items.push_back({Item::ICON, (int16_t)(x - 20), 320, nullptr, &cloud_bolt_rain_40x40});
+        items.push_back({Item::TEXT, (int16_t)(x - 30), 380, highLow[i], nullptr});
+    }
+    items.push_back({Item::TEXT, 670, 460, "Jan 01 14:30", nullptr});
+    return items;
+}
+
+static int16_t fontTop, fontBottom;
+
+// One draw call the way DisplayManager makes it, skipped up front when cull is set and the
+// item lies in another band
+static void drawItem(const RasterTarget &target, const Item &item, bool cull)
+{
+    if (item.kind == Item::TEXT)
+    {
+        if (cull && !TextRaster::rowsInPage(target, item.y + fontTop, fontBottom - fontTop))
+            return;
+        TextRaster::drawText(target, &font, item.x, item.y, item.text, true);
+    }
+    else if (item.kind == Item::ICON)
+    {
+        if (cull && !TextRaster::rowsInPage(target, item.y, item.icon->height))
+            return;
+        PackedBlit::draw(target, *item.icon, item.x, item.y);
+    }
+    else
+    {
+        if (cull && !TextRaster::rowsInPage(target, item.y, DIGIT_HEIGHT))
+            return;
+        int16_t x = item.x;
+        for (const char *c = item.text; *c; c++)
+        {
+            if ((uint8_t)*c == 0xC2)
+                continue;
+            PackedBlit::draw(target, getDigitBitmap(*c), x, item.y);
+            x += DIGIT_WIDTH;
+        }
+    }
+}
+
+// firstPage()/nextPage() over the whole panel with a pageRows buffer; each page is copied
+// out to panel where GxEPD2 would write it to the controller
+static void renderPaged(const std::vector<Item> &items, int pageRows, bool cull, std::vector<uint8_t> &panel)
+{
+    std::vector<uint8_t> buffer((size_t)ROW_BYTES * pageRows);
+    panel.assign((size_t)ROW_BYTES * PANEL_HEIGHT, 0x00);
+    for (int pageTop = 0; pageTop < PANEL_HEIGHT; pageTop += pageRows)
+    {
+        memset(buffer.data(), 0xFF, buffer.size());
+        RasterTarget target = {buffer.data(), 0, 0, PANEL_WIDTH, PANEL_HEIGHT, (uint16_t)pageTop, (uint16_t)pageRows,
+                               PANEL_WIDTH, PANEL_HEIGHT};
+        for (const Item &item : items)
+            drawItem(target, item, cull);
+        int rows = PANEL_HEIGHT - pageTop < pageRows ? PANEL_HEIGHT - pageTop : pageRows;
+        memcpy(panel.data() + (size_t)pageTop * ROW_BYTES, buffer.data(), (size_t)rows * ROW_BYTES);
+    }
+}
+
+void test_rows_in_page()
+{
+    uint8_t buffer[ROW_BYTES];
+    // Window on panel rows 100..399; page 2 of 80-row pages holds window rows 160..239 = panel 260..339
+    RasterTarget target = {buffer, 0, 100, PANEL_WIDTH, 300, 160, 80, PANEL_WIDTH, PANEL_HEIGHT};
+    TEST_ASSERT_FALSE(TextRaster::rowsInPage(target, 200, 60)); // Ends at 259
+    TEST_ASSERT_TRUE(TextRaster::rowsInPage(target, 200, 61));
+    TEST_ASSERT_TRUE(TextRaster::rowsInPage(target, 339, 10));
+    TEST_ASSERT_FALSE(TextRaster::rowsInPage(target, 340, 10));
+    TEST_ASSERT_FALSE(TextRaster::rowsInPage(target, 280, 0));
+    TEST_ASSERT_TRUE(TextRaster::rowsInPage(target, 0, PANEL_HEIGHT));
+
+    // Last page reaching past the window: rows below it are out too
+    target.windowHeight = 200;
+    TEST_ASSERT_TRUE(TextRaster::rowsInPage(target, 299, 1));
+    TEST_ASSERT_FALSE(TextRaster::rowsInPage(target, 300, 20));
+}
+
+void test_font_rows()
+{
+    int16_t top, bottom;
+    TextLayout::fontRows(&font, top, bottom);
+    TEST_ASSERT_EQUAL(-17, top);
+    TEST_ASSERT_EQUAL(5, bottom);
+
+    // Every glyph of every item lies inside them
+    for (const Item &item : scene())
+    {
+        if (item.kind != Item::TEXT)
+            continue;
+        TextExtent extent = TextLayout::measure(&font, item.text);
+        TEST_ASSERT_TRUE(extent.y1 >= top);
+        TEST_ASSERT_TRUE(extent.y1 + extent.h <= bottom);
+    }
+}
+
+void test_every_page_height_draws_the_same_panel()
+{
+    std::vector<Item> items = scene();
+    std::vector<uint8_t> whole, paged;
+    renderPaged(items, PANEL_HEIGHT, false, whole);
+    for (int p = 0; p < PAGE_OPTIONS; p++)
+    {
+        renderPaged(items, PAGE_ROWS[p], true, paged);
+        TEST_ASSERT_EQUAL_MEMORY(whole.data(), paged.data(), whole.size());
+        renderPaged(items, PAGE_ROWS[p], false, paged);
+        TEST_ASSERT_EQUAL_MEMORY(whole.data(), paged.data(), whole.size());
+    }
+
+    // Something was drawn in every band
+    int inked = 0;
+    for (int band = 0; band < PANEL_HEIGHT / 16; band++)
+    {
+        for (int i = band * 16 * ROW_BYTES; i < (band + 1) * 16 * ROW_BYTES; i++)
+        {
+            if (whole[i] != 0xFF)
+            {
+                inked++;
+                break;
+            }
+        }
+    }
+    TEST_ASSERT_TRUE(inked > PANEL_HEIGHT / 16 / 2);
+}
+
+void test_cost_by_page_height()
+{
+    std::vector<Item> items = scene();
+    std::vector<uint8_t> panel;
+    const int runs = 100;
+    double baseUs = 0;
+
+    for (int p = 0; p < PAGE_OPTIONS; p++)
+    {
+        // Best of three interleaved rounds, so a busy host doesn't flip the comparison
+        double us[2] = {1e9, 1e9};
+        for (int round = 0; round < 3; round++)
+        {
+            for (int cull = 0; cull < 2; cull++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                for (int r = 0; r < runs; r++)
+                    renderPaged(items, PAGE_ROWS[p], cull, panel);
+                double t = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+                us[cull] = t / runs < us[cull] ? t / runs : us[cull];
+            }
+        }
+        if (p == 0)
+            baseUs = us[1];
+
+        char msg[160];
+        snprintf(msg, sizeof(msg), "%3d-row pages: %5d byte buffer, %2d pages, %7.1f us culled, %7.1f us without (%.1fx one page)",
+                 PAGE_ROWS[p], ROW_BYTES * PAGE_ROWS[p], (PANEL_HEIGHT + PAGE_ROWS[p] - 1) / PAGE_ROWS[p], us[1], us[0],
+                 us[1] / baseUs);
+        TEST_MESSAGE(msg);
+        if (PAGE_ROWS[p] <= 16)
+        {
+            TEST_ASSERT_TRUE(us[1] < us[0]); // Only clear-cut once most draw calls miss the band
+        }
+    }
+}
+
+int main()
+{
+    buildFont();
+    TextLayout::fontRows(&font, fontTop, fontBottom);
+    UNITY_BEGIN();
+    RUN_TEST(test_rows_in_page);
+    RUN_TEST(test_font_rows);
+    RUN_TEST(test_every_page_height_draws_the_same_panel);
+    RUN_TEST(test_cost_by_page_height);
+    return UNITY_END();
+}
@@ -0,0 +1,163 @@
+#include <unity.h>
+#include <cstring>
+#include <vector>
+#include "../../src/panel_waveform.h"
+#include "../../src/panel_waveform.cpp" // Include implementation directly for testing
+#include "../../src/band_transfer.cpp"
+
+const uint16_t COMMAND = 0x100; // Wire entries: command bytes carry this bit, data bytes don't
+
+// Records the command stream byte for byte; queued band data goes straight onto the wire
+struct MockSpi
+{
+    std::vector<uint16_t> wire;
+
+    static void command(void *context, uint8_t command)
+    {
+        ((MockSpi *)context)->wire.push_back(COMMAND | command);
+    }
+
+    static void data(void *context, const uint8_t *bytes, size_t length)
+    {
+        MockSpi *spi = (MockSpi *)context;
+        spi->wire.insert(spi->wire.end(), bytes, bytes + length);
+    }
+
+    static void waitOldest(void *context)
+    {
+        (void)context;
+    }
+
+    PanelSpi port() { return {this, command, data, data, waitOldest}; }
+};
+
+// Expected stream, written out by hand from the UC8179 command set
+struct Expect
+{
+    std::vector<uint16_t> wire;
+
+    Expect &command(uint8_t c, std::vector<uint16_t> bytes = {})
+    {
+        wire.push_back(COMMAND | c);
+        wire.insert(wire.end(), bytes.begin(), bytes.end());
+        return *this;
+    }
+
+    // One 6-byte group followed by zeros up to the register size
+    Expect &lut(uint8_t c, uint8_t level, uint8_t frames, int size)
+    {
+        std::vector<uint16_t> bytes(size, 0);
+        bytes[0] = level;
+        bytes[1] = frames;
+        bytes[5] = 1;
+        return command(c, bytes);
+    }
+};
+
+static void assertWire(const Expect &expected, const MockSpi &spi)
+{
+    TEST_ASSERT_EQUAL(expected.wire.size(), spi.wire.size());
+    TEST_ASSERT_EQUAL_MEMORY(expected.wire.data(), spi.wire.data(), expected.wire.size() * sizeof(uint16_t));
+}
+
+void test_fast_lut_load_sequence()
+{
+    MockSpi spi;
+    PanelWaveform::loadFast(spi.port(), 10);
+
+    Expect expected;
+    expected.command(PANEL_CMD_PANEL_SETTING, {0x3F})
+        .lut(0x20, 0x00, 10, 60)  // VCOM held
+        .lut(0x21, 0x00, 10, 42)  // White stays white
+        .lut(0x22, 0x80, 10, 60)  // Black to white: phase A at VDL
+        .lut(0x23, 0x40, 10, 60)  // White to black: phase A at VDH
+        .lut(0x24, 0x00, 10, 60); // Black stays black
+    assertWire(expected, spi);
+}
+
+void test_refresh_sequences()
+{
+    // Fast refresh of the clock digits' window (0,80 400x140), as DisplayManager sends it
+    // between the two band passes. The window and refresh framing match GxEPD2_750_T7's
+    // refresh(x, y, w, h) in the release pinned in platformio.ini
+    MockSpi spi;
+    PanelSpi port = spi.port();
+    PanelWaveform::loadFast(port, 10);
+    PanelWaveform::startRefresh(port, 0, 80, 400, 140);
+    PanelWaveform::endRefresh(port);
+
+    MockSpi lutOnly;
+    PanelWaveform::loadFast(lutOnly.port(), 10);
+    Expect expected;
+    expected.wire = lutOnly.wire;
+    expected.command(0x91)
+        .command(0x90, {0x00, 0x00, 0x01, 0x8F, 0x00, 0x50, 0x00, 0xDB, 0x01}) // x 0..399, y 80..219
+        .command(0x12)
+        .command(0x92);
+    assertWire(expected, spi);
+
+    // Cleanup: OTP waveform, same window
+    MockSpi cleanup;
+    PanelWaveform::selectFull(cleanup.port());
+    PanelWaveform::startRefresh(cleanup.port(), 0, 80, 400, 140);
+    PanelWaveform::endRefresh(cleanup.port());
+    Expect full;
+    full.command(PANEL_CMD_PANEL_SETTING, {0x1F})
+        .command(0xE0, {0x00}) // Sensed temperature, not GxEPD2's forced one
+        .command(0x91)
+        .command(0x90, {0x00, 0x00, 0x01, 0x8F, 0x00, 0x50, 0x00, 0xDB, 0x01})
+        .command(0x12)
+        .command(0x92);
+    assertWire(full, cleanup);
+}
+
+void test_page_loop_with_fast_refresh()
+{
+    // Whole clock update: new image in bands, fast refresh, image again into the old RAM
+    static uint8_t a[50 * 60], b[50 * 60];
+    std::vector<uint8_t> image(50 * 140);
+    for (size_t i = 0; i < image.size(); i++)
+        image[i] = (uint8_t)(i * 7);
+
+    MockSpi spi;
+    BandTransfer transfer(a, b, sizeof(a));
+    const uint8_t rams[] = {PANEL_RAM_NEW, PANEL_RAM_OLD};
+    for (uint8_t ram : rams)
+    {
+        transfer.begin(spi.port(), ram, 0, 80, 400, 140);
+        for (int top = 0; top < 140; top += 60)
+        {
+            int rows = 140 - top < 60 ? 140 - top : 60;
+            memcpy(transfer.band(), image.data() + top * 50, rows * 50);
+            transfer.send(rows * 50);
+        }
+        transfer.end();
+        if (ram == PANEL_RAM_NEW)
+        {
+            PanelWaveform::loadFast(spi.port(), 10);
+            PanelWaveform::startRefresh(spi.port(), 0, 80, 400, 140);
+            PanelWaveform::endRefresh(spi.port());
+        }
+    }
+
+    // Commands in order, data skipped
+    std::vector<uint16_t> commands;
+    for (uint16_t w : spi.wire)
+    {
+        if (w & COMMAND)
+            commands.push_back(w & 0xFF);
+    }
+    const uint16_t order[] = {0x91, 0x90, 0x13, 0x92, 0x00, 0x20, 0x21, 0x22, 0x23,
+                              0x24, 0x91, 0x90, 0x12, 0x92, 0x91, 0x90, 0x10, 0x92};
+    TEST_ASSERT_EQUAL(sizeof(order) / sizeof(order[0]), commands.size());
+    TEST_ASSERT_EQUAL_MEMORY(order, commands.data(), sizeof(order));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fast_lut_load_sequence);
+    RUN_TEST(test_refresh_sequences);
+    RUN_TEST(test_page_loop_with_fast_refresh);
+    return UNITY_END();
+}
@@ -0,0 +1,214 @@
+#include <unity.h>
+#include "../../src/power_governor.h"
+#include "../../src/power_governor.cpp" // Include implementation directly for testing
+
+const time_t START = 1767225600; // Jan 1, 2026 00:00:00 UTC
+const int SAMPLE_INTERVAL = 30 * 60;
+const int TARGET_HOURS = 72;
+
+// Synthetic discharge: drain per hour (in percent) for each power level
+struct DischargeCurve
+{
+    float drainPerHour[4];
+};
+
+// Deterministic ADC noise in [-0.5, 0.5] percent
+static float noise(uint32_t &seed)
+{
+    seed = seed * 1103515245u + 12345u;
+    return ((int)((seed >> 16) % 101) - 50) / 100.0f;
+}
+
+// Simulate minute wakes until the battery is empty, return runtime in hours.
+// maxLevel reports the deepest level used before the target (floors near empty don't count)
+static float simulate(const DischargeCurve &curve, int targetHours, int &maxLevel, bool withNoise)
+{
+    PowerGovernorState state;
+    PowerGovernor::reset(state, START);
+
+    float battery = 100.0f;
+    uint32_t seed = 42;
+    maxLevel = POWER_NORMAL;
+    time_t now = START;
+
+    while (battery > 0.0f && now - START < 400 * 3600)
+    {
+        float reading = battery + (withNoise ? noise(seed) : 0.0f);
+        if (reading < 0.0f)
+            reading = 0.0f;
+        PowerGovernor::recordSample(state, now, (int)(reading * 10.0f + 0.5f), SAMPLE_INTERVAL);
+        PowerLevel level = PowerGovernor::update(state, now, targetHours);
+        if (level > maxLevel && now - START < (time_t)targetHours * 3600)
+            maxLevel = level;
+
+        // Advance one minute of wall time at the current level's drain
+        now += 60;
+        battery -= curve.drainPerHour[level] / 60.0f;
+    }
+    return (now - START) / 3600.0f;
+}
+
+void test_policyFor_normal_matches_config()
+{
+    PowerPolicy policy = PowerGovernor::policyFor(POWER_NORMAL);
+    TEST_ASSERT_EQUAL(1, policy.clockIntervalMinutes);
+    TEST_ASSERT_EQUAL(30 * 60, policy.weatherIntervalSeconds);
+}
+
+void test_policyFor_saver_uses_two_minute_clock_and_two_hour_weather()
+{
+    PowerPolicy policy = PowerGovernor::policyFor(POWER_SAVER);
+    TEST_ASSERT_EQUAL(2, policy.clockIntervalMinutes);
+    TEST_ASSERT_EQUAL(2 * 60 * 60, policy.weatherIntervalSeconds);
+}
+
+void test_recordSample_respects_interval()
+{
+    PowerGovernorState state;
+    PowerGovernor::reset(state, START);
+
+    TEST_ASSERT_TRUE(PowerGovernor::recordSample(state, START, 900, SAMPLE_INTERVAL));
+    TEST_ASSERT_FALSE(PowerGovernor::recordSample(state, START + 60, 900, SAMPLE_INTERVAL));
+    TEST_ASSERT_TRUE(PowerGovernor::recordSample(state, START + SAMPLE_INTERVAL, 890, SAMPLE_INTERVAL));
+    TEST_ASSERT_EQUAL(2, state.sampleCount);
+}
+
+void test_dischargeRate_linear()
+{
+    PowerGovernorState state;
+    PowerGovernor::reset(state, START);
+
+    // 2% per hour = 1% per sample
+    for (int i = 0; i < 6; i++)
+    {
+        PowerGovernor::recordSample(state, START + i * SAMPLE_INTERVAL, 900 - i * 10, SAMPLE_INTERVAL);
+    }
+    TEST_ASSERT_INT_WITHIN(1, 20, PowerGovernor::dischargeRateX10(state));
+}
+
+void test_dischargeRate_ring_wraps()
+{
+    PowerGovernorState state;
+    PowerGovernor::reset(state, START);
+
+    for (int i = 0; i < POWER_SAMPLE_COUNT * 3; i++)
+    {
+        PowerGovernor::recordSample(state, START + i * SAMPLE_INTERVAL, 950 - i * 5, SAMPLE_INTERVAL);
+    }
+    TEST_ASSERT_EQUAL(POWER_SAMPLE_COUNT, state.sampleCount);
+    TEST_ASSERT_INT_WITHIN(1, 10, PowerGovernor::dischargeRateX10(state));
+}
+
+void test_holds_level_without_enough_trend()
+{
+    PowerGovernorState state;
+    PowerGovernor::reset(state, START);
+
+    // Steep drop but only two samples - not enough to act on
+    PowerGovernor::recordSample(state, START, 900, SAMPLE_INTERVAL);
+    PowerGovernor::recordSample(state, START + SAMPLE_INTERVAL, 800, SAMPLE_INTERVAL);
+    TEST_ASSERT_EQUAL(POWER_NORMAL, PowerGovernor::update(state, START + SAMPLE_INTERVAL, TARGET_HOURS));
+}
+
+void test_low_battery_floor()
+{
+    PowerGovernorState state;
+    PowerGovernor::reset(state, START);
+
+    PowerGovernor::recordSample(state, START, 80, SAMPLE_INTERVAL);
+    TEST_ASSERT_EQUAL(POWER_SAVER, PowerGovernor::update(state, START, TARGET_HOURS));
+
+    PowerGovernor::recordSample(state, START + SAMPLE_INTERVAL, 40, SAMPLE_INTERVAL);
+    TEST_ASSERT_EQUAL(POWER_CRITICAL, PowerGovernor::update(state, START + SAMPLE_INTERVAL, TARGET_HOURS));
+}
+
+void test_target_met_returns_to_normal()
+{
+    PowerGovernorState state;
+    PowerGovernor::reset(state, START);
+    state.level = POWER_SAVER;
+
+    time_t afterTarget = START + (TARGET_HOURS + 1) * 3600;
+    PowerGovernor::recordSample(state, afterTarget, 500, SAMPLE_INTERVAL);
+    TEST_ASSERT_EQUAL(POWER_NORMAL, PowerGovernor::update(state, afterTarget, TARGET_HOURS));
+}
+
+// Discharge curve scenarios
+
+void test_curve_slow_discharge_stays_normal()
+{
+    // Normal level alone lasts 125h, well past the 72h target
+    DischargeCurve curve = {{0.8f, 0.6f, 0.4f, 0.3f}};
+    int maxLevel;
+    simulate(curve, TARGET_HOURS, maxLevel, true);
+    TEST_ASSERT_EQUAL(POWER_NORMAL, maxLevel);
+}
+
+void test_curve_fast_discharge_reaches_target()
+{
+    // Normal level alone lasts 50h - governor must step down to make 72h
+    DischargeCurve curve = {{2.0f, 1.3f, 0.9f, 0.6f}};
+    int maxLevel;
+    float runtime = simulate(curve, TARGET_HOURS, maxLevel, true);
+    TEST_ASSERT_GREATER_THAN(POWER_NORMAL, maxLevel);
+    TEST_ASSERT_GREATER_OR_EQUAL(TARGET_HOURS, (int)runtime);
+}
+
+void test_curve_moderate_discharge_does_not_overshoot()
+{
+    // Eco is enough (100h); governor should not need critical
+    DischargeCurve curve = {{1.6f, 1.0f, 0.7f, 0.5f}};
+    int maxLevel;
+    float runtime = simulate(curve, TARGET_HOURS, maxLevel, true);
+    TEST_ASSERT_LESS_THAN(POWER_CRITICAL, maxLevel);
+    TEST_ASSERT_GREATER_OR_EQUAL(TARGET_HOURS, (int)runtime);
+}
+
+void test_curve_unreachable_target_uses_everything()
+{
+    // Even critical only lasts 50h; governor should bottom out rather than oscillate
+    DischargeCurve curve = {{6.0f, 4.0f, 3.0f, 2.0f}};
+    int maxLevel;
+    float runtime = simulate(curve, TARGET_HOURS, maxLevel, false);
+    TEST_ASSERT_EQUAL(POWER_CRITICAL, maxLevel);
+    TEST_ASSERT_GREATER_THAN(16, (int)runtime); // Normal alone would die at ~16h
+}
+
+void test_relaxes_when_drain_drops()
+{
+    PowerGovernorState state;
+    PowerGovernor::reset(state, START);
+    state.level = POWER_SAVER;
+
+    // Very slow drain at saver level: 80% with 0.2%/h lasts far beyond the target
+    time_t now = START;
+    for (int i = 0; i < 4; i++)
+    {
+        now = START + i * SAMPLE_INTERVAL;
+        PowerGovernor::recordSample(state, now, 800 - i, SAMPLE_INTERVAL);
+    }
+    TEST_ASSERT_EQUAL(POWER_ECO, PowerGovernor::update(state, now, TARGET_HOURS));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_policyFor_normal_matches_config);
+    RUN_TEST(test_policyFor_saver_uses_two_minute_clock_and_two_hour_weather);
+    RUN_TEST(test_recordSample_respects_interval);
+    RUN_TEST(test_dischargeRate_linear);
+    RUN_TEST(test_dischargeRate_ring_wraps);
+    RUN_TEST(test_holds_level_without_enough_trend);
+    RUN_TEST(test_low_battery_floor);
+    RUN_TEST(test_target_met_returns_to_normal);
+
+    // Synthetic discharge curves
+    RUN_TEST(test_curve_slow_discharge_stays_normal);
+    RUN_TEST(test_curve_fast_discharge_reaches_target);
+    RUN_TEST(test_curve_moderate_discharge_does_not_overshoot);
+    RUN_TEST(test_curve_unreachable_target_uses_everything);
+    RUN_TEST(test_relaxes_when_drain_drops);
+
+    return UNITY_END();
+}
@@ -0,0 +1,207 @@
+#include <unity.h>
+#include <cstdlib>
+#include "../../src/wake_logic.h"
+#include "../../src/wake_logic.cpp" // Include implementation directly for testing
+
+const time_t DAY_START = 1767254400; // Jan 1, 2026 08:00:00 UTC
+const int INTERVAL = 30 * 60;
+const int LEAD = 40;
+
+// Simulated wake durations (seconds)
+const int CLOCK_WAKE_SECONDS = 3;
+const int COMBINED_WAKE_SECONDS = 5;
+const int FETCH_SECONDS = 8;
+const int FAILED_FETCH_SECONDS = 15;
+
+// Simulated device: mirrors the RTC state and wake flow in main.cpp
+struct SimDevice
+{
+    time_t lastWeatherUpdate;
+    bool hasParkedWeather;
+    bool prefetchWakePending;
+};
+
+struct SimResult
+{
+    int clockWakes;
+    int lateClockWakes;    // Clock wakes that didn't land exactly on a minute boundary
+    int missedMinutes;     // Minutes that were never shown
+    int prefetchWakes;
+    int prefetchOnBoundary; // Prefetch wakes landing at second 0 (competing with the clock)
+    int weatherShown;
+    int weatherLateMinutes; // Sum of minutes weather was shown after its boundary
+};
+
+// Runs a simulated day. failEvery > 0 makes every Nth prefetch attempt fail
+static SimResult simulateDay(int failEvery)
+{
+    SimResult result = {};
+    SimDevice device = {DAY_START, false, false};
+
+    // Fresh boot at 08:00 finished its inline fetch at 08:00:05
+    time_t now = DAY_START + 5;
+    time_t lastShownMinute = DAY_START / 60;
+    int attempts = 0;
+    now += WakeLogic::planNextWake(now, 0, 5, 1, WakeLogic::prefetchTime(DAY_START, INTERVAL, LEAD)).sleepSeconds;
+
+    // Through 08:00 the next morning inclusive
+    while (now <= DAY_START + 24 * 3600)
+    {
+        struct tm timeinfo;
+        gmtime_r(&now, &timeinfo);
+        time_t wakeEnd = now;
+
+        if (device.prefetchWakePending)
+        {
+            device.prefetchWakePending = false;
+            result.prefetchWakes++;
+            if (timeinfo.tm_sec == 0)
+                result.prefetchOnBoundary++;
+
+            attempts++;
+            bool fails = failEvery > 0 && attempts % failEvery == 0;
+            wakeEnd += fails ? FAILED_FETCH_SECONDS : FETCH_SECONDS;
+            device.hasParkedWeather = !fails;
+        }
+        else
+        {
+            result.clockWakes++;
+            if (timeinfo.tm_sec != 0)
+                result.lateClockWakes++;
+
+            time_t minute = now / 60;
+            result.missedMinutes += (int)(minute - lastShownMinute - 1);
+            lastShownMinute = minute;
+
+            if (device.hasParkedWeather)
+            {
+                time_t boundary = WakeLogic::weatherBoundary(now);
+                result.weatherShown++;
+                result.weatherLateMinutes += (int)((now - boundary) / 60);
+                device.lastWeatherUpdate = boundary;
+                device.hasParkedWeather = false;
+                wakeEnd += COMBINED_WAKE_SECONDS;
+            }
+            else
+            {
+                wakeEnd += CLOCK_WAKE_SECONDS;
+            }
+        }
+
+        // Plan the next wake exactly like loop() does
+        gmtime_r(&wakeEnd, &timeinfo);
+        time_t prefetchAt = device.hasParkedWeather ? 0 : WakeLogic::prefetchTime(device.lastWeatherUpdate, INTERVAL, LEAD);
+        WakePlan plan = WakeLogic::planNextWake(wakeEnd, timeinfo.tm_min, timeinfo.tm_sec, 1, prefetchAt);
+        device.prefetchWakePending = plan.prefetch;
+        now = wakeEnd + plan.sleepSeconds;
+    }
+    return result;
+}
+
+void test_prefetchTime_before_boundary()
+{
+    // Last shown at 08:00, next boundary 08:30, prefetch at 08:29:20
+    TEST_ASSERT_EQUAL(DAY_START + INTERVAL - 40, WakeLogic::prefetchTime(DAY_START, INTERVAL, LEAD));
+}
+
+void test_prefetchTime_never_fetched()
+{
+    TEST_ASSERT_EQUAL(0, WakeLogic::prefetchTime(0, INTERVAL, LEAD));
+}
+
+void test_weatherBoundary_snaps_to_half_hour()
+{
+    TEST_ASSERT_EQUAL(DAY_START, WakeLogic::weatherBoundary(DAY_START + 29 * 60 + 59));
+    TEST_ASSERT_EQUAL(DAY_START + 30 * 60, WakeLogic::weatherBoundary(DAY_START + 31 * 60));
+}
+
+void test_planNextWake_clock_when_no_prefetch()
+{
+    WakePlan plan = WakeLogic::planNextWake(DAY_START + 3, 0, 3, 1, 0);
+    TEST_ASSERT_FALSE(plan.prefetch);
+    TEST_ASSERT_EQUAL(57, plan.sleepSeconds);
+}
+
+void test_planNextWake_prefetch_before_clock()
+{
+    // 08:29:03, prefetch due 08:29:20 - wake for it before the 08:30 clock update
+    time_t now = DAY_START + 29 * 60 + 3;
+    WakePlan plan = WakeLogic::planNextWake(now, 29, 3, 1, DAY_START + INTERVAL - LEAD);
+    TEST_ASSERT_TRUE(plan.prefetch);
+    TEST_ASSERT_EQUAL(17, plan.sleepSeconds);
+}
+
+void test_planNextWake_prefetch_after_clock_waits()
+{
+    // 08:28:03: the 08:29 clock update comes first
+    time_t now = DAY_START + 28 * 60 + 3;
+    WakePlan plan = WakeLogic::planNextWake(now, 28, 3, 1, DAY_START + INTERVAL - LEAD);
+    TEST_ASSERT_FALSE(plan.prefetch);
+    TEST_ASSERT_EQUAL(57, plan.sleepSeconds);
+}
+
+void test_planNextWake_overdue_retry_keeps_phase()
+{
+    // Prefetch at 08:29:20 failed, now 08:30:05 after the clock update - retry at 08:30:20
+    time_t now = DAY_START + 30 * 60 + 5;
+    WakePlan plan = WakeLogic::planNextWake(now, 30, 5, 1, DAY_START + INTERVAL - LEAD);
+    TEST_ASSERT_TRUE(plan.prefetch);
+    TEST_ASSERT_EQUAL(15, plan.sleepSeconds);
+}
+
+// Simulated clock scenarios
+
+void test_simulated_day_clock_never_late()
+{
+    SimResult result = simulateDay(0);
+    char msg[160];
+    snprintf(msg, sizeof(msg), "Day: %d clock wakes, %d prefetch wakes, %d weather updates, late clock wakes %d",
+             result.clockWakes, result.prefetchWakes, result.weatherShown, result.lateClockWakes);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_EQUAL(0, result.lateClockWakes);
+    TEST_ASSERT_EQUAL(0, result.missedMinutes);
+    TEST_ASSERT_EQUAL(0, result.prefetchOnBoundary);
+    TEST_ASSERT_EQUAL(48, result.weatherShown);
+    TEST_ASSERT_EQUAL(48, result.prefetchWakes);
+    TEST_ASSERT_EQUAL(0, result.weatherLateMinutes);
+}
+
+void test_simulated_day_with_failed_fetches()
+{
+    // Every third prefetch fails; retries must stay off the minute boundary
+    SimResult result = simulateDay(3);
+    char msg[160];
+    snprintf(msg, sizeof(msg), "Day with failures: %d prefetch wakes, weather late by %d minutes total",
+             result.prefetchWakes, result.weatherLateMinutes);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_EQUAL(0, result.lateClockWakes);
+    TEST_ASSERT_EQUAL(0, result.missedMinutes);
+    TEST_ASSERT_EQUAL(0, result.prefetchOnBoundary);
+    TEST_ASSERT_EQUAL(48, result.weatherShown);
+    // Each failure costs exactly one minute of weather staleness, never a clock update
+    TEST_ASSERT_EQUAL(result.prefetchWakes - 48, result.weatherLateMinutes);
+}
+
+int main()
+{
+    setenv("TZ", "UTC0", 1);
+    tzset();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_prefetchTime_before_boundary);
+    RUN_TEST(test_prefetchTime_never_fetched);
+    RUN_TEST(test_weatherBoundary_snaps_to_half_hour);
+    RUN_TEST(test_planNextWake_clock_when_no_prefetch);
+    RUN_TEST(test_planNextWake_prefetch_before_clock);
+    RUN_TEST(test_planNextWake_prefetch_after_clock_waits);
+    RUN_TEST(test_planNextWake_overdue_retry_keeps_phase);
+
+    // Simulated clock scenarios
+    RUN_TEST(test_simulated_day_clock_never_late);
+    RUN_TEST(test_simulated_day_with_failed_fetches);
+
+    return UNITY_END();
+}
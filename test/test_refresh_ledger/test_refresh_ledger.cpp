@@ -0,0 +1,246 @@
+#include <unity.h>
+#include <cstdio>
+#include "../../src/refresh_ledger.h"
+#include "../../src/refresh_ledger.cpp" // Include implementation directly for testing
+#include "../../src/weather_diff.cpp"
+#include "../../src/text_format.cpp"
+
+const int BUDGET = 60;
+const int LIMIT = 240;
+const int FAST_COST = 4;
+const int QUIET_START = 2;
+const int QUIET_END = 5;
+
+// Windows the display code refreshes
+const ScreenRect CLOCK_WINDOW = {0, 80, DISPLAY_LEFT_HALF, 140}; // DisplayClock::updatePartial
+const ScreenRect LEFT_PANE = {0, 0, DISPLAY_LEFT_HALF, DISPLAY_HEIGHT};
+
+static uint32_t bit(int region)
+{
+    return 1u << region;
+}
+
+static uint32_t weatherBit(int weatherRegion)
+{
+    return bit(PANEL_REGION_WEATHER_FIRST + weatherRegion);
+}
+
+void test_window_counts_regions_by_centre()
+{
+    // The clock rectangle overlaps the date's top alignment rows; the date isn't charged for it
+    TEST_ASSERT_EQUAL_HEX32(bit(PANEL_REGION_CLOCK_TIME), RefreshLedger::regionsIn(CLOCK_WINDOW));
+    TEST_ASSERT_EQUAL_HEX32(bit(PANEL_REGION_CLOCK_TIME), RefreshLedger::regionsIn(CLOCK_TIME_RECT));
+    TEST_ASSERT_EQUAL_HEX32(bit(PANEL_REGION_CLOCK_DATE), RefreshLedger::regionsIn(CLOCK_DATE_RECT));
+    TEST_ASSERT_EQUAL_HEX32(bit(PANEL_REGION_CLOCK_TIME) | bit(PANEL_REGION_CLOCK_DATE) | bit(PANEL_REGION_BATTERY),
+                            RefreshLedger::regionsIn(LEFT_PANE));
+
+    // Every weather region is its own entry
+    for (int region = 0; region < WEATHER_REGION_COUNT; region++)
+    {
+        TEST_ASSERT_EQUAL_HEX32(weatherBit(region), RefreshLedger::regionsIn(WeatherDiff::regionRect(region)));
+    }
+    ScreenRect pane = {WEATHER_PANE_X, 0, WEATHER_PANE_WIDTH, DISPLAY_HEIGHT};
+    TEST_ASSERT_EQUAL_HEX32(((1u << WEATHER_REGION_COUNT) - 1) << PANEL_REGION_WEATHER_FIRST,
+                            RefreshLedger::regionsIn(pane));
+}
+
+void test_only_selected_regions_go_fast()
+{
+    TEST_ASSERT_EQUAL(WAVEFORM_FAST, RefreshLedger::waveformFor(CLOCK_WINDOW, FAST_CLOCK_TIME));
+    TEST_ASSERT_EQUAL(WAVEFORM_STOCK, RefreshLedger::waveformFor(CLOCK_DATE_RECT, FAST_CLOCK_TIME));
+    TEST_ASSERT_EQUAL(WAVEFORM_STOCK, RefreshLedger::waveformFor(BATTERY_RECT, FAST_CLOCK_TIME));
+    TEST_ASSERT_EQUAL(WAVEFORM_STOCK, RefreshLedger::waveformFor(CLOCK_WINDOW, 0));
+
+    // A window over several regions goes fast only if all of them may
+    TEST_ASSERT_EQUAL(WAVEFORM_STOCK, RefreshLedger::waveformFor(LEFT_PANE, FAST_CLOCK_TIME | FAST_CLOCK_DATE));
+    TEST_ASSERT_EQUAL(WAVEFORM_FAST,
+                      RefreshLedger::waveformFor(LEFT_PANE, FAST_CLOCK_TIME | FAST_CLOCK_DATE | FAST_BATTERY));
+
+    // One bit for the whole weather pane
+    ScreenRect temp = WeatherDiff::regionRect(REGION_CURRENT_TEMP);
+    TEST_ASSERT_EQUAL(WAVEFORM_STOCK, RefreshLedger::waveformFor(temp, FAST_CLOCK_TIME));
+    TEST_ASSERT_EQUAL(WAVEFORM_FAST, RefreshLedger::waveformFor(temp, FAST_WEATHER));
+
+    // A sliver that holds no region's centre stays stock
+    ScreenRect sliver = {0, 0, 8, 8};
+    TEST_ASSERT_EQUAL(WAVEFORM_STOCK, RefreshLedger::waveformFor(sliver, 0xFF));
+}
+
+void test_record_charges_by_waveform()
+{
+    RefreshLedgerState ledger = {};
+    RefreshLedger::record(ledger, CLOCK_WINDOW, WAVEFORM_STOCK, FAST_COST);
+    RefreshLedger::record(ledger, CLOCK_WINDOW, WAVEFORM_FAST, FAST_COST);
+    RefreshLedger::record(ledger, BATTERY_RECT, WAVEFORM_STOCK, FAST_COST);
+    TEST_ASSERT_EQUAL(1 + FAST_COST, ledger.ghosting[PANEL_REGION_CLOCK_TIME]);
+    TEST_ASSERT_EQUAL(1, ledger.ghosting[PANEL_REGION_BATTERY]);
+    TEST_ASSERT_EQUAL(0, ledger.ghosting[PANEL_REGION_CLOCK_DATE]);
+
+    // Saturates instead of wrapping back to clean
+    for (int i = 0; i < 100; i++)
+    {
+        RefreshLedger::record(ledger, CLOCK_WINDOW, WAVEFORM_FAST, FAST_COST);
+    }
+    TEST_ASSERT_EQUAL(255, ledger.ghosting[PANEL_REGION_CLOCK_TIME]);
+}
+
+void test_cleanup_clears_only_what_it_covers()
+{
+    RefreshLedgerState ledger = {};
+    RefreshLedger::record(ledger, LEFT_PANE, WAVEFORM_STOCK, FAST_COST);
+    RefreshLedger::record(ledger, WeatherDiff::regionRect(REGION_CURRENT_TEMP), WAVEFORM_STOCK, FAST_COST);
+
+    // The clock's partial window is 4 rows short of its region: that isn't a cleanup of it
+    RefreshLedger::record(ledger, CLOCK_WINDOW, WAVEFORM_CLEANUP, FAST_COST);
+    TEST_ASSERT_EQUAL(1, ledger.ghosting[PANEL_REGION_CLOCK_TIME]);
+
+    RefreshLedger::record(ledger, CLOCK_TIME_RECT, WAVEFORM_CLEANUP, FAST_COST);
+    TEST_ASSERT_EQUAL(0, ledger.ghosting[PANEL_REGION_CLOCK_TIME]);
+    TEST_ASSERT_EQUAL(1, ledger.ghosting[PANEL_REGION_CLOCK_DATE]);
+    TEST_ASSERT_EQUAL(1, ledger.ghosting[PANEL_REGION_BATTERY]);
+    TEST_ASSERT_EQUAL(1, ledger.ghosting[PANEL_REGION_WEATHER_FIRST + REGION_CURRENT_TEMP]);
+}
+
+void test_quiet_hours()
+{
+    TEST_ASSERT_TRUE(RefreshLedger::quietHour(2, 2, 5));
+    TEST_ASSERT_TRUE(RefreshLedger::quietHour(4, 2, 5));
+    TEST_ASSERT_FALSE(RefreshLedger::quietHour(5, 2, 5));
+    TEST_ASSERT_FALSE(RefreshLedger::quietHour(1, 2, 5));
+
+    // Wrapping past midnight
+    TEST_ASSERT_TRUE(RefreshLedger::quietHour(23, 23, 4));
+    TEST_ASSERT_TRUE(RefreshLedger::quietHour(0, 23, 4));
+    TEST_ASSERT_FALSE(RefreshLedger::quietHour(4, 23, 4));
+    TEST_ASSERT_FALSE(RefreshLedger::quietHour(12, 23, 4));
+}
+
+void test_due_waits_for_quiet_hours_until_the_limit()
+{
+    RefreshLedgerState ledger = {};
+    ledger.ghosting[PANEL_REGION_CLOCK_TIME] = BUDGET;
+    ledger.ghosting[PANEL_REGION_BATTERY] = BUDGET - 1;
+    ledger.ghosting[PANEL_REGION_WEATHER_FIRST + REGION_LAST_UPDATED] = LIMIT;
+
+    TEST_ASSERT_EQUAL_HEX32(weatherBit(REGION_LAST_UPDATED),
+                            RefreshLedger::dueForCleanup(ledger, 14, BUDGET, LIMIT, QUIET_START, QUIET_END));
+    TEST_ASSERT_EQUAL_HEX32(bit(PANEL_REGION_CLOCK_TIME) | weatherBit(REGION_LAST_UPDATED),
+                            RefreshLedger::dueForCleanup(ledger, 3, BUDGET, LIMIT, QUIET_START, QUIET_END));
+
+    RefreshLedgerState clean = {};
+    TEST_ASSERT_EQUAL_HEX32(0, RefreshLedger::dueForCleanup(clean, 3, BUDGET, LIMIT, QUIET_START, QUIET_END));
+}
+
+void test_cleanup_rects_cover_due_regions()
+{
+    uint32_t due = bit(PANEL_REGION_CLOCK_TIME) | bit(PANEL_REGION_CLOCK_DATE) | weatherBit(REGION_HOURLY_FIRST) |
+                   weatherBit(REGION_HOURLY_FIRST + 1);
+    ScreenRect rects[PANEL_REGION_COUNT];
+    int count = RefreshLedger::cleanupRects(due, rects);
+    TEST_ASSERT_TRUE(count >= 1 && count <= 4);
+
+    RefreshLedgerState ledger;
+    for (int region = 0; region < PANEL_REGION_COUNT; region++)
+    {
+        ledger.ghosting[region] = 100;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        RefreshLedger::record(ledger, rects[i], WAVEFORM_CLEANUP, FAST_COST);
+    }
+    for (int region = 0; region < PANEL_REGION_COUNT; region++)
+    {
+        if (due & bit(region))
+        {
+            TEST_ASSERT_EQUAL(0, ledger.ghosting[region]);
+        }
+    }
+    // Regions the merged windows don't cover keep their count
+    TEST_ASSERT_EQUAL(100, ledger.ghosting[PANEL_REGION_BATTERY]);
+    TEST_ASSERT_EQUAL(100, ledger.ghosting[PANEL_REGION_WEATHER_FIRST + REGION_CURRENT_TEMP]);
+
+    char message[80];
+    snprintf(message, sizeof(message), "4 due regions -> %d cleanup window(s)", count);
+    TEST_MESSAGE(message);
+}
+
+// Two days of wakes as main.cpp runs them: the clock every minute, the battery every 50,
+// the current temperature every 30, the cleanup check at the end of each wake
+static void runDays(uint8_t fastRegions, int days, int &quietCleanups, int &dayCleanups, uint32_t &cleaned)
+{
+    RefreshLedgerState ledger = {};
+    quietCleanups = 0;
+    dayCleanups = 0;
+    cleaned = 0;
+    ScreenRect temp = WeatherDiff::regionRect(REGION_CURRENT_TEMP);
+    for (int minute = 0; minute < days * 24 * 60; minute++)
+    {
+        RefreshLedger::record(ledger, CLOCK_WINDOW, RefreshLedger::waveformFor(CLOCK_WINDOW, fastRegions), FAST_COST);
+        if (minute % 50 == 0)
+        {
+            RefreshLedger::record(ledger, BATTERY_RECT, RefreshLedger::waveformFor(BATTERY_RECT, fastRegions),
+                                  FAST_COST);
+        }
+        if (minute % 30 == 0)
+        {
+            RefreshLedger::record(ledger, temp, RefreshLedger::waveformFor(temp, fastRegions), FAST_COST);
+        }
+
+        int hour = minute / 60 % 24;
+        uint32_t due = RefreshLedger::dueForCleanup(ledger, hour, BUDGET, LIMIT, QUIET_START, QUIET_END);
+        ScreenRect rects[PANEL_REGION_COUNT];
+        int count = RefreshLedger::cleanupRects(due, rects);
+        for (int i = 0; i < count; i++)
+        {
+            RefreshLedger::record(ledger, rects[i], WAVEFORM_CLEANUP, FAST_COST);
+        }
+        if (count > 0)
+        {
+            (RefreshLedger::quietHour(hour, QUIET_START, QUIET_END) ? quietCleanups : dayCleanups) += count;
+        }
+        cleaned |= due;
+
+        for (int region = 0; region < PANEL_REGION_COUNT; region++)
+        {
+            TEST_ASSERT_TRUE(ledger.ghosting[region] < LIMIT);
+        }
+    }
+}
+
+void test_simulated_days()
+{
+    int quiet, day;
+    uint32_t cleaned;
+
+    // Stock waveform: the clock is cleaned each quiet hour and whenever it hits the limit by day.
+    // The temperature (48 refreshes a day) misses its budget by the second night's quiet hours
+    runDays(0, 2, quiet, day, cleaned);
+    TEST_ASSERT_EQUAL_HEX32(bit(PANEL_REGION_CLOCK_TIME), cleaned);
+    TEST_ASSERT_TRUE(quiet > 0);
+    char message[96];
+    snprintf(message, sizeof(message), "Stock: %d quiet-hour and %d daytime cleanups in 2 days", quiet, day);
+    TEST_MESSAGE(message);
+
+    // Fast clock: more cleanups, still only of the clock; nothing else is ever flashed
+    int fastQuiet, fastDay;
+    runDays(FAST_CLOCK_TIME, 2, fastQuiet, fastDay, cleaned);
+    TEST_ASSERT_EQUAL_HEX32(bit(PANEL_REGION_CLOCK_TIME), cleaned);
+    TEST_ASSERT_TRUE(fastQuiet + fastDay > quiet + day);
+    snprintf(message, sizeof(message), "Fast clock: %d quiet-hour and %d daytime cleanups in 2 days", fastQuiet,
+             fastDay);
+    TEST_MESSAGE(message);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_window_counts_regions_by_centre);
+    RUN_TEST(test_only_selected_regions_go_fast);
+    RUN_TEST(test_record_charges_by_waveform);
+    RUN_TEST(test_cleanup_clears_only_what_it_covers);
+    RUN_TEST(test_quiet_hours);
+    RUN_TEST(test_due_waits_for_quiet_hours_until_the_limit);
+    RUN_TEST(test_cleanup_rects_cover_due_regions);
+    RUN_TEST(test_simulated_days);
+    return UNITY_END();
+}
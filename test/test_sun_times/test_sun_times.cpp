@@ -0,0 +1,237 @@
+#include <unity.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "../../src/sun_times.h"
+#include "../../src/sun_times.cpp" // Include implementation directly for testing
+
+const time_t YEAR_START = 1767225600; // Jan 1, 2026 00:00:00 UTC
+const double RAD = M_PI / 180.0;
+
+struct Site
+{
+    const char *name;
+    const char *latitude;
+    const char *longitude;
+    int utcOffset; // Standard time, seconds - only used to pick local noon
+    int tolerance; // Seconds; the low sun grazes the horizon at high latitude, so timing errors grow
+};
+
+static const Site SITES[] = {
+    {"Portland", "45.5152", "-122.6784", -8 * 3600, 90},
+    {"Quito", "-0.1807", "-78.4678", -5 * 3600, 60},
+    {"Sydney", "-33.8688", "151.2093", 10 * 3600, 90},
+    {"Reykjavik", "64.1466", "-21.9426", 0, 150},
+    {"Tromso", "69.6492", "18.9553", 3600, 300},
+};
+const int SITE_COUNT = sizeof(SITES) / sizeof(SITES[0]);
+
+// NOAA solar calculator spreadsheet (Meeus) in double precision - the reference the
+// fixed-point routine is held to. cosHourAngle outside -1..1 means the sun stays up or down.
+struct Reference
+{
+    double sunrise; // UTC epoch seconds
+    double sunset;
+    double cosHourAngle;
+};
+
+static Reference reference(double latitude, double longitude, time_t noon)
+{
+    double solarNoon = (double)noon;
+    double cosHourAngle = 0;
+    double eqTime = 0;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        double jc = (solarNoon / 86400.0 + 2440587.5 - 2451545.0) / 36525.0;
+        double meanLong = fmod(280.46646 + jc * (36000.76983 + jc * 0.0003032), 360.0);
+        double meanAnom = 357.52911 + jc * (35999.05029 - 0.0001537 * jc);
+        double ecc = 0.016708634 - jc * (0.000042037 + 0.0000001267 * jc);
+        double center = sin(meanAnom * RAD) * (1.914602 - jc * (0.004817 + 0.000014 * jc)) +
+                        sin(2 * meanAnom * RAD) * (0.019993 - 0.000101 * jc) + sin(3 * meanAnom * RAD) * 0.000289;
+        double omega = (125.04 - 1934.136 * jc) * RAD;
+        double apparentLong = meanLong + center - 0.00569 - 0.00478 * sin(omega);
+        double meanObliq = 23 + (26 + (21.448 - jc * (46.815 + jc * (0.00059 - jc * 0.001813))) / 60) / 60;
+        double obliq = (meanObliq + 0.00256 * cos(omega)) * RAD;
+        double declination = asin(sin(obliq) * sin(apparentLong * RAD));
+        double y = tan(obliq / 2) * tan(obliq / 2);
+        double l = meanLong * RAD;
+        double m = meanAnom * RAD;
+        eqTime = 4 / RAD *
+                 (y * sin(2 * l) - 2 * ecc * sin(m) + 4 * ecc * y * sin(m) * cos(2 * l) -
+                  0.5 * y * y * sin(4 * l) - 1.25 * ecc * ecc * sin(2 * m));
+        cosHourAngle = cos(90.833 * RAD) / (cos(latitude * RAD) * cos(declination)) -
+                       tan(latitude * RAD) * tan(declination);
+
+        double utcDay = floor(((double)noon + longitude * 240) / 86400.0) * 86400.0; // Local solar date
+        solarNoon = utcDay + (720 - 4 * longitude - eqTime) * 60;
+    }
+
+    Reference result = {0, 0, cosHourAngle};
+    if (cosHourAngle > -1 && cosHourAngle < 1)
+    {
+        double halfDay = acos(cosHourAngle) / RAD * 240;
+        result.sunrise = solarNoon - halfDay;
+        result.sunset = solarNoon + halfDay;
+    }
+    return result;
+}
+
+void test_parse_micro_degrees()
+{
+    TEST_ASSERT_EQUAL_INT32(45515200, SunTimes::parseMicroDegrees("45.5152"));
+    TEST_ASSERT_EQUAL_INT32(-122678400, SunTimes::parseMicroDegrees("-122.6784"));
+    TEST_ASSERT_EQUAL_INT32(18000000, SunTimes::parseMicroDegrees("+18"));
+    TEST_ASSERT_EQUAL_INT32(-180700, SunTimes::parseMicroDegrees("-0.1807"));
+    TEST_ASSERT_EQUAL_INT32(1234568, SunTimes::parseMicroDegrees("1.23456789"));
+    TEST_ASSERT_EQUAL_INT32(180000000, SunTimes::parseMicroDegrees("180.000000"));
+}
+
+void test_cordic_sin_cos()
+{
+    double worst = 0;
+    for (int tenths = -7200; tenths <= 7200; tenths += 7)
+    {
+        int32_t angle = (int32_t)((int64_t)tenths * (1 << 20) / 10);
+        double radians = tenths / 10.0 * RAD;
+        double sinError = fabs(SunTimes::sinQ30(angle) / 1073741824.0 - sin(radians));
+        double cosError = fabs(SunTimes::cosQ30(angle) / 1073741824.0 - cos(radians));
+        worst = fmax(worst, fmax(sinError, cosError));
+    }
+    char msg[80];
+    snprintf(msg, sizeof(msg), "sin/cos worst error %.2e", worst);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(worst < 1e-6);
+}
+
+void test_cordic_atan2()
+{
+    double worst = 0;
+    for (int tenths = -1799; tenths <= 1800; tenths += 13)
+    {
+        double radians = tenths / 10.0 * RAD;
+        for (double radius = 0.01; radius <= 1.0; radius *= 4)
+        {
+            int32_t y = (int32_t)lround(radius * sin(radians) * 1073741824.0);
+            int32_t x = (int32_t)lround(radius * cos(radians) * 1073741824.0);
+            double degrees = SunTimes::atan2Q20(y, x) / 1048576.0;
+            double error = fabs(degrees - tenths / 10.0);
+            worst = fmax(worst, fmin(error, 360 - error));
+        }
+    }
+    char msg[80];
+    snprintf(msg, sizeof(msg), "atan2 worst error %.2e deg", worst);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(worst < 1e-4);
+    TEST_ASSERT_EQUAL_INT32(0, SunTimes::atan2Q20(0, 0));
+    TEST_ASSERT_INT_WITHIN(64, 90 << 20, SunTimes::atan2Q20(1 << 30, 0));
+}
+
+void test_matches_reference_through_the_year()
+{
+    for (int s = 0; s < SITE_COUNT; s++)
+    {
+        const Site &site = SITES[s];
+        int32_t latitude = SunTimes::parseMicroDegrees(site.latitude);
+        int32_t longitude = SunTimes::parseMicroDegrees(site.longitude);
+        double worst = 0;
+        int compared = 0;
+        int polarDays = 0;
+
+        for (int day = 0; day < 365; day++)
+        {
+            time_t noon = YEAR_START + day * 86400 + 12 * 3600 - site.utcOffset;
+            SunDay sun = {};
+            SunTimes::compute(latitude, longitude, noon, sun);
+            Reference ref = reference(latitude / 1e6, longitude / 1e6, noon);
+
+            // A few days either side of the polar switch the sunrise moves by hours per day,
+            // so only the clear cases are held to the reference
+            if (ref.cosHourAngle >= 1.02)
+            {
+                TEST_ASSERT_EQUAL(SUN_POLAR_NIGHT, sun.polar);
+                TEST_ASSERT_EQUAL(0, SunTimes::dayLengthMinutes(sun));
+                polarDays++;
+            }
+            else if (ref.cosHourAngle <= -1.02)
+            {
+                TEST_ASSERT_EQUAL(SUN_MIDNIGHT_SUN, sun.polar);
+                TEST_ASSERT_EQUAL(24 * 60, SunTimes::dayLengthMinutes(sun));
+                polarDays++;
+            }
+            else if (fabs(ref.cosHourAngle) <= 0.95)
+            {
+                TEST_ASSERT_EQUAL(SUN_RISES_AND_SETS, sun.polar);
+                worst = fmax(worst, fabs(sun.sunrise - ref.sunrise));
+                worst = fmax(worst, fabs(sun.sunset - ref.sunset));
+                TEST_ASSERT_TRUE(sun.sunrise < noon && sun.sunset > noon);
+                compared++;
+            }
+        }
+
+        char msg[120];
+        snprintf(msg, sizeof(msg), "%s: worst %.0f s off the NOAA reference over %d days (%d polar)", site.name,
+                 worst, compared, polarDays);
+        TEST_MESSAGE(msg);
+        TEST_ASSERT_TRUE(compared + polarDays > 330);
+        TEST_ASSERT_TRUE(worst <= site.tolerance);
+    }
+}
+
+void test_known_portland_day()
+{
+    // Jun 21 2026: NOAA gives sunrise 05:22 PDT, sunset 21:03 PDT
+    SunDay sun = {};
+    SunTimes::compute(45515200, -122678400, 1782068400, sun);
+    TEST_ASSERT_EQUAL(SUN_RISES_AND_SETS, sun.polar);
+    long sunriseLocal = (long)((sun.sunrise - 7 * 3600) % 86400);
+    long sunsetLocal = (long)((sun.sunset - 7 * 3600) % 86400);
+    TEST_ASSERT_INT_WITHIN(120, 5 * 3600 + 22 * 60, sunriseLocal);
+    TEST_ASSERT_INT_WITHIN(120, 21 * 3600 + 3 * 60, sunsetLocal);
+    TEST_ASSERT_INT_WITHIN(3, 15 * 60 + 41, SunTimes::dayLengthMinutes(sun));
+}
+
+void test_cost_per_day()
+{
+    const int runs = 200000;
+    int32_t latitude = 45515200;
+    int32_t longitude = -122678400;
+    volatile time_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++)
+    {
+        SunDay sun = {};
+        SunTimes::compute(latitude, longitude, YEAR_START + (i % 365) * 86400 + 72000, sun);
+        sink = sink + sun.sunrise;
+    }
+    double fixedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++)
+    {
+        Reference ref = reference(45.5152, -122.6784, YEAR_START + (i % 365) * 86400 + 72000);
+        sink = sink + (time_t)ref.sunrise;
+    }
+    double floatNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "Fixed point %.0f ns per day on host, double reference %.0f ns (with an FPU); once per day on device",
+             fixedNs, floatNs);
+    TEST_MESSAGE(msg);
+    snprintf(msg, sizeof(msg), "SunDay %u bytes of RTC memory", (unsigned)sizeof(SunDay));
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_OR_EQUAL(32, sizeof(SunDay));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_parse_micro_degrees);
+    RUN_TEST(test_cordic_sin_cos);
+    RUN_TEST(test_cordic_atan2);
+    RUN_TEST(test_matches_reference_through_the_year);
+    RUN_TEST(test_known_portland_day);
+    RUN_TEST(test_cost_per_day);
+    return UNITY_END();
+}
@@ -0,0 +1,234 @@
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include "../../src/telemetry.h"
+#include "../../src/telemetry.cpp" // Include implementation directly for testing
+
+static const uint8_t MAC[6] = {0x24, 0x0A, 0xC4, 0x12, 0x34, 0x56};
+
+static uint8_t batch[TELEMETRY_BATCH_MAX];
+static WakeMetrics decoded[TELEMETRY_CAPACITY];
+
+// A minute-boundary clock wake: short, no radio, one partial refresh
+static WakeMetrics clockWake(uint32_t startedAt, int minute)
+{
+    WakeMetrics m = {};
+    m.startedAt = startedAt;
+    m.awakeMs = (uint16_t)(310 + (minute % 3) * 10);
+    m.refreshMs = 290;
+    m.batteryX10 = (uint16_t)(874 - minute / 10);
+    m.kind = WAKE_CLOCK;
+    m.refreshes = 1;
+    m.resetCause = 1;
+    return m;
+}
+
+// A weather prefetch wake: radio up, one fetch
+static WakeMetrics prefetchWake(uint32_t startedAt)
+{
+    WakeMetrics m = {};
+    m.startedAt = startedAt;
+    m.awakeMs = 4210;
+    m.radioMs = 2870;
+    m.fetchMs = 1120;
+    m.batteryX10 = 871;
+    m.rssi = -67;
+    m.kind = WAKE_PREFETCH;
+    m.retries = 3;
+    m.fetch = 2;
+    m.resetCause = 1;
+    return m;
+}
+
+static bool sameMetrics(const WakeMetrics &a, const WakeMetrics &b)
+{
+    return a.startedAt == b.startedAt && a.awakeMs == b.awakeMs && a.radioMs == b.radioMs && a.fetchMs == b.fetchMs &&
+           a.refreshMs == b.refreshMs && a.batteryX10 == b.batteryX10 && a.rssi == b.rssi && a.kind == b.kind &&
+           a.refreshes == b.refreshes && a.retries == b.retries && a.fetch == b.fetch && a.resetCause == b.resetCause;
+}
+
+// Half an hour of clock wakes with the weather prefetch in the middle
+static void typicalHalfHour(TelemetryRing &ring)
+{
+    Telemetry::reset(ring);
+    uint32_t start = 1760000000;
+    for (int minute = 0; minute < 30; minute++)
+    {
+        Telemetry::record(ring, clockWake(start + minute * 60, minute));
+        if (minute == 14)
+        {
+            Telemetry::record(ring, prefetchWake(start + minute * 60 + 30));
+        }
+    }
+}
+
+void test_ring_drops_oldest_when_full()
+{
+    TelemetryRing ring;
+    Telemetry::reset(ring);
+    for (int i = 0; i < TELEMETRY_CAPACITY + 5; i++)
+    {
+        Telemetry::record(ring, clockWake(1000 + i * 60, i));
+    }
+    TEST_ASSERT_EQUAL(TELEMETRY_CAPACITY, ring.count);
+    TEST_ASSERT_EQUAL(5, ring.dropped);
+    TEST_ASSERT_EQUAL(1000 + 5 * 60, ring.records[ring.head].startedAt);
+}
+
+void test_round_trip()
+{
+    TelemetryRing ring;
+    typicalHalfHour(ring);
+    ring.records[3].startedAt = 0; // Clock not set
+    ring.records[7].rssi = -128;
+    ring.records[9].awakeMs = 0xFFFF;
+    ring.records[11].resetCause = 5;
+    ring.dropped = 300;
+
+    int records;
+    size_t length = Telemetry::encode(ring, MAC, batch, sizeof(batch), records);
+    TEST_ASSERT_TRUE(length > 0);
+    TEST_ASSERT_EQUAL(31, records);
+
+    uint8_t mac[6];
+    int dropped;
+    TEST_ASSERT_EQUAL(31, Telemetry::decode(batch, length, mac, dropped, decoded, TELEMETRY_CAPACITY));
+    TEST_ASSERT_EQUAL_MEMORY(MAC, mac, 6);
+    TEST_ASSERT_EQUAL(300, dropped);
+    for (int i = 0; i < records; i++)
+    {
+        TEST_ASSERT_TRUE(sameMetrics(ring.records[i], decoded[i]));
+    }
+}
+
+void test_round_trip_after_wrap()
+{
+    TelemetryRing ring;
+    Telemetry::reset(ring);
+    for (int i = 0; i < TELEMETRY_CAPACITY * 2 + 7; i++)
+    {
+        Telemetry::record(ring, i % 15 == 0 ? prefetchWake(5000 + i * 60) : clockWake(5000 + i * 60, i));
+    }
+    int records;
+    size_t length = Telemetry::encode(ring, MAC, batch, sizeof(batch), records);
+    TEST_ASSERT_EQUAL(TELEMETRY_CAPACITY, records);
+
+    uint8_t mac[6];
+    int dropped;
+    TEST_ASSERT_EQUAL(records, Telemetry::decode(batch, length, mac, dropped, decoded, TELEMETRY_CAPACITY));
+    for (int i = 0; i < records; i++)
+    {
+        TEST_ASSERT_TRUE(sameMetrics(ring.records[(ring.head + i) % TELEMETRY_CAPACITY], decoded[i]));
+    }
+}
+
+void test_typical_batch_is_small()
+{
+    TelemetryRing ring;
+    typicalHalfHour(ring);
+    int records;
+    size_t length = Telemetry::encode(ring, MAC, batch, sizeof(batch), records);
+    size_t raw = records * sizeof(WakeMetrics);
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%d wakes: %u bytes packed, %u unpacked", records, (unsigned)length, (unsigned)raw);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(length * 4 < raw);
+}
+
+void test_worst_case_fits_batch_max()
+{
+    TelemetryRing ring;
+    Telemetry::reset(ring);
+    for (int i = 0; i < TELEMETRY_CAPACITY; i++)
+    {
+        // Every field swings as far as it can from one record to the next
+        WakeMetrics m;
+        memset(&m, i % 2 ? 0xFF : 0x00, sizeof(m));
+        m.startedAt = i % 2 ? 0xFFFFFFFFu : 0;
+        m.rssi = i % 2 ? 127 : -128;
+        Telemetry::record(ring, m);
+    }
+    int records;
+    TEST_ASSERT_TRUE(Telemetry::encode(ring, MAC, batch, sizeof(batch), records) > 0);
+    TEST_ASSERT_EQUAL(TELEMETRY_CAPACITY, records);
+}
+
+void test_acknowledge_keeps_later_wakes()
+{
+    TelemetryRing ring;
+    typicalHalfHour(ring);
+    ring.dropped = 4;
+    int records;
+    Telemetry::encode(ring, MAC, batch, sizeof(batch), records);
+
+    // Two wakes recorded while the upload was in flight
+    Telemetry::record(ring, clockWake(1760009000, 0));
+    Telemetry::record(ring, clockWake(1760009060, 1));
+    Telemetry::acknowledge(ring, records);
+    TEST_ASSERT_EQUAL(2, ring.count);
+    TEST_ASSERT_EQUAL(0, ring.dropped);
+    TEST_ASSERT_EQUAL(1760009000, ring.records[ring.head].startedAt);
+}
+
+void test_empty_ring_or_small_buffer()
+{
+    TelemetryRing ring;
+    Telemetry::reset(ring);
+    int records = 7;
+    TEST_ASSERT_EQUAL(0, Telemetry::encode(ring, MAC, batch, sizeof(batch), records));
+    TEST_ASSERT_EQUAL(0, records);
+
+    typicalHalfHour(ring);
+    TEST_ASSERT_EQUAL(0, Telemetry::encode(ring, MAC, batch, 40, records));
+    TEST_ASSERT_EQUAL(0, records);
+}
+
+void test_malformed_batches_rejected()
+{
+    TelemetryRing ring;
+    typicalHalfHour(ring);
+    int records;
+    size_t length = Telemetry::encode(ring, MAC, batch, sizeof(batch), records);
+    uint8_t mac[6];
+    int dropped;
+
+    TEST_ASSERT_EQUAL(-1, Telemetry::decode(batch, length - 1, mac, dropped, decoded, TELEMETRY_CAPACITY));
+    TEST_ASSERT_EQUAL(-1, Telemetry::decode(batch, TELEMETRY_HEADER_SIZE - 1, mac, dropped, decoded, 64));
+    TEST_ASSERT_EQUAL(-1, Telemetry::decode(batch, length, mac, dropped, decoded, records - 1));
+
+    batch[length] = 0x01; // Trailing byte
+    TEST_ASSERT_EQUAL(-1, Telemetry::decode(batch, length + 1, mac, dropped, decoded, TELEMETRY_CAPACITY));
+
+    batch[1] = 'X';
+    TEST_ASSERT_EQUAL(-1, Telemetry::decode(batch, length, mac, dropped, decoded, TELEMETRY_CAPACITY));
+    batch[1] = 'M';
+    batch[2] = TELEMETRY_VERSION + 1;
+    TEST_ASSERT_EQUAL(-1, Telemetry::decode(batch, length, mac, dropped, decoded, TELEMETRY_CAPACITY));
+}
+
+void test_durations_saturate()
+{
+    uint16_t field = 0;
+    Telemetry::addMs(field, 40000);
+    TEST_ASSERT_EQUAL(40000, field);
+    Telemetry::addMs(field, 40000);
+    TEST_ASSERT_EQUAL(0xFFFF, field);
+    Telemetry::addMs(field, 0xFFFFFFFFu);
+    TEST_ASSERT_EQUAL(0xFFFF, field);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_ring_drops_oldest_when_full);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_round_trip_after_wrap);
+    RUN_TEST(test_typical_batch_is_small);
+    RUN_TEST(test_worst_case_fits_batch_max);
+    RUN_TEST(test_acknowledge_keeps_later_wakes);
+    RUN_TEST(test_empty_ring_or_small_buffer);
+    RUN_TEST(test_malformed_batches_rejected);
+    RUN_TEST(test_durations_saturate);
+    return UNITY_END();
+}
@@ -0,0 +1,124 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "../../src/text_format.h"
+#include "../../src/text_format.cpp" // Include implementation directly for testing
+
+void test_integers()
+{
+    char buf[16];
+    TextFormat(buf, sizeof(buf)).integer(0);
+    TEST_ASSERT_EQUAL_STRING("0", buf);
+    TextFormat(buf, sizeof(buf)).integer(-42);
+    TEST_ASSERT_EQUAL_STRING("-42", buf);
+    TextFormat(buf, sizeof(buf)).integer(7, 2).text(":").integer(5, 2);
+    TEST_ASSERT_EQUAL_STRING("07:05", buf);
+    TextFormat(buf, sizeof(buf)).integer(-3, 3);
+    TEST_ASSERT_EQUAL_STRING("-003", buf);
+    TextFormat(buf, sizeof(buf)).integer(INT32_MIN);
+    TEST_ASSERT_EQUAL_STRING("-2147483648", buf);
+    TextFormat(buf, sizeof(buf)).integer(INT32_MAX);
+    TEST_ASSERT_EQUAL_STRING("2147483647", buf);
+}
+
+void test_whole_matches_printf()
+{
+    // Every tenth from -99.9 to 199.9 prints the digits "%.0f" printed (ties to even), except
+    // that small negatives no longer show as "-0"
+    char ours[16];
+    char theirs[16];
+    for (int tenths = -999; tenths <= 1999; tenths++)
+    {
+        TextFormat(ours, sizeof(ours)).whole(tenths);
+        snprintf(theirs, sizeof(theirs), "%.0f", tenths / 10.0);
+        const char *expected = strcmp(theirs, "-0") == 0 ? "0" : theirs;
+        TEST_ASSERT_EQUAL_STRING(expected, ours);
+        TEST_ASSERT_EQUAL(atoi(expected), TextFormat::roundTenths(tenths));
+    }
+}
+
+void test_tenths_match_printf()
+{
+    char ours[16];
+    char theirs[16];
+    for (int tenths = -999; tenths <= 1999; tenths++)
+    {
+        TextFormat(ours, sizeof(ours)).tenths(tenths);
+        snprintf(theirs, sizeof(theirs), "%.1f", tenths / 10.0);
+        TEST_ASSERT_EQUAL_STRING(theirs, ours);
+    }
+}
+
+void test_labels_as_drawn()
+{
+    char buf[24];
+    TextFormat(buf, sizeof(buf)).whole(473).text("/").whole(-25).text("°");
+    TEST_ASSERT_EQUAL_STRING("47/-2°", buf);
+    TextFormat(buf, sizeof(buf)).text("Battery: ").whole(875).text("%");
+    TEST_ASSERT_EQUAL_STRING("Battery: 88%", buf);
+    TextFormat(buf, sizeof(buf)).integer(12).text("p");
+    TEST_ASSERT_EQUAL_STRING("12p", buf);
+}
+
+void test_overflow_truncates_and_reports()
+{
+    char buf[6];
+    TextFormat fits(buf, sizeof(buf));
+    fits.integer(12, 2).text(":").integer(34, 2);
+    TEST_ASSERT_EQUAL(5, fits.length());
+
+    TextFormat cut(buf, sizeof(buf));
+    cut.text("Battery: ").integer(100);
+    TEST_ASSERT_EQUAL(0, cut.length());
+    TEST_ASSERT_EQUAL_STRING("Batte", buf); // Still terminated
+
+    TextFormat none(buf, 0);
+    none.text("x");
+    TEST_ASSERT_EQUAL(0, none.length());
+}
+
+void test_cost_against_printf()
+{
+    const int runs = 200000;
+    char buf[24];
+    volatile size_t sink = 0;
+
+    // What the daily cells did per label: two soft-float "%.0f" conversions
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++)
+    {
+        float high = (473 + i % 300) / 10.0f;
+        float low = (-25 + i % 200) / 10.0f;
+        sink = sink + snprintf(buf, sizeof(buf), "%.0f/%.0f°", high, low);
+    }
+    double printfNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++)
+    {
+        TextFormat text(buf, sizeof(buf));
+        text.whole(473 + i % 300).text("/").whole(-25 + i % 200).text("°");
+        sink = sink + text.length();
+    }
+    double ownNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "High/low label: snprintf %.0f ns, TextFormat %.0f ns on host (%.1fx)", printfNs, ownNs,
+             printfNs / ownNs);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(ownNs < printfNs);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_integers);
+    RUN_TEST(test_whole_matches_printf);
+    RUN_TEST(test_tenths_match_printf);
+    RUN_TEST(test_labels_as_drawn);
+    RUN_TEST(test_overflow_truncates_and_reports);
+    RUN_TEST(test_cost_against_printf);
+    return UNITY_END();
+}
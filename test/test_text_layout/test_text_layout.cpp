@@ -0,0 +1,240 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "../../src/text_layout.h"
+#include "../../src/text_layout.cpp" // Include implementation directly for testing
+
+const int PANEL_WIDTH = 800;
+
+// Printable ASCII with metrics in the range of FreeSansBold12pt7b: a space with no ink,
+// glyphs hanging left of the cursor (negative xOffset) and descenders
+static GFXglyph glyphs[0x7E - 0x20 + 1];
+static GFXfont font = {nullptr, glyphs, 0x20, 0x7E, 29};
+
+static void buildFont()
+{
+    for (int c = 0x20; c <= 0x7E; c++)
+    {
+        GFXglyph &g = glyphs[c - 0x20];
+        g.bitmapOffset = 0;
+        g.width = c == ' ' ? 0 : (uint8_t)(4 + (c * 7) % 14);
+        g.height = c == ' ' ? 0 : (uint8_t)(6 + (c * 5) % 14);
+        g.xAdvance = (uint8_t)(c == ' ' ? 7 : g.width + 1 + c % 3);
+        g.xOffset = (int8_t)(c % 5 == 0 ? -1 : c % 3);
+        g.yOffset = (int8_t)(-(int)g.height + (c % 4 == 0 ? 5 : 0)); // Some descend below the baseline
+    }
+}
+
+// Adafruit_GFX::getTextBounds for a custom font at text size 1, wrap on (GFX's default) -
+// the reference every width has to match
+static void gfxTextBounds(const GFXfont *f, const char *str, int16_t x, int16_t y, int16_t *x1, int16_t *y1,
+                          uint16_t *w, uint16_t *h)
+{
+    int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+    *x1 = x;
+    *y1 = y;
+    *w = *h = 0;
+    uint8_t c;
+    while ((c = *str++))
+    {
+        if (c == '\n')
+        {
+            x = 0;
+            y += f->yAdvance;
+        }
+        else if (c != '\r')
+        {
+            uint8_t first = f->first, last = f->last;
+            if ((c >= first) && (c <= last))
+            {
+                GFXglyph *glyph = &f->glyph[c - first];
+                uint8_t gw = glyph->width, gh = glyph->height, xa = glyph->xAdvance;
+                int8_t xo = glyph->xOffset, yo = glyph->yOffset;
+                if ((x + (((int16_t)xo + gw))) > PANEL_WIDTH)
+                {
+                    x = 0;
+                    y += f->yAdvance;
+                }
+                int16_t tx1 = x + xo, ty1 = y + yo, tx2 = tx1 + gw - 1, ty2 = ty1 + gh - 1;
+                if (tx1 < minx)
+                    minx = tx1;
+                if (ty1 < miny)
+                    miny = ty1;
+                if (tx2 > maxx)
+                    maxx = tx2;
+                if (ty2 > maxy)
+                    maxy = ty2;
+                x += xa;
+            }
+        }
+    }
+    if (maxx >= minx)
+    {
+        *x1 = minx;
+        *w = maxx - minx + 1;
+    }
+    if (maxy >= miny)
+    {
+        *y1 = miny;
+        *h = maxy - miny + 1;
+    }
+}
+
+static void assertMatchesGfx(const char *text)
+{
+    int16_t x1, y1;
+    uint16_t w, h;
+    gfxTextBounds(&font, text, 0, 0, &x1, &y1, &w, &h);
+    TextExtent extent = TextLayout::measure(&font, text);
+    if (extent.x1 != x1 || extent.y1 != y1 || extent.w != w || extent.h != h)
+    {
+        printf("  \"%s\": got %d,%d %ux%u, GFX %d,%d %ux%u\n", text, extent.x1, extent.y1, extent.w, extent.h, x1, y1, w, h);
+    }
+    TEST_ASSERT_EQUAL(x1, extent.x1);
+    TEST_ASSERT_EQUAL(y1, extent.y1);
+    TEST_ASSERT_EQUAL(w, extent.w);
+    TEST_ASSERT_EQUAL(h, extent.h);
+}
+
+void test_panel_labels_match_gfx()
+{
+    const char *labels[] = {"Mon", "Wednesday", "12p", "47/-2\xC2\xB0", "Jan 5, 2026", "Battery: 88%",
+                            "AQI 42 Good   PM2.5 8", "Sun 7:49-16:29 (8h 40m)", "No sunrise today"};
+    for (const char *label : labels)
+    {
+        assertMatchesGfx(label);
+    }
+}
+
+void test_spaces_and_unknown_characters()
+{
+    assertMatchesGfx("");
+    assertMatchesGfx(" ");
+    assertMatchesGfx("  lead");
+    assertMatchesGfx("trail  ");
+    assertMatchesGfx("\xC2\xB0"); // Both bytes outside the font: no box at all
+    assertMatchesGfx("a\tb\x7F");
+}
+
+void test_random_strings_match_gfx()
+{
+    uint32_t seed = 7;
+    char text[24];
+    for (int n = 0; n < 5000; n++)
+    {
+        int length = n % 23;
+        for (int i = 0; i < length; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            text[i] = (char)(0x1E + (seed >> 16) % 0x64); // Mostly printable, a few outside the font
+        }
+        text[length] = '\0';
+        assertMatchesGfx(text);
+    }
+}
+
+void test_label_cache_by_address()
+{
+    static const char *days[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    TextWidthCache cache = {};
+    for (int round = 0; round < 2; round++)
+    {
+        for (const char *day : days)
+        {
+            TextExtent cached = TextLayout::measureLabel(cache, &font, day);
+            TextExtent direct = TextLayout::measure(&font, day);
+            TEST_ASSERT_EQUAL(direct.w, cached.w);
+            TEST_ASSERT_EQUAL(direct.h, cached.h);
+            TEST_ASSERT_EQUAL(direct.x1, cached.x1);
+        }
+    }
+
+    // The same string in another font is measured with that font
+    static GFXglyph wide[0x7E - 0x20 + 1];
+    for (int i = 0; i <= 0x7E - 0x20; i++)
+    {
+        wide[i] = glyphs[i];
+        wide[i].width = (uint8_t)(glyphs[i].width * 2);
+        wide[i].xAdvance = (uint8_t)(glyphs[i].xAdvance * 2);
+    }
+    GFXfont other = {nullptr, wide, 0x20, 0x7E, 29};
+    TEST_ASSERT_EQUAL(TextLayout::measure(&other, days[1]).w, TextLayout::measureLabel(cache, &other, days[1]).w);
+    TEST_ASSERT_EQUAL(TextLayout::measure(&font, days[1]).w, TextLayout::measureLabel(cache, &font, days[1]).w);
+    TEST_ASSERT_TRUE(TextLayout::measure(&other, days[1]).w > TextLayout::measure(&font, days[1]).w);
+}
+
+void test_cost_against_get_text_bounds()
+{
+    // One weather render: 5 hour labels, 5 hourly temps, 4 day names, 4 high/low, 2 date lines
+    static const char *render[] = {"3p", "4p", "5p", "6p", "7p", "41\xC2\xB0", "40\xC2\xB0", "38\xC2\xB0",
+                                   "37\xC2\xB0", "36\xC2\xB0", "Fri", "Sat", "Sun", "Mon", "47/32\xC2\xB0",
+                                   "48/33\xC2\xB0", "45/30\xC2\xB0", "44/29\xC2\xB0", "Thursday", "Jan 1, 2026"};
+    const int labels = sizeof(render) / sizeof(render[0]);
+    const int runs = 50000;
+    volatile uint32_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++)
+    {
+        for (int i = 0; i < labels; i++)
+        {
+            int16_t x1, y1;
+            uint16_t w, h;
+            gfxTextBounds(&font, render[i], 0, 0, &x1, &y1, &w, &h);
+            sink = sink + w;
+        }
+    }
+    double gfxNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++)
+    {
+        for (int i = 0; i < labels; i++)
+        {
+            sink = sink + TextLayout::measure(&font, render[i]).w;
+        }
+    }
+    double layoutNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    TextWidthCache cache = {};
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++)
+    {
+        for (int i = 10; i < 14; i++)
+        {
+            sink = sink + TextLayout::measureLabel(cache, &font, render[i]).w;
+        }
+    }
+    double cachedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++)
+    {
+        for (int i = 10; i < 14; i++)
+        {
+            sink = sink + TextLayout::measure(&font, render[i]).w;
+        }
+    }
+    double dayNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    char msg[200];
+    snprintf(msg, sizeof(msg), "%d labels per render: getTextBounds logic %.0f ns, TextLayout %.0f ns (%.1fx)", labels,
+             gfxNs, layoutNs, gfxNs / layoutNs);
+    TEST_MESSAGE(msg);
+    snprintf(msg, sizeof(msg), "4 day names: measured %.0f ns, cached %.0f ns; cache %u bytes", dayNs, cachedNs,
+             (unsigned)sizeof(TextWidthCache));
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(layoutNs < gfxNs);
+}
+
+int main()
+{
+    buildFont();
+    UNITY_BEGIN();
+    RUN_TEST(test_panel_labels_match_gfx);
+    RUN_TEST(test_spaces_and_unknown_characters);
+    RUN_TEST(test_random_strings_match_gfx);
+    RUN_TEST(test_label_cache_by_address);
+    RUN_TEST(test_cost_against_get_text_bounds);
+    return UNITY_END();
+}
@@ -0,0 +1,426 @@
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../../src/text_layout.h"
+#include "../../src/text_raster.h"
+#include "../../src/text_raster.cpp" // Include implementation directly for testing
+#include "../../src/text_layout.cpp"
+
+const int PANEL_WIDTH = 800;
+const int PANEL_HEIGHT = 480;
+const uint32_t GOLDEN_FULL_PANEL = 0x7c66ea57; // FNV-1a of the per-pixel path's render of LABELS
+
+// Printable ASCII with FreeSansBold12pt7b-like metrics and stroke-like ink, bits packed
+// across rows the way fontconvert packs them
+static GFXglyph glyphs[0x7E - 0x20 + 1];
+static std::vector<uint8_t> bitmap;
+static GFXfont font;
+
+static void buildFont()
+{
+    uint32_t seed = 12345;
+    for (int c = 0x20; c <= 0x7E; c++)
+    {
+        GFXglyph &g = glyphs[c - 0x20];
+        g.width = c == ' ' ? 0 : (uint8_t)(3 + (c * 7) % 17);
+        g.height = c == ' ' ? 0 : (uint8_t)(5 + (c * 5) % 15);
+        g.xAdvance = (uint8_t)(c == ' ' ? 7 : g.width + 1 + c % 3);
+        g.xOffset = (int8_t)(c % 5 == 0 ? -1 : c % 3);
+        g.yOffset = (int8_t)(-(int)g.height + (c % 4 == 0 ? 5 : 0));
+        g.bitmapOffset = (uint16_t)bitmap.size();
+
+        // Strokes like a bold sans: 3 px stems and bars, a few glyphs of noise for odd run patterns
+        std::vector<bool> ink(g.width * g.height);
+        for (int y = 0; y < g.height; y++)
+        {
+            for (int x = 0; x < g.width; x++)
+            {
+                seed = seed * 1103515245 + 12345;
+                bool stroke = x < 3 || (c % 2 && x >= g.width - 3) || y < 3 || (c % 3 == 0 && y >= g.height / 2 - 1 && y <= g.height / 2 + 1);
+                ink[y * g.width + x] = c % 11 == 0 ? ((seed >> 16) & 1) : stroke;
+            }
+        }
+        for (size_t i = 0; i < ink.size(); i += 8)
+        {
+            uint8_t b = 0;
+            for (size_t j = 0; j < 8; j++)
+            {
+                b = (uint8_t)(b << 1 | (i + j < ink.size() && ink[i + j]));
+            }
+            bitmap.push_back(b);
+        }
+    }
+    font = {bitmap.data(), glyphs, 0x20, 0x7E, 29};
+}
+
+// Reference: Adafruit_GFX write/drawChar at text size 1 feeding GxEPD2_BW::drawPixel
+// (rotation 0, no mirror) - the path the panel used before
+struct ReferencePanel
+{
+    RasterTarget target;
+    int16_t cursorX, cursorY;
+
+    // Out of line like the virtual drawPixel GFX calls for every pixel
+    __attribute__((noinline)) void drawPixel(int16_t x, int16_t y, bool black)
+    {
+        if (x < 0 || x >= PANEL_WIDTH || y < 0 || y >= PANEL_HEIGHT)
+            return;
+        x -= target.windowX;
+        y -= target.windowY;
+        if (x < 0 || x >= (int16_t)target.windowWidth || y < 0 || y >= (int16_t)target.windowHeight)
+            return;
+        y -= target.pageTop;
+        if (y < 0 || y >= (int16_t)target.pageHeight)
+            return;
+        uint16_t i = x / 8 + y * (target.windowWidth / 8);
+        if (black)
+            target.buffer[i] = (target.buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
+        else
+            target.buffer[i] = (target.buffer[i] | (1 << (7 - x % 8)));
+    }
+
+    void drawChar(int16_t x, int16_t y, unsigned char c, bool black)
+    {
+        c -= font.first;
+        GFXglyph *glyph = &font.glyph[c];
+        uint8_t *bits = font.bitmap;
+        uint16_t bo = glyph->bitmapOffset;
+        uint8_t w = glyph->width, h = glyph->height;
+        int8_t xo = glyph->xOffset, yo = glyph->yOffset;
+        uint8_t xx, yy, b = 0, bit = 0;
+        for (yy = 0; yy < h; yy++)
+        {
+            for (xx = 0; xx < w; xx++)
+            {
+                if (!(bit++ & 7))
+                    b = bits[bo++];
+                if (b & 0x80)
+                    drawPixel(x + xo + xx, y + yo + yy, black);
+                b <<= 1;
+            }
+        }
+    }
+
+    void print(const char *text, bool black)
+    {
+        for (const uint8_t *p = (const uint8_t *)text; *p; p++)
+        {
+            uint8_t c = *p;
+            if (c == '\n')
+            {
+                cursorX = 0;
+                cursorY += font.yAdvance;
+            }
+            else if (c != '\r' && c >= font.first && c <= font.last)
+            {
+                GFXglyph *glyph = &font.glyph[c - font.first];
+                if (glyph->width > 0 && glyph->height > 0)
+                {
+                    if (cursorX + (glyph->xOffset + glyph->width) > PANEL_WIDTH)
+                    {
+                        cursorX = 0;
+                        cursorY += font.yAdvance;
+                    }
+                    drawChar(cursorX, cursorY, c, black);
+                }
+                cursorX += glyph->xAdvance;
+            }
+        }
+    }
+};
+
+struct Scene
+{
+    int16_t windowX, windowY;
+    uint16_t windowWidth, windowHeight;
+    uint16_t pageTop, pageHeight;
+};
+
+struct Label
+{
+    int16_t x, y;
+    const char *text;
+};
+
+static const Label LABELS[] = {
+    {437, 300, "3p"},           {517, 340, "41\xC2\xB0"}, {603, 372, "Fri"},
+    {690, 412, "47/32\xC2\xB0"}, {95, 250, "Thursday"},    {90, 300, "Jan 1, 2026"},
+    {10, 460, "Battery: 88%"},  {-7, 20, "left edge"},     {770, 40, "wraps at the right edge"},
+    {403, 95, "two\nlines"},    {200, 479, "bottom gjpq"}, {300, 2, "top"},
+};
+const int LABEL_COUNT = sizeof(LABELS) / sizeof(LABELS[0]);
+
+static uint32_t fnv(const uint8_t *data, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+        hash = (hash ^ data[i]) * 16777619u;
+    return hash;
+}
+
+static void renderBoth(const Scene &scene, bool black, std::vector<uint8_t> &spans, std::vector<uint8_t> &pixels)
+{
+    size_t size = (size_t)(scene.windowWidth / 8) * scene.pageHeight;
+    spans.assign(size, black ? 0xFF : 0x00);
+    pixels.assign(size, black ? 0xFF : 0x00);
+    RasterTarget target = {spans.data(), scene.windowX, scene.windowY, scene.windowWidth, scene.windowHeight,
+                           scene.pageTop, scene.pageHeight, PANEL_WIDTH, PANEL_HEIGHT};
+    ReferencePanel reference = {target, 0, 0};
+    reference.target.buffer = pixels.data();
+
+    for (int i = 0; i < LABEL_COUNT; i++)
+    {
+        int16_t end = TextRaster::drawText(target, &font, LABELS[i].x, LABELS[i].y, LABELS[i].text, black);
+        reference.cursorX = LABELS[i].x;
+        reference.cursorY = LABELS[i].y;
+        reference.print(LABELS[i].text, black);
+        TEST_ASSERT_EQUAL(reference.cursorX, end);
+    }
+}
+
+static void assertSame(const std::vector<uint8_t> &spans, const std::vector<uint8_t> &pixels)
+{
+    for (size_t i = 0; i < spans.size(); i++)
+    {
+        if (spans[i] != pixels[i])
+        {
+            printf("  first difference at byte %zu: %02x vs %02x\n", i, spans[i], pixels[i]);
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL_MEMORY(pixels.data(), spans.data(), spans.size());
+}
+
+void test_full_panel_matches_gfx()
+{
+    Scene scene = {0, 0, PANEL_WIDTH, PANEL_HEIGHT, 0, PANEL_HEIGHT};
+    std::vector<uint8_t> spans, pixels;
+    renderBoth(scene, true, spans, pixels);
+    assertSame(spans, pixels);
+
+    // Golden image: the pixel path's render of the scene, fixed so a change to either path shows
+    char msg[64];
+    snprintf(msg, sizeof(msg), "Golden full-panel render %08x", fnv(pixels.data(), pixels.size()));
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_HEX32(GOLDEN_FULL_PANEL, fnv(spans.data(), spans.size()));
+}
+
+void test_partial_windows_clip_like_gfx()
+{
+    // Windows the pane actually uses plus ones cutting through glyphs on every side
+    const Scene scenes[] = {
+        {400, 0, 400, 480, 0, 480},  {0, 80, 400, 144, 0, 144},  {0, 216, 400, 144, 0, 144},
+        {0, 400, 200, 80, 0, 80},    {512, 296, 96, 88, 0, 88},  {88, 240, 64, 16, 0, 16},
+        {0, 0, 800, 480, 120, 120},  {400, 24, 160, 400, 64, 48}, {792, 0, 8, 480, 0, 480},
+    };
+    for (const Scene &scene : scenes)
+    {
+        std::vector<uint8_t> spans, pixels;
+        renderBoth(scene, true, spans, pixels);
+        assertSame(spans, pixels);
+        renderBoth(scene, false, spans, pixels);
+        assertSame(spans, pixels);
+    }
+}
+
+void test_random_positions_match_gfx()
+{
+    uint32_t seed = 99;
+    Scene scene = {128, 64, 320, 256, 0, 256};
+    size_t size = (size_t)(scene.windowWidth / 8) * scene.pageHeight;
+    std::vector<uint8_t> spans(size, 0xFF), pixels(size, 0xFF);
+    RasterTarget target = {spans.data(), scene.windowX, scene.windowY, scene.windowWidth, scene.windowHeight,
+                           scene.pageTop, scene.pageHeight, PANEL_WIDTH, PANEL_HEIGHT};
+    ReferencePanel reference = {target, 0, 0};
+    reference.target.buffer = pixels.data();
+
+    char text[12];
+    for (int n = 0; n < 2000; n++)
+    {
+        seed = seed * 1103515245 + 12345;
+        int16_t x = (int16_t)(100 + (seed >> 8) % 380);
+        int16_t y = (int16_t)(50 + (seed >> 4) % 300);
+        int length = 1 + n % 10;
+        for (int i = 0; i < length; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            text[i] = (char)(0x20 + (seed >> 16) % 0x5F);
+        }
+        text[length] = '\0';
+        bool black = (n % 3) != 0;
+        TextRaster::drawText(target, &font, x, y, text, black);
+        reference.cursorX = x;
+        reference.cursorY = y;
+        reference.print(text, black);
+    }
+    assertSame(spans, pixels);
+}
+
+void test_fill_rect_clips_like_gfx()
+{
+    // GFX drawRect as four fillRects (what the unknown weather icon's box is), crossing the
+    // window, page and panel edges
+    const Scene scenes[] = {{400, 0, 400, 480, 0, 480}, {0, 0, 800, 480, 120, 120}, {400, 24, 160, 400, 64, 48}};
+    uint32_t seed = 7;
+    for (const Scene &scene : scenes)
+    {
+        size_t size = (size_t)(scene.windowWidth / 8) * scene.pageHeight;
+        std::vector<uint8_t> spans(size, 0xFF), pixels(size, 0xFF);
+        RasterTarget target = {spans.data(), scene.windowX, scene.windowY, scene.windowWidth, scene.windowHeight,
+                               scene.pageTop, scene.pageHeight, PANEL_WIDTH, PANEL_HEIGHT};
+        ReferencePanel reference = {target, 0, 0};
+        reference.target.buffer = pixels.data();
+        for (int n = 0; n < 500; n++)
+        {
+            seed = seed * 1103515245 + 12345;
+            int16_t x = (int16_t)((seed >> 8) % 840) - 20;
+            int16_t y = (int16_t)((seed >> 4) % 520) - 20;
+            int16_t w = (int16_t)((seed >> 16) % 70);
+            int16_t h = (int16_t)((seed >> 20) % 40);
+            bool black = n % 4 != 0;
+            TextRaster::fillRect(target, x, y, w, h, black);
+            for (int16_t row = y; row < y + h; row++)
+            {
+                for (int16_t col = x; col < x + w; col++)
+                    reference.drawPixel(col, row, black);
+            }
+        }
+        assertSame(spans, pixels);
+    }
+}
+
+// Subset the way scripts/subset_fonts.py does: range cut to the used characters, glyphs in
+// between that are never drawn keep their metrics but lose their bitmap
+static void buildSubset(const char *used, GFXfont &subset, std::vector<GFXglyph> &subsetGlyphs,
+                        std::vector<uint8_t> &subsetBitmap)
+{
+    uint8_t first = 0x7E, last = 0x20;
+    for (const uint8_t *p = (const uint8_t *)used; *p; p++)
+    {
+        first = *p < first ? *p : first;
+        last = *p > last ? *p : last;
+    }
+    for (int c = first; c <= last; c++)
+    {
+        GFXglyph g = glyphs[c - 0x20];
+        if (strchr(used, c))
+        {
+            size_t bytes = (g.width * g.height + 7) / 8;
+            subsetBitmap.insert(subsetBitmap.end(), bitmap.begin() + g.bitmapOffset,
+                                bitmap.begin() + g.bitmapOffset + bytes);
+            g.bitmapOffset = (uint16_t)(subsetBitmap.size() - bytes);
+        }
+        else
+        {
+            g.bitmapOffset = 0;
+            g.width = g.height = 0;
+        }
+        subsetGlyphs.push_back(g);
+    }
+    subset = {subsetBitmap.data(), subsetGlyphs.data(), first, last, font.yAdvance};
+}
+
+void test_subset_font_draws_like_full_font()
+{
+    static const char *const texts[] = {"Thursday", "Jan 1, 2026", "Battery: 88%", "47/32\xC2\xB0", "3p", "-12"};
+    std::string used;
+    for (const char *text : texts)
+    {
+        for (const char *p = text; *p; p++)
+        {
+            if ((uint8_t)*p >= 0x20 && (uint8_t)*p <= 0x7E && used.find(*p) == std::string::npos)
+                used += *p;
+        }
+    }
+    GFXfont subset;
+    std::vector<GFXglyph> subsetGlyphs;
+    std::vector<uint8_t> subsetBitmap;
+    buildSubset(used.c_str(), subset, subsetGlyphs, subsetBitmap);
+
+    Scene scene = {0, 0, 400, 160, 0, 160};
+    for (const char *text : texts)
+    {
+        std::vector<uint8_t> full(50 * 160, 0xFF), cut(50 * 160, 0xFF);
+        RasterTarget target = {full.data(), scene.windowX, scene.windowY, scene.windowWidth, scene.windowHeight,
+                               scene.pageTop, scene.pageHeight, PANEL_WIDTH, PANEL_HEIGHT};
+        int16_t fullEnd = TextRaster::drawText(target, &font, 13, 100, text, true);
+        target.buffer = cut.data();
+        int16_t cutEnd = TextRaster::drawText(target, &subset, 13, 100, text, true);
+        TEST_ASSERT_EQUAL(fullEnd, cutEnd);
+        TEST_ASSERT_EQUAL_MEMORY(full.data(), cut.data(), full.size());
+
+        TextExtent a = TextLayout::measure(&font, text), b = TextLayout::measure(&subset, text);
+        TEST_ASSERT_EQUAL(a.x1, b.x1);
+        TEST_ASSERT_EQUAL(a.y1, b.y1);
+        TEST_ASSERT_EQUAL(a.w, b.w);
+        TEST_ASSERT_EQUAL(a.h, b.h);
+    }
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%zu of 95 glyphs: %zu of %zu bitmap bytes", used.size(), subsetBitmap.size(),
+             bitmap.size());
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(subsetBitmap.size() < bitmap.size() / 2);
+}
+
+void test_cost_against_draw_pixel()
+{
+    // The weather pane's labels in one 400x480 window
+    Scene scene = {400, 0, 400, 480, 0, 480};
+    size_t size = (size_t)(scene.windowWidth / 8) * scene.pageHeight;
+    std::vector<uint8_t> buffer(size, 0xFF);
+    RasterTarget target = {buffer.data(), scene.windowX, scene.windowY, scene.windowWidth, scene.windowHeight,
+                           scene.pageTop, scene.pageHeight, PANEL_WIDTH, PANEL_HEIGHT};
+    ReferencePanel reference = {target, 0, 0};
+    static const Label pane[] = {{437, 300, "3p"},   {517, 300, "4p"},       {597, 300, "5p"},       {677, 300, "6p"},
+                                 {757, 300, "7p"},   {437, 360, "41\xC2\xB0"}, {517, 360, "40\xC2\xB0"}, {597, 360, "38\xC2\xB0"},
+                                 {677, 360, "37\xC2\xB0"}, {757, 360, "36\xC2\xB0"}, {440, 400, "Fri"},     {540, 400, "Sat"},
+                                 {640, 400, "Sun"},  {740, 400, "Mon"},      {430, 460, "47/32\xC2\xB0"}, {530, 460, "48/33\xC2\xB0"},
+                                 {630, 460, "45/30\xC2\xB0"}, {730, 460, "44/29\xC2\xB0"}, {640, 470, "Jan 01 14:30"}};
+    const int count = sizeof(pane) / sizeof(pane[0]);
+    const int runs = 5000;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            reference.cursorX = pane[i].x;
+            reference.cursorY = pane[i].y;
+            reference.print(pane[i].text, r & 1);
+        }
+    }
+    double pixelUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            TextRaster::drawText(target, &font, pane[i].x, pane[i].y, pane[i].text, r & 1);
+        }
+    }
+    double spanUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "%d pane labels: per-pixel path %.2f us, spans %.2f us on host (%.1fx)", count, pixelUs,
+             spanUs, pixelUs / spanUs);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(spanUs < pixelUs);
+}
+
+int main()
+{
+    buildFont();
+    UNITY_BEGIN();
+    RUN_TEST(test_full_panel_matches_gfx);
+    RUN_TEST(test_partial_windows_clip_like_gfx);
+    RUN_TEST(test_random_positions_match_gfx);
+    RUN_TEST(test_fill_rect_clips_like_gfx);
+    RUN_TEST(test_subset_font_draws_like_full_font);
+    RUN_TEST(test_cost_against_draw_pixel);
+    return UNITY_END();
+}
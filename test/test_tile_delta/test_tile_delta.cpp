@@ -0,0 +1,342 @@
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#define PROGMEM
+#include "../../src/weather_bitmaps.h"
+#include "../../src/weather_bitmaps.cpp"
+#include "../../src/packed_bitmap.cpp"
+#include "../../src/weather_layout.h"
+#include "../../src/frame_codec.h"
+#include "../../src/frame_codec.cpp" // Include implementation directly for testing
+#include "../../src/weather_diff.h"
+#include "../../src/weather_diff.cpp" // Include implementation directly for testing
+#include "../../src/text_format.h"
+#include "../../src/text_format.cpp"
+#include "../../src/tile_delta.h"
+#include "../../src/tile_delta.cpp" // Include implementation directly for testing
+
+const int PANE_WIDTH = WEATHER_PANE_WIDTH;
+const int PANE_HEIGHT = DISPLAY_HEIGHT;
+const int PANE_ROW_BYTES = PANE_WIDTH / 8;
+const size_t PANE_BYTES = (size_t)PANE_ROW_BYTES * PANE_HEIGHT;
+const int BAND_ROWS = 16; // Same band height as DisplayManager::drawFrameDelta
+
+typedef std::vector<uint8_t> Image; // Packed 1bpp, 1 = white
+
+static void black(Image &image, int x, int y)
+{
+    if (x < 0 || y < 0 || x >= PANE_WIDTH || y >= PANE_HEIGHT)
+        return;
+    image[y * PANE_ROW_BYTES + x / 8] &= ~(0x80 >> (x % 8));
+}
+
+static void icon(Image &image, int centerX, int centerY, const PackedBitmap *bitmap)
+{
+    RasterTarget target = {image.data(), 0, 0, PANE_WIDTH, PANE_HEIGHT, 0, PANE_HEIGHT, PANE_WIDTH, PANE_HEIGHT};
+    PackedBlit::draw(target, *bitmap, centerX - 20 + 1, centerY - 20);
+}
+
+// Stand-in for a centered line of 12pt text whose strokes depend on the value shown
+static void text(Image &image, int centerX, int baseline, int chars, unsigned value)
+{
+    int x0 = centerX - chars * 7;
+    unsigned seed = value * 2654435761u;
+    for (int c = 0; c < chars; c++)
+    {
+        seed = seed * 1103515245 + 12345;
+        for (int stroke = 0; stroke < 5; stroke++)
+        {
+            int sx = x0 + c * 14 + (seed >> (stroke * 3)) % 10;
+            for (int y = baseline - 17; y < baseline; y++)
+                for (int w = 0; w < 3; w++)
+                    black(image, sx + w, y);
+        }
+    }
+}
+
+// Values that decide the pixels of the weather pane
+struct PaneValues
+{
+    int currentTemp;
+    int hourlyHour[HOURLY_COLUMNS];
+    int hourlyTemp[HOURLY_COLUMNS];
+    int hourlyIcon[HOURLY_COLUMNS];
+    int dailyTemp[DAILY_COLUMNS];
+    int dailyIcon[DAILY_COLUMNS];
+    int stampMinutes;
+};
+
+static PaneValues sampleValues()
+{
+    return {72, {9, 10, 11, 12, 13}, {70, 71, 73, 74, 74}, {0, 0, 1, 1, 2}, {7560, 7158, 6855, 7057}, {0, 1, 2, 3}, 600};
+}
+
+// Pane laid out like DisplayWeather (pane-local coordinates)
+static Image renderPane(const PaneValues &v)
+{
+    Image image(PANE_BYTES, 0xFF);
+    const PackedBitmap *icons[] = {&sun_max_40x40, &cloud_40x40, &cloud_rain_40x40, &cloud_snow_40x40,
+                                   &cloud_bolt_rain_40x40};
+
+    // Large current temperature: two digit blocks plus degree, shape depends on the digit
+    for (int d = 0; d < 2; d++)
+    {
+        int digit = (d == 0) ? v.currentTemp / 10 : v.currentTemp % 10;
+        for (int y = CURRENT_TEMP_Y; y < CURRENT_TEMP_Y + 110; y++)
+            for (int x = 0; x < 70; x++)
+                if (x < 14 || x > 56 || y < CURRENT_TEMP_Y + 14 + digit * 4 || y > CURRENT_TEMP_Y + 96)
+                    black(image, 95 + d * 70 + x, y);
+    }
+
+    int hourlyWidth = PANE_WIDTH / HOURLY_COLUMNS;
+    for (int i = 0; i < HOURLY_COLUMNS; i++)
+    {
+        int centerX = i * hourlyWidth + hourlyWidth / 2;
+        text(image, centerX, HOURLY_START_Y + TEXT_HEIGHT, 3, v.hourlyHour[i]);
+        icon(image, centerX, HOURLY_START_Y + ICON_HEIGHT, icons[v.hourlyIcon[i]]);
+        text(image, centerX, HOURLY_START_Y + ICON_HEIGHT + TEXT_HEIGHT * 2, 3, v.hourlyTemp[i]);
+    }
+
+    int dailyWidth = PANE_WIDTH / DAILY_COLUMNS;
+    for (int i = 0; i < DAILY_COLUMNS; i++)
+    {
+        int centerX = i * dailyWidth + dailyWidth / 2;
+        text(image, centerX, DAILY_START_Y + TEXT_HEIGHT, 3, 20 + i);
+        icon(image, centerX, DAILY_START_Y + ICON_HEIGHT, icons[v.dailyIcon[i]]);
+        text(image, centerX, DAILY_START_Y + ICON_HEIGHT + TEXT_HEIGHT * 2, 6, v.dailyTemp[i]);
+    }
+
+    text(image, LAST_UPDATED_X - WEATHER_PANE_X + 60, LAST_UPDATED_Y, 12, v.stampMinutes);
+    return image;
+}
+
+static std::vector<uint8_t> encodeDelta(const Image &before, const Image &after, int *windows = nullptr)
+{
+    std::vector<ScreenRect> rects(TileDelta::maxRects(PANE_WIDTH, PANE_HEIGHT));
+    int count = TileDelta::changedRects(before.data(), after.data(), PANE_WIDTH, PANE_HEIGHT, rects.data());
+    if (windows)
+        *windows = count;
+
+    std::vector<uint8_t> delta(TILE_DELTA_HEADER_SIZE + count * FrameCodec::maxEncodedSize(PANE_WIDTH, PANE_HEIGHT));
+    size_t length = TileDelta::encode(after.data(), PANE_WIDTH, WEATHER_PANE_X, 0, rects.data(), count,
+                                      TileDelta::imageHash(before.data(), before.size()),
+                                      TileDelta::imageHash(after.data(), after.size()), delta.data(), delta.size());
+    delta.resize(length);
+    return delta;
+}
+
+// What the device does: each tile decoded band by band into the buffer at its panel position
+static bool applyDelta(const std::vector<uint8_t> &delta, Image &pane)
+{
+    TileDeltaReader reader;
+    if (!reader.begin(delta.data(), delta.size()))
+        return false;
+
+    FrameDecoder decoder;
+    std::vector<uint8_t> band(BAND_ROWS * PANE_ROW_BYTES);
+    while (reader.nextTile(decoder))
+    {
+        const FrameInfo &info = decoder.info();
+        if (info.x < WEATHER_PANE_X || info.x - WEATHER_PANE_X + info.width > PANE_WIDTH ||
+            info.y + info.height > PANE_HEIGHT)
+            return false;
+
+        int rows;
+        while ((rows = decoder.decodeRows(band.data(), BAND_ROWS)) > 0)
+        {
+            int y0 = info.y + decoder.rowsDecoded() - rows;
+            for (int r = 0; r < rows; r++)
+                memcpy(&pane[(y0 + r) * PANE_ROW_BYTES + (info.x - WEATHER_PANE_X) / 8],
+                       &band[r * decoder.rowBytes()], decoder.rowBytes());
+        }
+        if (rows < 0)
+            return false;
+    }
+    return true;
+}
+
+static size_t fullFrameSize(const Image &pane)
+{
+    FrameInfo info = {WEATHER_PANE_X, 0, PANE_WIDTH, PANE_HEIGHT, FRAME_FLAG_PACKBITS, 0};
+    std::vector<uint8_t> frame(FrameCodec::maxEncodedSize(PANE_WIDTH, PANE_HEIGHT));
+    return FrameCodec::encode(pane.data(), info, frame.data(), frame.size());
+}
+
+void test_image_hash()
+{
+    Image a = renderPane(sampleValues());
+    Image b = a;
+    TEST_ASSERT_EQUAL_UINT32(TileDelta::imageHash(a.data(), a.size()), TileDelta::imageHash(b.data(), b.size()));
+    b[1234] ^= 0x10;
+    TEST_ASSERT_NOT_EQUAL(TileDelta::imageHash(a.data(), a.size()), TileDelta::imageHash(b.data(), b.size()));
+    TEST_ASSERT_NOT_EQUAL(0, TileDelta::imageHash(nullptr, 0));
+}
+
+void test_identical_panes_have_no_tiles()
+{
+    Image pane = renderPane(sampleValues());
+    std::vector<ScreenRect> rects(TileDelta::maxRects(PANE_WIDTH, PANE_HEIGHT));
+    TEST_ASSERT_EQUAL(0, TileDelta::changedRects(pane.data(), pane.data(), PANE_WIDTH, PANE_HEIGHT, rects.data()));
+}
+
+void test_single_pixel_gives_one_tile()
+{
+    Image before(PANE_BYTES, 0xFF);
+    Image after = before;
+    black(after, 130, 95); // Inside tile column 3, row 2
+
+    std::vector<ScreenRect> rects(TileDelta::maxRects(PANE_WIDTH, PANE_HEIGHT));
+    TEST_ASSERT_EQUAL(1, TileDelta::changedRects(before.data(), after.data(), PANE_WIDTH, PANE_HEIGHT, rects.data()));
+    TEST_ASSERT_EQUAL(120, rects[0].x);
+    TEST_ASSERT_EQUAL(80, rects[0].y);
+    TEST_ASSERT_EQUAL(TILE_SIZE, rects[0].w);
+    TEST_ASSERT_EQUAL(TILE_SIZE, rects[0].h);
+}
+
+void test_nearby_tiles_merge_into_one_window()
+{
+    Image before(PANE_BYTES, 0xFF);
+    Image after = before;
+    black(after, 10, 10);
+    black(after, 90, 10);  // Same tile row, one clean tile between
+    black(after, 10, 50);  // Tile row below
+
+    std::vector<ScreenRect> rects(TileDelta::maxRects(PANE_WIDTH, PANE_HEIGHT));
+    TEST_ASSERT_EQUAL(1, TileDelta::changedRects(before.data(), after.data(), PANE_WIDTH, PANE_HEIGHT, rects.data()));
+    TEST_ASSERT_EQUAL(0, rects[0].x);
+    TEST_ASSERT_EQUAL(0, rects[0].y);
+    TEST_ASSERT_EQUAL(120, rects[0].w);
+    TEST_ASSERT_EQUAL(80, rects[0].h);
+}
+
+void test_delta_reproduces_new_pane()
+{
+    // Random edits: applying the delta to the old pane must give exactly the new one
+    unsigned seed = 99;
+    for (int round = 0; round < 50; round++)
+    {
+        Image before = renderPane(sampleValues());
+        Image after = before;
+        int edits = 1 + round % 12;
+        for (int e = 0; e < edits; e++)
+        {
+            seed = seed * 1103515245 + 12345;
+            int x = (seed >> 8) % PANE_WIDTH;
+            int y = (seed >> 20) % PANE_HEIGHT;
+            for (int k = 0; k < 6; k++)
+                black(after, x + k, y);
+        }
+
+        std::vector<uint8_t> delta = encodeDelta(before, after);
+        Image shown = before;
+        TEST_ASSERT_TRUE(applyDelta(delta, shown));
+        TEST_ASSERT_EQUAL_MEMORY(after.data(), shown.data(), PANE_BYTES);
+    }
+}
+
+void test_reader_header_and_rejects()
+{
+    Image before = renderPane(sampleValues());
+    PaneValues v = sampleValues();
+    v.hourlyTemp[2] = 75;
+    Image after = renderPane(v);
+    std::vector<uint8_t> delta = encodeDelta(before, after);
+
+    TileDeltaReader reader;
+    TEST_ASSERT_TRUE(reader.begin(delta.data(), delta.size()));
+    TEST_ASSERT_EQUAL_UINT32(TileDelta::imageHash(before.data(), PANE_BYTES), reader.baseHash());
+    TEST_ASSERT_EQUAL_UINT32(TileDelta::imageHash(after.data(), PANE_BYTES), reader.newHash());
+    TEST_ASSERT_TRUE(reader.tileCount() >= 1);
+
+    // Truncated download, trailing garbage, wrong magic, tile count too high
+    TEST_ASSERT_FALSE(reader.begin(delta.data(), delta.size() - 1));
+    std::vector<uint8_t> bad = delta;
+    bad.push_back(0);
+    TEST_ASSERT_FALSE(reader.begin(bad.data(), bad.size()));
+    bad = delta;
+    bad[1] = 'F';
+    TEST_ASSERT_FALSE(reader.begin(bad.data(), bad.size()));
+    bad = delta;
+    bad[3]++;
+    TEST_ASSERT_FALSE(reader.begin(bad.data(), bad.size()));
+}
+
+void test_bandwidth_per_update()
+{
+    PaneValues base = sampleValues();
+    Image shown = renderPane(base);
+    size_t full = fullFrameSize(shown);
+
+    struct Scenario
+    {
+        const char *name;
+        PaneValues values;
+    };
+    Scenario scenarios[5] = {{"stamp only", base}, {"one hourly temp", base}, {"current temp", base},
+                             {"hourly columns shift", base}, {"all values", base}};
+    scenarios[0].values.stampMinutes += 30;
+    scenarios[1].values.stampMinutes += 30;
+    scenarios[1].values.hourlyTemp[3] = 76;
+    scenarios[2].values.stampMinutes += 30;
+    scenarios[2].values.currentTemp = 74;
+    for (int i = 0; i < HOURLY_COLUMNS; i++)
+    {
+        scenarios[3].values.hourlyHour[i]++;
+        scenarios[3].values.hourlyTemp[i] = base.hourlyTemp[(i + 1) % HOURLY_COLUMNS];
+        scenarios[3].values.hourlyIcon[i] = base.hourlyIcon[(i + 1) % HOURLY_COLUMNS];
+    }
+    scenarios[3].values.stampMinutes += 60;
+    scenarios[4].values = scenarios[3].values;
+    scenarios[4].values.currentTemp = 65;
+    for (int i = 0; i < DAILY_COLUMNS; i++)
+    {
+        scenarios[4].values.dailyTemp[i] += 101;
+        scenarios[4].values.dailyIcon[i] = (base.dailyIcon[i] + 1) % 5;
+    }
+
+    char msg[200];
+    snprintf(msg, sizeof(msg), "Raw pane %zu bytes, full PackBits frame %zu bytes", PANE_BYTES, full);
+    TEST_MESSAGE(msg);
+
+    for (const Scenario &s : scenarios)
+    {
+        Image next = renderPane(s.values);
+        int windows = 0;
+        std::vector<uint8_t> delta = encodeDelta(shown, next, &windows);
+
+        Image applied = shown;
+        TEST_ASSERT_TRUE(applyDelta(delta, applied));
+        TEST_ASSERT_EQUAL_MEMORY(next.data(), applied.data(), PANE_BYTES);
+
+        TileDeltaReader reader;
+        reader.begin(delta.data(), delta.size());
+        FrameDecoder decoder;
+        int32_t area = 0;
+        while (reader.nextTile(decoder))
+            area += decoder.info().width * decoder.info().height;
+
+        snprintf(msg, sizeof(msg), "%-20s delta %5zu bytes (%4.1f%% of full frame), %d window(s), %4.1f%% of pane refreshed",
+                 s.name, delta.size(), 100.0 * delta.size() / full, windows, 100.0 * area / (PANE_WIDTH * PANE_HEIGHT));
+        TEST_MESSAGE(msg);
+
+        // Partial changes must cost less than resending the pane
+        if (&s - scenarios < 3)
+            TEST_ASSERT_TRUE(delta.size() * 2 < full);
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_image_hash);
+    RUN_TEST(test_identical_panes_have_no_tiles);
+    RUN_TEST(test_single_pixel_gives_one_tile);
+    RUN_TEST(test_nearby_tiles_merge_into_one_window);
+    RUN_TEST(test_delta_reproduces_new_pane);
+    RUN_TEST(test_reader_header_and_rejects);
+    RUN_TEST(test_bandwidth_per_update);
+
+    return UNITY_END();
+}
@@ -179,6 +179,26 @@ void test_scenario_multiple_wake_cycles_same_day()
     }
 }
 
+void test_secondsUntilNextClockUpdate_every_minute()
+{
+    // 12:34:10 with 1-minute granularity -> wake at 12:35:00
+    TEST_ASSERT_EQUAL(50, WakeLogic::secondsUntilNextClockUpdate(34, 10, 1));
+}
+
+void test_secondsUntilNextClockUpdate_buffer_skips_to_next_boundary()
+{
+    // 12:34:58 is too close to the boundary - sleep through to 12:36:00
+    TEST_ASSERT_EQUAL(62, WakeLogic::secondsUntilNextClockUpdate(34, 58, 1));
+}
+
+void test_secondsUntilNextClockUpdate_two_minute_granularity()
+{
+    // 12:33:20 with 2-minute granularity -> wake at 12:34:00
+    TEST_ASSERT_EQUAL(40, WakeLogic::secondsUntilNextClockUpdate(33, 20, 2));
+    // 12:34:05 with 2-minute granularity -> wake at 12:36:00
+    TEST_ASSERT_EQUAL(115, WakeLogic::secondsUntilNextClockUpdate(34, 5, 2));
+}
+
 int main()
 {
     UNITY_BEGIN();
@@ -205,6 +225,11 @@ int main()
     RUN_TEST(test_isFirstBoot_on_first_boot);
     RUN_TEST(test_isFirstBoot_after_update);
 
+    // secondsUntilNextClockUpdate tests
+    RUN_TEST(test_secondsUntilNextClockUpdate_every_minute);
+    RUN_TEST(test_secondsUntilNextClockUpdate_buffer_skips_to_next_boundary);
+    RUN_TEST(test_secondsUntilNextClockUpdate_two_minute_granularity);
+
     // Scenario tests
     RUN_TEST(test_scenario_regular_minute_wake_no_weather_update);
     RUN_TEST(test_scenario_30_minute_weather_update);
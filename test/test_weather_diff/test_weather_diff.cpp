@@ -0,0 +1,272 @@
+#include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include "../../src/weather_diff.h"
+#include "../../src/weather_diff.cpp" // Include implementation directly for testing
+#include "../../src/text_format.h"
+#include "../../src/text_format.cpp"
+
+const time_t DAY_START = 1767225600; // Jan 1, 2026 00:00:00 UTC
+const int32_t PANE_AREA = (int32_t)WEATHER_PANE_WIDTH * DISPLAY_HEIGHT;
+
+static WeatherData makeWeather(time_t fetchedAt)
+{
+    WeatherData weather = {};
+    weather.currentTemp = 123;
+    weather.currentCondition = WEATHER_CLOUDY;
+    weather.lastUpdated = fetchedAt;
+    for (int i = 0; i < 6; i++)
+    {
+        weather.hourly[i].hour = (8 + i) % 24;
+        weather.hourly[i].temp = 100 + i * 10;
+        weather.hourly[i].condition = WEATHER_CLOUDY;
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        weather.daily[i].dayOfWeek = (4 + i) % 7;
+        weather.daily[i].tempHigh = 150;
+        weather.daily[i].tempLow = 50;
+        weather.daily[i].condition = WEATHER_RAIN;
+    }
+    return weather;
+}
+
+static RenderedWeather captured(const WeatherData &weather)
+{
+    RenderedWeather rendered;
+    WeatherDiff::capture(weather, rendered);
+    return rendered;
+}
+
+static int32_t totalArea(const ScreenRect *rects, int count)
+{
+    int32_t sum = 0;
+    for (int i = 0; i < count; i++)
+    {
+        sum += (int32_t)rects[i].w * rects[i].h;
+    }
+    return sum;
+}
+
+void test_capture_rounds_like_printf()
+{
+    WeatherData weather = makeWeather(DAY_START);
+    weather.currentTemp = 125; // "%.0f" printed 12
+    weather.hourly[0].temp = 135; // "%.0f" printed 14
+    weather.daily[0].tempLow = -4; // "%.0f" printed -0, the formatter prints 0
+    RenderedWeather rendered = captured(weather);
+
+    TEST_ASSERT_TRUE(rendered.valid);
+    TEST_ASSERT_EQUAL(12, rendered.currentTemp);
+    TEST_ASSERT_EQUAL(14, rendered.hourly[0].temp);
+    TEST_ASSERT_EQUAL(0, rendered.daily[0].tempLow);
+}
+
+void test_invalid_shown_marks_everything()
+{
+    RenderedWeather shown = {};
+    RenderedWeather next = captured(makeWeather(DAY_START));
+    TEST_ASSERT_EQUAL((1u << WEATHER_REGION_COUNT) - 1, WeatherDiff::changedRegions(shown, next));
+}
+
+void test_identical_forecast_changes_nothing()
+{
+    RenderedWeather shown = captured(makeWeather(DAY_START));
+    RenderedWeather next = captured(makeWeather(DAY_START));
+    ScreenRect rects[WEATHER_REGION_COUNT];
+
+    TEST_ASSERT_EQUAL(0, WeatherDiff::changedRegions(shown, next));
+    TEST_ASSERT_EQUAL(0, WeatherDiff::refreshRects(0, rects));
+}
+
+void test_sub_degree_change_is_invisible()
+{
+    WeatherData weather = makeWeather(DAY_START);
+    RenderedWeather shown = captured(weather);
+    weather.currentTemp = 124; // Still prints 12
+    weather.hourly[2].temp += 2;
+    TEST_ASSERT_EQUAL(0, WeatherDiff::changedRegions(shown, captured(weather)));
+}
+
+void test_each_field_maps_to_its_region()
+{
+    WeatherData base = makeWeather(DAY_START);
+    RenderedWeather shown = captured(base);
+
+    WeatherData weather = base;
+    weather.currentTemp = 200;
+    TEST_ASSERT_EQUAL(1u << REGION_CURRENT_TEMP, WeatherDiff::changedRegions(shown, captured(weather)));
+
+    weather = base;
+    weather.hourly[3].condition = WEATHER_SNOW;
+    TEST_ASSERT_EQUAL(1u << (REGION_HOURLY_FIRST + 3), WeatherDiff::changedRegions(shown, captured(weather)));
+
+    weather = base;
+    weather.daily[1].tempLow = -30;
+    TEST_ASSERT_EQUAL(1u << (REGION_DAILY_FIRST + 1), WeatherDiff::changedRegions(shown, captured(weather)));
+
+    weather = base;
+    weather.lastUpdated += 30 * 60;
+    TEST_ASSERT_EQUAL(1u << REGION_LAST_UPDATED, WeatherDiff::changedRegions(shown, captured(weather)));
+
+    weather = base;
+    weather.hasAirQuality = true;
+    weather.usAqi = 0; // "AQI 0" is drawn, no AQI draws nothing
+    TEST_ASSERT_EQUAL(1u << REGION_AIR_QUALITY, WeatherDiff::changedRegions(shown, captured(weather)));
+    RenderedWeather withAir = captured(weather);
+    weather.pm25Tenths = 124;
+    TEST_ASSERT_EQUAL(1u << REGION_AIR_QUALITY, WeatherDiff::changedRegions(withAir, captured(weather)));
+}
+
+void test_air_quality_fits_between_rows()
+{
+    // The AQI line gets its own window without touching the temp digits or the hourly labels
+    ScreenRect air = WeatherDiff::regionRect(REGION_AIR_QUALITY);
+    TEST_ASSERT_FALSE(WeatherDiff::intersects(air, WeatherDiff::regionRect(REGION_CURRENT_TEMP)));
+    for (int i = 0; i < HOURLY_COLUMNS; i++)
+    {
+        TEST_ASSERT_FALSE(WeatherDiff::intersects(air, WeatherDiff::regionRect(REGION_HOURLY_FIRST + i)));
+    }
+}
+
+void test_sixth_hour_is_not_shown()
+{
+    // Only 5 hourly columns are drawn; the 6th forecast hour must not trigger a refresh
+    WeatherData weather = makeWeather(DAY_START);
+    RenderedWeather shown = captured(weather);
+    weather.hourly[5].temp = 400;
+    TEST_ASSERT_EQUAL(0, WeatherDiff::changedRegions(shown, captured(weather)));
+}
+
+void test_region_rects_aligned_inside_pane()
+{
+    for (int region = 0; region < WEATHER_REGION_COUNT; region++)
+    {
+        ScreenRect rect = WeatherDiff::regionRect(region);
+        TEST_ASSERT_EQUAL(0, rect.x % 8);
+        TEST_ASSERT_EQUAL(0, rect.w % 8);
+        TEST_ASSERT_EQUAL(0, rect.y % 8);
+        TEST_ASSERT_EQUAL(0, rect.h % 8);
+        TEST_ASSERT_TRUE(rect.x >= WEATHER_PANE_X);
+        TEST_ASSERT_TRUE(rect.x + rect.w <= WEATHER_PANE_X + WEATHER_PANE_WIDTH);
+        TEST_ASSERT_TRUE(rect.y >= 0);
+        TEST_ASSERT_TRUE(rect.y + rect.h <= DISPLAY_HEIGHT);
+    }
+}
+
+void test_far_apart_regions_stay_separate()
+{
+    // Current temp (top) and the stamp (bottom right) are cheaper as two small windows
+    ScreenRect rects[WEATHER_REGION_COUNT];
+    uint32_t changed = (1u << REGION_CURRENT_TEMP) | (1u << REGION_LAST_UPDATED);
+    TEST_ASSERT_EQUAL(2, WeatherDiff::refreshRects(changed, rects));
+}
+
+void test_adjacent_cells_merge()
+{
+    ScreenRect rects[WEATHER_REGION_COUNT];
+    uint32_t changed = (1u << (REGION_HOURLY_FIRST + 1)) | (1u << (REGION_HOURLY_FIRST + 2));
+    int count = WeatherDiff::refreshRects(changed, rects);
+
+    TEST_ASSERT_EQUAL(1, count);
+    ScreenRect a = WeatherDiff::regionRect(REGION_HOURLY_FIRST + 1);
+    ScreenRect b = WeatherDiff::regionRect(REGION_HOURLY_FIRST + 2);
+    TEST_ASSERT_EQUAL(a.x, rects[0].x);
+    TEST_ASSERT_EQUAL(b.x + b.w, rects[0].x + rects[0].w);
+}
+
+void test_merged_rects_cover_every_changed_region()
+{
+    ScreenRect rects[WEATHER_REGION_COUNT];
+    uint32_t changed = 0x2A5; // Scattered regions
+    int count = WeatherDiff::refreshRects(changed, rects);
+
+    for (int region = 0; region < WEATHER_REGION_COUNT; region++)
+    {
+        if (!(changed & (1u << region)))
+            continue;
+
+        ScreenRect r = WeatherDiff::regionRect(region);
+        bool covered = false;
+        for (int i = 0; i < count; i++)
+        {
+            if (rects[i].x <= r.x && rects[i].y <= r.y &&
+                rects[i].x + rects[i].w >= r.x + r.w && rects[i].y + rects[i].h >= r.y + r.h)
+                covered = true;
+        }
+        TEST_ASSERT_TRUE(covered);
+    }
+}
+
+// Replays a recorded-style day of half-hourly fetches: slow temperature drift, an occasional
+// condition change, a new day at midnight. Compares refreshed area against full-pane refreshes.
+void test_recorded_day_refresh_area()
+{
+    RenderedWeather shown = {};
+    int32_t fullArea = 0;
+    int32_t diffArea = 0;
+    int windows = 0;
+    int skippedRegions = 0;
+
+    for (int fetch = 0; fetch < 48; fetch++)
+    {
+        time_t fetchedAt = DAY_START + fetch * 30 * 60;
+        int hour = fetch / 2;
+
+        WeatherData weather = makeWeather(fetchedAt);
+        // Temperature rises ~0.4 degrees per fetch until 15:00, then falls
+        int16_t now = (int16_t)(20 + 4 * (fetch <= 30 ? fetch : 60 - fetch));
+        weather.currentTemp = now;
+        for (int i = 0; i < 6; i++)
+        {
+            weather.hourly[i].hour = (hour + 1 + i) % 24;
+            weather.hourly[i].temp = (int16_t)(now + 8 * i);
+            weather.hourly[i].condition = (hour + 1 + i) >= 14 && (hour + 1 + i) < 18 ? WEATHER_RAIN : WEATHER_CLOUDY;
+        }
+
+        RenderedWeather next = captured(weather);
+        uint32_t changed = WeatherDiff::changedRegions(shown, next);
+        ScreenRect rects[WEATHER_REGION_COUNT];
+        int count = WeatherDiff::refreshRects(changed, rects);
+
+        // The stamp changes every fetch, so there is always something to draw
+        TEST_ASSERT_TRUE(count > 0);
+        for (int region = 0; region < WEATHER_REGION_COUNT; region++)
+        {
+            if (!(changed & (1u << region)))
+                skippedRegions++;
+        }
+
+        windows += count;
+        diffArea += totalArea(rects, count);
+        fullArea += PANE_AREA;
+        shown = next;
+    }
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "48 fetches: %ld px refreshed vs %ld full-pane (%ld%%), %d windows, %d unchanged regions skipped",
+             (long)diffArea, (long)fullArea, (long)(diffArea * 100 / fullArea), windows, skippedRegions);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_TRUE(diffArea * 2 < fullArea);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_capture_rounds_like_printf);
+    RUN_TEST(test_invalid_shown_marks_everything);
+    RUN_TEST(test_identical_forecast_changes_nothing);
+    RUN_TEST(test_sub_degree_change_is_invisible);
+    RUN_TEST(test_each_field_maps_to_its_region);
+    RUN_TEST(test_air_quality_fits_between_rows);
+    RUN_TEST(test_sixth_hour_is_not_shown);
+    RUN_TEST(test_region_rects_aligned_inside_pane);
+    RUN_TEST(test_far_apart_regions_stay_separate);
+    RUN_TEST(test_adjacent_cells_merge);
+    RUN_TEST(test_merged_rects_cover_every_changed_region);
+    RUN_TEST(test_recorded_day_refresh_area);
+
+    return UNITY_END();
+}
@@ -6,8 +6,8 @@ void testBitmapLookup()
     // Test that all digits can be looked up
     for (char c = '0'; c <= '9'; c++)
     {
-        const unsigned char *bitmap = getDigitBitmap(c);
-        if (bitmap == NULL)
+        const PackedBitmap &bitmap = getDigitBitmap(c);
+        if (bitmap.length == 0)
         {
             // Error: bitmap lookup failed
             return;
@@ -15,8 +15,8 @@ void testBitmapLookup()
     }
 
     // Test colon
-    const unsigned char *colonBitmap = getDigitBitmap(':');
-    if (colonBitmap == NULL)
+    const PackedBitmap &colonBitmap = getDigitBitmap(':');
+    if (colonBitmap.length == 0)
     {
         // Error: colon bitmap lookup failed
         return;